@@ -0,0 +1,239 @@
+/*
+    benchmarks/ad.cpp -- scaling behavior of the automatic differentiation
+    backend on synthetic graphs with 10^3 to 10^7 nodes
+
+    Every scenario builds a graph twice: once without gradient tracking (to
+    measure the cost of the primal computation alone) and once with it. The
+    difference is reported as the cost of creating AD variables and edges
+    ('new'). A backward traversal follows, whose time is broken down using
+    the counters of \ref ad_stats() into the depth-first search ('dfs'), edge
+    sorting ('sort'), gradient propagation ('traverse') and the callbacks of
+    special edges ('special'). All times are in milliseconds. Memory is the
+    host storage of the variable and edge records. It includes the page table
+    of the dense variable storage; configure with DRJIT_AD_DENSE_STORAGE=OFF
+    to compare against the hash tables.
+
+    The 'chain', 'fan_in' and 'threads' scenarios use scalar differentiable
+    arrays, which isolates the AD bookkeeping from JIT tracing. The 'gather'
+    and 'vcall' scenarios use the LLVM backend.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+#include <drjit/jit.h>
+#include <drjit/autodiff.h>
+#include <drjit/vcall.h>
+#include <thread>
+
+namespace dr = drjit;
+
+using FloatS  = dr::DiffArray<float>;
+using FloatJ  = dr::DiffArray<dr::LLVMArray<float>>;
+using UInt32J = dr::uint32_array_t<FloatJ>;
+
+/// Exponents of the graph sizes that are swept
+static constexpr int MinExp = 3, MaxExp = 7;
+
+static double ms_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start).count();
+}
+
+struct Measurement {
+    double time_primal = 0, time_new = 0, time_backward = 0;
+    dr::ADStats stats { };
+    size_t contention = 0;
+};
+
+static void report(const char *name, size_t nodes, uint32_t threads,
+                   const Measurement &m) {
+    const dr::ADStats &s = m.stats;
+    if (bench::Benchmark::json) {
+        printf("{\"name\": \"ad_%s\", \"nodes\": %zu, \"threads\": %u, "
+               "\"unit\": \"ms\", \"primal\": %.3f, \"new\": %.3f, "
+               "\"backward\": %.3f, \"dfs\": %.3f, \"sort\": %.3f, "
+               "\"traverse\": %.3f, \"special\": %.3f, \"cleanup\": %.3f, "
+               "\"variables\": %zu, \"edges\": %zu, \"variable_bytes\": %zu, "
+               "\"edge_bytes\": %zu, \"lock_contention\": %zu}\n",
+               name, nodes, threads, m.time_primal, m.time_new,
+               m.time_backward, s.time_dfs, s.time_sort, s.time_traverse,
+               s.time_special, s.time_cleanup, s.variables, s.edges,
+               s.variable_bytes, s.edge_bytes, m.contention);
+    } else {
+        printf("  %-8s n=%-9zu thr=%-2u new %9.2f  bwd %9.2f (dfs %8.2f, "
+               "sort %8.2f, trav %9.2f, spec %8.2f)  %7.1f MiB  contention %zu\n",
+               name, nodes, threads, m.time_new, m.time_backward, s.time_dfs,
+               s.time_sort, s.time_traverse, s.time_special,
+               (s.variable_bytes + s.edge_bytes) / (1024.0 * 1024.0),
+               m.contention);
+    }
+    fflush(stdout);
+}
+
+/**
+ * \brief Build the graph via <tt>build(n, grad)</tt>, which returns the
+ * output variable, and measure construction and backward traversal
+ */
+template <typename Build> Measurement measure(size_t n, Build &&build) {
+    Measurement m;
+
+    auto start = std::chrono::steady_clock::now();
+    build(n, false);
+    m.time_primal = ms_since(start);
+
+    dr::ad_stats_clear();
+    dr::ad_lock_contention_clear();
+
+    start = std::chrono::steady_clock::now();
+    auto output = build(n, true);
+    m.time_new = std::max(ms_since(start) - m.time_primal, 0.0);
+
+    // Capture the graph size before the traversal releases it
+    dr::ADStats before = dr::ad_stats();
+
+    start = std::chrono::steady_clock::now();
+    dr::backward(output);
+    m.time_backward = ms_since(start);
+
+    m.stats = dr::ad_stats();
+    m.stats.variables = before.variables;
+    m.stats.edges = before.edges;
+    m.stats.variable_bytes = before.variable_bytes;
+    m.stats.edge_bytes = before.edge_bytes;
+    m.contention = dr::ad_lock_contention();
+    return m;
+}
+
+template <typename Build> void sweep(const char *name, Build &&build) {
+    size_t n = 1;
+    for (int i = 0; i < MinExp; ++i)
+        n *= 10;
+    for (int e = MinExp; e <= MaxExp; ++e, n *= 10)
+        report(name, n, 1, measure(n, build));
+}
+
+/// Long chain of dependent operations: y = y * 0.5 + 1
+static FloatS build_chain(size_t n, bool grad) {
+    FloatS x = 1.f;
+    if (grad)
+        dr::enable_grad(x);
+    FloatS y = x;
+    for (size_t i = 0; i < n; ++i)
+        y = dr::fmadd(y, .5f, 1.f);
+    return y;
+}
+
+/// A single input feeds 'n' products that are accumulated into the output
+static FloatS build_fan_in(size_t n, bool grad) {
+    FloatS x = 2.f;
+    if (grad)
+        dr::enable_grad(x);
+    FloatS acc = 0.f;
+    for (size_t i = 0; i < n / 2; ++i)
+        acc += x * float(i & 15);
+    return acc;
+}
+
+/// Repeated gathers from a differentiable table (scatter-adds in reverse mode)
+static FloatJ build_gather(size_t n, bool grad) {
+    FloatJ table = dr::arange<FloatJ>(1024);
+    if (grad)
+        dr::enable_grad(table);
+    UInt32J index = dr::arange<UInt32J>(16) * 61u;
+    FloatJ acc = dr::zeros<FloatJ>(16);
+    for (size_t i = 0; i < n / 2; ++i) {
+        acc += dr::gather<FloatJ>(table, index);
+        index = (index + 17u) & 1023u;
+    }
+    return acc;
+}
+
+struct Element {
+    FloatJ scale;
+
+    FloatJ f(const FloatJ &x) { return dr::fmadd(x, scale, 1.f); }
+
+    DRJIT_VCALL_REGISTER(FloatJ, Element)
+};
+
+DRJIT_VCALL_BEGIN(Element)
+DRJIT_VCALL_METHOD(f)
+DRJIT_VCALL_END(Element)
+
+using ElementPtr = dr::replace_scalar_t<FloatJ, Element *>;
+
+/// Instances targeted by the 'vcall' scenario (alive until its traversal finishes)
+static Element *elements[2] = { nullptr, nullptr };
+
+/// Chain of recorded virtual function calls (one special edge per call)
+static FloatJ build_vcall(size_t n, bool grad) {
+    Element *e1 = elements[0], *e2 = elements[1];
+    e1->scale = .5f;
+    e2->scale = .25f;
+    if (grad) {
+        dr::enable_grad(e1->scale);
+        dr::enable_grad(e2->scale);
+    }
+
+    ElementPtr ptr = dr::select(dr::eq(dr::arange<UInt32J>(16) & 1u, 0u),
+                                ElementPtr(e1), ElementPtr(e2));
+    FloatJ y = dr::arange<FloatJ>(16);
+    // A recorded call creates roughly ten AD nodes
+    for (size_t i = 0; i < n / 10; ++i)
+        y = ptr->f(y);
+    return y;
+}
+
+DRJIT_BENCH(ad_scalar) {
+    sweep("chain", build_chain);
+    sweep("fan_in", build_fan_in);
+}
+
+DRJIT_BENCH(ad_llvm) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    jit_set_flag(JitFlag::VCallRecord, true);
+    sweep("gather", build_gather);
+
+    elements[0] = new Element();
+    elements[1] = new Element();
+    sweep("vcall", build_vcall);
+    delete elements[0];
+    delete elements[1];
+}
+
+/**
+ * Independent chains built and traversed concurrently by several threads.
+ * The reported 'backward' time is the wall time of both steps.
+ */
+DRJIT_BENCH(ad_threads) {
+    size_t n = 1000000;
+    uint32_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for (uint32_t threads = 1; threads <= max_threads; threads *= 2) {
+        dr::ad_stats_clear();
+        dr::ad_lock_contention_clear();
+
+        Measurement m;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (uint32_t i = 0; i < threads; ++i)
+            workers.emplace_back([n, threads] {
+                FloatS y = build_chain(n / threads, true);
+                dr::backward(y);
+            });
+        for (std::thread &t : workers)
+            t.join();
+
+        m.time_backward = ms_since(start);
+        m.stats = dr::ad_stats();
+        m.contention = dr::ad_lock_contention();
+        report("threads", n, threads, m);
+    }
+}
@@ -0,0 +1,243 @@
+/*
+    benchmarks/bench.h -- Minimal harness for microbenchmarks of the packet
+    backends, used by the programs in this directory
+
+    Every benchmark reports the throughput of an operation (elements
+    processed per clock cycle when applied to many independent packets) and
+    its latency (cycles per packet along a chain of dependent evaluations).
+    On x86, cycles are counted using the time stamp counter, which ticks at
+    the nominal frequency of the processor; disable frequency scaling and
+    turbo modes to obtain stable numbers. On other platforms, the harness
+    reports nanoseconds instead.
+
+    Results are printed as a table, or as JSON lines when the program is
+    invoked with ``--json`` (one object per measurement), which can be
+    collected and compared across commits and releases.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/packet.h>
+#include <drjit/math.h>
+#include <drjit/dispatch.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+
+using namespace drjit;
+
+NAMESPACE_BEGIN(bench)
+
+/// Number of packets processed per repetition of a throughput benchmark
+static constexpr size_t Packets = 64;
+
+/// Number of repetitions per trial, and number of trials (the fastest counts)
+static constexpr size_t Repetitions = 2000, Trials = 7;
+
+#if defined(DRJIT_X86_64) || defined(DRJIT_X86_32)
+static constexpr const char *Unit = "cycles", *UnitShort = "cyc";
+inline uint64_t clock() {
+#  if defined(_MSC_VER)
+    return __rdtsc();
+#  else
+    return __builtin_ia32_rdtsc();
+#  endif
+}
+#else
+static constexpr const char *Unit = "ns", *UnitShort = "ns";
+inline uint64_t clock() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+#endif
+
+/// Prevent the compiler from optimizing away the computation of \c value
+template <typename T> DRJIT_INLINE void keep(const T &value) {
+#if defined(_MSC_VER)
+    static volatile char sink;
+    sink = *(const volatile char *) &value;
+#else
+    asm volatile("" : : "m"(value) : "memory");
+#endif
+}
+
+/// Return a value that the compiler cannot constant-fold
+template <typename T> DRJIT_NOINLINE T opaque(T value) {
+    keep(value);
+    return value;
+}
+
+struct Benchmark {
+    using Storage = std::vector<std::pair<std::string, void (*)()>>;
+
+    Benchmark(const char *name, void (*func)()) {
+        if (!registered)
+            registered = new Storage();
+        registered->emplace_back(name, func);
+    }
+
+    static inline Storage *registered = nullptr;
+    static inline bool json = false;
+};
+
+/// Short name of the scalar type underlying \c T
+template <typename T> const char *type_name() {
+    using S = scalar_t<T>;
+    if constexpr (std::is_same_v<S, float>)         return "float32";
+    else if constexpr (std::is_same_v<S, double>)   return "float64";
+    else if constexpr (std::is_same_v<S, int32_t>)  return "int32";
+    else if constexpr (std::is_same_v<S, uint32_t>) return "uint32";
+    else if constexpr (std::is_same_v<S, int64_t>)  return "int64";
+    else if constexpr (std::is_same_v<S, uint64_t>) return "uint64";
+    else                                            return "other";
+}
+
+/// Print one measurement (a negative value means 'not measured')
+inline void report(const char *name, const char *type, size_t width,
+                   double throughput, double latency) {
+    const char *isa = isa_name(CompiledISA);
+    if (Benchmark::json) {
+        printf("{\"isa\": \"%s\", \"name\": \"%s\", \"type\": \"%s\", "
+               "\"width\": %zu, \"unit\": \"%s\", \"throughput\": %.4f",
+               isa, name, type, width, Unit, throughput);
+        if (latency >= 0)
+            printf(", \"latency\": %.3f", latency);
+        printf("}\n");
+    } else {
+        printf("  %-6s %-22s %-8s %3zu  %10.4f elem/%s", isa, name, type,
+               width, throughput, UnitShort);
+        if (latency >= 0)
+            printf("  %9.3f %s/op", latency, UnitShort);
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+/// Run \c body repeatedly and return the duration of the fastest trial
+template <typename Body> double min_time(Body &&body) {
+    double best = 1e30;
+    body(); // warm up
+    for (size_t trial = 0; trial < Trials; ++trial) {
+        uint64_t start = clock();
+        body();
+        best = std::min(best, double(clock() - start));
+    }
+    return best;
+}
+
+/// Uniformly distributed random inputs in <tt>[lo, hi]</tt>
+template <typename T> std::vector<T> inputs(scalar_t<T> lo, scalar_t<T> hi) {
+    using S = scalar_t<T>;
+    std::vector<T> result(Packets);
+    std::mt19937 gen(0);
+    for (T &v : result) {
+        for (size_t i = 0; i < array_size_v<T>; ++i) {
+            if constexpr (std::is_floating_point_v<S>)
+                v.entry(i) = std::uniform_real_distribution<S>(lo, hi)(gen);
+            else
+                v.entry(i) = std::uniform_int_distribution<S>(lo, hi)(gen);
+        }
+    }
+    return result;
+}
+
+/// Cycles (or nanoseconds) per packet of evaluating \c func along a dependency chain
+template <typename T, typename Func> double chain(const T &start, Func &&func) {
+    T zero = opaque(T(0));
+    return min_time([&] {
+        T x = start;
+        for (size_t i = 0; i < Repetitions * Packets; ++i) {
+            auto y = func(x);
+            // Feed the result back without changing 'x'
+            if constexpr (std::is_floating_point_v<scalar_t<T>>)
+                x = fmadd(T(y), zero, x);
+            else
+                x = x + (T(y) & zero);
+        }
+        keep(x);
+    }) / double(Repetitions * Packets);
+}
+
+/**
+ * \brief Measure the throughput and latency of the element-wise operation
+ * \c func on inputs sampled from <tt>[lo, hi]</tt>
+ *
+ * The latency excludes the cost of the multiply-add (or AND/add) that feeds
+ * the result back into the next evaluation. The \c type label defaults to
+ * the scalar type of the input.
+ */
+template <typename T, typename Func>
+void measure(const char *name, Func &&func, scalar_t<T> lo, scalar_t<T> hi,
+             bool with_latency = true, const char *type = nullptr) {
+    std::vector<T> in = inputs<T>(lo, hi);
+    using Out = std::decay_t<decltype(func(in[0]))>;
+    std::vector<Out> out(Packets);
+
+    double time = min_time([&] {
+        for (size_t r = 0; r < Repetitions; ++r) {
+            for (size_t i = 0; i < Packets; ++i)
+                out[i] = func(in[i]);
+            keep(out[0]);
+        }
+    });
+
+    double throughput = double(Repetitions * Packets * array_size_v<T>) / time,
+           latency = -1;
+
+    if (with_latency)
+        latency = std::max(chain(in[0], func) -
+                           chain(in[0], [](const T &x) { return x; }), 0.0);
+
+    report(name, type ? type : type_name<T>(), array_size_v<T>, throughput,
+           latency);
+}
+
+NAMESPACE_END(bench)
+
+#define DRJIT_BENCH(name)                                                      \
+    void name();                                                               \
+    static bench::Benchmark name##_bench{ #name, &name };                      \
+    void name()
+
+int main(int argc, char **argv) {
+    const char *filter = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--json") == 0) {
+            bench::Benchmark::json = true;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "Usage: %s [--json] [name filter]\n", argv[0]);
+            return -1;
+        } else {
+            filter = argv[i];
+        }
+    }
+
+    if (!bench::Benchmark::registered)
+        return 0;
+
+    for (auto &[name, func] : *bench::Benchmark::registered) {
+        if (filter && name.find(filter) == std::string::npos)
+            continue;
+        if (!bench::Benchmark::json)
+            printf("%s:\n", name.c_str());
+        func();
+    }
+
+    return 0;
+}
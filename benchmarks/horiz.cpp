@@ -0,0 +1,38 @@
+/*
+    benchmarks/horiz.cpp -- throughput and latency of horizontal operations
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+
+template <typename T> void bench_horiz() {
+    using Scalar = scalar_t<T>;
+
+    bench::measure<T>("sum",  [](const T &x) { return sum(x); }, 0, 100);
+    bench::measure<T>("prod", [](const T &x) { return prod(x); }, 0, 2);
+    bench::measure<T>("min",  [](const T &x) { return min(x); }, 0, 100);
+    bench::measure<T>("max",  [](const T &x) { return max(x); }, 0, 100);
+    bench::measure<T>("dot",  [](const T &x) { return dot(x, x); }, 0, 100);
+
+    bench::measure<T>("all", [](const T &x) {
+        return all(x > Scalar(50)) ? Scalar(1) : Scalar(0);
+    }, 0, 100);
+    bench::measure<T>("any", [](const T &x) {
+        return any(x > Scalar(50)) ? Scalar(1) : Scalar(0);
+    }, 0, 100);
+    bench::measure<T>("count", [](const T &x) {
+        return Scalar(count(x > Scalar(50)));
+    }, 0, 100);
+}
+
+DRJIT_BENCH(horiz_float32) { bench_horiz<Packet<float>>(); }
+DRJIT_BENCH(horiz_float64) { bench_horiz<Packet<double>>(); }
+DRJIT_BENCH(horiz_int32)   { bench_horiz<Packet<int32_t>>(); }
+DRJIT_BENCH(horiz_uint64)  { bench_horiz<Packet<uint64_t>>(); }
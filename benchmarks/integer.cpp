@@ -0,0 +1,68 @@
+/*
+    benchmarks/integer.cpp -- throughput and latency of integer division by
+    constants (drjit/idiv.h) and Morton encoding (drjit/morton.h)
+
+    The "_lane" variants divide by a different divisor in every lane, either
+    natively or via precomputed per-lane constants, and the "24" variants
+    compare native division of 24-bit operands against \ref idivmod24().
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+#include <drjit/idiv.h>
+#include <drjit/morton.h>
+
+template <typename T> void bench_integer() {
+    using Scalar = scalar_t<T>;
+    divisor<Scalar> div(Scalar(7));
+
+    bench::measure<T>("div", [](const T &x) { return x / T(bench::opaque(Scalar(7))); },
+                      0, 1 << 30);
+    bench::measure<T>("idiv", [div](const T &x) { return idiv(x, div); }, 0, 1 << 30);
+    bench::measure<T>("imod", [div](const T &x) { return imod(x, div); }, 0, 1 << 30);
+    bench::measure<T>("idivmod", [div](const T &x) {
+        auto [q, r] = idivmod(x, div);
+        return q + r;
+    }, 0, 1 << 30);
+
+    T d = bench::opaque(arange<T>() * Scalar(6) + Scalar(7));
+    divisor<T> div_lane(d);
+
+    bench::measure<T>("div_lane", [d](const T &x) { return x / d; }, 0, 1 << 30);
+    bench::measure<T>("mod_lane", [d](const T &x) { return x % d; }, 0, 1 << 30);
+    bench::measure<T>("idiv_lane", [div_lane](const T &x) { return idiv(x, div_lane); },
+                      0, 1 << 30);
+    bench::measure<T>("imod_lane", [div_lane](const T &x) { return imod(x, div_lane); },
+                      0, 1 << 30);
+    bench::measure<T>("div24", [d](const T &x) { return x / d; }, 0, 1 << 24);
+    bench::measure<T>("mod24", [d](const T &x) { return x % d; }, 0, 1 << 24);
+    bench::measure<T>("idiv24", [d](const T &x) { return idiv24(x, d); }, 0, 1 << 24);
+    bench::measure<T>("idivmod24", [d](const T &x) {
+        auto [q, r] = idivmod24(x, d);
+        return q + r;
+    }, 0, 1 << 24);
+
+    if constexpr (std::is_unsigned_v<Scalar>) {
+        bench::measure<T>("morton_encode_2d", [](const T &x) {
+            return morton_encode(Array<T, 2>(x & 0xffff, sr<16>(x)));
+        }, 0, 0xffffffff);
+        bench::measure<T>("morton_encode_3d", [](const T &x) {
+            return morton_encode(Array<T, 3>(x & 0x3ff, sr<10>(x) & 0x3ff, sr<20>(x) & 0x3ff));
+        }, 0, 0xffffffff);
+        bench::measure<T>("morton_decode_2d", [](const T &x) {
+            Array<T, 2> v = morton_decode<Array<T, 2>>(x);
+            return v.x() ^ v.y();
+        }, 0, 0xffffffff);
+    }
+}
+
+DRJIT_BENCH(integer_uint32) { bench_integer<Packet<uint32_t>>(); }
+DRJIT_BENCH(integer_int32)  { bench_integer<Packet<int32_t>>(); }
+DRJIT_BENCH(integer_uint64) { bench_integer<Packet<uint64_t>>(); }
@@ -0,0 +1,64 @@
+/*
+    benchmarks/intersect.cpp -- throughput and latency of the ray
+    intersection routines in drjit/intersect.h
+
+    Every measurement intersects a packet of rays with one primitive. The
+    input varies the ray origin, and the "_fused" variants of the triangle
+    test reuse the precomputed \ref TriangleRay for four triangles.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+#include <drjit/intersect.h>
+
+template <typename T> void bench_intersect() {
+    using Vector3 = Array<T, 3>;
+
+    Vector3 d = bench::opaque(Vector3(T(.25f), T(-.5f), T(1.f))),
+            d_rcp = ray_rcp_dir(d),
+            lo = bench::opaque(Vector3(T(-1.f))),
+            hi = bench::opaque(Vector3(T(1.f))),
+            p0(T(-1.f), T(-1.f), T(2.f)), p1(T(1.f), T(-1.f), T(2.f)),
+            p2(T(0.f), T(1.f), T(2.f));
+
+    bench::measure<T>("ray_box", [&](const T &x) {
+        auto [hit, t_near, t_far] =
+            ray_box(Vector3(x, T(0.f), T(-2.f)), d_rcp, lo, hi, T(0.f), T(10.f));
+        return select(hit, t_near, t_far);
+    }, -2, 2);
+
+    bench::measure<T>("ray_triangle", [&](const T &x) {
+        auto [hit, t, u, v] = ray_triangle(
+            TriangleRay<Vector3>(Vector3(x, T(0.f), T(0.f)), d), p0, p1, p2,
+            T(0.f), T(10.f));
+        return select(hit, t, u + v);
+    }, -2, 2);
+
+    bench::measure<T>("ray_triangle_fused", [&](const T &x) {
+        TriangleRay<Vector3> ray(Vector3(x, T(0.f), T(0.f)), d);
+        T t_max(10.f);
+        for (int i = 0; i < 4; ++i) {
+            Vector3 offset(T(0.f), T(0.f), T(float(i)));
+            auto [hit, t, u, v] = ray_triangle(ray, p0 + offset, p1 + offset,
+                                               p2 + offset, T(0.f), t_max);
+            t_max = select(hit, t, t_max);
+        }
+        return t_max;
+    }, -2, 2, false);
+
+    bench::measure<T>("ray_sphere", [&](const T &x) {
+        auto [hit, t] = ray_sphere(Vector3(x, T(0.f), T(-2.f)), d, lo, T(1.5f),
+                                   T(0.f), T(10.f));
+        return select(hit, t, T(-1.f));
+    }, -2, 2);
+}
+
+DRJIT_BENCH(intersect_float32) { bench_intersect<Packet<float>>(); }
+DRJIT_BENCH(intersect_float64) { bench_intersect<Packet<double>>(); }
@@ -0,0 +1,70 @@
+/*
+    benchmarks/math.cpp -- throughput and latency of the transcendental
+    functions in drjit/math.h
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+
+#define DRJIT_BENCH_UNARY(func, lo, hi)                                        \
+    bench::measure<T>(#func, [](const T &x) { return func(x); }, lo, hi)
+
+template <typename T> void bench_math() {
+    DRJIT_BENCH_UNARY(sqrt,    0, 100);
+    DRJIT_BENCH_UNARY(rsqrt,   0.01, 100);
+    DRJIT_BENCH_UNARY(rcp,     0.01, 100);
+    DRJIT_BENCH_UNARY(cbrt,    -100, 100);
+
+    DRJIT_BENCH_UNARY(sin,     -10, 10);
+    DRJIT_BENCH_UNARY(cos,     -10, 10);
+    DRJIT_BENCH_UNARY(tan,     -1.5, 1.5);
+    DRJIT_BENCH_UNARY(csc,     0.1, 3);
+    DRJIT_BENCH_UNARY(sec,     -1.5, 1.5);
+    DRJIT_BENCH_UNARY(cot,     0.1, 3);
+    DRJIT_BENCH_UNARY(asin,    -1, 1);
+    DRJIT_BENCH_UNARY(acos,    -1, 1);
+    DRJIT_BENCH_UNARY(atan,    -10, 10);
+    bench::measure<T>("sincos", [](const T &x) {
+        auto [s, c] = sincos(x);
+        return s + c;
+    }, -10, 10);
+    bench::measure<T>("atan2", [](const T &x) { return atan2(x, x + 1); }, -10, 10);
+
+    DRJIT_BENCH_UNARY(exp,     -10, 10);
+    DRJIT_BENCH_UNARY(exp2,    -10, 10);
+    DRJIT_BENCH_UNARY(log,     0.01, 100);
+    DRJIT_BENCH_UNARY(log2,    0.01, 100);
+    bench::measure<T>("pow", [](const T &x) { return pow(x, x * .5f); }, 0.01, 10);
+    bench::measure<T>("frexp", [](const T &x) {
+        auto [m, e] = frexp(x);
+        return m + e;
+    }, 0.01, 100);
+    bench::measure<T>("ldexp", [](const T &x) { return ldexp(x, T(3)); }, -10, 10);
+
+    DRJIT_BENCH_UNARY(sinh,    -5, 5);
+    DRJIT_BENCH_UNARY(cosh,    -5, 5);
+    DRJIT_BENCH_UNARY(tanh,    -5, 5);
+    DRJIT_BENCH_UNARY(csch,    0.1, 5);
+    DRJIT_BENCH_UNARY(sech,    -5, 5);
+    DRJIT_BENCH_UNARY(coth,    0.1, 5);
+    DRJIT_BENCH_UNARY(asinh,   -10, 10);
+    DRJIT_BENCH_UNARY(acosh,   1, 10);
+    DRJIT_BENCH_UNARY(atanh,   -0.99, 0.99);
+    bench::measure<T>("sincosh", [](const T &x) {
+        auto [s, c] = sincosh(x);
+        return s + c;
+    }, -5, 5);
+
+    DRJIT_BENCH_UNARY(erf,     -3, 3);
+    DRJIT_BENCH_UNARY(erfinv,  -0.99, 0.99);
+}
+
+DRJIT_BENCH(math_float32) { bench_math<Packet<float>>(); }
+DRJIT_BENCH(math_float64) { bench_math<Packet<double>>(); }
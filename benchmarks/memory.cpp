@@ -0,0 +1,75 @@
+/*
+    benchmarks/memory.cpp -- throughput of gathers and scatters, and the
+    latency of dependent gathers (pointer chasing)
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+
+/// Benchmark memory operations on a table with 'size' entries
+template <typename T> void bench_memory(uint32_t size, const char *suffix) {
+    using Scalar = scalar_t<T>;
+    using Index = uint32_array_t<T>;
+
+    std::vector<Scalar> table(size);
+    std::vector<uint32_t> next(size);
+    std::mt19937 gen(1);
+
+    // A random cyclic permutation for the pointer chasing benchmark
+    std::vector<uint32_t> perm(size);
+    for (uint32_t i = 0; i < size; ++i)
+        perm[i] = i;
+    std::shuffle(perm.begin(), perm.end(), gen);
+    for (uint32_t i = 0; i < size; ++i) {
+        next[perm[i]] = perm[(i + 1) % size];
+        table[i] = Scalar(i);
+    }
+
+    const Scalar *src = table.data();
+    Scalar *dst = table.data();
+    const uint32_t *next_p = next.data();
+    const char *type = bench::type_name<T>();
+    std::string name;
+
+    name = std::string("gather_") + suffix;
+    bench::measure<Index>(name.c_str(), [src](const Index &i) {
+        return gather<T>(src, i);
+    }, 0, size - 1, false, type);
+
+    name = std::string("gather_masked_") + suffix;
+    bench::measure<Index>(name.c_str(), [src](const Index &i) {
+        return gather<T>(src, i, neq(i & 1u, 0u));
+    }, 0, size - 1, false, type);
+
+    name = std::string("gather_chain_") + suffix;
+    bench::measure<Index>(name.c_str(), [next_p](const Index &i) {
+        return gather<Index>(next_p, i);
+    }, 0, size - 1, true, "uint32");
+
+    name = std::string("scatter_") + suffix;
+    bench::measure<Index>(name.c_str(), [dst](const Index &i) {
+        scatter(dst, T(i), i);
+        return i;
+    }, 0, size - 1, false, type);
+
+    name = std::string("scatter_add_") + suffix;
+    bench::measure<Index>(name.c_str(), [dst](const Index &i) {
+        scatter_reduce(ReduceOp::Add, dst, T(1), i);
+        return i;
+    }, 0, size - 1, false, type);
+}
+
+template <typename T> void bench_memory() {
+    bench_memory<T>(1024, "l1");
+    bench_memory<T>(1u << 24, "dram");
+}
+
+DRJIT_BENCH(memory_float32) { bench_memory<Packet<float>>(); }
+DRJIT_BENCH(memory_float64) { bench_memory<Packet<double, Packet<float>::Size>>(); }
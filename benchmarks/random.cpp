@@ -0,0 +1,42 @@
+/*
+    benchmarks/random.cpp -- throughput of the pseudorandom number generators
+    in drjit/random.h
+
+    The "pcg32" and "philox" measurements advance a single generator per
+    lane, while "philox_index" evaluates the counter-based generator at the
+    position given by the input without keeping any state. The "_x4"
+    variants produce four samples per lane and element.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+#include <drjit/random.h>
+
+template <typename T> void bench_random() {
+    using Float = float32_array_t<T>;
+    using Float4 = Array<Float, 4>;
+
+    PCG32<uint64_array_t<T>> pcg;
+    Philox4x32<T> philox(arange<T>());
+
+    bench::measure<T>("pcg32", [&](const T &) { return pcg.next_float32(); },
+                      0, 0, false);
+    bench::measure<T>("philox", [&](const T &) { return philox.next_float32(); },
+                      0, 0, false);
+    bench::measure<T>("philox_x4", [&](const T &) {
+        Float4 v = philox.next_float32x4();
+        return (v.x() + v.y()) + (v.z() + v.w());
+    }, 0, 0, false);
+    bench::measure<T>("philox_index", [](const T &x) {
+        return Philox4x32<T>(x).next_float32();
+    }, 0, 1 << 30);
+}
+
+DRJIT_BENCH(random_uint32) { bench_random<Packet<uint32_t>>(); }
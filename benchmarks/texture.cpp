@@ -0,0 +1,215 @@
+/*
+    benchmarks/texture.cpp -- lookup throughput of drjit::Texture
+
+    Sweeps the dimension (1-3D), the number of channels, the filter and wrap
+    modes, hardware acceleration (CUDA only) and the query pattern for the
+    evaluation routines \ref Texture::eval(), \ref Texture::eval_fetch(),
+    \ref Texture::eval_cubic() and \ref Texture::eval_cubic_grad(). Coherent
+    queries traverse the texture in scanline order, while random queries are
+    uniformly distributed. The reported figure is lookups per second,
+    excluding the kernel compilation (the fastest of several launches counts).
+
+    The filter mode only affects \ref Texture::eval(); the remaining routines
+    are measured with linear filtering, which the hardware-accelerated cubic
+    interpolation requires. On the LLVM backend the \c use_accel flag has no
+    effect, hence only non-accelerated textures are measured there.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "bench.h"
+#include <drjit/jit.h>
+#include <drjit/random.h>
+#include <drjit/texture.h>
+
+namespace dr = drjit;
+
+/// Number of lookups per kernel launch
+static constexpr uint32_t Queries = 1u << 20;
+
+/// Number of launches per configuration (the fastest counts)
+static constexpr int Launches = 5;
+
+/// Texture resolution per axis for 1D, 2D and 3D textures
+static constexpr size_t Resolution[3] = { 1u << 16, 1024, 64 };
+
+enum class Method { Eval, Fetch, Cubic, CubicGrad };
+
+static const char *method_name(Method method) {
+    switch (method) {
+        case Method::Eval:  return "eval";
+        case Method::Fetch: return "eval_fetch";
+        case Method::Cubic: return "eval_cubic";
+        default:            return "eval_cubic_grad";
+    }
+}
+
+static const char *filter_name(FilterMode mode) {
+    return mode == FilterMode::Nearest ? "nearest" : "linear";
+}
+
+static const char *wrap_name(WrapMode mode) {
+    switch (mode) {
+        case WrapMode::Repeat: return "repeat";
+        case WrapMode::Clamp:  return "clamp";
+        default:               return "mirror";
+    }
+}
+
+/// Query positions in <tt>[-0.25, 1.25]</tt> so that every wrap mode is exercised
+template <typename Float, size_t Dimension>
+dr::Array<Float, Dimension> query_positions(bool coherent) {
+    using UInt32 = dr::uint32_array_t<Float>;
+    using Pos = dr::Array<Float, Dimension>;
+
+    Pos pos;
+    if (coherent) {
+        // Scanline order over a regular grid with 'side' points per axis
+        uint32_t side = (uint32_t) std::lround(std::pow((double) Queries, 1.0 / Dimension));
+        UInt32 index = dr::arange<UInt32>(Queries);
+        for (size_t i = 0; i < Dimension; ++i) {
+            pos.entry(i) = Float(index % side) * (1.5f / side) - .25f;
+            index /= side;
+        }
+    } else {
+        dr::PCG32<Float> rng(Queries);
+        for (size_t i = 0; i < Dimension; ++i)
+            pos.entry(i) = dr::fmadd(rng.next_float32(), 1.5f, -.25f);
+    }
+
+    dr::eval(pos);
+    return pos;
+}
+
+/// Seconds spent by the fastest launch of \c func, which returns the outputs
+template <typename Func> double fastest_launch(Func &&func) {
+    double best = 1e30;
+    for (int i = 0; i <= Launches; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        jit_sync_thread();
+        double time = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - start).count();
+        // The first launch compiles the kernel
+        if (i > 0)
+            best = std::min(best, time);
+    }
+    return best;
+}
+
+template <typename Float, size_t Dimension>
+void run(const char *backend, bool use_accel, size_t channels,
+         FilterMode filter, WrapMode wrap, Method method) {
+    using Tex = dr::Texture<Float, Dimension>;
+    using Pos = dr::Array<Float, Dimension>;
+    using Storage = typename Tex::Storage;
+
+    size_t shape[Dimension], texels = channels;
+    for (size_t i = 0; i < Dimension; ++i) {
+        shape[i] = Resolution[Dimension - 1];
+        texels *= shape[i];
+    }
+
+    Tex tex(shape, channels, use_accel, filter, wrap);
+    dr::PCG32<Float> rng((size_t) texels);
+    tex.set_value(Storage(rng.next_float32()));
+
+    for (int coherent = 1; coherent >= 0; --coherent) {
+        Pos pos = query_positions<Float, Dimension>(coherent);
+
+        std::vector<Float> out(channels);
+        std::vector<Pos> grad(channels);
+        std::vector<Float> fetch(channels << Dimension);
+        dr::Array<Float *, 1 << Dimension> fetch_ptr;
+        for (size_t i = 0; i < (1 << Dimension); ++i)
+            fetch_ptr[i] = fetch.data() + i * channels;
+
+        double time = fastest_launch([&] {
+            switch (method) {
+                case Method::Eval:
+                    tex.eval(pos, out.data());
+                    dr::eval(out);
+                    break;
+
+                case Method::Fetch:
+                    tex.eval_fetch(pos, fetch_ptr);
+                    dr::eval(fetch);
+                    break;
+
+                case Method::Cubic:
+                    tex.eval_cubic(pos, out.data());
+                    dr::eval(out);
+                    break;
+
+                case Method::CubicGrad:
+                    tex.eval_cubic_grad(pos, out.data(), grad.data());
+                    dr::eval(out, grad);
+                    break;
+            }
+        });
+
+        double rate = Queries / time;
+        const char *queries = coherent ? "coherent" : "random";
+        if (bench::Benchmark::json) {
+            printf("{\"name\": \"texture_%s\", \"backend\": \"%s\", "
+                   "\"dim\": %zu, \"channels\": %zu, \"filter\": \"%s\", "
+                   "\"wrap\": \"%s\", \"accel\": %s, \"queries\": \"%s\", "
+                   "\"lookups_per_s\": %.4g}\n",
+                   method_name(method), backend, Dimension, channels,
+                   filter_name(filter), wrap_name(wrap),
+                   use_accel ? "true" : "false", queries, rate);
+        } else {
+            printf("  %-4s %-15s %zuD ch=%zu %-7s %-6s %-8s %-8s %9.2f Mlookups/s\n",
+                   backend, method_name(method), Dimension, channels,
+                   filter_name(filter), wrap_name(wrap),
+                   use_accel ? "accel" : "nonaccel", queries, rate * 1e-6);
+        }
+        fflush(stdout);
+    }
+}
+
+template <typename Float, size_t Dimension>
+void sweep_dimension(const char *backend, bool use_accel) {
+    const FilterMode filters[] = { FilterMode::Nearest, FilterMode::Linear };
+    const WrapMode wraps[] = { WrapMode::Repeat, WrapMode::Clamp,
+                               WrapMode::Mirror };
+    const size_t channels[] = { 1, 4 };
+
+    for (size_t ch : channels) {
+        for (WrapMode wrap : wraps) {
+            for (FilterMode filter : filters)
+                run<Float, Dimension>(backend, use_accel, ch, filter, wrap,
+                                      Method::Eval);
+            for (Method method : { Method::Fetch, Method::Cubic, Method::CubicGrad })
+                run<Float, Dimension>(backend, use_accel, ch,
+                                      FilterMode::Linear, wrap, method);
+        }
+    }
+}
+
+template <typename Float> void sweep(const char *backend, bool use_accel) {
+    sweep_dimension<Float, 1>(backend, use_accel);
+    sweep_dimension<Float, 2>(backend, use_accel);
+    sweep_dimension<Float, 3>(backend, use_accel);
+}
+
+DRJIT_BENCH(texture_llvm) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    if (!jit_has_backend(JitBackend::LLVM))
+        return;
+    sweep<dr::LLVMArray<float>>("llvm", false);
+}
+
+DRJIT_BENCH(texture_cuda) {
+    jit_init((uint32_t) JitBackend::CUDA);
+    if (!jit_has_backend(JitBackend::CUDA))
+        return;
+    sweep<dr::CUDAArray<float>>("cuda", true);
+    sweep<dr::CUDAArray<float>>("cuda", false);
+}
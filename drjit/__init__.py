@@ -58,7 +58,7 @@ import drjit.tensor as tensor # noqa
 self = vars()
 base = self['ArrayBase']
 for k, v in router.__dict__.items():
-    if k.startswith('_') or (k[0].isupper() and not k == 'CustomOp'):
+    if k.startswith('_') or (k[0].isupper() and k not in ('CustomOp', 'ADFuture')):
         continue
     if k.startswith('op_'):
         setattr(base, '__' + k[3:] + '__', v)
@@ -102,4 +102,7 @@ for k, v in tensor.__dict__.items():
         continue
     self[k] = v
 
+# Dispatch same-type arithmetic directly to C++ (bypasses router.py)
+detail.install_fast_paths()
+
 del k, v, self, base, generic, router, matrix, tensor, traits, const, drjit_ext
@@ -56,6 +56,94 @@ def array_name(prefix, vt, shape, scalar):
     )
 
 
+def dlpack_capsule(t, o):
+    '''
+    Obtain a DLPack capsule from an object implementing ``__dlpack__()``. On
+    the CUDA backend, the producer orders Dr.Jit's stream after its own
+    pending work, which avoids a host synchronization.
+    '''
+    if t.IsCUDA:
+        stream = _dr.detail.cuda_stream()
+        return o.__dlpack__(stream=1 if stream == 0 else stream)
+    return o.__dlpack__()
+
+
+def dlpack_extent(shape, strides):
+    '''
+    Return the offset (in elements) of the lowest address referenced by a
+    strided DLPack tensor, and the number of elements spanned by it
+    '''
+    lo, hi = 0, 0
+    for size, stride in zip(shape, strides):
+        if size > 1:
+            if stride < 0:
+                lo += (size - 1) * stride
+            else:
+                hi += (size - 1) * stride
+    return lo, hi - lo + 1
+
+
+def tensor_from_dlpack(tensor_type, obj):
+    '''
+    Create a tensor that references the memory of an object implementing
+    ``__dlpack__()``. Non-contiguous inputs (e.g. transposed or sliced
+    tensors) are wrapped as-is, and their elements are reordered by a single
+    gather that is evaluated lazily along with the computation using it.
+    Returns ``None`` when the object cannot be imported this way.
+    '''
+    array_t = tensor_type.Array
+
+    try:
+        capsule = dlpack_capsule(tensor_type, obj)
+    except Exception:
+        return None
+
+    descr = _dr.detail.from_dlpack(capsule)
+    if descr["dtype"] != array_t.Type or \
+       descr["device_type"] != (2 if array_t.IsCUDA else 1):
+        return None
+
+    shape = descr["shape"]
+    ndim = len(shape)
+    size = _dr.prod(shape)
+    strides = descr["strides"]
+    if strides is None:
+        strides = [0] * ndim
+        tmp = 1
+        for i in reversed(range(ndim)):
+            strides[i] = tmp
+            tmp *= shape[i]
+
+    if ndim == 0:
+        shape = [1]
+    if size == 0:
+        return tensor_type(array_t(), shape)
+
+    contiguous, tmp = True, 1
+    for i in reversed(range(ndim)):
+        if shape[i] != 1:
+            contiguous &= strides[i] == tmp
+            tmp *= shape[i]
+
+    lo, extent = dlpack_extent(shape, strides)
+    descr["consume"](capsule)
+    data = array_t.map_(descr["data"] + lo * array_t.Type.Size, extent,
+                        descr["release"])
+
+    if contiguous:
+        return tensor_type(data, shape)
+
+    index_t = _dr.int32_array_t(array_t)
+    i = _dr.arange(index_t, size)
+    offset = index_t(-lo)
+    for k in reversed(range(ndim)):
+        if shape[k] > 1:
+            offset += (i % shape[k]) * strides[k]
+            i = i // shape[k]
+
+    return tensor_type(array_t.gather_(data, offset, True, False), shape)
+
+
 def array_from_dlpack(t, capsule):
     descr = _dr.detail.from_dlpack(capsule)
 
@@ -95,7 +183,8 @@ def array_from_dlpack(t, capsule):
         value = value.Value
 
     descr["consume"](capsule)
-    data = value.map_(data, _dr.prod(shape), descr["release"])
+    data = value.map_(data, dlpack_extent(shape, strides)[1] if
+                      _dr.prod(shape) > 0 else 0, descr["release"])
 
     def load(t, i, offset):
         size = shape[-1 - i]
@@ -158,8 +247,18 @@ def array_init(self, args):
             is_static_array = is_array and not o.Size == _dr.Dynamic
             is_sequence = issubclass(t, Sequence) and not issubclass(t, str)
 
+            # Bulk copy from objects implementing the buffer protocol. This
+            # includes 1D half precision NumPy arrays, which are converted in
+            # bulk when the target stores single precision values.
+            bulk = None
+            if dynamic and not is_array and hasattr(self, 'load_buffer_') and \
+               (mod != "numpy" or (o.ndim == 1 and o.dtype.char == 'e')):
+                bulk = self.load_buffer_(o)
+
+            if bulk is not None:
+                self.assign(bulk)
             # Matrix initialization from nested list
-            if is_sequence and self.IsMatrix and \
+            elif is_sequence and self.IsMatrix and \
                 len(o) == size and sub_len(o) == size:
                 for x in range(size):
                     for y in range(size):
@@ -261,8 +360,8 @@ def array_init(self, args):
             elif mod == "builtins" and name == "PyCapsule":
                 self.assign(array_from_dlpack(type(self), o))
             elif mod == "torch":
-                from torch.utils.dlpack import to_dlpack
-                self.assign(array_from_dlpack(type(self), to_dlpack(o)))
+                self.assign(array_from_dlpack(type(self),
+                                              dlpack_capsule(self, o)))
             elif mod.startswith("tensorflow."):
                 from tensorflow.experimental.dlpack import to_dlpack
                 self.assign(array_from_dlpack(type(self), to_dlpack(o)))
@@ -303,6 +402,11 @@ def array_init(self, args):
 
 def tensor_init(tensor_type, obj):
     mod = type(obj).__module__
+    if mod.startswith(('torch', 'jax')):
+        result = tensor_from_dlpack(tensor_type, obj)
+        if result is not None:
+            return result
+
     if 'tensorflow' in mod:
         import tensorflow as tf
         return tensor_type(tensor_type.Array(tf.reshape(obj, [-1])), obj.shape)
@@ -475,123 +579,39 @@ def array_configure(cls, shape, type_, value):
         array_name(mask_name, _dr.VarType.Bool, cls.Shape, cls.IsScalar))
 
 
-def _loop_process_state(value: type, in_state: list, out_state: list,
-                        write: bool, in_struct: bool = False):
+def loop_init_state(loop, funcs):
     '''
-    This helper function is used by ``drjit.*.Loop`` to collect the set of loop
-    state variables and ensure that their types stay consistent over time. It
-    traverses a python object tree in ``value`` and writes state variable
-    indices to ``out_state``. If provided, it performs a consistency check
-    against the output of a prior call provided via ``in_state``. If ``write``
-    is set to ``True``, it mutates the input value based on the information in
-    ``in_state``.
+    This helper function is used by ``drjit.*.Loop`` when it is initialized.
+    It registers loop state objects that implement ``loop_put`` and labels
+    the loop state variables after the names they are bound to in the
+    supplied functions. The traversal of the loop state itself is done by
+    the ``Loop`` class, which caches its layout.
     '''
-    t = type(value)
-
-    out_state.append(t)
-    if in_state:
-        assert len(in_state) > 0
-        t_old = in_state.pop()
-        if t is not t_old:
-            raise _dr.Exception(
-                "loop_process_state(): the type of loop state variables must "
-                "remain the same throughout the loop. However, one of the "
-                "supplied variables changed from type %s to %s!"
-                % (t_old.__name__, t.__name__))
-
-    if issubclass(t, tuple) or issubclass(t, list):
-        for entry in value:
-            _loop_process_state(entry, in_state, out_state, write, in_struct)
-        return
-
-    if _dr.is_tensor_v(t):
-        _loop_process_state(value.array, in_state, out_state, write, in_struct)
-    elif _dr.is_jit_v(t):
-        if t.Depth > 1:
-            for i in range(len(value)):
-                _loop_process_state(value.entry_ref_(i), in_state,
-                                    out_state, write, in_struct)
-        else:
-            index = value.index
-            index_ad = value.index_ad if t.IsDiff else 0
-
-            if index_ad != 0 and _dr.flag(_dr.JitFlag.LoopRecord):
-                raise _dr.Exception(
-                    "loop_process_state(): one of the supplied loop state variables "
-                    "of type %s is attached to the AD graph (i.e., grad_enabled(..) "
-                    "is true). However, propagating derivatives through multiple "
-                    "iterations of a recorded loop is not supported (and never "
-                    "will be). Please see the documentation on differentiating loops "
-                    "for details and suggested alternatives." % t.__name__)
-
-            if index == 0:
-                raise _dr.Exception(
-                    "loop_process_state(): one of the supplied loop state "
-                    "variables of type %s is uninitialized!" % t.__name__)
-
-            ad_float_precision = value.Type.Size * 8 if (t.IsDiff and t.IsFloat) else 0
-            out_state.append((index, index_ad, ad_float_precision))
-
-            if in_state:
-                assert len(in_state) > 0
-                index, index_ad, _ = in_state.pop()
-
-                if write:
-                    value.set_index_(index)
-                    if t.IsDiff:
-                        value.set_index_ad_(index_ad)
-    elif _dr.is_struct_v(t):
-        for k, v in t.DRJIT_STRUCT.items():
-            _loop_process_state(getattr(value, k), in_state, out_state, write, True)
-    elif hasattr(value, 'loop_put') or value is None:
-        pass
-    elif not in_struct:
-        raise _dr.Exception(
-            "loop_process_state(): one of the provided loop state variables "
-            "was of type '%s', which is not allowed (you must use Dr.Jit "
-            "arrays/structs that are managed by the JIT compiler)"
-            % t.__name__)
-
-
-def loop_process_state(loop, funcs, state, write):
-    if len(state) == 0:
-        old_state = None
-
-        for func in funcs:
-            values = func()
-
-            if isinstance(values, Sequence) and not isinstance(values, str):
-                for value in values:
-                    if hasattr(value, 'loop_put'):
-                        value.loop_put(loop)
-
-            # Automatically label loop variables
-            cv = inspect.getclosurevars(func)
-            _dr.set_label(**cv.globals)
-            _dr.set_label(**cv.nonlocals)
-
-            del values
-
-        assert old_state is None or len(old_state) == 0
-    else:
-        old_state = list(state)
-        old_state.reverse()
+    for func in funcs:
+        values = func()
 
-    del loop # Keep 'loop' out of the garbage collector's reach
+        if isinstance(values, Sequence) and not isinstance(values, str):
+            for value in values:
+                if hasattr(value, 'loop_put'):
+                    value.loop_put(loop)
 
-    state.clear()
+        # Automatically label loop variables
+        cv = inspect.getclosurevars(func)
+        _dr.set_label(**cv.globals)
+        _dr.set_label(**cv.nonlocals)
 
-    for func in funcs:
-        _loop_process_state(func(), old_state, state, write)
+        del values
 
-    assert old_state is None or len(old_state) == 0
+    del loop # Keep 'loop' out of the garbage collector's reach
 
 
 def slice_tensor(shape, indices, uint32):
     """
     This function takes an array shape (integer tuple) and a tuple containing
     slice indices. It returns the resulting array shape and a flattened 32-bit
-    unsigned integer array containing element indices.
+    unsigned integer array containing element indices. The index is ``None``
+    when the slice selects all elements in their original order, in which case
+    the flat array can be reused as is.
     """
     components = []
     ellipsis = False
@@ -662,6 +682,12 @@ def slice_tensor(shape, indices, uint32):
                 size_out *= shape_out[-1]
     shape_out = tuple(shape_out)
 
+    # Slices that only drop or insert unit dimensions don't need an index
+    comps = [comp for comp in components if comp is not None]
+    if all(not isinstance(comp, uint32) and comp == (0, size, 1)
+           for comp, size in zip(comps, shape)):
+        return shape_out, None
+
     index_tmp = _dr.arange(uint32, size_out)
     index_out = uint32()
 
@@ -699,6 +725,8 @@ def tensor_getitem(tensor, slice_arg):
         slice_arg = (slice_arg,)
     tensor_t = type(tensor)
     shape, index = slice_tensor(tensor.shape, slice_arg, tensor_t.Index)
+    if index is None:
+        return tensor_t(tensor.array, shape)
     return tensor_t(_dr.gather(tensor_t.Array, tensor.array, index), shape)
 
 
@@ -707,6 +735,8 @@ def tensor_setitem(tensor, slice_arg, value):
         slice_arg = (slice_arg,)
     tensor_t = type(tensor)
     shape, index = slice_tensor(tensor.shape, slice_arg, tensor_t.Index)
+    if index is None:
+        index = _dr.arange(tensor_t.Index, len(tensor.array))
     _dr.scatter(target=tensor.array, value=value, index=index)
 
 
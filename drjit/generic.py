@@ -1364,6 +1364,18 @@ def migrate_(a, target):
     return result
 
 
+def migrate_device_(a, device):
+    if not a.IsJIT:
+        raise Exception("Expected a JIT array type!")
+    t = type(a)
+    if a.IsTensor:
+        return t(a.array.migrate_device_(device), a.shape)
+    result = t.empty_(len(a) if a.Size == Dynamic else 0)
+    for i in range(len(a)):
+        result[i] = a[i].migrate_device_(device)
+    return result
+
+
 def index_(a):
     if not a.IsJIT:
         raise Exception("Expected a JIT array type!")
@@ -1630,8 +1642,14 @@ def numpy(a):
     return arr
 
 
-def op_dlpack(a):
+def op_dlpack(a, stream=None):
     struct = a.export_(migrate_to_host=False, version=2)
+    if a.IsCUDA and stream != -1:
+        if stream == 0:
+            raise Exception("__dlpack__(): stream 0 is ambiguous, use 1 to "
+                            "refer to the legacy default stream!")
+        # Make the consumer's stream wait for pending work (no host sync)
+        _dr.detail.cuda_stream_wait(1 if stream is None else stream)
     isize = a.Type.Size
     strides = tuple(k // isize for k in struct["strides"])
     return _dr.detail.to_dlpack(
@@ -1644,9 +1662,16 @@ def op_dlpack(a):
     )
 
 
+def op_dlpack_device(a):
+    if a.IsCUDA:
+        return (2, _dr.device(a))
+    return (1, 0)
+
+
 def torch(a):
     from torch.utils.dlpack import from_dlpack
-    return from_dlpack(a.__dlpack__())
+    # PyTorch passes its current stream to __dlpack__()
+    return from_dlpack(a)
 
 
 def jax(a):
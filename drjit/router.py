@@ -2576,6 +2576,9 @@ def eval(*args):
     During recursion, the function gathers all unevaluated Dr.Jit arrays. Evaluated
     arrays and incompatible types are ignored.
 
+    This is also the only place that polls the threshold of
+    :py:func:`set_malloc_flush_threshold`.
+
     Args:
         *args (tuple): A variable-length list of Dr.Jit array instances,
           :ref:`custom data structures <custom-struct>`, sequences, or mappings.
@@ -2588,6 +2591,8 @@ def eval(*args):
     '''
     if schedule(*args) or len(args) == 0:
         _dr.detail.eval()
+        if _malloc_flush_threshold is not None:
+            _malloc_flush_poll()
 
 
 def graphviz(as_str=False):
@@ -2623,6 +2628,74 @@ def migrate(a, type_):
         return a
 
 
+def migrate_device(a, device):
+    '''
+    Copy a CUDA array (or a custom data structure containing CUDA arrays) into
+    the memory of another device.
+
+    The array is evaluated and copied without a round trip through host memory
+    (the driver uses a peer-to-peer transfer when the two devices support it).
+    Gradient tracking does not carry over to the copy.
+
+    Args:
+        a (object): The input array or data structure
+
+        device (int): Index of the target device (see :py:func:`device_count`)
+
+    Returns:
+        object: A copy of ``a`` residing on ``device``
+    '''
+    if _dr.is_jit_v(a):
+        return a.migrate_device_(device)
+    elif _dr.is_struct_v(a):
+        result = type(a)()
+        for k in type(a).DRJIT_STRUCT.keys():
+            setattr(result, k, migrate_device(getattr(a, k), device))
+        return result
+    elif isinstance(a, _Sequence) and not isinstance(a, str):
+        return type(a)(migrate_device(v, device) for v in a)
+    elif isinstance(a, _Mapping):
+        return { k: migrate_device(v, device) for k, v in a.items() }
+    else:
+        return a
+
+
+def all_reduce(values, devices):
+    '''
+    Sum arrays that reside on different CUDA devices (e.g. the gradients
+    computed by several data-parallel workers) and return one copy of the sum
+    per device.
+
+    The arrays are gathered and summed on the first device, and the sum is
+    then copied to the other devices using :py:func:`migrate_device`.
+
+    Args:
+        values (list): Arrays, where ``values[i]`` resides on the device
+          ``devices[i]``
+
+        devices (list): Device indices
+
+    Returns:
+        list: The sum, with entry ``i`` residing on ``devices[i]``
+    '''
+    if len(values) != len(devices):
+        raise Exception('all_reduce(): the number of arrays (%i) and devices '
+                        '(%i) must match!' % (len(values), len(devices)))
+    if len(values) == 0:
+        return []
+
+    prev = _dr.device()
+    _dr.set_device(devices[0])
+    try:
+        total = values[0]
+        for v in values[1:]:
+            total = total + migrate_device(v, devices[0])
+        _dr.eval(total)
+        return [total] + [migrate_device(total, d) for d in devices[1:]]
+    finally:
+        _dr.set_device(prev)
+
+
 # -------------------------------------------------------------------
 #           Vertical operations -- transcendental functions
 # -------------------------------------------------------------------
@@ -3268,7 +3341,8 @@ def sh_eval(arg, order, /):
     The directions provided to ``sh_eval`` must be normalized 3D vectors
     (i.e. using Cartesian instead of spherical coordinates).
 
-    This function supports evaluation order up to 10 (e.g. ``order=9``).
+    Orders up to 9 use hand-unrolled code, and higher orders use a recurrence
+    over the associated Legendre polynomials.
 
     Args:
         arg (drjit.ArrayBase): A 3D Dr.Jit array type for the direction to be evaluated
@@ -3543,22 +3617,41 @@ def none_nested(arg, /):
     return not b if isinstance(b, bool) else ~b
 
 
-def sum(arg, /):
+def _reduce_axis(name, arg, op, axis):
+    if not _dr.is_tensor_v(arg):
+        raise TypeError("%s(): the 'axis' argument requires a tensor input!" % name)
+    if axis < 0:
+        axis += arg.ndim
+    if axis < 0 or axis >= arg.ndim:
+        raise IndexError("%s(): axis is out of bounds for a tensor with %i "
+                         "dimensions!" % (name, arg.ndim))
+    return arg.reduce_(op, axis)
+
+
+def sum(arg, /, axis=None):
     '''
-    sum(arg, /) -> float | int | drjit.ArrayBase
+    sum(arg, /, axis=None) -> float | int | drjit.ArrayBase
     Compute the sum of all array elements.
 
     When the argument is a dynamic array, function performs a horizontal reduction.
     Please see the section on :ref:`horizontal reductions <horizontal-reductions>`
     for details.
 
+    When ``axis`` is specified, the tensor ``arg`` is only reduced along this
+    dimension, which is removed from the shape of the result. The reduction
+    compiles to a single kernel and is differentiable.
+
     Args:
         arg (float | int | drjit.ArrayBase): A Python or Dr.Jit arithmetic type
 
+        axis (int): Tensor dimension to reduce (optional)
+
     Returns:
         Sum of the input
     '''
-    if _var_is_drjit(arg):
+    if axis is not None:
+        return _reduce_axis('sum', arg, _dr.ReduceOp.Add, axis)
+    elif _var_is_drjit(arg):
         return arg.sum_()
     elif isinstance(arg, float) or isinstance(arg, int):
         return arg
@@ -3598,22 +3691,30 @@ def sum_nested(arg, /):
     return arg
 
 
-def mean(arg, /):
+def mean(arg, /, axis=None):
     '''
-    mean(arg, /) -> float | drjit.ArrayBase
+    mean(arg, /, axis=None) -> float | drjit.ArrayBase
     Compute the mean of all array elements.
 
     When the argument is a dynamic array, function performs a horizontal reduction.
     Please see the section on :ref:`horizontal reductions <horizontal-reductions>`
     for details.
 
+    When ``axis`` is specified, the tensor ``arg`` is only reduced along this
+    dimension (see :py:func:`sum`).
+
     Args:
         arg (float | int | drjit.ArrayBase): A Python or Dr.Jit arithmetic type
 
+        axis (int): Tensor dimension to reduce (optional)
+
     Returns:
         Mean of the input
     '''
-    if hasattr(arg, '__len__'):
+    if axis is not None:
+        v = _reduce_axis('mean', arg, _dr.ReduceOp.Add, axis)
+        return v * (1.0 / arg.shape[axis])
+    elif hasattr(arg, '__len__'):
         v = _dr.sum(arg)
         return _dr.float_array_t(v)(v) / len(arg)
     else:
@@ -3692,22 +3793,30 @@ def prod_nested(arg, /):
     return arg
 
 
-def max(arg, /):
+def max(arg, /, axis=None):
     '''
-    max(arg, /) -> float | int | drjit.ArrayBase
+    max(arg, /, axis=None) -> float | int | drjit.ArrayBase
     Compute the maximum value in the provided input.
 
     When the argument is a dynamic array, function performs a horizontal reduction.
     Please see the section on :ref:`horizontal reductions <horizontal-reductions>`
     for details.
 
+    When ``axis`` is specified, the tensor ``arg`` is only reduced along this
+    dimension (see :py:func:`sum`). Derivatives flow into all entries that
+    attain the maximum.
+
     Args:
         arg (float | int | drjit.ArrayBase): A Python or Dr.Jit arithmetic type
 
+        axis (int): Tensor dimension to reduce (optional)
+
     Returns:
         Maximum of the input
     '''
-    if _var_is_drjit(arg):
+    if axis is not None:
+        return _reduce_axis('max', arg, _dr.ReduceOp.Max, axis)
+    elif _var_is_drjit(arg):
         return arg.max_()
     elif isinstance(arg, float) or isinstance(arg, int):
         return arg
@@ -3746,22 +3855,30 @@ def max_nested(arg, /):
     return arg
 
 
-def min(arg, /):
+def min(arg, /, axis=None):
     '''
-    min(arg, /) -> float | int | drjit.ArrayBase
+    min(arg, /, axis=None) -> float | int | drjit.ArrayBase
     Compute the minimum value in the provided input.
 
     When the argument is a dynamic array, function performs a horizontal reduction.
     Please see the section on :ref:`horizontal reductions <horizontal-reductions>`
     for details.
 
+    When ``axis`` is specified, the tensor ``arg`` is only reduced along this
+    dimension (see :py:func:`sum`). Derivatives flow into all entries that
+    attain the minimum.
+
     Args:
         arg (float | int | drjit.ArrayBase): A Python or Dr.Jit arithmetic type
 
+        axis (int): Tensor dimension to reduce (optional)
+
     Returns:
         Minimum of the input
     '''
-    if _var_is_drjit(arg):
+    if axis is not None:
+        return _reduce_axis('min', arg, _dr.ReduceOp.Min, axis)
+    elif _var_is_drjit(arg):
         return arg.min_()
     elif isinstance(arg, float) or isinstance(arg, int):
         return arg
@@ -4011,6 +4128,53 @@ def block_sum(value, size):
         raise Exception("block_sum(): requires a JIT array!")
 
 
+def argsort(value):
+    '''
+    Compute the permutation that stably sorts a 1D JIT array in ascending order
+
+    The implementation is a least significant digit radix sort built on
+    :py:func:`drjit.prefix_sum`. It supports 32 and 64-bit integer and
+    floating point keys. Since it evaluates its input and launches several
+    kernels, it cannot be used in recorded loops or virtual function calls.
+
+    Args:
+        value (drjit.ArrayBase): A 1D JIT array containing the sort keys
+
+    Returns:
+        drjit.ArrayBase: An unsigned 32-bit integer array with the index of
+        the key that goes to each position of the sorted output.
+    '''
+    if _dr.is_jit_v(value) and _dr.depth_v(value) == 1 and \
+            hasattr(value, 'argsort_'):
+        return value.argsort_()
+    else:
+        raise Exception("argsort(): requires a 1D JIT array with 32 or "
+                        "64-bit entries!")
+
+
+def sort(value):
+    '''
+    Sort a 1D JIT array in ascending order (see :py:func:`drjit.argsort`)
+    '''
+    return _dr.gather(type(value), value, argsort(value))
+
+
+def sort_by_key(keys, values):
+    '''
+    Sort ``keys`` in ascending order and reorder ``values`` accordingly
+
+    The sort is stable (see :py:func:`drjit.argsort`). ``values`` can be any
+    Dr.Jit array or custom data structure that supports
+    :py:func:`drjit.gather`, and gradients propagate through the reordering.
+
+    Returns:
+        tuple: The sorted keys and the correspondingly reordered values
+    '''
+    perm = argsort(keys)
+    return (_dr.gather(type(keys), keys, perm),
+            _dr.gather(type(values), values, perm))
+
+
 def binary_search(start, end, pred):
     '''
     Perform binary search over a range given a predicate ``pred``, which
@@ -4276,6 +4440,68 @@ def accum_grad(dst, src):
             accum_grad(getattr(dst, k), getattr(src, k) if ve else src)
 
 
+def set_grad_sparse(arg, value=True):
+    '''
+    Record the gradients of gather operations from ``arg`` sparsely.
+
+    The reverse-mode derivative of :py:func:`drjit.gather` normally scatters
+    into a dense zero-initialized array matching the size of the source, which
+    is wasteful when a large parameter buffer is accessed at only a few
+    locations. When this feature is enabled, the AD backend instead records
+    pairs of row indices and gradient values that can be queried via
+    :py:func:`drjit.grad_sparse`. :py:func:`drjit.grad` still returns the
+    equivalent dense gradient. Only leaf variables (i.e., parameters) support
+    this mode.
+
+    Args:
+        arg (object): An arbitrary Dr.Jit array, tensor,
+          :ref:`custom data structure <custom-struct>`, sequence, or mapping.
+
+        value (bool): Enable or disable sparse gradient storage.
+    '''
+    if _dr.is_diff_v(arg) and arg.IsFloat:
+        if _dr.is_tensor_v(arg):
+            arg = arg.array
+        if arg.Depth > 1:
+            for i in range(len(arg)):
+                set_grad_sparse(arg[i], value)
+        else:
+            arg.set_grad_sparse_(value)
+    elif isinstance(arg, _Sequence) and not isinstance(arg, str):
+        for v in arg:
+            set_grad_sparse(v, value)
+    elif isinstance(arg, _Mapping):
+        for v in arg.values():
+            set_grad_sparse(v, value)
+    elif _dr.is_struct_v(arg):
+        for k in type(arg).DRJIT_STRUCT.keys():
+            set_grad_sparse(getattr(arg, k), value)
+
+
+def grad_sparse(arg):
+    '''
+    Return the sparse gradient of a flat array or tensor.
+
+    This requires an earlier call to :py:func:`drjit.set_grad_sparse`. The
+    result is a tuple ``(rows, values)`` where ``rows`` may contain duplicates,
+    in which case the associated values must be added. Masked gathers produce
+    entries with row zero and a value of zero.
+
+    Args:
+        arg (object): A differentiable flat Dr.Jit array or tensor.
+
+    Returns:
+        tuple: The row indices as a :py:class:`drjit.UInt32`-style array and
+        the associated gradient values.
+    '''
+    if _dr.is_tensor_v(arg):
+        arg = arg.array
+    if not (_dr.is_diff_v(arg) and arg.IsFloat and arg.Depth == 1):
+        raise TypeError("grad_sparse(): expected a flat differentiable "
+                        "floating point array!")
+    return arg.grad_sparse_()
+
+
 def grad_enabled(*args):
     '''
     Return whether gradient tracking is enabled on any of the given variables.
@@ -4523,6 +4749,18 @@ def traverse(dtype, mode, flags=_dr.ADFlag.Default):
     - ``ADFlag.ClearVertices``: clear gradients of processed vertices only, but leave edges intact
     - ``ADFlag.Default``: clear everything (default behaviour)
 
+    In addition, ``ADFlag.Parallel`` can be combined with the above to
+    propagate the gradients of independent variables on the thread pool during
+    backward traversal (LLVM backend only, the results are identical).
+    ``ADFlag.Compensated`` switches the accumulation of gather (backward mode)
+    and scatter-add (forward mode) derivatives to Kahan summation via
+    :py:func:`drjit.scatter_reduce_kahan`, which improves the accuracy of
+    single precision gradients that receive many contributions per entry.
+    ``ADFlag.Async`` periodically evaluates the gradients accumulated during
+    the traversal, which lets the device run the resulting kernels while the
+    host traverses the remainder of the graph (see
+    :py:func:`drjit.backward_async`).
+
     Args:
         dtype (type): defines the Dr.JIT array type used to build the AD graph
 
@@ -4696,6 +4934,144 @@ def backward_to(*args, flags=_dr.ADFlag.Default):
     return grad(args) if len(args) > 1 else grad(*args)
 
 
+def backward_batch(arg, grads, inputs, flags=_dr.ADFlag.Default):
+    '''
+    Backward propagate a sequence of gradients from a Dr.Jit differentiable
+    array and return the resulting gradients of ``inputs``.
+
+    This function computes one vector-Jacobian product per entry of ``grads``.
+    The AD computational graph is retained until the last traversal, which
+    avoids recording the computation once per cotangent. The returned
+    gradients are not evaluated, hence a subsequent :py:func:`drjit.eval` can
+    compute all of them using a single kernel launch.
+
+    Args:
+        arg (object): A Dr.Jit differentiable array instance.
+
+        grads (list): A list of gradients (cotangents) that are compatible with
+          ``arg``.
+
+        inputs (object): A Dr.Jit differentiable array, tensor,
+          :ref:`custom data structure <custom-struct>`, sequence, or mapping.
+
+        flags (ADFlag | int): flags to control what should and should not be
+          destructed during the last traversal. The default value is
+          ``ADFlag.Default``.
+
+    Returns:
+        list: the gradients of ``inputs``, one entry per element of ``grads``.
+    '''
+    ta = type(arg)
+    _check_grad_enabled('backward_batch', ta, arg)
+
+    # Deduplicate components if 'a' is a vector
+    if _dr.depth_v(arg) > 1:
+        arg = arg + ta(0)
+
+    result = []
+    for i, g in enumerate(grads):
+        flags_i = int(flags)
+        if i + 1 < len(grads):
+            flags_i &= ~int(_dr.ADFlag.ClearEdges)
+
+        set_grad(arg, g)
+        enqueue(_dr.ADMode.Backward, arg)
+        traverse(ta, _dr.ADMode.Backward, flags_i)
+
+        result.append(grad(inputs))
+        set_grad(inputs, 0)
+
+    return result
+
+
+def set_record_hessian(dtype, value):
+    '''
+    Record the second-order terms of subsequently created differentiable
+    operations on the current thread.
+
+    This is needed by :py:func:`drjit.hvp`, and it slightly increases the
+    cost of recording the AD graph. Recording is disabled by default.
+
+    Args:
+        dtype (type): defines the Dr.JIT array type used to build the AD graph
+
+        value (bool): whether to record second-order terms
+    '''
+    dtype = _dr.leaf_array_t(dtype)
+
+    if not _dr.is_diff_v(dtype):
+        raise Exception('set_record_hessian(): expected a differentiable array type!')
+
+    dtype.set_record_hessian_(value)
+
+
+def record_hessian(dtype):
+    '''
+    Return whether second-order terms are recorded (see
+    :py:func:`drjit.set_record_hessian`).
+
+    Args:
+        dtype (type): defines the Dr.JIT array type used to build the AD graph
+
+    Returns:
+        bool: ``True`` if second-order terms are recorded.
+    '''
+    dtype = _dr.leaf_array_t(dtype)
+
+    if not _dr.is_diff_v(dtype):
+        return False
+
+    return dtype.record_hessian_()
+
+
+def hvp(arg, inputs, v, flags=_dr.ADFlag.Default):
+    '''
+    Return the product of the Hessian of ``arg`` with respect to ``inputs`` and
+    the direction ``v``.
+
+    The product is computed by differentiating the reverse-mode traversal of
+    the recorded AD graph in forward mode, which does not require building a
+    graph of the gradient computation. Its cost is therefore of the same order
+    as that of computing the gradient, and it can be evaluated repeatedly
+    (e.g., within a conjugate gradient solver) when ``flags`` retains the
+    graph. The graph must have been recorded while
+    :py:func:`drjit.set_record_hessian` was active. Computation that depends
+    on ``inputs`` via :py:class:`drjit.CustomOp`, differentiable virtual
+    function calls, or horizontal products is not supported and raises an
+    exception. The components of a vector-valued ``arg`` are summed.
+
+    Args:
+        arg (object): A Dr.Jit differentiable array instance.
+
+        inputs (object): A Dr.Jit differentiable array, tensor,
+          :ref:`custom data structure <custom-struct>`, sequence, or mapping.
+
+        v (object): the direction, which must be compatible with ``inputs``.
+
+        flags (ADFlag | int): flags to control what should and should not be
+          destructed during the final traversal. The default value is
+          ``ADFlag.Default``.
+
+    Returns:
+        object: the Hessian-vector product, which has the same layout as
+        ``inputs``.
+    '''
+    ta = type(arg)
+    _check_grad_enabled('hvp', ta, arg)
+
+    while _dr.depth_v(arg) > 1:
+        arg = _dr.sum(arg)
+
+    set_grad(inputs, v)
+    enqueue(_dr.ADMode.Forward, inputs)
+    set_grad(arg, 1)
+    arg.hvp_(int(flags))
+
+    result = grad(inputs)
+    set_grad(inputs, 0)
+    return result
+
+
 def backward(arg, flags=_dr.ADFlag.Default):
     '''
     Backward propagate gradients from a provided Dr.Jit differentiable array.
@@ -4714,6 +5090,43 @@ def backward(arg, flags=_dr.ADFlag.Default):
     backward_from(arg, flags)
 
 
+class ADFuture:
+    '''
+    Future-like handle returned by :py:func:`drjit.backward_async`.
+
+    The resulting gradients can be used right away, since subsequent
+    computation is ordered after the kernels launched by the traversal.
+    '''
+
+    def wait(self):
+        '''
+        Block until the kernels launched by the traversal have finished.
+        '''
+        _dr.sync_thread()
+
+
+def backward_async(arg, flags=_dr.ADFlag.Default):
+    '''
+    Asynchronous version of :py:func:`drjit.backward`.
+
+    The traversal periodically evaluates the gradients accumulated so far, so
+    that the device executes the corresponding kernels while the remainder of
+    the graph is traversed on the host (see ``ADFlag.Async``). The final
+    gradients are launched without waiting for their completion.
+
+    Args:
+        arg (object): A Dr.Jit differentiable array instance.
+
+        flags (ADFlag | int): flags to control what should and should not be
+          destructed during the traversal. The default value is ``ADFlag.Default``.
+
+    Returns:
+        ADFuture: A handle to wait for the completion of the traversal.
+    '''
+    backward_from(arg, flags | _dr.ADFlag.Async)
+    return ADFuture()
+
+
 # -------------------------------------------------------------------
 #                      Initialization operations
 # -------------------------------------------------------------------
@@ -5359,6 +5772,294 @@ class scoped_set_flag:
     def __exit__(self, exc_type, exc_val, exc_tb):
         _dr.set_flag(self.flag, self.backup)
 
+# -------------------------------------------------------------------
+#                     Memory allocator statistics
+# -------------------------------------------------------------------
+
+_mem_units = { 'B': 1, 'KiB': 1 << 10, 'MiB': 1 << 20, 'GiB': 1 << 30,
+               'TiB': 1 << 40 }
+
+_malloc_types = { 'host': _dr.AllocType.Host,
+                  'host-async': _dr.AllocType.HostAsync,
+                  'host-pinned': _dr.AllocType.HostPinned,
+                  'device': _dr.AllocType.Device }
+
+
+def malloc_stats():
+    '''
+    Return the memory usage of the JIT allocator for each allocation type.
+
+    The allocator keeps released memory in a cache for later reuse. For a
+    long-running process, a large ``cached`` value relative to ``peak``
+    indicates that :py:func:`flush_malloc_cache` can return memory to the
+    system without slowing down subsequent allocations.
+
+    Returns:
+        dict: Maps the allocation types (``'host'``, ``'host-async'``,
+        ``'host-pinned'``, ``'device'``) to dictionaries with the entries
+        ``used`` (bytes held by live allocations), ``allocated`` (bytes
+        obtained from the system, including the cache), ``cached``
+        (``allocated - used``) and ``peak`` (high-water mark of ``used``
+        since :py:func:`malloc_clear_statistics`). With drjit-core revisions
+        that don't export ``jit_malloc_stats()``, the sizes are parsed from
+        :py:func:`whos_str` and only accurate to three significant digits.
+    '''
+    if not hasattr(_dr.detail, 'malloc_stats'):
+        return _malloc_stats_whos()
+
+    result = {}
+    for name, t in _malloc_types.items():
+        used, allocated, peak = _dr.detail.malloc_stats(t)
+        result[name] = {
+            'used': used,
+            'allocated': allocated,
+            'cached': max(allocated - used, 0),
+            'peak': peak
+        }
+    return result
+
+
+def _malloc_stats_whos():
+    import re
+    size = r'([0-9.]+) ([KMGT]?i?B)'
+    pattern = re.compile(r'-\s*([a-z-]+)\s*:\s*%s/%s used \(peak: %s\)'
+                         % (size, size, size))
+
+    def parse(value, unit):
+        return int(float(value) * _mem_units[unit])
+
+    result = {}
+    for match in pattern.finditer(_dr.whos_str()):
+        g = match.groups()
+        used, allocated = parse(g[1], g[2]), parse(g[3], g[4])
+        result[g[0]] = {
+            'used': used,
+            'allocated': allocated,
+            'cached': max(allocated - used, 0),
+            'peak': parse(g[5], g[6])
+        }
+    return result
+
+
+_malloc_flush_threshold = None
+_malloc_flush_interval = 1.0
+_malloc_flush_polled = 0.0
+
+
+def set_malloc_flush_threshold(threshold, interval=1.0):
+    '''
+    Periodically flush the cache of the JIT allocator once it grows past a
+    threshold (best effort).
+
+    This is a convenience helper implemented in Python, not a limit of the
+    allocator. At most once every ``interval`` seconds, :py:func:`drjit.eval`
+    polls :py:func:`malloc_stats`. When the cached bytes of any allocation type
+    exceed ``threshold``, it calls :py:func:`flush_malloc_cache`, which releases
+    the *entire* cache of all allocation types (not just the excess).
+
+    Since nothing happens outside of explicit calls to :py:func:`drjit.eval`
+    from Python, the cache can grow arbitrarily beyond the threshold in the
+    meantime (e.g., during evaluations triggered by reading array contents or
+    by C++ code). Call :py:func:`drjit.eval` at a regular point of the
+    workload (e.g., once per iteration) to use this helper, and expect
+    subsequent allocations to be slower after each flush.
+
+    Args:
+        threshold (int): Number of cached bytes that triggers a flush, or
+          ``None`` to disable periodic flushing (the default).
+
+        interval (float): Minimum time between two polls in seconds.
+    '''
+    global _malloc_flush_threshold, _malloc_flush_interval
+    if threshold is not None and threshold < 0:
+        raise Exception('set_malloc_flush_threshold(): the threshold must be '
+                        'non-negative!')
+    _malloc_flush_threshold = threshold
+    _malloc_flush_interval = interval
+
+
+def malloc_flush_threshold():
+    '''
+    Return the threshold set by :py:func:`set_malloc_flush_threshold` (or
+    ``None``).
+    '''
+    return _malloc_flush_threshold
+
+
+def _malloc_flush_poll():
+    import time
+    global _malloc_flush_polled
+    now = time.monotonic()
+    if now - _malloc_flush_polled < _malloc_flush_interval:
+        return
+    _malloc_flush_polled = now
+
+    stats = malloc_stats()
+    if any(v['cached'] > _malloc_flush_threshold for v in stats.values()):
+        _dr.flush_malloc_cache()
+
+# -------------------------------------------------------------------
+#                   Persistent kernel cache
+# -------------------------------------------------------------------
+
+def kernel_cache_dir():
+    '''
+    Return the directory of the persistent kernel cache, where compiled
+    kernels are stored as ``<hash>.<backend>.bin`` files. The cache is shared
+    by all Dr.Jit processes of the current user.
+
+    The location is derived in the same way as by drjit-core, which places
+    the cache in ``$HOME/.drjit`` on Linux/macOS, and in
+    ``%LOCALAPPDATA%\\Temp\\drjit`` on Windows. Changing these environment
+    variables before Dr.Jit is initialized therefore relocates the cache of
+    both drjit-core and this function.
+    '''
+    import os, sys
+    if sys.platform == 'win32':
+        base = os.environ.get('LOCALAPPDATA')
+        if base is None:
+            base = os.path.join(os.path.expanduser('~'), 'AppData', 'Local')
+        return os.path.join(base, 'Temp', 'drjit')
+    base = os.environ.get('HOME')
+    if base is None:
+        base = os.path.expanduser('~')
+    return os.path.join(base, '.drjit')
+
+
+def _kernel_cache_files(path):
+    import os, re
+    pattern = re.compile(r'^([0-9a-f]{32})\.(cuda|llvm)\.bin$')
+    try:
+        names = os.listdir(path)
+    except FileNotFoundError:
+        return []
+    result = []
+    for name in names:
+        match = pattern.match(name)
+        if match:
+            result.append((name, match.group(1), match.group(2)))
+    return result
+
+
+def kernel_cache(path=None):
+    '''
+    List the kernels stored in the persistent kernel cache.
+
+    Args:
+        path (str): Cache directory (defaults to :py:func:`kernel_cache_dir`)
+
+    Returns:
+        list: One dictionary per kernel with the entries ``hash`` (str, as
+        reported by :py:func:`kernel_history`), ``backend``
+        (:py:class:`drjit.JitBackend`), ``file_size`` (bytes) and ``mtime``
+        (seconds since the epoch), sorted by modification time.
+    '''
+    import os
+    path = kernel_cache_dir() if path is None else os.fspath(path)
+    result = []
+    for name, h, backend in _kernel_cache_files(path):
+        st = os.stat(os.path.join(path, name))
+        result.append({
+            'hash': h,
+            'backend': _dr.JitBackend.CUDA if backend == 'cuda'
+                       else _dr.JitBackend.LLVM,
+            'file_size': st.st_size,
+            'mtime': st.st_mtime
+        })
+    result.sort(key=lambda k: k['mtime'])
+    return result
+
+
+def _kernel_cache_copy(source, target, hashes):
+    import os, shutil
+    os.makedirs(target, exist_ok=True)
+    count = 0
+    for name, h, _ in _kernel_cache_files(source):
+        if hashes is not None and h not in hashes:
+            continue
+        dst = os.path.join(target, name)
+        if os.path.exists(dst):
+            continue
+        # Copy and rename, so that concurrent readers never see partial files
+        tmp = '%s.%i.tmp' % (dst, os.getpid())
+        shutil.copyfile(os.path.join(source, name), tmp)
+        os.replace(tmp, dst)
+        count += 1
+    return count
+
+
+def kernel_cache_export(path, hashes=None):
+    '''
+    Copy kernels from the persistent kernel cache into the directory ``path``
+    (e.g. a location shared by several machines or containers). Kernels that
+    already exist there are skipped.
+
+    Args:
+        path (str): Target directory
+
+        hashes (list): Only export kernels with these hashes (e.g. those
+          returned by :py:func:`warm_up`). Exports all kernels by default.
+
+    Returns:
+        int: The number of copied kernels
+    '''
+    import os
+    if hashes is not None:
+        hashes = set(hashes)
+    return _kernel_cache_copy(kernel_cache_dir(), os.fspath(path), hashes)
+
+
+def kernel_cache_import(path):
+    '''
+    Copy kernels from the directory ``path`` (previously populated by
+    :py:func:`kernel_cache_export`) into the persistent kernel cache. Kernels
+    requested afterwards are loaded from there instead of being compiled.
+
+    Returns:
+        int: The number of copied kernels
+    '''
+    import os
+    return _kernel_cache_copy(os.fspath(path), kernel_cache_dir(), None)
+
+
+def warm_up(func, *args, **kwargs):
+    '''
+    Run a representative workload to compile its kernels ahead of time.
+
+    The function ``func`` is called with the given arguments and its result is
+    evaluated. All kernels compiled along the way end up in the in-memory and
+    persistent kernel caches, so that later runs of the same workload (in this
+    or in another process) skip compilation. Kernels don't depend on the array
+    sizes, hence ``func`` can be run on small inputs.
+
+    Returns:
+        tuple: The result of ``func`` and a list of the launched kernels in the
+        format of :py:func:`kernel_history`, whose ``hash`` entries can be
+        passed to :py:func:`kernel_cache_export`.
+    '''
+    with scoped_set_flag(_dr.JitFlag.KernelHistory, True):
+        result = func(*args, **kwargs)
+        _dr.eval(result)
+        _dr.sync_thread()
+        kernels = _dr.kernel_history([_dr.KernelType.JIT])
+    return result, kernels
+
+
+def trace_save(path):
+    '''
+    Write the timeline events recorded since :py:func:`trace_enable` to the
+    file ``path`` in the Chrome trace event format, which can be opened in
+    ``chrome://tracing`` or `Perfetto <https://ui.perfetto.dev>`_.
+
+    Events are recorded for evaluations (category ``jit``, covering code
+    generation, compilation and kernel launches), :py:class:`drjit.Scope`
+    regions (``python``), the phases of AD traversals (``ad``) and the
+    instance buckets of vectorized method calls (``vcall``).
+    '''
+    import os
+    with open(os.fspath(path), 'w') as f:
+        f.write(_dr.trace_export())
+
 # -------------------------------------------------------------------
 #                        Enabling/disabling AD
 # -------------------------------------------------------------------
@@ -5563,6 +6264,55 @@ def isolate_grad(when=True):
     return _ADContextManager(_dr.detail.ADScope.Isolate, None, [])
 
 
+class _IsolatedGraphContextManager:
+    def __init__(self, array_types):
+        self.array_types = array_types
+
+    def __enter__(self):
+        for t in self.array_types:
+            t.set_isolated_graph_(True)
+
+    def __exit__(self, exc_type, exc_val, exc_tb):
+        for t in self.array_types:
+            t.set_isolated_graph_(False)
+
+
+def isolated_graph(dtype=None):
+    '''
+    Context manager to record the AD graph of the current thread in a private
+    data structure.
+
+    By default, all threads share a single AD graph that is protected by locks.
+    When many threads each differentiate an independent computation (e.g., to
+    compute per-request gradients), this context manager avoids the associated
+    lock contention by redirecting AD variables created by the current thread
+    into a private graph. Such variables cannot be combined with variables of
+    the global graph or of other threads, which raises an exception. The
+    private graph persists until the thread exits, hence its variables remain
+    usable when the context manager is entered again. Variables that outlive
+    the thread keep its graph alive (now protected by locks) until they are
+    released.
+
+    Args:
+        dtype (type): The Dr.Jit array type whose AD graph should be isolated.
+          When not specified, this applies to all differentiable floating point
+          types of the CUDA and LLVM backends.
+    '''
+    if dtype is not None:
+        dtype = _dr.leaf_array_t(dtype)
+        if not _dr.is_diff_v(dtype) or not _dr.is_floating_point_v(dtype):
+            raise Exception('isolated_graph(): expected a differentiable '
+                            'floating point array type!')
+        types = [dtype]
+    else:
+        types = []
+        if hasattr(_dr, 'cuda'):
+            types += [_dr.cuda.ad.Float32, _dr.cuda.ad.Float64]
+        if hasattr(_dr, 'llvm'):
+            types += [_dr.llvm.ad.Float32, _dr.llvm.ad.Float64]
+    return _IsolatedGraphContextManager(types)
+
+
 # -------------------------------------------------------------------
 #             Automatic differentation of custom functions
 # -------------------------------------------------------------------
@@ -5818,6 +6568,71 @@ def custom(cls, *args, **kwargs):
     return output
 
 
+def checkpoint(func, *args):
+    '''
+    Evaluate ``func(*args)`` without recording its intermediate steps in the
+    AD graph and recompute them on demand during differentiation.
+
+    Dr.Jit normally retains the edge weights (i.e., partial derivatives) of
+    every differentiable operation until the graph is traversed. For long
+    chains of operations, this can require a significant amount of memory.
+    This function instead evaluates ``func`` with detached inputs and only
+    stores the (primal) input arguments along with a single node in the AD
+    graph. When this node is later traversed in forward or backward mode, the
+    function is evaluated a second time with gradient tracking enabled, and
+    derivatives are propagated through the recomputed subgraph, which is then
+    immediately released.
+
+    This trades additional computation for a reduced memory footprint
+    (*gradient checkpointing* or *rematerialization*). The function should only
+    depend differentiably on its arguments, and it must produce identical
+    results when evaluated twice.
+
+    Args:
+        func (object): A Python callable.
+
+        *args (tuple): A variable-length list of Dr.Jit arrays,
+          :ref:`custom data structures <custom-struct>`, sequences, or mappings
+          that will be passed to ``func``.
+
+    Returns:
+        object: The return value of ``func(*args)``.
+    '''
+    @_dr.detail.traverse()
+    def ad_copy(arg):
+        return arg.copy_() if _dr.is_diff_v(arg) else arg
+
+    class Checkpoint(CustomOp):
+        def eval(self, func, args):
+            self.func = func
+            self.args = args
+            return func(*args)
+
+        def replay(self):
+            args = ad_copy(self.args)
+            _dr.enable_grad(args)
+            return args, self.func(*args)
+
+        def forward(self):
+            args, result = self.replay()
+            _dr.set_grad(args, self.grad_in('args'))
+            _dr.enqueue(_dr.ADMode.Forward, args)
+            _dr.traverse(_dr.leaf_array_t(args), _dr.ADMode.Forward)
+            self.set_grad_out(_dr.grad(result))
+
+        def backward(self):
+            args, result = self.replay()
+            _dr.set_grad(result, self.grad_out())
+            _dr.enqueue(_dr.ADMode.Backward, result)
+            _dr.traverse(_dr.leaf_array_t(args), _dr.ADMode.Backward)
+            self.set_grad_in('args', _dr.grad(args))
+
+        def name(self):
+            return "Checkpoint[%s]" % getattr(self.func, '__name__', 'unnamed')
+
+    return _dr.custom(Checkpoint, func, args)
+
+
 def wrap_ad(source: str, target: str):
     '''
     Function decorator that wraps the excecution of a function using a different
@@ -6107,6 +6922,20 @@ def get_cmake_dir():
 #             Function dispatch and polymorphism routines
 # -------------------------------------------------------------------
 
+def _switch_wrap(funcs, wrap):
+    # Repeated callables map to the same wrapper, which switch_record_() traces once
+    cache = {}
+    result = []
+    for func in funcs:
+        if func is not None:
+            key = id(func)
+            if key not in cache:
+                cache[key] = wrap(func)
+            func = cache[key]
+        result.append(func)
+    return result
+
+
 def switch(indices, funcs, *args):
     """
     Dispatches a call to one of the given functions based on the given indices.
@@ -6126,6 +6955,9 @@ def switch(indices, funcs, *args):
 
         # [10.0, 200.0, 300.0, 40.0]
 
+    When method call recording is enabled, a function that occurs several
+    times in ``funcs`` is only traced once, unless it performs side effects.
+
     Args:
         indices (drjit.ArrayBase): a list of indices to choose the functions
         funcs (list): a list of functions to dispatch based on ``indices``
@@ -6188,9 +7020,7 @@ def switch(indices, funcs, *args):
             def __call__(self, *args, **kwargs):
                 return ad_copy(self.func(*args, **kwargs))
 
-        funcs = [
-            ADCopyWrapper(func) if func is not None else None for func in funcs
-        ]
+        funcs = _switch_wrap(funcs, ADCopyWrapper)
 
         class DiffSwitch(_dr.CustomOp):
             def eval(self, indices, funcs, args):
@@ -6225,7 +7055,7 @@ def switch(indices, funcs, *args):
 
                     return fwd
 
-                funcs_fwd = [generate(func) for func in self.funcs]
+                funcs_fwd = _switch_wrap(self.funcs, generate)
                 args_value_grad = tuple(zip(self.args, self.grad_in('args') ))
                 grad_out = mod.switch_record_(self.indices, funcs_fwd, *args_value_grad)
                 self.set_grad_out(grad_out)
@@ -6247,7 +7077,7 @@ def switch(indices, funcs, *args):
 
                     return bwd
 
-                funcs_bwd = [generate(func) for func in self.funcs]
+                funcs_bwd = _switch_wrap(self.funcs, generate)
                 grad_in = mod.switch_record_(self.indices, funcs_bwd, self.grad_out(), *self.args)
                 self.set_grad_in('args', grad_in)
 
@@ -1,6 +1,7 @@
 from typing import Type
 import drjit as _dr
 from collections.abc import Sequence as _Sequence
+import os as _os
 
 def upsample(t, shape=None, scale_factor=None):
     '''
@@ -138,3 +139,275 @@ def upsample(t, shape=None, scale_factor=None):
             stride *= t.shape[i]
 
         return type(t)(_dr.gather(type(t.array), t.array, index), shape)
+
+
+def _check_float_tensor(name, *args):
+    for t in args:
+        if not _dr.is_tensor_v(t) or not _dr.is_float_v(t):
+            raise TypeError("%s(): expected a floating point Dr.Jit tensor!" % name)
+
+
+def conv2d(input, weight, stride=1, padding=0):
+    '''
+    conv2d(input, weight, stride=1, padding=0)
+    Convolve a channels-last image tensor with a set of filters.
+
+    The convolution is evaluated by a single kernel that reads the input
+    directly (no intermediate im2col buffer) and is differentiable with
+    respect to both the input and the weights.
+
+    Args:
+        input (object): Input tensor of shape ``([batch,] height, width, in_channels)``
+
+        weight (object): Filter tensor of shape ``(kernel_height, kernel_width, in_channels, out_channels)``
+
+        stride (int): Step between successive filter positions
+
+        padding (int): Number of zero-valued pixels added to every side of the input
+
+    Returns:
+        object: Tensor of shape ``([batch,] out_height, out_width, out_channels)``
+    '''
+    _check_float_tensor('conv2d', input, weight)
+    return input.conv2d_(weight, stride, padding)
+
+
+def conv3d(input, weight, stride=1, padding=0):
+    '''
+    conv3d(input, weight, stride=1, padding=0)
+    Convolve a channels-last volume tensor with a set of filters.
+
+    This function is the 3D analog of :py:func:`conv2d`. The input has the
+    shape ``([batch,] depth, height, width, in_channels)`` and the weights
+    ``(kernel_depth, kernel_height, kernel_width, in_channels, out_channels)``.
+    '''
+    _check_float_tensor('conv3d', input, weight)
+    return input.conv3d_(weight, stride, padding)
+
+
+def avg_pool2d(input, kernel_size, stride=None):
+    '''
+    avg_pool2d(input, kernel_size, stride=None)
+    Average a channels-last image tensor over square windows.
+
+    Args:
+        input (object): Input tensor of shape ``([batch,] height, width, channels)``
+
+        kernel_size (int): Window size
+
+        stride (int): Step between successive windows (defaults to ``kernel_size``)
+
+    Returns:
+        object: The pooled tensor
+    '''
+    _check_float_tensor('avg_pool2d', input)
+    return input.pool2d_(_dr.ReduceOp.Add, kernel_size, stride or 0)
+
+
+def max_pool2d(input, kernel_size, stride=None):
+    '''
+    max_pool2d(input, kernel_size, stride=None)
+    Compute the maximum of a channels-last image tensor over square windows.
+
+    See :py:func:`avg_pool2d` for a description of the arguments. Derivatives
+    flow into all entries of a window that attain its maximum.
+    '''
+    _check_float_tensor('max_pool2d', input)
+    return input.pool2d_(_dr.ReduceOp.Max, kernel_size, stride or 0)
+
+
+def avg_pool3d(input, kernel_size, stride=None):
+    '''
+    avg_pool3d(input, kernel_size, stride=None)
+    3D analog of :py:func:`avg_pool2d`.
+    '''
+    _check_float_tensor('avg_pool3d', input)
+    return input.pool3d_(_dr.ReduceOp.Add, kernel_size, stride or 0)
+
+
+def max_pool3d(input, kernel_size, stride=None):
+    '''
+    max_pool3d(input, kernel_size, stride=None)
+    3D analog of :py:func:`max_pool2d`.
+    '''
+    _check_float_tensor('max_pool3d', input)
+    return input.pool3d_(_dr.ReduceOp.Max, kernel_size, stride or 0)
+
+
+def resample(source, shape, filter=_dr.ResampleFilter.Tent):
+    '''
+    resample(source, shape, filter=drjit.ResampleFilter.Tent)
+    Resample the input tensor or texture to the provided shape.
+
+    The resampling is performed by one separable pass per dimension whose size
+    changes. When downsampling, the filter is widened by the downsampling
+    factor so that it also acts as an antialiasing prefilter. The operation is
+    differentiable with respect to the values of ``source``.
+
+    Args:
+        source (object): A Dr.Jit tensor or texture type.
+
+        shape (list): The target shape. Trailing entries that are not
+          specified are left unchanged (e.g., the channel count).
+
+        filter (drjit.ResampleFilter): The reconstruction filter
+
+    Returns:
+        object: the resampled tensor or texture object. The type of the output
+        will be the same as the type of the source.
+    '''
+    is_texture = getattr(source, 'IsTexture', False)
+    if not is_texture and not _dr.is_tensor_v(source):
+        raise TypeError("resample(): unsupported input type, expected Dr.Jit "
+                        "tensor or texture type!")
+
+    if not isinstance(shape, _Sequence):
+        raise TypeError("resample(): unsupported shape type, expected a list!")
+
+    if len(shape) > len(source.shape):
+        raise TypeError("resample(): invalid shape size!")
+
+    shape = list(shape) + list(source.shape[len(shape):])
+    for s in shape:
+        if type(s) is not int or s < 1:
+            raise TypeError("resample(): target shape must contain positive "
+                            "integer values!")
+
+    if is_texture:
+        if source.shape[-1] != shape[-1]:
+            raise TypeError("resample(): channel counts doesn't match input texture!")
+
+        tensor = source.tensor().resample_(shape, filter)
+        texture = type(source)(shape[:-1], shape[-1],
+                               use_accel=source.use_accel(),
+                               filter_mode=source.filter_mode(),
+                               wrap_mode=source.wrap_mode())
+        texture.set_tensor(tensor)
+        return texture
+    else:
+        return source.resample_(shape, filter)
+
+
+def downsample(source, shape=None, scale_factor=None,
+               filter=_dr.ResampleFilter.Box):
+    '''
+    downsample(source, shape=None, scale_factor=None, filter=drjit.ResampleFilter.Box)
+    Down-sample the input tensor or texture according to the provided shape.
+
+    Alternatively to specifying the target shape, an integer scale factor can
+    be provided, by which the corresponding dimensions are divided. See
+    :py:func:`resample` for details on the filtering.
+
+    Args:
+        source (object): A Dr.Jit tensor or texture type.
+
+        shape (list): The target shape (optional)
+
+        scale_factor (list): The factor by which to divide the current shape (optional)
+
+        filter (drjit.ResampleFilter): The reconstruction filter
+
+    Returns:
+        object: the down-sampled tensor or texture object.
+    '''
+    if shape is not None and scale_factor is not None:
+        raise TypeError("downsample(): shape and scale_factor arguments cannot "
+                        "be defined at the same time!")
+
+    if scale_factor is not None:
+        if not isinstance(scale_factor, _Sequence):
+            raise TypeError("downsample(): unsupported scale_factor type, "
+                            "expected a list!")
+
+        if len(scale_factor) > len(source.shape):
+            raise TypeError("downsample(): invalid scale_factor size!")
+
+        shape = []
+        for i, factor in enumerate(scale_factor):
+            if type(factor) is not int or factor < 1:
+                raise TypeError("downsample(): scale_factor must contain "
+                                "positive integer values!")
+            shape.append(max(source.shape[i] // factor, 1))
+    elif shape is None:
+        raise TypeError("downsample(): either shape or scale_factor must be "
+                        "specified!")
+    else:
+        for i, s in enumerate(shape):
+            if type(s) is int and s > source.shape[i]:
+                raise TypeError("downsample(): target shape values must be "
+                                "smaller or equal to the input shape! (%i vs %i)"
+                                % (s, source.shape[i]))
+
+    return resample(source, shape, filter)
+
+
+def load_npy(dtype, filename):
+    '''
+    load_npy(dtype, filename)
+    Load a tensor from a NumPy ``.npy`` file.
+
+    The element type stored in the file must match the value type of
+    ``dtype``, and the array must be C-contiguous. On the LLVM backend, the
+    file is memory-mapped and used in place without copying it. On the CUDA
+    backend, it is read into pinned host memory and uploaded asynchronously.
+
+    Args:
+        dtype (type): A Dr.Jit tensor type (e.g. :py:class:`drjit.llvm.TensorXf`)
+
+        filename (str): Path of the file to load
+
+    Returns:
+        object: A tensor of type ``dtype``
+    '''
+    if not _dr.is_tensor_v(dtype):
+        raise TypeError("load_npy(): expected a Dr.Jit tensor type!")
+    return dtype.load_npy_(_os.fspath(filename))
+
+
+def save_npy(filename, tensor):
+    '''
+    save_npy(filename, tensor)
+    Save a tensor to a NumPy ``.npy`` file that can be read by ``numpy.load()``
+    and :py:func:`load_npy`.
+
+    Args:
+        filename (str): Path of the file to write
+
+        tensor (object): A Dr.Jit tensor
+    '''
+    if not _dr.is_tensor_v(tensor):
+        raise TypeError("save_npy(): expected a Dr.Jit tensor!")
+    tensor.save_npy_(_os.fspath(filename))
+
+
+def fft(input, ndim=1):
+    '''
+    fft(input, ndim=1)
+    Compute the discrete Fourier transform of a complex-valued tensor.
+
+    The last axis of ``input`` must have size 2 and holds the real and
+    imaginary parts. The transform is applied to the ``ndim`` axes preceding
+    it, whose sizes must be powers of two; all other axes are batch
+    dimensions. It follows the sign convention of ``numpy.fft.fftn`` (no
+    normalization) and is differentiable.
+
+    Args:
+        input (object): Tensor of shape ``([batch..,] signal dims.., 2)``
+
+        ndim (int): Number of transformed axes (1, 2 or 3)
+
+    Returns:
+        object: Tensor of the same shape holding the transformed signals
+    '''
+    _check_float_tensor('fft', input)
+    return input.fft_(ndim, False)
+
+
+def ifft(input, ndim=1):
+    '''
+    ifft(input, ndim=1)
+    Inverse of :py:func:`fft`, including the normalization by the number of
+    transformed entries.
+    '''
+    _check_float_tensor('ifft', input)
+    return input.fft_(ndim, True)
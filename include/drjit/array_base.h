@@ -44,6 +44,12 @@ NAMESPACE_BEGIN(drjit)
             derived().entry(i) = reinterpret_array<Value>(v[i]);               \
     }
 
+NAMESPACE_BEGIN(detail)
+/// Detects array types whose vertical operations may run in parallel
+template <typename T>
+using has_parallel_for =
+    decltype(T::parallel_for_(size_t(0), std::declval<void (*)(size_t)>()));
+NAMESPACE_END(detail)
 
 /// Array base class templated via the curiously recurring template pattern
 template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
@@ -240,6 +246,15 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
     // -----------------------------------------------------------------------
 
 
+    /* Loop over the entries of an array. Dynamic arrays providing a
+       'parallel_for_()' function (see \ref DynamicArray) may distribute the
+       iterations over several threads. */
+    #define DRJIT_ARRAY_LOOP(size, ...)                                      \
+        if constexpr (is_detected_v<detail::has_parallel_for, Derived>)     \
+            Derived::parallel_for_(size, [&](size_t i) { __VA_ARGS__ });    \
+        else                                                                 \
+            for (size_t i = 0; i < size; ++i) { __VA_ARGS__ }
+
     #define DRJIT_IMPLEMENT_UNARY(name, op, cond)                            \
         Derived name##_() const {                                            \
             DRJIT_CHKSCALAR(#name "_");                                      \
@@ -251,10 +266,10 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                 if constexpr (Derived::Size == Dynamic)                      \
                     result = drjit::empty<Derived>(sa);                      \
                                                                              \
-                for (size_t i = 0; i < sa; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sa,                                         \
                     const Value &a = derived().entry(i);                     \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -277,10 +292,10 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                 if constexpr (Derived::Size == Dynamic)                      \
                     result = drjit::empty<Derived>(sa);                      \
                                                                              \
-                for (size_t i = 0; i < sa; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sa,                                         \
                     const Value &a = derived().entry(i);                     \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -353,11 +368,11 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                     result = drjit::empty<Derived>(sr);                      \
                 }                                                            \
                                                                              \
-                for (size_t i = 0; i < sr; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sr,                                         \
                     const Value &a = derived().entry(i);                     \
                     const Value &b = v.entry(i);                             \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -386,11 +401,11 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                     result = drjit::empty<Derived>(sr);                      \
                 }                                                            \
                                                                              \
-                for (size_t i = 0; i < sr; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sr,                                         \
                     const Value &a = derived().entry(i);                     \
                     const auto &b = v.entry(i);                              \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -414,11 +429,11 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                     result = drjit::empty<mask_t<Derived>>(sr);              \
                 }                                                            \
                                                                              \
-                for (size_t i = 0; i < sr; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sr,                                         \
                     const Value &a = derived().entry(i);                     \
                     const Value &b = v.entry(i);                             \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -446,12 +461,12 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                     result = drjit::empty<Derived>(sr);                      \
                 }                                                            \
                                                                              \
-                for (size_t i = 0; i < sr; ++i) {                            \
+                DRJIT_ARRAY_LOOP(sr,                                         \
                     const Value &a = derived().entry(i);                     \
                     const Value &b = v1.entry(i);                            \
                     const Value &c = v2.entry(i);                            \
                     result.set_entry(i, op);                                 \
-                }                                                            \
+                )                                                            \
                                                                              \
                 return result;                                               \
             } else {                                                         \
@@ -556,6 +571,7 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
     #undef DRJIT_IMPLEMENT_BINARY_BITOP
     #undef DRJIT_IMPLEMENT_BINARY_MASK
     #undef DRJIT_IMPLEMENT_TERNARY_ALT
+    #undef DRJIT_ARRAY_LOOP
 
     template <typename Mask>
     static DRJIT_INLINE
@@ -742,6 +758,26 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
         }
     }
 
+    /// Exchange entries 'i' and 'i ^ Step' (used by segmented reductions)
+    template <size_t Step> Derived shuffle_xor_() const {
+        Derived result;
+        if constexpr (Derived::Size == Dynamic)
+            result = drjit::empty<Derived>(derived().size());
+        for (size_t i = 0; i < derived().size(); ++i)
+            result.entry(i) = derived().entry(i ^ Step);
+        return result;
+    }
+
+    /// Move entry 'i' to position 'i + Shift' and zero-fill (used by prefix sums)
+    template <size_t Shift> Derived shift_lanes_() const {
+        Derived result;
+        if constexpr (Derived::Size == Dynamic)
+            result = drjit::empty<Derived>(derived().size());
+        for (size_t i = 0; i < derived().size(); ++i)
+            result.entry(i) = i >= Shift ? derived().entry(i - Shift) : zeros<Value>();
+        return result;
+    }
+
     template <typename Mask, enable_if_t<Mask::Depth == 1> = 0>
     DRJIT_INLINE Value extract_(const Mask &mask) const {
         size_t sa = derived().size(), sb = mask.size(),
@@ -814,6 +850,35 @@ template <typename Value_, bool IsMask_, typename Derived_> struct ArrayBase {
                            mask.entry(i));
     }
 
+    template <typename Mask>
+    size_t compress_store_(void *mem, const Mask &mask) const {
+        DRJIT_CHKSCALAR("compress_store_");
+        Value *ptr = (Value *) mem;
+        size_t count = 0;
+
+        for (size_t i = 0; i < derived().size(); ++i) {
+            if (mask.entry(i))
+                ptr[count++] = derived().entry(i);
+        }
+
+        return count;
+    }
+
+    template <typename Mask>
+    static Derived expand_load_(const void *mem, const Mask &mask) {
+        DRJIT_CHKSCALAR("expand_load_");
+        const Value *ptr = (const Value *) mem;
+        Derived result;
+
+        if constexpr (Derived::Size == Dynamic)
+            result = drjit::empty<Derived>(mask.size());
+
+        for (size_t i = 0, count = 0; i < result.size(); ++i)
+            result.entry(i) = mask.entry(i) ? ptr[count++] : Value(0);
+
+        return result;
+    }
+
     static Derived load_aligned_(const void *mem, size_t size) {
         return Derived::load_(mem, size);
     }
@@ -53,6 +53,10 @@ namespace detail {
                       (vectorize_t<Type, Size>::self ||
                        (Size >= 4 && vectorize_t<Type, Size>::recurse)))>;
 
+    /// Detect packets providing a vectorized conversion to half precision
+    template <typename T>
+    using has_store_half_det = decltype(std::declval<const T &>().store_half_(nullptr));
+
     template <typename Type, size_t Size>
     using enable_if_recursive =
         enable_if_t<vectorizable_type_v<Type> && (Size >= 4) &&
@@ -88,7 +92,29 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
     using Base::entry;
 
     DRJIT_ARRAY_DEFAULTS(StaticArrayImpl)
-    DRJIT_ARRAY_FALLBACK_CONSTRUCTORS(StaticArrayImpl)
+
+    /* Same as DRJIT_ARRAY_FALLBACK_CONSTRUCTORS(), except that conversions
+       from single/double precision packets to half precision are vectorized */
+    template <typename Value2, typename D2, typename D = Derived_,
+              enable_if_t<D::Size == D2::Size && D::Depth == D2::Depth> = 0>
+    StaticArrayImpl(const ArrayBase<Value2, false, D2> &v) {
+        if constexpr (std::is_same_v<Value_, half> && !IsMask_ &&
+                      is_detected_v<detail::has_store_half_det, D2>) {
+            v.derived().store_half_(m_data);
+        } else {
+            DRJIT_CHKSCALAR("Copy constructor (conversion)");
+            for (size_t i = 0; i < derived().size(); ++i)
+                derived().entry(i) = (Value) v.derived().entry(i);
+        }
+    }
+
+    template <typename Value2, typename D2, typename D = Derived_,
+              enable_if_t<D::Size == D2::Size && D::Depth == D2::Depth> = 0>
+    StaticArrayImpl(const ArrayBase<Value2, IsMask_, D2> &v, detail::reinterpret_flag) {
+        DRJIT_CHKSCALAR("Copy constructor (reinterpret_cast)");
+        for (size_t i = 0; i < derived().size(); ++i)
+            derived().entry(i) = reinterpret_array<Value>(v[i]);
+    }
 
     template <typename Value2, typename D2, typename D = Derived_,
               enable_if_t<D::Size != D2::Size || D::Depth != D2::Depth> = 0>
@@ -608,10 +608,80 @@ value_t<Array> extract(const Array &array, const Mask &mask) {
     return array.extract_(mask);
 }
 
+namespace detail {
+    template <size_t Group, size_t Step = 1, typename Array, typename Op>
+    DRJIT_INLINE Array segmented_reduce(const Array &a, const Op &op) {
+        static_assert(is_static_array_v<Array> && Group != 0 &&
+                      (Group & (Group - 1)) == 0 && Array::Size % Group == 0,
+                      "segmented reduction: the group size must be a power "
+                      "of two that divides the array size!");
+        if constexpr (Step >= Group)
+            return a;
+        else
+            return segmented_reduce<Group, Step * 2>(
+                op(a, a.template shuffle_xor_<Step>()), op);
+    }
+
+    template <size_t Shift = 1, typename Array>
+    DRJIT_INLINE Array prefix_sum_static(const Array &a) {
+        if constexpr (Shift >= Array::Size)
+            return a;
+        else
+            return prefix_sum_static<Shift * 2>(
+                a + a.template shift_lanes_<Shift>());
+    }
+}
+
+/**
+ * \brief Sum over groups of \c Group consecutive entries, the result of each
+ * group is broadcast to all of its entries.
+ *
+ * For example, <tt>segmented_sum<4>(a * b)</tt> computes dot products of
+ * pairs of 4D vectors that are stored contiguously in 8- or 16-wide packets.
+ * Packet backends implement this using log2(Group) in-register permutations.
+ */
+template <size_t Group, typename Array>
+DRJIT_INLINE Array segmented_sum(const Array &a) {
+    return detail::segmented_reduce<Group>(
+        a, [](const Array &x, const Array &y) { return x + y; });
+}
+
+/// Minimum over groups of \c Group consecutive entries (see \ref segmented_sum())
+template <size_t Group, typename Array>
+DRJIT_INLINE Array segmented_min(const Array &a) {
+    return detail::segmented_reduce<Group>(
+        a, [](const Array &x, const Array &y) { return minimum(x, y); });
+}
+
+/// Maximum over groups of \c Group consecutive entries (see \ref segmented_sum())
+template <size_t Group, typename Array>
+DRJIT_INLINE Array segmented_max(const Array &a) {
+    return detail::segmented_reduce<Group>(
+        a, [](const Array &x, const Array &y) { return maximum(x, y); });
+}
+
+/**
+ * \brief Inclusive or exclusive prefix sum
+ *
+ * Static arrays are scanned along their outermost dimension. Packet backends
+ * implement this via log2(Size) in-register lane shifts.
+ */
 template <typename Array>
 Array prefix_sum(const Array &array, bool exclusive = true) {
-    static_assert(is_dynamic_array_v<Array>);
-    return array.prefix_sum_(exclusive);
+    if constexpr (is_dynamic_array_v<Array>) {
+        return array.prefix_sum_(exclusive);
+    } else if constexpr (is_recursive_array_v<Array>) {
+        // Scan both halves, then offset the high half by the sum of the low one
+        return Array(prefix_sum(low(array), exclusive),
+                     prefix_sum(high(array), exclusive) + sum(low(array)));
+    } else {
+        static_assert(is_static_array_v<Array>,
+                      "prefix_sum(): expected a static or dynamic array!");
+        Array result = detail::prefix_sum_static(array);
+        if (exclusive)
+            result = result.template shift_lanes_<1>();
+        return result;
+    }
 }
 
 template <typename Mask>
@@ -959,6 +1029,97 @@ template <typename T> DRJIT_INLINE void store(void *ptr, const T &value) {
         *static_cast<T *>(ptr) = value;
 }
 
+/**
+ * \brief Store the entries of \c value selected by \c mask contiguously to
+ * memory, returns the number of stored entries
+ *
+ * Memory past the last stored entry is not modified.
+ */
+template <typename Array>
+DRJIT_INLINE size_t compress_store(void *ptr, const Array &value,
+                                   const mask_t<Array> &mask) {
+    if constexpr (is_array_v<Array>) {
+        return value.compress_store_(ptr, mask);
+    } else {
+        if (mask)
+            *static_cast<Array *>(ptr) = value;
+        return mask ? 1 : 0;
+    }
+}
+
+/**
+ * \brief Load consecutive entries from memory into the lanes selected by
+ * \c mask (the remaining lanes are set to zero)
+ *
+ * Only <tt>count(mask)</tt> entries are accessed.
+ */
+template <typename Array>
+DRJIT_INLINE Array expand_load(const void *ptr, const mask_t<Array> &mask) {
+    if constexpr (is_array_v<Array>)
+        return Array::expand_load_(ptr, mask);
+    else
+        return mask ? *static_cast<const Array *>(ptr) : Array(0);
+}
+
+namespace detail {
+    template <typename T> using has_load_aos = decltype(
+        value_t<T>::template load_aos_<T::Size>(nullptr, (value_t<T> *) nullptr));
+    template <typename T> using has_store_aos = decltype(
+        value_t<T>::template store_aos_<T::Size>(nullptr, (const value_t<T> *) nullptr));
+}
+
+/**
+ * \brief Load a nested array (e.g. <tt>Array<Packet<float>, 3></tt>) from
+ * memory containing <tt>T::Size</tt> interleaved components per record
+ * ("array of structures" layout).
+ *
+ * Packet backends transpose the data in registers where possible, otherwise
+ * the components are gathered using scalar loads.
+ */
+template <typename T> DRJIT_INLINE T load_aos(const void *ptr) {
+    static_assert(array_depth_v<T> >= 2 && !is_dynamic_v<T>,
+                  "load_aos(): expected a static nested array!");
+    using Inner = value_t<T>;
+    constexpr size_t N = T::Size;
+    T result;
+
+    if constexpr (is_detected_v<detail::has_load_aos, T>) {
+        Inner tmp[N];
+        Inner::template load_aos_<N>(ptr, tmp);
+        for (size_t j = 0; j < N; ++j)
+            result.entry(j) = tmp[j];
+    } else {
+        using Value = value_t<Inner>;
+        const Value *p = (const Value *) ptr;
+        for (size_t i = 0; i < Inner::Size; ++i)
+            for (size_t j = 0; j < N; ++j)
+                result.entry(j).entry(i) = p[i * N + j];
+    }
+
+    return result;
+}
+
+/// Store a nested array to memory in interleaved form (see \ref load_aos())
+template <typename T> DRJIT_INLINE void store_aos(void *ptr, const T &value) {
+    static_assert(array_depth_v<T> >= 2 && !is_dynamic_v<T>,
+                  "store_aos(): expected a static nested array!");
+    using Inner = value_t<T>;
+    constexpr size_t N = T::Size;
+
+    if constexpr (is_detected_v<detail::has_store_aos, T>) {
+        Inner tmp[N];
+        for (size_t j = 0; j < N; ++j)
+            tmp[j] = value.entry(j);
+        Inner::template store_aos_<N>(ptr, tmp);
+    } else {
+        using Value = value_t<Inner>;
+        Value *p = (Value *) ptr;
+        for (size_t i = 0; i < Inner::Size; ++i)
+            for (size_t j = 0; j < N; ++j)
+                p[i * N + j] = value.entry(j).entry(i);
+    }
+}
+
 namespace detail {
     template <typename Target, typename Index> Target broadcast_index(const Index &index) {
         using Scalar = scalar_t<Index>;
@@ -974,6 +1135,18 @@ namespace detail {
         }
         return result;
     }
+
+    template <typename T> size_t aos_width(const T &value);
+
+    template <bool Permute, typename T, typename Source, typename Index,
+              typename Mask>
+    void gather_aos(T &value, const Source &source, const Index &index,
+                    const Mask &mask, size_t &offset);
+
+    template <bool Permute, typename T, typename Target, typename Index,
+              typename Mask>
+    void scatter_aos(Target &target, const T &value, const Index &index,
+                     const Mask &mask, size_t &offset);
 }
 
 template <typename Target, bool Permute = false, typename Source,
@@ -1039,8 +1212,18 @@ Target gather(Source &&source, const Index &index, const Mask &mask_ = true) {
             return gather<Target, Permute>(
                 source, detail::broadcast_index<TargetIndex>(index), mask);
         }
+    } else if constexpr (is_drjit_struct_v<Target> && is_array_v<Source>) {
+        /// Case 3.0: gather<MyStruct>(const FloatC &, ...) from an AoS buffer
+        static_assert(array_depth_v<Source> == 1 && is_array_v<Index>,
+                      "gather(): AoS structure gathers require a flat source "
+                      "array and an index array!");
+        Target result;
+        size_t width = detail::aos_width(result), offset = 0;
+        Index base = index * scalar_t<Index>(width);
+        detail::gather_aos<Permute>(result, source, base, mask, offset);
+        return result;
     } else if constexpr (is_drjit_struct_v<Target>) {
-        /// Case 3: gather<MyStruct>(const MyStruct &, ...)
+        /// Case 3.1: gather<MyStruct>(const MyStruct &, ...)
         static_assert(is_drjit_struct_v<Source>,
                       "Source must also be a custom data structure!");
         Target result;
@@ -1102,6 +1285,15 @@ void scatter(Target &&target, const Value &value, const Index &index,
             scatter<Permute>(target, value,
                              detail::broadcast_index<TargetIndex>(index), mask);
         }
+    } else if constexpr (is_drjit_struct_v<Value> &&
+                         is_array_v<std::decay_t<Target>>) {
+        // Scatter a structure into an AoS buffer (see gather())
+        static_assert(array_depth_v<Target> == 1 && is_array_v<Index>,
+                      "scatter(): AoS structure scatters require a flat "
+                      "target array and an index array!");
+        size_t width = detail::aos_width(value), offset = 0;
+        Index base = index * scalar_t<Index>(width);
+        detail::scatter_aos<Permute>(target, value, base, mask, offset);
     } else if constexpr (is_drjit_struct_v<Value>) {
         static_assert(is_drjit_struct_v<Target>,
                       "Target must also be a custom data structure!");
@@ -1125,6 +1317,97 @@ void scatter(Target &&target, const Value &value, const Index &index,
     }
 }
 
+NAMESPACE_BEGIN(detail)
+
+/// Number of scalar slots occupied by a structure in an interleaved (AoS) buffer
+template <typename T> size_t aos_width(const T &value) {
+    if constexpr (is_drjit_struct_v<T>) {
+        size_t result = 0;
+        struct_support_t<T>::apply_1(
+            value, [&](auto const &x) { result += aos_width(x); });
+        return result;
+    } else if constexpr (array_depth_v<T> > 1) {
+        static_assert(T::Size != Dynamic,
+                      "AoS layout: nested fields must have a static size!");
+        return T::Size * aos_width(value.entry(0));
+    } else {
+        static_assert(is_array_v<T>,
+                      "AoS layout: structure fields must be Dr.Jit arrays!");
+        return 1;
+    }
+}
+
+/**
+ * Gather the fields of 'value' from consecutive slots of the interleaved
+ * buffer 'source', starting at 'index + offset'. Fields whose type differs from
+ * that of the buffer are bit-cast (masks are stored as 0/1).
+ */
+template <bool Permute, typename T, typename Source, typename Index,
+          typename Mask>
+void gather_aos(T &value, const Source &source, const Index &index,
+                const Mask &mask, size_t &offset) {
+    if constexpr (is_drjit_struct_v<T>) {
+        struct_support_t<T>::apply_1(value, [&](auto &x) {
+            gather_aos<Permute>(x, source, index, mask, offset);
+        });
+    } else if constexpr (array_depth_v<T> > 1) {
+        for (size_t i = 0; i < T::Size; ++i)
+            gather_aos<Permute>(value.entry(i), source, index, mask, offset);
+    } else {
+        Index slot = index + scalar_t<Index>(offset++);
+        if constexpr (std::is_same_v<scalar_t<T>, scalar_t<Source>>) {
+            value = gather<T, Permute>(source, slot, mask);
+        } else {
+            using SourceD = detached_t<Source>;
+            SourceD v = gather<SourceD, Permute>(detach(source),
+                                                 detach(slot), detach(mask));
+            if constexpr (is_mask_v<T>) {
+                value = T(neq(v, scalar_t<SourceD>(0)));
+            } else {
+                static_assert(sizeof(scalar_t<T>) == sizeof(scalar_t<Source>),
+                              "AoS layout: fields must have the same size as "
+                              "the elements of the buffer!");
+                value = T(reinterpret_array<detached_t<T>>(v));
+            }
+        }
+    }
+}
+
+/// Inverse of \ref gather_aos(): scatter the fields of 'value' into 'target'
+template <bool Permute, typename T, typename Target, typename Index,
+          typename Mask>
+void scatter_aos(Target &target, const T &value, const Index &index,
+                 const Mask &mask, size_t &offset) {
+    if constexpr (is_drjit_struct_v<T>) {
+        struct_support_t<T>::apply_1(value, [&](auto const &x) {
+            scatter_aos<Permute>(target, x, index, mask, offset);
+        });
+    } else if constexpr (array_depth_v<T> > 1) {
+        for (size_t i = 0; i < T::Size; ++i)
+            scatter_aos<Permute>(target, value.entry(i), index, mask, offset);
+    } else {
+        using Value = plain_t<std::decay_t<Target>>;
+        Index slot = index + scalar_t<Index>(offset++);
+        if constexpr (std::is_same_v<scalar_t<T>, scalar_t<Value>>) {
+            scatter<Permute>(target, value, slot, mask);
+        } else {
+            using ValueD = detached_t<Value>;
+            ValueD v;
+            if constexpr (is_mask_v<T>) {
+                v = select(detach(value), ValueD(1), ValueD(0));
+            } else {
+                static_assert(sizeof(scalar_t<T>) == sizeof(scalar_t<Value>),
+                              "AoS layout: fields must have the same size as "
+                              "the elements of the buffer!");
+                v = reinterpret_array<ValueD>(detach(value));
+            }
+            scatter<Permute>(target, Value(v), slot, mask);
+        }
+    }
+}
+
+NAMESPACE_END(detail)
+
 template <typename Target, typename Value, typename Index>
 void scatter_reduce(ReduceOp op, Target &&target, const Value &value,
                     const Index &index, const mask_t<Value> &mask = true) {
@@ -1154,7 +1437,7 @@ void scatter_reduce(ReduceOp op, Target &&target, const Value &value,
                 else if (op == ReduceOp::Max)
                     return maximum(a, b);
 
-                if constexpr (std::is_same_v<Value, bool>) {
+                if constexpr (std::is_integral_v<Value>) {
                     if (op == ReduceOp::And)
                         return a & b;
                     else if (op == ReduceOp::Or)
@@ -1235,6 +1518,43 @@ decltype(auto) migrate(const T &value, TargetType target) {
     }
 }
 
+/**
+ * \brief Copy a CUDA array (or a nested array / custom data structure) into
+ * the memory of another device, see \ref JitArray::migrate_device_()
+ *
+ * Gradient tracking does not carry over to the copy.
+ */
+template <typename T> T migrate_device(const T &value, int32_t device) {
+    DRJIT_MARK_USED(device);
+
+    if constexpr (is_jit_v<T>) {
+        if constexpr (array_depth_v<T> > 1) {
+            T result;
+            if constexpr (T::Size == Dynamic)
+                result = empty<T>(value.size());
+
+            for (size_t i = 0; i < value.size(); ++i)
+                result.entry(i) = migrate_device(value.entry(i), device);
+
+            return result;
+        } else {
+            return value.derived().migrate_device_(device);
+        }
+    } else if constexpr (is_drjit_struct_v<T>) {
+        T result;
+
+        struct_support_t<T>::apply_2(
+            value, result,
+            [device](auto const &x1, auto &x2) DRJIT_INLINE_LAMBDA {
+                x2 = migrate_device(x1, device);
+            });
+
+        return result;
+    } else {
+        return value;
+    }
+}
+
 template <typename ResultType = void, typename T>
 decltype(auto) slice(const T &value, size_t index = -1) {
     schedule(value);
@@ -1721,6 +2041,21 @@ decltype(auto) detach(T &&value) {
     }
 }
 
+/**
+ * \brief Invoke \c func with non-differentiable versions of the arguments
+ *
+ * Generic code that is templated on its array types is thereby instantiated
+ * with the underlying (detached) types, which removes the AD bookkeeping from
+ * it at compile time: there are no runtime checks of AD variable indices, no
+ * reference counting, and no storage for these indices. This is in contrast
+ * to \ref suspend_grad, which only disables derivative tracking at runtime.
+ * The result is returned using non-differentiable types as well.
+ */
+template <typename Func, typename... Args>
+decltype(auto) no_grad(Func &&func, const Args &... args) {
+    return func(detach<true>(args)...);
+}
+
 template <bool Underlying = true, bool FailIfMissing = true, typename T>
 auto grad(const T &value) {
     using Result = std::conditional_t<Underlying, detached_t<T>, T>;
@@ -1810,6 +2145,48 @@ void accum_grad(T &value, const T2 &grad) {
     }
 }
 
+/**
+ * \brief Record the reverse-mode derivatives of gather operations from
+ * 'value' sparsely, as pairs of row indices and gradient values
+ *
+ * This avoids scattering into a dense zero-initialized gradient array when
+ * only a small part of a large array is accessed. The dense gradient remains
+ * available via \ref grad(), and \ref grad_sparse() returns the sparse
+ * representation. Only applies to leaf variables with a JIT backend.
+ */
+template <typename T> void set_grad_sparse(T &value, bool state = true) {
+    if constexpr (is_diff_v<T>) {
+        if constexpr (array_depth_v<T> > 1) {
+            for (size_t i = 0; i < value.size(); ++i)
+                set_grad_sparse(value.entry(i), state);
+        } else if constexpr (is_tensor_v<T>) {
+            set_grad_sparse(value.array(), state);
+        } else {
+            value.set_grad_sparse_(state);
+        }
+    }
+    DRJIT_MARK_USED(value);
+    DRJIT_MARK_USED(state);
+}
+
+/**
+ * \brief Return the sparse gradient of a flat array as a pair of row indices
+ * and gradient values (see \ref set_grad_sparse())
+ *
+ * Rows may occur more than once, and the associated values must then be
+ * added. Inactive lanes of masked gathers map to row zero with a value of
+ * zero.
+ */
+template <typename T> auto grad_sparse(const T &value) {
+    if constexpr (is_tensor_v<T>) {
+        return grad_sparse(value.array());
+    } else {
+        static_assert(is_diff_v<T> && array_depth_v<T> == 1,
+                      "grad_sparse(): expected a flat differentiable array!");
+        return value.derived().grad_sparse_();
+    }
+}
+
 template <typename T> void enqueue(ADMode mode, const T &value) {
     if constexpr (is_diff_v<T>) {
         if constexpr (array_depth_v<T> > 1) {
@@ -1899,7 +2276,30 @@ enum class ADFlag : uint32_t {
    ClearVertices = (uint32_t) ClearInput | (uint32_t) ClearInterior,
 
    /// Default: clear everything (edges, gradients of processed vertices)
-   Default = (uint32_t) ClearEdges | (uint32_t) ClearVertices
+   Default = (uint32_t) ClearEdges | (uint32_t) ClearVertices,
+
+   /**
+    * Reverse mode: propagate gradients of independent variables in parallel
+    * using the thread pool (LLVM and scalar backends, ignored otherwise)
+    */
+   Parallel = 8,
+
+   /**
+    * Use compensated (Kahan) summation when gradients of gather() (reverse
+    * mode) or scatter_reduce() (forward mode) operations are accumulated into
+    * a dense array. This keeps single precision gradients accurate when many
+    * contributions land on the same entry (JIT backends, ignored otherwise)
+    */
+   Compensated = 16,
+
+   /**
+    * Periodically evaluate the partially accumulated gradients while the
+    * graph is being traversed, so that the device executes the resulting
+    * kernels while the host continues with the remainder of the graph. The
+    * final gradients are scheduled and launched without waiting for their
+    * completion (JIT backends, ignored otherwise)
+    */
+   Async = 32
 };
 
 constexpr uint32_t operator |(ADFlag f1, ADFlag f2)   { return (uint32_t) f1 | (uint32_t) f2; }
@@ -1972,6 +2372,144 @@ void backward(T &value, uint32_t flags = (uint32_t) ADFlag::Default) {
     backward_from(value, flags);
 }
 
+/**
+ * \brief Future-like handle returned by \ref backward_async()
+ *
+ * The gradients can be used right away, since subsequent computation is
+ * ordered after the kernels launched by the traversal. \ref wait() blocks
+ * until these kernels have finished.
+ */
+struct ADFuture {
+    void wait() const { sync_thread(); }
+};
+
+/// Asynchronous version of \ref backward() (see \ref ADFlag::Async)
+template <typename T>
+ADFuture backward_async(T &value, uint32_t flags = (uint32_t) ADFlag::Default) {
+    backward_from(value, flags | ADFlag::Async);
+    return ADFuture();
+}
+
+/**
+ * \brief Backpropagate a sequence of gradients from ``value`` and return the
+ * resulting gradients of ``input`` (i.e., one vector-Jacobian product per entry
+ * of ``grads``)
+ *
+ * The AD graph is retained until the last traversal, which avoids re-recording
+ * the computation for every cotangent. The results are not evaluated, hence
+ * they can be computed by a single kernel launch.
+ */
+template <typename T, typename Input>
+dr_vector<detached_t<Input>>
+backward_batch(T &value, const dr_vector<detached_t<T>> &grads, Input &input,
+               uint32_t flags = (uint32_t) ADFlag::Default) {
+    detail::check_grad_enabled("backward_batch", value);
+
+    if constexpr (array_depth_v<T> > 1)
+        value = value + T(0);
+
+    dr_vector<detached_t<Input>> result;
+    for (size_t i = 0; i < grads.size(); ++i) {
+        uint32_t flags_i = flags;
+        if (i + 1 < grads.size())
+            flags_i &= ~(uint32_t) ADFlag::ClearEdges;
+
+        set_grad(value, grads[i]);
+        enqueue(ADMode::Backward, value);
+        traverse<T>(ADMode::Backward, flags_i);
+
+        result.push_back(grad(input));
+        set_grad(input, detached_t<Input>(0));
+    }
+
+    return result;
+}
+
+/**
+ * \brief Record the second-order terms of subsequently created differentiable
+ * operations on the current thread, which is needed by \ref hvp()
+ */
+template <typename T> void set_record_hessian(bool value) {
+    using Type = leaf_array_t<T>;
+    DRJIT_MARK_USED(value);
+    if constexpr (is_diff_v<Type> && std::is_floating_point_v<scalar_t<Type>>)
+        Type::set_record_hessian_(value);
+}
+
+/// Are second-order terms recorded? (see \ref set_record_hessian())
+template <typename T> bool record_hessian() {
+    using Type = leaf_array_t<T>;
+    if constexpr (is_diff_v<Type> && std::is_floating_point_v<scalar_t<Type>>)
+        return Type::record_hessian_();
+    else
+        return false;
+}
+
+/**
+ * \brief Return the product of the Hessian of ``value`` with respect to
+ * ``input`` and the direction ``v``
+ *
+ * The computation is a forward-mode differentiation of the reverse-mode
+ * traversal, which reuses the recorded AD graph instead of differentiating
+ * the gradient computation (hence, its cost is of the same order as that of
+ * computing the gradient). The graph must have been recorded while \ref
+ * set_record_hessian() was active. Computation that depends on ``input`` via
+ * custom derivative callbacks (custom operations, differentiable virtual
+ * function calls) or horizontal products is not supported and raises an
+ * exception. Components of a vector-valued ``value`` are summed.
+ */
+template <typename T, typename Input>
+detached_t<Input> hvp(T &value, Input &input, const detached_t<Input> &v,
+                      uint32_t flags = (uint32_t) ADFlag::Default) {
+    if constexpr (array_depth_v<T> > 1) {
+        auto total = sum(value);
+        return hvp(total, input, v, flags);
+    } else {
+        detail::check_grad_enabled("hvp", value);
+
+        set_grad(input, v);
+        enqueue(ADMode::Forward, input);
+        set_grad(value, 1.f);
+        value.hvp_(flags);
+
+        detached_t<Input> result = grad(input);
+        set_grad(input, detached_t<Input>(0));
+        return result;
+    }
+}
+
+/**
+ * \brief Record subsequent AD operations of the current thread in a private
+ * graph that does not require locking
+ *
+ * This is useful when many threads differentiate independent computations.
+ * Variables of the private graph cannot be combined with variables of the
+ * global graph (or those of other threads).
+ */
+template <typename T> void set_isolated_graph(bool value) {
+    using Type = leaf_array_t<T>;
+    DRJIT_MARK_USED(value);
+    if constexpr (is_diff_v<Type> && std::is_floating_point_v<scalar_t<Type>>)
+        Type::set_isolated_graph_(value);
+}
+
+/// Does the current thread use a private AD graph? (see \ref set_isolated_graph())
+template <typename T> bool isolated_graph() {
+    using Type = leaf_array_t<T>;
+    if constexpr (is_diff_v<Type> && std::is_floating_point_v<scalar_t<Type>>)
+        return Type::isolated_graph_();
+    else
+        return false;
+}
+
+/// RAII helper to use a private AD graph within a C++ scope
+template <typename T> struct scoped_isolated_graph {
+    scoped_isolated_graph() { set_isolated_graph<T>(true); }
+    ~scoped_isolated_graph() { set_isolated_graph<T>(false); }
+    scoped_isolated_graph(const scoped_isolated_graph &) = delete;
+    scoped_isolated_graph &operator=(const scoped_isolated_graph &) = delete;
+};
+
 template <typename T>
 void forward(T &value, uint32_t flags = (uint32_t) ADFlag::Default) {
     forward_from(value, flags);
@@ -23,6 +23,8 @@
 
 #include <drjit/array.h>
 #include <drjit-core/jit.h>
+#include <atomic>
+#include <chrono>
 
 NAMESPACE_BEGIN(drjit)
 
@@ -41,6 +43,14 @@ template <typename Value> uint32_t ad_inc_ref_cond_impl(uint32_t index) noexcept
 /// Decrease the external reference count of a given variable
 template <typename Value> void ad_dec_ref_impl(uint32_t index) noexcept (true);
 
+/// Increase the reference count of 'n' variables (zero entries are skipped)
+template <typename Value>
+void ad_inc_ref_n_impl(size_t n, const uint32_t *indices) noexcept (true);
+
+/// Decrease the reference count of 'n' variables (zero entries are skipped)
+template <typename Value>
+void ad_dec_ref_n_impl(size_t n, const uint32_t *indices) noexcept (true);
+
 /// Create a new variable with the given number of operands and AD weights
 template <typename Value>
 uint32_t ad_new(const char *label, size_t size, uint32_t ops = 0,
@@ -57,17 +67,75 @@ void ad_set_grad(uint32_t index, const Value &v, bool fail_if_missing);
 template <typename Value>
 void ad_accum_grad(uint32_t index, const Value &v, bool fail_if_missing);
 
+/// Record the gradients of gather() operations sparsely (leaf variables only)
+template <typename Value> void ad_set_grad_sparse(uint32_t index, bool value);
+
+/// Query the sparse gradient of a variable, returns \c false if not enabled
+template <typename Value, typename Index>
+bool ad_grad_sparse(uint32_t index, Index &rows, Value &values);
+
 /// Enqueue a variable for a subsequent ad_traverse() command
 template <typename Value> void ad_enqueue(ADMode mode, uint32_t index);
 
 /// Propagate derivatives through the enqueued set of edges
 template <typename Value> void ad_traverse(ADMode mode, uint32_t flags);
 
+/// Record second-order terms of subsequent operations (on the current thread)
+template <typename Value> void ad_set_record_hessian(bool value);
+
+/// Are second-order terms being recorded? (see \ref ad_set_record_hessian())
+template <typename Value> bool ad_record_hessian() noexcept(true);
+
+/**
+ * Store the upper triangle of the local Hessian of the operation 'index'. With
+ * 'ops == 0', mark the operation as nonlinear without second-order terms,
+ * which causes \ref ad_hvp() to fail.
+ */
+template <typename Value>
+void ad_set_hessian(uint32_t index, uint32_t ops, const uint32_t *indices,
+                    const Value *terms);
+
+/**
+ * \brief Compute a Hessian-vector product
+ *
+ * Expects that the inputs were enqueued in forward mode with gradients
+ * specifying the direction, and that the gradient of 'index' holds the seed of
+ * the reverse-mode pass. Afterwards, the gradients of the inputs contain the
+ * product of the Hessian and the direction. Requires that the graph was
+ * recorded while \ref ad_set_record_hessian() was active, and raises an
+ * exception if it involves custom derivative callbacks or operations lacking
+ * second-order terms.
+ */
+template <typename Value> void ad_hvp(uint32_t index, uint32_t flags);
+
+/**
+ * \brief Record subsequent AD operations of the current thread in a private graph
+ *
+ * The private graph is not shared with other threads and therefore requires
+ * no locking. Its variables cannot be combined with those of the global graph
+ * or of private graphs belonging to other threads, and attempting to do so
+ * raises an exception. The graph persists until the thread exits, hence
+ * variables created within it can be used after re-entering.
+ */
+template <typename Value> void ad_isolated_graph_enter();
+
+/// Return to the global AD graph (see \ref ad_isolated_graph_enter())
+template <typename Value> void ad_isolated_graph_leave();
+
+/// Does the current thread use a private AD graph?
+template <typename Value> bool ad_isolated_graph() noexcept(true);
+
 /// Number of observed implicit dependencies
 template <typename Value> size_t ad_implicit();
 
-/// Extract implicit dependencies since 'snapshot' (obtained via ad_implicit())
-template <typename Value> void ad_extract_implicit(size_t snapshot, uint32_t *out);
+/**
+ * Extract implicit dependencies since 'snapshot' (obtained via ad_implicit())
+ *
+ * Writes the distinct source variables in ascending order to 'out', which
+ * must have room for <tt>ad_implicit() - snapshot</tt> entries, and returns
+ * their number.
+ */
+template <typename Value> size_t ad_extract_implicit(size_t snapshot, uint32_t *out);
 
 /// Enqueue implicit dependencies since 'snapshot' (obtained via ad_implicit())
 template <typename Value> void ad_enqueue_implicit(size_t snapshot);
@@ -317,6 +385,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[2] = { a.m_value, m_value };
                     index_new = detail::ad_new<Type>(
                         "mul", width(result), 2, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[3] = { 0, 1, 0 };
+                        detail::ad_set_hessian<Type>(index_new, 2, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -336,6 +408,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[2] = { rcp_a, -m_value * sqr(rcp_a) };
                     index_new = detail::ad_new<Type>(
                         "div", width(result), 2, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type rcp_a2 = sqr(rcp_a);
+                        Type h[3] = { 0, -rcp_a2, 2.f * m_value * rcp_a2 * rcp_a };
+                        detail::ad_set_hessian<Type>(index_new, 2, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -372,6 +449,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[3] = { a.m_value, m_value, 1 };
                     index_new = detail::ad_new<Type>(
                         "fmadd", width(result), 3, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[6] = { 0, 1, 0, 0, 0, 0 };
+                        detail::ad_set_hessian<Type>(index_new, 3, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -390,6 +471,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[3] = { a.m_value, m_value, -1 };
                     index_new = detail::ad_new<Type>(
                         "fmsub", width(result), 3, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[6] = { 0, 1, 0, 0, 0, 0 };
+                        detail::ad_set_hessian<Type>(index_new, 3, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -408,6 +493,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[3] = { -a.m_value, -m_value, 1 };
                     index_new = detail::ad_new<Type>(
                         "fnmadd", width(result), 3, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[6] = { 0, -1, 0, 0, 0, 0 };
+                        detail::ad_set_hessian<Type>(index_new, 3, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -426,6 +515,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[3] = { -a.m_value, -m_value, -1 };
                     index_new = detail::ad_new<Type>(
                         "fnmsub", width(result), 3, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[6] = { 0, -1, 0, 0, 0, 0 };
+                        detail::ad_set_hessian<Type>(index_new, 3, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -462,6 +555,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { .5f * rcp(result) };
                     index_new = detail::ad_new<Type>(
                         "sqrt", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -.25f * rcp(result * m_value) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -480,6 +577,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { (1 / 3.f) * sqr(rcp(result)) };
                     index_new = detail::ad_new<Type>(
                         "cbrt", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { (-2.f / 9.f) * rcp(sqr(result) * m_value),
+                                       };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -498,6 +600,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { (2.f * InvSqrtPi<Type>) * exp(-sqr(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "erf", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { (-4.f * InvSqrtPi<Type>) * m_value *
+                                      exp(-sqr(m_value)) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -516,6 +623,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -sqr(result) };
                     index_new = detail::ad_new<Type>(
                         "rcp", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { 2.f * result * sqr(result) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -535,6 +646,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -.5f * rsqrt_3 };
                     index_new = detail::ad_new<Type>(
                         "rsqrt", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { .75f * rsqrt_3 * rsqrt_2 };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -654,6 +769,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { std::move(c) };
                     index_new = detail::ad_new<Type>("sin", width(s),
                                                      1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -s };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(s));
@@ -672,6 +791,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -s };
                     index_new = detail::ad_new<Type>("cos", width(c),
                                                      1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -c };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(c));
@@ -691,8 +814,16 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     uint32_t w = (uint32_t) width(s);
                     index_s = detail::ad_new<Type>("sincos[s]", w, 1, indices,
                                                    weights_s);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -s };
+                        detail::ad_set_hessian<Type>(index_s, 1, indices, h);
+                    }
                     index_c = detail::ad_new<Type>("sincos[c]", w, 1, indices,
                                                    weights_c);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -c };
+                        detail::ad_set_hessian<Type>(index_c, 1, indices, h);
+                    }
                 }
             }
             return {
@@ -714,6 +845,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -result * cot(m_value) };
                     index_new = detail::ad_new<Type>(
                         "csc", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { result * (sqr(cot(m_value)) + sqr(result)) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -732,6 +867,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { result * tan(m_value) };
                     index_new = detail::ad_new<Type>(
                         "sec", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { result * (sqr(tan(m_value)) + sqr(result)) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -750,6 +889,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { sqr(sec(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "tan", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { 2.f * result * fmadd(result, result, 1) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -768,6 +911,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -sqr(csc(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "cot", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { 2.f * result * fmadd(result, result, 1) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -786,6 +933,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rsqrt(fnmadd(m_value, m_value, 1)) };
                     index_new = detail::ad_new<Type>(
                         "asin", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rsqrt(fnmadd(m_value, m_value, 1));
+                        Type h[1] = { m_value * d * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -804,6 +956,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { -rsqrt(fnmadd(m_value, m_value, 1)) };
                     index_new = detail::ad_new<Type>(
                         "acos", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rsqrt(fnmadd(m_value, m_value, 1));
+                        Type h[1] = { -m_value * d * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -822,6 +979,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rcp(fmadd(m_value, m_value, 1)) };
                     index_new = detail::ad_new<Type>(
                         "atan", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rcp(fmadd(m_value, m_value, 1));
+                        Type h[1] = { -2.f * m_value * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -841,6 +1003,13 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[2] = { il2 * x.m_value, -il2 * m_value };
                     index_new = detail::ad_new<Type>(
                         "atan2", width(result), 2, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type il4 = sqr(il2), xy2 = 2.f * m_value * x.m_value;
+                        Type h[3] = { -xy2 * il4,
+                                      (sqr(m_value) - sqr(x.m_value)) * il4,
+                                      xy2 * il4 };
+                        detail::ad_set_hessian<Type>(index_new, 2, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -859,6 +1028,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { result };
                     index_new = detail::ad_new<Type>(
                         "exp", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { result };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -877,6 +1050,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { result * LogTwo<Value> };
                     index_new = detail::ad_new<Type>(
                         "exp2", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { result * (LogTwo<Value> * LogTwo<Value>),
+                                       };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -895,6 +1073,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rcp(m_value) };
                     index_new = detail::ad_new<Type>(
                         "log", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -sqr(rcp(m_value)) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -913,6 +1095,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rcp(m_value) * InvLogTwo<Value> };
                     index_new = detail::ad_new<Type>(
                         "log2", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -sqr(rcp(m_value)) * InvLogTwo<Value> };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -931,6 +1117,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { std::move(c) };
                     index_new = detail::ad_new<Type>("sinh", width(s),
                                                      1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { s };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(s));
@@ -949,6 +1139,10 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { s };
                     index_new = detail::ad_new<Type>("cosh", width(c),
                                                      1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { c };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(c));
@@ -968,8 +1162,16 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     size_t w = width(s);
                     index_s =
                         detail::ad_new<Type>("sincosh[s]", w, 1, indices, weights_s);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { s };
+                        detail::ad_set_hessian<Type>(index_s, 1, indices, h);
+                    }
                     index_c =
                         detail::ad_new<Type>("sincosh[c]", w, 1, indices, weights_c);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { c };
+                        detail::ad_set_hessian<Type>(index_c, 1, indices, h);
+                    }
                 }
             }
             return {
@@ -991,6 +1193,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { sqr(sech(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "tanh", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type h[1] = { -2.f * result * fnmadd(result, result, 1),
+                                       };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -1009,6 +1216,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rsqrt((Scalar) 1 + sqr(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "asinh", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rsqrt((Scalar) 1 + sqr(m_value));
+                        Type h[1] = { -m_value * d * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -1027,6 +1239,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rsqrt(sqr(m_value) - (Scalar) 1) };
                     index_new = detail::ad_new<Type>(
                         "acosh", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rsqrt(sqr(m_value) - (Scalar) 1);
+                        Type h[1] = { -m_value * d * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -1045,6 +1262,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                     Type weights[1] = { rcp((Scalar) 1 - sqr(m_value)) };
                     index_new = detail::ad_new<Type>(
                         "atanh", width(result), 1, indices, weights);
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>())) {
+                        Type d = rcp((Scalar) 1 - sqr(m_value));
+                        Type h[1] = { 2.f * m_value * sqr(d) };
+                        detail::ad_set_hessian<Type>(index_new, 1, indices, h);
+                    }
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -1285,6 +1507,11 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
                                                (Scalar) 0, result / m_value) };
                     index_new = detail::ad_new<Type>(
                         "prod", 1, 1, indices, weights);
+                    // The Hessian couples all entries, which ad_hvp() can't represent
+                    if (DRJIT_UNLIKELY(detail::ad_record_hessian<Type>()) &&
+                        width(m_value) > 1)
+                        detail::ad_set_hessian<Type>(index_new, 0, nullptr,
+                                                     nullptr);
                 }
             }
             return DiffArray::create(index_new, std::move(result));
@@ -1617,6 +1844,14 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
             return *this;
     }
 
+    DiffArray migrate_device_(int32_t device) const {
+        DRJIT_MARK_USED(device);
+        if constexpr (is_jit_v<Type_>)
+            return m_value.migrate_device_(device);
+        else
+            return *this;
+    }
+
     bool schedule_() const {
         if constexpr (is_jit_v<Type_>)
             return m_value.schedule_();
@@ -1643,6 +1878,42 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
             detail::ad_traverse<Type>(mode, flags);
     }
 
+    void hvp_(uint32_t flags) const {
+        DRJIT_MARK_USED(flags);
+        if constexpr (IsEnabled)
+            detail::ad_hvp<Type>(m_index, flags);
+    }
+
+    static void set_record_hessian_(bool value) {
+        DRJIT_MARK_USED(value);
+        if constexpr (IsEnabled)
+            detail::ad_set_record_hessian<Type>(value);
+    }
+
+    static bool record_hessian_() {
+        if constexpr (IsEnabled)
+            return detail::ad_record_hessian<Type>();
+        else
+            return false;
+    }
+
+    static void set_isolated_graph_(bool value) {
+        DRJIT_MARK_USED(value);
+        if constexpr (IsEnabled) {
+            if (value)
+                detail::ad_isolated_graph_enter<Type>();
+            else
+                detail::ad_isolated_graph_leave<Type>();
+        }
+    }
+
+    static bool isolated_graph_() {
+        if constexpr (IsEnabled)
+            return detail::ad_isolated_graph<Type>();
+        else
+            return false;
+    }
+
     void set_label_(const char *label) {
         set_label(m_value, label);
 
@@ -1700,6 +1971,23 @@ struct DiffArray : ArrayBase<value_t<Type_>, is_mask_v<Type_>, DiffArray<Type_>>
             detail::ad_accum_grad<Type>(m_index, value, fail_if_missing);
     }
 
+    void set_grad_sparse_(bool value) {
+        DRJIT_MARK_USED(value);
+        if constexpr (IsEnabled)
+            detail::ad_set_grad_sparse<Type>(m_index, value);
+    }
+
+    std::pair<uint32_array_t<Type>, Type> grad_sparse_() const {
+        uint32_array_t<Type> rows{};
+        Type values{};
+        if constexpr (IsEnabled) {
+            if (!detail::ad_grad_sparse<Type>(m_index, rows, values))
+                drjit_raise("grad_sparse_(): sparse gradients were not "
+                            "enabled for this variable!");
+        }
+        return { rows, values };
+    }
+
     size_t size() const {
         if constexpr (std::is_scalar_v<Type>)
             return 1;
@@ -1823,6 +2111,10 @@ protected:
         ad_inc_ref_cond_impl<T>(uint32_t) noexcept (true);                     \
     extern template DRJIT_AD_EXPORT void                                       \
         ad_dec_ref_impl<T>(uint32_t) noexcept (true);                          \
+    extern template DRJIT_AD_EXPORT void                                       \
+        ad_inc_ref_n_impl<T>(size_t, const uint32_t *) noexcept (true);        \
+    extern template DRJIT_AD_EXPORT void                                       \
+        ad_dec_ref_n_impl<T>(size_t, const uint32_t *) noexcept (true);        \
     extern template DRJIT_AD_EXPORT uint32_t ad_new<T>(const char *, size_t,   \
                                                        uint32_t, uint32_t *,   \
                                                        T *);                   \
@@ -1831,12 +2123,26 @@ protected:
                                                         bool);                 \
     extern template DRJIT_AD_EXPORT void ad_accum_grad<T>(uint32_t, const T &, \
                                                           bool);               \
+    extern template DRJIT_AD_EXPORT void ad_set_grad_sparse<T>(uint32_t,       \
+                                                               bool);          \
+    extern template DRJIT_AD_EXPORT bool ad_grad_sparse<T, Index>(             \
+        uint32_t, Index &, T &);                                               \
     extern template DRJIT_AD_EXPORT void ad_set_label<T>(uint32_t,             \
                                                          const char *);        \
     extern template DRJIT_AD_EXPORT const char *ad_label<T>(uint32_t);         \
     extern template DRJIT_AD_EXPORT const char *ad_graphviz<T>();              \
     extern template DRJIT_AD_EXPORT void ad_enqueue<T>(ADMode, uint32_t);      \
     extern template DRJIT_AD_EXPORT void ad_traverse<T>(ADMode, uint32_t);     \
+    extern template DRJIT_AD_EXPORT void ad_set_record_hessian<T>(bool);       \
+    extern template DRJIT_AD_EXPORT bool                                       \
+        ad_record_hessian<T>() noexcept (true);                                \
+    extern template DRJIT_AD_EXPORT void ad_set_hessian<T>(                    \
+        uint32_t, uint32_t, const uint32_t *, const T *);                      \
+    extern template DRJIT_AD_EXPORT void ad_hvp<T>(uint32_t, uint32_t);        \
+    extern template DRJIT_AD_EXPORT void ad_isolated_graph_enter<T>();         \
+    extern template DRJIT_AD_EXPORT void ad_isolated_graph_leave<T>();         \
+    extern template DRJIT_AD_EXPORT bool                                       \
+        ad_isolated_graph<T>() noexcept (true);                                \
     extern template DRJIT_AD_EXPORT uint32_t ad_new_select<T, Mask>(           \
         const char *, size_t, const Mask &, uint32_t, uint32_t);               \
     extern template DRJIT_AD_EXPORT uint32_t ad_new_gather<T, Mask, Index>(    \
@@ -1847,8 +2153,8 @@ protected:
     extern template DRJIT_AD_EXPORT void ad_add_edge<T>(uint32_t, uint32_t,    \
                                                         DiffCallback *);       \
     extern template DRJIT_AD_EXPORT size_t ad_implicit<T>();                   \
-    extern template DRJIT_AD_EXPORT void ad_extract_implicit<T>(size_t,        \
-                                                                uint32_t *);   \
+    extern template DRJIT_AD_EXPORT size_t ad_extract_implicit<T>(size_t,      \
+                                                                  uint32_t *); \
     extern template DRJIT_AD_EXPORT void                                       \
     ad_scope_enter<T>(ADScope, size_t, const uint32_t *);                      \
     extern template DRJIT_AD_EXPORT void ad_scope_leave<T>(bool);              \
@@ -1870,8 +2176,111 @@ extern DRJIT_AD_EXPORT const char *ad_whos();
 extern DRJIT_AD_EXPORT void ad_prefix_push(const char *value);
 extern DRJIT_AD_EXPORT void ad_prefix_pop();
 
+/// Return how often a thread had to wait for a lock within the AD backend
+extern DRJIT_AD_EXPORT size_t ad_lock_contention();
+
+/// Reset the counter returned by \ref ad_lock_contention()
+extern DRJIT_AD_EXPORT void ad_lock_contention_clear();
+
+/// Return timing and size statistics gathered by the AD backend
+extern DRJIT_AD_EXPORT ADStats ad_stats();
+
+/// Reset the counters returned by \ref ad_stats()
+extern DRJIT_AD_EXPORT void ad_stats_clear();
+
+using ADStatsCallback = void (*)(void *payload, const char *label,
+                                 size_t variables, size_t edges,
+                                 size_t grad_bytes);
+
+/**
+ * \brief Invoke \c callback for every group of AD variables, reporting the
+ * number of variables, incoming edges, and the gradient storage in bytes
+ *
+ * Variables are grouped by the prefix of their label (i.e., the active \ref
+ * ad_prefix_push() scopes) or by the label itself when there is no prefix.
+ * Groups holding the most gradient storage are reported first.
+ */
+extern DRJIT_AD_EXPORT void ad_stats_labels(ADStatsCallback callback,
+                                            void *payload);
+
+/// Is the recording of timeline events enabled? See \ref trace_enable()
+extern DRJIT_AD_EXPORT std::atomic<bool> trace_active;
+
+/**
+ * \brief Start recording timestamped events into a ring buffer with room for
+ * \c capacity events; when it fills up, the oldest events are overwritten
+ *
+ * The AD backend records the depth-first search, sorting, propagation,
+ * special edge callbacks and cleanup of every traversal, and vectorized
+ * method calls record the tracing of every instance bucket (in translation
+ * units that include this header). Other subsystems (e.g. the Python
+ * bindings) add their own events via \ref trace_record(). When disabled,
+ * each instrumented site costs a single relaxed atomic load.
+ */
+extern DRJIT_AD_EXPORT void trace_enable(size_t capacity = 1 << 20);
+
+/// Stop recording timeline events (the recorded events are kept)
+extern DRJIT_AD_EXPORT void trace_disable();
+
+/// Discard all recorded timeline events
+extern DRJIT_AD_EXPORT void trace_clear();
+
+/**
+ * \brief Record an event spanning the interval <tt>[start, end]</tt> (see
+ * \ref trace_time()) if tracing is enabled
+ *
+ * The \c name and \c category strings are referenced and must remain valid
+ * until the events are exported (e.g. string literals, or strings returned by
+ * \ref trace_intern()). An optional integer argument (e.g. a size) is
+ * reported unless it equals <tt>(uint64_t) -1</tt>.
+ */
+extern DRJIT_AD_EXPORT void trace_record(const char *name,
+                                         const char *category, uint64_t start,
+                                         uint64_t end,
+                                         uint64_t arg = (uint64_t) -1);
+
+/// Return a copy of \c str that remains valid until the process exits
+extern DRJIT_AD_EXPORT const char *trace_intern(const char *str);
+
+/**
+ * \brief Return the recorded events in the Chrome trace event format (JSON),
+ * which can be opened in <tt>chrome://tracing</tt> or Perfetto
+ *
+ * The returned string remains valid until the next call on the same thread.
+ */
+extern DRJIT_AD_EXPORT const char *trace_export();
+
+/// Time stamp in nanoseconds used by \ref trace_record()
+inline uint64_t trace_time() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Records an event spanning the lifetime of this object when tracing is enabled
+struct TraceScope {
+    TraceScope(const char *name, const char *category,
+               uint64_t arg = (uint64_t) -1)
+        : name(name), category(category), arg(arg),
+          start(trace_active.load(std::memory_order_relaxed) ? trace_time() : 0) { }
+
+    ~TraceScope() {
+        if (start)
+            trace_record(name, category, start, trace_time(), arg);
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+    const char *name, *category;
+    uint64_t arg, start;
+};
+
 NAMESPACE_END(drjit)
 
 #if defined(DRJIT_VCALL_H)
 #  include <drjit/vcall_autodiff.h>
 #endif
+
+#if defined(DRJIT_MATRIX_H)
+#  include <drjit/matrix_autodiff.h>
+#endif
@@ -0,0 +1,306 @@
+/*
+    drjit/bvh.h -- Linear bounding volume hierarchy (LBVH) construction and
+    traversal for JIT arrays
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/morton.h>
+#include <drjit/util.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/// Inverse of \ref radix_key() for single precision floats
+template <typename UInt32> float32_array_t<UInt32> lbvh_key_to_float(const UInt32 &key) {
+    return reinterpret_array<float32_array_t<UInt32>>(
+        key ^ ((sr<31>(key) - 1u) | 0x80000000u));
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Linear bounding volume hierarchy over a set of axis-aligned boxes
+ *
+ * The constructor implements the fully parallel method of Karras
+ * ("Maximizing Parallelism in the Construction of BVHs, Octrees, and k-d
+ * Trees", HPG 2012): the box centroids are quantized to 10 bits per axis
+ * within the scene bounds and mapped to 30-bit Morton codes, which are
+ * sorted using \ref argsort(). Every internal node then independently
+ * determines the range of sorted primitives it covers and the position
+ * where this range splits into its two children (ties between identical
+ * codes are resolved using the primitive index). Finally, every leaf walks
+ * up to the root within a \ref Loop and merges its bounds into those of its
+ * ancestors using atomic integer minima/maxima over order-preserving keys.
+ *
+ * A hierarchy over \c n primitives has <tt>2n-1</tt> nodes: internal nodes
+ * are stored first (index 0 is the root), followed by the leaves in Morton
+ * order. Besides its bounds, each node records a \c skip link to the node
+ * that follows its subtree in depth-first order, which permits traversal
+ * without a per-lane stack (see \ref LBVHTraversal).
+ *
+ * Construction evaluates the inputs and launches several kernels, hence it
+ * cannot be used within recorded loops or virtual function calls.
+ */
+template <typename Float_> struct LBVH {
+    using Float   = detached_t<Float_>;
+    using UInt32  = uint32_array_t<Float>;
+    using Int32   = int32_array_t<Float>;
+    using Mask    = mask_t<Float>;
+    using Array3f = Array<Float, 3>;
+    using Array3u = Array<UInt32, 3>;
+
+    static_assert(is_jit_v<Float> && std::is_same_v<scalar_t<Float>, float>,
+                  "LBVH: requires a single precision JIT array type!");
+
+    /// Marks the end of a traversal
+    static constexpr uint32_t Invalid = 0xffffffffu;
+
+    /// Number of primitives (leaves)
+    uint32_t size = 0;
+
+    /// Bounds of all nodes: internal nodes first, followed by the leaves
+    Array3f bbox_min, bbox_max;
+
+    /// First child of every internal node
+    UInt32 child;
+
+    /// Next node in depth-first order after the subtree of every node
+    UInt32 skip;
+
+    /// Original index of the primitive referenced by each leaf
+    UInt32 prim_index;
+
+    LBVH() = default;
+
+    /// Build a hierarchy over the boxes <tt>[prim_min[i], prim_max[i]]</tt>
+    LBVH(const Array3f &prim_min, const Array3f &prim_max) {
+        size_t n_ = width(prim_min);
+        if (n_ == 0)
+            drjit_raise("drjit::LBVH(): at least one primitive is required!");
+        if (n_ >= (1ull << 29))
+            drjit_raise("drjit::LBVH(): too many primitives (%zu)!", n_);
+        if (width(prim_max) != n_)
+            drjit_raise("drjit::LBVH(): the bounding box arrays have "
+                        "mismatched sizes!");
+
+        uint32_t n = (uint32_t) n_, leaf_base = n - 1;
+        size = n;
+
+        // Quantize the centroids within the scene bounds and sort them
+        Array3f center = (prim_min + prim_max) * .5f, lo, scale;
+        for (size_t i = 0; i < 3; ++i) {
+            lo.entry(i) = min(center.entry(i));
+            Float extent = max(center.entry(i)) - lo.entry(i);
+            scale.entry(i) = select(extent > 0.f, 1023.f / extent, 0.f);
+        }
+
+        Array3u cell = Array3u(clamp((center - lo) * scale, 0.f, 1023.f));
+        UInt32 code = morton_encode(cell);
+        prim_index = argsort(code);
+        code = gather<UInt32>(code, prim_index);
+
+        Array3f leaf_min = gather<Array3f>(prim_min, prim_index),
+                leaf_max = gather<Array3f>(prim_max, prim_index);
+        UInt32 leaf = arange<UInt32>(n);
+
+        if (n == 1) {
+            bbox_min = leaf_min;
+            bbox_max = leaf_max;
+            child = zeros<UInt32>(1);
+            skip = full<UInt32>(Invalid, 1);
+            eval(bbox_min, bbox_max, child, skip, prim_index);
+            return;
+        }
+
+        eval(code);
+
+        // Length of the common prefix of the keys 'i' and 'j' (or -1)
+        auto delta = [&](const Int32 &i, const UInt32 &code_i,
+                         const Int32 &j) {
+            Mask valid = j >= 0 && j < (int32_t) n;
+            UInt32 x = code_i ^ gather<UInt32>(code, UInt32(j), valid);
+            Int32 result = select(neq(x, 0u), Int32(lzcnt(x)),
+                                  32 + Int32(lzcnt(UInt32(i ^ j))));
+            return select(valid, result, -1);
+        };
+
+        // Enough steps to cover ranges spanning all primitives
+        uint32_t steps = log2i(n) + 2;
+
+        Int32 i = arange<Int32>(n - 1);
+        UInt32 code_i = gather<UInt32>(code, UInt32(i));
+
+        // Direction of the range and a bound on its length
+        Int32 dir = select(delta(i, code_i, i + 1) > delta(i, code_i, i - 1),
+                           Int32(1), Int32(-1)),
+              delta_min = delta(i, code_i, i - dir),
+              l_max = 2;
+
+        for (uint32_t k = 0; k < steps; ++k) {
+            Mask grow = delta(i, code_i, i + l_max * dir) > delta_min;
+            masked(l_max, grow) = sl<1>(l_max);
+        }
+
+        // Binary search for the other end of the range
+        Int32 l = 0, t = sr<1>(l_max);
+        for (uint32_t k = 0; k <= steps; ++k) {
+            Mask extend = t > 0 && delta(i, code_i, i + (l + t) * dir) > delta_min;
+            masked(l, extend) += t;
+            t = sr<1>(t);
+        }
+
+        Int32 j = i + l * dir,
+              delta_node = delta(i, code_i, j);
+
+        // Binary search for the split position
+        Int32 s = 0;
+        for (uint32_t k = 1; k <= steps; ++k) {
+            Int32 t2 = (l + ((1 << k) - 1)) >> k;
+            Mask extend = delta(i, code_i, i + (s + t2) * dir) > delta_node;
+            masked(s, extend) += t2;
+        }
+
+        Int32 split = i + s * dir + minimum(dir, 0),
+              first = minimum(i, j),
+              last  = maximum(i, j);
+
+        UInt32 left  = UInt32(split) + select(eq(first, split), leaf_base, 0u),
+               right = UInt32(split) + 1u +
+                       select(eq(last, split + 1), leaf_base, 0u);
+        child = left;
+
+        /* The subtree of a node covering the primitives [first, last] is
+           followed by the right child of the node splitting at 'last' */
+        UInt32 split_right = empty<UInt32>(n - 1);
+        scatter(split_right, right, UInt32(split));
+        eval(child, split_right);
+
+        auto skip_link = [&](const UInt32 &last) {
+            Mask valid = last < leaf_base;
+            return select(valid, gather<UInt32>(split_right, last, valid),
+                          Invalid);
+        };
+
+        UInt32 node = arange<UInt32>(n - 1);
+        skip = empty<UInt32>(2 * n - 1);
+        scatter(skip, skip_link(UInt32(last)), node);
+        scatter(skip, skip_link(leaf), leaf_base + leaf);
+
+        UInt32 parent = full<UInt32>(Invalid, 2 * n - 1);
+        scatter(parent, node, left);
+        scatter(parent, node, right);
+        eval(skip, parent);
+
+        // Merge the leaf bounds into all of their ancestors
+        Array3u key_min = full<Array3u>(Invalid, n - 1),
+                key_max = zeros<Array3u>(n - 1),
+                leaf_key_min = detail::radix_key(leaf_min),
+                leaf_key_max = detail::radix_key(leaf_max);
+
+        UInt32 ancestor = gather<UInt32>(parent, leaf_base + leaf);
+        Loop<Mask> loop("drjit::LBVH()", ancestor);
+        while (loop(neq(ancestor, Invalid))) {
+            Mask active = neq(ancestor, Invalid);
+            for (size_t k = 0; k < 3; ++k) {
+                scatter_reduce(ReduceOp::Min, key_min.entry(k),
+                               leaf_key_min.entry(k), ancestor, active);
+                scatter_reduce(ReduceOp::Max, key_max.entry(k),
+                               leaf_key_max.entry(k), ancestor, active);
+            }
+            ancestor = select(active, gather<UInt32>(parent, ancestor, active),
+                              Invalid);
+        }
+
+        bbox_min = empty<Array3f>(2 * n - 1);
+        bbox_max = empty<Array3f>(2 * n - 1);
+        for (size_t k = 0; k < 3; ++k) {
+            scatter(bbox_min.entry(k), detail::lbvh_key_to_float(key_min.entry(k)), node);
+            scatter(bbox_max.entry(k), detail::lbvh_key_to_float(key_max.entry(k)), node);
+        }
+        scatter(bbox_min, leaf_min, leaf_base + leaf);
+        scatter(bbox_max, leaf_max, leaf_base + leaf);
+        eval(bbox_min, bbox_max, prim_index);
+    }
+};
+
+/**
+ * \brief Stackless depth-first traversal of an \ref LBVH
+ *
+ * The traversal state is a single node index per lane, which makes it cheap
+ * to carry through a \ref Loop. Each call to \ref next() visits one node:
+ * the traversal descends into the node when the user-provided predicate
+ * accepts its bounds, and otherwise follows the node's skip link. Lanes that
+ * accept a leaf receive the associated primitive index.
+ *
+ * \code
+ * LBVHTraversal<Float> it(bvh, active);
+ * Loop<Mask> loop("query", it, count);
+ * while (loop(it.active())) {
+ *     auto [prim, hit] = it.next([&](const Array3f &lo, const Array3f &hi) {
+ *         return all(lo <= query_max && hi >= query_min);
+ *     });
+ *     masked(count, hit) += 1;
+ * }
+ * \endcode
+ */
+template <typename Float_> struct LBVHTraversal {
+    using BVH     = LBVH<Float_>;
+    using UInt32  = typename BVH::UInt32;
+    using Mask    = typename BVH::Mask;
+    using Array3f = typename BVH::Array3f;
+
+    /// Node that is visited next, or \ref LBVH::Invalid
+    UInt32 node;
+
+    /// Start a traversal at the root, one per entry of \c active
+    LBVHTraversal(const BVH &bvh, const Mask &active)
+        : node(select(active, UInt32(0), UInt32(BVH::Invalid))), m_bvh(&bvh) { }
+
+    /// Return the lanes that have not finished traversing the hierarchy
+    Mask active() const { return neq(node, BVH::Invalid); }
+
+    /**
+     * \brief Visit the next node and return the index of a primitive along
+     * with a mask of lanes that accepted its leaf
+     *
+     * \c pred receives the bounds of the current node as two \c Array3f
+     * instances and must return a mask.
+     */
+    template <typename Predicate>
+    std::pair<UInt32, Mask> next(const Predicate &pred, Mask mask = true) {
+        const BVH &bvh = *m_bvh;
+        uint32_t leaf_base = bvh.size - 1;
+
+        mask &= active();
+        Array3f lo = gather<Array3f>(bvh.bbox_min, node, mask),
+                hi = gather<Array3f>(bvh.bbox_max, node, mask);
+
+        Mask hit     = mask && Mask(pred(lo, hi)),
+             is_leaf = node >= leaf_base,
+             descend = hit && !is_leaf,
+             found   = hit && is_leaf;
+
+        UInt32 prim = gather<UInt32>(bvh.prim_index, node - leaf_base, found),
+               next = select(descend, gather<UInt32>(bvh.child, node, descend),
+                             gather<UInt32>(bvh.skip, node, mask && !descend));
+
+        node = select(mask, next, node);
+        return { prim, found };
+    }
+
+    void loop_put(Loop<Mask> &loop) { loop.put(node); }
+
+private:
+    const BVH *m_bvh;
+};
+
+NAMESPACE_END(drjit)
@@ -1,5 +1,5 @@
 /*
-    drjit/color.h -- Color space transformations (only sRGB so far)
+    drjit/color.h -- Color space transformations (sRGB, XYZ, YCbCr, OKLab)
 
     Dr.Jit is a C++ template library for efficient vectorization and
     differentiation of numerical kernels on modern processor architectures.
@@ -89,4 +89,245 @@ template <typename Value> Value srgb_to_linear(const Value &x) {
     return r * x;
 }
 
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Piecewise linear approximation of the sRGB curve for quantization
+ * to 8 bits
+ *
+ * Following Giesen's "float->sRGB8 using SSE2" method, the interval
+ * <tt>[2^-13, 1)</tt> is split into 104 segments (eight per binade), each of
+ * which stores a 16-bit bias (upper half) and slope (lower half) applied to
+ * the next eight mantissa bits. The fit was chosen to minimize the maximum
+ * error, which stays below 0.54 units of the 8-bit result: the output
+ * matches correct rounding except within 0.04 units of a tie.
+ */
+static constexpr uint32_t srgb8_table[104] = {
+    0x005b0000, 0x006f0024, 0x00800000, 0x00800000, 0x00800000, 0x00800000, 0x00820000, 0x00880000,
+    0x008e0001, 0x009b0001, 0x00a80001, 0x00b50001, 0x00c20001, 0x00cf0001, 0x00f50018, 0x01000001,
+    0x0100001b, 0x010f001b, 0x0129001b, 0x0143001b, 0x01780025, 0x0180001b, 0x0190001b, 0x01aa001b,
+    0x01e40050, 0x0200004e, 0x022a004e, 0x02780056, 0x0291004e, 0x02e50050, 0x0300004e, 0x032c004e,
+    0x037800c4, 0x03e300b5, 0x044d00b5, 0x04b600b7, 0x050000b5, 0x057b00ac, 0x05e100a6, 0x0644009e,
+    0x069e0140, 0x0747012a, 0x07e5011b, 0x087a0121, 0x091500fb, 0x099d00f0, 0x0a2100e4, 0x0a9f00da,
+    0x0b1601b2, 0x0bf301b1, 0x0ccc0191, 0x0d9c0169, 0x0e55016f, 0x0f150146, 0x0fc10137, 0x10630143,
+    0x110a025b, 0x1239023d, 0x1358021a, 0x14650204, 0x156601ea, 0x165a01d3, 0x174501bc, 0x182a0197,
+    0x18fc0331, 0x1a9802f5, 0x1c1702cb, 0x1d7d02ad, 0x1ed4028d, 0x201b026d, 0x21520256, 0x227c0242,
+    0x23a0043e, 0x25c203fa, 0x27c003bf, 0x29a10392, 0x2b690368, 0x2d1f033a, 0x2ebe031d, 0x304d02ff,
+    0x31d205a9, 0x34ab054a, 0x37520509, 0x39d504c0, 0x3c37048a, 0x3e7b045a, 0x40a90423, 0x42be03fc,
+    0x44c30797, 0x488e0715, 0x4c1f06aa, 0x4f76065e, 0x52a5060e, 0x55ac05ca, 0x58940588, 0x5b5a0552,
+    0x5e0b0a26, 0x631c097f, 0x67dc08f0, 0x6c55087e, 0x70970811, 0x749f07b8, 0x787c076e, 0x7c35071e
+};
+
+/// Decoded values of all 256 sRGB8 codes
+struct Srgb8ToLinearTable {
+    float data[256];
+
+    Srgb8ToLinearTable() {
+        for (int i = 0; i < 256; ++i) {
+            double x = i / 255.0;
+            data[i] = (float) (x <= 0.04045 ? x * (1.0 / 12.92)
+                                            : std::pow((x + 0.055) * (1.0 / 1.055), 2.4));
+        }
+    }
+};
+
+/// Look up entries of a small host-side table (copied to the device for JIT arrays)
+template <typename Target, typename Index>
+Target color_lut(const scalar_t<Target> *table, size_t size, const Index &index) {
+    if constexpr (is_jit_v<Target>)
+        return gather<Target>(load<Target>(table, size), index);
+    else
+        return gather<Target>(table, index);
+}
+
+/// Multiply a 3D color by a row-major 3x3 matrix
+template <typename Array3>
+Array3 color_matrix(const Array3 &v, const double (&m)[9]) {
+    using Scalar = scalar_t<Array3>;
+    Array3 result;
+    for (size_t i = 0; i < 3; ++i)
+        result.entry(i) = fmadd(v.entry(0), Scalar(m[3 * i]),
+                          fmadd(v.entry(1), Scalar(m[3 * i + 1]),
+                                v.entry(2) * Scalar(m[3 * i + 2])));
+    return result;
+}
+
+/// Linear sRGB (D65) to CIE XYZ and back
+static constexpr double srgb_to_xyz_matrix[9] = {
+    0.4124564, 0.3575761, 0.1804375,
+    0.2126729, 0.7151522, 0.0721750,
+    0.0193339, 0.1191920, 0.9503041
+};
+
+static constexpr double xyz_to_srgb_matrix[9] = {
+     3.2404542, -1.5371385, -0.4985314,
+    -0.9692660,  1.8760108,  0.0415560,
+     0.0556434, -0.2040259,  1.0572252
+};
+
+/// Full-range BT.601 (JPEG) luma/chroma weights and their inverse
+static constexpr double srgb_to_ycbcr_matrix[9] = {
+     0.299,     0.587,     0.114,
+    -0.168736, -0.331264,  0.5,
+     0.5,      -0.418688, -0.081312
+};
+
+static constexpr double ycbcr_to_srgb_matrix[9] = {
+    1.0,  0.0,       1.402,
+    1.0, -0.344136, -0.714136,
+    1.0,  1.772,     0.0
+};
+
+/// Matrices of Ottosson's OKLab color space
+static constexpr double srgb_to_lms_matrix[9] = {
+    0.4122214708, 0.5363325363, 0.0514459929,
+    0.2119034982, 0.6806995451, 0.1073969566,
+    0.0883024619, 0.2817188376, 0.6299787005
+};
+
+static constexpr double lms_to_oklab_matrix[9] = {
+    0.2104542553,  0.7936177850, -0.0040720468,
+    1.9779984951, -2.4285922050,  0.4505937099,
+    0.0259040371,  0.7827717662, -0.8086757660
+};
+
+static constexpr double oklab_to_lms_matrix[9] = {
+    1.0,  0.3963377774,  0.2158037573,
+    1.0, -0.1055613458, -0.0638541728,
+    1.0, -0.0894841775, -1.2914855480
+};
+
+static constexpr double lms_to_srgb_matrix[9] = {
+     4.0767416621, -3.3077115913,  0.2309699292,
+    -1.2684380046,  2.6097574011, -0.3413193965,
+    -0.0041960863, -0.7034186147,  1.7076147010
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Convert linear intensities to 8-bit sRGB codes in <tt>[0, 255]</tt>
+ *
+ * This is considerably cheaper than quantizing the output of \ref
+ * linear_to_srgb(): the transfer curve is evaluated using a single lookup
+ * into a 104-entry table of linear segments indexed by the exponent and
+ * leading mantissa bits of the input, followed by an integer multiply-add.
+ * Inputs are clamped to <tt>[0, 1]</tt>, and NaNs map to zero.
+ */
+template <typename Value> uint32_array_t<Value> linear_to_srgb8(const Value &x) {
+    using UInt32 = uint32_array_t<Value>;
+    static_assert(std::is_same_v<scalar_t<Value>, float>,
+                  "linear_to_srgb8(): requires a single precision input!");
+
+    constexpr float MinValue = 0x1p-13f;
+    Value y = minimum(select(x > MinValue, x, MinValue),
+                      OneMinusEpsilon<float>);
+
+    UInt32 u = reinterpret_array<UInt32>(y),
+           entry = detail::color_lut<UInt32>(detail::srgb8_table, 104,
+                                             sr<20>(u - 0x39000000u)),
+           bias = sl<9>(sr<16>(entry)),
+           scale = entry & 0xffffu,
+           t = sr<12>(u) & 0xffu;
+
+    return sr<16>(bias + scale * t);
+}
+
+/// Convert 8-bit sRGB codes in <tt>[0, 255]</tt> to linear intensities using a lookup table
+template <typename UInt32> float32_array_t<UInt32> srgb8_to_linear(const UInt32 &value) {
+    static const detail::Srgb8ToLinearTable table;
+    return detail::color_lut<float32_array_t<UInt32>>(table.data, 256, value);
+}
+
+/**
+ * \brief Quantize a linear RGB or RGBA color and pack it into 32-bit words
+ *
+ * The color channels are sRGB-encoded using \ref linear_to_srgb8(), while
+ * the alpha channel (if present) is stored linearly. Red occupies the least
+ * significant byte, hence an array of packed values is laid out as
+ * interleaved RGBA8 pixels in memory on little endian machines. The
+ * conversion only involves shifts and bitwise operations beyond the
+ * lookup, so it vectorizes on all backends.
+ */
+template <typename Array>
+uint32_array_t<value_t<Array>> pack_srgb8(const Array &color) {
+    using Value = value_t<Array>;
+    using UInt32 = uint32_array_t<Value>;
+    static_assert(array_size_v<Array> == 3 || array_size_v<Array> == 4,
+                  "pack_srgb8(): expected an RGB or RGBA color!");
+
+    UInt32 result = linear_to_srgb8(color.entry(0)) |
+                    sl<8>(linear_to_srgb8(color.entry(1))) |
+                    sl<16>(linear_to_srgb8(color.entry(2)));
+
+    if constexpr (array_size_v<Array> == 4)
+        result |= sl<24>(UInt32(fmadd(clamp(color.entry(3), 0.f, 1.f), 255.f, .5f)));
+    else
+        result |= 0xff000000u;
+
+    return result;
+}
+
+/// Inverse of \ref pack_srgb8()
+template <typename Array, typename UInt32> Array unpack_srgb8(const UInt32 &value) {
+    using Value = value_t<Array>;
+    static_assert(array_size_v<Array> == 3 || array_size_v<Array> == 4,
+                  "unpack_srgb8(): expected an RGB or RGBA color!");
+
+    Array result;
+    for (size_t i = 0; i < 3; ++i)
+        result.entry(i) = Value(srgb8_to_linear((value >> (8 * i)) & 0xffu));
+
+    if constexpr (array_size_v<Array> == 4)
+        result.entry(3) = Value(sr<24>(value)) * (1.f / 255.f);
+
+    return result;
+}
+
+/// Convert linear sRGB (D65) to CIE XYZ tristimulus values
+template <typename Array3> Array3 linear_srgb_to_xyz(const Array3 &rgb) {
+    return detail::color_matrix(rgb, detail::srgb_to_xyz_matrix);
+}
+
+/// Convert CIE XYZ tristimulus values to linear sRGB (D65)
+template <typename Array3> Array3 xyz_to_linear_srgb(const Array3 &xyz) {
+    return detail::color_matrix(xyz, detail::xyz_to_srgb_matrix);
+}
+
+/**
+ * \brief Convert gamma-encoded sRGB to full-range YCbCr (BT.601, as used by
+ * JPEG) with chroma centered at 0.5
+ */
+template <typename Array3> Array3 srgb_to_ycbcr(const Array3 &rgb) {
+    using Scalar = scalar_t<Array3>;
+    Array3 result = detail::color_matrix(rgb, detail::srgb_to_ycbcr_matrix);
+    result.entry(1) += Scalar(.5);
+    result.entry(2) += Scalar(.5);
+    return result;
+}
+
+/// Inverse of \ref srgb_to_ycbcr()
+template <typename Array3> Array3 ycbcr_to_srgb(Array3 ycbcr) {
+    using Scalar = scalar_t<Array3>;
+    ycbcr.entry(1) -= Scalar(.5);
+    ycbcr.entry(2) -= Scalar(.5);
+    return detail::color_matrix(ycbcr, detail::ycbcr_to_srgb_matrix);
+}
+
+/// Convert linear sRGB to Ottosson's perceptual OKLab color space
+template <typename Array3> Array3 linear_srgb_to_oklab(const Array3 &rgb) {
+    Array3 lms = detail::color_matrix(rgb, detail::srgb_to_lms_matrix);
+    for (size_t i = 0; i < 3; ++i)
+        lms.entry(i) = cbrt(lms.entry(i));
+    return detail::color_matrix(lms, detail::lms_to_oklab_matrix);
+}
+
+/// Inverse of \ref linear_srgb_to_oklab()
+template <typename Array3> Array3 oklab_to_linear_srgb(const Array3 &lab) {
+    Array3 lms = detail::color_matrix(lab, detail::oklab_to_lms_matrix);
+    for (size_t i = 0; i < 3; ++i)
+        lms.entry(i) = sqr(lms.entry(i)) * lms.entry(i);
+    return detail::color_matrix(lms, detail::lms_to_srgb_matrix);
+}
+
 NAMESPACE_END(drjit)
@@ -0,0 +1,675 @@
+/*
+    drjit/convolution.h -- Convolution and pooling layers on tensors
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/tensor.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Problem size of a D-dimensional convolution or pooling operation
+ *
+ * Images are stored channels-last, i.e. (batch, in[0], .., in[D-1], channels).
+ * Convolution weights have the shape (kernel[0], .., kernel[D-1],
+ * in_channels, out_channels).
+ */
+template <size_t D> struct ConvDims {
+    uint32_t batch, in_channels, out_channels;
+    uint32_t in[D], out[D], kernel[D];
+    uint32_t stride, padding;
+
+    uint32_t taps() const {
+        uint32_t result = 1;
+        for (size_t i = 0; i < D; ++i)
+            result *= kernel[i];
+        return result;
+    }
+
+    uint32_t in_pixels() const {
+        uint32_t result = batch;
+        for (size_t i = 0; i < D; ++i)
+            result *= in[i];
+        return result;
+    }
+
+    uint32_t out_pixels() const {
+        uint32_t result = batch;
+        for (size_t i = 0; i < D; ++i)
+            result *= out[i];
+        return result;
+    }
+};
+
+/// Number of output channels accumulated by each lane of a convolution
+static constexpr uint32_t ConvBlock = 4;
+
+/// Convolutions with up to this many multiply-adds per output are unrolled
+static constexpr uint32_t ConvUnroll = 64;
+
+/// Minimum number of lanes used to accumulate weight gradients
+static constexpr uint32_t ConvGradLanes = 16384;
+
+/// Split a linear pixel index into its batch and spatial coordinates
+template <size_t D, typename Index>
+Index conv_unravel(Index idx, const uint32_t *shape, Index *coord) {
+    for (size_t i = D; i-- > 0; ) {
+        Index next = idx / shape[i];
+        coord[i] = idx - next * shape[i];
+        idx = next;
+    }
+    return idx;
+}
+
+/// Linear pixel index of the given batch and spatial coordinates
+template <size_t D, typename Index>
+Index conv_ravel(const Index &batch, const Index *coord, const uint32_t *shape) {
+    Index result = batch;
+    for (size_t i = 0; i < D; ++i)
+        result = result * shape[i] + coord[i];
+    return result;
+}
+
+/// Spatial offset of the filter tap \c t
+template <size_t D> void conv_tap(const ConvDims<D> &d, uint32_t t, uint32_t *k) {
+    for (size_t i = D; i-- > 0; ) {
+        k[i] = t % d.kernel[i];
+        t /= d.kernel[i];
+    }
+}
+
+/**
+ * \brief Locate the source pixel that contributes to pixel \c q via filter
+ * tap \c k
+ *
+ * In the forward direction, \c q is an output pixel that reads the input
+ * pixel q * stride + k - padding. In the transposed direction, \c q is an
+ * input pixel that receives contributions from the output pixel
+ * (q + padding - k) / stride. The function returns the linear index of the
+ * source pixel and sets \c valid to false when it lies outside of the image.
+ */
+template <size_t D, typename Index, typename Mask>
+Index conv_source(const ConvDims<D> &d, const Index &batch, const Index *q,
+                  const uint32_t *k, bool transpose, Mask &valid) {
+    Index p[D];
+    valid = true;
+
+    for (size_t i = 0; i < D; ++i) {
+        if (!transpose) {
+            Index pos = q[i] * d.stride + k[i];
+            valid &= pos >= d.padding && pos < d.in[i] + d.padding;
+            p[i] = pos - d.padding;
+        } else {
+            Index pos = q[i] + d.padding;
+            valid &= pos >= k[i];
+            pos -= k[i];
+            Index next = pos / d.stride;
+            valid &= eq(pos, next * d.stride) && next < d.out[i];
+            p[i] = next;
+        }
+    }
+
+    return conv_ravel<D>(batch, p, transpose ? d.out : d.in);
+}
+
+/**
+ * \brief Evaluate a convolution (or, when \c transpose is set, its adjoint
+ * with respect to the input image)
+ *
+ * Every lane computes up to ConvBlock channels of one output pixel, so each
+ * gathered image entry feeds several FMAs. The filter taps are unrolled. On
+ * JIT backends, larger filters record a loop over the source channels, so
+ * that the convolution compiles to a single kernel without an intermediate
+ * im2col buffer.
+ */
+template <size_t D, typename Array>
+Array conv_kernel(const Array &x, const Array &w, const ConvDims<D> &d,
+                  bool transpose) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+
+    uint32_t src_channels = transpose ? d.out_channels : d.in_channels,
+             dst_channels = transpose ? d.in_channels : d.out_channels,
+             pixels = transpose ? d.in_pixels() : d.out_pixels(),
+             taps = d.taps(),
+             rc = drjit::minimum(dst_channels, ConvBlock);
+
+    if (pixels == 0 || dst_channels == 0)
+        return zeros<Array>(0);
+
+    uint32_t blocks = (dst_channels + rc - 1) / rc,
+             lanes = pixels * blocks;
+
+    Index idx = arange<Index>(lanes),
+          c0 = (idx % blocks) * rc,
+          pixel = idx / blocks,
+          q[D];
+    Index batch = conv_unravel<D>(pixel, transpose ? d.in : d.out, q);
+
+    Mask channel_valid[ConvBlock];
+    for (uint32_t c = 0; c < rc; ++c)
+        channel_valid[c] = c0 + c < dst_channels;
+
+    // Source pixels of all filter taps
+    dr_vector<Index> src(taps);
+    dr_vector<Mask> src_valid(taps);
+    for (uint32_t t = 0; t < taps; ++t) {
+        uint32_t k[D];
+        conv_tap(d, t, k);
+        src[t] = conv_source(d, batch, q, k, transpose, src_valid[t]) *
+                 src_channels;
+    }
+
+    Array acc[ConvBlock];
+    for (uint32_t c = 0; c < rc; ++c)
+        acc[c] = zeros<Array>(lanes);
+
+    auto step = [&](const auto &ci, const Mask &active) {
+        for (uint32_t t = 0; t < taps; ++t) {
+            Array xv = gather<Array>(x, src[t] + ci, active && src_valid[t]);
+
+            for (uint32_t c = 0; c < rc; ++c) {
+                Index wi = transpose
+                    ? (t * d.in_channels + c0 + c) * d.out_channels + ci
+                    : (t * d.in_channels + ci) * d.out_channels + c0 + c;
+                Array wv = gather<Array>(w, wi, active && channel_valid[c]);
+                acc[c] = fmadd(xv, wv, acc[c]);
+            }
+        }
+    };
+
+    bool unroll = true;
+    if constexpr (is_jit_v<Array>) {
+        if (taps * src_channels > ConvUnroll) {
+            Index ci = zeros<Index>(lanes);
+
+            Loop<Mask> loop("drjit::conv");
+            loop.put(ci);
+            for (uint32_t c = 0; c < rc; ++c)
+                loop.put(acc[c]);
+            loop.init();
+
+            while (loop(ci < src_channels)) {
+                step(ci, true);
+                ci += 1;
+            }
+
+            unroll = false;
+        }
+    }
+
+    if (unroll) {
+        for (uint32_t ci = 0; ci < src_channels; ++ci)
+            step(ci, true);
+    }
+
+    Array result = zeros<Array>(pixels * dst_channels);
+    for (uint32_t c = 0; c < rc; ++c)
+        scatter(result, acc[c], pixel * dst_channels + c0 + c,
+                channel_valid[c]);
+
+    return result;
+}
+
+/**
+ * \brief Adjoint of a convolution with respect to its weights
+ *
+ * The gradient of every weight is a sum over all output pixels. Lanes handle
+ * ConvBlock output channels of one weight and one chunk of output pixels,
+ * and a subsequent reduction combines the chunks.
+ */
+template <size_t D, typename Array>
+Array conv_grad_weight(const Array &x, const Array &grad,
+                       const ConvDims<D> &d) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+
+    uint32_t taps = d.taps(),
+             pixels = d.out_pixels(),
+             rc = drjit::minimum(d.out_channels, ConvBlock),
+             size = taps * d.in_channels * d.out_channels;
+
+    if (pixels == 0 || size == 0)
+        return zeros<Array>(size);
+
+    uint32_t blocks = (d.out_channels + rc - 1) / rc,
+             weights = taps * d.in_channels * blocks,
+             chunks = (ConvGradLanes + weights - 1) / weights;
+    chunks = drjit::minimum(chunks, pixels);
+    uint32_t chunk_size = (pixels + chunks - 1) / chunks;
+    chunks = (pixels + chunk_size - 1) / chunk_size;
+
+    uint32_t lanes = weights * chunks;
+    Index idx = arange<Index>(lanes),
+          c0 = (idx % blocks) * rc;
+    idx /= blocks;
+    Index ci = idx % d.in_channels;
+    idx /= d.in_channels;
+    Index t = idx % taps,
+          chunk = idx / taps;
+
+    // Filter tap offsets of every lane
+    Index k[D];
+    Index tmp = t;
+    for (size_t i = D; i-- > 0; ) {
+        Index next = tmp / d.kernel[i];
+        k[i] = tmp - next * d.kernel[i];
+        tmp = next;
+    }
+
+    Mask channel_valid[ConvBlock];
+    for (uint32_t c = 0; c < rc; ++c)
+        channel_valid[c] = c0 + c < d.out_channels;
+
+    Array acc[ConvBlock];
+    for (uint32_t c = 0; c < rc; ++c)
+        acc[c] = zeros<Array>(lanes);
+
+    Index start = chunk * chunk_size;
+
+    auto step = [&](const auto &j, const Mask &active_) {
+        Index pixel = start + j, q[D], p[D];
+        Mask active = active_ && pixel < pixels;
+        Index batch = conv_unravel<D>(pixel, d.out, q);
+
+        for (size_t i = 0; i < D; ++i) {
+            Index pos = q[i] * d.stride + k[i];
+            active &= pos >= d.padding && pos < d.in[i] + d.padding;
+            p[i] = pos - d.padding;
+        }
+
+        Array xv = gather<Array>(
+            x, conv_ravel<D>(batch, p, d.in) * d.in_channels + ci, active);
+
+        for (uint32_t c = 0; c < rc; ++c) {
+            Array gv = gather<Array>(grad, pixel * d.out_channels + c0 + c,
+                                     active && channel_valid[c]);
+            acc[c] = fmadd(xv, gv, acc[c]);
+        }
+    };
+
+    bool unroll = true;
+    if constexpr (is_jit_v<Array>) {
+        if (chunk_size > ConvUnroll) {
+            Index j = zeros<Index>(lanes);
+
+            Loop<Mask> loop("drjit::conv_grad_weight");
+            loop.put(j);
+            for (uint32_t c = 0; c < rc; ++c)
+                loop.put(acc[c]);
+            loop.init();
+
+            while (loop(j < chunk_size)) {
+                step(j, true);
+                j += 1;
+            }
+
+            unroll = false;
+        }
+    }
+
+    if (unroll) {
+        for (uint32_t j = 0; j < chunk_size; ++j)
+            step(j, true);
+    }
+
+    // Partial sums are stored chunk by chunk, followed by a reduction
+    Array partial = zeros<Array>(chunks * size);
+    Index weight = (t * d.in_channels + ci) * d.out_channels + c0;
+    for (uint32_t c = 0; c < rc; ++c)
+        scatter(partial, acc[c], chunk * size + weight + c, channel_valid[c]);
+
+    if (chunks == 1)
+        return partial;
+
+    return reduce_kernel(ReduceOp::Add, partial, ReduceDims { 1, chunks, size });
+}
+
+/**
+ * \brief Evaluate a pooling operation (\c op is \c Add for average pooling
+ * and \c Max for max pooling)
+ *
+ * When \c y and \c grad are specified, the function instead computes the
+ * forward-mode derivative of max pooling, which propagates the entries of
+ * \c grad that attain the maximum \c y.
+ */
+template <size_t D, typename Array>
+Array pool_kernel(ReduceOp op, const Array &x, const ConvDims<D> &d,
+                  const Array *y = nullptr, const Array *grad = nullptr) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+    using Scalar = scalar_t<Array>;
+
+    uint32_t channels = d.in_channels, taps = d.taps(),
+             lanes = d.out_pixels() * channels;
+
+    Index idx = arange<Index>(lanes),
+          c = idx % channels,
+          pixel = idx / channels,
+          q[D];
+    Index batch = conv_unravel<D>(pixel, d.out, q);
+
+    Array ym;
+    if (y)
+        ym = gather<Array>(*y, idx);
+
+    Array result = grad || op == ReduceOp::Add
+                       ? zeros<Array>(lanes)
+                       : full<Array>(reduce_identity<Scalar>(op), lanes);
+
+    for (uint32_t t = 0; t < taps; ++t) {
+        uint32_t k[D];
+        conv_tap(d, t, k);
+        Mask valid;
+        Index src = conv_source(d, batch, q, k, false, valid) * channels + c;
+        Array xv = gather<Array>(x, src, valid);
+
+        if (grad)
+            result += select(eq(xv, ym), gather<Array>(*grad, src, valid), 0);
+        else
+            result = reduce_combine(op, result, xv);
+    }
+
+    if (op == ReduceOp::Add)
+        result *= Scalar(1.f / taps);
+
+    return result;
+}
+
+/// Adjoint of \ref pool_kernel() with respect to the input image
+template <size_t D, typename Array>
+Array pool_grad(ReduceOp op, const Array &x, const Array &y,
+                const Array &grad, const ConvDims<D> &d) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+    using Scalar = scalar_t<Array>;
+
+    uint32_t channels = d.in_channels, taps = d.taps(),
+             lanes = d.in_pixels() * channels;
+
+    Index idx = arange<Index>(lanes),
+          c = idx % channels,
+          pixel = idx / channels,
+          p[D];
+    Index batch = conv_unravel<D>(pixel, d.in, p);
+
+    Array xv;
+    if (op == ReduceOp::Max)
+        xv = gather<Array>(x, idx);
+
+    Array result = zeros<Array>(lanes);
+    for (uint32_t t = 0; t < taps; ++t) {
+        uint32_t k[D];
+        conv_tap(d, t, k);
+        Mask valid;
+        Index dst = conv_source(d, batch, p, k, true, valid) * channels + c;
+
+        if (op == ReduceOp::Max)
+            valid &= eq(gather<Array>(y, dst, valid), xv);
+
+        result += gather<Array>(grad, dst, valid);
+    }
+
+    if (op == ReduceOp::Add)
+        result *= Scalar(1.f / taps);
+
+    return result;
+}
+
+template <size_t D, typename DiffArray>
+struct ConvOp
+    : CustomOp<DiffArray, DiffArray, DiffArray, DiffArray, ConvDims<D>> {
+    using Base = CustomOp<DiffArray, DiffArray, DiffArray, DiffArray, ConvDims<D>>;
+    using Array = detached_t<DiffArray>;
+
+    static constexpr bool ClearPrimal = false;
+
+    DiffArray eval(const DiffArray &x, const DiffArray &w,
+                   const ConvDims<D> &dims) override {
+        m_dims = dims;
+        return DiffArray(conv_kernel(detach(x), detach(w), dims, false));
+    }
+
+    void forward() override {
+        Array result = zeros<Array>(m_dims.out_pixels() * m_dims.out_channels);
+
+        if (Base::template grad_enabled_in<0>())
+            result += conv_kernel(detach(Base::template grad_in<0>()),
+                                  detach(Base::template value_in<1>()),
+                                  m_dims, false);
+
+        if (Base::template grad_enabled_in<1>())
+            result += conv_kernel(detach(Base::template value_in<0>()),
+                                  detach(Base::template grad_in<1>()),
+                                  m_dims, false);
+
+        Base::set_grad_out(DiffArray(result));
+    }
+
+    void backward() override {
+        Array grad = detach(Base::grad_out());
+
+        if (Base::template grad_enabled_in<0>())
+            Base::template set_grad_in<0>(DiffArray(conv_kernel(
+                grad, detach(Base::template value_in<1>()), m_dims, true)));
+
+        if (Base::template grad_enabled_in<1>())
+            Base::template set_grad_in<1>(DiffArray(conv_grad_weight(
+                detach(Base::template value_in<0>()), grad, m_dims)));
+    }
+
+    const char *name() const override { return "conv"; }
+
+private:
+    ConvDims<D> m_dims;
+};
+
+template <size_t D, typename DiffArray>
+struct PoolOp : CustomOp<DiffArray, DiffArray, DiffArray, ReduceOp, ConvDims<D>> {
+    using Base = CustomOp<DiffArray, DiffArray, DiffArray, ReduceOp, ConvDims<D>>;
+    using Array = detached_t<DiffArray>;
+
+    static constexpr bool ClearPrimal = false;
+
+    DiffArray eval(const DiffArray &x, const ReduceOp &op,
+                   const ConvDims<D> &dims) override {
+        m_op = op;
+        m_dims = dims;
+        m_result = pool_kernel(op, detach(x), dims);
+        return DiffArray(m_result);
+    }
+
+    void forward() override {
+        Array grad = detach(Base::template grad_in<0>()), result;
+
+        if (m_op == ReduceOp::Add)
+            result = pool_kernel(m_op, grad, m_dims);
+        else
+            result = pool_kernel(m_op, detach(Base::template value_in<0>()),
+                                 m_dims, &m_result, &grad);
+
+        Base::set_grad_out(DiffArray(result));
+    }
+
+    void backward() override {
+        Base::template set_grad_in<0>(DiffArray(
+            pool_grad(m_op, detach(Base::template value_in<0>()), m_result,
+                      detach(Base::grad_out()), m_dims)));
+    }
+
+    const char *name() const override { return "pool"; }
+
+private:
+    ReduceOp m_op;
+    ConvDims<D> m_dims;
+    Array m_result;
+};
+
+/// Validate the shape of an image and fill the corresponding fields of \c d
+template <size_t D, typename T>
+dr_vector<size_t> conv_image(const char *name, const T &input, ConvDims<D> &d) {
+    size_t ndim = input.ndim();
+    if (ndim != D + 1 && ndim != D + 2)
+        drjit_raise("drjit::%s(): the input must be a tensor of shape "
+                    "([batch,] spatial dims.., channels) with %zu or %zu "
+                    "dimensions (got %zu)!", name, D + 1, D + 2, ndim);
+
+    size_t offset = ndim - D - 1;
+    d.batch = offset ? (uint32_t) input.shape(0) : 1;
+    for (size_t i = 0; i < D; ++i)
+        d.in[i] = (uint32_t) input.shape(offset + i);
+    d.in_channels = (uint32_t) input.shape(ndim - 1);
+
+    return dr_vector<size_t>(input.shape().data(),
+                             input.shape().data() + ndim);
+}
+
+/// Compute the output resolution, returns the tensor shape of the output
+template <size_t D>
+dr_vector<size_t> conv_output(const char *name, ConvDims<D> &d,
+                              dr_vector<size_t> shape, uint32_t channels) {
+    if (d.stride == 0)
+        drjit_raise("drjit::%s(): the stride must be positive!", name);
+
+    size_t offset = shape.size() - D - 1;
+    for (size_t i = 0; i < D; ++i) {
+        if (d.kernel[i] == 0 || d.in[i] + 2 * d.padding < d.kernel[i])
+            drjit_raise("drjit::%s(): the kernel (size %u) does not fit into "
+                        "dimension %zu of the input (size %u + padding)!",
+                        name, d.kernel[i], i, d.in[i]);
+        d.out[i] = (d.in[i] + 2 * d.padding - d.kernel[i]) / d.stride + 1;
+        shape[offset + i] = d.out[i];
+    }
+    shape[shape.size() - 1] = channels;
+
+    return shape;
+}
+
+template <size_t D, typename T>
+T tensor_conv(const char *name, const T &input, const T &weight,
+              size_t stride, size_t padding) {
+    using Array = typename T::Array;
+
+    ConvDims<D> d;
+    dr_vector<size_t> shape = conv_image(name, input, d);
+
+    if (weight.ndim() != D + 2)
+        drjit_raise("drjit::%s(): the weights must be a tensor of shape "
+                    "(spatial dims.., in_channels, out_channels) with %zu "
+                    "dimensions (got %zu)!", name, D + 2, weight.ndim());
+
+    if (weight.shape(D) != d.in_channels)
+        drjit_raise("drjit::%s(): channel count mismatch between the input "
+                    "(%u) and the weights (%zu)!", name, d.in_channels,
+                    weight.shape(D));
+
+    for (size_t i = 0; i < D; ++i)
+        d.kernel[i] = (uint32_t) weight.shape(i);
+    d.out_channels = (uint32_t) weight.shape(D + 1);
+    d.stride = (uint32_t) stride;
+    d.padding = (uint32_t) padding;
+    shape = conv_output(name, d, shape, d.out_channels);
+
+    Array result;
+    if constexpr (is_diff_v<Array>)
+        result = custom<ConvOp<D, Array>>(input.array(), weight.array(), d);
+    else
+        result = conv_kernel(input.array(), weight.array(), d, false);
+
+    return T(result, shape.size(), shape.data());
+}
+
+template <size_t D, typename T>
+T tensor_pool(const char *name, ReduceOp op, const T &input,
+              size_t kernel_size, size_t stride) {
+    using Array = typename T::Array;
+
+    ConvDims<D> d;
+    dr_vector<size_t> shape = conv_image(name, input, d);
+
+    d.out_channels = d.in_channels;
+    for (size_t i = 0; i < D; ++i)
+        d.kernel[i] = (uint32_t) kernel_size;
+    d.stride = (uint32_t) (stride ? stride : kernel_size);
+    d.padding = 0;
+    shape = conv_output(name, d, shape, d.in_channels);
+
+    Array result;
+    if constexpr (is_diff_v<Array>)
+        result = custom<PoolOp<D, Array>>(input.array(), op, d);
+    else
+        result = pool_kernel(op, input.array(), d);
+
+    return T(result, shape.size(), shape.data());
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief 2D convolution of a channels-last image tensor of shape
+ * ([batch,] height, width, in_channels) with weights of shape
+ * (kernel_height, kernel_width, in_channels, out_channels)
+ *
+ * The input is zero-padded by \c padding pixels on every side.
+ */
+template <typename Array>
+Tensor<Array> conv2d(const Tensor<Array> &input, const Tensor<Array> &weight,
+                     size_t stride = 1, size_t padding = 0) {
+    return detail::tensor_conv<2>("conv2d", input, weight, stride, padding);
+}
+
+/// 3D convolution, see \ref conv2d()
+template <typename Array>
+Tensor<Array> conv3d(const Tensor<Array> &input, const Tensor<Array> &weight,
+                     size_t stride = 1, size_t padding = 0) {
+    return detail::tensor_conv<3>("conv3d", input, weight, stride, padding);
+}
+
+/**
+ * \brief Average pooling of a channels-last image tensor of shape
+ * ([batch,] height, width, channels) over square windows
+ *
+ * The stride defaults to the window size when set to zero.
+ */
+template <typename Array>
+Tensor<Array> avg_pool2d(const Tensor<Array> &input, size_t kernel_size,
+                         size_t stride = 0) {
+    return detail::tensor_pool<2>("avg_pool2d", ReduceOp::Add, input,
+                                  kernel_size, stride);
+}
+
+/// Max pooling, see \ref avg_pool2d()
+template <typename Array>
+Tensor<Array> max_pool2d(const Tensor<Array> &input, size_t kernel_size,
+                         size_t stride = 0) {
+    return detail::tensor_pool<2>("max_pool2d", ReduceOp::Max, input,
+                                  kernel_size, stride);
+}
+
+/// 3D average pooling, see \ref avg_pool2d()
+template <typename Array>
+Tensor<Array> avg_pool3d(const Tensor<Array> &input, size_t kernel_size,
+                         size_t stride = 0) {
+    return detail::tensor_pool<3>("avg_pool3d", ReduceOp::Add, input,
+                                  kernel_size, stride);
+}
+
+/// 3D max pooling, see \ref avg_pool2d()
+template <typename Array>
+Tensor<Array> max_pool3d(const Tensor<Array> &input, size_t kernel_size,
+                         size_t stride = 0) {
+    return detail::tensor_pool<3>("max_pool3d", ReduceOp::Max, input,
+                                  kernel_size, stride);
+}
+
+NAMESPACE_END(drjit)
@@ -155,10 +155,10 @@ protected:
 
     /// Release the implicit dependencies registered via add_input/add_output
     void clear_implicit_dependencies() {
-        for (size_t i = 0; i < m_implicit_in.size(); ++i)
-            detail::ad_dec_ref<Type>(m_implicit_in[i]);
-        for (size_t i = 0; i < m_implicit_out.size(); ++i)
-            detail::ad_dec_ref<Type>(m_implicit_out[i]);
+        detail::ad_dec_ref_n_impl<Type>(m_implicit_in.size(),
+                                        m_implicit_in.data());
+        detail::ad_dec_ref_n_impl<Type>(m_implicit_out.size(),
+                                        m_implicit_out.data());
         m_implicit_in.clear();
         m_implicit_out.clear();
     }
@@ -343,4 +343,266 @@ template <typename Custom, typename... Input> auto custom(const Input&... input)
     return output;
 }
 
+NAMESPACE_BEGIN(detail)
+
+/// CustomOp that recomputes the subgraph of a function during AD traversal
+template <typename DiffType, typename Output, typename Func, typename... Args>
+struct Checkpoint : CustomOp<DiffType, Output, Func, Args...> {
+    using Base = CustomOp<DiffType, Output, Func, Args...>;
+
+    static constexpr bool ClearPrimal = false;
+
+    Output eval(const Func &func, const Args &... args) override {
+        return func(args...);
+    }
+
+    void forward() override {
+        forward_impl(std::make_index_sequence<sizeof...(Args)>());
+    }
+
+    void backward() override {
+        backward_impl(std::make_index_sequence<sizeof...(Args)>());
+    }
+
+    const char *name() const override { return "Checkpoint"; }
+
+private:
+    template <size_t... Is> void forward_impl(std::index_sequence<Is...>) {
+        dr_tuple<Args...> args(Base::template value_in<1 + Is>()...);
+        enable_grad(args.template get<Is>()...);
+
+        Output result = Base::template value_in<0>()(args.template get<Is>()...);
+
+        (set_grad(args.template get<Is>(), Base::template grad_in<1 + Is>()), ...);
+        enqueue(ADMode::Forward, args.template get<Is>()...);
+        traverse<DiffType>(ADMode::Forward);
+
+        Base::set_grad_out(grad<false>(result));
+    }
+
+    template <size_t... Is> void backward_impl(std::index_sequence<Is...>) {
+        dr_tuple<Args...> args(Base::template value_in<1 + Is>()...);
+        enable_grad(args.template get<Is>()...);
+
+        Output result = Base::template value_in<0>()(args.template get<Is>()...);
+
+        set_grad(result, Base::grad_out());
+        enqueue(ADMode::Backward, result);
+        traverse<DiffType>(ADMode::Backward);
+
+        ((Base::template grad_enabled_in<1 + Is>()
+              ? Base::template set_grad_in<1 + Is>(grad<false>(args.template get<Is>()))
+              : void()), ...);
+    }
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Evaluate ``func(args...)`` without retaining its intermediate AD
+ * graph, and recompute it on demand during forward/backward traversal.
+ *
+ * The function is evaluated with detached inputs, and only the primal input
+ * values are kept along with a single edge in the AD graph. When this edge is
+ * traversed, ``func`` is evaluated a second time with gradient tracking
+ * enabled, and derivatives are propagated through the recomputed subgraph
+ * (gradient checkpointing). ``func`` should only depend differentiably on its
+ * arguments and must be deterministic.
+ */
+template <typename DiffType, typename Func, typename... Args>
+auto checkpoint(const Func &func, const Args &... args) {
+    using Output = std::decay_t<decltype(func(args...))>;
+    return custom<detail::Checkpoint<DiffType, Output, Func, Args...>>(func, args...);
+}
+
+/**
+ * \brief Base class of custom differentiable operations whose inputs and
+ * output are fixed at compile time.
+ *
+ * This is a lightweight alternative to \ref CustomOp for small operations
+ * that are invoked very frequently. The derived class is a plain value type
+ * without virtual functions, and it must provide the following methods:
+ *
+ * \code
+ * // Primal evaluation, receives and returns detached values
+ * Output eval(const Input&... input);
+ *
+ * // Forward-mode AD: map input gradients to the output gradient
+ * Output forward(const Input&... grad_in);
+ *
+ * // Backward-mode AD: map the output gradient to input gradients
+ * Inputs backward(const Output &grad_out);
+ * \endcode
+ *
+ * Any primal values needed by the derivatives must be cached in fields of
+ * the derived class by \ref eval(). The operation is invoked via \ref
+ * custom_static(), which moves it into the AD edge along with the (primal
+ * free) inputs and output. The edge is the only heap allocation, and the
+ * interface nodes of the edge are only created when several variables enter
+ * or leave it. Implicit dependencies (\ref CustomOp::add_input()) are not
+ * supported.
+ */
+template <typename DiffType_, typename Output_, typename... Input>
+struct StaticCustomOp {
+    using DiffType = DiffType_;
+    using Type     = detached_t<DiffType_>;
+    using Output   = Output_;
+    using Inputs   = dr_tuple<Input...>;
+
+    /// Return a descriptive name (used in GraphViz output)
+    const char *name() const { return "StaticCustomOp"; }
+};
+
+NAMESPACE_BEGIN(detail)
+
+/* Invoke 'func' on the index of every variable that is attached to the AD
+   graph, or (if 'Attachable' is set) that \ref enable_grad() would attach */
+template <bool Attachable = false, typename T, typename Func>
+void visit_diff_vars(const T &value, const Func &func) {
+    if constexpr (is_array_v<T>) {
+        if constexpr (array_depth_v<T> == 1) {
+            if constexpr (is_diff_v<T>) {
+                if constexpr (Attachable) {
+                    if constexpr (std::is_floating_point_v<scalar_t<T>>)
+                        func(value.index_ad());
+                } else if (grad_enabled(value)) {
+                    func(value.index_ad());
+                }
+            }
+        } else {
+            for (size_t i = 0; i < value.size(); ++i)
+                visit_diff_vars<Attachable>(value.entry(i), func);
+        }
+    } else if constexpr (is_drjit_struct_v<T>) {
+        struct_support_t<T>::apply_1(value,
+            [&](auto &x) { visit_diff_vars<Attachable>(x, func); });
+    }
+}
+
+/// AD edge that stores a \ref StaticCustomOp along with its inputs and output
+template <typename Op, typename... Input>
+struct StaticCustomEdge final : DiffCallback {
+    using Output = typename Op::Output;
+
+    StaticCustomEdge(Op &&op, const Input &... input, const Output &output)
+        : m_op(std::move(op)), m_inputs(clear_primal(input)...),
+          m_output(clear_primal(output)) { }
+
+    ~StaticCustomEdge() {
+        // Reference counts of 'm_output' were released in custom_static()
+        clear_diff_vars(m_output);
+    }
+
+    void forward() override {
+        forward_impl(std::make_index_sequence<sizeof...(Input)>());
+    }
+
+    void backward() override {
+        backward_impl(std::make_index_sequence<sizeof...(Input)>());
+    }
+
+private:
+    template <size_t... Is> void forward_impl(std::index_sequence<Is...>) {
+        accum_grad<false>(m_output, m_op.forward(
+            grad<false>(m_inputs.template get<Is>())...));
+    }
+
+    template <size_t... Is> void backward_impl(std::index_sequence<Is...>) {
+        dr_tuple<Input...> grad_in = m_op.backward(grad<false, false>(m_output));
+        (accum_grad(m_inputs.template get<Is>(), grad_in.template get<Is>()), ...);
+    }
+
+    Op m_op;
+    dr_tuple<Input...> m_inputs;
+    Output m_output;
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Evaluate the \ref StaticCustomOp \c Op and attach its custom
+ * derivatives to the AD graph
+ */
+template <typename Op, typename... Input> auto custom_static(const Input&... input) {
+    using Type   = typename Op::Type;
+    using Output = typename Op::Output;
+    using Edge   = detail::StaticCustomEdge<Op, Input...>;
+
+    static_assert(std::is_same_v<dr_tuple<Input...>, typename Op::Inputs>,
+                  "custom_static(): the argument types don't match the "
+                  "declaration of the StaticCustomOp!");
+
+    Op op;
+    Output output = op.eval(detach<false>(input)...);
+
+    if (grad_enabled(output))
+        drjit_raise("drjit::custom_static(): the return value of the eval() "
+                    "implementation was attached to the AD graph. This is not "
+                    "allowed.");
+
+    uint32_t in_count = 0, in_var = 0;
+    auto count_in = [&](uint32_t index) { in_count++; in_var = index; };
+    (detail::visit_diff_vars(input, count_in), ...);
+
+    uint32_t out_count = 0, out_var = 0;
+    detail::visit_diff_vars<true>(output, [&](uint32_t) { out_count++; });
+
+    if (in_count == 0 || out_count == 0)
+        return output;
+
+    const char *name = op.name();
+    size_t buf_size = strlen(name) + 7;
+    char *buf = (char *) alloca(buf_size);
+
+    /* Interface nodes are only needed when the fan-in/fan-out exceeds 1. They
+       are created before the outputs are attached, since AD edges must point
+       from older to newer variables. */
+    if (in_count > 1) {
+        in_var = detail::ad_new<Type>(nullptr, 0);
+        snprintf(buf, buf_size, "%s [in]", name);
+        detail::ad_set_label<Type>(in_var, buf);
+        auto add_in = [&](uint32_t index) {
+            detail::ad_add_edge<Type>(index, in_var);
+        };
+        (detail::visit_diff_vars(input, add_in), ...);
+    } else {
+        detail::ad_inc_ref<Type>(in_var);
+    }
+
+    if (out_count > 1) {
+        out_var = detail::ad_new<Type>(nullptr, 0);
+        snprintf(buf, buf_size, "%s [out]", name);
+        detail::ad_set_label<Type>(out_var, buf);
+    }
+
+    enable_grad(output);
+
+    if (out_count > 1) {
+        detail::visit_diff_vars(output, [&](uint32_t index) {
+            detail::ad_add_edge<Type>(out_var, index);
+        });
+    } else {
+        detail::visit_diff_vars(output, [&](uint32_t index) { out_var = index; });
+        if (out_var == 0) { // Gradient tracking is disabled in this scope
+            detail::ad_dec_ref<Type>(in_var);
+            return output;
+        }
+        detail::ad_inc_ref<Type>(out_var);
+    }
+
+    Edge *edge = new Edge(std::move(op), input..., output);
+
+    /* Undo the reference count increases that resulted from storage in the
+       edge to avoid a reference cycle (see also ~StaticCustomEdge()) */
+    detail::visit_diff_vars(output, [](uint32_t index) {
+        detail::ad_dec_ref<Type>(index);
+    });
+
+    detail::ad_add_edge<Type>(in_var, out_var, edge);
+    detail::ad_dec_ref<Type>(in_var);
+    detail::ad_dec_ref<Type>(out_var);
+
+    return output;
+}
+
 NAMESPACE_END(drjit)
@@ -0,0 +1,309 @@
+/*
+    drjit/dispatch.h -- Runtime selection between packet kernels that were
+    compiled for different instruction sets
+
+    The packet backend (SSE4.2, AVX, AVX2, AVX512, NEON) is chosen at compile
+    time. To ship a single binary that makes good use of both older and newer
+    processors, compile the source file containing a kernel once per
+    instruction set (the CMake function ``drjit_add_isa_variants()`` does
+    this) and name its entry point via ``DRJIT_ISA_NAME()``:
+
+        // kernel.cpp (compiled once per instruction set)
+        #include <drjit/dispatch.h>
+
+        void DRJIT_ISA_NAME(my_kernel)(float *data, size_t size) {
+            using FloatP = dr::Packet<float>;
+            ...
+        }
+
+    A translation unit compiled for the baseline instruction set then declares
+    all variants and selects between them based on the host processor:
+
+        DRJIT_ISA_DECLARE(void, my_kernel, (float *, size_t))
+
+        dr::ISADispatch<void(float *, size_t)>
+            my_kernel { DRJIT_ISA_VARIANTS(my_kernel) };
+
+        my_kernel(data, size); // calls e.g. my_kernel_avx2()
+
+    Dr.Jit's packet operations are force-inlined, which keeps ISA-specific
+    instructions within the variant that uses them. Variant translation units
+    should therefore only expose their ISA-suffixed entry points.
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/fwd.h>
+#include <atomic>
+#include <initializer_list>
+#include <utility>
+
+#if defined(DRJIT_X86_64) || defined(DRJIT_X86_32)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#endif
+
+NAMESPACE_BEGIN(drjit)
+
+/// Instruction sets targeted by the packet backends
+enum class PacketISA : uint32_t {
+    None = 0, SSE42, AVX, AVX2, AVX512, NEON, Count
+};
+
+/**
+ * \brief Instruction set targeted by the current translation unit
+ *
+ * This value differs between the variants of a kernel. The runtime queries
+ * below (\ref isa_supported(), \ref host_isa()) are therefore independent of
+ * it, since inline functions must be identical in all translation units.
+ */
+#if defined(DRJIT_X86_AVX512)
+    static constexpr PacketISA CompiledISA = PacketISA::AVX512;
+#  define DRJIT_ISA_NAME(name) name##_avx512
+#elif defined(DRJIT_X86_AVX2)
+    static constexpr PacketISA CompiledISA = PacketISA::AVX2;
+#  define DRJIT_ISA_NAME(name) name##_avx2
+#elif defined(DRJIT_X86_AVX)
+    static constexpr PacketISA CompiledISA = PacketISA::AVX;
+#  define DRJIT_ISA_NAME(name) name##_avx
+#elif defined(DRJIT_X86_SSE42)
+    static constexpr PacketISA CompiledISA = PacketISA::SSE42;
+#  define DRJIT_ISA_NAME(name) name##_sse42
+#elif defined(DRJIT_ARM_NEON) && defined(DRJIT_ENABLE_NEON)
+    static constexpr PacketISA CompiledISA = PacketISA::NEON;
+#  define DRJIT_ISA_NAME(name) name##_neon
+#else
+    static constexpr PacketISA CompiledISA = PacketISA::None;
+#  define DRJIT_ISA_NAME(name) name##_none
+#endif
+
+/// Declare the per-ISA variants of a kernel and list them (best one first)
+#if (defined(DRJIT_X86_64) || defined(DRJIT_X86_32)) &&                        \
+    !(defined(_MSC_VER) && defined(DRJIT_X86_32))
+#  define DRJIT_ISA_DECLARE(Ret, name, Args)                                   \
+    Ret name##_avx512 Args;                                                    \
+    Ret name##_avx2 Args;                                                      \
+    Ret name##_avx Args;                                                       \
+    Ret name##_sse42 Args;                                                     \
+    Ret name##_none Args;
+#  define DRJIT_ISA_VARIANTS(name)                                             \
+    { drjit::PacketISA::AVX512, &name##_avx512 },                              \
+    { drjit::PacketISA::AVX2,   &name##_avx2 },                                \
+    { drjit::PacketISA::AVX,    &name##_avx },                                 \
+    { drjit::PacketISA::SSE42,  &name##_sse42 },                               \
+    { drjit::PacketISA::None,   &name##_none }
+#elif defined(DRJIT_ARM_64) && defined(DRJIT_ENABLE_NEON)
+#  define DRJIT_ISA_DECLARE(Ret, name, Args)                                   \
+    Ret name##_neon Args;                                                      \
+    Ret name##_none Args;
+#  define DRJIT_ISA_VARIANTS(name)                                             \
+    { drjit::PacketISA::NEON, &name##_neon },                                  \
+    { drjit::PacketISA::None, &name##_none }
+#else
+#  define DRJIT_ISA_DECLARE(Ret, name, Args)                                   \
+    Ret name##_none Args;
+#  define DRJIT_ISA_VARIANTS(name)                                             \
+    { drjit::PacketISA::None, &name##_none }
+#endif
+
+/// Return a human-readable name of the given instruction set
+inline const char *isa_name(PacketISA isa) {
+    switch (isa) {
+        case PacketISA::None:   return "none";
+        case PacketISA::SSE42:  return "sse42";
+        case PacketISA::AVX:    return "avx";
+        case PacketISA::AVX2:   return "avx2";
+        case PacketISA::AVX512: return "avx512";
+        case PacketISA::NEON:   return "neon";
+        default:                return "unknown";
+    }
+}
+
+/**
+ * \brief Number of single precision lanes in a packet of the given
+ * instruction set (i.e., the value of \ref DefaultSize in a translation unit
+ * compiled for it)
+ */
+constexpr size_t packet_size(PacketISA isa) {
+    switch (isa) {
+        case PacketISA::AVX512:
+            return 16;
+        case PacketISA::AVX2:
+        case PacketISA::AVX:
+            return 8;
+        case PacketISA::SSE42:
+        case PacketISA::NEON:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+NAMESPACE_BEGIN(detail)
+
+#if defined(DRJIT_X86_64) || defined(DRJIT_X86_32)
+inline void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#  if defined(_MSC_VER)
+    int tmp[4];
+    __cpuidex(tmp, (int) leaf, (int) subleaf);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = (uint32_t) tmp[i];
+#  else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+}
+
+inline uint64_t xgetbv() {
+#  if defined(_MSC_VER)
+    return (uint64_t) _xgetbv(0);
+#  else
+    uint32_t eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((uint64_t) edx << 32) | eax;
+#  endif
+}
+#endif
+
+/// Query the processor and operating system, returns a bit mask of PacketISA values
+inline uint32_t detect_isa() {
+    uint32_t result = 1u << (uint32_t) PacketISA::None;
+
+#if defined(DRJIT_X86_64) || defined(DRJIT_X86_32)
+    uint32_t regs[4], max_leaf, leaf1_ecx, leaf7_ebx = 0, ext_ecx = 0;
+    cpuid(0, 0, regs);
+    max_leaf = regs[0];
+    cpuid(1, 0, regs);
+    leaf1_ecx = regs[2];
+    if (max_leaf >= 7) {
+        cpuid(7, 0, regs);
+        leaf7_ebx = regs[1];
+    }
+    cpuid(0x80000000u, 0, regs);
+    if (regs[0] >= 0x80000001u) {
+        cpuid(0x80000001u, 0, regs);
+        ext_ecx = regs[2];
+    }
+
+    auto has = [](uint32_t reg, int bit) { return (reg & (1u << bit)) != 0; };
+
+    // The OS must save the AVX (YMM) and AVX512 (opmask, ZMM) register state
+    uint64_t xcr0 = has(leaf1_ecx, 27) ? xgetbv() : 0;
+    bool os_avx    = (xcr0 & 0x6) == 0x6,
+         os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+    bool sse42 = has(leaf1_ecx, 20),
+         avx   = sse42 && os_avx && has(leaf1_ecx, 28),
+         avx2  = avx && has(leaf7_ebx, 5) && has(leaf1_ecx, 12) /* FMA */ &&
+                 has(leaf1_ecx, 29) /* F16C */ && has(leaf7_ebx, 3) /* BMI */ &&
+                 has(leaf7_ebx, 8) /* BMI2 */ && has(ext_ecx, 5) /* LZCNT */,
+         avx512 = avx2 && os_avx512 && has(leaf7_ebx, 16) /* F */ &&
+                  has(leaf7_ebx, 17) /* DQ */ && has(leaf7_ebx, 28) /* CD */ &&
+                  has(leaf7_ebx, 30) /* BW */ && has(leaf7_ebx, 31) /* VL */;
+
+    if (sse42)
+        result |= 1u << (uint32_t) PacketISA::SSE42;
+    if (avx)
+        result |= 1u << (uint32_t) PacketISA::AVX;
+    if (avx2)
+        result |= 1u << (uint32_t) PacketISA::AVX2;
+    if (avx512)
+        result |= 1u << (uint32_t) PacketISA::AVX512;
+#elif defined(DRJIT_ARM_64) && defined(DRJIT_ENABLE_NEON)
+    // Advanced SIMD is a mandatory part of ARMv8-A
+    result |= 1u << (uint32_t) PacketISA::NEON;
+#endif
+
+    return result;
+}
+
+inline uint32_t host_isa_mask() {
+    static const uint32_t mask = detect_isa();
+    return mask;
+}
+
+NAMESPACE_END(detail)
+
+/// Can the host processor execute code compiled for the given instruction set?
+inline bool isa_supported(PacketISA isa) {
+    return (detail::host_isa_mask() & (1u << (uint32_t) isa)) != 0;
+}
+
+/// Return the most capable instruction set supported by the host processor
+inline PacketISA host_isa() {
+    for (PacketISA isa : { PacketISA::AVX512, PacketISA::AVX2, PacketISA::AVX,
+                           PacketISA::SSE42, PacketISA::NEON }) {
+        if (isa_supported(isa))
+            return isa;
+    }
+    return PacketISA::None;
+}
+
+/// Packet size (single precision lanes) of the best instruction set of the host
+inline size_t host_packet_size() { return packet_size(host_isa()); }
+
+/**
+ * \brief Table of kernel variants compiled for different instruction sets
+ *
+ * The function call operator forwards to the first variant (in the order
+ * given to the constructor) that the host processor supports. The choice is
+ * made on the first call and cached afterwards.
+ */
+template <typename Func> struct ISADispatch;
+
+template <typename Ret, typename... Args> struct ISADispatch<Ret(Args...)> {
+    using Func = Ret(Args...);
+
+    struct Variant {
+        PacketISA isa;
+        Func *func;
+    };
+
+    ISADispatch(std::initializer_list<Variant> variants) {
+        if (variants.size() > (size_t) PacketISA::Count)
+            drjit_raise("ISADispatch(): too many variants!");
+        for (const Variant &v : variants)
+            m_variants[m_count++] = v;
+    }
+
+    /// Return the variant that will be used on the host processor
+    const Variant &select() const {
+        uint32_t index = m_selected.load(std::memory_order_relaxed);
+        if (DRJIT_UNLIKELY(index == (uint32_t) -1)) {
+            for (index = 0; index < m_count; ++index) {
+                if (m_variants[index].func && isa_supported(m_variants[index].isa))
+                    break;
+            }
+            if (index == m_count)
+                drjit_raise("ISADispatch(): no variant is supported by the "
+                            "host processor!");
+            m_selected.store(index, std::memory_order_relaxed);
+        }
+        return m_variants[index];
+    }
+
+    /// Instruction set of the selected variant
+    PacketISA isa() const { return select().isa; }
+
+    Ret operator()(Args... args) const {
+        return select().func(std::forward<Args>(args)...);
+    }
+
+private:
+    Variant m_variants[(size_t) PacketISA::Count] { };
+    uint32_t m_count = 0;
+    mutable std::atomic<uint32_t> m_selected { (uint32_t) -1 };
+};
+
+NAMESPACE_END(drjit)
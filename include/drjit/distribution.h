@@ -0,0 +1,375 @@
+/*
+    drjit/distribution.h -- Discrete probability distributions with O(1)
+    sampling based on alias tables
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/util.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Build alias tables over consecutive segments of \c segment_size
+ * weights, where each segment forms an independent distribution
+ *
+ * This is a parallel formulation of the sweeping construction by Hübschle-
+ * Schneider and Sanders ("Parallel Weighted Random Sampling", ESA 2019). The
+ * weights of a segment are rescaled to a mean of 1 and split into light (< 1)
+ * and heavy (>= 1) entries. Sequentially, every light entry would fill its
+ * bucket with a share of the current heavy entry. A heavy entry whose
+ * residual drops below 1 becomes light itself and receives a share of the
+ * next heavy entry. Both events can be located using prefix sums: with
+ * inclusive prefix sums \c D over the deficits <tt>1 - p</tt> of the light
+ * entries and \c S over the excesses <tt>p - 1</tt> of the heavy entries,
+ *
+ * - light entry \c i is aliased to the first heavy entry \c j with
+ *   <tt>S[j] >= D[i - 1]</tt>, and
+ *
+ * - heavy entry \c j keeps <tt>1 - (D[i] - S[j])</tt> of its bucket, where
+ *   \c i is the first light entry with <tt>D[i] > S[j]</tt>, and is aliased
+ *   to heavy entry <tt>j + 1</tt>. It keeps its whole bucket if there is no
+ *   such light entry.
+ *
+ * Every entry therefore requires a single binary search. The prefix sums
+ * use double precision to avoid an accumulation of rounding errors in large
+ * tables. Segments with a zero total weight become uniform.
+ *
+ * Returns the probability of keeping each bucket along with the global index
+ * of its alias.
+ */
+template <typename Float>
+std::pair<Float, uint32_array_t<Float>> alias_build(const Float &weights,
+                                                    uint32_t segment_size) {
+    using Float64 = float64_array_t<Float>;
+    using UInt32  = uint32_array_t<Float>;
+    using Mask    = mask_t<UInt32>;
+
+    uint32_t n = (uint32_t) width(weights);
+
+    Float64 w = Float64(weights);
+    UInt32 item  = arange<UInt32>(n),
+           first = idiv(item, divisor<uint32_t>(segment_size)) * segment_size,
+           last  = first + (segment_size - 1);
+
+    Float64 total = repeat(block_sum(w, segment_size), segment_size),
+            p = select(total > 0.0, w * ((double) segment_size / total), 1.0);
+
+    Mask light = p < 1.0;
+    UInt32 flag = select(light, UInt32(1), UInt32(0)),
+           light_end  = prefix_sum(flag, false),
+           light_rank = light_end - flag,
+           light_item = UInt32(compress(light)),
+           heavy_item = UInt32(compress(!light));
+    eval(p, light_rank, light_end);
+
+    uint32_t n_light = (uint32_t) light_item.size(),
+             n_heavy = (uint32_t) heavy_item.size();
+
+    // Ranges of light/heavy entries within the segment [f, l]
+    auto light_range = [&](const UInt32 &f, const UInt32 &l) {
+        return std::make_pair(gather<UInt32>(light_rank, f),
+                              gather<UInt32>(light_end, l));
+    };
+
+    auto heavy_range = [&](const UInt32 &f, const UInt32 &l) {
+        return std::make_pair(f - gather<UInt32>(light_rank, f),
+                              l + 1u - gather<UInt32>(light_end, l));
+    };
+
+    Float64 deficit, excess, d_incl, s_incl;
+    if (n_light > 0) {
+        deficit = 1.0 - gather<Float64>(p, light_item);
+        d_incl = prefix_sum(deficit, false);
+    }
+    if (n_heavy > 0) {
+        excess = gather<Float64>(p, heavy_item) - 1.0;
+        s_incl = prefix_sum(excess, false);
+    }
+    eval(d_incl, s_incl);
+
+    Float prob = empty<Float>(n);
+    UInt32 alias = empty<UInt32>(n);
+
+    if (n_light > 0 && n_heavy == 0) {
+        scatter(prob, Float(1.f), light_item);
+        scatter(alias, light_item, light_item);
+    } else if (n_light > 0) {
+        UInt32 f = gather<UInt32>(first, light_item),
+               l = gather<UInt32>(last, light_item);
+        UInt32 lb = light_range(f, l).first;
+        auto [hb, he] = heavy_range(f, l);
+        Mask has_heavy = hb < he;
+
+        Float64 d_base = gather<Float64>(d_incl - deficit, lb),
+                s_base = gather<Float64>(s_incl - excess, hb, has_heavy),
+                d_prev = d_incl - deficit - d_base;
+
+        UInt32 j = binary_search<UInt32>(hb, he, [&](const UInt32 &k) {
+            return gather<Float64>(s_incl, k, k < n_heavy) - s_base < d_prev;
+        });
+        j = minimum(j, he - 1u);
+
+        scatter(prob, Float(gather<Float64>(p, light_item)), light_item);
+        scatter(alias,
+                select(has_heavy, gather<UInt32>(heavy_item, j, has_heavy),
+                       light_item),
+                light_item);
+    }
+
+    if (n_heavy > 0 && n_light == 0) {
+        scatter(prob, Float(1.f), heavy_item);
+        scatter(alias, heavy_item, heavy_item);
+    } else if (n_heavy > 0) {
+        UInt32 f = gather<UInt32>(first, heavy_item),
+               l = gather<UInt32>(last, heavy_item);
+        auto [lb, le] = light_range(f, l);
+        auto [hb, he] = heavy_range(f, l);
+
+        Float64 d_base = gather<Float64>(d_incl - deficit, lb, lb < le),
+                s_base = gather<Float64>(s_incl - excess, hb),
+                s = s_incl - s_base;
+
+        UInt32 i = binary_search<UInt32>(lb, le, [&](const UInt32 &k) {
+            return gather<Float64>(d_incl, k, k < n_light) - d_base <= s;
+        });
+
+        Mask exhausted = i < le;
+        Float64 keep = clamp(
+            1.0 - (gather<Float64>(d_incl, i, exhausted) - d_base - s), 0.0, 1.0);
+        UInt32 next = minimum(arange<UInt32>(n_heavy) + 1u, he - 1u);
+
+        scatter(prob, Float(select(exhausted, keep, 1.0)), heavy_item);
+        scatter(alias,
+                select(exhausted, gather<UInt32>(heavy_item, next), heavy_item),
+                heavy_item);
+    }
+
+    eval(prob, alias);
+    return { prob, alias };
+}
+
+/**
+ * \brief Sample a bucket of the alias table <tt>(prob, alias)</tt> that
+ * starts at index \c offset and holds \c size entries
+ *
+ * Returns the sampled entry along with the sample \c u rescaled to [0, 1).
+ */
+template <typename Float, typename UInt32>
+std::pair<UInt32, Float> alias_sample(const Float &prob, const UInt32 &alias,
+                                      const UInt32 &offset, uint32_t size,
+                                      const Float &u, const mask_t<UInt32> &active) {
+    using Mask = mask_t<Float>;
+
+    Float x = u * (float) size;
+    UInt32 bucket = minimum(UInt32(x), size - 1u);
+    Float frac = x - Float(bucket), keep;
+    bucket += offset;
+    keep = gather<Float>(prob, bucket, active);
+
+    Mask own = frac < keep;
+    UInt32 index = select(own, bucket, gather<UInt32>(alias, bucket, active && !own));
+    Float u_reuse = select(own, frac / keep, (frac - keep) / (1.f - keep));
+
+    return { index, clamp(u_reuse, 0.f, OneMinusEpsilon<Float>) };
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Discrete distribution over the entries of an array of non-negative
+ * weights
+ *
+ * Sampling draws from an alias table (Walker 1977, Vose 1991) at the cost of
+ * two gathers per sample, independently of the number of entries. The table is
+ * built in parallel on the device (see \ref detail::alias_build()).
+ *
+ * \ref eval() and \ref pdf() look up the weights, which may be attached to
+ * the AD graph. After modifying \ref weights, call \ref update() to rebuild
+ * the table.
+ *
+ * Construction evaluates the weights and launches several kernels, hence it
+ * cannot be used within recorded loops or virtual function calls.
+ */
+template <typename Float_> struct DiscreteDistribution {
+    using Float   = Float_;
+    using FloatD  = detached_t<Float>;
+    using UInt32  = uint32_array_t<FloatD>;
+    using Mask    = mask_t<FloatD>;
+
+    static_assert(is_jit_v<Float> && std::is_same_v<scalar_t<Float>, float>,
+                  "DiscreteDistribution: requires a single precision JIT array type!");
+
+    /// Unnormalized weights
+    Float weights;
+
+    /// Reciprocal of the sum of all weights
+    Float normalization;
+
+    /// Probability of keeping each bucket of the alias table
+    FloatD prob;
+
+    /// Entry that a bucket refers to when it is not kept
+    UInt32 alias;
+
+    DiscreteDistribution() = default;
+
+    DiscreteDistribution(const Float &weights) : weights(weights) { update(); }
+
+    /// Rebuild the alias table after modifying \ref weights
+    void update() {
+        size_t n = width(weights);
+        if (n == 0)
+            drjit_raise("drjit::DiscreteDistribution::update(): at least one "
+                        "weight is required!");
+        if (n >= (1ull << 31))
+            drjit_raise("drjit::DiscreteDistribution::update(): too many "
+                        "weights (%zu)!", n);
+
+        normalization = rcp(sum(weights));
+        std::tie(prob, alias) = detail::alias_build(detach(weights), (uint32_t) n);
+    }
+
+    /// Number of entries
+    uint32_t size() const { return (uint32_t) width(prob); }
+
+    /// Return the unnormalized weight of an entry
+    Float eval(const UInt32 &index, const Mask &active = true) const {
+        return gather<Float>(weights, index, active);
+    }
+
+    /// Return the probability of sampling an entry
+    Float pdf(const UInt32 &index, const Mask &active = true) const {
+        return eval(index, active) * normalization;
+    }
+
+    /// Map a uniform sample on [0, 1) to an entry
+    UInt32 sample(const FloatD &u, const Mask &active = true) const {
+        return sample_reuse(u, active).first;
+    }
+
+    /// Map a uniform sample to an entry and return the sample rescaled to [0, 1)
+    std::pair<UInt32, FloatD> sample_reuse(const FloatD &u,
+                                           const Mask &active = true) const {
+        return detail::alias_sample(prob, alias, UInt32(0), size(), u, active);
+    }
+
+    /// Map a uniform sample to an entry and also return its probability
+    std::pair<UInt32, Float> sample_pdf(const FloatD &u,
+                                        const Mask &active = true) const {
+        UInt32 index = sample(u, active);
+        return { index, pdf(index, active) };
+    }
+};
+
+/**
+ * \brief Discrete distribution over the pixels of a 2D image with row-major
+ * weights, e.g. for importance sampling a texture
+ *
+ * This distribution is hierarchical with two levels. An alias table over the
+ * row sums selects a row, and a second alias table restricted to that row
+ * selects the column. Both tables are built by a single parallel
+ * construction (one segment per row), and sampling costs four gathers.
+ */
+template <typename Float_> struct DiscreteDistribution2D {
+    using Float   = Float_;
+    using FloatD  = detached_t<Float>;
+    using UInt32  = uint32_array_t<FloatD>;
+    using Mask    = mask_t<FloatD>;
+    using Array2f = Array<FloatD, 2>;
+    using Array2u = Array<UInt32, 2>;
+
+    static_assert(is_jit_v<Float> && std::is_same_v<scalar_t<Float>, float>,
+                  "DiscreteDistribution2D: requires a single precision JIT array type!");
+
+    /// Resolution of the image
+    uint32_t width = 0, height = 0;
+
+    /// Unnormalized row-major weights
+    Float weights;
+
+    /// Reciprocal of the sum of all weights
+    Float normalization;
+
+    /// Alias table over the rows
+    FloatD row_prob;
+    UInt32 row_alias;
+
+    /// Alias tables over the columns of every row
+    FloatD col_prob;
+    UInt32 col_alias;
+
+    DiscreteDistribution2D() = default;
+
+    DiscreteDistribution2D(const Float &weights, uint32_t width, uint32_t height)
+        : width(width), height(height), weights(weights) {
+        update();
+    }
+
+    /// Rebuild the alias tables after modifying \ref weights
+    void update() {
+        size_t n = drjit::width(weights);
+        if (width == 0 || height == 0 || n != (size_t) width * height)
+            drjit_raise("drjit::DiscreteDistribution2D::update(): expected "
+                        "%u x %u weights, got %zu!", width, height, n);
+        if (n >= (1ull << 31))
+            drjit_raise("drjit::DiscreteDistribution2D::update(): too many "
+                        "weights (%zu)!", n);
+
+        FloatD w = detach(weights);
+        normalization = rcp(sum(weights));
+        std::tie(row_prob, row_alias) = detail::alias_build(block_sum(w, width), height);
+        std::tie(col_prob, col_alias) = detail::alias_build(w, width);
+    }
+
+    /// Return the unnormalized weight of a pixel
+    Float eval(const Array2u &pos, const Mask &active = true) const {
+        return gather<Float>(weights, pos.y() * width + pos.x(), active);
+    }
+
+    /// Return the probability of sampling a pixel
+    Float pdf(const Array2u &pos, const Mask &active = true) const {
+        return eval(pos, active) * normalization;
+    }
+
+    /// Map a uniform 2D sample to a pixel, with \c u.y() selecting the row
+    Array2u sample(const Array2f &u, const Mask &active = true) const {
+        return sample_reuse(u, active).first;
+    }
+
+    /// Map a uniform 2D sample to a pixel and return the sample rescaled to [0, 1)^2
+    std::pair<Array2u, Array2f> sample_reuse(const Array2f &u,
+                                             const Mask &active = true) const {
+        auto [row, uy] = detail::alias_sample(row_prob, row_alias, UInt32(0),
+                                              height, u.y(), active);
+        UInt32 offset = row * width;
+        auto [index, ux] = detail::alias_sample(col_prob, col_alias, offset,
+                                                width, u.x(), active);
+        return { Array2u(index - offset, row), Array2f(ux, uy) };
+    }
+
+    /**
+     * \brief Map a uniform 2D sample to a continuous position on [0, 1]^2
+     * and return the associated density with respect to area
+     *
+     * The result is distributed uniformly within the sampled pixel.
+     */
+    std::pair<Array2f, Float> sample_continuous(const Array2f &u,
+                                                const Mask &active = true) const {
+        auto [pos, u_reuse] = sample_reuse(u, active);
+        Array2f p = (Array2f(pos) + u_reuse) *
+                    Array2f(1.f / (float) width, 1.f / (float) height);
+        return { p, pdf(pos, active) * ((float) width * (float) height) };
+    }
+};
+
+NAMESPACE_END(drjit)
@@ -0,0 +1,267 @@
+/*
+    drjit/dual.h -- Dual numbers for eager forward-mode differentiation
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/array.h>
+
+NAMESPACE_BEGIN(drjit)
+
+namespace detail {
+    template <typename T> using is_dual_det = std::enable_if_t<T::Derived::IsDual>;
+}
+
+template <typename T>
+constexpr bool is_dual_v = is_detected_v<detail::is_dual_det, std::decay_t<T>>;
+template <typename T> using enable_if_dual_t = enable_if_t<is_dual_v<T>>;
+
+/**
+ * \brief Dual number consisting of a primal value and a tangent
+ *
+ * Arithmetic operations and transcendental functions involving dual numbers
+ * propagate the tangent along with the primal value, which implements
+ * forward-mode differentiation (i.e., Jacobian-vector products) without
+ * recording an AD graph. In contrast to \ref DiffArray, there is no
+ * per-operation graph bookkeeping or locking, and the tangent computation
+ * becomes part of the same kernel when \c Value is a JIT array.
+ *
+ * Comparisons and other mask-producing operations act on both components;
+ * apply them to \ref primal() instead.
+ */
+template <typename Value_>
+struct Dual : StaticArrayImpl<Value_, 2, false, Dual<Value_>> {
+    using Base = StaticArrayImpl<Value_, 2, false, Dual<Value_>>;
+    DRJIT_ARRAY_DEFAULTS(Dual)
+
+    static constexpr bool IsDual = true;
+    static constexpr bool IsSpecial = true;
+    static constexpr bool IsVector = false;
+
+    using ArrayType = Dual;
+    using PlainArrayType = Array<Value_, 2>;
+    using MaskType = Mask<Value_, 2>;
+    using typename Base::Scalar;
+
+    template <typename T> using ReplaceValue = Dual<T>;
+
+    Dual() = default;
+
+    template <typename T, enable_if_t<is_dual_v<T> || array_depth_v<T> == Base::Depth> = 0>
+    DRJIT_INLINE Dual(T&& d) : Base(std::forward<T>(d)) { }
+
+    template <typename T, enable_if_t<!is_dual_v<T> && array_depth_v<T> != Base::Depth &&
+                                       (is_array_v<T> || std::is_scalar_v<std::decay_t<T>>)> = 0>
+    DRJIT_INLINE Dual(T&& v) : Base(std::forward<T>(v), zeros<Value_>()) { }
+
+    template <typename T, enable_if_t<!is_array_v<T> && !std::is_scalar_v<std::decay_t<T>>> = 0> // __m128d
+    DRJIT_INLINE Dual(T&& d) : Base(d) { }
+
+    DRJIT_INLINE Dual(const Value_ &v1, const Value_ &v2) : Base(v1, v2) { }
+    DRJIT_INLINE Dual(Value_ &&v1, Value_ &&v2)
+        : Base(std::move(v1), std::move(v2)) { }
+};
+
+template <typename T> DRJIT_INLINE T primal(const Dual<T> &d) { return d.x(); }
+template <typename T> DRJIT_INLINE T tangent(const Dual<T> &d) { return d.y(); }
+
+/// Apply the chain rule to a function with value 'f' and derivative 'df'
+template <typename T>
+DRJIT_INLINE Dual<T> chain(const Dual<T> &d, const T &f, const T &df) {
+    return { f, df * tangent(d) };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> operator*(const Dual<T0> &d0, const Dual<T1> &d1) {
+    return {
+        primal(d0) * primal(d1),
+        fmadd(primal(d0), tangent(d1), tangent(d0) * primal(d1))
+    };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> operator*(const Dual<T0> &d0, const T1 &v1) {
+    return Array<T0, 2>(d0) * v1;
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> operator*(const T0 &v0, const Dual<T1> &d1) {
+    return v0 * Array<T1, 2>(d1);
+}
+
+template <typename T> Dual<T> rcp(const Dual<T> &d) {
+    T r = rcp(primal(d));
+    return { r, -sqr(r) * tangent(d) };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> operator/(const Dual<T0> &d0, const Dual<T1> &d1) {
+    using T = expr_t<T0, T1>;
+    T r = rcp(primal(d1)),
+      q = primal(d0) * r;
+    return { q, fnmadd(q, tangent(d1), tangent(d0)) * r };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> operator/(const Dual<T0> &d0, const T1 &v1) {
+    return Array<T0, 2>(d0) / v1;
+}
+
+template <typename T0, typename T1, typename T2>
+Dual<expr_t<T0, T1, T2>> fmadd(const Dual<T0> &d0, const Dual<T1> &d1,
+                               const Dual<T2> &d2) {
+    return d0 * d1 + d2;
+}
+
+template <typename T0, typename T1, typename T2>
+Dual<expr_t<T0, T1, T2>> fmsub(const Dual<T0> &d0, const Dual<T1> &d1,
+                               const Dual<T2> &d2) {
+    return d0 * d1 - d2;
+}
+
+template <typename T0, typename T1, typename T2>
+Dual<expr_t<T0, T1, T2>> fnmadd(const Dual<T0> &d0, const Dual<T1> &d1,
+                                const Dual<T2> &d2) {
+    return d2 - d0 * d1;
+}
+
+template <typename T0, typename T1, typename T2>
+Dual<expr_t<T0, T1, T2>> fnmsub(const Dual<T0> &d0, const Dual<T1> &d1,
+                                const Dual<T2> &d2) {
+    return -(d0 * d1) - d2;
+}
+
+template <typename T> Dual<T> abs(const Dual<T> &d) {
+    return { abs(primal(d)), mulsign(tangent(d), primal(d)) };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> minimum(const Dual<T0> &d0, const Dual<T1> &d1) {
+    return select(primal(d0) <= primal(d1), Dual<expr_t<T0, T1>>(d0),
+                  Dual<expr_t<T0, T1>>(d1));
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> maximum(const Dual<T0> &d0, const Dual<T1> &d1) {
+    return select(primal(d0) >= primal(d1), Dual<expr_t<T0, T1>>(d0),
+                  Dual<expr_t<T0, T1>>(d1));
+}
+
+template <typename T> Dual<T> sqrt(const Dual<T> &d) {
+    T s = sqrt(primal(d));
+    return chain(d, s, .5f * rcp(s));
+}
+
+template <typename T> Dual<T> rsqrt(const Dual<T> &d) {
+    T r = rsqrt(primal(d));
+    return chain(d, r, -.5f * r * sqr(r));
+}
+
+template <typename T> Dual<T> cbrt(const Dual<T> &d) {
+    T c = cbrt(primal(d));
+    return chain(d, c, (1.f / 3.f) * rcp(sqr(c)));
+}
+
+template <typename T> Dual<T> exp(const Dual<T> &d) {
+    T e = exp(primal(d));
+    return chain(d, e, e);
+}
+
+template <typename T> Dual<T> exp2(const Dual<T> &d) {
+    T e = exp2(primal(d));
+    return chain(d, e, e * LogTwo<T>);
+}
+
+template <typename T> Dual<T> log(const Dual<T> &d) {
+    return chain(d, log(primal(d)), rcp(primal(d)));
+}
+
+template <typename T> Dual<T> log2(const Dual<T> &d) {
+    return chain(d, log2(primal(d)), rcp(primal(d)) * InvLogTwo<T>);
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> pow(const Dual<T0> &d0, const T1 &v1) {
+    using T = expr_t<T0, T1>;
+    T p = pow(primal(d0), v1);
+    return { p, v1 * pow(primal(d0), v1 - 1.f) * tangent(d0) };
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> pow(const Dual<T0> &d0, const Dual<T1> &d1) {
+    return exp(log(d0) * d1);
+}
+
+template <typename T> Dual<T> sin(const Dual<T> &d) {
+    auto [s, c] = sincos(primal(d));
+    return chain(d, s, c);
+}
+
+template <typename T> Dual<T> cos(const Dual<T> &d) {
+    auto [s, c] = sincos(primal(d));
+    return chain(d, c, -s);
+}
+
+template <typename T>
+std::pair<Dual<T>, Dual<T>> sincos(const Dual<T> &d) {
+    auto [s, c] = sincos(primal(d));
+    return { chain(d, s, c), chain(d, c, -s) };
+}
+
+template <typename T> Dual<T> tan(const Dual<T> &d) {
+    T t = tan(primal(d));
+    return chain(d, t, fmadd(t, t, 1.f));
+}
+
+template <typename T> Dual<T> asin(const Dual<T> &d) {
+    return chain(d, asin(primal(d)), rsqrt(fnmadd(primal(d), primal(d), 1.f)));
+}
+
+template <typename T> Dual<T> acos(const Dual<T> &d) {
+    return chain(d, acos(primal(d)), -rsqrt(fnmadd(primal(d), primal(d), 1.f)));
+}
+
+template <typename T> Dual<T> atan(const Dual<T> &d) {
+    return chain(d, atan(primal(d)), rcp(fmadd(primal(d), primal(d), 1.f)));
+}
+
+template <typename T0, typename T1>
+Dual<expr_t<T0, T1>> atan2(const Dual<T0> &y, const Dual<T1> &x) {
+    using T = expr_t<T0, T1>;
+    T r = rcp(fmadd(primal(x), primal(x), sqr(primal(y))));
+    return {
+        atan2(primal(y), primal(x)),
+        fmsub(primal(x), tangent(y), primal(y) * tangent(x)) * r
+    };
+}
+
+template <typename T> Dual<T> sinh(const Dual<T> &d) {
+    auto [sh, ch] = sincosh(primal(d));
+    return chain(d, sh, ch);
+}
+
+template <typename T> Dual<T> cosh(const Dual<T> &d) {
+    auto [sh, ch] = sincosh(primal(d));
+    return chain(d, ch, sh);
+}
+
+template <typename T>
+std::pair<Dual<T>, Dual<T>> sincosh(const Dual<T> &d) {
+    auto [sh, ch] = sincosh(primal(d));
+    return { chain(d, sh, ch), chain(d, ch, sh) };
+}
+
+template <typename T> Dual<T> tanh(const Dual<T> &d) {
+    T t = tanh(primal(d));
+    return chain(d, t, fnmadd(t, t, 1.f));
+}
+
+NAMESPACE_END(drjit)
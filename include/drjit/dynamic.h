@@ -14,8 +14,208 @@
 #pragma once
 
 #include <drjit/array.h>
+#include <drjit/half.h>
+#include <drjit/packet.h>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
 
 NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/// Inline storage of a \ref DynamicArray, which holds up to 'Size' entries
+template <typename Value, size_t Size> struct dynamic_inline_storage {
+    alignas(alignof(Value) > 16 ? alignof(Value) : 16)
+        unsigned char data[Size * sizeof(Value)];
+    Value *ptr() { return (Value *) data; }
+    const Value *ptr() const { return (const Value *) data; }
+};
+
+template <typename Value> struct dynamic_inline_storage<Value, 0> {
+    Value *ptr() { return nullptr; }
+    const Value *ptr() const { return nullptr; }
+};
+
+/**
+ * \brief Thread pool that parallelizes vertical operations on large
+ * \ref DynamicArray instances
+ *
+ * A loop is split into chunks that the calling thread and the workers claim
+ * one at a time from a shared atomic counter, which balances the load when
+ * chunks take different amounts of time. Workers are launched on first use.
+ * Loops issued from within a worker (e.g. by nested dynamic arrays) or while
+ * another thread is using the pool run serially on the calling thread.
+ *
+ * The pool is disabled (i.e., uses a single thread) until the application
+ * opts in via \ref set_dynamic_thread_count().
+ */
+class DynamicThreadPool {
+public:
+    using Task = void (*)(void *payload, size_t start, size_t end);
+
+    static DynamicThreadPool &get() {
+        static DynamicThreadPool pool;
+        return pool;
+    }
+
+    ~DynamicThreadPool() { stop_workers(); }
+
+    uint32_t thread_count() const { return m_thread_count; }
+
+    void set_thread_count(uint32_t count) {
+        if (count == 0)
+            count = default_thread_count();
+        std::lock_guard<std::mutex> guard(m_run_mutex);
+        stop_workers();
+        m_thread_count = count;
+    }
+
+    /// Run 'task' over the range [0, size) in chunks of 'chunk' entries
+    void run(size_t size, size_t chunk, Task task, void *payload) {
+        std::unique_lock<std::mutex> run_guard(m_run_mutex, std::try_to_lock);
+        if (!run_guard.owns_lock() || in_worker() || m_thread_count < 2 ||
+            size <= chunk) {
+            task(payload, 0, size);
+            return;
+        }
+
+        if (m_workers.empty()) {
+            // Workers wait for jobs issued after this point
+            uint64_t generation = m_generation;
+            for (uint32_t i = 1; i < m_thread_count; ++i)
+                m_workers.emplace_back([this, generation] { worker(generation); });
+        }
+
+        /* Acquire job */ {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_task = task;
+            m_payload = payload;
+            m_size = size;
+            m_chunk = chunk;
+            m_next.store(0, std::memory_order_relaxed);
+            m_busy = (uint32_t) m_workers.size();
+            m_generation++;
+        }
+        m_work_cv.notify_all();
+
+        work();
+
+        std::unique_lock<std::mutex> guard(m_mutex);
+        m_done_cv.wait(guard, [&] { return m_busy == 0; });
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+    }
+
+private:
+    DynamicThreadPool() : m_thread_count(1) { }
+
+    static uint32_t default_thread_count() {
+        uint32_t count = std::thread::hardware_concurrency();
+        return count > 0 ? count : 1;
+    }
+
+    static bool &in_worker() {
+        static thread_local bool value = false;
+        return value;
+    }
+
+    /// Claim and process chunks until the job is finished
+    void work() {
+        while (true) {
+            size_t start = m_next.fetch_add(m_chunk);
+            if (start >= m_size)
+                break;
+            size_t end = start + m_chunk < m_size ? start + m_chunk : m_size;
+            try {
+                m_task(m_payload, start, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(m_mutex);
+                if (!m_error)
+                    m_error = std::current_exception();
+                m_next.store(m_size);
+            }
+        }
+    }
+
+    void worker(uint64_t generation) {
+        in_worker() = true;
+        std::unique_lock<std::mutex> guard(m_mutex);
+
+        while (true) {
+            m_work_cv.wait(guard, [&] {
+                return m_stop || m_generation != generation;
+            });
+            if (m_stop)
+                break;
+            generation = m_generation;
+
+            guard.unlock();
+            work();
+            guard.lock();
+
+            if (--m_busy == 0)
+                m_done_cv.notify_one();
+        }
+    }
+
+    void stop_workers() {
+        /* Signal */ {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_stop = true;
+        }
+        m_work_cv.notify_all();
+        for (std::thread &t : m_workers)
+            t.join();
+        m_workers.clear();
+        m_stop = false;
+    }
+
+    std::vector<std::thread> m_workers;
+    uint32_t m_thread_count;
+
+    /// Serializes jobs and changes to the number of threads
+    std::mutex m_run_mutex;
+
+    /// Protects the job description and worker synchronization
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv, m_done_cv;
+    uint64_t m_generation = 0;
+    uint32_t m_busy = 0;
+    bool m_stop = false;
+    std::exception_ptr m_error;
+
+    Task m_task = nullptr;
+    void *m_payload = nullptr;
+    size_t m_size = 0, m_chunk = 0;
+    std::atomic<size_t> m_next { 0 };
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Set the number of threads that evaluate vertical operations on
+ * large \ref DynamicArray instances (0: one per hardware thread, 1:
+ * disable parallelization, which is the default)
+ *
+ * Only arrays of arithmetic types and of packets thereof are processed in
+ * parallel. Other entry types (e.g. nested dynamic or JIT arrays) always use
+ * the calling thread.
+ */
+inline void set_dynamic_thread_count(uint32_t count) {
+    detail::DynamicThreadPool::get().set_thread_count(count);
+}
+
+/// Return the number of threads used by large \ref DynamicArray operations
+inline uint32_t dynamic_thread_count() {
+    return detail::DynamicThreadPool::get().thread_count();
+}
 
 template <typename Value_>
 struct DynamicArray
@@ -32,6 +232,28 @@ struct DynamicArray
     static constexpr size_t Size = Dynamic;
     static constexpr bool IsDynamic = true;
 
+    /// Trivial types are copied using memcpy() and can be stored inline
+    static constexpr bool IsTrivial = std::is_trivially_copyable_v<Value> &&
+                                      std::is_trivially_destructible_v<Value>;
+
+    /// Arrays with up to this many entries of a trivial type avoid the heap
+    static constexpr size_t InlineSize = IsTrivial ? 64 / sizeof(Value) : 0;
+
+    /// Alignment of heap allocations (suitable for aligned packet loads)
+    static constexpr size_t Alignment = alignof(Value) > 64 ? alignof(Value) : 64;
+
+    /// Can vertical operations evaluate entries concurrently? (see \ref parallel_for_())
+    static constexpr bool IsParallel =
+        std::is_arithmetic_v<scalar_t<Value>> &&
+        (std::is_arithmetic_v<Value> ||
+         (is_static_array_v<Value> && array_depth_v<Value> == 1));
+
+    /// Vertical operations on arrays larger than this (in bytes) run in parallel
+    static constexpr size_t ParallelThreshold = 256 * 1024;
+
+    /// Number of bytes processed per parallel work item (fits the L1 cache)
+    static constexpr size_t ParallelChunk = 16 * 1024;
+
     using ArrayType = DynamicArray<array_t<Value>>;
     using MaskType  = DynamicArray<mask_t<Value>>;
     template <typename T> using ReplaceValue = DynamicArray<T>;
@@ -41,27 +263,32 @@ struct DynamicArray
 
     DynamicArray() = default;
 
-    DynamicArray(const DynamicArray &a) : m_size(a.m_size) {
-        if (!empty()) {
-            m_data = new Value[m_size];
-            for (size_t i = 0; i < m_size; ++i)
-                m_data[i] = a.m_data[i];
-        }
+    DynamicArray(const DynamicArray &a) {
+        init_(a.m_size);
+        copy_(m_data, a.m_data, m_size);
     }
 
-    DynamicArray(DynamicArray &&a)
-        : m_data(a.m_data), m_size(a.m_size), m_free(a.m_free) {
-        a.m_size = 0;
-        a.m_data = nullptr;
-        a.m_free = true;
-    }
+    DynamicArray(DynamicArray &&a) { move_(a); }
 
     template <typename Value2, bool IsMask2, typename Derived2>
     DynamicArray(const ArrayBase<Value2, IsMask2, Derived2> &v) {
         size_t size = v.derived().size();
         init_(size);
-        for (size_t i = 0; i < size; ++i)
-            m_data[i] = (Value) v.derived().entry(i);
+
+        // Vectorized bulk conversion between half and single precision
+        constexpr bool FromHalf = std::is_same_v<Value, float> &&
+                                  std::is_same_v<Derived2, DynamicArray<half>>,
+                       ToHalf   = std::is_same_v<Value, half> &&
+                                  std::is_same_v<Derived2, DynamicArray<float>>;
+
+        if constexpr (FromHalf) {
+            half_to_float32(v.derived().data(), m_data, size);
+        } else if constexpr (ToHalf) {
+            float32_to_half(v.derived().data(), m_data, size);
+        } else {
+            for (size_t i = 0; i < size; ++i)
+                m_data[i] = (Value) v.derived().entry(i);
+        }
     }
 
     template <typename Value2, bool IsMask2, typename Derived2>
@@ -96,27 +323,40 @@ struct DynamicArray
             m_data[i] = std::move(data[i]);
     }
 
-    ~DynamicArray() {
-        if (m_free)
-            delete[] m_data;
-    }
+    ~DynamicArray() { release_(); }
 
     DynamicArray &operator=(const DynamicArray &a) {
-        Value* new_data = new Value[a.m_size];
-        for (size_t i = 0; i < a.m_size; ++i)
-            new_data[i] = a.m_data[i];
-        if (m_free)
-            delete[] m_data;
+        if (this == &a)
+            return *this;
+
+        if (a.m_size == m_size && m_free) {
+            // Reuse the existing storage
+            copy_(m_data, a.m_data, m_size);
+            return *this;
+        }
+
+        Value *new_data = allocate_(a.m_size);
+        copy_(new_data, a.m_data, a.m_size);
+        if (new_data != m_data)
+            release_();
         m_size = a.m_size;
-        m_data = new_data;
+        m_data = a.m_size > 0 ? new_data : nullptr;
         m_free = true;
         return *this;
     }
 
     DynamicArray &operator=(DynamicArray &&a) {
-        std::swap(a.m_data, m_data);
-        std::swap(a.m_free, m_free);
-        std::swap(a.m_size, m_size);
+        if (this == &a)
+            return *this;
+
+        if (m_data == inline_() || a.m_data == a.inline_()) {
+            release_();
+            move_(a);
+        } else {
+            std::swap(a.m_data, m_data);
+            std::swap(a.m_free, m_free);
+            std::swap(a.m_size, m_size);
+        }
         return *this;
     }
 
@@ -206,20 +446,59 @@ struct DynamicArray
             DynamicArray<uint32_t> result;
             result.init_(m_size);
 
-            uint32_t accum = 0;
-            for (size_t i = 0; i < m_size; ++i) {
+            size_t i = 0, accum = 0;
+            if constexpr (std::is_same_v<Value, bool>) {
+                // Compress a packet of indices at a time
+                using UInt32P = Packet<uint32_t>;
+                using BoolP = Mask<bool, UInt32P::Size>;
+
+                UInt32P index = arange<UInt32P>();
+                for (; i + UInt32P::Size <= m_size; i += UInt32P::Size) {
+                    auto active = reinterpret_array<mask_t<UInt32P>>(
+                        load<BoolP>(m_data + i));
+                    accum += compress_store(result.m_data + accum, index, active);
+                    index += uint32_t(UInt32P::Size);
+                }
+            }
+
+            for (; i < m_size; ++i) {
                 if (m_data[i])
-                    result.m_data[accum++] = Value(i);
+                    result.m_data[accum++] = uint32_t(i);
             }
             result.m_size = accum;
             return result;
         }
     }
 
+    /**
+     * \brief Invoke <tt>func(i)</tt> for all i in [0, size), distributing the
+     * work over the threads of \ref set_dynamic_thread_count() when the array
+     * is large enough and \ref IsParallel holds. Used by the vertical
+     * operations of \ref ArrayBase.
+     */
+    template <typename Func> static void parallel_for_(size_t size, Func &&func) {
+        if (!IsParallel || size * sizeof(Value) < ParallelThreshold) {
+            for (size_t i = 0; i < size; ++i)
+                func(i);
+            return;
+        }
+
+        using FuncT = std::remove_reference_t<Func>;
+        size_t chunk = ParallelChunk / sizeof(Value);
+        detail::DynamicThreadPool::get().run(
+            size, chunk > 0 ? chunk : 1,
+            [](void *payload, size_t start, size_t end) {
+                FuncT &f = *(FuncT *) payload;
+                for (size_t i = start; i < end; ++i)
+                    f(i);
+            },
+            (void *) &func);
+    }
+
     void init_(size_t size) {
         if (size == 0)
             return;
-        m_data = new Value[size];
+        m_data = allocate_(size);
         m_size = size;
         m_free = true;
     }
@@ -228,6 +507,58 @@ struct DynamicArray
     Value *data() { return m_data; }
 
 protected:
+    Value *inline_() { return m_inline.ptr(); }
+    const Value *inline_() const { return m_inline.ptr(); }
+
+    /// Return the inline buffer if it can hold 'size' entries, else an aligned heap block
+    Value *allocate_(size_t size) {
+        if (size == 0)
+            return nullptr;
+        if (size <= InlineSize)
+            return inline_();
+        if constexpr (IsTrivial)
+            return (Value *) ::operator new[](
+                sizeof(Value) * size, std::align_val_t(Alignment));
+        else
+            return new Value[size];
+    }
+
+    /// Free the heap storage (if owned)
+    void release_() {
+        if (!m_free || !m_data || m_data == inline_())
+            return;
+        if constexpr (IsTrivial)
+            ::operator delete[](m_data, std::align_val_t(Alignment));
+        else
+            delete[] m_data;
+    }
+
+    static void copy_(Value *dst, const Value *src, size_t size) {
+        if constexpr (IsTrivial) {
+            if (size > 0)
+                memcpy((void *) dst, (const void *) src, sizeof(Value) * size);
+        } else {
+            for (size_t i = 0; i < size; ++i)
+                dst[i] = src[i];
+        }
+    }
+
+    /// Take over the contents of 'a' (only the inline buffer has to be copied)
+    void move_(DynamicArray &a) {
+        if (a.m_data && a.m_data == a.inline_()) {
+            m_data = inline_();
+            copy_(m_data, a.m_data, a.m_size);
+        } else {
+            m_data = a.m_data;
+        }
+        m_size = a.m_size;
+        m_free = a.m_free;
+        a.m_size = 0;
+        a.m_data = nullptr;
+        a.m_free = true;
+    }
+
+    detail::dynamic_inline_storage<Value, InlineSize> m_inline;
     Value *m_data = nullptr;
     size_t m_size = 0;
     bool m_free = true;
@@ -0,0 +1,428 @@
+/*
+    drjit/fft.h -- Batched fast Fourier transforms of complex arrays and
+    tensors
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/complex.h>
+#include <drjit/math.h>
+#include <drjit/tensor.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Problem size of a batched D-dimensional FFT
+ *
+ * The data consists of \c batch contiguous signals of shape
+ * (n[0], .., n[D-1]) in row-major order.
+ */
+template <size_t D> struct FFTDims {
+    uint32_t batch;
+    uint32_t n[D];
+
+    uint32_t points() const {
+        uint32_t result = 1;
+        for (size_t i = 0; i < D; ++i)
+            result *= n[i];
+        return result;
+    }
+
+    uint32_t size() const { return batch * points(); }
+};
+
+/**
+ * \brief Storage of the complex entries processed by an FFT pass: either
+ * separate arrays of real and imaginary parts, or a single array in which
+ * they are interleaved (the layout of tensors with a trailing axis of size 2)
+ */
+template <typename Array> struct FFTBuffer {
+    using Index = uint32_array_t<Array>;
+
+    Array re, im;
+    bool interleaved;
+
+    Complex<Array> load(const Index &i) const {
+        if (interleaved)
+            return { gather<Array>(re, i * 2u), gather<Array>(re, i * 2u + 1u) };
+        else
+            return { gather<Array>(re, i), gather<Array>(im, i) };
+    }
+
+    void store(const Complex<Array> &z, const Index &i) {
+        if (interleaved) {
+            scatter(re, real(z), i * 2u);
+            scatter(re, imag(z), i * 2u + 1u);
+        } else {
+            scatter(re, real(z), i);
+            scatter(im, imag(z), i);
+        }
+    }
+};
+
+/// Multiply \c z by the complex number <tt>c + i s</tt>
+template <typename Array, typename Scalar>
+Complex<Array> fft_rotate(const Complex<Array> &z, const Scalar &c,
+                          const Scalar &s) {
+    return { fmsub(real(z), c, imag(z) * s), fmadd(imag(z), c, real(z) * s) };
+}
+
+/// Multiply \c z by i (inverse transform) or -i (forward transform)
+template <typename Array>
+Complex<Array> fft_rotate_quarter(const Complex<Array> &z, bool inverse) {
+    if (inverse)
+        return { -imag(z), real(z) };
+    else
+        return { imag(z), -real(z) };
+}
+
+/// In-register DFT of 2, 4 or 8 entries that are overwritten by the result
+template <typename Array>
+void fft_butterfly(Complex<Array> *v, uint32_t radix, bool inverse) {
+    using Scalar = scalar_t<Array>;
+
+    if (radix == 2) {
+        Complex<Array> a = v[0];
+        v[0] = a + v[1];
+        v[1] = a - v[1];
+    } else if (radix == 4) {
+        Complex<Array> apc = v[0] + v[2], amc = v[0] - v[2],
+                       bpd = v[1] + v[3],
+                       bmd = fft_rotate_quarter(v[1] - v[3], inverse);
+        v[0] = apc + bpd;
+        v[1] = amc + bmd;
+        v[2] = apc - bpd;
+        v[3] = amc - bmd;
+    } else {
+        // Radix-4 DFTs of the even and odd entries, combined by a radix-2 step
+        Complex<Array> e[4] = { v[0], v[2], v[4], v[6] },
+                       o[4] = { v[1], v[3], v[5], v[7] };
+        fft_butterfly(e, 4, inverse);
+        fft_butterfly(o, 4, inverse);
+
+        Scalar h = Scalar(0.70710678118654752440),
+               s = inverse ? h : -h;
+        o[1] = fft_rotate(o[1], h, s);
+        o[2] = fft_rotate_quarter(o[2], inverse);
+        o[3] = fft_rotate(o[3], -h, s);
+
+        for (size_t k = 0; k < 4; ++k) {
+            v[k]     = e[k] + o[k];
+            v[k + 4] = e[k] - o[k];
+        }
+    }
+}
+
+/// Radix of the next Stockham pass along an axis with \c n_cur remaining points
+inline uint32_t fft_radix(uint32_t n_cur) {
+    return n_cur % 8 == 0 ? 8 : (n_cur % 4 == 0 ? 4 : 2);
+}
+
+/**
+ * \brief Evaluate one radix-\c radix Stockham pass along an axis of length
+ * \c n, whose entries are \c inner elements apart
+ *
+ * \c s is the product of the radices of the preceding passes along this
+ * axis. Each lane loads \c radix entries spaced <tt>n / (s * radix)</tt>
+ * apart, computes their butterfly, applies the twiddle factors and writes
+ * the results to consecutive (stride \c s) output locations. The Stockham
+ * formulation leaves the final result in natural order, without a separate
+ * bit reversal step.
+ */
+template <typename Array>
+void fft_pass(const FFTBuffer<Array> &src, FFTBuffer<Array> &dst,
+              uint32_t size, uint32_t n, uint32_t inner, uint32_t s,
+              uint32_t radix, bool inverse, scalar_t<Array> scale) {
+    using Index = uint32_array_t<Array>;
+    using Scalar = scalar_t<Array>;
+
+    uint32_t n_cur = n / s, m = n_cur / radix, groups = n / radix;
+
+    Index idx = arange<Index>(size / radix),
+          j = idx % inner,
+          rest = idx / inner,
+          b = rest % groups,
+          base = (rest / groups) * n,
+          q = b % s,
+          p = b / s;
+
+    Complex<Array> v[8];
+    for (uint32_t k = 0; k < radix; ++k)
+        v[k] = src.load((base + q + s * (p + k * m)) * inner + j);
+
+    fft_butterfly(v, radix, inverse);
+
+    Scalar step = (inverse ? TwoPi<Scalar> : -TwoPi<Scalar>) / Scalar(n_cur);
+    for (uint32_t e = 1; e < radix; ++e) {
+        auto [sin_w, cos_w] = sincos(Array(p * e) * step);
+        v[e] = fft_rotate(v[e], cos_w, sin_w);
+    }
+
+    for (uint32_t e = 0; e < radix; ++e) {
+        if (scale != Scalar(1))
+            v[e] = { real(v[e]) * scale, imag(v[e]) * scale };
+        dst.store(v[e], (base + q + s * (radix * p + e)) * inner + j);
+    }
+}
+
+/**
+ * \brief Transform the axes of \c data (in place) with a sequence of
+ * Stockham passes using radix 8, 4 and 2
+ *
+ * The inverse transform is scaled by <tt>1 / N</tt> when \c normalize is
+ * specified.
+ */
+template <size_t D, typename Array>
+void fft_kernel(FFTBuffer<Array> &data, const FFTDims<D> &d, bool inverse,
+                bool normalize) {
+    using Scalar = scalar_t<Array>;
+
+    uint32_t size = d.size(), inner = d.points(), passes = 0;
+    bool interleaved = data.interleaved;
+    for (size_t i = 0; i < D; ++i)
+        for (uint32_t s = 1; s < d.n[i]; s *= fft_radix(d.n[i] / s))
+            passes++;
+
+    Scalar scale = normalize ? Scalar(1) / Scalar(d.points()) : Scalar(1);
+
+    if (size == 0 || (passes == 0 && scale == Scalar(1)))
+        return;
+
+    if (passes == 0) {
+        data.re *= scale;
+        if (!data.interleaved)
+            data.im *= scale;
+        return;
+    }
+
+    for (size_t i = 0; i < D; ++i) {
+        uint32_t n = d.n[i];
+        inner /= n;
+
+        for (uint32_t s = 1; s < n; ) {
+            uint32_t radix = fft_radix(n / s);
+            bool last = --passes == 0;
+
+            // Intermediate results use the split layout
+            FFTBuffer<Array> out;
+            out.interleaved = last && interleaved;
+            out.re = empty<Array>(out.interleaved ? 2 * size : size);
+            if (!out.interleaved)
+                out.im = empty<Array>(size);
+
+            fft_pass(data, out, size, n, inner, s, radix, inverse,
+                     last ? scale : Scalar(1));
+            data = std::move(out);
+            s *= radix;
+        }
+    }
+}
+
+/// Apply \ref fft_kernel() to an array of complex numbers
+template <size_t D, typename Array>
+Complex<Array> fft_apply(const Complex<Array> &x, const FFTDims<D> &d,
+                         bool inverse, bool normalize) {
+    FFTBuffer<Array> data{ real(x), imag(x), false };
+    fft_kernel(data, d, inverse, normalize);
+    return { data.re, data.im };
+}
+
+/// Apply \ref fft_kernel() to an array of interleaved complex numbers
+template <size_t D, typename Array>
+Array fft_apply(const Array &x, const FFTDims<D> &d, bool inverse,
+                bool normalize) {
+    FFTBuffer<Array> data{ x, Array(), true };
+    fft_kernel(data, d, inverse, normalize);
+    return data.re;
+}
+
+/**
+ * \brief Differentiable FFT. The transform is linear, its derivative in the
+ * forward direction is the FFT of the input gradient. The adjoint of the
+ * unnormalized transform is the unnormalized transform in the opposite
+ * direction.
+ */
+template <size_t D, typename DiffArray, typename Value>
+struct FFTOp : CustomOp<DiffArray, Value, Value, FFTDims<D>, bool> {
+    using Base = CustomOp<DiffArray, Value, Value, FFTDims<D>, bool>;
+
+    Value eval(const Value &x, const FFTDims<D> &d, const bool &inverse) override {
+        m_dims = d;
+        m_inverse = inverse;
+        return Value(fft_apply(detach(x), d, inverse, inverse));
+    }
+
+    void forward() override {
+        Base::set_grad_out(Value(fft_apply(
+            detach(Base::template grad_in<0>()), m_dims, m_inverse, m_inverse)));
+    }
+
+    void backward() override {
+        Base::template set_grad_in<0>(Value(fft_apply(
+            detach(Base::grad_out()), m_dims, !m_inverse, m_inverse)));
+    }
+
+    const char *name() const override { return m_inverse ? "ifft" : "fft"; }
+
+private:
+    FFTDims<D> m_dims;
+    bool m_inverse;
+};
+
+/// Check that the signal shape consists of powers of two and fill \c d
+template <size_t D>
+void fft_dims(const char *name, size_t size, const size_t *n, FFTDims<D> &d) {
+    size_t points = 1;
+    for (size_t i = 0; i < D; ++i) {
+        if (n[i] == 0 || (n[i] & (n[i] - 1)) != 0)
+            drjit_raise("drjit::%s(): the transform size must be a power of "
+                        "two (got %zu along dimension %zu)!", name, n[i], i);
+        d.n[i] = (uint32_t) n[i];
+        points *= n[i];
+    }
+
+    if (size % points != 0)
+        drjit_raise("drjit::%s(): the input size (%zu) is not a multiple of "
+                    "the transform size (%zu)!", name, size, points);
+
+    d.batch = (uint32_t) (size / points);
+}
+
+template <size_t D, typename Value>
+Complex<Value> complex_fft(const char *name, const Complex<Value> &x,
+                           const size_t *n, bool inverse) {
+    static_assert(array_depth_v<Value> == 1 && is_dynamic_v<Value>,
+                  "drjit::fft(): requires a complex number of dynamic arrays!");
+
+    size_t size = width(x);
+
+    size_t n_[D];
+    for (size_t i = 0; i < D; ++i)
+        n_[i] = (D == 1 && n[i] == 0) ? size : n[i];
+
+    FFTDims<D> d;
+    fft_dims(name, size, n_, d);
+
+    if constexpr (is_diff_v<Value>)
+        return custom<FFTOp<D, Value, Complex<Value>>>(x, d, inverse);
+    else
+        return fft_apply(x, d, inverse, inverse);
+}
+
+template <size_t D, typename T>
+T tensor_fft(const char *name, const T &input, bool inverse) {
+    using Array = typename T::Array;
+
+    size_t ndim = input.ndim();
+    if (ndim < D + 1 || input.shape(ndim - 1) != 2)
+        drjit_raise("drjit::%s(): the input must be a tensor of shape "
+                    "([batch..,] signal dims.., 2) storing the real and "
+                    "imaginary parts along the last axis, with at least %zu "
+                    "dimensions!", name, D + 1);
+
+    FFTDims<D> d;
+    fft_dims(name, input.size() / 2, input.shape().data() + ndim - D - 1, d);
+
+    Array result;
+    if constexpr (is_diff_v<Array>)
+        result = custom<FFTOp<D, Array, Array>>(input.array(), d, inverse);
+    else
+        result = fft_apply(input.array(), d, inverse, inverse);
+
+    return T(result, ndim, input.shape().data());
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Batched 1D fast Fourier transform
+ *
+ * \c x stores consecutive signals of length \c n, which must be a power of
+ * two (the entire array is transformed by default). The transform computes
+ * <tt>X_k = sum_j x_j exp(-2 pi i j k / n)</tt> using a sequence of
+ * Stockham radix-8/4/2 passes, each of which is a single kernel. It is
+ * differentiable, the derivative is propagated through the adjoint
+ * transform.
+ */
+template <typename Value>
+Complex<Value> fft(const Complex<Value> &x, size_t n = 0) {
+    return detail::complex_fft<1>("fft", x, &n, false);
+}
+
+/// Inverse of \ref fft(), including the normalization by <tt>1 / n</tt>
+template <typename Value>
+Complex<Value> ifft(const Complex<Value> &x, size_t n = 0) {
+    return detail::complex_fft<1>("ifft", x, &n, true);
+}
+
+/// Batched 2D FFT of consecutive signals of shape (n0, n1), see \ref fft()
+template <typename Value>
+Complex<Value> fft2(const Complex<Value> &x, size_t n0, size_t n1) {
+    size_t n[2] = { n0, n1 };
+    return detail::complex_fft<2>("fft2", x, n, false);
+}
+
+/// Inverse of \ref fft2()
+template <typename Value>
+Complex<Value> ifft2(const Complex<Value> &x, size_t n0, size_t n1) {
+    size_t n[2] = { n0, n1 };
+    return detail::complex_fft<2>("ifft2", x, n, true);
+}
+
+/// Batched 3D FFT of consecutive signals of shape (n0, n1, n2), see \ref fft()
+template <typename Value>
+Complex<Value> fft3(const Complex<Value> &x, size_t n0, size_t n1, size_t n2) {
+    size_t n[3] = { n0, n1, n2 };
+    return detail::complex_fft<3>("fft3", x, n, false);
+}
+
+/// Inverse of \ref fft3()
+template <typename Value>
+Complex<Value> ifft3(const Complex<Value> &x, size_t n0, size_t n1, size_t n2) {
+    size_t n[3] = { n0, n1, n2 };
+    return detail::complex_fft<3>("ifft3", x, n, true);
+}
+
+/**
+ * \brief 1D FFT along the second to last axis of a tensor of shape
+ * ([batch..,] n, 2), whose last axis holds the real and imaginary parts
+ */
+template <typename Array> Tensor<Array> fft(const Tensor<Array> &t) {
+    return detail::tensor_fft<1>("fft", t, false);
+}
+
+/// Inverse of \ref fft(const Tensor<Array> &)
+template <typename Array> Tensor<Array> ifft(const Tensor<Array> &t) {
+    return detail::tensor_fft<1>("ifft", t, true);
+}
+
+/// 2D FFT of a tensor of shape ([batch..,] n0, n1, 2)
+template <typename Array> Tensor<Array> fft2(const Tensor<Array> &t) {
+    return detail::tensor_fft<2>("fft2", t, false);
+}
+
+/// Inverse of \ref fft2(const Tensor<Array> &)
+template <typename Array> Tensor<Array> ifft2(const Tensor<Array> &t) {
+    return detail::tensor_fft<2>("ifft2", t, true);
+}
+
+/// 3D FFT of a tensor of shape ([batch..,] n0, n1, n2, 2)
+template <typename Array> Tensor<Array> fft3(const Tensor<Array> &t) {
+    return detail::tensor_fft<3>("fft3", t, false);
+}
+
+/// Inverse of \ref fft3(const Tensor<Array> &)
+template <typename Array> Tensor<Array> ifft3(const Tensor<Array> &t) {
+    return detail::tensor_fft<3>("ifft3", t, true);
+}
+
+NAMESPACE_END(drjit)
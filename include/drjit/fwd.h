@@ -274,11 +274,55 @@ namespace detail {
 /// This library supports two main directions of derivative propagation
 enum class ADMode { Primal, Forward, Backward };
 
+/// Cumulative statistics of the AD backend, see \ref ad_stats()
+struct ADStats {
+    /// Number of calls to \ref traverse()
+    size_t traversals;
+
+    /// Number of intermediate evaluations of asynchronous traversals (ADFlag::Async)
+    size_t async_evals;
+
+    /// Time (ms) spent enqueuing edges (depth-first search)
+    double time_dfs;
+
+    /// Time (ms) spent bringing the enqueued edges into traversal order
+    double time_sort;
+
+    /// Time (ms) spent propagating gradients (includes 'time_special')
+    double time_traverse;
+
+    /// Time (ms) spent within callbacks of special edges (custom ops, etc.)
+    double time_special;
+
+    /// Time (ms) spent releasing references and edges after traversal
+    double time_cleanup;
+
+    /**
+     * The same timings (ms) for the most recently completed traversal alone
+     * ('last_time_dfs' covers the calls to \ref enqueue() preceding it), and
+     * the number of edges that it processed
+     */
+    double last_time_dfs, last_time_sort, last_time_traverse,
+           last_time_special, last_time_cleanup;
+    size_t last_edges;
+
+    /// Current number of variables in the AD graph
+    size_t variables;
+
+    /// Current and peak number of edges in the AD graph
+    size_t edges, edges_peak;
+
+    /// Host memory (bytes) used by the variable and edge records (excluding gradients)
+    size_t variable_bytes, edge_bytes;
+};
+
 NAMESPACE_BEGIN(detail)
 enum class ADScope { Invalid = 0, Suspend = 1, Resume = 2, Isolate = 3 };
 // A few forward declarations so that this compiles even without autodiff.h
 template <typename Value> void ad_inc_ref_impl(uint32_t) noexcept;
 template <typename Value> void ad_dec_ref_impl(uint32_t) noexcept;
+template <typename Value> void ad_inc_ref_n_impl(size_t, const uint32_t *) noexcept;
+template <typename Value> void ad_dec_ref_n_impl(size_t, const uint32_t *) noexcept;
 template <typename Value, typename Mask>
 uint32_t ad_new_select(const char *, size_t, const Mask &, uint32_t, uint32_t);
 template <typename Value>
@@ -298,6 +342,10 @@ NAMESPACE_END(detail)
         ad_inc_ref_impl<T>(uint32_t) noexcept(true);                           \
     extern template DRJIT_AD_EXPORT void                                       \
         ad_dec_ref_impl<T>(uint32_t) noexcept(true);                           \
+    extern template DRJIT_AD_EXPORT void                                       \
+        ad_inc_ref_n_impl<T>(size_t, const uint32_t *) noexcept(true);         \
+    extern template DRJIT_AD_EXPORT void                                       \
+        ad_dec_ref_n_impl<T>(size_t, const uint32_t *) noexcept(true);         \
     extern template DRJIT_AD_EXPORT void ad_scope_enter<T>(                    \
         ADScope type, size_t, const uint32_t *);                               \
     extern template DRJIT_AD_EXPORT void ad_scope_leave<T>(bool);              \
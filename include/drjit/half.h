@@ -15,6 +15,7 @@
 
 #include <drjit/array_traits.h>
 #include <drjit/packet_intrin.h>
+#include <ostream>
 
 NAMESPACE_BEGIN(drjit)
 struct half;
@@ -158,6 +159,60 @@ public:
     }
 };
 
+/**
+ * \brief Convert \c size half precision values to single precision
+ *
+ * Unlike a loop over \ref half::float16_to_float32(), this processes 16
+ * (AVX512) or 8 (F16C, AArch64 NEON) values per iteration, which matters when
+ * importing large fp16 buffers. The remainder is converted one value at a time.
+ */
+inline void half_to_float32(const half *in, float *out, size_t size) {
+    size_t i = 0;
+#if defined(DRJIT_X86_AVX512)
+    for (; i + 16 <= size; i += 16)
+        _mm512_storeu_ps(out + i, _mm512_cvtph_ps(
+            _mm256_loadu_si256((const __m256i *) (in + i))));
+#endif
+#if defined(DRJIT_X86_F16C)
+    for (; i + 8 <= size; i += 8)
+        _mm256_storeu_ps(out + i, _mm256_cvtph_ps(
+            _mm_loadu_si128((const __m128i *) (in + i))));
+#elif defined(DRJIT_ARM_NEON) && defined(DRJIT_ARM_64)
+    for (; i + 8 <= size; i += 8) {
+        float16x8_t v = vreinterpretq_f16_u16(vld1q_u16((const uint16_t *) (in + i)));
+        vst1q_f32(out + i, vcvt_f32_f16(vget_low_f16(v)));
+        vst1q_f32(out + i + 4, vcvt_high_f32_f16(v));
+    }
+#endif
+    for (; i < size; ++i)
+        out[i] = half::float16_to_float32(in[i].value);
+}
+
+/// Convert \c size single precision values to half precision (see \ref half_to_float32())
+inline void float32_to_half(const float *in, half *out, size_t size) {
+    size_t i = 0;
+#if defined(DRJIT_X86_AVX512)
+    for (; i + 16 <= size; i += 16)
+        _mm256_storeu_si256((__m256i *) (out + i),
+                            _mm512_cvtps_ph(_mm512_loadu_ps(in + i),
+                                            _MM_FROUND_CUR_DIRECTION));
+#endif
+#if defined(DRJIT_X86_F16C)
+    for (; i + 8 <= size; i += 8)
+        _mm_storeu_si128((__m128i *) (out + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                         _MM_FROUND_CUR_DIRECTION));
+#elif defined(DRJIT_ARM_NEON) && defined(DRJIT_ARM_64)
+    for (; i + 8 <= size; i += 8) {
+        float16x8_t v = vcvt_high_f16_f32(vcvt_f16_f32(vld1q_f32(in + i)),
+                                          vld1q_f32(in + i + 4));
+        vst1q_u16((uint16_t *) (out + i), vreinterpretq_u16_f16(v));
+    }
+#endif
+    for (; i < size; ++i)
+        out[i] = half::from_binary(half::float32_to_float16(in[i]));
+}
+
 NAMESPACE_END(drjit)
 
 NAMESPACE_BEGIN(std)
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <drjit/array.h>
+#include <drjit/struct.h>
 
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
@@ -210,6 +211,76 @@ struct divisor<T, enable_if_t<std::is_signed_v<T>>> {
     }
 } DRJIT_PACK;
 
+/**
+ * \brief Per-lane divisors of an integer array
+ *
+ * Stores the multiplier and shift of a separate divisor for every lane of
+ * \c T as parallel arrays. The precomputation performs a branch-free long
+ * division in every lane, hence it is best hoisted out of loops: for instance,
+ * a table of divisors (e.g. one per instance) can be built once and its
+ * entries subsequently fetched via <tt>gather<divisor<UInt32>>(table,
+ * index)</tt>. Signed divisors are handled by dividing the magnitudes and
+ * restoring the sign, which matches the rounding of the <tt>/</tt> operator.
+ * Division by zero is undefined.
+ */
+template <typename T>
+struct divisor<T, enable_if_t<is_array_v<T> && std::is_integral_v<scalar_t<T>>>> {
+    using UInt = uint_array_t<T>;
+    static constexpr bool Signed = std::is_signed_v<scalar_t<T>>;
+    static constexpr size_t Bits = sizeof(scalar_t<T>) * 8;
+
+    T div;
+    UInt multiplier;
+    UInt shift;
+
+    divisor(const T &div) : div(div) {
+        UInt ad = magnitude(div),
+             log = log2i(ad);
+        mask_t<UInt> pow2 = eq(ad & (ad - 1), 0);
+
+        // Long division of 2^(Bits + log) by the divisor, one bit at a time
+        UInt m = 0, rem = UInt(1) << log;
+        for (size_t i = 0; i < Bits; ++i) {
+            mask_t<UInt> carry = neq(sr<Bits - 1>(rem), 0);
+            rem = sl<1>(rem);
+            mask_t<UInt> ge = carry || rem >= ad;
+            rem = select(ge, rem - ad, rem);
+            m = sl<1>(m) | select(ge, UInt(1), UInt(0));
+        }
+
+        UInt rem2 = rem * 2;
+        m = m * 2 + 1 + select(rem2 >= ad || rem2 < rem, UInt(1), UInt(0));
+
+        // Powers of two only shift, division by one is handled in operator()
+        multiplier = select(pow2, UInt(0), m);
+        shift = select(pow2, log - select(neq(log, 0), UInt(1), UInt(0)), log);
+    }
+
+    T operator()(const T &value) const {
+        UInt n = magnitude(value), ad = magnitude(div);
+
+        UInt q = mulhi(multiplier, n);
+        UInt t = sr<1>(n - q) + q;
+        UInt result = select(eq(ad, 1), n, t >> shift);
+
+        if constexpr (Signed) {
+            T r = T(result);
+            return select((value ^ div) < 0, -r, r);
+        } else {
+            return result;
+        }
+    }
+
+    static UInt magnitude(const T &value) {
+        if constexpr (Signed)
+            return UInt(abs(value));
+        else
+            return value;
+    }
+
+    DRJIT_STRUCT(divisor, div, multiplier, shift)
+};
+
 template <typename Value> DRJIT_INLINE Value idiv(const Value &a, const divisor<scalar_t<Value>> &div) {
     static_assert(std::is_integral_v<scalar_t<Value>>, "idiv(): requires integral operands!");
     return div(a);
@@ -238,4 +309,61 @@ template <typename Value> DRJIT_INLINE std::pair<Value, Value> idivmod(const Val
     return { d, a - d*div.div };
 }
 
+template <typename Value, enable_if_array_t<Value> = 0>
+DRJIT_INLINE Value idiv(const Value &a, const divisor<Value> &div) {
+    static_assert(std::is_integral_v<scalar_t<Value>>, "idiv(): requires integral operands!");
+    return div(a);
+}
+
+template <typename Value, enable_if_array_t<Value> = 0>
+DRJIT_INLINE Value imod(const Value &a, const divisor<Value> &div) {
+    static_assert(std::is_integral_v<scalar_t<Value>>, "imod(): requires integral operands!");
+    return a - div(a) * div.div;
+}
+
+template <typename Value, enable_if_array_t<Value> = 0>
+DRJIT_INLINE std::pair<Value, Value> idivmod(const Value &a, const divisor<Value> &div) {
+    static_assert(std::is_integral_v<scalar_t<Value>>, "idivmod(): requires integral operands!");
+    Value d = div(a);
+    return { d, a - d * div.div };
+}
+
+/**
+ * \brief Quotient and remainder of integers below 2^24 via a floating point
+ * reciprocal
+ *
+ * Both operands must lie in <tt>[0, 2^24)</tt> (the divisor being nonzero),
+ * which makes them exactly representable in single precision. The product of
+ * the dividend and the correctly rounded reciprocal of the divisor is then off
+ * by less than one from the true quotient, and a single correction step based
+ * on the remainder makes the result exact. This is much cheaper than integer
+ * division on GPUs and on CPUs lacking vectorized integer division, and it
+ * does not require any precomputation for per-lane divisors.
+ */
+template <typename Value>
+DRJIT_INLINE std::pair<Value, Value> idivmod24(const Value &a, const Value &d) {
+    static_assert(std::is_integral_v<scalar_t<Value>>, "idivmod24(): requires integral operands!");
+    using Int = int32_array_t<Value>;
+    using Float = float32_array_t<Value>;
+
+    Float df = Float(d);
+    Int ai = Int(a), di = Int(d),
+        q = Int(Float(a) * (1.f / df)),
+        r = ai - q * di;
+
+    mask_t<Int> under = r < 0, over = r >= di;
+    q = select(under, q - 1, select(over, q + 1, q));
+    r = select(under, r + di, select(over, r - di, r));
+
+    return { Value(q), Value(r) };
+}
+
+template <typename Value> DRJIT_INLINE Value idiv24(const Value &a, const Value &d) {
+    return idivmod24(a, d).first;
+}
+
+template <typename Value> DRJIT_INLINE Value imod24(const Value &a, const Value &d) {
+    return idivmod24(a, d).second;
+}
+
 NAMESPACE_END(drjit)
@@ -0,0 +1,238 @@
+/*
+    drjit/intersect.h -- Ray-box, ray-triangle and ray-sphere intersection
+    routines for packets and JIT arrays
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/array.h>
+#include <drjit/struct.h>
+#include <tuple>
+
+NAMESPACE_BEGIN(drjit)
+
+/**
+ * \brief Reciprocal of a ray direction for use with \ref ray_box()
+ *
+ * Zero components are mapped exactly to an infinity with the same sign,
+ * independently of the accuracy of \ref rcp() on the current platform.
+ */
+template <typename Vector3> Vector3 ray_rcp_dir(const Vector3 &d) {
+    using Value = value_t<Vector3>;
+    Vector3 result;
+    for (size_t i = 0; i < 3; ++i)
+        result.entry(i) = select(eq(d.entry(i), 0),
+                                 mulsign(Value(Infinity<Value>), d.entry(i)),
+                                 rcp(d.entry(i)));
+    return result;
+}
+
+/**
+ * \brief Slab test of a ray against an axis-aligned box
+ *
+ * Takes the ray origin \c o, the reciprocal direction \c d_rcp computed by
+ * \ref ray_rcp_dir(), the box bounds and the ray segment
+ * <tt>[tmin, tmax]</tt>. Returns the hit mask along with the parametric
+ * distances where the ray enters and exits the box (clipped to the segment).
+ *
+ * The routine is free of branches. The entry and exit distances of each slab
+ * are chosen using the sign of the direction instead of a minimum and
+ * maximum, and are merged using comparisons that ignore NaNs. A ray lying
+ * within a slab plane computes <tt>0 * inf = NaN</tt>, which therefore
+ * leaves that side of the slab unbounded. The exit distance is enlarged by
+ * <tt>2 * gamma(3)</tt> as in Ize's "Robust BVH Ray Traversal" (JCGT 2013),
+ * which makes the test conservative despite rounding errors. Rays that graze
+ * a box within this bound may therefore report a hit.
+ */
+template <typename Vector3>
+std::tuple<mask_t<value_t<Vector3>>, value_t<Vector3>, value_t<Vector3>>
+ray_box(const Vector3 &o, const Vector3 &d_rcp, const Vector3 &lo,
+        const Vector3 &hi, const value_t<Vector3> &tmin,
+        const value_t<Vector3> &tmax) {
+    using Value = value_t<Vector3>;
+    using Scalar = scalar_t<Value>;
+    constexpr Scalar Gamma3 = 3 * Epsilon<Scalar> / (1 - 3 * Epsilon<Scalar>);
+
+    Value t_near = tmin, t_far = tmax;
+    for (size_t i = 0; i < 3; ++i) {
+        Value t0 = (lo.entry(i) - o.entry(i)) * d_rcp.entry(i),
+              t1 = (hi.entry(i) - o.entry(i)) * d_rcp.entry(i);
+        auto neg = d_rcp.entry(i) < 0;
+        Value tn = select(neg, t1, t0),
+              tf = select(neg, t0, t1) * (1 + 2 * Gamma3);
+        t_near = select(tn > t_near, tn, t_near);
+        t_far  = select(tf < t_far, tf, t_far);
+    }
+
+    return { t_near <= t_far, t_near, t_far };
+}
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Twice the 2D cross product <tt>ax * by - ay * bx</tt>
+ *
+ * Swapping the two points negates the result exactly, even when the compiler
+ * contracts multiplications and subtractions into FMA instructions (which
+ * would break the watertightness of \ref ray_triangle()).
+ */
+template <typename Value>
+Value edge_function(const Value &ax, const Value &ay, const Value &bx,
+                    const Value &by) {
+    return fmsub(ax, by, ay * bx) - fmsub(ay, bx, ax * by);
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Per-ray constants of the watertight ray-triangle test of Woop et al.
+ *
+ * The test ("Watertight Ray/Triangle Intersection", JCGT 2013) permutes
+ * the coordinates so that the dominant axis of the ray direction becomes the
+ * z axis, and then shears space so that the ray points along this axis. The
+ * permutation differs between lanes. It is applied with \c select() rather
+ * than with branches, and is swapped when the dominant component is negative
+ * so that the winding order is preserved. Computing these values once per ray
+ * and reusing them for many triangles avoids redundant divisions.
+ */
+template <typename Vector3_> struct TriangleRay {
+    using Vector3 = Vector3_;
+    using Value = value_t<Vector3>;
+    using Mask = mask_t<Value>;
+
+    /// Ray origin
+    Vector3 o;
+
+    /// Is the dominant direction axis x (or y)? Otherwise it is z
+    Mask axis_x, axis_y;
+
+    /// Swap the first two permuted coordinates
+    Mask flip;
+
+    /// Shear constants
+    Value sx, sy, sz;
+
+    TriangleRay(const Vector3 &o, const Vector3 &d) : o(o) {
+        Vector3 a = abs(d);
+        axis_x = a.x() >= a.y() && a.x() >= a.z();
+        axis_y = !axis_x && a.y() >= a.z();
+        flip = false;
+
+        Vector3 dp = permute(d);
+        flip = dp.z() < 0;
+        sz = rcp(dp.z());
+        sx = select(flip, dp.y(), dp.x()) * sz;
+        sy = select(flip, dp.x(), dp.y()) * sz;
+    }
+
+    /// Permute \c v so that the dominant direction axis becomes the z axis
+    Vector3 permute(const Vector3 &v) const {
+        Value x = select(axis_x, v.y(), select(axis_y, v.z(), v.x())),
+              y = select(axis_x, v.z(), select(axis_y, v.x(), v.y())),
+              z = select(axis_x, v.x(), select(axis_y, v.y(), v.z()));
+        return { select(flip, y, x), select(flip, x, y), z };
+    }
+
+    DRJIT_STRUCT(TriangleRay, o, axis_x, axis_y, flip, sx, sy, sz)
+};
+
+/**
+ * \brief Watertight intersection of a ray with the triangle <tt>(p0, p1,
+ * p2)</tt>
+ *
+ * Returns the hit mask, the parametric distance along the ray and the
+ * barycentric coordinates <tt>(u, v)</tt>. The hit position is
+ * <tt>(1 - u - v) * p0 + u * p1 + v * p2</tt>. Both triangle orientations
+ * are reported, and only hits within the open interval <tt>(tmin, tmax)</tt>
+ * count.
+ *
+ * The edge functions are evaluated in the sheared space of \ref TriangleRay,
+ * where they agree exactly between triangles that share an edge. A ray can
+ * therefore never slip through the seam between two triangles. Rays that hit
+ * an edge exactly (i.e. an edge function is zero) are reported by both
+ * adjacent triangles. The original paper recomputes such edge functions in
+ * double precision, which would require a branch and is omitted here.
+ */
+template <typename Vector3>
+std::tuple<mask_t<value_t<Vector3>>, value_t<Vector3>, value_t<Vector3>,
+           value_t<Vector3>>
+ray_triangle(const TriangleRay<Vector3> &ray, const Vector3 &p0,
+             const Vector3 &p1, const Vector3 &p2,
+             const value_t<Vector3> &tmin, const value_t<Vector3> &tmax) {
+    using Value = value_t<Vector3>;
+    using Mask = mask_t<Value>;
+
+    Vector3 a = ray.permute(p0 - ray.o),
+            b = ray.permute(p1 - ray.o),
+            c = ray.permute(p2 - ray.o);
+
+    Value ax = fnmadd(ray.sx, a.z(), a.x()), ay = fnmadd(ray.sy, a.z(), a.y()),
+          bx = fnmadd(ray.sx, b.z(), b.x()), by = fnmadd(ray.sy, b.z(), b.y()),
+          cx = fnmadd(ray.sx, c.z(), c.x()), cy = fnmadd(ray.sy, c.z(), c.y());
+
+    // Scaled barycentric coordinates of p0, p1 and p2
+    Value u = detail::edge_function(bx, by, cx, cy),
+          v = detail::edge_function(cx, cy, ax, ay),
+          w = detail::edge_function(ax, ay, bx, by);
+
+    Value det = u + v + w,
+          t_scaled = fmadd(u, a.z(), fmadd(v, b.z(), w * c.z())) * ray.sz,
+          inv_det = rcp(det),
+          t = t_scaled * inv_det;
+
+    Mask miss = (u < 0 || v < 0 || w < 0) && (u > 0 || v > 0 || w > 0);
+    Mask hit = !miss && neq(det, 0) && t > tmin && t < tmax;
+
+    return { hit, t, v * inv_det, w * inv_det };
+}
+
+/**
+ * \brief Intersection of a ray with a sphere
+ *
+ * Returns the hit mask and the parametric distance of the nearest
+ * intersection within the open interval <tt>(tmin, tmax)</tt>. The ray
+ * direction need not be normalized.
+ *
+ * The quadratic is solved with the numerically robust formulation from
+ * "Precision Improvements for Ray/Sphere Intersection" (Ray Tracing Gems,
+ * 2019). It computes the discriminant from the distance between the center
+ * and the ray, and avoids cancellation between the two roots.
+ */
+template <typename Vector3>
+std::pair<mask_t<value_t<Vector3>>, value_t<Vector3>>
+ray_sphere(const Vector3 &o, const Vector3 &d, const Vector3 &center,
+           const value_t<Vector3> &radius, const value_t<Vector3> &tmin,
+           const value_t<Vector3> &tmax) {
+    using Value = value_t<Vector3>;
+    using Mask = mask_t<Value>;
+
+    Vector3 f = o - center;
+    Value r2 = radius * radius,
+          a = squared_norm(d),
+          b = dot(f, d),
+          c = squared_norm(f) - r2;
+
+    Vector3 l = fnmadd(d, b / a, f);
+    Value disc = a * (r2 - squared_norm(l));
+
+    Value q  = -(b + mulsign(sqrt(maximum(disc, 0)), b)),
+          t1 = q / a,
+          t0 = select(neq(q, 0), c / q, t1);
+
+    Value t_near = minimum(t0, t1),
+          t_far  = maximum(t0, t1),
+          t      = select(t_near > tmin, t_near, t_far);
+
+    Mask hit = disc >= 0 && t > tmin && t < tmax;
+    return { hit, t };
+}
+
+NAMESPACE_END(drjit)
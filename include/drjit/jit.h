@@ -15,9 +15,75 @@
 
 #include <drjit/array.h>
 #include <drjit-core/traits.h>
+#include <cstring>
 
 NAMESPACE_BEGIN(drjit)
 
+NAMESPACE_BEGIN(detail)
+
+/// Installed by \ref DeterministicReductionScope (see below)
+inline thread_local bool deterministic_reductions = false;
+
+/// Can reductions of this type differ from run to run?
+template <typename T>
+constexpr bool nondeterministic_reduce_v =
+    std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+template <typename Array> Array reduce_deterministic(const Array &value, ReduceOp op);
+
+template <typename Array, typename Index, typename Mask>
+void scatter_add_deterministic(Array &dst, const Array &value,
+                               const Index &index, const Mask &mask);
+
+/// Label that marks variables created by \ref reinterpret_alias()
+static constexpr const char reinterpret_alias_label[] = "reinterpret_alias";
+
+/// Releases the source of an alias when the alias is freed
+inline void reinterpret_alias_callback(uint32_t, int free, void *payload) {
+    if (free)
+        jit_var_dec_ref((uint32_t) (uintptr_t) payload);
+}
+
+/**
+ * \brief Create a variable of type \c type that refers to the storage of the
+ * evaluated variable \c source
+ *
+ * The new variable keeps a reference to \c source until it is freed. Writes to
+ * the source copy it as usual (since its reference count is larger than one),
+ * while writes to the alias first replace it by a copy (see \ref JitArray::unalias_()).
+ * The alias is recognized by its label, which drjit-core stores on the
+ * variable itself and hence is shared by all modules using it.
+ */
+inline uint32_t reinterpret_alias(JitBackend backend, VarType type,
+                                  uint32_t source) {
+    uint32_t index = jit_var_mem_map(backend, type, (void *) jit_var_ptr(source),
+                                     jit_var_size(source), 0);
+
+    uint32_t labeled = jit_var_set_label(index, reinterpret_alias_label);
+    jit_var_dec_ref(index);
+    index = labeled;
+
+    jit_var_inc_ref(source);
+    jit_var_set_callback(index, reinterpret_alias_callback,
+                         (void *) (uintptr_t) source);
+
+    return index;
+}
+
+/// Does the variable \c index share its storage with other variables?
+inline bool is_reinterpret_alias(uint32_t index) {
+    const char *label = jit_var_label(index);
+    if (!label)
+        return false;
+
+    // Labels may carry a prefix (see jit_prefix_push())
+    size_t size = strlen(label), tag = sizeof(reinterpret_alias_label) - 1;
+    return size >= tag &&
+           strcmp(label + size - tag, reinterpret_alias_label) == 0;
+}
+
+NAMESPACE_END(detail)
+
 template <JitBackend Backend_, typename Value_, typename Derived_>
 struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
     static_assert(std::is_scalar_v<Value_>,
@@ -80,6 +146,17 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
     template <typename T, typename Derived2>
     JitArray(const JitArray<Backend, T, Derived2> &v,
              detail::reinterpret_flag) {
+        /* Evaluated arrays share their storage instead of materializing a
+           bitcast when the result is evaluated. Other inputs produce a bitcast
+           node that is fused into the consumer kernel. */
+        if constexpr (sizeof(T) == sizeof(Value) && !std::is_same_v<T, Value> &&
+                      !IsClass) {
+            if (v.is_evaluated() && !jit_flag(JitFlag::Recording)) {
+                v.eval_(); // Perform pending scatters
+                m_index = detail::reinterpret_alias(Backend, Type, v.index());
+                return;
+            }
+        }
         m_index = jit_var_cast(v.index(), Type, 1);
     }
 
@@ -334,6 +411,11 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
         Derived name##_() const {                                              \
             if (size() == 0)                                                   \
                 default_op;                                                    \
+            if constexpr (detail::nondeterministic_reduce_v<Value>) {          \
+                if ((op == ReduceOp::Add || op == ReduceOp::Mul) &&            \
+                    detail::deterministic_reductions)                          \
+                    return detail::reduce_deterministic(derived(), op);        \
+            }                                                                  \
             return steal(jit_var_reduce(m_index, op));                         \
         }
 
@@ -480,6 +562,7 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
     void scatter_(Derived &dst, const Index &index, const Mask &mask) const {
         static_assert(
             std::is_same_v<detached_t<Mask>, detached_t<mask_t<Derived>>>);
+        dst.unalias_();
         dst = steal(jit_var_scatter(dst.index(), m_index, index.index(),
                                     mask.index(), ReduceOp::None));
     }
@@ -497,6 +580,13 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
                          const Mask &mask) const {
         static_assert(
             std::is_same_v<detached_t<Mask>, detached_t<mask_t<Derived>>>);
+        if constexpr (detail::nondeterministic_reduce_v<Value>) {
+            if (op == ReduceOp::Add && detail::deterministic_reductions) {
+                detail::scatter_add_deterministic(dst, derived(), index, mask);
+                return;
+            }
+        }
+        dst.unalias_();
         dst = steal(jit_var_scatter(dst.index(), m_index, index.index(),
                                     mask.index(), op));
     }
@@ -506,6 +596,8 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
                                const Index &index, const Mask &mask) const {
         static_assert(
             std::is_same_v<detached_t<Mask>, detached_t<mask_t<Derived>>>);
+        dst_1.unalias_();
+        dst_2.unalias_();
         jit_var_scatter_reduce_kahan(dst_1.index_ptr(), dst_2.index_ptr(),
                                      m_index, index.index(), mask.index());
     }
@@ -515,6 +607,7 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
                              const Mask &mask) {
         static_assert(
             std::is_same_v<detached_t<Mask>, detached_t<mask_t<Derived>>>);
+        dst.unalias_();
         return steal(jit_var_scatter_inc(dst.index_ptr(), index.index(), mask.index()));
     }
 
@@ -583,6 +676,12 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
 
     Derived copy() const { return steal(jit_var_copy(m_index)); }
 
+    /// Replace an array sharing the storage of another one by a copy before writing to it
+    void unalias_() {
+        if (detail::is_reinterpret_alias(m_index))
+            derived() = copy();
+    }
+
     bool schedule_() const { return jit_var_schedule(m_index) != 0; }
     bool eval_() const { return jit_var_eval(m_index) != 0; }
 
@@ -611,6 +710,7 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
     }
 
     void set_entry(size_t offset, Value value) {
+        unalias_();
         uint32_t index;
         if constexpr (!IsClass) {
             index = jit_var_write(m_index, offset, &value);
@@ -632,11 +732,43 @@ struct JitArray : ArrayBase<Value_, is_mask_v<Value_>, Derived_> {
         return steal(jit_var_migrate(m_index, type));
     }
 
+    /**
+     * \brief Copy the array into the memory of the CUDA device \c device
+     *
+     * The array is evaluated and copied by the device holding the result,
+     * without a round trip through host memory (the driver uses a
+     * peer-to-peer transfer when the two devices support it). The copy
+     * completes before the function returns, hence the original array can
+     * be released right away.
+     */
+    Derived migrate_device_(int32_t device) const {
+        if constexpr (Backend != JitBackend::CUDA) {
+            DRJIT_MARK_USED(device);
+            drjit_raise("migrate_device(): only CUDA arrays reside on a device!");
+        } else {
+            eval_();
+            if (jit_var_device(m_index) == device)
+                return derived();
+
+            const void *ptr = jit_var_ptr(m_index);
+            jit_sync_thread();
+
+            int32_t prev = jit_cuda_device();
+            jit_cuda_set_device(device);
+            uint32_t index = jit_var_mem_copy(Backend, AllocType::Device, Type,
+                                              ptr, size());
+            jit_sync_thread();
+            jit_cuda_set_device(prev);
+            return steal(index);
+        }
+    }
+
     static auto counter(size_t size) {
         return uint32_array_t<Derived>::steal(jit_var_counter(Backend, size));
     }
 
 	void set_label_(const char *label) {
+        unalias_(); // Don't drop the marker of an alias
         uint32_t index = jit_var_set_label(m_index, label);
         jit_var_dec_ref(m_index);
         m_index = index;
@@ -699,6 +831,37 @@ DRJIT_DECLARE_EXTERN_TEMPLATE(LLVMArray<float>, LLVMArray<bool>, LLVMArray<uint3
 DRJIT_DECLARE_EXTERN_TEMPLATE(LLVMArray<double>, LLVMArray<bool>, LLVMArray<uint32_t>)
 #endif
 
+/**
+ * \brief Sum arrays that reside on different CUDA devices and store the
+ * result on every one of them (e.g. to aggregate gradients)
+ *
+ * Entry \c i of \c values must reside on the device <tt>devices[i]</tt>.
+ * The arrays are gathered and summed on the first device, after which the
+ * sum is copied back to the other devices.
+ */
+template <typename T>
+void all_reduce(std::vector<T> &values, const std::vector<int32_t> &devices) {
+    if (values.size() != devices.size())
+        drjit_raise("drjit::all_reduce(): the number of arrays (%zu) and "
+                    "devices (%zu) must match!", values.size(), devices.size());
+    if (values.empty())
+        return;
+
+    int32_t prev = jit_cuda_device();
+    jit_cuda_set_device(devices[0]);
+
+    T sum = values[0];
+    for (size_t i = 1; i < values.size(); ++i)
+        sum = sum + migrate_device(values[i], devices[0]);
+    eval(sum);
+
+    values[0] = sum;
+    for (size_t i = 1; i < values.size(); ++i)
+        values[i] = migrate_device(sum, devices[i]);
+
+    jit_cuda_set_device(prev);
+}
+
 template <typename Mask, typename... Ts>
 void printf_async(const Mask &mask, const char *fmt, const Ts &... ts) {
     constexpr bool Active = is_jit_v<Mask> || (is_jit_v<Ts> || ...);
@@ -715,6 +878,128 @@ void printf_async(const Mask &mask, const char *fmt, const Ts &... ts) {
     }
 }
 
+/**
+ * \brief Make floating point reductions reproducible
+ *
+ * On the CUDA backend and on the multithreaded LLVM backend, the order in
+ * which partial results are combined by \ref sum(), \ref prod(), \ref dot()
+ * and \ref scatter_reduce() with <tt>ReduceOp::Add</tt> depends on
+ * scheduling and atomic ordering, hence floating point results can change
+ * from run to run. While this scope is active, single and double precision
+ * reductions issued by the current thread are bitwise reproducible instead:
+ *
+ * - Horizontal reductions use a tree of fixed shape: every level combines
+ *   groups of 16 consecutive entries in a fixed order, which requires one
+ *   kernel launch per level (i.e. <tt>log16(n)</tt> launches).
+ *
+ * - Scatter-additions pre-round every contribution to a fixed-point grid that
+ *   only depends on the largest magnitude per target, accumulate them with
+ *   64-bit integer atomics (which are associative), and convert the sum back.
+ *   The result is therefore also independent of the order of the inputs. It
+ *   has about <tt>62 - log2(n)</tt> significant bits relative to the largest
+ *   contribution of its target, where \c n is the number of inputs. Infinite
+ *   and NaN contributions propagate as usual.
+ *
+ * Other reductions (minima, maxima, integer and half precision arithmetic)
+ * are unaffected.
+ */
+struct DeterministicReductionScope {
+    DeterministicReductionScope(bool value = true)
+        : m_prev(detail::deterministic_reductions) {
+        detail::deterministic_reductions = value;
+    }
+
+    ~DeterministicReductionScope() { detail::deterministic_reductions = m_prev; }
+
+    DeterministicReductionScope(const DeterministicReductionScope &) = delete;
+    DeterministicReductionScope &operator=(const DeterministicReductionScope &) = delete;
+
+private:
+    bool m_prev;
+};
+
+NAMESPACE_BEGIN(detail)
+
+/// Number of entries combined by each level of \ref reduce_deterministic()
+static constexpr uint32_t DeterministicFanIn = 16;
+
+template <typename Array> Array reduce_deterministic(const Array &value, ReduceOp op) {
+    using UInt32 = uint32_array_t<Array>;
+    using Mask = mask_t<UInt32>;
+
+    Array x = value;
+    for (uint32_t n = (uint32_t) x.size(); n > 1;) {
+        uint32_t m = (n + DeterministicFanIn - 1) / DeterministicFanIn;
+        UInt32 base = arange<UInt32>(m) * DeterministicFanIn;
+
+        Array y = gather<Array>(x, base);
+        for (uint32_t k = 1; k < DeterministicFanIn; ++k) {
+            UInt32 idx = base + k;
+            Mask active = idx < n;
+            Array v = gather<Array>(x, idx, active);
+            y = op == ReduceOp::Add ? y + v : y * select(active, v, Array(1));
+        }
+
+        x = y;
+        eval(x);
+        n = m;
+    }
+
+    return x;
+}
+
+template <typename Array, typename Index, typename Mask>
+void scatter_add_deterministic(Array &dst, const Array &value,
+                               const Index &index, const Mask &mask) {
+    using Scalar  = scalar_t<Array>;
+    using UInt    = uint_array_t<Array>;
+    using Int32   = int32_array_t<Array>;
+    using Int64   = int64_array_t<Array>;
+    using UInt64  = uint64_array_t<Array>;
+    using Float64 = float64_array_t<Array>;
+
+    constexpr int Mantissa = std::numeric_limits<Scalar>::digits - 1,
+                  Bias = std::numeric_limits<Scalar>::max_exponent - 1;
+
+    size_t n = std::max({ value.size(), index.size(), mask.size() }),
+           size = dst.size();
+
+    // Sums of 'n' grid points must remain below 2^63
+    int grid_bits = 62 - (n > 1 ? (int) log2i(n - 1) + 1 : 0);
+
+    Mask finite = mask && isfinite(value);
+
+    // 1. Largest magnitude per target (the bit patterns share its ordering)
+    UInt max_bits = zeros<UInt>(size);
+    scatter_reduce(ReduceOp::Max, max_bits, reinterpret_array<UInt>(abs(value)),
+                   index, finite);
+
+    // 2. Grid spacing per target, such that all contributions are < 2^grid_bits
+    Int32 exponent = Int32(sr<Mantissa>(max_bits)),
+          p = clamp(grid_bits - (maximum(exponent, 1) - Bias + 1), -1022, 1023);
+    Float64 scale = reinterpret_array<Float64>(sl<52>(UInt64(p + 1023)));
+
+    // 3. Accumulate fixed-point contributions and non-finite values
+    Int64 acc = zeros<Int64>(size);
+    scatter_reduce(ReduceOp::Add, acc,
+                   Int64(round(Float64(value) *
+                               gather<Float64>(scale, index, finite))),
+                   index, finite);
+
+    // Order does not matter here, hence a regular scatter-add suffices
+    Array special = zeros<Array>(size);
+    {
+        DeterministicReductionScope scope(false);
+        scatter_reduce(ReduceOp::Add, special, value, index, mask && !finite);
+    }
+
+    Array result =
+        select(neq(acc, 0), Array(Float64(dst) + Float64(acc) / scale), dst);
+    dst = select(neq(special, 0), result + special, result);
+}
+
+NAMESPACE_END(detail)
+
 template <typename Array>
 Array block_sum(const Array &array, size_t block_size) {
     if constexpr (array_depth_v<Array> > 1) {
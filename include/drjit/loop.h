@@ -33,6 +33,9 @@ struct Loop<Mask, enable_if_t<std::is_scalar_v<Mask>>> {
     template <typename... Args> Loop(const char*, Args&...) { }
     void set_max_iterations(uint32_t) { }
     void set_eval_stride(uint32_t) { }
+    void set_unroll(uint32_t) { }
+    void set_optimize(bool) { }
+    void set_compaction(float, uint32_t = 1) { }
 };
 
 /// Array case, expands into a symbolic or wavefront-style loop
@@ -43,6 +46,7 @@ struct Loop<Mask, enable_if_jit_array_t<Mask>> {
 
     using Float32 = float32_array_t<detached_t<Mask>>;
     using Float64 = float64_array_t<detached_t<Mask>>;
+    using UInt32 = uint32_array_t<detached_t<Mask>>;
 
     Loop(const Loop &) = delete;
     Loop(Loop &&) = delete;
@@ -81,15 +85,14 @@ struct Loop<Mask, enable_if_jit_array_t<Mask>> {
         for (size_t i = 0; i < m_indices_prev.size(); ++i)
             jit_var_dec_ref(m_indices_prev[i]);
 
-        if constexpr (IsDiff) {
-            for (size_t i = 0; i < m_indices_ad_prev.size(); ++i) {
-                uint32_t index = m_indices_ad_prev[i];
+        for (size_t i = 0; i < m_indices_unroll.size(); ++i)
+            jit_var_dec_ref(m_indices_unroll[i]);
 
-                if (m_ad_float_precision == 32)
-                    detail::ad_dec_ref_impl<Float32>(index);
-                else if (m_ad_float_precision == 64)
-                    detail::ad_dec_ref_impl<Float64>(index);
-            }
+        for (size_t i = 0; i < m_indices_full.size(); ++i)
+            jit_var_dec_ref(m_indices_full[i]);
+
+        if constexpr (IsDiff) {
+            ad_dec_ref_n(m_indices_ad_prev.size(), m_indices_ad_prev.data());
 
             if (m_ad_scope) {
                 m_ad_scope = false;
@@ -212,6 +215,73 @@ struct Loop<Mask, enable_if_jit_array_t<Mask>> {
         m_eval_stride = stride;
     }
 
+    /**
+     * \brief Emit several copies of the loop body per iteration
+     *
+     * Only applies to recorded loops. The body of the loop is traced \c
+     * factor times in a row, which amortizes the overheads of the loop
+     * header (branch, \c phi nodes) over several steps of short loop bodies.
+     * After each copy, the loop condition is evaluated again, and lanes for
+     * which it became \c false are masked in the remaining copies (i.e. their
+     * loop state is preserved and their side effects are disabled).
+     */
+    void set_unroll(uint32_t factor) {
+        if (m_state > 1)
+            jit_raise("Loop(\"%s\"): set_unroll() can only be called "
+                      "before entering the loop!", m_name.get());
+        if (factor == 0)
+            jit_raise("Loop(\"%s\"): the unroll factor must be nonzero!",
+                      m_name.get());
+
+        m_unroll = factor;
+    }
+
+    /**
+     * \brief Remove loop-invariant variables from the state of this loop
+     *
+     * Only applies to recorded loops. When a loop variable is unchanged after
+     * the first recording of the loop body, the body is recorded a second
+     * time with \ref JitFlag::LoopOptimize enabled for this loop, which
+     * removes the variable from the loop state. Note that this runs the loop
+     * body (including side effects of the surrounding program, such as
+     * Python code) twice. Setting \ref JitFlag::LoopOptimize globally enables
+     * this for all loops.
+     */
+    void set_optimize(bool value) {
+        if (m_state > 1)
+            jit_raise("Loop(\"%s\"): set_optimize() can only be called "
+                      "before entering the loop!", m_name.get());
+
+        m_optimize_invariant = value;
+    }
+
+    /**
+     * \brief Shrink the loop state when many lanes have terminated
+     *
+     * Only applies to wavefront-style loops. Every \c stride evaluated
+     * iterations, the loop counts its active lanes. If they represent less
+     * than the fraction \c threshold of the current wavefront, the loop state
+     * is compressed to the active lanes via \ref compress() and \ref gather(),
+     * so that subsequent iterations process fewer lanes. The final state is
+     * scattered back into arrays of the original size when the loop ends.
+     *
+     * For this to work, all per-lane values accessed by the loop body (and the
+     * loop condition) must be loop variables. Loops with differentiable
+     * state, and loops within masked regions (e.g. vectorized method calls),
+     * aren't compacted.
+     */
+    void set_compaction(float threshold, uint32_t stride = 1) {
+        if (m_state > 1)
+            jit_raise("Loop(\"%s\"): set_compaction() can only be called "
+                      "before entering the loop!", m_name.get());
+        if (stride == 0)
+            jit_raise("Loop(\"%s\"): the compaction stride must be nonzero!",
+                      m_name.get());
+
+        m_compact_threshold = threshold;
+        m_compact_stride = stride;
+    }
+
     bool operator()(const Mask &cond_) {
         // Determine wavefront size
         if (m_size <= 1) {
@@ -264,17 +334,37 @@ protected:
                 // Start recording side effects
                 m_jit_state.begin_recording();
 
+                m_cond_head = cond;
+                m_unroll_cond = cond;
                 m_state++;
 
                 return true;
 
             case 2:
             case 3:
+                if (m_unroll > 1 && unroll_step(cond))
+                    return true;
+
+                /* Loop variables that are still the placeholders created at
+                   the top of the loop body are invariant. If requested via
+                   set_optimize(), enable JitFlag::LoopOptimize for this loop
+                   in that case, so that they are removed from the loop state
+                   while recording the body a second time. */
+                if (m_state == 2) {
+                    m_optimize = jit_flag(JitFlag::LoopOptimize);
+                    for (uint32_t i = 0; i < m_indices.size() &&
+                                         m_optimize_invariant && !m_optimize; ++i)
+                        m_optimize = *m_indices[i] == m_indices_prev[i];
+                }
+
                 // Rewrite loop state variables (3)
-                rv = jit_var_loop(m_name.get(), m_loop_init, m_loop_cond,
-                                  m_indices.size(), m_indices_prev.data(),
-                                  m_indices.data(), m_jit_state.checkpoint(),
-                                  m_state == 2);
+                {
+                    scoped_set_flag optimize(JitFlag::LoopOptimize, m_optimize);
+                    rv = jit_var_loop(m_name.get(), m_loop_init, m_loop_cond,
+                                      m_indices.size(), m_indices_prev.data(),
+                                      m_indices.data(), m_jit_state.checkpoint(),
+                                      m_state == 2);
+                }
 
                 m_state++;
 
@@ -285,6 +375,7 @@ protected:
                     jit_log(::LogLevel::InfoSym,
                             "Loop(\"%s\"): ----- recording loop body *again* ------", m_name.get());
                     m_jit_state.clear_mask_if_set();
+                    m_unroll_cond = m_cond_head;
                     return true;
                 } else {
                     jit_log(::LogLevel::InfoSym,
@@ -299,6 +390,9 @@ protected:
                     m_jit_state.clear_mask_if_set();
                     jit_var_mark_side_effect(rv);
 
+                    m_cond_head = Mask();
+                    m_unroll_cond = Mask();
+
                     if constexpr (IsDiff) {
                         if (m_ad_scope) {
                             m_ad_scope = false;
@@ -320,6 +414,48 @@ protected:
         return false;
     }
 
+    /**
+     * \brief Called after each copy of the body of an unrolled loop. Returns
+     * \c true when another copy should be traced.
+     */
+    bool unroll_step(const Mask &cond) {
+        // Lanes that were inactive in the last copy keep their previous state
+        if (m_unroll_index > 0) {
+            for (uint32_t i = 0; i < m_indices.size(); ++i) {
+                uint32_t i1 = *m_indices[i], i2 = m_indices_unroll[i];
+                // Keep invariant loop variables recognizable (see cond_record())
+                if (i1 != i2)
+                    *m_indices[i] = jit_var_select(m_unroll_cond.index(), i1, i2);
+                else
+                    jit_var_inc_ref(i1);
+                jit_var_dec_ref(i1);
+                jit_var_dec_ref(i2);
+            }
+            m_indices_unroll.clear();
+        }
+
+        if (++m_unroll_index == m_unroll) {
+            m_unroll_index = 0;
+            m_unroll_cond = m_cond_head;
+            return false;
+        }
+
+        // Lanes that terminated in an earlier copy remain inactive
+        m_unroll_cond = m_unroll_cond & cond;
+
+        for (uint32_t i = 0; i < m_indices.size(); ++i) {
+            uint32_t index = *m_indices[i];
+            jit_var_inc_ref(index);
+            m_indices_unroll.push_back(index);
+        }
+
+        // Also mask the side effects of the next copy on the CUDA backend
+        m_jit_state.clear_mask_if_set();
+        m_jit_state.set_mask(m_unroll_cond.index());
+
+        return true;
+    }
+
     /// Unroll a loop using wavefronts
     bool cond_wavefront(const Mask &cond_) {
         Mask cond = cond_;
@@ -336,7 +472,11 @@ protected:
             // Blend with loop state from last iteration based on mask
             for (uint32_t i = 0; i < m_indices.size(); ++i) {
                 uint32_t i1 = *m_indices[i], i2 = m_indices_prev[i];
-                *m_indices[i] = jit_var_select(m_cond.index(), i1, i2);
+                // Nothing to blend if the variable is loop-invariant
+                if (i1 != i2)
+                    *m_indices[i] = jit_var_select(m_cond.index(), i1, i2);
+                else
+                    jit_var_inc_ref(i1);
                 jit_var_dec_ref(i1);
                 jit_var_dec_ref(i2);
             }
@@ -355,19 +495,19 @@ protected:
                             index_new = detail::ad_new_select<Float32>(
                                 "dr_loop", jit_var_size(*m_indices[i]),
                                 detach(m_cond), i1, i2);
-                        *m_indices_ad[i] = index_new;
-                        detail::ad_dec_ref_impl<Float32>(i1);
-                        detail::ad_dec_ref_impl<Float32>(i2);
                     } else if (m_ad_float_precision == 64) {
                         if (i1 > 0 || i2 > 0)
                             index_new = detail::ad_new_select<Float64>(
                                 "dr_loop", jit_var_size(*m_indices[i]),
                                 detach(m_cond), i1, i2);
-                        *m_indices_ad[i] = index_new;
-                        detail::ad_dec_ref_impl<Float64>(i1);
-                        detail::ad_dec_ref_impl<Float64>(i2);
                     }
+
+                    *m_indices_ad[i] = index_new;
+
+                    // Release the previous indices in bulk below
+                    m_indices_ad_prev.push_back(i1);
                 }
+                ad_dec_ref_n(m_indices_ad_prev.size(), m_indices_ad_prev.data());
                 m_indices_ad_prev.clear();
             }
         }
@@ -391,6 +531,9 @@ protected:
             do_continue = jit_var_any(cond.index());
 
         if (do_continue) {
+            if (m_compact_threshold > 0.f && do_eval)
+                compact(cond);
+
             for (uint32_t i = 0; i < m_indices.size(); ++i) {
                 uint32_t index = *m_indices[i];
                 jit_var_inc_ref(index);
@@ -398,18 +541,9 @@ protected:
             }
 
             if constexpr (IsDiff) {
-                for (uint32_t i = 0; i < m_indices_ad.size(); ++i) {
-                    if (!m_indices_ad[i]) {
-                        m_indices_ad_prev.push_back(0);
-                        continue;
-                    }
-                    uint32_t index = *m_indices_ad[i];
-                    if (m_ad_float_precision == 64)
-                        detail::ad_inc_ref_impl<Float64>(index);
-                    else if (m_ad_float_precision == 32)
-                        detail::ad_inc_ref_impl<Float32>(index);
-                    m_indices_ad_prev.push_back(index);
-                }
+                for (uint32_t i = 0; i < m_indices_ad.size(); ++i)
+                    m_indices_ad_prev.push_back(m_indices_ad[i] ? *m_indices_ad[i] : 0);
+                ad_inc_ref_n(m_indices_ad_prev.size(), m_indices_ad_prev.data());
             }
 
             m_cond = std::move(cond);
@@ -417,6 +551,9 @@ protected:
         } else {
             m_state = 4;
 
+            if (m_compact_perm.index())
+                compact_finish();
+
             if constexpr (IsDiff) {
                 if (m_ad_scope) {
                     m_ad_scope = false;
@@ -430,7 +567,120 @@ protected:
         }
     }
 
+    /// Compress the loop state to the active lanes, see set_compaction()
+    void compact(Mask &cond) {
+        if (++m_compact_counter < m_compact_stride)
+            return;
+        m_compact_counter = 0;
+
+        if constexpr (IsDiff) {
+            for (uint32_t i = 0; i < m_indices_ad.size(); ++i) {
+                if (m_indices_ad[i] && *m_indices_ad[i])
+                    return;
+            }
+        }
+
+        if (jit_var_size(cond.index()) != m_size)
+            return;
+
+        // Masks of an enclosing region have the size of the original wavefront
+        m_jit_state.clear_mask_if_set();
+        uint32_t outer_mask = jit_var_mask_peek(Backend);
+        jit_var_dec_ref(outer_mask);
+
+        UInt32 perm;
+        if (!outer_mask)
+            perm = compress(detach(cond));
+
+        uint32_t size = (uint32_t) perm.size();
+        if (outer_mask || size == 0 ||
+            (float) size >= m_compact_threshold * (float) m_size) {
+            m_jit_state.set_mask(cond.index());
+            return;
+        }
+
+        jit_log(::LogLevel::Debug,
+                "Loop(\"%s\"): compacting the loop state (%u -> %u lanes)",
+                m_name.get(), m_size, size);
+
+        if (!m_compact_perm.index()) {
+            m_size_full = m_size;
+            m_compact_perm = perm;
+            for (uint32_t i = 0; i < m_indices.size(); ++i) {
+                uint32_t index = *m_indices[i];
+                jit_var_inc_ref(index);
+                m_indices_full.push_back(index);
+            }
+        } else {
+            compact_store();
+            m_compact_perm = gather<UInt32>(m_compact_perm, perm);
+        }
+        schedule(m_compact_perm);
+
+        detached_t<Mask> always(true);
+        for (uint32_t i = 0; i < m_indices.size(); ++i) {
+            uint32_t index = *m_indices[i];
+            // Uniform variables are unaffected
+            if (jit_var_size(index) == 1)
+                continue;
+            *m_indices[i] = jit_var_gather(index, perm.index(), always.index());
+            jit_var_dec_ref(index);
+        }
+
+        cond = gather<Mask>(cond, perm);
+        m_size = size;
+        m_jit_state.set_mask(cond.index());
+    }
+
+    /// Scatter the compacted loop state into arrays of the original size
+    void compact_store() {
+        detached_t<Mask> always(true);
+        for (uint32_t i = 0; i < m_indices.size(); ++i) {
+            uint32_t value = *m_indices[i], &target = m_indices_full[i], index;
+            if (value == target)
+                continue;
+
+            if (jit_var_size(target) != m_size_full) {
+                index = jit_var_resize(target, m_size_full);
+                jit_var_dec_ref(target);
+                target = index;
+            }
+
+            index = jit_var_scatter(target, value, m_compact_perm.index(),
+                                    always.index(), ReduceOp::None);
+            jit_var_dec_ref(target);
+            target = index;
+        }
+    }
+
+    /// Restore the loop state at the original size after the last iteration
+    void compact_finish() {
+        compact_store();
+        for (uint32_t i = 0; i < m_indices.size(); ++i) {
+            jit_var_dec_ref(*m_indices[i]);
+            *m_indices[i] = m_indices_full[i];
+        }
+        m_indices_full.clear();
+        m_compact_perm = UInt32();
+        m_size = m_size_full;
+    }
+
 protected:
+    /// Bulk reference count updates of AD variables (wavefront mode)
+    void ad_inc_ref_n(size_t n, const uint32_t *indices) {
+        if (m_ad_float_precision == 32)
+            detail::ad_inc_ref_n_impl<Float32>(n, indices);
+        else if (m_ad_float_precision == 64)
+            detail::ad_inc_ref_n_impl<Float64>(n, indices);
+    }
+
+    void ad_dec_ref_n(size_t n, const uint32_t *indices) {
+        if (m_ad_float_precision == 32)
+            detail::ad_dec_ref_n_impl<Float32>(n, indices);
+        else if (m_ad_float_precision == 64)
+            detail::ad_dec_ref_n_impl<Float64>(n, indices);
+    }
+
     /// Is the loop being recorded?
     bool m_record;
 
@@ -468,6 +718,27 @@ protected:
     /// Index of the symbolic loop state machine
     uint32_t m_state = 0;
 
+    /// Eliminate invariant loop variables (see cond_record())
+    bool m_optimize = false;
+
+    /// Eliminate them even without JitFlag::LoopOptimize (see set_optimize())
+    bool m_optimize_invariant = false;
+
+    /// Number of copies of the loop body per iteration (see set_unroll())
+    uint32_t m_unroll = 1;
+
+    /// Index of the copy of the loop body that is being recorded
+    uint32_t m_unroll_index = 0;
+
+    /// Loop condition at the top of the loop body
+    Mask m_cond_head;
+
+    /// Lanes that are active in the current copy of the loop body
+    Mask m_unroll_cond;
+
+    /// Loop state before the current copy of the loop body
+    dr_vector<uint32_t> m_indices_unroll;
+
     // --------------- Wavefront mode ---------------
 
     /// Pointers to loop variable indices (AD handles)
@@ -487,6 +758,18 @@ protected:
 
     /// Stashed mask variable from the previous iteration
     Mask m_cond;
+
+    /// Loop state compaction, see set_compaction()
+    float m_compact_threshold = 0.f;
+    uint32_t m_compact_stride = 1;
+    uint32_t m_compact_counter = 0;
+    uint32_t m_size_full = 0;
+
+    /// Original lane index of each lane of the compacted loop state
+    UInt32 m_compact_perm;
+
+    /// Loop state at the original size (lanes that were compacted away)
+    dr_vector<uint32_t> m_indices_full;
 };
 
 NAMESPACE_END(drjit)
@@ -1591,4 +1591,369 @@ template <typename Value> Value lgamma(Value x_) {
 /// Gamma function
 template <typename Value> Value tgamma(Value x) { return exp(lgamma(x)); }
 
+
+// -----------------------------------------------------------------------
+//! @{ \name Fast approximate transcendental functions
+// -----------------------------------------------------------------------
+
+/**
+ * The functions in the ``drjit::fast`` namespace trade accuracy for speed by
+ * using shorter minimax polynomial fits and cheaper argument reduction. The
+ * template parameter selects one of two accuracy tiers:
+ *
+ *  - ``fast::Accuracy::Medium``: at most a few ULP of error (single precision)
+ *  - ``fast::Accuracy::Low``: relative error below 1e-4
+ *
+ * The error bounds listed for each function refer to single precision.
+ * Double precision arguments are supported and achieve a comparable relative
+ * accuracy (i.e., that of single precision). Arrays that provide their own
+ * implementation (e.g. JIT and AD arrays) dispatch to it as usual.
+ */
+NAMESPACE_BEGIN(fast)
+
+enum class Accuracy { Medium, Low };
+
+NAMESPACE_BEGIN(detail)
+
+template <bool Sin, bool Cos, typename Value>
+DRJIT_INLINE void sincos_low(const Value &x, Value *s_out, Value *c_out) {
+    using Scalar = scalar_t<Value>;
+    constexpr bool Single = std::is_same_v<Scalar, float>;
+    using IntArray = int_array_t<Value>;
+    using Int = scalar_t<IntArray>;
+    using Mask = mask_t<Value>;
+    DRJIT_MARK_USED(s_out);
+    DRJIT_MARK_USED(c_out);
+    static_assert(std::is_floating_point_v<Scalar>,
+                  "fast::sin()/cos(): function requires a floating point argument!");
+
+    // Same argument reduction as drjit::sin() and drjit::cos()
+    Value xa = abs(x);
+    IntArray j = IntArray(xa * Scalar(1.2732395447351626862));
+    j = (j + Int(1)) & Int(~1u);
+    Value y = Value(j);
+
+    Value sign_sin, sign_cos;
+    constexpr size_t Shift = sizeof(Scalar) * 8 - 3;
+    if constexpr (Sin)
+        sign_sin = drjit::detail::xor_(reinterpret_array<Value>(sl<Shift>(j)), x);
+    if constexpr (Cos)
+        sign_cos = reinterpret_array<Value>(sl<Shift>(~(j - Int(2))));
+    DRJIT_MARK_USED(sign_sin);
+    DRJIT_MARK_USED(sign_cos);
+
+    if constexpr (Single) {
+        y = xa - y * Scalar(0.78515625)
+               - y * Scalar(2.4187564849853515625e-4)
+               - y * Scalar(3.77489497744594108e-8);
+    } else {
+        y = xa - y * Scalar(7.85398125648498535156e-1)
+               - y * Scalar(3.77489470793079817668e-8)
+               - y * Scalar(2.69515142907905952645e-15);
+    }
+
+    Value z = sqr(y);
+    z = drjit::detail::or_(z, eq(xa, Infinity<Value>));
+
+    // Shorter polynomials, max rel. err on [0, pi/4]: 1.9e-6 (sin), 8.2e-8 (cos)
+    Value s = estrin(z, -0x1.554428p-3, 0x1.0b7e92p-7) * z,
+          c = estrin(z, 0x1.55499ap-5, -0x1.65caf8p-10) * z;
+
+    s = fmadd(s, y, y);
+    c = fmadd(c, z, fmadd(z, Scalar(-0.5), Scalar(1)));
+
+    Mask polymask = eq(j & Int(2), zeros<IntArray>());
+
+    if constexpr (Sin)
+        *s_out = mulsign(select(polymask, s, c), sign_sin);
+    if constexpr (Cos)
+        *c_out = mulsign(select(polymask, c, s), sign_cos);
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Fast sine approximation
+ *
+ * The medium tier is identical to \ref drjit::sin(), whose polynomial is
+ * already minimal for single precision.
+ *
+ * Error of the low tier in [-8192, 8192]: max abs. err = 1.4e-06,
+ * max rel. err = 2.9e-05
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value sin(const Value &x) {
+    if constexpr (Acc == Accuracy::Medium ||
+                  is_detected_v<drjit::detail::has_sin, Value>) {
+        return drjit::sin(x);
+    } else {
+        Value result;
+        detail::sincos_low<true, false>(x, &result, (Value *) nullptr);
+        return result;
+    }
+}
+
+/**
+ * \brief Fast cosine approximation
+ *
+ * The medium tier is identical to \ref drjit::cos().
+ *
+ * Error of the low tier in [-8192, 8192]: max abs. err = 1.4e-06,
+ * max rel. err = 8.0e-05 (dominated by the argument reduction)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value cos(const Value &x) {
+    if constexpr (Acc == Accuracy::Medium ||
+                  is_detected_v<drjit::detail::has_cos, Value>) {
+        return drjit::cos(x);
+    } else {
+        Value result;
+        detail::sincos_low<false, true>(x, (Value *) nullptr, &result);
+        return result;
+    }
+}
+
+/// Fast joint sine and cosine approximation, see \ref fast::sin()
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+std::pair<Value, Value> sincos(const Value &x) {
+    if constexpr (Acc == Accuracy::Medium ||
+                  is_detected_v<drjit::detail::has_sincos, Value>) {
+        return drjit::sincos(x);
+    } else {
+        Value result_s, result_c;
+        detail::sincos_low<true, true>(x, &result_s, &result_c);
+        return { result_s, result_c };
+    }
+}
+
+/**
+ * \brief Fast natural exponential function approximation
+ *
+ * Error in [-20, 30]: max rel. err = 2.6 ulp (medium), 6.4e-06 (low)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value exp(const Value &x) {
+    if constexpr (is_detected_v<drjit::detail::has_exp, Value>) {
+        return x.exp_();
+    } else {
+        static_assert(!is_special_v<Value>,
+                      "fast::exp(): requires a regular scalar/array argument!");
+        using Scalar = scalar_t<Value>;
+        constexpr bool Single = std::is_same_v<Scalar, float>;
+        using Mask = mask_t<Value>;
+
+        const Scalar range =
+            Scalar(Single ? 88.3762588501 : 709.43613930310391424428);
+
+        Mask mask_overflow  = x >  range,
+             mask_underflow = x < -range;
+
+        // e^x = e^y 2^n, where |y| <= log(2) / 2
+        Value n = floor(fmadd(InvLogTwo<Scalar>, x, Scalar(0.5))), y;
+
+        if constexpr (Acc == Accuracy::Medium)
+            y = fmadd(n, Scalar(2.12194440e-4), fmadd(n, Scalar(-0.693359375), x));
+        else
+            y = fmadd(n, -LogTwo<Scalar>, x);
+
+        // e^y = 1 + y + y^2 P(y)
+        Value p;
+        if constexpr (Acc == Accuracy::Medium)
+            p = estrin(y, 0x1.fffdfcp-2, 0x1.5557aep-3, 0x1.5729fp-5, 0x1.106284p-7);
+        else
+            p = estrin(y, 0x1.0006b4p-1, 0x1.571caap-3, 0x1.5225b6p-5);
+
+        Value z = fmadd(p, sqr(y), y + Scalar(1));
+
+        return select(mask_overflow, Infinity<Value>,
+                      select(mask_underflow, zeros<Value>(), ldexp(z, n)));
+    }
+}
+
+/**
+ * \brief Fast base-2 exponential function approximation
+ *
+ * Error in [-20, 30]: max rel. err = 2.5 ulp (medium), 2.9e-06 (low)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value exp2(const Value &x) {
+    if constexpr (is_detected_v<drjit::detail::has_exp2, Value>) {
+        return x.exp2_();
+    } else {
+        static_assert(!is_special_v<Value>,
+                      "fast::exp2(): requires a regular scalar/array argument!");
+        using Scalar = scalar_t<Value>;
+        constexpr bool Single = std::is_same_v<Scalar, float>;
+        using Mask = mask_t<Value>;
+
+        const Scalar range = Scalar(Single ? 127 : 1024);
+
+        Mask mask_overflow  = x >  range,
+             mask_underflow = x < -range;
+
+        // 2^x = 2^y 2^n, where |y| <= 1/2
+        Value n = floor(x + Scalar(0.5)), y = x - n;
+
+        // 2^y = 1 + y P(y)
+        Value p;
+        if constexpr (Acc == Accuracy::Medium)
+            p = estrin(y, 0x1.62e42ap-1, 0x1.ebf9bcp-3, 0x1.c6b752p-5,
+                          0x1.3cea88p-7, 0x1.5bba14p-10);
+        else
+            p = estrin(y, 0x1.62e12cp-1, 0x1.ec0378p-3, 0x1.c9fc46p-5,
+                          0x1.3a02ccp-7);
+
+        Value z = fmadd(y, p, Scalar(1));
+
+        return select(mask_overflow, Infinity<Value>,
+                      select(mask_underflow, zeros<Value>(), ldexp(z, n)));
+    }
+}
+
+/**
+ * \brief Fast natural logarithm approximation
+ *
+ * Error in [1e-20, 1000]: max rel. err = 1.1 ulp (medium), 1.3e-05 (low)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value log(const Value &x) {
+    if constexpr (is_detected_v<drjit::detail::has_log, Value>) {
+        return x.log_();
+    } else {
+        static_assert(!is_special_v<Value>,
+                      "fast::log(): requires a regular scalar/array argument!");
+        using Scalar = scalar_t<Value>;
+        using Mask = mask_t<Value>;
+
+        Mask valid_mask = x >= Scalar(0);
+
+        auto [xm, e] = frexp(x);
+
+        Mask mask_ge_inv_sqrt2 = xm >= InvSqrtTwo<Scalar>;
+        masked(e, mask_ge_inv_sqrt2) += Scalar(1);
+        xm += drjit::detail::andnot_(xm, mask_ge_inv_sqrt2) - Scalar(1);
+
+        // log(1+x) = x - .5x**2 + x**3 P(x)
+        Value y;
+        if constexpr (Acc == Accuracy::Medium)
+            y = estrin(xm, 0x1.5556d8p-2, -0x1.000382p-2, 0x1.98d7f2p-3,
+                          -0x1.538248p-3, 0x1.317458p-3, -0x1.2432c2p-3,
+                           0x1.645ebcp-4);
+        else
+            y = estrin(xm, 0x1.54d7dep-2, -0x1.02824p-2, 0x1.bdfbaep-3,
+                          -0x1.2adadep-3);
+
+        Value z = sqr(xm);
+        y *= xm * z;
+        y = fmadd(e, Scalar(-2.121944400546905827679e-4), y);
+
+        Value r = xm + fmadd(Scalar(-.5), z, y);
+        r = fmadd(e, Scalar(0.693359375), r);
+
+        const Scalar n_inf(-Infinity<Scalar>),
+                     p_inf( Infinity<Scalar>);
+
+        masked(r, eq(x, p_inf)) = p_inf;
+        masked(r, eq(x, Scalar(0))) = n_inf;
+
+        return drjit::detail::or_(r, !valid_mask);
+    }
+}
+
+/// Fast base-2 logarithm approximation, see \ref fast::log()
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value log2(const Value &x) {
+    if constexpr (is_detected_v<drjit::detail::has_log2, Value>)
+        return x.log2_();
+    else
+        return fast::log<Acc>(x) * InvLogTwo<scalar_t<Value>>;
+}
+
+/**
+ * \brief Fast error function approximation
+ *
+ * Error in [-6, 6]: max rel. err = 3.6 ulp (medium), 2.8e-05 (low)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value erf(const Value &x) {
+    if constexpr (is_detected_v<drjit::detail::has_erf, Value>) {
+        return x.erf_();
+    } else {
+        Value xa = abs(x), x2 = sqr(x), c0, c1;
+
+        // erf(x) = x * c0(x^2) on [0, 1], 1 - 2^(x * c1(x)) on [1, 4]
+        if constexpr (Acc == Accuracy::Medium) {
+            c0 = estrin(x2,
+                0x1.20dd74p+0, -0x1.812672p-2,
+                0x1.ce0934p-4, -0x1.b5a334p-6,
+                0x1.4246b4p-8, -0x1.273facp-11);
+
+            c1 = estrin(xa,
+                -0x1.a030fap+0, -0x1.d9c894p-1,
+                -0x1.200f54p-3,  0x1.a29b9ep-6,
+                -0x1.212438p-9);
+        } else {
+            c0 = estrin(x2,
+                0x1.20db6p+0,  -0x1.8023ccp-2,
+                0x1.b9afcep-4, -0x1.2ceeb8p-6);
+
+            c1 = estrin(xa,
+                -0x1.96196ap+0, -0x1.05742ap+0,
+                -0x1.f1150cp-5);
+        }
+
+        Value xb = 1.f - fast::exp2<Acc>(c1 * xa);
+        return select(
+            xa < 1, x * c0,
+            copysign(select(isfinite(xb) && xa < 4.f, xb, 1.f), x));
+    }
+}
+
+/**
+ * \brief Fast inverse error function approximation
+ *
+ * Error in (-1, 1): max rel. err = 5.6 ulp (medium), 3.5e-05 (low)
+ */
+template <Accuracy Acc = Accuracy::Medium, typename Value>
+Value erfinv(const Value &x) {
+    Value w = -fast::log<Acc>((Value(1.f) - x) * (Value(1.f) + x));
+
+    Value w1 = w - 2.5f;
+    Value w2 = sqrt(w) - 3.f;
+
+    Value p1, p2;
+    if constexpr (Acc == Accuracy::Medium) {
+        p1 = estrin(w1,
+             1.50140941,     0.246640727,
+            -0.00417768164, -0.00125372503,
+             0.00021858087, -4.39150654e-06,
+            -3.5233877e-06,  3.43273939e-07,
+             2.81022636e-08);
+
+        p2 = estrin(w2,
+             2.83297682,     1.00167406,
+             0.00943887047, -0.0076224613,
+             0.00573950773, -0.00367342844,
+             0.00134934322,  0.000100950558,
+            -0.000200214257);
+    } else {
+        p1 = estrin(w1,
+             0x1.805a78p+0,  0x1.f92d6cp-3,
+            -0x1.0c72bp-8,  -0x1.4de3c2p-10,
+             0x1.8487a4p-13);
+
+        p2 = estrin(w2,
+             0x1.6a9ecep+1,  0x1.009378p+0,
+             0x1.3c48dcp-7, -0x1.611952p-7,
+             0x1.7d753cp-8);
+    }
+
+    return select(w < 5.f, p1, p2) * x;
+}
+
+NAMESPACE_END(fast)
+
+//! @}
+// -----------------------------------------------------------------------
+
 NAMESPACE_END(drjit)
@@ -13,7 +13,10 @@
 
 #pragma once
 
+#define DRJIT_MATRIX_H
+
 #include <drjit/packet.h>
+#include <tuple>
 
 NAMESPACE_BEGIN(drjit)
 
@@ -258,7 +261,7 @@ Array transpose(const Array &a) {
             }
         #endif
 
-        #if defined(DRJIT_ARM_NEON)
+        #if defined(DRJIT_ARM_NEON) && defined(DRJIT_ENABLE_NEON)
             if constexpr (std::is_same_v<value_t<Column>, float> && Size == 3) {
                 float32x4x2_t v01 = vtrnq_f32(a.entry(0).m, a.entry(1).m);
                 float32x4x2_t v23 = vtrnq_f32(a.entry(2).m, a.entry(2).m);
@@ -447,19 +450,497 @@ template <typename T> Matrix<T, 4> inverse(const Matrix<T, 4> &m) {
     return transpose(inverse_transpose(m));
 }
 
+/**
+ * \brief LU decomposition with partial pivoting
+ *
+ * Returns the factors packed into one matrix (the unit diagonal of \c L is
+ * implicit) along with the row permutation: row \c i of the factorization
+ * corresponds to row <tt>perm[i]</tt> of \c A. When \c T is a packet or JIT
+ * array, every lane factors its own matrix and selects its own pivots. Row
+ * exchanges are performed using masked selects, hence all loops have trip
+ * counts that are known at compile time and unroll completely.
+ */
+template <typename T, size_t Size>
+std::pair<Matrix<T, Size>, Array<uint32_array_t<T>, Size>>
+lu_decomp(const Matrix<T, Size> &A) {
+    using UInt32 = uint32_array_t<T>;
+    using UInt32Mask = mask_t<UInt32>;
+
+    Matrix<T, Size> LU = A;
+    Array<UInt32, Size> perm;
+    for (size_t i = 0; i < Size; ++i)
+        perm.entry(i) = scalar_t<UInt32>(i);
+
+    for (size_t k = 0; k < Size; ++k) {
+        // Move the entry of largest magnitude in column k onto the diagonal
+        for (size_t r = k + 1; r < Size; ++r) {
+            mask_t<T> swap = abs(LU(r, k)) > abs(LU(k, k));
+            for (size_t j = 0; j < Size; ++j) {
+                T a = LU(k, j), b = LU(r, j);
+                LU(k, j) = select(swap, b, a);
+                LU(r, j) = select(swap, a, b);
+            }
+            UInt32 a = perm.entry(k), b = perm.entry(r);
+            perm.entry(k) = select(UInt32Mask(swap), b, a);
+            perm.entry(r) = select(UInt32Mask(swap), a, b);
+        }
+
+        T inv_pivot = rcp(LU(k, k));
+        for (size_t i = k + 1; i < Size; ++i) {
+            T l = LU(i, k) * inv_pivot;
+            LU(i, k) = l;
+            for (size_t j = k + 1; j < Size; ++j)
+                LU(i, j) = fnmadd(l, LU(k, j), LU(i, j));
+        }
+    }
+
+    return { LU, perm };
+}
+
+/// Solve <tt>A x = b</tt> given the LU decomposition computed by \ref lu_decomp()
+template <typename T, size_t Size>
+Array<T, Size> lu_solve(const Matrix<T, Size> &LU,
+                        const Array<uint32_array_t<T>, Size> &perm,
+                        const Array<T, Size> &b) {
+    Array<T, Size> x;
+
+    // Forward substitution with the permuted right hand side
+    for (size_t i = 0; i < Size; ++i) {
+        T value = b.entry(0);
+        for (size_t j = 1; j < Size; ++j)
+            value = select(mask_t<T>(eq(perm.entry(i), scalar_t<uint32_array_t<T>>(j))),
+                           b.entry(j), value);
+        for (size_t j = 0; j < i; ++j)
+            value = fnmadd(LU(i, j), x.entry(j), value);
+        x.entry(i) = value;
+    }
+
+    // Backward substitution
+    for (size_t i = Size; i-- > 0; ) {
+        T value = x.entry(i);
+        for (size_t j = i + 1; j < Size; ++j)
+            value = fnmadd(LU(i, j), x.entry(j), value);
+        x.entry(i) = value / LU(i, i);
+    }
+
+    return x;
+}
+
+/// Solve the linear system <tt>A x = b</tt> using an LU decomposition with partial pivoting
+template <typename T, size_t Size>
+Array<T, Size> solve(const Matrix<T, Size> &A, const Array<T, Size> &b) {
+    auto [LU, perm] = lu_decomp(A);
+    return lu_solve(LU, perm, b);
+}
+
+/**
+ * \brief Cholesky decomposition <tt>A = L L^T</tt> of a symmetric positive
+ * definite matrix
+ *
+ * Only the lower triangle of \c A is accessed. Lanes whose matrix is not
+ * positive definite produce NaN entries.
+ */
+template <typename T, size_t Size>
+Matrix<T, Size> cholesky(const Matrix<T, Size> &A) {
+    Matrix<T, Size> L = zeros<Matrix<T, Size>>();
+
+    for (size_t j = 0; j < Size; ++j) {
+        T diag = A(j, j);
+        for (size_t k = 0; k < j; ++k)
+            diag = fnmadd(L(j, k), L(j, k), diag);
+        diag = sqrt(diag);
+        L(j, j) = diag;
+
+        T inv_diag = rcp(diag);
+        for (size_t i = j + 1; i < Size; ++i) {
+            T value = A(i, j);
+            for (size_t k = 0; k < j; ++k)
+                value = fnmadd(L(i, k), L(j, k), value);
+            L(i, j) = value * inv_diag;
+        }
+    }
+
+    return L;
+}
+
+/// Solve <tt>A x = b</tt> given the Cholesky factor computed by \ref cholesky()
+template <typename T, size_t Size>
+Array<T, Size> cholesky_solve(const Matrix<T, Size> &L, const Array<T, Size> &b) {
+    Array<T, Size> x;
+
+    for (size_t i = 0; i < Size; ++i) {
+        T value = b.entry(i);
+        for (size_t j = 0; j < i; ++j)
+            value = fnmadd(L(i, j), x.entry(j), value);
+        x.entry(i) = value / L(i, i);
+    }
+
+    for (size_t i = Size; i-- > 0; ) {
+        T value = x.entry(i);
+        for (size_t j = i + 1; j < Size; ++j)
+            value = fnmadd(L(j, i), x.entry(j), value);
+        x.entry(i) = value / L(i, i);
+    }
+
+    return x;
+}
+
+/**
+ * \brief QR decomposition <tt>A = Q R</tt> using Householder reflections
+ *
+ * Returns the orthogonal matrix \c Q and the upper triangular matrix \c R.
+ */
+template <typename T, size_t Size>
+std::pair<Matrix<T, Size>, Matrix<T, Size>> qr_decomp(const Matrix<T, Size> &A) {
+    Matrix<T, Size> Q = identity<Matrix<T, Size>>(), R = A;
+
+    for (size_t k = 0; k + 1 < Size; ++k) {
+        T norm2 = zeros<T>();
+        for (size_t i = k; i < Size; ++i)
+            norm2 = fmadd(R(i, k), R(i, k), norm2);
+
+        // Reflect column k onto 'alpha * e_k', choosing the sign that avoids cancellation
+        T alpha = -mulsign(sqrt(norm2), R(k, k));
+
+        T v[Size];
+        v[k] = R(k, k) - alpha;
+        for (size_t i = k + 1; i < Size; ++i)
+            v[i] = R(i, k);
+
+        T v_norm2 = 2.f * fnmadd(alpha, R(k, k), norm2),
+          beta = select(v_norm2 > 0.f, 2.f / v_norm2, T(0.f));
+
+        R(k, k) = alpha;
+        for (size_t i = k + 1; i < Size; ++i)
+            R(i, k) = zeros<T>();
+
+        for (size_t j = k + 1; j < Size; ++j) {
+            T dot = zeros<T>();
+            for (size_t i = k; i < Size; ++i)
+                dot = fmadd(v[i], R(i, j), dot);
+            dot *= beta;
+            for (size_t i = k; i < Size; ++i)
+                R(i, j) = fnmadd(dot, v[i], R(i, j));
+        }
+
+        for (size_t r = 0; r < Size; ++r) {
+            T dot = zeros<T>();
+            for (size_t i = k; i < Size; ++i)
+                dot = fmadd(Q(r, i), v[i], dot);
+            dot *= beta;
+            for (size_t i = k; i < Size; ++i)
+                Q(r, i) = fnmadd(dot, v[i], Q(r, i));
+        }
+    }
+
+    return { Q, R };
+}
+
+/// Solve <tt>A x = b</tt> given the QR decomposition computed by \ref qr_decomp()
+template <typename T, size_t Size>
+Array<T, Size> qr_solve(const Matrix<T, Size> &Q, const Matrix<T, Size> &R,
+                        const Array<T, Size> &b) {
+    Array<T, Size> x;
+
+    for (size_t i = 0; i < Size; ++i) {
+        T value = zeros<T>();
+        for (size_t j = 0; j < Size; ++j)
+            value = fmadd(Q(j, i), b.entry(j), value);
+        x.entry(i) = value;
+    }
+
+    for (size_t i = Size; i-- > 0; ) {
+        T value = x.entry(i);
+        for (size_t j = i + 1; j < Size; ++j)
+            value = fnmadd(R(i, j), x.entry(j), value);
+        x.entry(i) = value / R(i, i);
+    }
+
+    return x;
+}
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Cyclic Jacobi eigenvalue iteration for symmetric matrices
+ *
+ * Every sweep annihilates each off-diagonal entry once using a plane rotation
+ * computed in closed form. Lanes whose entry is already zero apply the
+ * identity, so there are no branches. A single sweep diagonalizes a 2x2
+ * matrix exactly. Eigenvalues are returned in ascending order, with the
+ * eigenvectors in the corresponding columns.
+ */
+template <typename T, size_t Size>
+std::pair<Array<T, Size>, Matrix<T, Size>>
+eig_sym_jacobi(Matrix<T, Size> M, size_t sweeps) {
+    Matrix<T, Size> V = drjit::identity<Matrix<T, Size>>();
+
+    for (size_t it = 0; it < sweeps; ++it) {
+        for (size_t p = 0; p + 1 < Size; ++p) {
+            for (size_t q = p + 1; q < Size; ++q) {
+                T a_pq  = M(p, q),
+                  theta = (M(q, q) - M(p, p)) / (2.f * a_pq),
+                  t     = mulsign(rcp(abs(theta) + sqrt(fmadd(theta, theta, 1.f))), theta);
+
+                t = select(neq(a_pq, 0.f), t, T(0.f));
+                T c = rsqrt(fmadd(t, t, 1.f)), s = t * c;
+
+                for (size_t k = 0; k < Size; ++k) {
+                    T m_kp = M(k, p), m_kq = M(k, q);
+                    M(k, p) = fmsub(c, m_kp, s * m_kq);
+                    M(k, q) = fmadd(s, m_kp, c * m_kq);
+                }
+
+                for (size_t k = 0; k < Size; ++k) {
+                    T m_pk = M(p, k), m_qk = M(q, k);
+                    M(p, k) = fmsub(c, m_pk, s * m_qk);
+                    M(q, k) = fmadd(s, m_pk, c * m_qk);
+                }
+
+                M(p, q) = M(q, p) = zeros<T>();
+
+                for (size_t k = 0; k < Size; ++k) {
+                    T v_kp = V(k, p), v_kq = V(k, q);
+                    V(k, p) = fmsub(c, v_kp, s * v_kq);
+                    V(k, q) = fmadd(s, v_kp, c * v_kq);
+                }
+            }
+        }
+    }
+
+    Array<T, Size> lambda;
+    for (size_t i = 0; i < Size; ++i)
+        lambda.entry(i) = M(i, i);
+
+    // Sorting network (odd-even transposition) that also permutes the columns of V
+    for (size_t pass = 0; pass < Size; ++pass) {
+        for (size_t i = pass % 2; i + 1 < Size; i += 2) {
+            mask_t<T> swap = lambda.entry(i) > lambda.entry(i + 1);
+            T a = lambda.entry(i), b = lambda.entry(i + 1);
+            lambda.entry(i)     = select(swap, b, a);
+            lambda.entry(i + 1) = select(swap, a, b);
+            for (size_t k = 0; k < Size; ++k) {
+                T va = V(k, i), vb = V(k, i + 1);
+                V(k, i)     = select(swap, vb, va);
+                V(k, i + 1) = select(swap, va, vb);
+            }
+        }
+    }
+
+    return { lambda, V };
+}
+
+/**
+ * \brief Compute a singular value decomposition from the eigenvectors of
+ * <tt>A^T A</tt> followed by a QR decomposition of <tt>A V</tt>
+ *
+ * The QR step yields orthonormal left singular vectors even when \c A is
+ * rank deficient ("Computing the Singular Value Decomposition of 3x3
+ * matrices with minimal branching and elementary floating point
+ * operations", McAdams et al. 2011).
+ */
+template <typename T, size_t Size>
+std::tuple<Matrix<T, Size>, Array<T, Size>, Matrix<T, Size>>
+svd_jacobi(const Matrix<T, Size> &A, size_t sweeps) {
+    Matrix<T, Size> V = eig_sym_jacobi(transpose(A) * A, sweeps).second;
+
+    // Singular values in descending order
+    for (size_t i = 0; i < Size / 2; ++i)
+        std::swap(V.entry(i), V.entry(Size - 1 - i));
+
+    auto [U, R] = qr_decomp(A * V);
+
+    Array<T, Size> S;
+    for (size_t i = 0; i < Size; ++i) {
+        S.entry(i) = abs(R(i, i));
+        U.entry(i) = mulsign(U.entry(i), R(i, i));
+    }
+
+    return { U, S, V };
+}
+
+/**
+ * \brief Reciprocal gaps <tt>1 / (value[j] - value[i])</tt> that appear in
+ * the derivatives of eigen- and singular vectors
+ *
+ * The diagonal and entries belonging to (numerically) repeated values are set
+ * to zero, where the derivative of the vectors is not defined.
+ */
+template <typename T, size_t Size>
+Matrix<T, Size> eig_gap_rcp(const Array<T, Size> &value) {
+    using Scalar = scalar_t<T>;
+    Matrix<T, Size> F = zeros<Matrix<T, Size>>();
+    for (size_t i = 0; i < Size; ++i) {
+        for (size_t j = 0; j < Size; ++j) {
+            if (i == j)
+                continue;
+            T gap = value.entry(j) - value.entry(i),
+              tol = Epsilon<Scalar> * (abs(value.entry(i)) + abs(value.entry(j)));
+            F(i, j) = select(abs(gap) > tol, rcp(gap), T(0.f));
+        }
+    }
+    return F;
+}
+
+/// Forward-mode derivative of \ref eig_sym() along the symmetric part of \c dA
+template <typename T, size_t Size>
+std::pair<Array<T, Size>, Matrix<T, Size>>
+eig_sym_fwd(const Array<T, Size> &lambda, const Matrix<T, Size> &V,
+            const Matrix<T, Size> &dA) {
+    using PlainArrayType = plain_t<Matrix<T, Size>>;
+    Matrix<T, Size> P = transpose(V) * ((dA + transpose(dA)) * .5f);
+    P = P * V;
+
+    Array<T, Size> d_lambda;
+    for (size_t i = 0; i < Size; ++i)
+        d_lambda.entry(i) = P(i, i);
+
+    Matrix<T, Size> dV =
+        V * Matrix<T, Size>(PlainArrayType(eig_gap_rcp(lambda)) * PlainArrayType(P));
+
+    return { d_lambda, dV };
+}
+
+/// Backward-mode derivative of \ref eig_sym(), which is symmetric
+template <typename T, size_t Size>
+Matrix<T, Size> eig_sym_bwd(const Array<T, Size> &lambda, const Matrix<T, Size> &V,
+                            const Array<T, Size> &grad_lambda,
+                            const Matrix<T, Size> &grad_V) {
+    using PlainArrayType = plain_t<Matrix<T, Size>>;
+    Matrix<T, Size> M(PlainArrayType(eig_gap_rcp(lambda)) *
+                      PlainArrayType(transpose(V) * grad_V));
+    for (size_t i = 0; i < Size; ++i)
+        M(i, i) += grad_lambda.entry(i);
+
+    M = V * M * transpose(V);
+    return (M + transpose(M)) * .5f;
+}
+
+/// Forward-mode derivative of \ref svd()
+template <typename T, size_t Size>
+std::tuple<Matrix<T, Size>, Array<T, Size>, Matrix<T, Size>>
+svd_fwd(const Matrix<T, Size> &U, const Array<T, Size> &S,
+        const Matrix<T, Size> &V, const Matrix<T, Size> &dA) {
+    using PlainArrayType = plain_t<Matrix<T, Size>>;
+    Matrix<T, Size> P = transpose(U) * dA * V,
+                    F = eig_gap_rcp(Array<T, Size>(S * S)),
+                    PS = P * diag(S), SP = diag(S) * P;
+
+    Array<T, Size> dS;
+    for (size_t i = 0; i < Size; ++i)
+        dS.entry(i) = P(i, i);
+
+    Matrix<T, Size>
+        dU = U * Matrix<T, Size>(PlainArrayType(F) *
+                                 PlainArrayType(PS + transpose(PS))),
+        dV = V * Matrix<T, Size>(PlainArrayType(F) *
+                                 PlainArrayType(SP + transpose(SP)));
+
+    return { dU, dS, dV };
+}
+
+/// Backward-mode derivative of \ref svd()
+template <typename T, size_t Size>
+Matrix<T, Size> svd_bwd(const Matrix<T, Size> &U, const Array<T, Size> &S,
+                        const Matrix<T, Size> &V, const Matrix<T, Size> &grad_U,
+                        const Array<T, Size> &grad_S,
+                        const Matrix<T, Size> &grad_V) {
+    using PlainArrayType = plain_t<Matrix<T, Size>>;
+    Matrix<T, Size> F = eig_gap_rcp(Array<T, Size>(S * S)),
+                    X = transpose(U) * grad_U,
+                    Y = transpose(V) * grad_V;
+
+    X = Matrix<T, Size>(PlainArrayType(F) * PlainArrayType(X - transpose(X)));
+    Y = Matrix<T, Size>(PlainArrayType(F) * PlainArrayType(Y - transpose(Y)));
+
+    Matrix<T, Size> G = X * diag(S) + diag(S) * Y;
+    for (size_t i = 0; i < Size; ++i)
+        G(i, i) += grad_S.entry(i);
+
+    return U * G * transpose(V);
+}
+
+// Differentiable versions based on custom operations, see 'matrix_autodiff.h'
+template <typename T, size_t Size>
+std::pair<Array<T, Size>, Matrix<T, Size>>
+eig_sym_ad(const Matrix<T, Size> &A, size_t sweeps);
+
+template <typename T, size_t Size>
+std::tuple<Matrix<T, Size>, Array<T, Size>, Matrix<T, Size>>
+svd_ad(const Matrix<T, Size> &A, size_t sweeps);
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Eigendecomposition <tt>A = V diag(lambda) V^T</tt> of a symmetric
+ * matrix
+ *
+ * Returns the eigenvalues in ascending order along with an orthogonal matrix
+ * whose columns hold the associated eigenvectors. The implementation runs a
+ * fixed number of cyclic Jacobi sweeps. Each lane rotates independently and
+ * there are no branches. It targets small matrices such as 2x2 (solved
+ * exactly by one sweep) and 3x3. Derivatives of differentiable types are
+ * computed analytically on the symmetric part of \c A. Derivatives of the
+ * eigenvectors vanish for repeated eigenvalues, where they are undefined.
+ */
+template <typename T, size_t Size>
+std::pair<Array<T, Size>, Matrix<T, Size>>
+eig_sym(const Matrix<T, Size> &A, size_t sweeps = (Size == 2 ? 1 : 4)) {
+    if constexpr (is_diff_v<T>)
+        return detail::eig_sym_ad(A, sweeps);
+    else
+        return detail::eig_sym_jacobi(A, sweeps);
+}
+
+/**
+ * \brief Singular value decomposition <tt>A = U diag(S) V^T</tt> of a square
+ * matrix
+ *
+ * Returns the orthogonal matrices \c U and \c V along with the non-negative
+ * singular values in descending order. The implementation runs \ref
+ * eig_sym() on <tt>A^T A</tt>, followed by a QR decomposition. It is
+ * branchless, vectorizes across lanes, and is differentiable analogously to
+ * \ref eig_sym().
+ */
+template <typename T, size_t Size>
+std::tuple<Matrix<T, Size>, Array<T, Size>, Matrix<T, Size>>
+svd(const Matrix<T, Size> &A, size_t sweeps = (Size == 2 ? 1 : 4)) {
+    if constexpr (is_diff_v<T>)
+        return detail::svd_ad(A, sweeps);
+    else
+        return detail::svd_jacobi(A, sweeps);
+}
+
+/**
+ * \brief Polar decomposition <tt>A = Q P</tt> into an orthogonal matrix \c Q
+ * and a symmetric positive semidefinite matrix \c P
+ *
+ * 2x2 and 3x3 matrices are decomposed using \ref svd(). Larger matrices run
+ * \c it steps of the scaled Newton iteration.
+ */
 template <typename T, size_t Size> std::pair<Matrix<T, Size>, Matrix<T, Size>>
 polar_decomp(const Matrix<T, Size> &A, size_t it = 10) {
-    using PlainArrayType = plain_t<Matrix<T, Size>>;
-    Matrix<T, Size> Q = A;
-    for (size_t i = 0; i < it; ++i) {
-        Matrix<T, Size> Qi = inverse_transpose(Q);
-        T gamma = sqrt(frob(Qi) / frob(Q));
-        Q = fmadd(PlainArrayType(Q), gamma * 0.5f,
-                  PlainArrayType(Qi) * (rcp(gamma) * 0.5f));
+    if constexpr (Size == 2 || Size == 3) {
+        (void) it;
+        auto [U, S, V] = svd(A);
+        return { U * transpose(V), V * diag(S) * transpose(V) };
+    } else {
+        using PlainArrayType = plain_t<Matrix<T, Size>>;
+        Matrix<T, Size> Q = A;
+        for (size_t i = 0; i < it; ++i) {
+            Matrix<T, Size> Qi = inverse_transpose(Q);
+            T gamma = sqrt(frob(Qi) / frob(Q));
+            Q = fmadd(PlainArrayType(Q), gamma * 0.5f,
+                      PlainArrayType(Qi) * (rcp(gamma) * 0.5f));
+        }
+        return { Q, transpose(Q) * A };
     }
-    return { Q, transpose(Q) * A };
 }
 
 template <typename T> using entry_t = typename T::Entry;
 
 NAMESPACE_END(drjit)
+
+#if defined(DRJIT_AUTODIFF_H)
+#  include <drjit/matrix_autodiff.h>
+#endif
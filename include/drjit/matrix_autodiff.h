@@ -0,0 +1,142 @@
+/*
+    drjit/matrix_autodiff.h -- Differentiable matrix decompositions
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/custom.h>
+#include <drjit/matrix.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/* The custom operations below return their results packed into the columns of
+   a single nested array, since CustomOp supports only one output */
+
+/// Eigenvectors in entries [0, Size), eigenvalues in entry 'Size'
+template <typename T, size_t Size>
+struct EigSymOp : CustomOp<T, Array<Array<T, Size>, Size + 1>,
+                           Matrix<T, Size>, size_t> {
+    using Output = Array<Array<T, Size>, Size + 1>;
+    using Base = CustomOp<T, Output, Matrix<T, Size>, size_t>;
+    using Matrix_ = Matrix<detached_t<T>, Size>;
+    using Vector_ = Array<detached_t<T>, Size>;
+
+    Output eval(const Matrix<T, Size> &A, const size_t &sweeps) override {
+        std::tie(m_lambda, m_V) = eig_sym_jacobi(detach(A), sweeps);
+        return pack(m_lambda, m_V);
+    }
+
+    void forward() override {
+        auto [d_lambda, dV] =
+            eig_sym_fwd(m_lambda, m_V, detach(Base::template grad_in<0>()));
+        Base::set_grad_out(pack(d_lambda, dV));
+    }
+
+    void backward() override {
+        Output grad = Base::grad_out();
+        Matrix_ grad_V;
+        for (size_t i = 0; i < Size; ++i)
+            grad_V.entry(i) = detach(grad.entry(i));
+
+        Base::template set_grad_in<0>(Matrix<T, Size>(eig_sym_bwd(
+            m_lambda, m_V, Vector_(detach(grad.entry(Size))), grad_V)));
+    }
+
+    const char *name() const override { return "eig_sym"; }
+
+private:
+    static Output pack(const Vector_ &lambda, const Matrix_ &V) {
+        Output result;
+        for (size_t i = 0; i < Size; ++i)
+            result.entry(i) = Array<T, Size>(V.entry(i));
+        result.entry(Size) = Array<T, Size>(lambda);
+        return result;
+    }
+
+    Vector_ m_lambda;
+    Matrix_ m_V;
+};
+
+/// U in entries [0, Size), V in entries [Size, 2*Size), S in entry '2*Size'
+template <typename T, size_t Size>
+struct SVDOp : CustomOp<T, Array<Array<T, Size>, 2 * Size + 1>,
+                        Matrix<T, Size>, size_t> {
+    using Output = Array<Array<T, Size>, 2 * Size + 1>;
+    using Base = CustomOp<T, Output, Matrix<T, Size>, size_t>;
+    using Matrix_ = Matrix<detached_t<T>, Size>;
+    using Vector_ = Array<detached_t<T>, Size>;
+
+    Output eval(const Matrix<T, Size> &A, const size_t &sweeps) override {
+        std::tie(m_U, m_S, m_V) = svd_jacobi(detach(A), sweeps);
+        return pack(m_U, m_S, m_V);
+    }
+
+    void forward() override {
+        auto [dU, dS, dV] =
+            svd_fwd(m_U, m_S, m_V, detach(Base::template grad_in<0>()));
+        Base::set_grad_out(pack(dU, dS, dV));
+    }
+
+    void backward() override {
+        Output grad = Base::grad_out();
+        Matrix_ grad_U, grad_V;
+        for (size_t i = 0; i < Size; ++i) {
+            grad_U.entry(i) = detach(grad.entry(i));
+            grad_V.entry(i) = detach(grad.entry(Size + i));
+        }
+
+        Base::template set_grad_in<0>(Matrix<T, Size>(svd_bwd(
+            m_U, m_S, m_V, grad_U, Vector_(detach(grad.entry(2 * Size))),
+            grad_V)));
+    }
+
+    const char *name() const override { return "svd"; }
+
+private:
+    static Output pack(const Matrix_ &U, const Vector_ &S, const Matrix_ &V) {
+        Output result;
+        for (size_t i = 0; i < Size; ++i) {
+            result.entry(i) = Array<T, Size>(U.entry(i));
+            result.entry(Size + i) = Array<T, Size>(V.entry(i));
+        }
+        result.entry(2 * Size) = Array<T, Size>(S);
+        return result;
+    }
+
+    Matrix_ m_U, m_V;
+    Vector_ m_S;
+};
+
+template <typename T, size_t Size>
+std::pair<Array<T, Size>, Matrix<T, Size>>
+eig_sym_ad(const Matrix<T, Size> &A, size_t sweeps) {
+    auto result = custom<EigSymOp<T, Size>>(A, sweeps);
+    Matrix<T, Size> V;
+    for (size_t i = 0; i < Size; ++i)
+        V.entry(i) = result.entry(i);
+    return { result.entry(Size), V };
+}
+
+template <typename T, size_t Size>
+std::tuple<Matrix<T, Size>, Array<T, Size>, Matrix<T, Size>>
+svd_ad(const Matrix<T, Size> &A, size_t sweeps) {
+    auto result = custom<SVDOp<T, Size>>(A, sweeps);
+    Matrix<T, Size> U, V;
+    for (size_t i = 0; i < Size; ++i) {
+        U.entry(i) = result.entry(i);
+        V.entry(i) = result.entry(Size + i);
+    }
+    return { U, result.entry(2 * Size), V };
+}
+
+NAMESPACE_END(detail)
+NAMESPACE_END(drjit)
@@ -49,13 +49,30 @@ template <typename Value> constexpr Value morton_magic(size_t dim, size_t level)
     return value;
 }
 
+/// Does \ref scatter_bits() / \ref gather_bits() have an AVX-512 VBMI fast path for this type?
+template <size_t Dimension, typename Value, typename = int>
+struct morton_vbmi { static constexpr bool value = false; };
+
+template <size_t Dimension, typename Value>
+struct morton_vbmi<Dimension, Value, enable_if_t<is_array_v<Value>>> {
+    using Scalar = scalar_t<Value>;
+    static constexpr bool value =
+        has_avx512vbmi && Value::IsPacked && array_depth_v<Value> == 1 &&
+        std::is_unsigned_v<Scalar> && (sizeof(Scalar) == 4 || sizeof(Scalar) == 8) &&
+        Value::Size * sizeof(Scalar) == 64 && Dimension >= 2 && Dimension <= 4;
+};
+
+template <size_t Dimension, typename Value>
+constexpr bool morton_vbmi_v = morton_vbmi<Dimension, Value>::value;
+
 /// Bit scatter function. \c Dimension defines the final distance between two output bits
 template <size_t, typename Value, size_t Level, enable_if_t<Level == 0> = 0>
 DRJIT_INLINE Value scatter_bits(Value x) { return x; }
 
 template <size_t Dimension, typename Value,
-          size_t Level = clog2i(sizeof(Value) * 8),
-          enable_if_t<Level != 0 && (!(has_avx2 && has_x86_64) || !std::is_integral_v<Value>)> = 0>
+          size_t Level = clog2i(sizeof(scalar_t<Value>) * 8),
+          enable_if_t<Level != 0 && (!(has_avx2 && has_x86_64) || !std::is_integral_v<Value>) &&
+                      !morton_vbmi_v<Dimension, Value>> = 0>
 DRJIT_INLINE Value scatter_bits(Value x) {
     using Scalar = scalar_t<Value>;
 
@@ -77,12 +94,13 @@ DRJIT_INLINE Value gather_bits(Value x) { return x; }
 
 /// Bit gather function. \c Dimension defines the final distance between two input bits
 template <size_t Dimension, typename Value,
-          size_t Level = clog2i(sizeof(Value) * 8),
-          enable_if_t<Level != 0 && (!(has_avx2 && has_x86_64) || !std::is_integral_v<Value>)> = 0>
+          size_t Level = clog2i(sizeof(scalar_t<Value>) * 8),
+          enable_if_t<Level != 0 && (!(has_avx2 && has_x86_64) || !std::is_integral_v<Value>) &&
+                      !morton_vbmi_v<Dimension, Value>> = 0>
 DRJIT_INLINE Value gather_bits(Value x) {
     using Scalar = scalar_t<Value>;
 
-    constexpr size_t ilevel = clog2i(sizeof(Value) * 8) - Level + 1;
+    constexpr size_t ilevel = clog2i(sizeof(scalar_t<Value>) * 8) - Level + 1;
     constexpr Scalar magic = morton_magic<Scalar>(Dimension, ilevel);
     constexpr size_t shift_maybe = (1 << (ilevel - 1)) * (Dimension - 1);
     constexpr size_t shift = (shift_maybe < sizeof(Scalar) * 8) ? shift_maybe : 0;
@@ -117,6 +135,114 @@ DRJIT_INLINE Value gather_bits(Value x) {
 }
 #endif
 
+#if defined(DRJIT_X86_AVX512VBMI)
+/**
+ * \brief Lookup tables of the AVX-512 VBMI variants of \ref scatter_bits()
+ * and \ref gather_bits()
+ *
+ * Scattering: every byte of the result receives the bits of a short window
+ * (at most 4 bits) of the input, which <tt>vpmultishiftqb</tt> moves to the
+ * bottom of the byte, and a single <tt>vpermb</tt> table lookup then spreads
+ * them out (the table index also encodes the position of the first output
+ * bit within the byte).
+ *
+ * Gathering: byte \c j of the result initially holds the bits
+ * <tt>[c*j, c*j+c)</tt> of the output, which are extracted from a 7-bit
+ * window of the input and compacted by a 128-entry <tt>vpermi2b</tt> table
+ * lookup. Two multiply-add instructions then concatenate these chunks.
+ */
+template <size_t Dimension, typename Scalar> struct morton_vbmi_tables {
+    static constexpr uint32_t LaneBits = sizeof(Scalar) * 8,
+                              LaneBytes = sizeof(Scalar),
+                              Bits = LaneBits / Dimension,
+                              Chunk = 6 / Dimension + 1;
+
+    alignas(64) uint8_t scatter_ctrl[64] { }, scatter_mask[64] { },
+                        scatter_base[64] { }, scatter_lut[64] { },
+                        gather_ctrl[64] { }, gather_lut[128] { };
+
+    constexpr morton_vbmi_tables() {
+        for (uint32_t i = 0; i < 64; ++i) {
+            uint32_t j = i % LaneBytes,
+                     offset = (i % 8) / LaneBytes * LaneBits,
+                     k0 = (8 * j + Dimension - 1) / Dimension,
+                     k1 = (8 * j + 8 + Dimension - 1) / Dimension;
+            if (k1 > Bits)
+                k1 = Bits;
+
+            if (k0 < k1) {
+                scatter_ctrl[i] = (uint8_t) (offset + k0);
+                scatter_mask[i] = (uint8_t) ((1u << (k1 - k0)) - 1);
+                scatter_base[i] = (uint8_t) ((Dimension * k0 - 8 * j) << 4);
+            }
+
+            gather_ctrl[i] = (uint8_t) ((offset + Dimension * Chunk * j) % 64);
+        }
+
+        for (uint32_t o = 0; o < Dimension; ++o) {
+            for (uint32_t b = 0; b < 16; ++b) {
+                uint32_t value = 0;
+                for (uint32_t t = 0; t < 4; ++t)
+                    value |= ((b >> t) & 1) << (o + Dimension * t);
+                scatter_lut[o * 16 + b] = (uint8_t) value;
+            }
+        }
+
+        for (uint32_t b = 0; b < 128; ++b) {
+            uint32_t value = 0;
+            for (uint32_t t = 0; t < Chunk; ++t)
+                value |= ((b >> (Dimension * t)) & 1) << t;
+            gather_lut[b] = (uint8_t) value;
+        }
+    }
+};
+
+template <size_t Dimension, typename Scalar>
+constexpr morton_vbmi_tables<Dimension, Scalar> morton_vbmi_tables_v { };
+
+template <size_t Dimension, typename Value,
+          enable_if_t<morton_vbmi_v<Dimension, Value>> = 0>
+DRJIT_INLINE Value scatter_bits(Value x) {
+    const auto &t = morton_vbmi_tables_v<Dimension, scalar_t<Value>>;
+
+    __m512i window = _mm512_multishift_epi64_epi8(
+        _mm512_load_si512(t.scatter_ctrl), x.m);
+
+    // (window & mask) | base
+    __m512i index = _mm512_ternarylogic_epi32(
+        window, _mm512_load_si512(t.scatter_mask),
+        _mm512_load_si512(t.scatter_base), 0xEA);
+
+    return Value(_mm512_permutexvar_epi8(index, _mm512_load_si512(t.scatter_lut)));
+}
+
+template <size_t Dimension, typename Value,
+          enable_if_t<morton_vbmi_v<Dimension, Value>> = 0>
+DRJIT_INLINE Value gather_bits(Value x) {
+    using Scalar = scalar_t<Value>;
+    using Tables = morton_vbmi_tables<Dimension, Scalar>;
+    const auto &t = morton_vbmi_tables_v<Dimension, Scalar>;
+    constexpr Scalar magic = morton_magic<Scalar>(Dimension, 1);
+    constexpr int Chunk = (int) Tables::Chunk;
+
+    __m512i value = _mm512_and_si512(x.m, Value(magic).m);
+    value = _mm512_multishift_epi64_epi8(_mm512_load_si512(t.gather_ctrl), value);
+    value = _mm512_permutex2var_epi8(_mm512_load_si512(t.gather_lut), value,
+                                     _mm512_load_si512(t.gather_lut + 64));
+
+    // Concatenate the chunks stored in the bytes of each 32-bit word
+    value = _mm512_maddubs_epi16(value, _mm512_set1_epi16((short) ((1 << Chunk) << 8 | 1)));
+    value = _mm512_madd_epi16(value, _mm512_set1_epi32(1 << (2 * Chunk) << 16 | 1));
+
+    if constexpr (sizeof(Scalar) == 8)
+        value = _mm512_ternarylogic_epi64(
+            value, _mm512_set1_epi64(0xffffffffll),
+            _mm512_slli_epi64(_mm512_srli_epi64(value, 32), 4 * Chunk), 0xEA);
+
+    return Value(value);
+}
+#endif
+
 template <typename Array, size_t Index,
           enable_if_t<Index == 0> = 0>
 DRJIT_INLINE void morton_decode_helper(value_t<Array> value, Array &out) {
@@ -0,0 +1,316 @@
+/*
+    drjit/npy.h -- Loading and saving tensors in the NumPy ``.npy`` format
+
+    On the LLVM backend, tensors are memory-mapped from disk and used in
+    place without any intermediate copies. On the CUDA backend, the file is
+    read into a pinned staging buffer that is then uploaded asynchronously.
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/tensor.h>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/// Type descriptor of a scalar type in the ``.npy`` header (little endian)
+template <typename Value> constexpr const char *npy_descr() {
+    if constexpr (std::is_same_v<Value, bool>)
+        return "|b1";
+    else if constexpr (std::is_same_v<Value, half>)
+        return "<f2";
+    else if constexpr (std::is_floating_point_v<Value>)
+        return sizeof(Value) == 4 ? "<f4" : "<f8";
+    else if constexpr (std::is_signed_v<Value>)
+        return sizeof(Value) == 1 ? "|i1" : sizeof(Value) == 2 ? "<i2"
+             : sizeof(Value) == 4 ? "<i4" : "<i8";
+    else
+        return sizeof(Value) == 1 ? "|u1" : sizeof(Value) == 2 ? "<u2"
+             : sizeof(Value) == 4 ? "<u4" : "<u8";
+}
+
+/// Contents of a ``.npy`` header
+struct NpyHeader {
+    std::string descr;
+    bool fortran_order = false;
+    dr_vector<size_t> shape;
+    /// Byte offset of the array data from the start of the file
+    size_t offset = 0;
+};
+
+/// Closes a file handle when going out of scope
+struct NpyFile {
+    FILE *f;
+    NpyFile(FILE *f) : f(f) { }
+    ~NpyFile() { if (f) fclose(f); }
+};
+
+/**
+ * \brief Parse the header of a ``.npy`` file and leave \c f positioned at
+ * the start of the array data
+ *
+ * The header is a Python dictionary literal written by NumPy, e.g.
+ * ``{'descr': '<f4', 'fortran_order': False, 'shape': (3, 4), }``.
+ */
+inline NpyHeader npy_read_header(const char *filename, FILE *f) {
+    uint8_t preamble[12];
+    if (fread(preamble, 1, 10, f) != 10 ||
+        memcmp(preamble, "\x93NUMPY", 6) != 0)
+        drjit_raise("drjit::load_npy(\"%s\"): not a .npy file!", filename);
+
+    uint8_t major = preamble[6];
+    size_t header_len, preamble_len;
+    if (major == 1) {
+        header_len = (size_t) preamble[8] | ((size_t) preamble[9] << 8);
+        preamble_len = 10;
+    } else if (major == 2 || major == 3) {
+        if (fread(preamble + 10, 1, 2, f) != 2)
+            drjit_raise("drjit::load_npy(\"%s\"): truncated header!", filename);
+        header_len = (size_t) preamble[8] | ((size_t) preamble[9] << 8) |
+                     ((size_t) preamble[10] << 16) | ((size_t) preamble[11] << 24);
+        preamble_len = 12;
+    } else {
+        drjit_raise("drjit::load_npy(\"%s\"): unsupported format version %u!",
+                    filename, (uint32_t) major);
+    }
+
+    std::string dict(header_len, '\0');
+    if (fread(&dict[0], 1, header_len, f) != header_len)
+        drjit_raise("drjit::load_npy(\"%s\"): truncated header!", filename);
+
+    NpyHeader h;
+    h.offset = preamble_len + header_len;
+
+    auto value = [&](const char *key) -> size_t {
+        size_t pos = dict.find(key);
+        if (pos == std::string::npos)
+            drjit_raise("drjit::load_npy(\"%s\"): header lacks the %s entry!",
+                        filename, key);
+        pos = dict.find(':', pos + strlen(key));
+        if (pos == std::string::npos)
+            drjit_raise("drjit::load_npy(\"%s\"): malformed header!", filename);
+        return dict.find_first_not_of(' ', pos + 1);
+    };
+
+    size_t pos = value("'descr'");
+    if (pos == std::string::npos || dict[pos] != '\'')
+        drjit_raise("drjit::load_npy(\"%s\"): malformed header!", filename);
+    size_t end = dict.find('\'', pos + 1);
+    if (end == std::string::npos)
+        drjit_raise("drjit::load_npy(\"%s\"): malformed header!", filename);
+    h.descr = dict.substr(pos + 1, end - pos - 1);
+
+    pos = value("'fortran_order'");
+    h.fortran_order = dict.compare(pos, 4, "True") == 0;
+
+    pos = value("'shape'");
+    if (pos == std::string::npos || dict[pos] != '(')
+        drjit_raise("drjit::load_npy(\"%s\"): malformed header!", filename);
+    end = dict.find(')', pos);
+    if (end == std::string::npos)
+        drjit_raise("drjit::load_npy(\"%s\"): malformed header!", filename);
+    for (size_t i = pos + 1; i < end; ) {
+        if (dict[i] >= '0' && dict[i] <= '9') {
+            size_t size = 0;
+            while (i < end && dict[i] >= '0' && dict[i] <= '9')
+                size = size * 10 + (size_t) (dict[i++] - '0');
+            h.shape.push_back(size);
+        } else {
+            i++;
+        }
+    }
+
+    return h;
+}
+
+/// Keeps a memory-mapped file alive until the variable referencing it is freed
+struct NpyMapping {
+    void *ptr;
+    size_t size;
+
+    static void release(uint32_t /* index */, int free, void *payload) {
+        if (!free)
+            return;
+        NpyMapping *m = (NpyMapping *) payload;
+#if !defined(_WIN32)
+        munmap(m->ptr, m->size);
+#endif
+        delete m;
+    }
+};
+
+/**
+ * \brief Wrap the data region of a ``.npy`` file as a host array without
+ * copying it. Returns an uninitialized array when the file cannot be mapped
+ * or when its data is insufficiently aligned.
+ */
+template <typename Array>
+Array npy_map(const char *filename, size_t offset, size_t size) {
+#if !defined(_WIN32)
+    // The LLVM backend issues aligned vector loads
+    if (offset % 64 == 0) {
+        int fd = open(filename, O_RDONLY);
+        if (fd >= 0) {
+            size_t length = offset + size * sizeof(value_t<Array>);
+            // Private mapping: scatters into the tensor don't modify the file
+            void *ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE, fd, 0);
+            close(fd);
+
+            if (ptr != MAP_FAILED) {
+                Array result = Array::map_((uint8_t *) ptr + offset, size);
+                jit_var_set_callback(result.index(), NpyMapping::release,
+                                     new NpyMapping{ ptr, length });
+                return result;
+            }
+        }
+    }
+#else
+    (void) filename; (void) offset; (void) size;
+#endif
+    return Array();
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Load a tensor from a NumPy ``.npy`` file
+ *
+ * The data type stored in the file must match the tensor's value type
+ * exactly, and the array must be C-contiguous. On the LLVM backend, the file
+ * is memory-mapped, and the resulting tensor refers to the mapped pages until
+ * it is freed (writes to the tensor never reach the file). On the CUDA
+ * backend, the file is read into pinned host memory followed by an
+ * asynchronous upload to the device.
+ */
+template <typename T> T load_npy(const char *filename) {
+    using Array = detached_t<typename T::Array>;
+    using Value = typename T::Value;
+
+    detail::NpyFile file(fopen(filename, "rb"));
+    if (!file.f)
+        drjit_raise("drjit::load_npy(\"%s\"): could not open file!", filename);
+
+    detail::NpyHeader h = detail::npy_read_header(filename, file.f);
+    const char *descr = detail::npy_descr<Value>();
+    if (h.descr != descr)
+        drjit_raise("drjit::load_npy(\"%s\"): the file contains elements of "
+                    "type \"%s\", expected \"%s\"!", filename, h.descr.c_str(),
+                    descr);
+    if (h.fortran_order)
+        drjit_raise("drjit::load_npy(\"%s\"): Fortran-ordered arrays are not "
+                    "supported!", filename);
+
+    size_t size = 1;
+    for (size_t s : h.shape)
+        size *= s;
+    size_t bytes = size * sizeof(Value);
+
+    if (fseek(file.f, 0, SEEK_END) != 0 ||
+        (size_t) ftell(file.f) < h.offset + bytes)
+        drjit_raise("drjit::load_npy(\"%s\"): file is truncated!", filename);
+    fseek(file.f, (long) h.offset, SEEK_SET);
+
+    auto read = [&](void *ptr) {
+        if (fread(ptr, 1, bytes, file.f) != bytes)
+            drjit_raise("drjit::load_npy(\"%s\"): read error!", filename);
+    };
+
+    Array result;
+    if (size == 0) {
+        result = empty<Array>(0);
+    } else if constexpr (is_llvm_v<Array>) {
+        result = detail::npy_map<Array>(filename, h.offset, size);
+    } else if constexpr (is_cuda_v<Array>) {
+        void *staging = jit_malloc(AllocType::HostPinned, bytes),
+             *device = jit_malloc(AllocType::Device, bytes);
+        read(staging);
+        jit_memcpy_async(JitBackend::CUDA, device, staging, bytes);
+        // Freeing pinned memory is deferred until the copy has finished
+        jit_free(staging);
+        result = Array::map_(device, size, true);
+    } else {
+        result = empty<Array>(size);
+        read(result.data());
+    }
+
+    // Misaligned or unmappable file: fall back to a copy
+    if (result.size() != size) {
+        std::unique_ptr<uint8_t[]> buf(new uint8_t[bytes]);
+        read(buf.get());
+        result = load<Array>(buf.get(), size);
+    }
+
+    return T(typename T::Array(result), h.shape.size(), h.shape.data());
+}
+
+/// Save a tensor to a NumPy ``.npy`` file
+template <typename T> void save_npy(const char *filename, const T &t) {
+    using Value = typename T::Value;
+
+    std::string dict = "{'descr': '";
+    dict += detail::npy_descr<Value>();
+    dict += "', 'fortran_order': False, 'shape': (";
+    for (size_t i = 0; i < t.ndim(); ++i) {
+        dict += std::to_string(t.shape(i));
+        dict += t.ndim() == 1 ? "," : (i + 1 < t.ndim() ? ", " : "");
+    }
+    dict += "), }";
+
+    // Pad the header so that the data starts at a multiple of 64 bytes
+    size_t preamble_len = dict.size() + 64 < 65536 ? 10 : 12;
+    dict.append(63 - (preamble_len + dict.size()) % 64, ' ');
+    dict += '\n';
+
+    uint8_t preamble[12] = { 0x93, 'N', 'U', 'M', 'P', 'Y' };
+    size_t header_len = dict.size();
+    preamble[6] = preamble_len == 10 ? 1 : 2;
+    for (size_t i = 0; i < preamble_len - 8; ++i)
+        preamble[8 + i] = (uint8_t) (header_len >> (8 * i));
+
+    auto value = detach(t.array());
+    size_t bytes = value.size() * sizeof(Value);
+    std::unique_ptr<uint8_t[]> buf;
+    const void *ptr;
+
+    if constexpr (is_cuda_v<decltype(value)>) {
+        buf.reset(new uint8_t[bytes]);
+        store(buf.get(), value);
+        ptr = buf.get();
+    } else {
+        if constexpr (is_jit_v<decltype(value)>) {
+            eval(value);
+            sync_thread();
+        }
+        ptr = value.data();
+    }
+
+    detail::NpyFile file(fopen(filename, "wb"));
+    if (!file.f)
+        drjit_raise("drjit::save_npy(\"%s\"): could not open file!", filename);
+    if (fwrite(preamble, 1, preamble_len, file.f) != preamble_len ||
+        fwrite(dict.data(), 1, header_len, file.f) != header_len ||
+        fwrite(ptr, 1, bytes, file.f) != bytes)
+        drjit_raise("drjit::save_npy(\"%s\"): write error!", filename);
+}
+
+NAMESPACE_END(drjit)
@@ -15,6 +15,7 @@
 #include <drjit/array.h>
 #include <drjit/packet_intrin.h>
 #include <drjit/packet_recursive.h>
+#include <drjit/half.h>
 
 #if defined(DRJIT_X86_AVX512)
 #  include <drjit/packet_kmask.h>
@@ -36,6 +37,11 @@
 #  include <drjit/packet_avx512.h>
 #endif
 
+/* The NEON packet backend is opt-in (CMake option DRJIT_ENABLE_NEON) */
+#if defined(DRJIT_ARM_NEON) && defined(DRJIT_ENABLE_NEON)
+#  include <drjit/packet_neon.h>
+#endif
+
 NAMESPACE_BEGIN(drjit)
 
 template <typename Value_, size_t Size_>
@@ -87,6 +93,21 @@ inline bool flush_denormals() {
     return _MM_GET_FLUSH_ZERO_MODE() == _MM_FLUSH_ZERO_ON;
 }
 
+#elif defined(DRJIT_ARM_64) && (defined(__GNUC__) || defined(__clang__))
+/// Flush denormalized numbers to zero (FZ bit of the FPCR register)
+inline void set_flush_denormals(bool value) {
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    fpcr = value ? (fpcr | (1ull << 24)) : (fpcr & ~(1ull << 24));
+    __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+}
+
+inline bool flush_denormals() {
+    uint64_t fpcr;
+    __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+    return (fpcr & (1ull << 24)) != 0;
+}
+
 #else
 inline void set_flush_denormals(bool) { }
 inline bool flush_denormals() { return false; }
@@ -40,10 +40,10 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-//     DRJIT_CONVERT(half)
-//         : m(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data()))) { }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half)
+        : m(_mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data()))) { }
+#endif
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
 
@@ -286,6 +286,33 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
         #endif
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return _mm256_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1));
+        else if constexpr (Step == 2)
+            return _mm256_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2));
+        else
+            return _mm256_permute2f128_ps(m, m, 0x01);
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        // Low 128 bit lane moved up, zero below
+        __m256 t = _mm256_permute2f128_ps(m, m, 0x08);
+        if constexpr (Shift == 4) {
+            return t;
+        } else {
+        #if defined(DRJIT_X86_AVX2)
+            __m256i mi = _mm256_castps_si256(m), ti = _mm256_castps_si256(t);
+            if constexpr (Shift < 4)
+                return _mm256_castsi256_ps(_mm256_alignr_epi8(mi, ti, 16 - 4 * Shift));
+            else
+                return _mm256_castsi256_ps(_mm256_slli_si256(ti, 4 * (Shift - 4)));
+        #else
+            return Base::template shift_lanes_<Shift>();
+        #endif
+        }
+    }
+
 #if defined(DRJIT_X86_AVX512)
     DRJIT_INLINE Derived ldexp_(Ref arg) const { return _mm256_scalef_ps(m, arg.m); }
 
@@ -396,6 +423,13 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
         _mm256_storeu_ps((Value *) ptr, m);
     }
 
+#if defined(DRJIT_X86_F16C)
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        _mm_storeu_si128((__m128i *) ptr, _mm256_cvtps_ph(m, _MM_FROUND_CUR_DIRECTION));
+    }
+#endif
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
         return _mm256_load_ps((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 32));
     }
@@ -404,6 +438,82 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
         return _mm256_loadu_ps((const Value *) ptr);
     }
 
+    /**
+     * Load 'N' interleaved components of 8 records (used by load_aos()).
+     * Records 0-3 and 4-7 are placed into separate 128-bit lanes, which are
+     * then transposed in the same way as in the SSE4.2 backend.
+     */
+    template <size_t N, enable_if_t<N == 3 || N == 4> = 0>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const Value *p = (const Value *) ptr;
+        auto load2 = [p](size_t lo, size_t hi) {
+            return _mm256_insertf128_ps(
+                _mm256_castps128_ps256(_mm_loadu_ps(p + lo)),
+                _mm_loadu_ps(p + hi), 1);
+        };
+
+        if constexpr (N == 3) {
+            __m256 a = load2(0, 12), b = load2(4, 16), c = load2(8, 20);
+
+            __m256 t0 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)),
+                   t1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+            out[0] = _mm256_shuffle_ps(a, t0,  _MM_SHUFFLE(2, 0, 3, 0));
+            out[1] = _mm256_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+            out[2] = _mm256_shuffle_ps(t1, c,  _MM_SHUFFLE(3, 0, 3, 1));
+        } else {
+            __m256 a = load2(0, 16), b = load2(4, 20),
+                   c = load2(8, 24), d = load2(12, 28);
+
+            __m256 t0 = _mm256_unpacklo_ps(a, b), t1 = _mm256_unpacklo_ps(c, d),
+                   t2 = _mm256_unpackhi_ps(a, b), t3 = _mm256_unpackhi_ps(c, d);
+
+            out[0] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            out[1] = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            out[2] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            out[3] = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        }
+    }
+
+    /// Store 'N' components of 8 records in interleaved form (used by store_aos())
+    template <size_t N, enable_if_t<N == 3 || N == 4> = 0>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        Value *p = (Value *) ptr;
+        __m256 x = in[0].m, y = in[1].m, z = in[2].m, r0, r1, r2, r3;
+
+        if constexpr (N == 3) {
+            __m256 t0 = _mm256_unpacklo_ps(x, y),
+                   t1 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                   t2 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                   t3 = _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                   t4 = _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                   t5 = _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+            r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(2, 0, 2, 0));
+            r2 = _mm256_shuffle_ps(t4, t5, _MM_SHUFFLE(2, 0, 2, 0));
+
+            _mm256_storeu_ps(p,      _mm256_permute2f128_ps(r0, r1, 0x20));
+            _mm256_storeu_ps(p + 8,  _mm256_permute2f128_ps(r2, r0, 0x30));
+            _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(r1, r2, 0x31));
+        } else {
+            __m256 w = in[3].m;
+
+            __m256 t0 = _mm256_unpacklo_ps(x, y), t1 = _mm256_unpacklo_ps(z, w),
+                   t2 = _mm256_unpackhi_ps(x, y), t3 = _mm256_unpackhi_ps(z, w);
+
+            r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+            r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+            r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+            r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+
+            _mm256_storeu_ps(p,      _mm256_permute2f128_ps(r0, r1, 0x20));
+            _mm256_storeu_ps(p + 8,  _mm256_permute2f128_ps(r2, r3, 0x20));
+            _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(r0, r1, 0x31));
+            _mm256_storeu_ps(p + 24, _mm256_permute2f128_ps(r2, r3, 0x31));
+        }
+    }
+
     static DRJIT_INLINE Derived empty_(size_t) { return _mm256_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm256_setzero_ps(); }
 
@@ -437,6 +547,36 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     }
 #endif
 
+#if defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            _mm256_mask_compressstoreu_ps(ptr, (__mmask8) bits, m);
+        #else
+            __m256i perm = detail::compress_unpack(
+                detail::compress_table.compress[bits]);
+            _mm256_maskstore_ps((float *) ptr, perm,
+                _mm256_permutevar8x32_ps(m, _mm256_srli_epi32(perm, 28)));
+        #endif
+        return (size_t) _mm_popcnt_u32(bits);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            return _mm256_maskz_expandloadu_ps((__mmask8) bits, ptr);
+        #else
+            __m256i prefix = detail::compress_unpack(detail::compress_table.compress[bits]),
+                    perm   = detail::compress_unpack(detail::compress_table.expand[bits]);
+            __m256 value = _mm256_maskload_ps((const float *) ptr, prefix);
+            value = _mm256_permutevar8x32_ps(value, _mm256_srli_epi32(perm, 28));
+            return _mm256_and_ps(value, _mm256_castsi256_ps(_mm256_srai_epi32(perm, 31)));
+        #endif
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -464,12 +604,12 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-//     DRJIT_CONVERT(half) {
-//         m = _mm256_cvtps_pd(
-//             _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data())));
-//     }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half) {
+        m = _mm256_cvtps_pd(
+            _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data())));
+    }
+#endif
 
     DRJIT_CONVERT(float) : m(_mm256_cvtps_pd(a.derived().m)) { }
     DRJIT_CONVERT(int32_t) : m(_mm256_cvtepi32_pd(a.derived().m)) { }
@@ -761,6 +901,14 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
         _mm256_storeu_pd((Value *) ptr, m);
     }
 
+#if defined(DRJIT_X86_F16C)
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        _mm_storel_epi64((__m128i *) ptr,
+                         _mm_cvtps_ph(_mm256_cvtpd_ps(m), _MM_FROUND_CUR_DIRECTION));
+    }
+#endif
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
         return _mm256_load_pd((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 32));
     }
@@ -799,6 +947,37 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     }
 #endif
 
+#if defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            _mm256_mask_compressstoreu_pd(ptr, (__mmask8) bits, m);
+        #else
+            __m256i perm = detail::compress_unpack(
+                detail::compress_table.compress[detail::compress_widen(bits)]);
+            _mm256_maskstore_pd((double *) ptr, perm,
+                _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(m), _mm256_srli_epi32(perm, 28))));
+        #endif
+        return (size_t) _mm_popcnt_u32(bits);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            return _mm256_maskz_expandloadu_pd((__mmask8) bits, ptr);
+        #else
+            bits = detail::compress_widen(bits);
+            __m256i prefix = detail::compress_unpack(detail::compress_table.compress[bits]),
+                    perm   = detail::compress_unpack(detail::compress_table.expand[bits]);
+            __m256 value = _mm256_castpd_ps(_mm256_maskload_pd((const double *) ptr, prefix));
+            value = _mm256_permutevar8x32_ps(value, _mm256_srli_epi32(perm, 28));
+            return _mm256_castps_pd(_mm256_and_ps(value, _mm256_castsi256_ps(_mm256_srai_epi32(perm, 31))));
+        #endif
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -810,13 +989,13 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
     DRJIT_PACKET_TYPE_3D(double)
 
 #if defined(DRJIT_X86_F16C)
-    // template <typename Derived2>
-    // DRJIT_INLINE StaticArrayImpl(const StaticArrayBase<half, 3, IsMask_, Derived2> &a) {
-    //     uint16_t temp[4];
-    //     memcpy(temp, a.derived().data(), sizeof(uint16_t) * 3);
-    //     temp[3] = 0;
-    //     m = _mm256_cvtps_pd(_mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) temp)));
-    // }
+    template <typename Derived2>
+    DRJIT_INLINE StaticArrayImpl(const StaticArrayBase<half, 3, IsMask_, Derived2> &a) {
+        uint16_t temp[4];
+        memcpy(temp, a.derived().data(), sizeof(uint16_t) * 3);
+        temp[3] = 0;
+        m = _mm256_cvtps_pd(_mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) temp)));
+    }
 #endif
 
     template <int I0, int I1, int I2>
@@ -875,6 +1054,14 @@ template <bool IsMask_, typename Derived_> struct alignas(32)
         store_aligned_(ptr);
     }
 
+#if defined(DRJIT_X86_F16C)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        uint16_t temp[4];
+        Base::store_half_(temp);
+        memcpy(ptr, temp, sizeof(uint16_t) * 3);
+    }
+#endif
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t size) {
         return Base::load_(ptr, size);
     }
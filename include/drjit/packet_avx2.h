@@ -323,6 +323,26 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
             _mm256_setr_epi32(I0, I1, I2, I3, I4, I5, I6, I7));
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return _mm256_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1));
+        else if constexpr (Step == 2)
+            return _mm256_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2));
+        else
+            return _mm256_permute2x128_si256(m, m, 0x01);
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        // Low 128 bit lane moved up, zero below
+        __m256i t = _mm256_permute2x128_si256(m, m, 0x08);
+        if constexpr (Shift < 4)
+            return _mm256_alignr_epi8(m, t, 16 - 4 * Shift);
+        else if constexpr (Shift == 4)
+            return t;
+        else
+            return _mm256_slli_si256(t, 4 * (Shift - 4));
+    }
+
     DRJIT_INLINE Derived mulhi_(Ref b) const {
         Derived even, odd;
 
@@ -430,6 +450,36 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
     }
 
 
+#if defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            _mm256_mask_compressstoreu_epi32(ptr, (__mmask8) bits, m);
+        #else
+            __m256i perm = detail::compress_unpack(
+                detail::compress_table.compress[bits]);
+            _mm256_maskstore_epi32((int *) ptr, perm,
+                _mm256_permutevar8x32_epi32(m, _mm256_srli_epi32(perm, 28)));
+        #endif
+        return (size_t) _mm_popcnt_u32(bits);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            return _mm256_maskz_expandloadu_epi32((__mmask8) bits, ptr);
+        #else
+            __m256i prefix = detail::compress_unpack(detail::compress_table.compress[bits]),
+                    perm   = detail::compress_unpack(detail::compress_table.expand[bits]);
+            __m256i value = _mm256_maskload_epi32((const int *) ptr, prefix);
+            value = _mm256_permutevar8x32_epi32(value, _mm256_srli_epi32(perm, 28));
+            return _mm256_and_si256(value, _mm256_srai_epi32(perm, 31));
+        #endif
+    }
+#endif
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -553,44 +603,41 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
     }
 
     DRJIT_INLINE Derived mulhi_(Ref b) const {
-        if constexpr (std::is_unsigned_v<Value>) {
-            const __m256i low_bits = _mm256_set1_epi64x(0xffffffffu);
-            __m256i al = m, bl = b.m;
-
-            __m256i ah = _mm256_srli_epi64(al, 32);
-            __m256i bh = _mm256_srli_epi64(bl, 32);
+        const __m256i low_bits = _mm256_set1_epi64x(0xffffffffu);
+        __m256i al = m, bl = b.m;
 
-            // 4x unsigned 32x32->64 bit multiplication
-            __m256i albl = _mm256_mul_epu32(al, bl);
-            __m256i albh = _mm256_mul_epu32(al, bh);
-            __m256i ahbl = _mm256_mul_epu32(ah, bl);
-            __m256i ahbh = _mm256_mul_epu32(ah, bh);
+        __m256i ah = _mm256_srli_epi64(al, 32);
+        __m256i bh = _mm256_srli_epi64(bl, 32);
 
-            // Calculate a possible carry from the low bits of the multiplication.
-            __m256i carry = _mm256_add_epi64(
-                _mm256_srli_epi64(albl, 32),
-                _mm256_add_epi64(_mm256_and_si256(albh, low_bits),
-                                 _mm256_and_si256(ahbl, low_bits)));
+        // 4x unsigned 32x32->64 bit multiplication
+        __m256i albl = _mm256_mul_epu32(al, bl);
+        __m256i albh = _mm256_mul_epu32(al, bh);
+        __m256i ahbl = _mm256_mul_epu32(ah, bl);
+        __m256i ahbh = _mm256_mul_epu32(ah, bh);
 
-            __m256i s0 = _mm256_add_epi64(ahbh, _mm256_srli_epi64(carry, 32));
-            __m256i s1 = _mm256_add_epi64(_mm256_srli_epi64(albh, 32),
-                                          _mm256_srli_epi64(ahbl, 32));
+        // Calculate a possible carry from the low bits of the multiplication.
+        __m256i carry = _mm256_add_epi64(
+            _mm256_srli_epi64(albl, 32),
+            _mm256_add_epi64(_mm256_and_si256(albh, low_bits),
+                             _mm256_and_si256(ahbl, low_bits)));
 
-            return _mm256_add_epi64(s0, s1);
+        __m256i s0 = _mm256_add_epi64(ahbh, _mm256_srli_epi64(carry, 32));
+        __m256i s1 = _mm256_add_epi64(_mm256_srli_epi64(albh, 32),
+                                      _mm256_srli_epi64(ahbl, 32));
 
-        } else {
-            const Derived mask(0xffffffff);
-            const Derived a = derived();
-            Derived ah = sr<32>(a), bh = sr<32>(b),
-                    al = a & mask, bl = b & mask;
-
-            Derived albl_hi = _mm256_srli_epi64(_mm256_mul_epu32(m, b.m), 32);
-
-            Derived t = ah * bl + albl_hi;
-            Derived w1 = al * bh + (t & mask);
+        __m256i result = _mm256_add_epi64(s0, s1);
 
-            return ah * bh + sr<32>(t) + sr<32>(w1);
+        if constexpr (std::is_signed_v<Value>) {
+            /* Signed high product from the unsigned one: subtract 'b' if
+               'a' is negative, and 'a' if 'b' is negative */
+            const __m256i zero = _mm256_setzero_si256();
+            __m256i fix = _mm256_add_epi64(
+                _mm256_and_si256(_mm256_cmpgt_epi64(zero, al), bl),
+                _mm256_and_si256(_mm256_cmpgt_epi64(zero, bl), al));
+            result = _mm256_sub_epi64(result, fix);
         }
+
+        return result;
     }
 
     template <typename T> DRJIT_INLINE Derived or_(const T &a) const {
@@ -872,10 +919,46 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(32)
             return (Value) detail::mm_cvtsi128_si64(_mm256_castsi256_si128(
                 _mm256_mask_compress_epi64(_mm256_setzero_si256(), mask.k, m)));
         #else
+            /* Move the lane to the front instead of reading it via entry(),
+               which violates strict aliasing when 'Value' is a pointer */
             int k = _mm256_movemask_pd(_mm256_castsi256_pd(mask.m));
-            return entry((size_t) (detail::tzcnt(k) & 3));
+            long long i = (long long) (detail::tzcnt(k) & 3) * 2;
+            __m256i perm = _mm256_set1_epi64x(((i + 1) << 32) | i);
+            return (Value) detail::mm_cvtsi128_si64(_mm256_castsi256_si128(
+                _mm256_permutevar8x32_epi32(m, perm)));
+        #endif
+    }
+
+#if defined(DRJIT_X86_AVX2)
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            _mm256_mask_compressstoreu_epi64(ptr, (__mmask8) bits, m);
+        #else
+            __m256i perm = detail::compress_unpack(
+                detail::compress_table.compress[detail::compress_widen(bits)]);
+            _mm256_maskstore_epi64((long long *) ptr, perm,
+                _mm256_permutevar8x32_epi32(m, _mm256_srli_epi32(perm, 28)));
+        #endif
+        return (size_t) _mm_popcnt_u32(bits);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        uint32_t bits = mask.bitmask_();
+        #if defined(DRJIT_X86_AVX512)
+            return _mm256_maskz_expandloadu_epi64((__mmask8) bits, ptr);
+        #else
+            bits = detail::compress_widen(bits);
+            __m256i prefix = detail::compress_unpack(detail::compress_table.compress[bits]),
+                    perm   = detail::compress_unpack(detail::compress_table.expand[bits]);
+            __m256i value = _mm256_maskload_epi64((const long long *) ptr, prefix);
+            value = _mm256_permutevar8x32_epi32(value, _mm256_srli_epi32(perm, 28));
+            return _mm256_and_si256(value, _mm256_srai_epi32(perm, 31));
         #endif
     }
+#endif
 
     //! @}
     // -----------------------------------------------------------------------
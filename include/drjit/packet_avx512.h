@@ -16,6 +16,43 @@
 NAMESPACE_BEGIN(drjit)
 DRJIT_PACKET_DECLARE(64)
 
+NAMESPACE_BEGIN(detail)
+
+/// Can the conflict-aware packet scatter_reduce_() handle the operation 'op'?
+template <typename Value> constexpr bool packet_reduce_supported(ReduceOp op) {
+    switch (op) {
+        case ReduceOp::Add:
+        case ReduceOp::Mul:
+        case ReduceOp::Min:
+        case ReduceOp::Max:
+            return true;
+        case ReduceOp::And:
+        case ReduceOp::Or:
+            return std::is_integral_v<Value>;
+        default:
+            return false;
+    }
+}
+
+/// Combine two packets using the reduction operation 'op'
+template <typename T> DRJIT_INLINE T packet_reduce(ReduceOp op, const T &a, const T &b) {
+    switch (op) {
+        case ReduceOp::Mul: return a * b;
+        case ReduceOp::Min: return minimum(a, b);
+        case ReduceOp::Max: return maximum(a, b);
+        default: break;
+    }
+    if constexpr (std::is_integral_v<scalar_t<T>>) {
+        if (op == ReduceOp::And)
+            return a & b;
+        else if (op == ReduceOp::Or)
+            return a | b;
+    }
+    return a + b;
+}
+
+NAMESPACE_END(detail)
+
 /// Partial overload of StaticArrayImpl using AVX512 intrinsics (single precision)
 template <bool IsMask_, typename Derived_> struct alignas(64)
     StaticArrayImpl<float, 16, IsMask_, Derived_>
@@ -43,8 +80,8 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-    // DRJIT_CONVERT(half)
-    //     : m(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *) a.derived().data()))) { }
+    DRJIT_CONVERT(half)
+        : m(_mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *) a.derived().data()))) { }
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
 
@@ -207,6 +244,22 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
         return _mm512_permutexvar_ps(idx, m);
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return _mm512_permute_ps(m, _MM_SHUFFLE(2, 3, 0, 1));
+        else if constexpr (Step == 2)
+            return _mm512_permute_ps(m, _MM_SHUFFLE(1, 0, 3, 2));
+        else if constexpr (Step == 4)
+            return _mm512_shuffle_f32x4(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+        else
+            return _mm512_shuffle_f32x4(m, m, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        return _mm512_castsi512_ps(_mm512_alignr_epi32(
+            _mm512_castps_si512(m), _mm512_setzero_si512(), 16 - Shift));
+    }
+
     DRJIT_INLINE Derived rcp_() const {
         __m512 r = _mm512_rcp14_ps(m); // rel error < 2^-14
 
@@ -262,6 +315,11 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
         _mm512_storeu_ps((Value *) ptr, m);
     }
 
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        _mm256_storeu_si256((__m256i *) ptr, _mm512_cvtps_ph(m, _MM_FROUND_CUR_DIRECTION));
+    }
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
         return _mm512_load_ps((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 64));
     }
@@ -270,6 +328,73 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
         return _mm512_loadu_ps((const Value *) ptr);
     }
 
+    /// Load 'N' interleaved components of 16 records (used by load_aos())
+    template <size_t N, enable_if_t<N == 3 || N == 4> = 0>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const Value *p = (const Value *) ptr;
+        __m512 v0 = _mm512_loadu_ps(p),      v1 = _mm512_loadu_ps(p + 16),
+               v2 = _mm512_loadu_ps(p + 32);
+
+        if constexpr (N == 3) {
+            /* Component 'c' of record 'i' is at position 3*i + c. The
+               permutations only consider the low 5 (resp. 4) index bits */
+            __m512i base = _mm512_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21, 24,
+                                              27, 30, 33, 36, 39, 42, 45);
+            for (int c = 0; c < 3; ++c) {
+                __m512i index = _mm512_add_epi32(base, _mm512_set1_epi32(c));
+                __m512 t = _mm512_permutex2var_ps(v0, index, v1);
+                out[c] = _mm512_mask_permutexvar_ps(
+                    t, __mmask16(c == 2 ? 0xFC00 : 0xF800), index, v2);
+            }
+        } else {
+            __m512 v3 = _mm512_loadu_ps(p + 48);
+            __m512i base = _mm512_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28, 32,
+                                              36, 40, 44, 48, 52, 56, 60);
+            for (int c = 0; c < 4; ++c) {
+                __m512i index = _mm512_add_epi32(base, _mm512_set1_epi32(c));
+                out[c] = _mm512_mask_blend_ps(
+                    __mmask16(0xFF00), _mm512_permutex2var_ps(v0, index, v1),
+                    _mm512_permutex2var_ps(v2, index, v3));
+            }
+        }
+    }
+
+    /// Store 'N' components of 16 records in interleaved form (used by store_aos())
+    template <size_t N, enable_if_t<N == 3 || N == 4> = 0>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        Value *p = (Value *) ptr;
+        __m512 x = in[0].m, y = in[1].m, z = in[2].m;
+
+        if constexpr (N == 3) {
+            /* Output element 'e' is component e % 3 of record e / 3. Lanes
+               drawn from 'x'/'y' use a two-source permutation, while lanes
+               drawn from 'z' are merged in via a masked permutation */
+            const __m512i i0 = _mm512_setr_epi32(0, 16, 0, 1, 17, 1, 2, 18, 2,
+                                                 3, 19, 3, 4, 20, 4, 5),
+                          i1 = _mm512_setr_epi32(21, 5, 6, 22, 6, 7, 23, 7, 8,
+                                                 24, 8, 9, 25, 9, 10, 26),
+                          i2 = _mm512_setr_epi32(10, 11, 27, 11, 12, 28, 12, 13,
+                                                 29, 13, 14, 30, 14, 15, 31, 15);
+
+            _mm512_storeu_ps(p, _mm512_mask_permutexvar_ps(
+                _mm512_permutex2var_ps(x, i0, y), __mmask16(0x4924), i0, z));
+            _mm512_storeu_ps(p + 16, _mm512_mask_permutexvar_ps(
+                _mm512_permutex2var_ps(x, i1, y), __mmask16(0x2492), i1, z));
+            _mm512_storeu_ps(p + 32, _mm512_mask_permutexvar_ps(
+                _mm512_permutex2var_ps(x, i2, y), __mmask16(0x9249), i2, z));
+        } else {
+            __m512 w = in[3].m;
+            const __m512i base = _mm512_setr_epi32(0, 16, 0, 16, 1, 17, 1, 17,
+                                                   2, 18, 2, 18, 3, 19, 3, 19);
+            for (int k = 0; k < 4; ++k) {
+                __m512i index = _mm512_add_epi32(base, _mm512_set1_epi32(4 * k));
+                _mm512_storeu_ps(p + 16 * k, _mm512_mask_blend_ps(
+                    __mmask16(0xCCCC), _mm512_permutex2var_ps(x, index, y),
+                    _mm512_permutex2var_ps(z, index, w)));
+            }
+        }
+    }
+
     static DRJIT_INLINE Derived empty_(size_t) { return _mm512_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm512_setzero_ps(); }
 
@@ -297,8 +422,10 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     template <typename Index, typename Mask>
     DRJIT_INLINE void scatter_reduce_(ReduceOp op, void *ptr, const Index &index_,
                                       const Mask &active_) const {
-        if (op != ReduceOp::Add)
-            drjit_raise("Packet scatter_reduce only support Add operation!");
+        if (!detail::packet_reduce_supported<Value>(op)) {
+            Base::scatter_reduce_(op, ptr, index_, active_);
+            return;
+        }
 
         if constexpr (sizeof(scalar_t<Index>) == 4) {
             __m512i index = index_.m;
@@ -321,20 +448,32 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
                     __m512 value_peer = _mm512_maskz_permutexvar_ps(todo, perm_idx, value);
                     perm_idx = _mm512_mask_permutexvar_epi32(perm_idx, todo,
                                                              perm_idx, perm_idx);
-                    value = _mm512_add_ps(value, value_peer);
+                    value = _mm512_mask_mov_ps(value, todo,
+                        detail::packet_reduce(op, Derived(value), Derived(value_peer)).m);
                     todo = _mm512_mask_cmp_epi32_mask(active, all_ones, perm_idx,
                                                       _MM_CMPINT_NE);
                 } while (!_mm512_kortestz(todo, todo));
             }
 
-            value = _mm512_add_ps(value, value_orig);
+            value = detail::packet_reduce(op, Derived(value), Derived(value_orig)).m;
 
             _mm512_mask_i32scatter_ps(ptr, active, index, value, 4);
         } else {
-            scatter_reduce_(ptr, int32_array_t<Index>(index_), op, active_);
+            scatter_reduce_(op, ptr, int32_array_t<Index>(index_), active_);
         }
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_ps(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((uint32_t) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_ps(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -361,9 +500,9 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-    // DRJIT_CONVERT(half)
-    //     : m(_mm512_cvtps_pd(
-    //           _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data())))) { }
+    DRJIT_CONVERT(half)
+        : m(_mm512_cvtps_pd(
+              _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *) a.derived().data())))) { }
 
     DRJIT_CONVERT(float) : m(_mm512_cvtps_pd(a.derived().m)) { }
 
@@ -574,6 +713,12 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
         _mm512_storeu_pd((Value *) ptr, m);
     }
 
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        _mm_storeu_si128((__m128i *) ptr,
+                         _mm256_cvtps_ph(_mm512_cvtpd_ps(m), _MM_FROUND_CUR_DIRECTION));
+    }
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
         return _mm512_load_pd((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 64));
     }
@@ -604,8 +749,10 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
     template <typename Index, typename Mask>
     DRJIT_INLINE void scatter_reduce_(ReduceOp op, void *ptr, const Index &index_,
                                       const Mask &active_) const {
-        if (op != ReduceOp::Add)
-            drjit_raise("Packet scatter_reduce only support Add operation!");
+        if (!detail::packet_reduce_supported<Value>(op)) {
+            Base::scatter_reduce_(op, ptr, index_, active_);
+            return;
+        }
 
         if constexpr (sizeof(scalar_t<Index>) == 8) {
             __m512i index = index_.m;
@@ -628,20 +775,32 @@ template <bool IsMask_, typename Derived_> struct alignas(64)
                     __m512d value_peer = _mm512_maskz_permutexvar_pd(todo, perm_idx, value);
                     perm_idx = _mm512_mask_permutexvar_epi64(perm_idx, todo,
                                                              perm_idx, perm_idx);
-                    value = _mm512_add_pd(value, value_peer);
+                    value = _mm512_mask_mov_pd(value, todo,
+                        detail::packet_reduce(op, Derived(value), Derived(value_peer)).m);
                     todo = _mm512_mask_cmp_epi64_mask(active, all_ones, perm_idx,
                                                       _MM_CMPINT_NE);
                 } while (!_kortestz_mask8_u8(todo, todo));
             }
 
-            value = _mm512_add_pd(value, value_orig);
+            value = detail::packet_reduce(op, Derived(value), Derived(value_orig)).m;
 
             _mm512_mask_i64scatter_pd(ptr, active, index, value, 8);
         } else {
-            scatter_reduce_(ptr, int64_array_t<Index>(index_), op, active_);
+            scatter_reduce_(op, ptr, int64_array_t<Index>(index_), active_);
         }
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_pd(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((uint32_t) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_pd(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -786,10 +945,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
                                        : _mm512_srlv_epi32(m, k.m);
     }
 
-    DRJIT_INLINE auto lt_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_LT));  }
-    DRJIT_INLINE auto gt_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_GT));  }
-    DRJIT_INLINE auto le_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_LE));  }
-    DRJIT_INLINE auto ge_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_GE));  }
+    #define DRJIT_CMP_INT32(op)                                                 \
+        (std::is_signed_v<Value> ? _mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_##op) \
+                                 : _mm512_cmp_epu32_mask(m, a.m, _MM_CMPINT_##op))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT32(LT)); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT32(GT)); }
+    DRJIT_INLINE auto le_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT32(LE)); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT32(GE)); }
+
+    #undef DRJIT_CMP_INT32
+
     DRJIT_INLINE auto eq_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_EQ));  }
     DRJIT_INLINE auto neq_(Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi32_mask(m, a.m, _MM_CMPINT_NE)); }
 
@@ -823,6 +989,21 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
         return _mm512_permutexvar_epi32(idx, m);
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return _mm512_shuffle_epi32(m, (_MM_PERM_ENUM) _MM_SHUFFLE(2, 3, 0, 1));
+        else if constexpr (Step == 2)
+            return _mm512_shuffle_epi32(m, (_MM_PERM_ENUM) _MM_SHUFFLE(1, 0, 3, 2));
+        else if constexpr (Step == 4)
+            return _mm512_shuffle_i32x4(m, m, _MM_SHUFFLE(2, 3, 0, 1));
+        else
+            return _mm512_shuffle_i32x4(m, m, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        return _mm512_alignr_epi32(m, _mm512_setzero_si512(), 16 - Shift);
+    }
+
     DRJIT_INLINE Derived mulhi_(Ref a) const {
         auto blend = mask_t<Derived>::from_k(0b0101010101010101);
         Derived even, odd;
@@ -902,8 +1083,10 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
     template <typename Index, typename Mask>
     DRJIT_INLINE void scatter_reduce_(ReduceOp op, void *ptr, const Index &index_,
                                       const Mask &active_) const {
-        if (op != ReduceOp::Add)
-            drjit_raise("Packet scatter_reduce only support Add operation!");
+        if (!detail::packet_reduce_supported<Value>(op)) {
+            Base::scatter_reduce_(op, ptr, index_, active_);
+            return;
+        }
 
         if constexpr (sizeof(scalar_t<Index>) == 4) {
             __m512i index = index_.m;
@@ -926,17 +1109,18 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
                     __m512i value_peer = _mm512_maskz_permutexvar_epi32(todo, perm_idx, value);
                     perm_idx = _mm512_mask_permutexvar_epi32(perm_idx, todo,
                                                              perm_idx, perm_idx);
-                    value = _mm512_add_epi32(value, value_peer);
+                    value = _mm512_mask_mov_epi32(value, todo,
+                        detail::packet_reduce(op, Derived(value), Derived(value_peer)).m);
                     todo = _mm512_mask_cmp_epi32_mask(active, all_ones, perm_idx,
                                                       _MM_CMPINT_NE);
                 } while (!_mm512_kortestz(todo, todo));
             }
 
-            value = _mm512_add_epi32(value, value_orig);
+            value = detail::packet_reduce(op, Derived(value), Derived(value_orig)).m;
 
             _mm512_mask_i32scatter_epi32(ptr, active, index, value, 4);
         } else {
-            scatter_reduce_(ptr, int32_array_t<Index>(index_), op, active_);
+            scatter_reduce_(op, ptr, int32_array_t<Index>(index_), active_);
         }
     }
 
@@ -945,6 +1129,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
         return (Value) _mm_cvtsi128_si32(_mm512_castsi512_si128(_mm512_maskz_compress_epi32(mask.k, m)));
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_epi32(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((uint32_t) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_epi32(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 } DRJIT_MAY_ALIAS;
@@ -1080,10 +1275,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
                                        : _mm512_srlv_epi64(m, k.m);
     }
 
-    DRJIT_INLINE auto lt_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_LT)); }
-    DRJIT_INLINE auto gt_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_GT)); }
-    DRJIT_INLINE auto le_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_LE)); }
-    DRJIT_INLINE auto ge_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_GE)); }
+    #define DRJIT_CMP_INT64(op)                                                 \
+        (std::is_signed_v<Value> ? _mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_##op) \
+                                 : _mm512_cmp_epu64_mask(m, a.m, _MM_CMPINT_##op))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT64(LT)); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT64(GT)); }
+    DRJIT_INLINE auto le_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT64(LE)); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return mask_t<Derived>::from_k(DRJIT_CMP_INT64(GE)); }
+
+    #undef DRJIT_CMP_INT64
+
     DRJIT_INLINE auto eq_ (Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_EQ)); }
     DRJIT_INLINE auto neq_(Ref a) const { return mask_t<Derived>::from_k(_mm512_cmp_epi64_mask(m, a.m, _MM_CMPINT_NE)); }
 
@@ -1115,42 +1317,39 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
     }
 
     DRJIT_INLINE Derived mulhi_(Ref b) const {
-        if (std::is_unsigned_v<Value>) {
-            const __m512i low_bits = _mm512_set1_epi64(0xffffffffu);
-            __m512i al = m, bl = b.m;
-            __m512i ah = _mm512_srli_epi64(al, 32);
-            __m512i bh = _mm512_srli_epi64(bl, 32);
-
-            // 4x unsigned 32x32->64 bit multiplication
-            __m512i albl = _mm512_mul_epu32(al, bl);
-            __m512i albh = _mm512_mul_epu32(al, bh);
-            __m512i ahbl = _mm512_mul_epu32(ah, bl);
-            __m512i ahbh = _mm512_mul_epu32(ah, bh);
-
-            // Calculate a possible carry from the low bits of the multiplication.
-            __m512i carry = _mm512_add_epi64(
-                _mm512_srli_epi64(albl, 32),
-                _mm512_add_epi64(_mm512_and_epi64(albh, low_bits),
-                                 _mm512_and_epi64(ahbl, low_bits)));
-
-            __m512i s0 = _mm512_add_epi64(ahbh, _mm512_srli_epi64(carry, 32));
-            __m512i s1 = _mm512_add_epi64(_mm512_srli_epi64(albh, 32),
-                                          _mm512_srli_epi64(ahbl, 32));
-
-            return _mm512_add_epi64(s0, s1);
-        } else {
-            const Derived mask(0xffffffff);
-            const Derived a = derived();
-            Derived ah = sr<32>(a), bh = sr<32>(b),
-                    al = a & mask, bl = b & mask;
+        const __m512i low_bits = _mm512_set1_epi64(0xffffffffu);
+        __m512i al = m, bl = b.m;
+        __m512i ah = _mm512_srli_epi64(al, 32);
+        __m512i bh = _mm512_srli_epi64(bl, 32);
+
+        // 8x unsigned 32x32->64 bit multiplication
+        __m512i albl = _mm512_mul_epu32(al, bl);
+        __m512i albh = _mm512_mul_epu32(al, bh);
+        __m512i ahbl = _mm512_mul_epu32(ah, bl);
+        __m512i ahbh = _mm512_mul_epu32(ah, bh);
 
-            Derived albl_hi = _mm512_srli_epi64(_mm512_mul_epu32(m, b.m), 32);
+        // Calculate a possible carry from the low bits of the multiplication.
+        __m512i carry = _mm512_add_epi64(
+            _mm512_srli_epi64(albl, 32),
+            _mm512_add_epi64(_mm512_and_epi64(albh, low_bits),
+                             _mm512_and_epi64(ahbl, low_bits)));
 
-            Derived t = ah * bl + albl_hi;
-            Derived w1 = al * bh + (t & mask);
+        __m512i s0 = _mm512_add_epi64(ahbh, _mm512_srli_epi64(carry, 32));
+        __m512i s1 = _mm512_add_epi64(_mm512_srli_epi64(albh, 32),
+                                      _mm512_srli_epi64(ahbl, 32));
 
-            return ah * bh + sr<32>(t) + sr<32>(w1);
+        __m512i result = _mm512_add_epi64(s0, s1);
+
+        if constexpr (std::is_signed_v<Value>) {
+            /* Signed high product from the unsigned one: subtract 'b' if
+               'a' is negative, and 'a' if 'b' is negative */
+            __m512i fix = _mm512_add_epi64(
+                _mm512_and_epi64(_mm512_srai_epi64(al, 63), bl),
+                _mm512_and_epi64(_mm512_srai_epi64(bl, 63), al));
+            result = _mm512_sub_epi64(result, fix);
         }
+
+        return result;
     }
 
     DRJIT_INLINE Derived lzcnt_() const { return _mm512_lzcnt_epi64(m); }
@@ -1211,8 +1410,10 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
     template <typename Index, typename Mask>
     DRJIT_INLINE void scatter_reduce_(ReduceOp op, void *ptr, const Index &index_,
                                       const Mask &active_) const {
-        if (op != ReduceOp::Add)
-            drjit_raise("Packet scatter_reduce only support Add operation!");
+        if (!detail::packet_reduce_supported<Value>(op)) {
+            Base::scatter_reduce_(op, ptr, index_, active_);
+            return;
+        }
 
         if constexpr (sizeof(scalar_t<Index>) == 8) {
             __m512i index = index_.m;
@@ -1235,17 +1436,18 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
                     __m512i value_peer = _mm512_maskz_permutexvar_epi64(todo, perm_idx, value);
                     perm_idx = _mm512_mask_permutexvar_epi64(perm_idx, todo,
                                                              perm_idx, perm_idx);
-                    value = _mm512_add_epi64(value, value_peer);
+                    value = _mm512_mask_mov_epi64(value, todo,
+                        detail::packet_reduce(op, Derived(value), Derived(value_peer)).m);
                     todo = _mm512_mask_cmp_epi64_mask(active, all_ones, perm_idx,
                                                       _MM_CMPINT_NE);
                 } while (!_kortestz_mask8_u8(todo, todo));
             }
 
-            value = _mm512_add_epi64(value, value_orig);
+            value = detail::packet_reduce(op, Derived(value), Derived(value_orig)).m;
 
             _mm512_mask_i64scatter_epi64(ptr, active, index, value, 8);
         } else {
-            scatter_reduce_(ptr, int64_array_t<Index>(index_), op, active_);
+            scatter_reduce_(op, ptr, int64_array_t<Index>(index_), active_);
         }
     }
 
@@ -1254,6 +1456,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(64)
         return (Value) _mm_cvtsi128_si64(_mm512_castsi512_si128(_mm512_maskz_compress_epi64(mask.k, m)));
     }
 
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        _mm512_mask_compressstoreu_epi64(ptr, mask.k, m);
+        return (size_t) _mm_popcnt_u32((uint32_t) mask.k);
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        return _mm512_maskz_expandloadu_epi64(mask.k, ptr);
+    }
+
     //! @}
     // -----------------------------------------------------------------------
 
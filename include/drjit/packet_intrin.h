@@ -164,6 +164,12 @@
     static constexpr bool has_avx512 = false;
 #endif
 
+#if defined(DRJIT_X86_AVX512) && defined(DRJIT_X86_AVX512VBMI)
+    static constexpr bool has_avx512vbmi = true;
+#else
+    static constexpr bool has_avx512vbmi = false;
+#endif
+
 #if defined(DRJIT_ARM_NEON)
     static constexpr bool has_neon = true;
 #else
@@ -329,6 +335,54 @@ template <typename T> DRJIT_INLINE T tzcnt(T v) {
 //! @}
 // -----------------------------------------------------------------------
 
+// -----------------------------------------------------------------------
+//! @{ \name Emulation of AVX512 compress/expand operations using AVX2
+// -----------------------------------------------------------------------
+
+#if defined(DRJIT_X86_AVX2) && !defined(DRJIT_X86_AVX512)
+/* For each 8 bit mask, the tables store one 4 bit nibble per 32 bit lane. The
+   low 3 bits specify a source lane for _mm256_permutevar8x32_*(), and the
+   high bit indicates whether the lane receives a value. 'compress' moves the
+   selected lanes to the front, 'expand' distributes consecutive lanes to the
+   selected positions. */
+struct CompressTable {
+    uint32_t compress[256], expand[256];
+
+    constexpr CompressTable() : compress{}, expand{} {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t k = 0;
+            for (uint32_t j = 0; j < 8; ++j) {
+                if (i & (1u << j)) {
+                    compress[i] |= (8u | j) << (4 * k);
+                    expand[i] |= (8u | k) << (4 * j);
+                    k++;
+                }
+            }
+        }
+    }
+};
+
+inline constexpr CompressTable compress_table { };
+
+/* Unpack a table entry. Each lane holds its nibble in bits 28..31, i.e. the
+   sign bit can directly be used as a mask, and a right shift by 28 yields a
+   valid permutation index */
+DRJIT_INLINE __m256i compress_unpack(uint32_t entry) {
+    return _mm256_sllv_epi32(_mm256_set1_epi32((int) entry),
+                             _mm256_setr_epi32(28, 24, 20, 16, 12, 8, 4, 0));
+}
+
+/// Convert a mask of 4 64 bit lanes into a mask of 8 32 bit lanes
+DRJIT_INLINE uint32_t compress_widen(uint32_t mask) {
+    mask = (mask | (mask << 2)) & 0x33u;
+    mask = (mask | (mask << 1)) & 0x55u;
+    return mask * 3u;
+}
+#endif
+
+//! @}
+// -----------------------------------------------------------------------
+
 #define DRJIT_PACKET_DECLARE(Size)                                             \
     namespace detail {                                                         \
         template <typename Type> struct vectorize<Type, Size> {                \
@@ -0,0 +1,1265 @@
+/*
+    drjit/packet_neon.h -- Packet arrays, ARM NEON specialization
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+NAMESPACE_BEGIN(drjit)
+
+#if defined(DRJIT_ARM_64)
+DRJIT_PACKET_DECLARE(16)
+#else
+/* 32 bit ARM lacks most double precision / 64 bit integer vector operations */
+DRJIT_PACKET_DECLARE_COND(16, enable_if_t<sizeof(Type) == 4>)
+#endif
+DRJIT_PACKET_DECLARE(12)
+
+NAMESPACE_BEGIN(detail)
+
+/// Gather the most significant bit of each 32 bit lane (like _mm_movemask_ps)
+DRJIT_INLINE uint32_t neon_movemask_u32(uint32x4_t v) {
+    const int32_t shift[4] = { 0, 1, 2, 3 };
+    uint32x4_t t = vshlq_u32(vshrq_n_u32(v, 31), vld1q_s32(shift));
+#if defined(DRJIT_ARM_64)
+    return vaddvq_u32(t);
+#else
+    uint32x2_t t2 = vorr_u32(vget_low_u32(t), vget_high_u32(t));
+    return vget_lane_u32(vpadd_u32(t2, t2), 0);
+#endif
+}
+
+/// Number of active lanes in a 32 bit mask
+DRJIT_INLINE uint32_t neon_count_u32(uint32x4_t v) {
+    uint32x4_t t = vshrq_n_u32(v, 31);
+#if defined(DRJIT_ARM_64)
+    return vaddvq_u32(t);
+#else
+    uint32x2_t t2 = vadd_u32(vget_low_u32(t), vget_high_u32(t));
+    return vget_lane_u32(vpadd_u32(t2, t2), 0);
+#endif
+}
+
+/// Expand 4 booleans into a mask with 32 bit lanes
+DRJIT_INLINE uint32x4_t neon_bool_mask_u32(const void *ptr) {
+    uint32_t ival;
+    memcpy(&ival, ptr, 4);
+    int8x8_t b = vreinterpret_s8_u8(
+        vcgt_u8(vcreate_u8((uint64_t) ival), vdup_n_u8(0)));
+    return vreinterpretq_u32_s32(vmovl_s16(vget_low_s16(vmovl_s8(b))));
+}
+
+#if defined(DRJIT_ARM_64)
+/// Expand 2 booleans into a mask with 64 bit lanes
+DRJIT_INLINE uint64x2_t neon_bool_mask_u64(const void *ptr) {
+    uint16_t ival;
+    memcpy(&ival, ptr, 2);
+    int8x8_t b = vreinterpret_s8_u8(
+        vcgt_u8(vcreate_u8((uint64_t) ival), vdup_n_u8(0)));
+    return vreinterpretq_u64_s64(vmovl_s32(
+        vget_low_s32(vmovl_s16(vget_low_s16(vmovl_s8(b))))));
+}
+
+DRJIT_INLINE uint64x2_t vmvnq_u64(uint64x2_t v) {
+    return vreinterpretq_u64_u32(vmvnq_u32(vreinterpretq_u32_u64(v)));
+}
+
+DRJIT_INLINE uint32_t neon_movemask_u64(uint64x2_t v) {
+    uint64x2_t t = vshrq_n_u64(v, 63);
+    return (uint32_t) (vgetq_lane_u64(t, 0) | (vgetq_lane_u64(t, 1) << 1));
+}
+#endif
+
+NAMESPACE_END(detail)
+
+/* NEON lacks an immediate shuffle instruction, use the compiler's generic
+   vector shuffle so that a suitable permutation sequence is selected */
+#if defined(__clang__)
+#  define DRJIT_NEON_SHUFFLE(v, Mask, ...) __builtin_shufflevector(v, v, __VA_ARGS__)
+#elif defined(__GNUC__)
+#  define DRJIT_NEON_SHUFFLE(v, Mask, ...) __builtin_shuffle(v, Mask{ __VA_ARGS__ })
+#endif
+
+/// Partial overload of StaticArrayImpl using NEON intrinsics (single precision)
+template <bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<float, 4, IsMask_, Derived_>
+  : StaticArrayBase<float, 4, IsMask_, Derived_> {
+
+    DRJIT_PACKET_TYPE(float, 4, float32x4_t)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value) : m(vdupq_n_f32((float) value)) { }
+
+    DRJIT_INLINE StaticArrayImpl(Value v0, Value v1, Value v2, Value v3) {
+        alignas(16) Value data[4] = { v0, v1, v2, v3 };
+        m = vld1q_f32(data);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(float) : m(a.derived().m) { }
+    DRJIT_CONVERT(int32_t) : m(vcvtq_f32_s32(vreinterpretq_s32_u32(a.derived().m))) { }
+    DRJIT_CONVERT(uint32_t) : m(vcvtq_f32_u32(a.derived().m)) { }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_CONVERT(half)
+        : m(vcvt_f32_f16(vreinterpret_f16_u16(
+              vld1_u16((const uint16_t *) a.derived().data())))) { }
+
+    DRJIT_CONVERT(double)
+        : m(vcombine_f32(vcvt_f32_f64(low(a).m), vcvt_f32_f64(high(a).m))) { }
+#endif
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET(float) : m(a.derived().m) { }
+    DRJIT_REINTERPRET(int32_t) : m(vreinterpretq_f32_u32(a.derived().m)) { }
+    DRJIT_REINTERPRET(uint32_t) : m(vreinterpretq_f32_u32(a.derived().m)) { }
+
+    DRJIT_REINTERPRET_MASK(bool)
+        : m(vreinterpretq_f32_u32(detail::neon_bool_mask_u32(a.derived().data()))) { }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_REINTERPRET_MASK(double)
+        : m(vreinterpretq_f32_u32(
+              vcombine_u32(vmovn_u64(vreinterpretq_u64_f64(low(a).m)),
+                           vmovn_u64(vreinterpretq_u64_f64(high(a).m))))) { }
+
+    DRJIT_REINTERPRET_MASK(int64_t)
+        : m(vreinterpretq_f32_u32(vcombine_u32(vmovn_u64(low(a).m),
+                                               vmovn_u64(high(a).m)))) { }
+
+    DRJIT_REINTERPRET_MASK(uint64_t)
+        : m(vreinterpretq_f32_u32(vcombine_u32(vmovn_u64(low(a).m),
+                                               vmovn_u64(high(a).m)))) { }
+#endif
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : StaticArrayImpl(a1.entry(0), a1.entry(1), a2.entry(0), a2.entry(1)) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0), entry(1)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(2), entry(3)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Derived add_(Ref a) const { return vaddq_f32(m, a.m); }
+    DRJIT_INLINE Derived sub_(Ref a) const { return vsubq_f32(m, a.m); }
+    DRJIT_INLINE Derived mul_(Ref a) const { return vmulq_f32(m, a.m); }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_INLINE Derived div_(Ref a) const { return vdivq_f32(m, a.m); }
+#endif
+
+    DRJIT_INLINE Derived not_() const {
+        return vreinterpretq_f32_u32(vmvnq_u32(vreinterpretq_u32_f32(m)));
+    }
+
+    DRJIT_INLINE Derived neg_() const { return vnegq_f32(m); }
+
+    template <typename T> DRJIT_INLINE Derived or_(const T &a) const {
+        return vreinterpretq_f32_u32(vorrq_u32(vreinterpretq_u32_f32(m),
+                                               vreinterpretq_u32_f32(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived and_(const T &a) const {
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(m),
+                                               vreinterpretq_u32_f32(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const {
+        return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(m),
+                                               vreinterpretq_u32_f32(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived xor_(const T &a) const {
+        return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(m),
+                                               vreinterpretq_u32_f32(a.m)));
+    }
+
+    #define DRJIT_COMP(op) mask_t<Derived>(vreinterpretq_f32_u32(op(m, a.m)))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(vcltq_f32); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(vcgtq_f32); }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(vcleq_f32); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(vcgeq_f32); }
+
+    DRJIT_INLINE auto eq_ (Ref a) const {
+        using Int = int_array_t<Derived>;
+        if constexpr (IsMask_)
+            return mask_t<Derived>(eq(Int(derived()), Int(a)));
+        else
+            return DRJIT_COMP(vceqq_f32);
+    }
+
+    DRJIT_INLINE auto neq_(Ref a) const {
+        using Int = int_array_t<Derived>;
+        if constexpr (IsMask_)
+            return mask_t<Derived>(neq(Int(derived()), Int(a)));
+        else
+            return mask_t<Derived>(
+                vreinterpretq_f32_u32(vmvnq_u32(vceqq_f32(m, a.m))));
+    }
+
+    #undef DRJIT_COMP
+
+    DRJIT_INLINE Derived abs_()          const { return vabsq_f32(m); }
+    DRJIT_INLINE Derived minimum_(Ref b) const { return vminq_f32(b.m, m); }
+    DRJIT_INLINE Derived maximum_(Ref b) const { return vmaxq_f32(b.m, m); }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_INLINE Derived sqrt_()  const { return vsqrtq_f32(m); }
+    DRJIT_INLINE Derived floor_() const { return vrndmq_f32(m); }
+    DRJIT_INLINE Derived ceil_()  const { return vrndpq_f32(m); }
+    DRJIT_INLINE Derived round_() const { return vrndnq_f32(m); }
+    DRJIT_INLINE Derived trunc_() const { return vrndq_f32(m); }
+#endif
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return vbslq_f32(vreinterpretq_u32_f32(m.m), t.m, f.m);
+    }
+
+#if defined(DRJIT_ARM_FMA)
+    DRJIT_INLINE Derived fmadd_   (Ref b, Ref c) const { return vfmaq_f32(c.m, m, b.m); }
+    DRJIT_INLINE Derived fmsub_   (Ref b, Ref c) const { return vfmaq_f32(vnegq_f32(c.m), m, b.m); }
+    DRJIT_INLINE Derived fnmadd_  (Ref b, Ref c) const { return vfmsq_f32(c.m, m, b.m); }
+    DRJIT_INLINE Derived fnmsub_  (Ref b, Ref c) const { return vnegq_f32(vfmaq_f32(c.m, m, b.m)); }
+#endif
+
+#if defined(DRJIT_NEON_SHUFFLE)
+    template <int I0, int I1, int I2, int I3>
+    DRJIT_INLINE Derived shuffle_() const {
+        return DRJIT_NEON_SHUFFLE(m, uint32x4_t, I0, I1, I2, I3);
+    }
+#endif
+
+    DRJIT_INLINE Derived rcp_() const {
+        // Initial estimate has a relative error < 2^-8
+        float32x4_t r = vrecpeq_f32(m);
+
+        // Refine using two Newton-Raphson iterations (vrecpsq handles 0*inf)
+        r = vmulq_f32(vrecpsq_f32(m, r), r);
+        r = vmulq_f32(vrecpsq_f32(m, r), r);
+
+        return r;
+    }
+
+    DRJIT_INLINE Derived rsqrt_() const {
+        // Initial estimate has a relative error < 2^-8
+        float32x4_t r = vrsqrteq_f32(m);
+
+        // Refine using two Newton-Raphson iterations (vrsqrtsq handles 0*inf)
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(r, r), m), r);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(r, r), m), r);
+
+        return r;
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                     \
+        DRJIT_INLINE Value name##_() const {                                  \
+            float32x2_t t = v##op##_f32(vget_low_f32(m), vget_high_f32(m));   \
+            return vget_lane_f32(v##op##_f32(t, vrev64_f32(t)), 0);           \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum, add)
+    DRJIT_HORIZONTAL_OP(prod, mul)
+    DRJIT_HORIZONTAL_OP(min, min)
+    DRJIT_HORIZONTAL_OP(max, max)
+
+    #undef DRJIT_HORIZONTAL_OP
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_INLINE bool all_() const { return vminvq_u32(vreinterpretq_u32_f32(m)) != 0; }
+    DRJIT_INLINE bool any_() const { return vmaxvq_u32(vreinterpretq_u32_f32(m)) != 0; }
+#else
+    DRJIT_INLINE bool all_() const { return bitmask_() == 0xF; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0x0; }
+#endif
+
+    DRJIT_INLINE uint32_t bitmask_() const {
+        return detail::neon_movemask_u32(vreinterpretq_u32_f32(m));
+    }
+
+    DRJIT_INLINE size_t count_() const {
+        return (size_t) detail::neon_count_u32(vreinterpretq_u32_f32(m));
+    }
+
+    DRJIT_INLINE Value dot_(Ref a) const {
+        return Derived(vmulq_f32(m, a.m)).sum_();
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        vst1q_f32((Value *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        vst1q_f32((Value *) ptr, m);
+    }
+
+#if defined(DRJIT_ARM_64)
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        vst1_u16((uint16_t *) ptr, vreinterpret_u16_f16(vcvt_f16_f32(m)));
+    }
+#endif
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return vld1q_f32((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return vld1q_f32((const Value *) ptr);
+    }
+
+    static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_f32(0.f); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+/// Partial overload of StaticArrayImpl using NEON intrinsics (32 bit integers)
+template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<Value_, 4, IsMask_, Derived_, enable_if_int32_t<Value_>>
+  : StaticArrayBase<Value_, 4, IsMask_, Derived_> {
+
+    DRJIT_PACKET_TYPE(Value_, 4, uint32x4_t)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value) : m(vdupq_n_u32((uint32_t) value)) { }
+
+    DRJIT_INLINE StaticArrayImpl(Value v0, Value v1, Value v2, Value v3) {
+        alignas(16) uint32_t data[4] = { (uint32_t) v0, (uint32_t) v1,
+                                         (uint32_t) v2, (uint32_t) v3 };
+        m = vld1q_u32(data);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(float) {
+        if constexpr (std::is_signed_v<Value>)
+            m = vreinterpretq_u32_s32(vcvtq_s32_f32(a.derived().m));
+        else
+            m = vcvtq_u32_f32(a.derived().m);
+    }
+
+    DRJIT_CONVERT(int32_t) : m(a.derived().m) { }
+    DRJIT_CONVERT(uint32_t) : m(a.derived().m) { }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_CONVERT(double) {
+        if constexpr (std::is_signed_v<Value>)
+            m = vreinterpretq_u32_s32(
+                vcombine_s32(vmovn_s64(vcvtq_s64_f64(low(a).m)),
+                             vmovn_s64(vcvtq_s64_f64(high(a).m))));
+        else
+            m = vcombine_u32(vmovn_u64(vcvtq_u64_f64(low(a).m)),
+                             vmovn_u64(vcvtq_u64_f64(high(a).m)));
+    }
+
+    DRJIT_CONVERT(int64_t)
+        : m(vcombine_u32(vmovn_u64(low(a).m), vmovn_u64(high(a).m))) { }
+    DRJIT_CONVERT(uint64_t)
+        : m(vcombine_u32(vmovn_u64(low(a).m), vmovn_u64(high(a).m))) { }
+#endif
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET(float) : m(vreinterpretq_u32_f32(a.derived().m)) { }
+    DRJIT_REINTERPRET(int32_t) : m(a.derived().m) { }
+    DRJIT_REINTERPRET(uint32_t) : m(a.derived().m) { }
+
+    DRJIT_REINTERPRET_MASK(bool)
+        : m(detail::neon_bool_mask_u32(a.derived().data())) { }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_REINTERPRET_MASK(double)
+        : m(vcombine_u32(vmovn_u64(vreinterpretq_u64_f64(low(a).m)),
+                         vmovn_u64(vreinterpretq_u64_f64(high(a).m)))) { }
+
+    DRJIT_REINTERPRET_MASK(int64_t)
+        : m(vcombine_u32(vmovn_u64(low(a).m), vmovn_u64(high(a).m))) { }
+
+    DRJIT_REINTERPRET_MASK(uint64_t)
+        : m(vcombine_u32(vmovn_u64(low(a).m), vmovn_u64(high(a).m))) { }
+#endif
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : StaticArrayImpl(a1.entry(0), a1.entry(1), a2.entry(0), a2.entry(1)) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0), entry(1)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(2), entry(3)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Derived add_(Ref a) const { return vaddq_u32(m, a.m); }
+    DRJIT_INLINE Derived sub_(Ref a) const { return vsubq_u32(m, a.m); }
+    DRJIT_INLINE Derived mul_(Ref a) const { return vmulq_u32(m, a.m); }
+
+    DRJIT_INLINE Derived not_() const { return vmvnq_u32(m); }
+
+    DRJIT_INLINE Derived neg_() const {
+        return vreinterpretq_u32_s32(vnegq_s32(vreinterpretq_s32_u32(m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived or_    (const T &a) const { return vorrq_u32(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived and_   (const T &a) const { return vandq_u32(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const { return vbicq_u32(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived xor_   (const T &a) const { return veorq_u32(m, a.m); }
+
+    template <int Imm> DRJIT_INLINE Derived sl_() const {
+        return vshlq_n_u32(m, Imm);
+    }
+
+    template <int Imm> DRJIT_INLINE Derived sr_() const {
+        if constexpr (Imm == 0)
+            return derived();
+        else if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u32_s32(
+                vshrq_n_s32(vreinterpretq_s32_u32(m), Imm));
+        else
+            return vshrq_n_u32(m, Imm);
+    }
+
+    DRJIT_INLINE Derived sl_(Ref k) const {
+        return vshlq_u32(m, vreinterpretq_s32_u32(k.m));
+    }
+
+    DRJIT_INLINE Derived sr_(Ref k) const {
+        // NEON only has a left shift, a negative shift amount shifts right
+        int32x4_t shift = vnegq_s32(vreinterpretq_s32_u32(k.m));
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u32_s32(
+                vshlq_s32(vreinterpretq_s32_u32(m), shift));
+        else
+            return vshlq_u32(m, shift);
+    }
+
+    #define DRJIT_COMP(op)                                                    \
+        mask_t<Derived>(std::is_signed_v<Value>                               \
+                            ? op##_s32(vreinterpretq_s32_u32(m),              \
+                                       vreinterpretq_s32_u32(a.m))            \
+                            : op##_u32(m, a.m))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(vcltq); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(vcgtq); }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(vcleq); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(vcgeq); }
+
+    #undef DRJIT_COMP
+
+    DRJIT_INLINE auto eq_ (Ref a) const { return mask_t<Derived>(vceqq_u32(m, a.m)); }
+    DRJIT_INLINE auto neq_(Ref a) const { return mask_t<Derived>(vmvnq_u32(vceqq_u32(m, a.m))); }
+
+    DRJIT_INLINE Derived minimum_(Ref a) const {
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u32_s32(vminq_s32(vreinterpretq_s32_u32(a.m),
+                                                   vreinterpretq_s32_u32(m)));
+        else
+            return vminq_u32(a.m, m);
+    }
+
+    DRJIT_INLINE Derived maximum_(Ref a) const {
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u32_s32(vmaxq_s32(vreinterpretq_s32_u32(a.m),
+                                                   vreinterpretq_s32_u32(m)));
+        else
+            return vmaxq_u32(a.m, m);
+    }
+
+    DRJIT_INLINE Derived abs_() const {
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u32_s32(vabsq_s32(vreinterpretq_s32_u32(m)));
+        else
+            return m;
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return vbslq_u32(m.m, t.m, f.m);
+    }
+
+#if defined(DRJIT_NEON_SHUFFLE)
+    template <int I0, int I1, int I2, int I3>
+    DRJIT_INLINE Derived shuffle_() const {
+        return DRJIT_NEON_SHUFFLE(m, uint32x4_t, I0, I1, I2, I3);
+    }
+#endif
+
+    DRJIT_INLINE Derived mulhi_(Ref a) const {
+        if constexpr (std::is_signed_v<Value>) {
+            int32x4_t ms = vreinterpretq_s32_u32(m),
+                      as = vreinterpretq_s32_u32(a.m);
+            int64x2_t lo = vmull_s32(vget_low_s32(ms),  vget_low_s32(as)),
+                      hi = vmull_s32(vget_high_s32(ms), vget_high_s32(as));
+            return vreinterpretq_u32_s32(
+                vcombine_s32(vshrn_n_s64(lo, 32), vshrn_n_s64(hi, 32)));
+        } else {
+            uint64x2_t lo = vmull_u32(vget_low_u32(m),  vget_low_u32(a.m)),
+                       hi = vmull_u32(vget_high_u32(m), vget_high_u32(a.m));
+            return vcombine_u32(vshrn_n_u64(lo, 32), vshrn_n_u64(hi, 32));
+        }
+    }
+
+    DRJIT_INLINE Derived lzcnt_() const { return vclzq_u32(m); }
+    DRJIT_INLINE Derived tzcnt_() const { return Value(32) - lzcnt(~derived() & (derived() - Value(1))); }
+
+    DRJIT_INLINE Derived popcnt_() const {
+        return vpaddlq_u16(vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u32(m))));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                     \
+        DRJIT_INLINE Value name##_() const {                                  \
+            if constexpr (std::is_signed_v<Value>) {                          \
+                int32x4_t v = vreinterpretq_s32_u32(m);                       \
+                int32x2_t t = v##op##_s32(vget_low_s32(v), vget_high_s32(v)); \
+                return (Value) vget_lane_s32(v##op##_s32(t, vrev64_s32(t)), 0); \
+            } else {                                                          \
+                uint32x2_t t = v##op##_u32(vget_low_u32(m), vget_high_u32(m)); \
+                return (Value) vget_lane_u32(v##op##_u32(t, vrev64_u32(t)), 0); \
+            }                                                                 \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum, add)
+    DRJIT_HORIZONTAL_OP(prod, mul)
+    DRJIT_HORIZONTAL_OP(min, min)
+    DRJIT_HORIZONTAL_OP(max, max)
+
+    #undef DRJIT_HORIZONTAL_OP
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_INLINE bool all_() const { return vminvq_u32(m) != 0; }
+    DRJIT_INLINE bool any_() const { return vmaxvq_u32(m) != 0; }
+#else
+    DRJIT_INLINE bool all_() const { return bitmask_() == 0xF; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0x0; }
+#endif
+
+    DRJIT_INLINE uint32_t bitmask_() const { return detail::neon_movemask_u32(m); }
+    DRJIT_INLINE size_t count_() const { return (size_t) detail::neon_count_u32(m); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        vst1q_u32((uint32_t *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        vst1q_u32((uint32_t *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return vld1q_u32((const uint32_t *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return vld1q_u32((const uint32_t *) ptr);
+    }
+
+    static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_u32(0); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+#if defined(DRJIT_ARM_64)
+/// Partial overload of StaticArrayImpl using NEON intrinsics (double precision)
+template <bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<double, 2, IsMask_, Derived_>
+  : StaticArrayBase<double, 2, IsMask_, Derived_> {
+
+    DRJIT_PACKET_TYPE(double, 2, float64x2_t)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value) : m(vdupq_n_f64((double) value)) { }
+
+    DRJIT_INLINE StaticArrayImpl(Value v0, Value v1) {
+        alignas(16) Value data[2] = { v0, v1 };
+        m = vld1q_f64(data);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    /* No vectorized conversions from float/[u]int32_t (too small) */
+
+    DRJIT_CONVERT(double) : m(a.derived().m) { }
+    DRJIT_CONVERT(int64_t) : m(vcvtq_f64_s64(vreinterpretq_s64_u64(a.derived().m))) { }
+    DRJIT_CONVERT(uint64_t) : m(vcvtq_f64_u64(a.derived().m)) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET_MASK(bool)
+        : m(vreinterpretq_f64_u64(detail::neon_bool_mask_u64(a.derived().data()))) { }
+
+    DRJIT_REINTERPRET(double) : m(a.derived().m) { }
+    DRJIT_REINTERPRET(int64_t) : m(vreinterpretq_f64_u64(a.derived().m)) { }
+    DRJIT_REINTERPRET(uint64_t) : m(vreinterpretq_f64_u64(a.derived().m)) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : StaticArrayImpl(a1.entry(0), a2.entry(0)) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(1)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Derived add_(Ref a) const { return vaddq_f64(m, a.m); }
+    DRJIT_INLINE Derived sub_(Ref a) const { return vsubq_f64(m, a.m); }
+    DRJIT_INLINE Derived mul_(Ref a) const { return vmulq_f64(m, a.m); }
+    DRJIT_INLINE Derived div_(Ref a) const { return vdivq_f64(m, a.m); }
+
+    DRJIT_INLINE Derived not_() const {
+        return vreinterpretq_f64_u64(detail::vmvnq_u64(vreinterpretq_u64_f64(m)));
+    }
+
+    DRJIT_INLINE Derived neg_() const { return vnegq_f64(m); }
+
+    template <typename T> DRJIT_INLINE Derived or_(const T &a) const {
+        return vreinterpretq_f64_u64(vorrq_u64(vreinterpretq_u64_f64(m),
+                                               vreinterpretq_u64_f64(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived and_(const T &a) const {
+        return vreinterpretq_f64_u64(vandq_u64(vreinterpretq_u64_f64(m),
+                                               vreinterpretq_u64_f64(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const {
+        return vreinterpretq_f64_u64(vbicq_u64(vreinterpretq_u64_f64(m),
+                                               vreinterpretq_u64_f64(a.m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived xor_(const T &a) const {
+        return vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(m),
+                                               vreinterpretq_u64_f64(a.m)));
+    }
+
+    #define DRJIT_COMP(op) mask_t<Derived>(vreinterpretq_f64_u64(op(m, a.m)))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(vcltq_f64); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(vcgtq_f64); }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(vcleq_f64); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(vcgeq_f64); }
+
+    DRJIT_INLINE auto eq_ (Ref a) const {
+        using Int = int_array_t<Derived>;
+        if constexpr (IsMask_)
+            return mask_t<Derived>(eq(Int(derived()), Int(a)));
+        else
+            return DRJIT_COMP(vceqq_f64);
+    }
+
+    DRJIT_INLINE auto neq_(Ref a) const {
+        using Int = int_array_t<Derived>;
+        if constexpr (IsMask_)
+            return mask_t<Derived>(neq(Int(derived()), Int(a)));
+        else
+            return mask_t<Derived>(vreinterpretq_f64_u64(
+                detail::vmvnq_u64(vceqq_f64(m, a.m))));
+    }
+
+    #undef DRJIT_COMP
+
+    DRJIT_INLINE Derived abs_()          const { return vabsq_f64(m); }
+    DRJIT_INLINE Derived minimum_(Ref b) const { return vminq_f64(b.m, m); }
+    DRJIT_INLINE Derived maximum_(Ref b) const { return vmaxq_f64(b.m, m); }
+    DRJIT_INLINE Derived sqrt_()         const { return vsqrtq_f64(m); }
+    DRJIT_INLINE Derived floor_()        const { return vrndmq_f64(m); }
+    DRJIT_INLINE Derived ceil_()         const { return vrndpq_f64(m); }
+    DRJIT_INLINE Derived round_()        const { return vrndnq_f64(m); }
+    DRJIT_INLINE Derived trunc_()        const { return vrndq_f64(m); }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return vbslq_f64(vreinterpretq_u64_f64(m.m), t.m, f.m);
+    }
+
+#if defined(DRJIT_ARM_FMA)
+    DRJIT_INLINE Derived fmadd_   (Ref b, Ref c) const { return vfmaq_f64(c.m, m, b.m); }
+    DRJIT_INLINE Derived fmsub_   (Ref b, Ref c) const { return vfmaq_f64(vnegq_f64(c.m), m, b.m); }
+    DRJIT_INLINE Derived fnmadd_  (Ref b, Ref c) const { return vfmsq_f64(c.m, m, b.m); }
+    DRJIT_INLINE Derived fnmsub_  (Ref b, Ref c) const { return vnegq_f64(vfmaq_f64(c.m, m, b.m)); }
+#endif
+
+#if defined(DRJIT_NEON_SHUFFLE)
+    template <int I0, int I1>
+    DRJIT_INLINE Derived shuffle_() const {
+        return DRJIT_NEON_SHUFFLE(m, uint64x2_t, I0, I1);
+    }
+#endif
+
+    DRJIT_INLINE Derived rcp_() const {
+        // Initial estimate has a relative error < 2^-8
+        float64x2_t r = vrecpeq_f64(m);
+
+        // Refine using three Newton-Raphson iterations
+        DRJIT_UNROLL for (int i = 0; i < 3; ++i)
+            r = vmulq_f64(vrecpsq_f64(m, r), r);
+
+        return r;
+    }
+
+    DRJIT_INLINE Derived rsqrt_() const {
+        // Initial estimate has a relative error < 2^-8
+        float64x2_t r = vrsqrteq_f64(m);
+
+        // Refine using three Newton-Raphson iterations
+        DRJIT_UNROLL for (int i = 0; i < 3; ++i)
+            r = vmulq_f64(vrsqrtsq_f64(vmulq_f64(r, r), m), r);
+
+        return r;
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Value sum_()  const { return vaddvq_f64(m); }
+    DRJIT_INLINE Value prod_() const { return vgetq_lane_f64(m, 0) * vgetq_lane_f64(m, 1); }
+    DRJIT_INLINE Value min_()  const { return vminvq_f64(m); }
+    DRJIT_INLINE Value max_()  const { return vmaxvq_f64(m); }
+
+    DRJIT_INLINE bool all_() const { return bitmask_() == 0x3; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0x0; }
+
+    DRJIT_INLINE uint32_t bitmask_() const {
+        return detail::neon_movemask_u64(vreinterpretq_u64_f64(m));
+    }
+
+    DRJIT_INLINE size_t count_() const {
+        return (size_t) vaddvq_u64(vshrq_n_u64(vreinterpretq_u64_f64(m), 63));
+    }
+
+    DRJIT_INLINE Value dot_(Ref a) const {
+        return vaddvq_f64(vmulq_f64(m, a.m));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        vst1q_f64((Value *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        vst1q_f64((Value *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return vld1q_f64((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return vld1q_f64((const Value *) ptr);
+    }
+
+    static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_f64(0.0); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+/// Partial overload of StaticArrayImpl using NEON intrinsics (64 bit integers)
+template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<Value_, 2, IsMask_, Derived_, enable_if_int64_t<Value_>>
+  : StaticArrayBase<Value_, 2, IsMask_, Derived_> {
+
+    DRJIT_PACKET_TYPE(Value_, 2, uint64x2_t)
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Value constructors
+    // -----------------------------------------------------------------------
+
+    template <typename T, enable_if_scalar_t<T> = 0>
+    DRJIT_INLINE StaticArrayImpl(T value) : m(vdupq_n_u64((uint64_t) value)) { }
+
+    DRJIT_INLINE StaticArrayImpl(Value v0, Value v1) {
+        alignas(16) uint64_t data[2] = { (uint64_t) v0, (uint64_t) v1 };
+        m = vld1q_u64(data);
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Type converting constructors
+    // -----------------------------------------------------------------------
+
+    DRJIT_CONVERT(double) {
+        if constexpr (std::is_signed_v<Value>)
+            m = vreinterpretq_u64_s64(vcvtq_s64_f64(a.derived().m));
+        else
+            m = vcvtq_u64_f64(a.derived().m);
+    }
+
+    DRJIT_CONVERT(int64_t) : m(a.derived().m) { }
+    DRJIT_CONVERT(uint64_t) : m(a.derived().m) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Reinterpreting constructors, mask converters
+    // -----------------------------------------------------------------------
+
+    DRJIT_REINTERPRET_MASK(bool)
+        : m(detail::neon_bool_mask_u64(a.derived().data())) { }
+
+    DRJIT_REINTERPRET(double) : m(vreinterpretq_u64_f64(a.derived().m)) { }
+    DRJIT_REINTERPRET(int64_t) : m(a.derived().m) { }
+    DRJIT_REINTERPRET(uint64_t) : m(a.derived().m) { }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Converting from/to half size vectors
+    // -----------------------------------------------------------------------
+
+    StaticArrayImpl(const Array1 &a1, const Array2 &a2)
+        : StaticArrayImpl(a1.entry(0), a2.entry(0)) { }
+
+    DRJIT_INLINE Array1 low_()  const { return Array1(entry(0)); }
+    DRJIT_INLINE Array2 high_() const { return Array2(entry(1)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Vertical operations
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE Derived add_(Ref a) const { return vaddq_u64(m, a.m); }
+    DRJIT_INLINE Derived sub_(Ref a) const { return vsubq_u64(m, a.m); }
+
+    DRJIT_INLINE Derived not_() const { return detail::vmvnq_u64(m); }
+
+    DRJIT_INLINE Derived neg_() const {
+        return vreinterpretq_u64_s64(vnegq_s64(vreinterpretq_s64_u64(m)));
+    }
+
+    template <typename T> DRJIT_INLINE Derived or_    (const T &a) const { return vorrq_u64(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived and_   (const T &a) const { return vandq_u64(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived andnot_(const T &a) const { return vbicq_u64(m, a.m); }
+    template <typename T> DRJIT_INLINE Derived xor_   (const T &a) const { return veorq_u64(m, a.m); }
+
+    template <int Imm> DRJIT_INLINE Derived sl_() const {
+        return vshlq_n_u64(m, Imm);
+    }
+
+    template <int Imm> DRJIT_INLINE Derived sr_() const {
+        if constexpr (Imm == 0)
+            return derived();
+        else if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u64_s64(
+                vshrq_n_s64(vreinterpretq_s64_u64(m), Imm));
+        else
+            return vshrq_n_u64(m, Imm);
+    }
+
+    DRJIT_INLINE Derived sl_(Ref k) const {
+        return vshlq_u64(m, vreinterpretq_s64_u64(k.m));
+    }
+
+    DRJIT_INLINE Derived sr_(Ref k) const {
+        // NEON only has a left shift, a negative shift amount shifts right
+        int64x2_t shift = vnegq_s64(vreinterpretq_s64_u64(k.m));
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u64_s64(
+                vshlq_s64(vreinterpretq_s64_u64(m), shift));
+        else
+            return vshlq_u64(m, shift);
+    }
+
+    #define DRJIT_COMP(op)                                                    \
+        mask_t<Derived>(std::is_signed_v<Value>                               \
+                            ? op##_s64(vreinterpretq_s64_u64(m),              \
+                                       vreinterpretq_s64_u64(a.m))            \
+                            : op##_u64(m, a.m))
+
+    DRJIT_INLINE auto lt_ (Ref a) const { return DRJIT_COMP(vcltq); }
+    DRJIT_INLINE auto gt_ (Ref a) const { return DRJIT_COMP(vcgtq); }
+    DRJIT_INLINE auto le_ (Ref a) const { return DRJIT_COMP(vcleq); }
+    DRJIT_INLINE auto ge_ (Ref a) const { return DRJIT_COMP(vcgeq); }
+
+    #undef DRJIT_COMP
+
+    DRJIT_INLINE auto eq_ (Ref a) const { return mask_t<Derived>(vceqq_u64(m, a.m)); }
+    DRJIT_INLINE auto neq_(Ref a) const { return mask_t<Derived>(detail::vmvnq_u64(vceqq_u64(m, a.m))); }
+
+    DRJIT_INLINE Derived minimum_(Ref a) const {
+        return select(derived() < a, derived(), a);
+    }
+
+    DRJIT_INLINE Derived maximum_(Ref a) const {
+        return select(derived() > a, derived(), a);
+    }
+
+    DRJIT_INLINE Derived abs_() const {
+        if constexpr (std::is_signed_v<Value>)
+            return vreinterpretq_u64_s64(vabsq_s64(vreinterpretq_s64_u64(m)));
+        else
+            return m;
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived select_(const Mask &m, Ref t, Ref f) {
+        return vbslq_u64(m.m, t.m, f.m);
+    }
+
+#if defined(DRJIT_NEON_SHUFFLE)
+    template <int I0, int I1>
+    DRJIT_INLINE Derived shuffle_() const {
+        return DRJIT_NEON_SHUFFLE(m, uint64x2_t, I0, I1);
+    }
+#endif
+
+    DRJIT_INLINE Derived popcnt_() const {
+        return vpaddlq_u32(vpaddlq_u16(vpaddlq_u8(vcntq_u8(vreinterpretq_u8_u64(m)))));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                     \
+        DRJIT_INLINE Value name##_() const {                                  \
+            Value t1 = Value(vgetq_lane_u64(m, 1));                           \
+            Value t2 = Value(vgetq_lane_u64(m, 0));                           \
+            return op;                                                        \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum,  t1 + t2)
+    DRJIT_HORIZONTAL_OP(prod, t1 * t2)
+    DRJIT_HORIZONTAL_OP(min,  minimum(t1, t2))
+    DRJIT_HORIZONTAL_OP(max,  maximum(t1, t2))
+
+    #undef DRJIT_HORIZONTAL_OP
+
+    DRJIT_INLINE bool all_() const { return bitmask_() == 0x3; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0x0; }
+
+    DRJIT_INLINE uint32_t bitmask_() const { return detail::neon_movemask_u64(m); }
+    DRJIT_INLINE size_t count_() const { return (size_t) vaddvq_u64(vshrq_n_u64(m, 63)); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Initialization, loading/writing data
+    // -----------------------------------------------------------------------
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        vst1q_u64((uint64_t *) DRJIT_ASSUME_ALIGNED(ptr, 16), m);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        vst1q_u64((uint64_t *) ptr, m);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
+        return vld1q_u64((const uint64_t *) DRJIT_ASSUME_ALIGNED(ptr, 16));
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        return vld1q_u64((const uint64_t *) ptr);
+    }
+
+    static DRJIT_INLINE Derived zero_(size_t) { return vdupq_n_u64(0); }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+#endif // DRJIT_ARM_64
+
+/// Partial overload of StaticArrayImpl for the n=3 case (single precision)
+template <bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<float, 3, IsMask_, Derived_>
+  : StaticArrayImpl<float, 4, IsMask_, Derived_> {
+    DRJIT_PACKET_TYPE_3D(float)
+
+    template <int I0, int I1, int I2>
+    DRJIT_INLINE Derived shuffle_() const {
+        return Base::template shuffle_<I0, I1, I2, 3>();
+    }
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations (adapted for the n=3 case)
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                     \
+        DRJIT_INLINE Value name##_() const {                                  \
+            float32x2_t lo = vget_low_f32(m),                                 \
+                        t  = v##op##_f32(lo, vrev64_f32(lo));                 \
+            return vget_lane_f32(v##op##_f32(t, vget_high_f32(m)), 0);        \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum, add)
+    DRJIT_HORIZONTAL_OP(prod, mul)
+    DRJIT_HORIZONTAL_OP(min, min)
+    DRJIT_HORIZONTAL_OP(max, max)
+
+    #undef DRJIT_HORIZONTAL_OP
+
+    DRJIT_INLINE Value dot_(Ref a) const {
+        return Derived(vmulq_f32(m, a.m)).sum_();
+    }
+
+    DRJIT_INLINE bool all_() const { return bitmask_() == 7; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0; }
+
+    DRJIT_INLINE uint32_t bitmask_() const {
+        return detail::neon_movemask_u32(vreinterpretq_u32_f32(m)) & 7;
+    }
+
+    DRJIT_INLINE size_t count_() const {
+        return (size_t) detail::neon_count_u32(
+            vandq_u32(vreinterpretq_u32_f32(m), mask_().m));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Loading/writing data (adapted for the n=3 case)
+    // -----------------------------------------------------------------------
+
+    static DRJIT_INLINE auto mask_() {
+        const uint32_t data[4] = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0u };
+        return mask_t<Derived>(vreinterpretq_f32_u32(vld1q_u32(data)));
+    }
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        memcpy(ptr, &m, sizeof(Value) * 3);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        store_aligned_(ptr);
+    }
+
+#if defined(DRJIT_ARM_64)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        uint16_t temp[4];
+        Base::store_half_(temp);
+        memcpy(ptr, temp, sizeof(uint16_t) * 3);
+    }
+#endif
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t size) {
+        return Base::load_(ptr, size);
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        Derived result;
+        memcpy(&result.m, ptr, sizeof(Value) * 3);
+        return result;
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+/// Partial overload of StaticArrayImpl for the n=3 case (32 bit integers)
+template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
+    StaticArrayImpl<Value_, 3, IsMask_, Derived_, enable_if_int32_t<Value_>>
+  : StaticArrayImpl<Value_, 4, IsMask_, Derived_> {
+    DRJIT_PACKET_TYPE_3D(Value_)
+
+    template <int I0, int I1, int I2>
+    DRJIT_INLINE Derived shuffle_() const {
+        return Base::template shuffle_<I0, I1, I2, 3>();
+    }
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Horizontal operations (adapted for the n=3 case)
+    // -----------------------------------------------------------------------
+
+    #define DRJIT_HORIZONTAL_OP(name, op)                                     \
+        DRJIT_INLINE Value name##_() const {                                  \
+            if constexpr (std::is_signed_v<Value>) {                          \
+                int32x4_t v = vreinterpretq_s32_u32(m);                       \
+                int32x2_t lo = vget_low_s32(v),                               \
+                          t  = v##op##_s32(lo, vrev64_s32(lo));               \
+                return (Value) vget_lane_s32(                                 \
+                    v##op##_s32(t, vget_high_s32(v)), 0);                     \
+            } else {                                                          \
+                uint32x2_t lo = vget_low_u32(m),                              \
+                           t  = v##op##_u32(lo, vrev64_u32(lo));              \
+                return (Value) vget_lane_u32(                                 \
+                    v##op##_u32(t, vget_high_u32(m)), 0);                     \
+            }                                                                 \
+        }
+
+    DRJIT_HORIZONTAL_OP(sum, add)
+    DRJIT_HORIZONTAL_OP(prod, mul)
+    DRJIT_HORIZONTAL_OP(min, min)
+    DRJIT_HORIZONTAL_OP(max, max)
+
+    #undef DRJIT_HORIZONTAL_OP
+
+    DRJIT_INLINE bool all_() const { return bitmask_() == 7; }
+    DRJIT_INLINE bool any_() const { return bitmask_() != 0; }
+
+    DRJIT_INLINE uint32_t bitmask_() const { return detail::neon_movemask_u32(m) & 7; }
+
+    DRJIT_INLINE size_t count_() const {
+        return (size_t) detail::neon_count_u32(vandq_u32(m, mask_().m));
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+
+    // -----------------------------------------------------------------------
+    //! @{ \name Loading/writing data (adapted for the n=3 case)
+    // -----------------------------------------------------------------------
+
+    static DRJIT_INLINE auto mask_() {
+        const uint32_t data[4] = { 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0u };
+        return mask_t<Derived>(vld1q_u32(data));
+    }
+
+    DRJIT_INLINE void store_aligned_(void *ptr) const {
+        memcpy(ptr, &m, sizeof(Value) * 3);
+    }
+
+    DRJIT_INLINE void store_(void *ptr) const {
+        store_aligned_(ptr);
+    }
+
+    static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t size) {
+        return Base::load_(ptr, size);
+    }
+
+    static DRJIT_INLINE Derived load_(const void *ptr, size_t) {
+        Derived result;
+        memcpy(&result.m, ptr, sizeof(Value) * 3);
+        return result;
+    }
+
+    //! @}
+    // -----------------------------------------------------------------------
+} DRJIT_MAY_ALIAS;
+
+#undef DRJIT_NEON_SHUFFLE
+
+NAMESPACE_END(drjit)
@@ -51,7 +51,12 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
     template <typename... Ts, enable_if_t<sizeof...(Ts) == Size_ && Size_ != 1 &&
               detail::and_v<!std::is_same_v<Ts, detail::reinterpret_flag>...>> = 0>
     DRJIT_INLINE StaticArrayImpl(Ts&&... ts) {
-        alignas(alignof(Array1)) Value storage[Size_] = { (Value) ts... };
+        /* Padded packets (e.g. 3 floats loaded as 4) read past the last
+           component, so allocate the physical size of the upper half */
+        constexpr size_t StorageSize =
+            Size1 + sizeof(Array2) / sizeof(Value) > Size_
+                ? Size1 + sizeof(Array2) / sizeof(Value) : Size_;
+        alignas(alignof(Array1)) Value storage[StorageSize] = { (Value) ts... };
         a1 = load_aligned<Array1>(storage);
         a2 = load_aligned<Array2>(storage + Size1);
     }
@@ -303,6 +308,40 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
         store((uint8_t *) mem + sizeof(Array1), a2);
     }
 
+    template <typename T1 = Array1, typename T2 = Array2,
+              typename = decltype(std::declval<const T1 &>().store_half_(nullptr)),
+              typename = decltype(std::declval<const T2 &>().store_half_(nullptr))>
+    DRJIT_INLINE void store_half_(void *mem) const {
+        a1.store_half_(mem);
+        a2.store_half_((uint16_t *) mem + Array1::Size);
+    }
+
+    template <size_t N, typename T1 = Array1, typename T2 = Array2,
+              typename = decltype(T1::template load_aos_<N>(nullptr, (T1 *) nullptr)),
+              typename = decltype(T2::template load_aos_<N>(nullptr, (T2 *) nullptr))>
+    static DRJIT_INLINE void load_aos_(const void *mem, Derived *out) {
+        Array1 a1[N];
+        Array2 a2[N];
+        Array1::template load_aos_<N>(mem, a1);
+        Array2::template load_aos_<N>((const Value *) mem + N * Array1::Size, a2);
+        for (size_t i = 0; i < N; ++i)
+            out[i] = Derived(a1[i], a2[i]);
+    }
+
+    template <size_t N, typename T1 = Array1, typename T2 = Array2,
+              typename = decltype(T1::template store_aos_<N>(nullptr, (const T1 *) nullptr)),
+              typename = decltype(T2::template store_aos_<N>(nullptr, (const T2 *) nullptr))>
+    static DRJIT_INLINE void store_aos_(void *mem, const Derived *in) {
+        Array1 a1[N];
+        Array2 a2[N];
+        for (size_t i = 0; i < N; ++i) {
+            a1[i] = in[i].a1;
+            a2[i] = in[i].a2;
+        }
+        Array1::template store_aos_<N>(mem, a1);
+        Array2::template store_aos_<N>((Value *) mem + N * Array1::Size, a2);
+    }
+
     static DRJIT_INLINE Derived load_aligned_(const void *mem, size_t) {
         return Derived(
             load_aligned<Array1>((uint8_t *) mem),
@@ -325,6 +364,31 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
         );
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Size1 != Size2)
+            return Base::template shuffle_xor_<Step>();
+        else if constexpr (Step == Size1)
+            return Derived(a2, a1);
+        else
+            return Derived(a1.template shuffle_xor_<Step>(),
+                           a2.template shuffle_xor_<Step>());
+    }
+
+    template <typename Mask>
+    DRJIT_INLINE size_t compress_store_(void *ptr, const Mask &mask) const {
+        size_t count = compress_store(ptr, a1, low(mask));
+        return count + compress_store((Value *) ptr + count, a2, high(mask));
+    }
+
+    template <typename Mask>
+    static DRJIT_INLINE Derived expand_load_(const void *ptr, const Mask &mask) {
+        size_t count = (size_t) drjit::count(low(mask));
+        return Derived(
+            expand_load<Array1>(ptr, low(mask)),
+            expand_load<Array2>((const Value *) ptr + count, high(mask))
+        );
+    }
+
     template <bool, typename Index, typename Mask>
     DRJIT_INLINE void scatter_(void *ptr, const Index &index, const Mask &mask) const {
         scatter(ptr, a1, low(index), low(mask));
@@ -412,4 +476,101 @@ struct StaticArrayImpl<Value_, Size_, IsMask_, Derived_,
     Array2 a2;
 } DRJIT_MAY_ALIAS;
 
+NAMESPACE_BEGIN(detail)
+
+/// Number of lanes of the innermost (packet) dimension of 'T', 1 for scalars
+template <typename T> constexpr size_t split_width() {
+    if constexpr (!is_array_v<T>)
+        return 1;
+    else if constexpr (array_depth_v<T> == 1)
+        return T::Size;
+    else
+        return split_width<value_t<T>>();
+}
+
+template <typename... Ts> constexpr size_t split_size() {
+    size_t result = 1;
+    ((result = split_width<Ts>() > result ? split_width<Ts>() : result), ...);
+    return result;
+}
+
+/// Extract the low or high half of the innermost dimension of 'value'
+template <bool High, typename T> DRJIT_INLINE auto split_half(const T &value) {
+    if constexpr (!is_array_v<T>) {
+        return value;
+    } else if constexpr (array_depth_v<T> == 1) {
+        if constexpr (High)
+            return high(value);
+        else
+            return low(value);
+    } else {
+        using Half = decltype(split_half<High>(value.entry(0)));
+        typename T::template ReplaceValue<Half> result;
+        for (size_t i = 0; i < T::Size; ++i)
+            result.entry(i) = split_half<High>(value.entry(i));
+        return result;
+    }
+}
+
+/// Inverse of split_half(): concatenate the innermost dimension of two halves
+template <typename T, typename Half>
+DRJIT_INLINE T split_merge(const Half &lo, const Half &hi) {
+    if constexpr (array_depth_v<T> == 1) {
+        return T(lo, hi);
+    } else {
+        T result;
+        for (size_t i = 0; i < T::Size; ++i)
+            result.entry(i) = split_merge<value_t<T>>(lo.entry(i), hi.entry(i));
+        return result;
+    }
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Evaluate \c func on slices of \c Width lanes of its arguments
+ *
+ * Wide packets (e.g. <tt>Packet<float, 32></tt> on AVX512) are processed by
+ * the recursive backend as several native packets in lockstep. This hides
+ * instruction latencies, but kernels with many live temporaries (e.g.
+ * \ref sh_eval_9() or a 4x4 matrix \ref inverse()) can then exceed the
+ * register file and spill to the stack. This function instead calls \c func
+ * separately on each \c Width-lane slice and reassembles the result, which
+ * selects the degree of interleaving independently of the packet width used
+ * by the surrounding code.
+ *
+ * The arguments can be flat or nested static arrays sharing the same
+ * innermost (packet) dimension, or scalars, which are passed through
+ * unchanged. The packet dimension must be a power-of-two multiple of
+ * \c Width. \c func should be a generic callable, since its arguments are
+ * slices with a different type. It may return \c void or an array of the same
+ * structure as the arguments.
+ */
+template <size_t Width, typename Func, typename... Args>
+DRJIT_INLINE auto split_apply(Func &&func, const Args &... args) {
+    constexpr size_t Size = detail::split_size<Args...>();
+    static_assert(((detail::split_width<Args>() == 1 ||
+                    detail::split_width<Args>() == Size) && ...),
+                  "split_apply(): arguments have mismatched packet sizes!");
+    static_assert(Width > 0 && Size % Width == 0 &&
+                  ((Size / Width) & (Size / Width - 1)) == 0,
+                  "split_apply(): the packet size must be a power-of-two "
+                  "multiple of 'Width'!");
+
+    if constexpr (Size <= Width) {
+        return func(args...);
+    } else {
+        using Result = decltype(func(args...));
+
+        if constexpr (std::is_void_v<Result>) {
+            split_apply<Width>(func, detail::split_half<false>(args)...);
+            split_apply<Width>(func, detail::split_half<true>(args)...);
+        } else {
+            auto lo = split_apply<Width>(func, detail::split_half<false>(args)...);
+            auto hi = split_apply<Width>(func, detail::split_half<true>(args)...);
+            return detail::split_merge<Result>(lo, hi);
+        }
+    }
+}
+
 NAMESPACE_END(drjit)
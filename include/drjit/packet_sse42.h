@@ -40,11 +40,11 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
     //! @{ \name Type converting constructors
     // -----------------------------------------------------------------------
 
-// #if defined(DRJIT_X86_F16C)
-    // DRJIT_CONVERT(half) {
-    //     m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data()));
-    // }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    DRJIT_CONVERT(half) {
+        m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) a.derived().data()));
+    }
+#endif
 
     DRJIT_CONVERT(float) : m(a.derived().m) { }
     DRJIT_CONVERT(int32_t) : m(_mm_cvtepi32_ps(a.derived().m)) { }
@@ -271,6 +271,17 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
         #endif
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return shuffle_<1, 0, 3, 2>();
+        else
+            return shuffle_<2, 3, 0, 1>();
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        return _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(m), 4 * Shift));
+    }
+
 #if defined(DRJIT_X86_AVX512)
     DRJIT_INLINE Derived ldexp_(Ref arg) const { return _mm_scalef_ps(m, arg.m); }
 
@@ -386,6 +397,13 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
         _mm_storeu_ps((Value *) ptr, m);
     }
 
+#if defined(DRJIT_X86_F16C)
+    /// Convert to half precision and store (used by half-valued arrays)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        _mm_storel_epi64((__m128i *) ptr, _mm_cvtps_ph(m, _MM_FROUND_CUR_DIRECTION));
+    }
+#endif
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t) {
         return _mm_load_ps((const Value *) DRJIT_ASSUME_ALIGNED(ptr, 16));
     }
@@ -394,6 +412,65 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
         return _mm_loadu_ps((const Value *) ptr);
     }
 
+    /// Load 'N' interleaved components of 4 records (used by load_aos())
+    template <size_t N, typename D = Derived,
+              enable_if_t<(N == 3 || N == 4) && D::Size == 4> = 0>
+    static DRJIT_INLINE void load_aos_(const void *ptr, Derived *out) {
+        const Value *p = (const Value *) ptr;
+        __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4),
+               c = _mm_loadu_ps(p + 8);
+
+        if constexpr (N == 3) {
+            __m128 t0 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2)),
+                   t1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+            out[0] = _mm_shuffle_ps(a, t0,  _MM_SHUFFLE(2, 0, 3, 0));
+            out[1] = _mm_shuffle_ps(t1, t0, _MM_SHUFFLE(3, 1, 2, 0));
+            out[2] = _mm_shuffle_ps(t1, c,  _MM_SHUFFLE(3, 0, 3, 1));
+        } else {
+            __m128 d = _mm_loadu_ps(p + 12);
+
+            __m128 t0 = _mm_unpacklo_ps(a, b), t1 = _mm_unpacklo_ps(c, d),
+                   t2 = _mm_unpackhi_ps(a, b), t3 = _mm_unpackhi_ps(c, d);
+
+            out[0] = _mm_movelh_ps(t0, t1);
+            out[1] = _mm_movehl_ps(t1, t0);
+            out[2] = _mm_movelh_ps(t2, t3);
+            out[3] = _mm_movehl_ps(t3, t2);
+        }
+    }
+
+    /// Store 'N' components of 4 records in interleaved form (used by store_aos())
+    template <size_t N, typename D = Derived,
+              enable_if_t<(N == 3 || N == 4) && D::Size == 4> = 0>
+    static DRJIT_INLINE void store_aos_(void *ptr, const Derived *in) {
+        Value *p = (Value *) ptr;
+        __m128 x = in[0].m, y = in[1].m, z = in[2].m;
+
+        if constexpr (N == 3) {
+            __m128 t0 = _mm_unpacklo_ps(x, y),
+                   t1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                   t2 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                   t3 = _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                   t4 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                   t5 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+            _mm_storeu_ps(p,     _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(2, 0, 1, 0)));
+            _mm_storeu_ps(p + 4, _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(2, 0, 2, 0)));
+            _mm_storeu_ps(p + 8, _mm_shuffle_ps(t4, t5, _MM_SHUFFLE(2, 0, 2, 0)));
+        } else {
+            __m128 w = in[3].m;
+
+            __m128 t0 = _mm_unpacklo_ps(x, y), t1 = _mm_unpacklo_ps(z, w),
+                   t2 = _mm_unpackhi_ps(x, y), t3 = _mm_unpackhi_ps(z, w);
+
+            _mm_storeu_ps(p,      _mm_movelh_ps(t0, t1));
+            _mm_storeu_ps(p + 4,  _mm_movehl_ps(t1, t0));
+            _mm_storeu_ps(p + 8,  _mm_movelh_ps(t2, t3));
+            _mm_storeu_ps(p + 12, _mm_movehl_ps(t3, t2));
+        }
+    }
+
     static DRJIT_INLINE Derived empty_(size_t) { return _mm_undefined_ps(); }
     static DRJIT_INLINE Derived zero_(size_t) { return _mm_setzero_ps(); }
 
@@ -736,6 +813,17 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
         return _mm_shuffle_epi32(m, _MM_SHUFFLE(I3, I2, I1, I0));
     }
 
+    template <size_t Step> DRJIT_INLINE Derived shuffle_xor_() const {
+        if constexpr (Step == 1)
+            return shuffle_<1, 0, 3, 2>();
+        else
+            return shuffle_<2, 3, 0, 1>();
+    }
+
+    template <size_t Shift> DRJIT_INLINE Derived shift_lanes_() const {
+        return _mm_slli_si128(m, 4 * Shift);
+    }
+
     DRJIT_INLINE Derived mulhi_(Ref a) const {
         Derived even, odd;
 
@@ -747,7 +835,8 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
             odd.m = _mm_mul_epu32(_mm_srli_epi64(m, 32), _mm_srli_epi64(a.m, 32));
         }
 
-        return select(mask_t<Derived>(true, false, true, false), even, odd);
+        // Even lanes from 'even', odd lanes from 'odd' (also valid for n=3)
+        return _mm_blend_epi16(odd.m, even.m, 0x33);
     }
 
 #if defined(DRJIT_X86_AVX512)
@@ -1627,6 +1716,14 @@ template <typename Value_, bool IsMask_, typename Derived_> struct alignas(16)
     DRJIT_INLINE Value extract_(const Mask &mask) const {
         return (Value) detail::mm_cvtsi128_si64(_mm_mask_compress_epi64(_mm_setzero_si128(), mask.k, m));
     }
+#else
+    // Avoid the entry()-based fallback, which violates strict aliasing for pointers
+    template <typename Mask>
+    DRJIT_INLINE Value extract_(const Mask &mask) const {
+        int k = _mm_movemask_pd(_mm_castsi128_pd(mask.m));
+        return (Value) ((k & 1) ? detail::mm_cvtsi128_si64(m)
+                                : detail::mm_extract_epi64<1>(m));
+    }
 #endif
 } DRJIT_MAY_ALIAS;
 
@@ -1636,16 +1733,16 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
   : StaticArrayImpl<float, 4, IsMask_, Derived_> {
     DRJIT_PACKET_TYPE_3D(float)
 
-// #if defined(DRJIT_X86_F16C)
-    // template <typename Derived2>
-    // DRJIT_INLINE StaticArrayImpl(
-    //     const StaticArrayBase<half, 3, IsMask_, Derived2> &a) {
-    //     uint16_t temp[4];
-    //     memcpy(temp, a.derived().data(), sizeof(uint16_t) * 3);
-    //     temp[3] = 0;
-    //     m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) temp));
-    // }
-// #endif
+#if defined(DRJIT_X86_F16C)
+    template <typename Derived2>
+    DRJIT_INLINE StaticArrayImpl(
+        const StaticArrayBase<half, 3, IsMask_, Derived2> &a) {
+        uint16_t temp[4];
+        memcpy(temp, a.derived().data(), sizeof(uint16_t) * 3);
+        temp[3] = 0;
+        m = _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *) temp));
+    }
+#endif
 
     template <int I0, int I1, int I2>
     DRJIT_INLINE Derived shuffle_() const {
@@ -1705,6 +1802,14 @@ template <bool IsMask_, typename Derived_> struct alignas(16)
         store_aligned_(ptr);
     }
 
+#if defined(DRJIT_X86_F16C)
+    DRJIT_INLINE void store_half_(void *ptr) const {
+        uint16_t temp[4];
+        Base::store_half_(temp);
+        memcpy(ptr, temp, sizeof(uint16_t) * 3);
+    }
+#endif
+
     static DRJIT_INLINE Derived load_aligned_(const void *ptr, size_t size) {
         return Base::load_(ptr, size);
     }
@@ -0,0 +1,228 @@
+/*
+    drjit/qmc.h -- Low-discrepancy sequences for quasi-Monte Carlo integration
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/array.h>
+#include <drjit/idiv.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/// Number of Sobol dimensions with tabulated direction numbers
+static constexpr uint32_t SobolDimensions = 16;
+
+/**
+ * \brief Generator matrices of the Sobol sequence
+ *
+ * Dimension 0 is the van der Corput sequence. The remaining dimensions use
+ * the primitive polynomials and initial direction numbers of Joe and Kuo
+ * ("Constructing Sobol sequences with better two-dimensional projections",
+ * SIAM J. Sci. Comput. 2008, file 'new-joe-kuo-6.21201'). Column \c k of a
+ * matrix holds the direction number that is XORed into the result when bit
+ * \c k of the sample index is set, with the most significant bit
+ * representing 1/2.
+ */
+struct SobolMatrices {
+    uint32_t m[SobolDimensions][32] { };
+
+    constexpr SobolMatrices() {
+        // Degree, polynomial coefficients and initial direction numbers
+        constexpr uint32_t params[SobolDimensions - 1][8] = {
+            { 1, 0,  1 },                { 2, 1,  1, 3 },
+            { 3, 1,  1, 3, 1 },          { 3, 2,  1, 1, 1 },
+            { 4, 1,  1, 1, 3, 3 },       { 4, 4,  1, 3, 5, 13 },
+            { 5, 2,  1, 1, 5, 5, 17 },   { 5, 4,  1, 1, 5, 5, 5 },
+            { 5, 7,  1, 1, 7, 11, 19 },  { 5, 11, 1, 1, 5, 1, 1 },
+            { 5, 13, 1, 1, 1, 3, 11 },   { 5, 14, 1, 3, 5, 5, 31 },
+            { 6, 1,  1, 3, 3, 9, 7, 49 }, { 6, 13, 1, 1, 1, 15, 21, 21 },
+            { 6, 16, 1, 3, 1, 13, 27, 49 }
+        };
+
+        for (uint32_t k = 0; k < 32; ++k)
+            m[0][k] = 1u << (31 - k);
+
+        for (uint32_t d = 1; d < SobolDimensions; ++d) {
+            uint32_t s = params[d - 1][0], a = params[d - 1][1], v[32] { };
+            for (uint32_t k = 0; k < s; ++k)
+                v[k] = params[d - 1][2 + k];
+
+            for (uint32_t k = s; k < 32; ++k) {
+                v[k] = v[k - s] ^ (v[k - s] << s);
+                for (uint32_t j = 1; j < s; ++j) {
+                    if ((a >> (s - 1 - j)) & 1)
+                        v[k] ^= v[k - j] << j;
+                }
+            }
+
+            for (uint32_t k = 0; k < 32; ++k)
+                m[d][k] = v[k] << (31 - k);
+        }
+    }
+};
+
+static constexpr SobolMatrices sobol_matrices { };
+
+/// Integer hash function with good avalanche properties ('lowbias32')
+template <typename UInt32> UInt32 qmc_hash(UInt32 x) {
+    x ^= sr<16>(x);
+    x *= 0x7feb352du;
+    x ^= sr<15>(x);
+    x *= 0x846ca68bu;
+    x ^= sr<16>(x);
+    return x;
+}
+
+/// Map a 32-bit fixed point value to a single precision float in [0, 1)
+template <typename UInt32> float32_array_t<UInt32> qmc_to_float(const UInt32 &v) {
+    using Float32 = float32_array_t<UInt32>;
+    return Float32(sr<8>(v)) * 0x1p-24f;
+}
+
+NAMESPACE_END(detail)
+
+/// Reverse the order of the bits of a 32-bit unsigned integer
+template <typename UInt32> UInt32 reverse_bits(UInt32 v) {
+    static_assert(std::is_same_v<scalar_t<UInt32>, uint32_t>,
+                  "reverse_bits(): requires a 32-bit unsigned integer type!");
+    v = sr<1>(v & 0xaaaaaaaau) | sl<1>(v & 0x55555555u);
+    v = sr<2>(v & 0xccccccccu) | sl<2>(v & 0x33333333u);
+    v = sr<4>(v & 0xf0f0f0f0u) | sl<4>(v & 0x0f0f0f0fu);
+    v = sr<8>(v & 0xff00ff00u) | sl<8>(v & 0x00ff00ffu);
+    return sr<16>(v) | sl<16>(v);
+}
+
+/**
+ * \brief Evaluate the dimension \c dim (< 16) of the Sobol sequence at the
+ * given sample index and return the result as a 32-bit fixed point value
+ *
+ * The dimension is a scalar, hence the direction numbers are compile-time
+ * tables on the host and enter JIT kernels as literal constants. No device
+ * memory or gathers are involved.
+ */
+template <typename UInt32>
+UInt32 sobol_uint32(const UInt32 &index, uint32_t dim) {
+    if (dim >= detail::SobolDimensions)
+        drjit_raise("drjit::sobol_uint32(): only the first %u dimensions are "
+                    "supported!", detail::SobolDimensions);
+
+    if (dim == 0)
+        return reverse_bits(index);
+
+    const uint32_t *m = detail::sobol_matrices.m[dim];
+    UInt32 result = zeros<UInt32>();
+    for (uint32_t k = 0; k < 32; ++k)
+        result ^= -((index >> k) & 1u) & m[k];
+
+    return result;
+}
+
+/**
+ * \brief Owen-scramble a 32-bit fixed point value by hashing
+ *
+ * This is the nested uniform scramble of Burley ("Practical Hash-based Owen
+ * Scrambling", JCGT 2020): the Laine-Karras permutation applied to the
+ * bit-reversed value only propagates information from more to less
+ * significant digits, which randomizes the sequence while preserving its
+ * stratification.
+ */
+template <typename UInt32>
+UInt32 owen_scramble(const UInt32 &value, const UInt32 &seed) {
+    UInt32 x = reverse_bits(value);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverse_bits(x);
+}
+
+/**
+ * \brief Owen-scrambled Sobol sequence on the interval [0, 1)
+ *
+ * Each dimension is scrambled with its own hash of \c seed, which may differ
+ * per lane (e.g. per pixel). Dimensions beyond the tabulated 16 reuse the
+ * generator matrices of dimension <tt>dim % 16</tt> together with a
+ * scrambled (shuffled) sample index, which keeps every dimension stratified
+ * while decorrelating it from the others ("padding").
+ */
+template <typename UInt32>
+float32_array_t<UInt32> sobol(const UInt32 &index, uint32_t dim,
+                              const UInt32 &seed) {
+    uint32_t group = dim / detail::SobolDimensions;
+    UInt32 seed_dim = detail::qmc_hash(seed ^ detail::qmc_hash(dim + 1u));
+
+    UInt32 i = index;
+    if (group > 0)
+        i = owen_scramble(index, detail::qmc_hash(seed ^ (0x9e3779b9u * group)));
+
+    return detail::qmc_to_float(owen_scramble(
+        sobol_uint32(i, dim % detail::SobolDimensions), seed_dim));
+}
+
+/**
+ * \brief Radical inverse of \c index in the given base, i.e. the digits of
+ * the index mirrored about the decimal point
+ *
+ * The loop runs for a fixed number of iterations determined by the base
+ * (enough digits to represent any 32-bit index), so it does not diverge in
+ * JIT kernels or packets.
+ */
+template <typename UInt32>
+float32_array_t<UInt32> radical_inverse(const UInt32 &index, uint32_t base) {
+    using Float32 = float32_array_t<UInt32>;
+
+    if (base < 2)
+        drjit_raise("drjit::radical_inverse(): the base must be at least 2!");
+
+    if (base == 2)
+        return detail::qmc_to_float(reverse_bits(index));
+
+    uint32_t digits = 0;
+    for (uint64_t v = 1; v <= 0xffffffffull; v *= base)
+        digits++;
+
+    divisor<uint32_t> div(base);
+    float inv_base = 1.f / (float) base, scale = inv_base;
+    UInt32 i = index;
+    Float32 result = zeros<Float32>();
+
+    for (uint32_t k = 0; k < digits; ++k) {
+        UInt32 next = idiv(i, div);
+        result = fmadd(Float32(i - next * base), scale, result);
+        scale *= inv_base;
+        i = next;
+    }
+
+    return minimum(result, OneMinusEpsilon<Float32>);
+}
+
+/// Halton sequence: the radical inverse in the base of the <tt>dim</tt>-th prime
+template <typename UInt32>
+float32_array_t<UInt32> halton(const UInt32 &index, uint32_t dim) {
+    uint32_t base = 1;
+    for (uint32_t count = 0; count <= dim; ) {
+        base++;
+        bool prime = true;
+        for (uint32_t j = 2; j * j <= base; ++j) {
+            if (base % j == 0) {
+                prime = false;
+                break;
+            }
+        }
+        count += prime;
+    }
+
+    return radical_inverse(index, base);
+}
+
+NAMESPACE_END(drjit)
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <drjit/complex.h>
+#include <drjit/struct.h>
 
 NAMESPACE_BEGIN(drjit)
 
@@ -293,6 +294,185 @@ Quaternion<Value> slerp(const Quaternion<Value> &q0,
     );
 }
 
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Coefficients of the series used by \ref fast_slerp()
+ *
+ * The slerp weight <tt>sin(t*theta) / sin(theta)</tt> expands into a power
+ * series in <tt>x - 1</tt> with <tt>x = cos(theta)</tt>, whose terms satisfy
+ * <tt>b_i = b_(i-1) * (u_i * t^2 - v_i) * (x - 1)</tt>. Eberly ("A Fast and
+ * Accurate Algorithm for Computing SLERP", JGT 2011) truncates it after eight
+ * terms and scales the last one by a constant that balances the truncation
+ * error.
+ */
+struct SlerpSeries {
+    double u[8] { }, v[8] { };
+
+    constexpr SlerpSeries() {
+        for (int i = 1; i <= 8; ++i) {
+            u[i - 1] = 1.0 / (i * (2.0 * i + 1.0));
+            v[i - 1] = i / (2.0 * i + 1.0);
+        }
+        constexpr double mu = 1.85298109240830;
+        u[7] *= mu;
+        v[7] *= mu;
+    }
+};
+
+static constexpr SlerpSeries slerp_series { };
+
+/// Rotate a 3D vector by a unit quaternion without forming a matrix
+template <typename Value, typename Vector3>
+Vector3 quat_rotate(const Quaternion<Value> &q, const Vector3 &v) {
+    Array<Value, 3> u = imag(q);
+    return v + 2.f * cross(u, fmadd(v, q.w(), cross(u, v)));
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Normalized linear interpolation between two rotations
+ *
+ * This is the cheapest approximation of \ref slerp(): it follows the same
+ * great arc, but the angular velocity is not constant.
+ */
+template <typename Value>
+Quaternion<Value> nlerp(const Quaternion<Value> &q0,
+                        const Quaternion<Value> &q1_,
+                        const Value &t) {
+    using Base = Array<Value, 4>;
+    Quaternion<Value> q1 = mulsign(Base(q1_), Base(dot(q0, q1_)));
+    return normalize(q0 * (1.f - t) + q1 * t);
+}
+
+/**
+ * \brief Approximate spherical linear interpolation using only arithmetic
+ *
+ * The two interpolation weights are evaluated using the series described in
+ * \ref detail::SlerpSeries (maximum absolute error of about 2e-5) instead of
+ * \c acos, \c sincos and a normalization. The function is branch-free and
+ * only involves a few dozen multiply-adds per lane, which makes it well
+ * suited to blending large numbers of rotations in packets or JIT kernels.
+ */
+template <typename Value>
+Quaternion<Value> fast_slerp(const Quaternion<Value> &q0,
+                             const Quaternion<Value> &q1_,
+                             const Value &t) {
+    using Base = Array<Value, 4>;
+    using Scalar = scalar_t<Value>;
+    const detail::SlerpSeries &c = detail::slerp_series;
+
+    Value x = dot(q0, q1_);
+    Quaternion<Value> q1 = mulsign(Base(q1_), Base(x));
+
+    Value xm1 = abs(x) - 1.f,
+          d   = 1.f - t,
+          t2  = sqr(t),
+          d2  = sqr(d),
+          wt  = 1.f,
+          wd  = 1.f;
+
+    for (int i = 7; i >= 0; --i) {
+        wt = fmadd(fmsub(Scalar(c.u[i]), t2, Scalar(c.v[i])) * xm1, wt, 1.f);
+        wd = fmadd(fmsub(Scalar(c.u[i]), d2, Scalar(c.v[i])) * xm1, wd, 1.f);
+    }
+
+    return q0 * (wd * d) + q1 * (wt * t);
+}
+
+/**
+ * \brief Unit dual quaternion representing a rigid transformation
+ *
+ * The \c real part stores the rotation, and the \c dual part equals
+ * <tt>0.5 * t * real</tt> where \c t is the translation as a pure
+ * quaternion. Being declared via \ref DRJIT_STRUCT, instances can be
+ * gathered from bone arrays, carried through loops, etc.
+ */
+template <typename Value_> struct DualQuaternion {
+    using Value = Value_;
+    using Quat = Quaternion<Value>;
+
+    Quat real, dual;
+
+    DualQuaternion(const Quat &real, const Quat &dual) : real(real), dual(dual) { }
+
+    DRJIT_STRUCT(DualQuaternion, real, dual)
+};
+
+/// Build a dual quaternion from a unit rotation quaternion and a translation
+template <typename Value>
+DualQuaternion<Value> dual_quat(const Quaternion<Value> &rotation,
+                                const Array<Value, 3> &translation) {
+    return { rotation, Quaternion<Value>(translation * .5f, 0.f) * rotation };
+}
+
+/// Extract the translation of a unit dual quaternion
+template <typename Value>
+Array<Value, 3> dual_quat_translation(const DualQuaternion<Value> &dq) {
+    return imag(dq.dual * conj(dq.real)) * 2.f;
+}
+
+/**
+ * \brief Project a (blended) dual quaternion back onto the unit dual
+ * quaternions
+ *
+ * Both parts are divided by the norm of the real part, and the component of
+ * the dual part along the real part is removed.
+ */
+template <typename Value>
+DualQuaternion<Value> normalize(const DualQuaternion<Value> &dq) {
+    Value inv_norm_2 = rcp(squared_norm(dq.real)),
+          inv_norm = sqrt(inv_norm_2);
+
+    return { dq.real * inv_norm,
+             (dq.dual - dq.real * (dot(dq.real, dq.dual) * inv_norm_2)) * inv_norm };
+}
+
+/**
+ * \brief Add a weighted dual quaternion to an accumulator for dual
+ * quaternion linear blending (DLB, Kavan et al. 2007)
+ *
+ * The contribution is negated when its rotation lies in the opposite
+ * hemisphere of the accumulated rotation, so that blending follows the
+ * shortest path. Call \ref normalize() on the final sum.
+ */
+template <typename Value>
+DualQuaternion<Value> dual_quat_blend(const DualQuaternion<Value> &acc,
+                                      const DualQuaternion<Value> &dq,
+                                      const Value &weight) {
+    Value w = mulsign(weight, dot(acc.real, dq.real));
+    return { acc.real + dq.real * w, acc.dual + dq.dual * w };
+}
+
+/// Apply the rigid transformation of a unit dual quaternion to a point
+template <typename Value>
+Array<Value, 3> dual_quat_transform_point(const DualQuaternion<Value> &dq,
+                                          const Array<Value, 3> &p) {
+    Array<Value, 3> rv = imag(dq.real), dv = imag(dq.dual),
+                    t = 2.f * (fmsub(dv, dq.real.w(), rv * dq.dual.w()) +
+                               cross(rv, dv));
+    return detail::quat_rotate(dq.real, p) + t;
+}
+
+/// Apply the rotation of a unit dual quaternion to a vector (e.g. a normal)
+template <typename Value>
+Array<Value, 3> dual_quat_transform_vector(const DualQuaternion<Value> &dq,
+                                           const Array<Value, 3> &v) {
+    return detail::quat_rotate(dq.real, v);
+}
+
+/// Convert a unit dual quaternion into a 4x4 affine transformation matrix
+template <typename Matrix, typename Value>
+Matrix dual_quat_to_matrix(const DualQuaternion<Value> &dq) {
+    static_assert(Matrix::Size == 4, "dual_quat_to_matrix(): expected a 4x4 matrix!");
+    Matrix result = quat_to_matrix<Matrix>(dq.real);
+    Array<Value, 3> t = dual_quat_translation(dq);
+    for (size_t i = 0; i < 3; ++i)
+        result(i, 3) = t.entry(i);
+    return result;
+}
+
 template <typename Quat, typename Vector3, enable_if_quaternion_t<Quat> = 0>
 Quat rotate(const Vector3 &axis, const value_t<Quat> &angle) {
     auto [s, c] = sincos(angle * .5f);
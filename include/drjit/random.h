@@ -26,6 +26,11 @@
 #define PCG32_DEFAULT_STREAM 0xda3e39cb94b95bdbULL
 #define PCG32_MULT           0x5851f42d4c957f2dULL
 
+#define PHILOX_M0            0xD2511F53u
+#define PHILOX_M1            0xCD9E8D57u
+#define PHILOX_W0            0x9E3779B9u
+#define PHILOX_W1            0xBB67AE85u
+
 NAMESPACE_BEGIN(drjit)
 
 /// PCG32 pseudorandom number generator proposed by Melissa O'Neill
@@ -62,6 +67,31 @@ template <typename T> struct PCG32 {
         next_uint32();
     }
 
+    /**
+     * \brief Seed the pseudorandom number generator so that all lanes share a
+     * single sequence, with lane \c i starting <tt>i * stride</tt> steps
+     * into it
+     *
+     * In contrast to \ref seed(), which assigns a separate stream to every
+     * lane, the lanes here are disjoint windows of one sequence as long as no
+     * lane draws more than \c stride samples and <tt>size * stride</tt> does
+     * not exceed the period of 2^64. The default stride supports up to 2^32
+     * lanes with 2^32 samples each. The per-lane states are computed in
+     * parallel using the jump-ahead function, which turns into a single
+     * kernel of 64 multiply-add steps in JIT modes.
+     */
+    void seed_sequence(size_t size = 1,
+                       const UInt64 &initstate = PCG32_DEFAULT_STATE,
+                       const UInt64 &initseq   = PCG32_DEFAULT_STREAM,
+                       uint64_t stride = (uint64_t) 1 << 32) {
+        state = zeros<UInt64>(size);
+        inc = sl<1>(initseq + zeros<UInt64>(size)) | 1u;
+        next_uint32();
+        state += initstate;
+        next_uint32();
+        *this += Int64(arange<UInt64>(size) * stride);
+    }
+
     /// Generate a uniformly distributed unsigned 32-bit random number
     DRJIT_INLINE UInt32 next_uint32() {
         UInt64 oldstate = state;
@@ -262,6 +292,60 @@ template <typename T> struct PCG32 {
         }
     }
 
+    /**
+     * \brief Generate an integer r, where 0 <= r < bound, without a
+     * data-dependent loop
+     *
+     * This function uses Lemire's multiply-shift method ("Fast Random Integer
+     * Generation in an Interval", ACM TOMS 2019), which maps a 32-bit sample
+     * \c x to <tt>(x * bound) >> 32</tt> and only needs to reject it when the
+     * low half of the product falls below <tt>2^32 mod bound</tt>. Rejected
+     * lanes draw again up to \c retries times in one branchless pass and
+     * then keep their last value. The probability of this fallback, and
+     * hence the total variation distance to the uniform distribution, is
+     * below <tt>(bound / 2^32)^(retries + 1)</tt>, e.g. less than 2^-32 for
+     * bounds up to 2^16 with the default single retry.
+     *
+     * In contrast to \ref next_uint32_bounded(), this never introduces a
+     * divergent loop into JIT-compiled kernels or packet code.
+     */
+    UInt32 next_uint32_bounded_fixed(uint32_t bound, const Mask &mask = true,
+                                     uint32_t retries = 1) {
+        uint32_t threshold = (~bound + 1u) % bound;
+
+        UInt32 x = next_uint32(mask),
+               lo = x * bound,
+               hi = mulhi(x, UInt32(bound));
+
+        for (uint32_t i = 0; i < retries; ++i) {
+            mask_t<UInt32> retry = mask_t<UInt32>(mask) && lo < threshold;
+            x = next_uint32(Mask(retry));
+            lo = select(retry, x * bound, lo);
+            hi = select(retry, mulhi(x, UInt32(bound)), hi);
+        }
+
+        return hi;
+    }
+
+    /// 64-bit version of \ref next_uint32_bounded_fixed()
+    UInt64 next_uint64_bounded_fixed(uint64_t bound, const Mask &mask = true,
+                                     uint32_t retries = 1) {
+        uint64_t threshold = (~bound + (uint64_t) 1) % bound;
+
+        UInt64 x = next_uint64(mask),
+               lo = x * bound,
+               hi = mulhi(x, UInt64(bound));
+
+        for (uint32_t i = 0; i < retries; ++i) {
+            Mask retry = mask && lo < threshold;
+            x = next_uint64(retry);
+            lo = select(retry, x * bound, lo);
+            hi = select(retry, mulhi(x, UInt64(bound)), hi);
+        }
+
+        return hi;
+    }
+
     /// Forward \ref next_uint_bounded call to the correct method based given type size
     template <typename Value,
               enable_if_t<std::is_same_v<scalar_t<Value>, uint32_t> ||
@@ -384,4 +468,218 @@ private:
         : state(state), inc(inc) { }
 };
 
+/**
+ * \brief Philox4x32-10 counter-based pseudorandom number generator proposed
+ * by Salmon et al. ("Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011)
+ *
+ * Unlike \ref PCG32, this generator has no sequential state: every output is
+ * a pure function of a 128-bit counter and a 64-bit key, which are formed
+ * from the tuple (\c index, \c sample, \c dimension) and the \c seed. Any
+ * sample can thus be regenerated directly, e.g. from the pixel index and
+ * sample number of a renderer, without storing or advancing a generator
+ * per lane. The only mutable field is \c dimension, which the \c next_*()
+ * methods increment after every call.
+ *
+ * The ten rounds consist of 32-bit multiplies and XORs without any
+ * data-dependent control flow, which vectorizes well on packets and in
+ * JIT-compiled kernels.
+ */
+template <typename T> struct Philox4x32 {
+    /* Some convenient type aliases for vectorization */
+    using UInt64     = uint64_array_t<T>;
+    using UInt32     = uint32_array_t<T>;
+    using Float64    = float64_array_t<T>;
+    using Float32    = float32_array_t<T>;
+    using UInt32x4   = Array<UInt32, 4>;
+    using Float32x4  = Array<Float32, 4>;
+    using Mask       = mask_t<UInt32>;
+
+    Philox4x32(const UInt32 &index = 0, const UInt32 &sample = 0,
+               const UInt64 &seed = 0, const UInt32 &dimension = 0)
+        : index(index), sample(sample), dimension(dimension), seed(seed) { }
+
+    /// Evaluate the Philox4x32-10 bijection for the given counter and key
+    static UInt32x4 block(const UInt32x4 &counter, const UInt32 &key0,
+                          const UInt32 &key1) {
+        UInt32 c0 = counter.x(), c1 = counter.y(),
+               c2 = counter.z(), c3 = counter.w(),
+               k0 = key0, k1 = key1;
+
+        for (int i = 0; i < 10; ++i) {
+            if (i > 0) {
+                k0 += PHILOX_W0;
+                k1 += PHILOX_W1;
+            }
+
+            UInt32 lo0 = c0 * UInt32(PHILOX_M0),
+                   hi0 = mulhi(c0, UInt32(PHILOX_M0)),
+                   lo1 = c2 * UInt32(PHILOX_M1),
+                   hi1 = mulhi(c2, UInt32(PHILOX_M1));
+
+            c0 = hi1 ^ c1 ^ k0;
+            c1 = lo1;
+            c2 = hi0 ^ c3 ^ k1;
+            c3 = lo0;
+        }
+
+        return UInt32x4(c0, c1, c2, c3);
+    }
+
+    /// Return the four 32-bit words of the current block without advancing
+    UInt32x4 peek_uint32x4() const {
+        return block(UInt32x4(index, sample, dimension, 0u),
+                     UInt32(seed), UInt32(sr<32>(seed)));
+    }
+
+    /// Generate four uniformly distributed unsigned 32-bit random numbers
+    DRJIT_INLINE UInt32x4 next_uint32x4() {
+        UInt32x4 result = peek_uint32x4();
+        dimension += 1u;
+        return result;
+    }
+
+    /// Masked version of \ref next_uint32x4
+    DRJIT_INLINE UInt32x4 next_uint32x4(const Mask &mask) {
+        UInt32x4 result = peek_uint32x4();
+        masked(dimension, mask) = dimension + 1u;
+        return result;
+    }
+
+    /// Generate four single precision floating point values on the interval [0, 1)
+    DRJIT_INLINE Float32x4 next_float32x4() {
+        return reinterpret_array<Float32x4>(sr<9>(next_uint32x4()) | 0x3f800000u) - 1.f;
+    }
+
+    /// Masked version of \ref next_float32x4
+    DRJIT_INLINE Float32x4 next_float32x4(const Mask &mask) {
+        return reinterpret_array<Float32x4>(sr<9>(next_uint32x4(mask)) | 0x3f800000u) - 1.f;
+    }
+
+    /**
+     * \brief Generate a uniformly distributed unsigned 32-bit random number
+     *
+     * This consumes an entire block (i.e., one \c dimension). Use \ref
+     * next_uint32x4() when several numbers are needed at once.
+     */
+    DRJIT_INLINE UInt32 next_uint32() { return next_uint32x4().x(); }
+
+    /// Masked version of \ref next_uint32
+    DRJIT_INLINE UInt32 next_uint32(const Mask &mask) {
+        return next_uint32x4(mask).x();
+    }
+
+    /// Generate a uniformly distributed unsigned 64-bit random number
+    DRJIT_INLINE UInt64 next_uint64() {
+        UInt32x4 v = next_uint32x4();
+        return UInt64(v.x()) | sl<32>(UInt64(v.y()));
+    }
+
+    /// Masked version of \ref next_uint64
+    DRJIT_INLINE UInt64 next_uint64(const Mask &mask) {
+        UInt32x4 v = next_uint32x4(mask);
+        return UInt64(v.x()) | sl<32>(UInt64(v.y()));
+    }
+
+    /// Generate a single precision floating point value on the interval [0, 1)
+    DRJIT_INLINE Float32 next_float32() {
+        return reinterpret_array<Float32>(sr<9>(next_uint32()) | 0x3f800000u) - 1.f;
+    }
+
+    /// Masked version of \ref next_float32
+    DRJIT_INLINE Float32 next_float32(const Mask &mask) {
+        return reinterpret_array<Float32>(sr<9>(next_uint32(mask)) | 0x3f800000u) - 1.f;
+    }
+
+    /// Generate a double precision floating point value on the interval [0, 1)
+    DRJIT_INLINE Float64 next_float64() {
+        return reinterpret_array<Float64>(sr<12>(next_uint64()) |
+                                          0x3ff0000000000000ull) - 1.0;
+    }
+
+    /// Masked version of \ref next_float64
+    DRJIT_INLINE Float64 next_float64(const Mask &mask) {
+        return reinterpret_array<Float64>(sr<12>(next_uint64(mask)) |
+                                          0x3ff0000000000000ull) - 1.0;
+    }
+
+    /// Generate a uniformly distributed integer r, where 0 <= r < bound
+    UInt32 next_uint32_bounded(uint32_t bound, Mask mask = true) {
+        // See PCG32::next_uint32_bounded() for details
+        if constexpr (std::is_scalar_v<UInt32>) {
+            DRJIT_MARK_USED(mask);
+            uint32_t threshold = (~bound + 1u) % bound;
+
+            while (true) {
+                UInt32 result = next_uint32();
+
+                if (all(result >= threshold))
+                    return result % bound;
+            }
+        } else {
+            divisor<uint32_t> div(bound);
+            UInt32 threshold = imod(~bound + 1u, div);
+
+            UInt32 result = zeros<UInt32>();
+            do {
+                result[mask] = next_uint32(mask);
+                mask &= result < threshold;
+            } while (any(mask));
+
+            return imod(result, div);
+        }
+    }
+
+    /// Generate a uniformly distributed integer r, where 0 <= r < bound
+    UInt64 next_uint64_bounded(uint64_t bound, Mask mask = true) {
+        if constexpr (std::is_scalar_v<UInt64>) {
+            DRJIT_MARK_USED(mask);
+            uint64_t threshold = (~bound + (uint64_t) 1) % bound;
+
+            while (true) {
+                uint64_t result = next_uint64();
+
+                if (all(result >= threshold))
+                    return result % bound;
+            }
+        } else {
+            divisor<uint64_t> div(bound);
+            uint64_t threshold = (~bound + (uint64_t) 1) % bound;
+            uint32_t threshold_lo = (uint32_t) threshold,
+                     threshold_hi = (uint32_t) (threshold >> 32);
+
+            /* Track both halves separately so that the rejection test stays
+               in the domain of 32-bit masks */
+            UInt32 lo = zeros<UInt32>(), hi = zeros<UInt32>();
+            do {
+                UInt32x4 v = next_uint32x4(mask);
+                lo[mask] = v.x();
+                hi[mask] = v.y();
+                mask &= hi < threshold_hi ||
+                        (eq(hi, threshold_hi) && lo < threshold_lo);
+            } while (any(mask));
+
+            return imod(UInt64(lo) | sl<32>(UInt64(hi)), div);
+        }
+    }
+
+    /// Register internal state of this sampler with a symbolic loop
+    void loop_put(Loop<Mask> &loop) {
+        loop.put(dimension);
+    }
+
+    /// Equality operator
+    bool operator==(const Philox4x32 &other) const {
+        return index == other.index && sample == other.sample &&
+               dimension == other.dimension && seed == other.seed;
+    }
+
+    /// Inequality operator
+    bool operator!=(const Philox4x32 &other) const { return !operator==(other); }
+
+    UInt32 index;      // First counter word, e.g. the pixel index
+    UInt32 sample;     // Second counter word, e.g. the sample number
+    UInt32 dimension;  // Third counter word, advanced by every next_*() call
+    UInt64 seed;       // Key of the bijection
+};
+
 NAMESPACE_END(drjit)
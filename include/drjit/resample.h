@@ -0,0 +1,180 @@
+/*
+    drjit/resample.h -- Separable resampling of tensors
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/math.h>
+#include <drjit/tensor.h>
+
+NAMESPACE_BEGIN(drjit)
+
+/// Reconstruction filters supported by \ref resample()
+enum class ResampleFilter : uint32_t {
+    Box = 0,     /// Box filter (nearest neighbor when upsampling)
+    Tent = 1,    /// Tent filter (linear interpolation when upsampling)
+    Lanczos = 2  /// Lanczos-windowed sinc filter with 3 lobes
+};
+
+NAMESPACE_BEGIN(detail)
+
+/// Problem size of a resampling pass along one tensor axis
+struct ResampleDims {
+    uint32_t outer, in, out, inner;
+};
+
+/// Radius of the filter at its native scale
+inline float resample_radius(ResampleFilter filter) {
+    switch (filter) {
+        case ResampleFilter::Box:  return .5f;
+        case ResampleFilter::Tent: return 1.f;
+        default:                   return 3.f;
+    }
+}
+
+template <typename Array>
+Array resample_weight(ResampleFilter filter, const Array &x) {
+    using Scalar = scalar_t<Array>;
+
+    if (filter == ResampleFilter::Box) {
+        return select(x >= Scalar(-.5f) && x < Scalar(.5f), Array(1), Array(0));
+    } else if (filter == ResampleFilter::Tent) {
+        return maximum(1 - abs(x), 0);
+    } else {
+        Array px = x * Pi<Scalar>,
+              sinc = sin(px) * sin(px * Scalar(1.f / 3.f)) /
+                     (px * px * Scalar(1.f / 3.f));
+        return select(abs(x) < Scalar(1e-5f), Array(1),
+                      select(abs(x) < 3, sinc, Array(0)));
+    }
+}
+
+/**
+ * \brief Resample a flat array of shape (outer, in, inner) to (outer, out,
+ * inner) along its middle dimension
+ *
+ * The filter is stretched by the downsampling factor, so that it also acts
+ * as an antialiasing prefilter. Taps outside of the input are skipped, and
+ * the remaining weights are renormalized. Lanes whose taps all have a zero
+ * weight (which rounding can cause with the box filter) copy the nearest
+ * input sample instead. Every lane evaluates its weights
+ * analytically, which avoids weight tables, and the whole pass is a single
+ * sequence of gathers and FMAs that is differentiable with respect to the
+ * input.
+ */
+template <typename Array>
+Array resample_axis(const Array &a, const ResampleDims &d,
+                    ResampleFilter filter) {
+    using Index = uint32_array_t<Array>;
+    using Int = int32_array_t<Array>;
+    using Mask = mask_t<Array>;
+    using Scalar = scalar_t<Array>;
+
+    float scale = (float) d.in / (float) d.out,
+          stretch = drjit::maximum(scale, 1.f),
+          radius = resample_radius(filter) * stretch;
+    uint32_t taps = (uint32_t) std::ceil(2.f * radius) + 1,
+             lanes = d.outer * d.out * d.inner;
+
+    Index idx = arange<Index>(lanes),
+          inner = idx % d.inner;
+    idx /= d.inner;
+    Index j = idx % d.out,
+          base = (idx / d.out) * (d.in * d.inner) + inner;
+
+    Array center = fmadd(Array(j) + Scalar(.5f), Scalar(scale), Scalar(-.5f));
+    // First tap within the support [center - radius, center + radius]
+    Int start = Int(ceil(center - Scalar(radius)));
+
+    Array result = zeros<Array>(lanes),
+          weight_sum = zeros<Array>(lanes);
+
+    for (uint32_t k = 0; k < taps; ++k) {
+        Int i = start + (int32_t) k;
+        Mask valid = i >= 0 && i < (int32_t) d.in;
+        Array weight = resample_weight(
+            filter, (Array(i) - center) * Scalar(1.f / stretch));
+        weight = select(valid, weight, Array(0));
+
+        Array value = gather<Array>(a, base + Index(i) * d.inner, valid);
+        result = fmadd(value, weight, result);
+        weight_sum += weight;
+    }
+
+    Mask empty = eq(weight_sum, 0);
+    Int nearest = clamp(Int(round(center)), 0, (int32_t) d.in - 1);
+    Array value = gather<Array>(a, base + Index(nearest) * d.inner, empty);
+
+    return select(empty, value, result / weight_sum);
+}
+
+template <typename T>
+T tensor_resample(const T &t, const size_t *shape, ResampleFilter filter) {
+    using Array = typename T::Array;
+    size_t ndim = t.ndim();
+
+    dr_vector<size_t> cur(t.shape().data(), t.shape().data() + ndim);
+    dr_vector<size_t> order;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (shape[i] == 0)
+            drjit_raise("drjit::resample(): target shape entries must be "
+                        "positive!");
+        if (shape[i] != cur[i]) {
+            if (cur[i] == 0)
+                drjit_raise("drjit::resample(): cannot resample an empty "
+                            "dimension!");
+            order.push_back(i);
+        }
+    }
+
+    // Shrink first, which reduces the cost of the remaining passes
+    for (size_t i = 1; i < order.size(); ++i) {
+        for (size_t j = i; j > 0; --j) {
+            size_t a = order[j - 1], b = order[j];
+            if ((double) shape[b] / cur[b] >= (double) shape[a] / cur[a])
+                break;
+            order[j - 1] = b;
+            order[j] = a;
+        }
+    }
+
+    Array value = t.array();
+    for (size_t axis : order) {
+        ResampleDims d { 1, (uint32_t) cur[axis], (uint32_t) shape[axis], 1 };
+        for (size_t i = 0; i < ndim; ++i) {
+            if (i < axis)
+                d.outer *= (uint32_t) cur[i];
+            else if (i > axis)
+                d.inner *= (uint32_t) cur[i];
+        }
+        value = resample_axis(value, d, filter);
+        cur[axis] = shape[axis];
+    }
+
+    return T(value, ndim, cur.data());
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Resample a tensor to the given shape (which has one entry per
+ * tensor dimension) using separable passes of the specified filter
+ *
+ * Each dimension whose size changes is processed by its own pass, and
+ * downsampling passes run first. Derivatives propagate to the input tensor.
+ */
+template <typename Array>
+Tensor<Array> resample(const Tensor<Array> &t, const size_t *shape,
+                       ResampleFilter filter = ResampleFilter::Tent) {
+    return detail::tensor_resample(t, shape, filter);
+}
+
+NAMESPACE_END(drjit)
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <drjit/array.h>
+#include <vector>
 
 NAMESPACE_BEGIN(drjit)
 
@@ -33,7 +34,7 @@ void sh_eval(const Vector3f &d, size_t order, value_t<Vector3f> *out) {
         case 7: sh_eval_7(d, out); break;
         case 8: sh_eval_8(d, out); break;
         case 9: sh_eval_9(d, out); break;
-        default: throw drjit::Exception("sh_eval(): order too high!");
+        default: sh_eval_recurrence(d, order, out); break;
     }
 }
 
@@ -839,4 +840,237 @@ void sh_eval_9(const Vector3f &d, value_t<Vector3f> *out) {
     out[81] = tmp_c * s0;
 }
 
+/**
+ * \brief Evaluate the real spherical harmonics of any order using the
+ * recurrences of the associated Legendre polynomials
+ *
+ * The output layout and sign convention match \ref sh_eval(). The
+ * normalization constants are folded into the recurrence coefficients,
+ * which keeps all intermediate values bounded at high orders, and the
+ * azimuthal terms are obtained from powers of <tt>x + iy</tt>, hence no
+ * transcendental functions are needed. Only a handful of values are live at
+ * any time regardless of the order. The coefficients are computed in double
+ * precision on the host, which costs two scalar square roots per output.
+ */
+template <typename Vector3f>
+void sh_eval_recurrence(const Vector3f &d, size_t order, value_t<Vector3f> *out) {
+    static_assert(array_size_v<Vector3f> == 3, "The parameter 'd' should be a 3D vector.");
+
+    using Value = value_t<Vector3f>;
+    using Scalar = scalar_t<Value>;
+
+    Value x = d.x(), y = d.y(), z = d.z(), c = Scalar(1), s = Scalar(0);
+
+    // Normalized value of P_m^m / sin(theta)^m
+    double pmm = 0.28209479177387814;
+
+    for (size_t m = 0; m <= order; ++m) {
+        if (m > 0) {
+            Value c_next = fmsub(x, c, y * s);
+            s = fmadd(x, s, y * c);
+            c = c_next;
+            pmm *= -std::sqrt((2.0 * m + 1.0) / (2.0 * m)) *
+                   (m == 1 ? 1.4142135623730951 : 1.0);
+        }
+
+        auto store = [&](size_t l, const Value &p) {
+            size_t i = l * (l + 1);
+            if (m == 0) {
+                out[i] = p;
+            } else {
+                out[i + m] = p * c;
+                out[i - m] = p * s;
+            }
+        };
+
+        Value p0 = Scalar(pmm);
+        store(m, p0);
+        if (m == order)
+            break;
+
+        Value p1 = z * Scalar(std::sqrt(2.0 * m + 3.0) * pmm);
+        store(m + 1, p1);
+
+        for (size_t l = m + 2; l <= order; ++l) {
+            double lp = double(l + m), lm = double(l - m), l2 = 2.0 * l,
+                   a = std::sqrt((l2 + 1.0) * (l2 - 1.0) / (lm * lp)),
+                   b = -std::sqrt((l2 + 1.0) * (lp - 1.0) * (lm - 1.0) /
+                                  ((l2 - 3.0) * lm * lp));
+            Value p2 = fmadd(z * Scalar(a), p1, p0 * Scalar(b));
+            store(l, p2);
+            p0 = p1;
+            p1 = p2;
+        }
+    }
+}
+
+/**
+ * \brief Rotate spherical harmonic coefficients of the bands <tt>0 ..
+ * order</tt>
+ *
+ * Given the coefficients \c in of a function \c f, this computes the
+ * coefficients of <tt>g(d) = f(rot^T d)</tt>, i.e. of \c f rotated by the
+ * 3x3 rotation matrix \c rot (e.g. a \ref Matrix, accessed using
+ * <tt>rot(row, col)</tt>). The Wigner D-matrix of every band is built from
+ * that of the previous band with the recurrence of Ivanic and Ruedenberg
+ * ("Rotation Matrices for Real Spherical Harmonics. Direct Determination by
+ * Recursion", J. Phys. Chem. 1996 and its 1998 erratum). The matrices are
+ * computed in the element type of \c rot, which can be a plain scalar when
+ * all lanes share the same rotation. \c out may alias \c in.
+ */
+template <typename Matrix3, typename Value>
+void sh_rotate(const Matrix3 &rot, size_t order, const Value *in, Value *out) {
+    using T = std::decay_t<decltype(rot(0, 0))>;
+
+    // Band 1 in the (y, z, x) order of the real SH basis
+    const size_t perm[3] = { 1, 2, 0 };
+    T r1[3][3];
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            r1[i][j] = rot(perm[i], perm[j]);
+
+    std::vector<T> prev(1, T(1)), cur;
+    std::vector<Value> band;
+
+    out[0] = in[0];
+
+    for (size_t l = 1; l <= order; ++l) {
+        long li = (long) l, w = 2 * li + 1;
+        cur.resize(size_t(w * w));
+
+        auto r = [&](long i, long j) -> const T & { return r1[i + 1][j + 1]; };
+        auto rp = [&](long m, long n) -> const T & {
+            return prev[size_t((m + li - 1) * (w - 2) + n + li - 1)];
+        };
+        auto P = [&](long i, long a, long b) -> T {
+            if (b == li)
+                return r(i, 1) * rp(a, li - 1) - r(i, -1) * rp(a, 1 - li);
+            else if (b == -li)
+                return r(i, 1) * rp(a, 1 - li) + r(i, -1) * rp(a, li - 1);
+            else
+                return r(i, 0) * rp(a, b);
+        };
+
+        for (long m = -li; m <= li; ++m) {
+            long am = m < 0 ? -m : m;
+            double d0 = m == 0 ? 1.0 : 0.0;
+
+            for (long n = -li; n <= li; ++n) {
+                if (l == 1) {
+                    cur[size_t((m + li) * w + n + li)] = r(m, n);
+                    continue;
+                }
+
+                double denom = (n == li || n == -li)
+                                   ? double(2 * li * (2 * li - 1))
+                                   : double((li + n) * (li - n)),
+                       u = std::sqrt(double((li + m) * (li - m)) / denom),
+                       v = .5 * std::sqrt((1.0 + d0) * double((li + am - 1) * (li + am)) /
+                                          denom) * (1.0 - 2.0 * d0),
+                       ww = -.5 * std::sqrt(double((li - am - 1) * (li - am)) / denom) *
+                            (1.0 - d0);
+
+                T value = T(0);
+                if (u != 0.0)
+                    value = T(u) * P(0, m, n);
+
+                if (v != 0.0) {
+                    T V;
+                    if (m == 0)
+                        V = P(1, 1, n) + P(-1, -1, n);
+                    else if (m > 0)
+                        V = m == 1 ? P(1, 0, n) * T(1.4142135623730951)
+                                   : P(1, m - 1, n) - P(-1, 1 - m, n);
+                    else
+                        V = m == -1 ? P(-1, 0, n) * T(1.4142135623730951)
+                                    : P(1, m + 1, n) + P(-1, -m - 1, n);
+                    value = fmadd(T(v), V, value);
+                }
+
+                if (ww != 0.0) {
+                    T W = m > 0 ? P(1, m + 1, n) + P(-1, -m - 1, n)
+                                : P(1, m - 1, n) - P(-1, 1 - m, n);
+                    value = fmadd(T(ww), W, value);
+                }
+
+                cur[size_t((m + li) * w + n + li)] = value;
+            }
+        }
+
+        /* The recurrence assumes a basis without the Condon-Shortley phase
+           used by sh_eval(), which flips the sign of entries with odd m+n */
+        size_t base = l * l;
+        band.assign(in + base, in + base + size_t(w));
+        for (long m = -li; m <= li; ++m) {
+            Value sum = zeros<Value>();
+            for (long n = -li; n <= li; ++n) {
+                T e = cur[size_t((m + li) * w + n + li)];
+                sum = fmadd(((m + n) & 1) ? -e : e, band[size_t(n + li)], sum);
+            }
+            out[base + size_t(m + li)] = sum;
+        }
+
+        prev.swap(cur);
+    }
+}
+
+/**
+ * \brief Compute the coefficients of a zonal function, given by its
+ * coefficients \c zonal[l] (<tt>l = 0 .. order</tt>) with respect to the
+ * +Z axis, after rotating this axis to the direction \c d
+ *
+ * This is a cheap special case of \ref sh_rotate(): the rotated
+ * coefficients are <tt>sqrt(4 pi / (2l + 1)) * zonal[l] * Y_lm(d)</tt>.
+ */
+template <typename Vector3f, typename Zonal>
+void sh_zonal_rotate(const Vector3f &d, size_t order, const Zonal *zonal,
+                     value_t<Vector3f> *out) {
+    using Scalar = scalar_t<value_t<Vector3f>>;
+
+    sh_eval(d, order, out);
+    for (size_t l = 0; l <= order; ++l) {
+        auto scale = zonal[l] * Scalar(std::sqrt(12.566370614359172 / (2.0 * l + 1.0)));
+        for (size_t i = l * l; i < (l + 1) * (l + 1); ++i)
+            out[i] *= scale;
+    }
+}
+
+/**
+ * \brief Convolve spherical harmonic coefficients with a kernel that is
+ * rotationally symmetric about the +Z axis, given by its zonal coefficients
+ * \c kernel[l] (<tt>l = 0 .. order</tt>)
+ *
+ * By the Funk-Hecke theorem, this scales band \c l by <tt>sqrt(4 pi /
+ * (2l + 1)) * kernel[l]</tt>. \c out may alias \c in.
+ */
+template <typename Value, typename Kernel>
+void sh_convolve(const Value *in, size_t order, const Kernel *kernel, Value *out) {
+    using Scalar = scalar_t<Value>;
+
+    for (size_t l = 0; l <= order; ++l) {
+        auto scale = kernel[l] * Scalar(std::sqrt(12.566370614359172 / (2.0 * l + 1.0)));
+        for (size_t i = l * l; i < (l + 1) * (l + 1); ++i)
+            out[i] = in[i] * scale;
+    }
+}
+
+/**
+ * \brief Project a spherical function onto the bands <tt>0 .. order</tt>
+ *
+ * Every lane provides a direction \c d and the function value at this
+ * direction, pre-multiplied by its quadrature weight (e.g. <tt>4 pi / N</tt>
+ * for \c N uniformly distributed directions). The coefficients are the
+ * horizontal sums of <tt>value * Y_lm(d)</tt> over all lanes.
+ */
+template <typename Vector3f>
+void sh_project(const Vector3f &d, const value_t<Vector3f> &value, size_t order,
+                value_t<Vector3f> *out) {
+    using Value = value_t<Vector3f>;
+
+    std::vector<Value> basis((order + 1) * (order + 1));
+    sh_eval(d, order, basis.data());
+    for (size_t i = 0; i < basis.size(); ++i)
+        out[i] = sum(value * basis[i]);
+}
+
 NAMESPACE_END(drjit)
@@ -0,0 +1,408 @@
+/*
+    drjit/sparse.h -- Sparse matrices in compressed sparse row (CSR) format
+    and their products with dense vectors and matrices
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/custom.h>
+#include <drjit/loop.h>
+
+NAMESPACE_BEGIN(drjit)
+NAMESPACE_BEGIN(detail)
+
+/// Value gradients of products with up to this many dense columns are unrolled
+static constexpr uint32_t SparseUnroll = 8;
+
+/**
+ * \brief Sparsity pattern of a CSR matrix, along with the pattern of its
+ * transpose
+ *
+ * Entry \c i of the transpose corresponds to entry <tt>t_perm[i]</tt> of the
+ * matrix. Storing both orientations lets products with the matrix and with
+ * its transpose run row-parallel, without atomic operations.
+ */
+template <typename UInt32> struct SparsePattern {
+    uint32_t rows = 0, cols = 0;
+
+    /// Index of the first entry of every row, followed by the number of entries
+    UInt32 offset;
+
+    /// Row and column of every entry
+    UInt32 row, col;
+
+    /// The same information for the transpose
+    UInt32 t_offset, t_row, t_col, t_perm;
+};
+
+/**
+ * \brief Sort the entries <tt>(row[i], col[i])</tt> of a matrix with \c rows
+ * rows into row-major order
+ *
+ * This is a counting sort: an atomic increment assigns every entry a slot
+ * within its row, and an exclusive prefix sum over the row sizes yields the
+ * offset of each row. The order of the entries within a row is unspecified.
+ * Returns the row offsets, and the index of the source entry of every sorted
+ * entry.
+ */
+template <typename UInt32>
+std::pair<UInt32, UInt32> sparse_sort(uint32_t rows, const UInt32 &row) {
+    uint32_t nnz = (uint32_t) width(row);
+
+    UInt32 count = zeros<UInt32>(rows + 1);
+    if (nnz == 0)
+        return { count, UInt32() };
+
+    UInt32 slot = scatter_inc(count, row);
+    eval(slot);
+
+    UInt32 offset = prefix_sum(count, true),
+           perm = empty<UInt32>(nnz);
+    scatter(perm, arange<UInt32>(nnz), gather<UInt32>(offset, row) + slot);
+
+    return { offset, perm };
+}
+
+/// Row of every entry of a CSR matrix with the given row offsets
+template <typename UInt32>
+UInt32 sparse_rows(uint32_t rows, uint32_t nnz, const UInt32 &offset) {
+    if (nnz == 0)
+        return UInt32();
+
+    // Mark the first entry of every row except for the first one
+    UInt32 mark = zeros<UInt32>(nnz);
+    if (rows > 1) {
+        UInt32 start = gather<UInt32>(offset, arange<UInt32>(1, rows));
+        scatter_reduce(ReduceOp::Add, mark, UInt32(1), start, start < nnz);
+    }
+
+    return prefix_sum(mark, false);
+}
+
+/**
+ * \brief Multiply a CSR matrix with the row-major dense matrix \c b that has
+ * \c k columns
+ *
+ * Every lane computes one entry of the result and accumulates the products
+ * along its row in a loop, hence rows are processed in parallel without any
+ * atomic operations.
+ */
+template <typename Float, typename UInt32>
+Float sparse_matmul_kernel(uint32_t rows, const UInt32 &offset,
+                           const UInt32 &col, const Float &values,
+                           const Float &b, uint32_t k) {
+    using Mask = mask_t<UInt32>;
+
+    if (rows == 0 || k == 0)
+        return Float();
+
+    UInt32 idx = arange<UInt32>(rows * k), row = idx, j = zeros<UInt32>(1);
+    if (k > 1) {
+        row = idx / k;
+        j = idx - row * k;
+    }
+
+    UInt32 i   = gather<UInt32>(offset, row),
+           end = gather<UInt32>(offset, row + 1u);
+    Float acc = zeros<Float>(rows * k);
+
+    Loop<Mask> loop("drjit::SparseMatrix::matmul", i, acc);
+    while (loop(i < end)) {
+        UInt32 c = gather<UInt32>(col, i);
+        acc = fmadd(gather<Float>(values, i), gather<Float>(b, c * k + j), acc);
+        i++;
+    }
+
+    return acc;
+}
+
+/// Product of a matrix (or its transpose) with a dense matrix
+template <typename Float, typename UInt32>
+Float sparse_matmul(const SparsePattern<UInt32> &p, const Float &values,
+                    const Float &b, uint32_t k, bool transpose) {
+    if (!transpose)
+        return sparse_matmul_kernel(p.rows, p.offset, p.col, values, b, k);
+    else
+        return sparse_matmul_kernel(p.cols, p.t_offset, p.t_col,
+                                    gather<Float>(values, p.t_perm), b, k);
+}
+
+/**
+ * \brief Gradient of the matrix values given the gradient \c g of a product
+ * with the dense matrix \c b
+ *
+ * The derivative of entry (r, c) is the dot product of row r of \c g and row
+ * c of \c b (or vice versa, for a product with the transpose).
+ */
+template <typename Float, typename UInt32>
+Float sparse_grad_values(const SparsePattern<UInt32> &p, const Float &g,
+                         const Float &b, uint32_t k, bool transpose) {
+    using Mask = mask_t<UInt32>;
+
+    uint32_t nnz = (uint32_t) width(p.col);
+    if (nnz == 0 || k == 0)
+        return zeros<Float>(nnz);
+
+    UInt32 rg = (transpose ? p.col : p.row) * k,
+           rb = (transpose ? p.row : p.col) * k;
+    Float acc = zeros<Float>(nnz);
+
+    if (k <= SparseUnroll) {
+        for (uint32_t j = 0; j < k; ++j)
+            acc = fmadd(gather<Float>(g, rg + j), gather<Float>(b, rb + j), acc);
+    } else {
+        UInt32 j = zeros<UInt32>(nnz);
+        Loop<Mask> loop("drjit::SparseMatrix::grad", j, acc);
+        while (loop(j < k)) {
+            acc = fmadd(gather<Float>(g, rg + j), gather<Float>(b, rb + j), acc);
+            j++;
+        }
+    }
+
+    return acc;
+}
+
+template <typename DiffFloat>
+struct SparseMatmulOp
+    : CustomOp<DiffFloat, DiffFloat, DiffFloat, DiffFloat,
+               SparsePattern<uint32_array_t<detached_t<DiffFloat>>>, uint32_t,
+               bool> {
+    using Float = detached_t<DiffFloat>;
+    using Pattern = SparsePattern<uint32_array_t<Float>>;
+    using Base = CustomOp<DiffFloat, DiffFloat, DiffFloat, DiffFloat, Pattern,
+                          uint32_t, bool>;
+
+    static constexpr bool ClearPrimal = false;
+
+    DiffFloat eval(const DiffFloat &values, const DiffFloat &b,
+                   const Pattern &p, const uint32_t &k,
+                   const bool &transpose) override {
+        m_pattern = p;
+        m_k = k;
+        m_transpose = transpose;
+        return DiffFloat(sparse_matmul(p, detach(values), detach(b), k, transpose));
+    }
+
+    void forward() override {
+        Float result = zeros<Float>(
+            (m_transpose ? m_pattern.cols : m_pattern.rows) * m_k);
+
+        if (Base::template grad_enabled_in<0>())
+            result += sparse_matmul(m_pattern,
+                                    detach(Base::template grad_in<0>()),
+                                    detach(Base::template value_in<1>()), m_k,
+                                    m_transpose);
+
+        if (Base::template grad_enabled_in<1>())
+            result += sparse_matmul(m_pattern,
+                                    detach(Base::template value_in<0>()),
+                                    detach(Base::template grad_in<1>()), m_k,
+                                    m_transpose);
+
+        Base::set_grad_out(DiffFloat(result));
+    }
+
+    void backward() override {
+        Float grad = detach(Base::grad_out());
+
+        if (Base::template grad_enabled_in<0>())
+            Base::template set_grad_in<0>(DiffFloat(sparse_grad_values(
+                m_pattern, grad, detach(Base::template value_in<1>()), m_k,
+                m_transpose)));
+
+        if (Base::template grad_enabled_in<1>())
+            Base::template set_grad_in<1>(DiffFloat(sparse_matmul(
+                m_pattern, detach(Base::template value_in<0>()), grad, m_k,
+                !m_transpose)));
+    }
+
+    const char *name() const override { return "sparse_matmul"; }
+
+private:
+    Pattern m_pattern;
+    uint32_t m_k;
+    bool m_transpose;
+};
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Sparse matrix in compressed sparse row (CSR) format
+ *
+ * The entries of row \c r are stored at the indices
+ * <tt>[offset[r], offset[r + 1])</tt> of \ref col and \ref values. Products
+ * with dense vectors and matrices process the rows in parallel, hence they
+ * require no atomic operations. This also holds for products with the
+ * transpose, for which \ref update() precomputes the transposed sparsity
+ * pattern once.
+ *
+ * The products are differentiable with respect to both the dense operand and
+ * \ref values. The reverse-mode derivative of a product with the matrix is a
+ * product with its transpose (and vice versa).
+ *
+ * The values can be modified at any time, while changes to the sparsity
+ * pattern require a call to \ref update().
+ *
+ * \code
+ * SparseMatrix<Float> A = SparseMatrix<Float>::from_coo(n, n, row, col, value);
+ * Float y  = A.matvec(x),
+ *       yt = A.matvec(x, true); // A^T x
+ * \endcode
+ */
+template <typename Float_> struct SparseMatrix {
+    using Float   = Float_;
+    using FloatD  = detached_t<Float>;
+    using UInt32  = uint32_array_t<FloatD>;
+    using Pattern = detail::SparsePattern<UInt32>;
+
+    static_assert(is_jit_v<Float> && array_depth_v<Float> == 1,
+                  "SparseMatrix: requires a flat JIT array type!");
+
+    /// Number of rows and columns
+    uint32_t rows = 0, cols = 0;
+
+    /// Index of the first entry of every row, followed by the number of entries
+    UInt32 offset;
+
+    /// Column of every entry
+    UInt32 col;
+
+    /// Value of every entry
+    Float values;
+
+    /// Sparsity pattern of the matrix and its transpose (set by \ref update())
+    Pattern pattern;
+
+    SparseMatrix() = default;
+
+    /// Create a matrix from CSR arrays
+    SparseMatrix(uint32_t rows, uint32_t cols, const UInt32 &offset,
+                 const UInt32 &col, const Float &values)
+        : rows(rows), cols(cols), offset(offset), col(col), values(values) {
+        update();
+    }
+
+    /**
+     * \brief Create a matrix from a list of (row, column, value) triplets in
+     * any order (coordinate format)
+     *
+     * Duplicate entries are kept, and effectively summed by the products.
+     */
+    static SparseMatrix from_coo(uint32_t rows, uint32_t cols,
+                                 const UInt32 &row, const UInt32 &col,
+                                 const Float &values) {
+        size_t nnz = width(row);
+        if (width(col) != nnz || width(values) != nnz)
+            drjit_raise("drjit::SparseMatrix::from_coo(): the row, column and "
+                        "value arrays must have the same size (%zu, %zu and "
+                        "%zu)!", nnz, width(col), width(values));
+
+        auto [offset, perm] = detail::sparse_sort(rows, row);
+        if (nnz == 0)
+            return SparseMatrix(rows, cols, offset, UInt32(), Float());
+
+        return SparseMatrix(rows, cols, offset, gather<UInt32>(col, perm),
+                            gather<Float>(values, perm));
+    }
+
+    /// Recompute \ref pattern after modifying \ref offset or \ref col
+    void update() {
+        size_t nnz = width(col);
+        if (width(offset) != (size_t) rows + 1)
+            drjit_raise("drjit::SparseMatrix::update(): expected %u row "
+                        "offsets, got %zu!", rows + 1, width(offset));
+        if (width(values) != nnz)
+            drjit_raise("drjit::SparseMatrix::update(): the column and value "
+                        "arrays must have the same size (%zu and %zu)!", nnz,
+                        width(values));
+        if (nnz >= (1ull << 32))
+            drjit_raise("drjit::SparseMatrix::update(): too many entries "
+                        "(%zu)!", nnz);
+
+        pattern.rows = rows;
+        pattern.cols = cols;
+        pattern.offset = offset;
+        pattern.col = col;
+        pattern.row = detail::sparse_rows(rows, (uint32_t) nnz, offset);
+
+        std::tie(pattern.t_offset, pattern.t_perm) =
+            detail::sparse_sort(cols, col);
+        if (nnz > 0) {
+            pattern.t_row = gather<UInt32>(col, pattern.t_perm);
+            pattern.t_col = gather<UInt32>(pattern.row, pattern.t_perm);
+        }
+        eval(pattern.row, pattern.t_offset, pattern.t_row, pattern.t_col);
+    }
+
+    /// Number of stored entries
+    uint32_t nnz() const { return (uint32_t) width(col); }
+
+    /// Return the transpose of this matrix
+    SparseMatrix transpose() const {
+        SparseMatrix result;
+        result.rows = cols;
+        result.cols = rows;
+        result.offset = pattern.t_offset;
+        result.col = pattern.t_col;
+        if (nnz() > 0)
+            result.values = gather<Float>(values, pattern.t_perm);
+
+        Pattern &p = result.pattern;
+        p.rows = cols;
+        p.cols = rows;
+        p.offset = pattern.t_offset;
+        p.row = pattern.t_row;
+        p.col = pattern.t_col;
+        p.t_offset = pattern.offset;
+        p.t_row = pattern.row;
+        p.t_col = pattern.col;
+
+        // Inverse of the permutation 't_perm'
+        if (nnz() > 0) {
+            p.t_perm = empty<UInt32>(nnz());
+            scatter(p.t_perm, arange<UInt32>(nnz()), pattern.t_perm);
+        }
+
+        return result;
+    }
+
+    /// Multiply the matrix (or its transpose) with a dense vector
+    Float matvec(const Float &x, bool transpose = false) const {
+        return matmul(x, 1, transpose);
+    }
+
+    /**
+     * \brief Multiply the matrix (or its transpose) with the dense matrix \c b,
+     * which has \c k columns and is stored in row-major order
+     *
+     * The result is a row-major matrix with \c k columns.
+     */
+    Float matmul(const Float &b, uint32_t k, bool transpose = false) const {
+        size_t expected = (size_t) (transpose ? rows : cols) * k;
+        if (width(b) != expected)
+            drjit_raise("drjit::SparseMatrix::matmul(): the dense operand must "
+                        "have %zu entries (got %zu)!", expected, width(b));
+        if (width(pattern.offset) != (size_t) rows + 1)
+            drjit_raise("drjit::SparseMatrix::matmul(): the sparsity pattern "
+                        "is out of date, call update()!");
+
+        if constexpr (is_diff_v<Float>) {
+            if (grad_enabled(values, b))
+                return custom<detail::SparseMatmulOp<Float>>(
+                    values, b, pattern, k, transpose);
+        }
+
+        return Float(detail::sparse_matmul(pattern, detach(values), detach(b),
+                                           k, transpose));
+    }
+};
+
+NAMESPACE_END(drjit)
@@ -0,0 +1,204 @@
+/*
+    drjit/staging.h -- Ring of pinned host buffers for asynchronous
+    host<->device transfers
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#pragma once
+
+#include <drjit/jit.h>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+
+NAMESPACE_BEGIN(drjit)
+
+/**
+ * \brief Handle of a transfer issued by a \ref StagingRing
+ *
+ * The transfer is complete once all work preceding it on the stream of the
+ * issuing thread has finished.
+ */
+struct StagingTransfer {
+    StagingTransfer() = default;
+    StagingTransfer(const std::atomic<uint64_t> *completed, uint64_t id)
+        : m_completed(completed), m_id(id) { }
+
+    /// Has the transfer finished?
+    bool done() const {
+        return !m_completed || m_completed->load(std::memory_order_acquire) >= m_id;
+    }
+
+    /// Block until the transfer has finished
+    void wait() const {
+        while (!done())
+            std::this_thread::yield();
+    }
+
+private:
+    const std::atomic<uint64_t> *m_completed = nullptr;
+    uint64_t m_id = 0;
+};
+
+/**
+ * \brief Reusable ring of pinned host buffers for streaming data to and from
+ * a JIT backend
+ *
+ * Plain \ref load() and \ref store() operate on pageable host memory, which
+ * makes them copy through a temporary buffer and (when storing) wait for the
+ * device. A staging ring instead owns \c slots buffers of
+ * <tt>AllocType::HostPinned</tt> memory (host memory on the LLVM backend),
+ * each holding up to \c capacity entries. The application writes its input
+ * directly into a buffer returned by \ref acquire() and then calls \ref
+ * upload(), which enqueues an asynchronous copy and immediately returns the
+ * resulting array along with a \ref StagingTransfer handle. Kernels using the
+ * array are ordered after the copy on the same stream, while the host can
+ * already prepare the next buffer, hence host preparation, transfers and
+ * kernels overlap. \ref download() works the other way around.
+ *
+ * A buffer is reused once its previous transfer has completed: \ref acquire()
+ * waits for this when the ring wraps around. A staging ring must only be used
+ * by one thread at a time.
+ *
+ * \code
+ * StagingRing<CUDAArray<float>> ring(1 << 20);
+ * for (Frame &frame : frames) {
+ *     float *buf = ring.acquire();
+ *     frame.decode(buf);
+ *     auto [input, transfer] = ring.upload(frame.size());
+ *     render(input);
+ * }
+ * \endcode
+ */
+template <typename Array> class StagingRing {
+public:
+    using Value = scalar_t<Array>;
+    static constexpr JitBackend Backend = detached_t<Array>::Backend;
+
+    static_assert(is_jit_v<Array> && array_depth_v<Array> == 1 &&
+                      !is_diff_v<Array>,
+                  "StagingRing: requires a flat (non-differentiable) JIT array type!");
+
+    StagingRing(size_t capacity, size_t slots = 3)
+        : m_capacity(capacity), m_slot_count(slots),
+          m_slots(new Slot[slots]) {
+        if (capacity == 0 || slots == 0)
+            drjit_raise("drjit::StagingRing(): the capacity and number of "
+                        "slots must be positive!");
+
+        AllocType type = Backend == JitBackend::CUDA ? AllocType::HostPinned
+                                                     : AllocType::Host;
+        for (size_t i = 0; i < slots; ++i)
+            m_slots[i].ptr = (Value *) jit_malloc(type, capacity * sizeof(Value));
+    }
+
+    ~StagingRing() {
+        for (size_t i = 0; i < m_slot_count; ++i) {
+            Slot &slot = m_slots[i];
+            wait(slot);
+            jit_free(slot.ptr);
+        }
+    }
+
+    StagingRing(const StagingRing &) = delete;
+    StagingRing &operator=(const StagingRing &) = delete;
+
+    /// Number of entries per buffer
+    size_t capacity() const { return m_capacity; }
+
+    /// Number of buffers in the ring
+    size_t slots() const { return m_slot_count; }
+
+    /**
+     * \brief Advance to the next buffer of the ring and return it
+     *
+     * Waits until the buffer's previous transfer has completed.
+     */
+    Value *acquire() {
+        m_current = (m_current + 1) % m_slot_count;
+        Slot &slot = m_slots[m_current];
+        wait(slot);
+        return slot.ptr;
+    }
+
+    /**
+     * \brief Asynchronously copy the first \c size entries of the buffer
+     * returned by the last call to \ref acquire() into a new array
+     */
+    std::pair<Array, StagingTransfer> upload(size_t size) {
+        Slot &slot = current("upload", size);
+        size_t bytes = size * sizeof(Value);
+
+        void *target = jit_malloc(Backend == JitBackend::CUDA
+                                      ? AllocType::Device
+                                      : AllocType::HostAsync,
+                                  bytes);
+        jit_memcpy_async(Backend, target, slot.ptr, bytes);
+        StagingTransfer transfer = issue(slot);
+
+        return { Array::map_(target, size, true), transfer };
+    }
+
+    /**
+     * \brief Asynchronously copy \c array into the next buffer of the ring
+     *
+     * Returns the buffer, whose contents are valid once the transfer has
+     * completed, and remain so until the ring wraps around to it again.
+     */
+    std::pair<const Value *, StagingTransfer> download(const Array &array) {
+        Value *ptr = acquire();
+        size_t size = array.size();
+        Slot &slot = current("download", size);
+
+        array.eval_();
+        jit_memcpy_async(Backend, ptr, array.data(), size * sizeof(Value));
+        return { ptr, issue(slot) };
+    }
+
+private:
+    struct Slot {
+        Value *ptr = nullptr;
+        uint64_t issued = 0;
+        std::atomic<uint64_t> completed{0};
+    };
+
+    Slot &current(const char *name, size_t size) {
+        if (size > m_capacity)
+            drjit_raise("drjit::StagingRing::%s(): the size (%zu) exceeds the "
+                        "capacity of the staging buffers (%zu)!", name, size,
+                        m_capacity);
+        return m_slots[m_current];
+    }
+
+    /// Mark the slot as busy until the work enqueued so far has finished
+    StagingTransfer issue(Slot &slot) {
+        uint64_t id = ++slot.issued;
+        jit_enqueue_host_func(Backend, &StagingRing::release, &slot.completed);
+        return StagingTransfer(&slot.completed, id);
+    }
+
+    /// Host callback that runs once a transfer has finished
+    static void release(void *payload) {
+        ((std::atomic<uint64_t> *) payload)
+            ->fetch_add(1, std::memory_order_release);
+    }
+
+    static void wait(const Slot &slot) {
+        StagingTransfer(&slot.completed, slot.issued).wait();
+    }
+
+private:
+    size_t m_capacity, m_slot_count;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_current = 0;
+};
+
+NAMESPACE_END(drjit)
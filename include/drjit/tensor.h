@@ -13,7 +13,10 @@
 #pragma once
 
 #include <drjit/array.h>
+#include <drjit/custom.h>
+#include <drjit/loop.h>
 #include <drjit-core/containers.h>
+#include <limits>
 
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
@@ -25,6 +28,13 @@ void tensor_broadcast_impl(const char *op, T &t, const dr_vector<size_t> &shape)
     if (ndim == 0 || memcmp(t.shape().data(), shape.data(), sizeof(size_t) * ndim) == 0)
         return;
 
+    /* A single element is broadcast by the array itself, which avoids the
+       gather (and the evaluation of its source) below */
+    if (t.array().size() == 1) {
+        t = T(t.array(), shape.size(), shape.data());
+        return;
+    }
+
     uint32_t size = 1;
     for (int i = 0; i < ndim; ++i)
         size *= (uint32_t) shape[i];
@@ -91,6 +101,469 @@ dr_vector<size_t> tensor_broadcast(const char *op, T0 &t0, T1 &t1, T2 &t2) {
     return shape;
 }
 
+/// Strides (batch, row, column) of an operand of \ref matmul_kernel()
+struct MatmulLayout {
+    uint32_t batch, row, col;
+};
+
+/// Problem size of a batched matrix multiplication, see \ref tensor_matmul()
+struct MatmulDims {
+    uint32_t batch, m, n, k;
+
+    /// Batch strides of the two operands (zero when broadcast over the batch)
+    uint32_t a_batch, b_batch;
+};
+
+/// Size of the register-blocked output tile computed by each lane
+static constexpr uint32_t MatmulBlockM = 2, MatmulBlockN = 4;
+
+/// Contraction unroll factor of recorded loops
+static constexpr uint32_t MatmulBlockK = 4;
+
+/// Contractions up to this length are fully unrolled
+static constexpr uint32_t MatmulUnroll = 16;
+
+/**
+ * \brief Compute the batched matrix product C[b] = A[b] @ B[b], where A[b] is
+ * a (m x k) and B[b] a (k x n) matrix stored in flat arrays with the given
+ * layouts. The result is a contiguous array of shape (batch, m, n).
+ *
+ * Every lane accumulates a (MatmulBlockM x MatmulBlockN) tile of the output,
+ * which lets each gathered entry of A and B feed several FMAs. On JIT
+ * backends, long contractions are recorded as a loop over unrolled blocks of
+ * MatmulBlockK entries to keep the size of the generated kernel bounded.
+ */
+template <typename Array>
+Array matmul_kernel(const Array &a, const MatmulLayout &la, const Array &b,
+                    const MatmulLayout &lb, uint32_t batch, uint32_t m,
+                    uint32_t n, uint32_t k) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+
+    uint32_t rm = drjit::minimum(m, MatmulBlockM),
+             rn = drjit::minimum(n, MatmulBlockN);
+
+    if (batch == 0 || m == 0 || n == 0 || k == 0)
+        return zeros<Array>(batch * m * n);
+
+    uint32_t bm = (m + rm - 1) / rm, bn = (n + rn - 1) / rn,
+             lanes = batch * bm * bn;
+
+    Index idx = arange<Index>(lanes),
+          bj = idx % bn;
+    idx /= bn;
+    Index bi = idx % bm,
+          bb = idx / bm,
+          i0 = bi * rm,
+          j0 = bj * rn;
+
+    Index a_base[MatmulBlockM], b_base[MatmulBlockN];
+    Mask row_valid[MatmulBlockM], col_valid[MatmulBlockN];
+
+    for (uint32_t r = 0; r < rm; ++r) {
+        row_valid[r] = i0 + r < m;
+        a_base[r] = bb * la.batch + (i0 + r) * la.row;
+    }
+
+    for (uint32_t c = 0; c < rn; ++c) {
+        col_valid[c] = j0 + c < n;
+        b_base[c] = bb * lb.batch + (j0 + c) * lb.col;
+    }
+
+    Array acc[MatmulBlockM * MatmulBlockN];
+    for (uint32_t i = 0; i < rm * rn; ++i)
+        acc[i] = zeros<Array>(lanes);
+
+    auto step = [&](const auto &kk, const Mask &active) {
+        Array av[MatmulBlockM], bv[MatmulBlockN];
+
+        for (uint32_t r = 0; r < rm; ++r)
+            av[r] = gather<Array>(a, a_base[r] + kk * la.col,
+                                  active && row_valid[r]);
+
+        for (uint32_t c = 0; c < rn; ++c)
+            bv[c] = gather<Array>(b, b_base[c] + kk * lb.row,
+                                  active && col_valid[c]);
+
+        for (uint32_t r = 0; r < rm; ++r)
+            for (uint32_t c = 0; c < rn; ++c)
+                acc[r * rn + c] = fmadd(av[r], bv[c], acc[r * rn + c]);
+    };
+
+    bool unroll = true;
+    if constexpr (is_jit_v<Array>) {
+        if (k > MatmulUnroll) {
+            Index kk = zeros<Index>(lanes);
+
+            Loop<Mask> loop("drjit::matmul");
+            loop.put(kk);
+            for (uint32_t i = 0; i < rm * rn; ++i)
+                loop.put(acc[i]);
+            loop.init();
+
+            while (loop(kk < k)) {
+                for (uint32_t u = 0; u < MatmulBlockK; ++u)
+                    step(kk + u, kk + u < k);
+                kk += MatmulBlockK;
+            }
+
+            unroll = false;
+        }
+    }
+
+    if (unroll) {
+        for (uint32_t kk = 0; kk < k; ++kk)
+            step(kk, true);
+    }
+
+    Array result = zeros<Array>(batch * m * n);
+    Index c_base = bb * (m * n);
+
+    for (uint32_t r = 0; r < rm; ++r)
+        for (uint32_t c = 0; c < rn; ++c)
+            scatter(result, acc[r * rn + c], c_base + (i0 + r) * n + j0 + c,
+                    row_valid[r] && col_valid[c]);
+
+    return result;
+}
+
+/// Primal evaluation of \ref tensor_matmul()
+template <typename Array>
+Array matmul_forward(const Array &a, const Array &b, const MatmulDims &d) {
+    return matmul_kernel(a, { d.a_batch, d.k, 1 }, b, { d.b_batch, d.n, 1 },
+                         d.batch, d.m, d.n, d.k);
+}
+
+/// Adjoint of \ref matmul_forward() with respect to the first operand
+template <typename Array>
+Array matmul_grad_a(const Array &grad, const Array &b, const MatmulDims &d) {
+    Array result = matmul_kernel(grad, { d.m * d.n, d.n, 1 }, b,
+                                 { d.b_batch, 1, d.n }, d.batch, d.m, d.k, d.n);
+
+    if (d.a_batch == 0 && d.batch > 1) {
+        // Accumulate the per-batch gradients of a broadcast operand
+        using Index = uint32_array_t<Array>;
+        uint32_t size = d.m * d.k;
+        Array sum = zeros<Array>(size);
+        scatter_reduce(ReduceOp::Add, sum, result,
+                       arange<Index>(d.batch * size) % size);
+        result = sum;
+    }
+
+    return result;
+}
+
+/// Adjoint of \ref matmul_forward() with respect to the second operand
+template <typename Array>
+Array matmul_grad_b(const Array &a, const Array &grad, const MatmulDims &d) {
+    if (d.b_batch == 0 && d.batch > 1) {
+        /* The rows of all batches of A and the incoming gradient are stored
+           contiguously, which turns the batch reduction into one long
+           contraction */
+        return matmul_kernel(a, { 0, 1, d.k }, grad, { 0, d.n, 1 }, 1, d.k,
+                             d.n, d.batch * d.m);
+    }
+
+    return matmul_kernel(a, { d.a_batch, 1, d.k }, grad, { d.m * d.n, d.n, 1 },
+                         d.batch, d.k, d.n, d.m);
+}
+
+template <typename DiffArray>
+struct MatmulOp
+    : CustomOp<DiffArray, DiffArray, DiffArray, DiffArray, MatmulDims> {
+    using Base = CustomOp<DiffArray, DiffArray, DiffArray, DiffArray, MatmulDims>;
+    using Array = detached_t<DiffArray>;
+
+    static constexpr bool ClearPrimal = false;
+
+    DiffArray eval(const DiffArray &a, const DiffArray &b,
+                   const MatmulDims &dims) override {
+        m_dims = dims;
+        return DiffArray(matmul_forward(detach(a), detach(b), dims));
+    }
+
+    void forward() override {
+        Array result = zeros<Array>(m_dims.batch * m_dims.m * m_dims.n);
+
+        if (Base::template grad_enabled_in<0>())
+            result += matmul_forward(detach(Base::template grad_in<0>()),
+                                     detach(Base::template value_in<1>()),
+                                     m_dims);
+
+        if (Base::template grad_enabled_in<1>())
+            result += matmul_forward(detach(Base::template value_in<0>()),
+                                     detach(Base::template grad_in<1>()),
+                                     m_dims);
+
+        Base::set_grad_out(DiffArray(result));
+    }
+
+    void backward() override {
+        Array grad = detach(Base::grad_out());
+
+        if (Base::template grad_enabled_in<0>())
+            Base::template set_grad_in<0>(DiffArray(matmul_grad_a(
+                grad, detach(Base::template value_in<1>()), m_dims)));
+
+        if (Base::template grad_enabled_in<1>())
+            Base::template set_grad_in<1>(DiffArray(matmul_grad_b(
+                detach(Base::template value_in<0>()), grad, m_dims)));
+    }
+
+    const char *name() const override { return "matmul"; }
+
+private:
+    MatmulDims m_dims;
+};
+
+/**
+ * \brief Matrix product of the last two dimensions of two tensors
+ *
+ * The leading (batch) dimensions of both operands must either agree, or one
+ * of the two operands must be a plain matrix that is broadcast over the
+ * batch. Differentiable tensors propagate derivatives via \ref MatmulOp.
+ */
+template <typename T>
+T tensor_matmul(const T &a, const T &b) {
+    using Array = typename T::Array;
+    size_t ad = a.ndim(), bd = b.ndim();
+
+    if (ad < 2 || bd < 2)
+        drjit_raise("drjit::Tensor::matmul_(): operands must have at least "
+                    "two dimensions (got %zu and %zu)!", ad, bd);
+
+    MatmulDims d;
+    d.m = (uint32_t) a.shape(ad - 2);
+    d.k = (uint32_t) a.shape(ad - 1);
+    d.n = (uint32_t) b.shape(bd - 1);
+
+    if (b.shape(bd - 2) != d.k)
+        drjit_raise("drjit::Tensor::matmul_(): incompatible inner dimensions "
+                    "(%u and %zu)!", d.k, b.shape(bd - 2));
+
+    if (ad > 2 && bd > 2 &&
+        (ad != bd || memcmp(a.shape().data(), b.shape().data(),
+                            sizeof(size_t) * (ad - 2)) != 0))
+        drjit_raise("drjit::Tensor::matmul_(): incompatible batch dimensions!");
+
+    const T &batched = ad >= bd ? a : b;
+    dr_vector<size_t> shape(batched.shape().data(),
+                            batched.shape().data() + batched.ndim());
+    shape[shape.size() - 2] = d.m;
+    shape[shape.size() - 1] = d.n;
+
+    d.batch = 1;
+    for (size_t i = 0; i < shape.size() - 2; ++i)
+        d.batch *= (uint32_t) shape[i];
+    d.a_batch = ad > 2 ? d.m * d.k : 0;
+    d.b_batch = bd > 2 ? d.k * d.n : 0;
+
+    Array result;
+    if constexpr (is_diff_v<Array>)
+        result = custom<MatmulOp<Array>>(a.array(), b.array(), d);
+    else
+        result = matmul_forward(a.array(), b.array(), d);
+
+    return T(result, shape.size(), shape.data());
+}
+
+/// Problem size of a reduction along one tensor axis, see \ref tensor_reduce()
+struct ReduceDims {
+    uint32_t outer, size, inner;
+};
+
+/// Segments of up to this length are reduced by a single unrolled tree
+static constexpr uint32_t ReduceUnroll = 16;
+
+/// Number of entries combined by each iteration of recorded reduction loops
+static constexpr uint32_t ReduceBlock = 8;
+
+/// Neutral element of the reductions supported by \ref reduce_kernel()
+template <typename Value> Value reduce_identity(ReduceOp op) {
+    using Limits = std::numeric_limits<Value>;
+    if (op == ReduceOp::Min)
+        return Limits::has_infinity ? Limits::infinity() : Limits::max();
+    else if (op == ReduceOp::Max)
+        return Limits::has_infinity ? -Limits::infinity() : Limits::lowest();
+    else
+        return Value(0);
+}
+
+template <typename Array>
+Array reduce_combine(ReduceOp op, const Array &a, const Array &b) {
+    if (op == ReduceOp::Min)
+        return minimum(a, b);
+    else if (op == ReduceOp::Max)
+        return maximum(a, b);
+    else
+        return a + b;
+}
+
+/**
+ * \brief Reduce a flat array of shape (outer, size, inner) along its middle
+ * dimension using the operation \c op (\c Add, \c Min, or \c Max)
+ *
+ * Every lane handles one output entry. It gathers the entries of its segment
+ * and combines them pairwise in a tree, which shortens the dependency chain
+ * and is more accurate than a sequential accumulation. On JIT backends, long
+ * segments are processed by a recorded loop that combines a tree of
+ * ReduceBlock entries per iteration, so that the whole reduction compiles to
+ * a single kernel.
+ */
+template <typename Array>
+Array reduce_kernel(ReduceOp op, const Array &a, const ReduceDims &d) {
+    using Index = uint32_array_t<Array>;
+    using Mask = mask_t<Array>;
+    using Scalar = scalar_t<Array>;
+
+    if (op != ReduceOp::Add && op != ReduceOp::Min && op != ReduceOp::Max)
+        drjit_raise("drjit::Tensor::reduce_(): unsupported reduction!");
+
+    uint32_t lanes = d.outer * d.inner;
+    Scalar identity = reduce_identity<Scalar>(op);
+    if (lanes == 0 || d.size == 0)
+        return full<Array>(identity, lanes);
+
+    Index idx = arange<Index>(lanes),
+          base = (idx / d.inner) * (d.size * d.inner) + idx % d.inner;
+
+    auto tree = [&](const auto &offset, uint32_t count, const Mask &active) {
+        Array values[ReduceUnroll];
+
+        for (uint32_t i = 0; i < count; ++i) {
+            Mask valid = active && offset + i < d.size;
+            values[i] = select(valid,
+                               gather<Array>(a, base + (offset + i) * d.inner,
+                                             valid),
+                               identity);
+        }
+
+        for (uint32_t n = count; n > 1; n = (n + 1) / 2) {
+            for (uint32_t i = 0; i < n / 2; ++i)
+                values[i] = reduce_combine(op, values[2 * i], values[2 * i + 1]);
+            if (n & 1)
+                values[n / 2] = values[n - 1];
+        }
+
+        return values[0];
+    };
+
+    if constexpr (is_jit_v<Array>) {
+        if (d.size > ReduceUnroll) {
+            Index offset = zeros<Index>(lanes);
+            Array result = full<Array>(identity, lanes);
+
+            Loop<Mask> loop("drjit::reduce", offset, result);
+            while (loop(offset < d.size)) {
+                result = reduce_combine(op, result,
+                                        tree(offset, ReduceBlock, true));
+                offset += ReduceBlock;
+            }
+
+            return result;
+        }
+    }
+
+    Array result;
+    for (uint32_t offset = 0; offset < d.size; offset += ReduceUnroll) {
+        Array value =
+            tree(offset, drjit::minimum(ReduceUnroll, d.size - offset), true);
+        result = offset == 0 ? value : reduce_combine(op, result, value);
+    }
+
+    return result;
+}
+
+template <typename DiffArray>
+struct ReduceAxisOp
+    : CustomOp<DiffArray, DiffArray, DiffArray, ReduceOp, ReduceDims> {
+    using Base = CustomOp<DiffArray, DiffArray, DiffArray, ReduceOp, ReduceDims>;
+    using Array = detached_t<DiffArray>;
+    using Index = uint32_array_t<Array>;
+
+    static constexpr bool ClearPrimal = false;
+
+    DiffArray eval(const DiffArray &a, const ReduceOp &op,
+                   const ReduceDims &dims) override {
+        m_op = op;
+        m_dims = dims;
+        m_result = reduce_kernel(op, detach(a), dims);
+        return DiffArray(m_result);
+    }
+
+    void forward() override {
+        Base::set_grad_out(DiffArray(reduce_kernel(
+            ReduceOp::Add, select_grad(detach(Base::template grad_in<0>())),
+            m_dims)));
+    }
+
+    void backward() override {
+        Array grad = gather<Array>(detach(Base::grad_out()), output_index());
+        Base::template set_grad_in<0>(DiffArray(select_grad(grad)));
+    }
+
+    const char *name() const override { return "reduce"; }
+
+private:
+    /// Map every input entry to the output entry of its segment
+    Index output_index() const {
+        uint32_t segment = m_dims.size * m_dims.inner;
+        Index idx = arange<Index>(m_dims.outer * segment);
+        return (idx / segment) * m_dims.inner + idx % m_dims.inner;
+    }
+
+    /// Min/max reductions propagate derivatives of the extremal entries
+    Array select_grad(const Array &grad) const {
+        if (m_op == ReduceOp::Add)
+            return grad;
+        Array value = detach(Base::template value_in<0>());
+        return select(eq(value, gather<Array>(m_result, output_index())),
+                      grad, 0);
+    }
+
+    ReduceOp m_op;
+    ReduceDims m_dims;
+    Array m_result;
+};
+
+/**
+ * \brief Reduce a tensor along the dimension \c axis, which is removed from
+ * the shape of the result
+ *
+ * Differentiable tensors propagate derivatives via \ref ReduceAxisOp. The
+ * derivative of a min/max reduction flows into all entries that attain the
+ * extremum.
+ */
+template <typename T>
+T tensor_reduce(ReduceOp op, const T &t, size_t axis) {
+    using Array = typename T::Array;
+    size_t ndim = t.ndim();
+
+    if (axis >= ndim)
+        drjit_raise("drjit::Tensor::reduce_(): axis %zu is out of bounds for a "
+                    "tensor with %zu dimensions!", axis, ndim);
+
+    ReduceDims d { 1, (uint32_t) t.shape(axis), 1 };
+    dr_vector<size_t> shape;
+    for (size_t i = 0; i < ndim; ++i) {
+        if (i < axis)
+            d.outer *= (uint32_t) t.shape(i);
+        else if (i > axis)
+            d.inner *= (uint32_t) t.shape(i);
+        if (i != axis)
+            shape.push_back(t.shape(i));
+    }
+
+    Array result;
+    if constexpr (is_diff_v<Array> &&
+                  std::is_floating_point_v<scalar_t<Array>>)
+        result = custom<ReduceAxisOp<Array>>(t.array(), op, d);
+    else
+        result = Array(reduce_kernel(op, detach(t.array()), d));
+
+    return T(result, shape.size(), shape.data());
+}
+
 NAMESPACE_END(detail)
 
 
@@ -234,6 +707,14 @@ struct Tensor
         return Tensor(fmadd(t0.m_array, t1.m_array, t2.m_array), std::move(shape));
     }
 
+    Tensor matmul_(const Tensor &b) const {
+        return detail::tensor_matmul(*this, b);
+    }
+
+    Tensor reduce_(ReduceOp op, size_t axis) const {
+        return detail::tensor_reduce(op, *this, axis);
+    }
+
     Tensor fmsub_(const Tensor &b, const Tensor &c) const {
         return fmadd_(b, -c);
     }
@@ -368,4 +849,35 @@ protected:
     Shape m_shape;
 };
 
+/// Matrix product of the last two dimensions of two tensors (batched GEMM)
+template <typename Array>
+Tensor<Array> matmul(const Tensor<Array> &a, const Tensor<Array> &b) {
+    return a.matmul_(b);
+}
+
+/// Sum of the entries of a tensor along the dimension \c axis
+template <typename Array>
+Tensor<Array> sum(const Tensor<Array> &t, size_t axis) {
+    return t.reduce_(ReduceOp::Add, axis);
+}
+
+/// Maximum of the entries of a tensor along the dimension \c axis
+template <typename Array>
+Tensor<Array> max(const Tensor<Array> &t, size_t axis) {
+    return t.reduce_(ReduceOp::Max, axis);
+}
+
+/// Minimum of the entries of a tensor along the dimension \c axis
+template <typename Array>
+Tensor<Array> min(const Tensor<Array> &t, size_t axis) {
+    return t.reduce_(ReduceOp::Min, axis);
+}
+
+/// Mean of the entries of a tensor along the dimension \c axis
+template <typename Array>
+Tensor<Array> mean(const Tensor<Array> &t, size_t axis) {
+    Tensor<Array> result = t.reduce_(ReduceOp::Add, axis);
+    return result * scalar_t<Array>(1.0 / (double) t.shape(axis));
+}
+
 NAMESPACE_END(drjit)
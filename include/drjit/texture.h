@@ -12,10 +12,13 @@
 
 #include <array>
 #include <utility>
+#include <vector>
 #include <drjit-core/texture.h>
 #include <drjit/dynamic.h>
 #include <drjit/idiv.h>
 #include <drjit/jit.h>
+#include <drjit/math.h>
+#include <drjit/morton.h>
 #include <drjit/tensor.h>
 
 #pragma once
@@ -35,6 +38,67 @@ enum class WrapMode : uint32_t {
     Mirror = 2  /// Mirrors the texture wrt. each edge
 };
 
+/// Texel compression methods, see \ref Texture::set_compression()
+enum class TextureCompression : uint32_t {
+    Uncompressed = 0, /// Floating point texels
+    BC4 = 1           /// One BC4 block per 4x4 texels and channel
+};
+
+/// Texel storage formats
+enum class TextureFormat : uint32_t {
+    Float32 = 0, /// Single precision floating point
+    Float16 = 1, /// Half precision floating point
+    UNorm8 = 2,  /// Unsigned 8-bit integer mapping to <tt>[0, 1]</tt>
+    SNorm16 = 3  /// Signed 16-bit integer mapping to <tt>[-1, 1]</tt>
+};
+
+/// Texel memory layouts, see \ref Texture::set_layout()
+enum class TextureLayout : uint32_t {
+    RowMajor = 0, /// Rows of texels (width first)
+    Tiled = 1     /// Tiles of 4x4(x4) texels in Morton order
+};
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Repeat every entry of an array \c count times, with an adjoint that
+ * sums the copies using \ref block_sum() instead of atomic additions
+ *
+ * Used to set up the gradient copies of \ref Texture::set_grad_replicas().
+ */
+template <typename DiffArray>
+struct TextureReplicateOp : CustomOp<DiffArray, DiffArray, DiffArray, uint32_t> {
+    using Base = CustomOp<DiffArray, DiffArray, DiffArray, uint32_t>;
+    using Array = detached_t<DiffArray>;
+
+    DiffArray eval(const DiffArray &x, const uint32_t &count) override {
+        m_count = count;
+        return DiffArray(replicate(detach(x), count));
+    }
+
+    void forward() override {
+        Base::set_grad_out(DiffArray(
+            replicate(detach(Base::template grad_in<0>()), m_count)));
+    }
+
+    void backward() override {
+        Base::template set_grad_in<0>(
+            DiffArray(block_sum(detach(Base::grad_out()), m_count)));
+    }
+
+    const char *name() const override { return "texture_replicate"; }
+
+private:
+    static Array replicate(const Array &x, uint32_t count) {
+        using UInt32 = uint32_array_t<Array>;
+        return gather<Array>(x, arange<UInt32>((uint32_t) width(x) * count) / count);
+    }
+
+    uint32_t m_count;
+};
+
+NAMESPACE_END(detail)
+
 template <typename Value, size_t Dimension> class Texture {
 public:
     static constexpr bool IsCUDA = is_cuda_v<Value>;
@@ -52,6 +116,7 @@ public:
     using ArrayX = DynamicArray<Value>;
     using Storage = std::conditional_t<IsDynamic, Value, DynamicArray<Value>>;
     using TensorXf = Tensor<Storage>;
+    using StorageU = uint32_array_t<Storage>;
 
     /// Default constructor: create an invalid texture object
     Texture() = default;
@@ -78,12 +143,20 @@ public:
      * When evaluating the texture outside of its boundaries, the \c wrap_mode
      * defines the wrapping method. The default behavior is \ref WrapMode::Clamp,
      * which indefinitely extends the colors on the boundary along each dimension.
+     *
+     * The \c format parameter specifies how texels are stored. Formats other
+     * than \ref TextureFormat::Float32 pack 2 or 4 texels into each 32-bit
+     * word, which reduces the memory footprint and bandwidth of lookups. The
+     * texels are converted to single precision when they are fetched, and
+     * values outside of the range of normalized formats are clamped. Such
+     * formats are not supported by hardware-accelerated textures.
      */
     Texture(const size_t shape[Dimension], size_t channels,
             bool use_accel = true,
             FilterMode filter_mode = FilterMode::Linear,
-            WrapMode wrap_mode = WrapMode::Clamp) {
-        init(shape, channels, use_accel, filter_mode, wrap_mode);
+            WrapMode wrap_mode = WrapMode::Clamp,
+            TextureFormat format = TextureFormat::Float32) {
+        init(shape, channels, use_accel, filter_mode, wrap_mode, format);
     }
 
     /**
@@ -102,17 +175,18 @@ public:
      * differentiable even when migrated. The \ref value() and \ref tensor()
      * operations will perform a reverse migration in this case.
      *
-     * Both the \c filter_mode and \c wrap_mode have the same defaults and
-     * behaviors as for the previous constructor.
+     * The \c filter_mode, \c wrap_mode and \c format parameters have the same
+     * defaults and behaviors as for the previous constructor.
      */
     Texture(const TensorXf &tensor, bool use_accel = true, bool migrate = true,
             FilterMode filter_mode = FilterMode::Linear,
-            WrapMode wrap_mode = WrapMode::Clamp) {
+            WrapMode wrap_mode = WrapMode::Clamp,
+            TextureFormat format = TextureFormat::Float32) {
         if (tensor.ndim() != Dimension + 1)
             drjit_raise("Texture::Texture(): tensor dimension must equal "
                         "texture dimension plus one.");
         init(tensor.shape().data(), tensor.shape(Dimension), use_accel,
-             filter_mode, wrap_mode);
+             filter_mode, wrap_mode, format);
         set_tensor(tensor, migrate);
     }
 
@@ -128,6 +202,20 @@ public:
         m_wrap_mode = other.m_wrap_mode;
         m_use_accel = other.m_use_accel;
         m_migrated = other.m_migrated;
+        m_format = other.m_format;
+        m_compression = other.m_compression;
+        m_layout = other.m_layout;
+        m_packed = std::move(other.m_packed);
+        m_tiled = std::move(other.m_tiled);
+        m_tiled_size = other.m_tiled_size;
+        for (size_t i = 0; i < Dimension; ++i)
+            m_tiles[i] = other.m_tiles[i];
+        m_block_width = other.m_block_width;
+        m_inv_channels = other.m_inv_channels;
+        m_inv_width = other.m_inv_width;
+        m_decoded = other.m_decoded;
+        m_grad_replicas = other.m_grad_replicas;
+        m_grad_copies = std::move(other.m_grad_copies);
     }
 
     Texture &operator=(Texture &&other) noexcept {
@@ -144,6 +232,20 @@ public:
         m_wrap_mode = other.m_wrap_mode;
         m_use_accel = other.m_use_accel;
         m_migrated = other.m_migrated;
+        m_format = other.m_format;
+        m_compression = other.m_compression;
+        m_layout = other.m_layout;
+        m_packed = std::move(other.m_packed);
+        m_tiled = std::move(other.m_tiled);
+        m_tiled_size = other.m_tiled_size;
+        for (size_t i = 0; i < Dimension; ++i)
+            m_tiles[i] = other.m_tiles[i];
+        m_block_width = other.m_block_width;
+        m_inv_channels = other.m_inv_channels;
+        m_inv_width = other.m_inv_width;
+        m_decoded = other.m_decoded;
+        m_grad_replicas = other.m_grad_replicas;
+        m_grad_copies = std::move(other.m_grad_copies);
         return *this;
     }
 
@@ -170,6 +272,122 @@ public:
     WrapMode wrap_mode() const { return m_wrap_mode; }
     bool migrated() const { return m_migrated; }
     bool use_accel() const { return m_use_accel; }
+    TextureFormat format() const { return m_format; }
+    TextureCompression compression() const { return m_compression; }
+    TextureLayout layout() const { return m_layout; }
+    uint32_t grad_replicas() const { return m_grad_replicas; }
+
+    /**
+     * \brief Store the texels in a block-compressed format
+     *
+     * With \ref TextureCompression::BC4, each channel of every block of 4x4
+     * texels is stored as a BC4 block: two 8-bit endpoints and a 3-bit index
+     * per texel into a palette that linearly interpolates them (for two
+     * channels, this is also the layout of a BC5 block). This takes 0.5 bytes
+     * per channel and texel instead of 4 bytes, and the lookup routines \ref
+     * eval_nonaccel(), \ref eval_fetch_nonaccel() and \ref eval_cubic()
+     * decode the texels that they access on the fly.
+     *
+     * The compression is lossy: values are clamped to <tt>[0, 1]</tt> and
+     * quantized. It is applied to the current contents and to subsequent
+     * calls to \ref set_value() and \ref set_tensor(), whereas \ref value()
+     * and \ref tensor() return the decoded texels. Only 2D textures with the
+     * \ref TextureFormat::Float32 format that don't use hardware acceleration
+     * (CUDA texture objects) are supported. Derivatives with respect to the
+     * texels ignore the quantization.
+     */
+    void set_compression(TextureCompression compression) {
+        if (compression == m_compression)
+            return;
+
+        if (compression != TextureCompression::Uncompressed) {
+            if constexpr (Dimension != 2)
+                drjit_raise("Texture::set_compression(): block compression "
+                            "requires a 2D texture!");
+            if (m_format != TextureFormat::Float32 ||
+                m_layout != TextureLayout::RowMajor)
+                drjit_raise("Texture::set_compression(): block compression "
+                            "requires the Float32 format and row-major "
+                            "layout!");
+            if constexpr (HasCudaTexture) {
+                if (m_use_accel)
+                    drjit_raise("Texture::set_compression(): not supported "
+                                "by hardware-accelerated textures!");
+            }
+        }
+
+        Storage value = this->value();
+        m_compression = compression;
+        m_packed = StorageU();
+        set_value(value);
+    }
+
+    /**
+     * \brief Accumulate the texel gradients of lookups in several copies
+     *
+     * In reverse mode, every texel access of a software lookup adds a
+     * weighted gradient to that texel using an atomic operation. When many
+     * lanes access the same texels (e.g. rays hitting a small texture), these
+     * additions serialize. With <tt>replicas > 1</tt>, lane \c i instead
+     * accumulates into copy <tt>i % replicas</tt> of the texel gradients, and
+     * the copies are summed by a parallel reduction when the gradients
+     * propagate to the texels. This divides the number of conflicting atomic
+     * operations by \c replicas, and needs \c replicas times the storage of
+     * the texels for gradients.
+     *
+     * The copies are set up by \ref set_value() and \ref set_tensor() when
+     * the texels have gradients enabled. Like the tiled layout, they are part
+     * of the AD graph of these texels, which a reverse-mode traversal
+     * consumes: set the texels again before the next one. Hardware-accelerated
+     * lookups are not affected.
+     */
+    void set_grad_replicas(uint32_t replicas) {
+        if (replicas == 0)
+            drjit_raise("Texture::set_grad_replicas(): the number of replicas "
+                        "must be positive!");
+        if (replicas == m_grad_replicas)
+            return;
+        m_grad_replicas = replicas;
+        update_grad_copies();
+    }
+
+    /**
+     * \brief Change the memory layout of the texels
+     *
+     * With \ref TextureLayout::Tiled, the texels are stored in tiles of 4x4
+     * (2D) or 4x4x4 (3D) texels whose interior follows the Morton/Z-order
+     * curve, and the resolution is padded to a multiple of 4. The footprints
+     * of linear and cubic lookups then touch fewer cache lines than with rows
+     * of texels, which benefits \ref eval_nonaccel() and related routines on
+     * the LLVM and scalar backends. The offsets are computed on the fly, and
+     * \ref value() and \ref tensor() still return the texels in row-major
+     * order. Only the \ref TextureFormat::Float32 format without compression
+     * and textures that don't use hardware acceleration are supported.
+     */
+    void set_layout(TextureLayout layout) {
+        if (layout == m_layout)
+            return;
+
+        if (layout != TextureLayout::RowMajor) {
+            if constexpr (Dimension == 1)
+                drjit_raise("Texture::set_layout(): tiling requires a 2D or "
+                            "3D texture!");
+            if (m_format != TextureFormat::Float32 ||
+                m_compression != TextureCompression::Uncompressed)
+                drjit_raise("Texture::set_layout(): tiling requires the "
+                            "Float32 format without compression!");
+            if constexpr (HasCudaTexture) {
+                if (m_use_accel)
+                    drjit_raise("Texture::set_layout(): not supported by "
+                                "hardware-accelerated textures!");
+            }
+        }
+
+        Storage value = this->value();
+        m_layout = layout;
+        m_tiled = Storage();
+        set_value(value);
+    }
 
     /**
      * \brief Override the texture contents with the provided linearized 1D array
@@ -201,13 +419,44 @@ public:
                         m_value.array() = dummy;
 
                     m_migrated = true;
+                    update_grad_copies();
 
                     return;
                 }
             }
         }
 
+        if (encoded()) {
+            Storage dummy = zeros<Storage>(m_size);
+
+            if (m_layout == TextureLayout::Tiled) {
+                // Gradients are tracked by the scatter
+                m_tiled = zeros<Storage>(m_tiled_size);
+                scatter(m_tiled, value, tiled_offsets());
+                drjit::eval(m_tiled);
+                m_value.array() = dummy;
+            } else {
+                if (m_compression == TextureCompression::BC4)
+                    compress_bc4(value);
+                else
+                    encode(value);
+
+                // Only keep the gradients
+                if constexpr (IsDiff)
+                    m_value.array() = replace_grad(dummy, value);
+                else
+                    m_value.array() = dummy;
+            }
+
+            // Decoded on demand by tensor()
+            m_decoded = false;
+            update_grad_copies();
+
+            return;
+        }
+
         m_value.array() = value;
+        update_grad_copies();
     }
 
     /**
@@ -249,25 +498,88 @@ public:
                 if (shape_changed) {
                     jit_cuda_tex_destroy(m_handle);
                     init(tensor.shape().data(), tensor.shape(Dimension), m_use_accel,
-                         m_filter_mode, m_wrap_mode, !is_inplace_update);
+                         m_filter_mode, m_wrap_mode, m_format,
+                         !is_inplace_update);
                 }
             } else {
                 init(tensor.shape().data(), tensor.shape(Dimension),
-                     m_use_accel, m_filter_mode, m_wrap_mode, false);
+                     m_use_accel, m_filter_mode, m_wrap_mode, m_format, false);
             }
         } else {
             init(tensor.shape().data(), tensor.shape(Dimension),
-                 m_use_accel, m_filter_mode, m_wrap_mode, false);
+                 m_use_accel, m_filter_mode, m_wrap_mode, m_format, false);
         }
 
         // Avoid unnecessary copy when working with `DynamicArray`
         if constexpr (!IsDynamic)
-            if (is_inplace_update)
+            if (is_inplace_update && !encoded())
                 return;
 
         set_value(tensor.array(), migrate);
     }
 
+    /**
+     * \brief Override the texels of a rectangular region
+     *
+     * The \c offset and \c extent of the region are specified in the same
+     * order as the texture shape (e.g., height and width for 2D textures),
+     * and \c data contains the texels of the region in C-style order
+     * (including the channels). Only the texels of the region are written,
+     * except for packed, compressed, or hardware-accelerated textures, which
+     * are re-encoded or copied to texture memory in their entirety (CUDA
+     * texture objects can only be updated as a whole).
+     */
+    void update_region(const size_t offset[Dimension],
+                       const size_t extent[Dimension], const Storage &data) {
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension);
+
+        size_t size = channels;
+        for (size_t i = 0; i < Dimension; ++i) {
+            if (offset[i] + extent[i] > m_value.shape(i))
+                drjit_raise("Texture::update_region(): the region is out of "
+                            "bounds!");
+            size *= extent[i];
+        }
+        if (data.size() != size)
+            drjit_raise("Texture::update_region(): unexpected array size!");
+
+        StorageU texel = arange<StorageU>(size),
+                 ch = texel % channels,
+                 coord[Dimension];
+        texel /= channels;
+        for (size_t i = Dimension; i > 0; --i) {
+            coord[i - 1] = texel % (uint32_t) extent[i - 1];
+            texel /= (uint32_t) extent[i - 1];
+        }
+
+        StorageU idx = zeros<StorageU>(size);
+        for (size_t i = 0; i < Dimension; ++i)
+            idx = fmadd(idx, (uint32_t) m_value.shape(i),
+                        coord[i] + (uint32_t) offset[i]);
+
+        update(fmadd(idx, channels, ch), data);
+    }
+
+    /**
+     * \brief Override the texels with the given linear indices (excluding
+     * channels)
+     *
+     * The array \c data contains all channels of the first texel, followed
+     * by those of the second texel, etc. It is otherwise analogous to \ref
+     * update_region().
+     */
+    void update_texels(const StorageU &texel, const Storage &data) {
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension);
+        if (data.size() != texel.size() * channels)
+            drjit_raise("Texture::update_texels(): unexpected array size!");
+
+        StorageU i = arange<StorageU>(data.size()),
+                 ch = i % channels,
+                 idx = gather<StorageU>(texel, i / channels);
+
+        update(fmadd(idx, channels, ch), data);
+    }
+
     const Storage &value() const { return tensor().array(); }
 
     /**
@@ -292,6 +604,21 @@ public:
             }
         }
 
+        if (encoded() && !m_decoded) {
+            if (m_layout == TextureLayout::Tiled) {
+                m_value.array() = gather<Storage>(m_tiled, tiled_offsets());
+            } else {
+                Storage primal = decode_all();
+
+                if constexpr (IsDiff)
+                    m_value.array() = replace_grad(primal, m_value.array());
+                else
+                    m_value.array() = primal;
+            }
+
+            m_decoded = true;
+        }
+
         return m_value;
     }
 
@@ -357,7 +684,7 @@ public:
             UInt32 idx = index(pos_i_w);
 
             for (uint32_t ch = 0; ch < channels; ++ch)
-                out[ch] = gather<Value>(m_value.array(), idx + ch, active);
+                out[ch] = fetch(idx + ch, active);
         } else {
             using InterpOffset = Array<Int32, ipow(2, Dimension)>;
             using InterpPosI = Array<InterpOffset, Dimension>;
@@ -381,7 +708,7 @@ public:
                     Value weight_ = weight;                                            \
                     for (uint32_t ch = 0; ch < channels; ++ch)                         \
                         out[ch] =                                                      \
-                            fmadd(gather<Value>(m_value.array(), index_ + ch, active), \
+                            fmadd(fetch(index_ + ch, active),                          \
                                 weight_, out[ch]);                                     \
                 }
 
@@ -548,7 +875,7 @@ public:
         for (size_t i = 0; i < InterpOffset::Size; ++i)
             for (uint32_t ch = 0; ch < channels; ++ch)
                 out[i][ch] =
-                    gather<Value>(m_value.array(), idx[i] + ch, active);
+                    fetch(idx[i] + ch, active);
     }
 
     /**
@@ -648,7 +975,7 @@ public:
                 Value weight_ = weight;                                            \
                 for (uint32_t ch = 0; ch < channels; ++ch)                         \
                     out[ch] =                                                      \
-                        fmadd(gather<Value>(m_value.array(), index_ + ch, active), \
+                        fmadd(fetch(index_ + ch, active),                          \
                               weight_, out[ch]);                                   \
             }
 
@@ -676,6 +1003,99 @@ public:
         #undef DR_TEX_CUBIC_ACCUM
     }
 
+    /**
+     * \brief Evaluate a clamped cubic B-Spline interpolant without hardware
+     * acceleration
+     *
+     * This is an implementation detail, please use \ref eval_cubic() that may
+     * dispatch to this function depending on its inputs.
+     *
+     * The wrapped coordinates, memory offsets and basis function weights are
+     * computed once per dimension. The texels are then filtered separably:
+     * each row of 4 texels is weighted along the first dimension before the
+     * rows are combined along the remaining dimensions. Compared to the
+     * weighted sum of 2^D linear lookups used by \ref eval_cubic(), which
+     * maps well onto hardware texture units, this avoids recomputing the
+     * positions and weights of every texel. The result is differentiable.
+     */
+    void eval_cubic_nonaccel(const Array<Value, Dimension> &pos, Value *out,
+                             Mask active = true) const {
+        using Array4 = Array<Value, 4>;
+        using Offset4 = Array<UInt32, 4>;
+
+        if constexpr (!is_array_v<Mask>)
+            active = true;
+
+        PosF pos_f = fmadd(PosF(pos), PosF(m_shape_opaque), -.5f);
+        PosI pos_i = floor2int<PosI>(pos_f);
+        PosF pos_a = pos_f - PosF(pos_i);
+
+        // Offsets and weights of the 4 texels along each dimension
+        Offset4 offset[Dimension];
+        Array4 weight[Dimension];
+        for (uint32_t k = 0; k < 4; ++k) {
+            PosI pos_k = wrap(pos_i + ((int32_t) k - 1));
+            for (size_t i = 0; i < Dimension; ++i)
+                offset[i][k] = axis_offset(i, pos_k[i]);
+        }
+
+        for (size_t i = 0; i < Dimension; ++i) {
+            const Value &alpha = pos_a[i];
+            Value alpha2 = alpha * alpha,
+                  alpha3 = alpha2 * alpha;
+            weight[i] = (1.f / 6.f) *
+                        Array4(-alpha3 + 3.f * alpha2 - 3.f * alpha + 1.f,
+                                3.f * alpha3 - 6.f * alpha2 + 4.f,
+                               -3.f * alpha3 + 3.f * alpha2 + 3.f * alpha + 1.f,
+                                alpha3);
+        }
+
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension);
+
+        auto filter_row = [&](const UInt32 &base, Value *row) {
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                row[ch] = zeros<Value>();
+            for (uint32_t ix = 0; ix < 4; ++ix) {
+                UInt32 idx = base + offset[0][ix];
+                for (uint32_t ch = 0; ch < channels; ++ch)
+                    row[ch] = fmadd(fetch(idx + ch, active), weight[0][ix],
+                                    row[ch]);
+            }
+        };
+
+        if constexpr (Dimension == 1) {
+            filter_row(UInt32(0), out);
+        } else {
+            ArrayX row = empty<ArrayX>(channels),
+                   plane = empty<ArrayX>(channels);
+
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = zeros<Value>();
+
+            for (uint32_t iz = 0; iz < (Dimension == 3 ? 4 : 1); ++iz) {
+                UInt32 base = 0;
+                if constexpr (Dimension == 3)
+                    base = offset[2][iz];
+
+                for (uint32_t ch = 0; ch < channels; ++ch)
+                    plane[ch] = zeros<Value>();
+
+                for (uint32_t iy = 0; iy < 4; ++iy) {
+                    filter_row(base + offset[1][iy], row.data());
+                    for (uint32_t ch = 0; ch < channels; ++ch)
+                        plane[ch] = fmadd(row[ch], weight[1][iy], plane[ch]);
+                }
+
+                for (uint32_t ch = 0; ch < channels; ++ch) {
+                    if constexpr (Dimension == 3)
+                        out[ch] = fmadd(plane[ch], weight[2][iz], out[ch]);
+                    else
+                        out[ch] = plane[ch];
+                }
+            }
+        }
+    }
+
     /**
      * \brief Evaluate a clamped cubic B-Spline interpolant represented by this
      * texture
@@ -694,6 +1114,9 @@ public:
      * (thus the default AD graph gives incorrect results). The implementation
      * calls \ref eval_cubic_helper() function to replace the AD graph with a
      * direct evaluation of the B-Spline basis functions in that case.
+     *
+     * Without hardware acceleration (or when \c force_nonaccel is set), the
+     * function dispatches to \ref eval_cubic_nonaccel().
      */
     void eval_cubic(const Array<Value, Dimension> &pos, Value *out,
                     Mask active = true, bool force_nonaccel = false) const {
@@ -702,11 +1125,18 @@ public:
         if constexpr (!is_array_v<Mask>)
             active = true;
 
+        bool use_cuda = false;
         if constexpr (HasCudaTexture) {
             if (m_migrated && force_nonaccel)
                 jit_log(::LogLevel::Warn,
                         "\"force_nonaccel\" is used while the data has been fully "
                         "migrated to CUDA texture memory");
+            use_cuda = m_use_accel && !force_nonaccel;
+        }
+
+        if (!use_cuda) {
+            eval_cubic_nonaccel(pos, out, active);
+            return;
         }
 
         PosF res_f = PosF(m_shape_opaque);
@@ -884,7 +1314,7 @@ public:
             {                                                                         \
                 UInt32 index_ = index;                                                \
                 for (uint32_t ch = 0; ch < channels; ++ch)                            \
-                    values[ch] = gather<Value>(m_value.array(), index_ + ch, active); \
+                    values[ch] = fetch(index_ + ch, active);                          \
             }
         #define DR_TEX_CUBIC_ACCUM_VALUE(weight)                               \
             {                                                                  \
@@ -1031,7 +1461,7 @@ public:
             {                                                                         \
                 UInt32 index_ = index;                                                \
                 for (uint32_t ch = 0; ch < channels; ++ch)                            \
-                    values[ch] = gather<Value>(m_value.array(), index_ + ch, active); \
+                    values[ch] = fetch(index_ + ch, active);                          \
             }
         #define DR_TEX_CUBIC_ACCUM_VALUE(weight_value)                                \
             {                                                                         \
@@ -1172,12 +1602,39 @@ public:
     }
 
 protected:
+    /// Memory offset (including channels) of a coordinate along a dimension
+    UInt32 axis_offset(size_t dim, const Int32 &pos) const {
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension);
+        UInt32 pos_u = UInt32(pos);
+
+        if (m_layout == TextureLayout::Tiled) {
+            // Offsets of the tile and within the Morton-ordered tile
+            uint32_t tile_stride = 1;
+            for (size_t i = 0; i < dim; ++i)
+                tile_stride *= m_tiles[i];
+            UInt32 local = (pos_u & 1) | sl<Dimension - 1>(pos_u & 2);
+            return (sl<2 * Dimension>(sr<2>(pos_u) * tile_stride) |
+                    (local << (uint32_t) dim)) * channels;
+        }
+
+        UInt32 stride = channels;
+        for (size_t i = 0; i < dim; ++i)
+            stride *= m_shape_opaque[i];
+        return pos_u * stride;
+    }
+
     void init(const size_t *shape, size_t channels, bool use_accel,
-              FilterMode filter_mode, WrapMode wrap_mode,
+              FilterMode filter_mode, WrapMode wrap_mode, TextureFormat format,
               bool init_tensor = true) {
         if (channels == 0)
             drjit_raise("Texture::Texture(): must have at least 1 channel!");
 
+        if constexpr (HasCudaTexture) {
+            if (use_accel && format != TextureFormat::Float32)
+                drjit_raise("Texture::Texture(): hardware-accelerated "
+                            "textures require the Float32 format!");
+        }
+
         m_size = channels;
         size_t tensor_shape[Dimension + 1]{};
 
@@ -1195,6 +1652,17 @@ protected:
         m_use_accel = use_accel;
         m_filter_mode = filter_mode;
         m_wrap_mode = wrap_mode;
+        m_format = format;
+
+        m_inv_channels = divisor<uint32_t>((uint32_t) channels);
+        m_inv_width = divisor<uint32_t>((uint32_t) shape[Dimension - 1]);
+        m_block_width = ((uint32_t) shape[Dimension - 1] + 3) / 4;
+
+        m_tiled_size = channels;
+        for (size_t i = 0; i < Dimension; ++i) {
+            m_tiles[i] = ((uint32_t) shape[Dimension - 1 - i] + 3) / 4;
+            m_tiled_size *= (size_t) m_tiles[i] * 4;
+        }
 
         if constexpr (HasCudaTexture) {
             if (m_use_accel) {
@@ -1207,6 +1675,303 @@ protected:
     }
 
 private:
+    /// Fetch a texel channel given its index in the (decoded) tensor
+    template <typename Index, typename Mask_>
+    Value fetch(const Index &idx, const Mask_ &active) const {
+        if (m_layout == TextureLayout::Tiled)
+            return gather_texel(m_tiled, idx, active);
+        else if (!encoded())
+            return gather_texel(m_value.array(), idx, active);
+
+        Value result = decode<Value>(idx, active);
+        if constexpr (IsDiff) {
+            if (grad_enabled(m_value.array()))
+                result = replace_grad(
+                    result, gather_texel(m_value.array(), idx, active));
+        }
+
+        return result;
+    }
+
+    /**
+     * \brief Gather from the texel storage \c source, while routing the
+     * gradients through the copies of \ref set_grad_replicas()
+     */
+    template <typename Index, typename Mask_>
+    Value gather_texel(const Storage &source, const Index &idx,
+                       const Mask_ &active) const {
+        if constexpr (IsDiff && is_jit_v<Value>) {
+            if (m_grad_replicas > 1 && grad_enabled(m_grad_copies)) {
+                Index lane = arange<Index>(width(idx, active)) % m_grad_replicas;
+                return replace_grad(
+                    gather<Value>(detach(source), idx, active),
+                    gather<Value>(m_grad_copies,
+                                  fmadd(idx, m_grad_replicas, lane), active));
+            }
+        }
+
+        return gather<Value>(source, idx, active);
+    }
+
+    /// Recreate the gradient copies of the texel storage
+    void update_grad_copies() {
+        if constexpr (IsDiff && is_jit_v<Value>) {
+            const Storage &source =
+                m_layout == TextureLayout::Tiled ? m_tiled : m_value.array();
+            if (m_grad_replicas > 1 && grad_enabled(source))
+                m_grad_copies = custom<detail::TextureReplicateOp<Storage>>(
+                    source, m_grad_replicas);
+            else
+                m_grad_copies = Storage();
+        }
+    }
+
+    /// Scatter entries of the (decoded) tensor into the texture storage
+    void update(const StorageU &idx, const Storage &data) {
+        bool rebuild = m_compression != TextureCompression::Uncompressed ||
+                       m_format != TextureFormat::Float32;
+        if constexpr (HasCudaTexture)
+            rebuild |= m_use_accel;
+
+        if (rebuild) {
+            bool migrated = m_migrated;
+            Storage value = this->value();
+            scatter(value, data, idx);
+            set_value(value, migrated);
+        } else if (m_layout == TextureLayout::Tiled) {
+            scatter(m_tiled, data, tiled_offsets(idx));
+            drjit::eval(m_tiled);
+            m_value.array() = zeros<Storage>(m_size);
+            m_decoded = false;
+            update_grad_copies();
+        } else {
+            scatter(m_value.array(), data, idx);
+            drjit::eval(m_value.array());
+            update_grad_copies();
+        }
+    }
+
+    /// Are the texels stored differently than by \ref m_value?
+    bool encoded() const {
+        return m_compression != TextureCompression::Uncompressed ||
+               m_format != TextureFormat::Float32 ||
+               m_layout != TextureLayout::RowMajor;
+    }
+
+    /// Offset of texels (without channels) in the tiled layout
+    template <typename Pos> auto tiled_index(const Pos &pos) const {
+        using Index = uint32_array_t<value_t<Pos>>;
+
+        if constexpr (Dimension == 1) {
+            return Index(pos[0]); // 1D textures are not tiled
+        } else {
+            Index tile = Index(sr<2>(pos[Dimension - 1]));
+            Array<Index, Dimension> local;
+            for (size_t i = Dimension - 1; i > 0; --i)
+                tile = fmadd(tile, m_tiles[i - 1], Index(sr<2>(pos[i - 1])));
+            for (size_t i = 0; i < Dimension; ++i)
+                local[i] = Index(pos[i] & 3);
+
+            return sl<2 * Dimension>(tile) | morton_encode(local);
+        }
+    }
+
+    /// Offsets of tensor entries (all of them by default) in the tiled layout
+    StorageU tiled_offsets(const StorageU &idx = StorageU()) const {
+        const uint32_t channels = m_inv_channels.div;
+
+        StorageU texel = idx.size() == 0 ? arange<StorageU>(m_size) : idx,
+                 ch = texel % channels;
+        Array<StorageU, Dimension> pos;
+        texel /= channels;
+        for (size_t i = 0; i < Dimension; ++i) {
+            uint32_t res = (uint32_t) m_value.shape(Dimension - 1 - i);
+            pos[i] = texel % res;
+            texel /= res;
+        }
+
+        return fmadd(tiled_index(pos), channels, ch);
+    }
+
+    /// Decode a texel channel of a packed or compressed texture
+    template <typename Float, typename Index, typename Mask_>
+    Float decode(const Index &idx, const Mask_ &active) const {
+        if (m_compression == TextureCompression::BC4)
+            return decode_bc4<Float>(idx, active);
+
+        // Extract the code of the texel from its 32-bit word
+        uint32_t bits = format_bits(), log_per_word = bits == 8 ? 2 : 1;
+        Index word = gather<Index>(m_packed, idx >> log_per_word, active),
+              code = (word >> ((idx & ((1u << log_per_word) - 1)) * bits)) &
+                     ((1u << bits) - 1);
+
+        switch (m_format) {
+            case TextureFormat::Float16:
+                if constexpr (is_array_v<Float>)
+                    return Float(reinterpret_array<float16_array_t<Float>>(
+                        uint16_array_t<Float>(code)));
+                else
+                    return Float(half::from_binary((uint16_t) code));
+
+            case TextureFormat::UNorm8:
+                return Float(code) * (1.f / 255.f);
+
+            default:
+                return maximum(Float(sr<16>(reinterpret_array<int32_array_t<
+                                   Index>>(sl<16>(code)))) *
+                                   (1.f / 32767.f),
+                               -1.f);
+        }
+    }
+
+    /// Decode all texels of a packed or compressed texture
+    Storage decode_all() const {
+        if constexpr (IsDynamic) {
+            return decode<Storage>(arange<StorageU>(m_size), true);
+        } else {
+            Storage result = empty<Storage>(m_size);
+            for (uint32_t i = 0; i < (uint32_t) m_size; ++i)
+                result[i] = decode<Value>(i, true);
+            return result;
+        }
+    }
+
+    /// Number of bits per texel of the storage format
+    uint32_t format_bits() const {
+        switch (m_format) {
+            case TextureFormat::UNorm8: return 8;
+            case TextureFormat::Float16:
+            case TextureFormat::SNorm16: return 16;
+            default: return 32;
+        }
+    }
+
+    /// Convert texels to the codes of the storage format
+    template <typename Float>
+    uint32_array_t<Float> encode_texel(const Float &value) const {
+        using UInt = uint32_array_t<Float>;
+
+        switch (m_format) {
+            case TextureFormat::Float16:
+                if constexpr (is_array_v<Float>)
+                    return UInt(reinterpret_array<uint16_array_t<Float>>(
+                        float16_array_t<Float>(value)));
+                else
+                    return UInt(half(value).value);
+
+            case TextureFormat::UNorm8:
+                return UInt(round(clamp(value, 0.f, 1.f) * 255.f));
+
+            default:
+                return reinterpret_array<UInt>(int32_array_t<Float>(
+                           round(clamp(value, -1.f, 1.f) * 32767.f))) &
+                       0xFFFF;
+        }
+    }
+
+    /// Pack the texels into 32-bit words using the storage format
+    void encode(const Storage &value) {
+        StorageU codes;
+        if constexpr (IsDynamic) {
+            codes = encode_texel(value);
+        } else {
+            codes = empty<StorageU>(m_size);
+            for (size_t i = 0; i < m_size; ++i)
+                codes[i] = encode_texel(value[i]);
+        }
+
+        uint32_t bits = format_bits(), per_word = 32 / bits,
+                 n_words = ((uint32_t) m_size + per_word - 1) / per_word;
+
+        StorageU word = arange<StorageU>(n_words);
+        m_packed = zeros<StorageU>(n_words);
+        for (uint32_t k = 0; k < per_word; ++k) {
+            StorageU idx = fmadd(word, per_word, k);
+            m_packed |= gather<StorageU>(codes, idx, idx < (uint32_t) m_size)
+                        << (k * bits);
+        }
+        drjit::eval(m_packed);
+    }
+
+    /// Decode a texel channel of a BC4-compressed texture
+    template <typename Float, typename Index, typename Mask_>
+    Float decode_bc4(const Index &idx, const Mask_ &active) const {
+        using UInt64 = uint64_array_t<Index>;
+        Index texel = m_inv_channels(idx),
+              ch = idx - texel * m_inv_channels.div,
+              y = m_inv_width(texel),
+              x = texel - y * m_inv_width.div;
+
+        Index block = fmadd(sr<2>(y), m_block_width, sr<2>(x)),
+              word = fmadd(block, m_inv_channels.div, ch) * 2,
+              lo = gather<Index>(m_packed, word, active),
+              hi = gather<Index>(m_packed, word + 1, active),
+              shift = fmadd(y & 3, 12, (x & 3) * 3) + 16;
+
+        Index i = Index((UInt64(lo) | sl<32>(UInt64(hi))) >> UInt64(shift)) & 7;
+
+        Float r0 = Float(lo & 0xFF), r1 = Float(sr<8>(lo) & 0xFF);
+        mask_t<Float> mode8 = r0 > r1;
+
+        // Weight of r1 (the palette linearly interpolates the endpoints)
+        Float t = select(eq(i, 0), 0.f,
+                         select(eq(i, 1), 1.f,
+                                (Float(i) - 1.f) *
+                                    select(mode8, 1.f / 7.f, 1.f / 5.f)));
+
+        // The palette with 6 entries additionally contains 0 and 255
+        Float value = select(mode8 || i < 6, fmadd(r1 - r0, t, r0),
+                             select(eq(i, 6), 0.f, 255.f));
+
+        return value * (1.f / 255.f);
+    }
+
+    /// Compress the texels, producing one BC4 block per 4x4 texels and channel
+    void compress_bc4(const Storage &value) {
+        using UInt64S = uint64_array_t<StorageU>;
+        const uint32_t width = m_inv_width.div,
+                       height = (uint32_t) (m_size / m_inv_channels.div / width),
+                       channels = m_inv_channels.div;
+
+        uint32_t n_blocks = m_block_width * ((height + 3) / 4);
+        StorageU lane = arange<StorageU>(n_blocks * channels),
+                 block = lane / channels,
+                 ch = lane - block * channels,
+                 by = block / m_block_width,
+                 bx = block - by * m_block_width;
+
+        // Gather the 4x4 texels (replicating the edges of partial blocks)
+        Storage texels[16], v_min = 1.f, v_max = 0.f;
+        for (uint32_t k = 0; k < 16; ++k) {
+            StorageU x = minimum(fmadd(bx, 4, k % 4), width - 1),
+                     y = minimum(fmadd(by, 4, k / 4), height - 1);
+            texels[k] = clamp(gather<Storage>(value, fmadd(fmadd(y, width, x),
+                                                           channels, ch)),
+                              0.f, 1.f);
+            v_min = minimum(v_min, texels[k]);
+            v_max = maximum(v_max, texels[k]);
+        }
+
+        // Endpoints with r0 > r1 select the palette with 8 entries
+        StorageU r0 = StorageU(round(v_max * 255.f)),
+                 r1 = StorageU(round(v_min * 255.f));
+        Storage r0f = Storage(r0), range = r0f - Storage(r1),
+                scale = select(range > 0.f, 7.f / range, 0.f);
+
+        UInt64S bits = UInt64S(r0 | sl<8>(r1));
+        for (uint32_t k = 0; k < 16; ++k) {
+            // Position within the palette (0: r0, 7: r1)
+            StorageU j = StorageU(round((r0f - texels[k] * 255.f) * scale)),
+                     i = select(eq(j, 0), 0u, select(eq(j, 7), 1u, j + 1));
+            bits |= UInt64S(i) << (16 + 3 * k);
+        }
+
+        m_packed = zeros<StorageU>(n_blocks * channels * 2);
+        scatter(m_packed, StorageU(bits), lane * 2);
+        scatter(m_packed, StorageU(sr<32>(bits)), lane * 2 + 1);
+        drjit::eval(m_packed);
+    }
+
     /// Helper function to reverse the tensor (\ref Texture.m_value) shape
     void reverse_tensor_shape(size_t *output, bool include_channels) const {
         for (size_t i = 0; i < Dimension; ++i)
@@ -1276,6 +2041,12 @@ private:
             std::is_signed_v<Scalar>
         );
 
+        uint32_t channels = (uint32_t) m_value.shape(Dimension);
+        if constexpr (Dimension > 1) {
+            if (m_layout == TextureLayout::Tiled)
+                return tiled_index(pos) * channels;
+        }
+
         Index index;
         if constexpr (Dimension == 1) {
             index = Index(pos.x());
@@ -1288,8 +2059,6 @@ private:
                 m_shape_opaque.x(), Index(pos.x())));
         }
 
-        uint32_t channels = (uint32_t) m_value.shape(Dimension);
-
         return index * channels;
     }
 
@@ -1306,6 +2075,791 @@ private:
     WrapMode m_wrap_mode;
     bool m_use_accel = false;
     mutable bool m_migrated = false;
+
+    // Packed or block-compressed texels, see set_compression()
+    TextureFormat m_format = TextureFormat::Float32;
+    TextureCompression m_compression = TextureCompression::Uncompressed;
+    TextureLayout m_layout = TextureLayout::RowMajor;
+    StorageU m_packed;
+    uint32_t m_block_width = 0;
+    divisor<uint32_t> m_inv_channels, m_inv_width;
+    mutable bool m_decoded = false;
+
+    // Texels in the tiled layout, see set_layout()
+    Storage m_tiled;
+    uint32_t m_tiles[Dimension] { };
+    size_t m_tiled_size = 0;
+
+    // Copies that accumulate texel gradients, see set_grad_replicas()
+    uint32_t m_grad_replicas = 1;
+    Storage m_grad_copies;
+};
+
+/**
+ * \brief Mipmapped texture with trilinear and anisotropic filtering
+ *
+ * This class stores a pyramid of successively downsampled copies of a tensor.
+ * Each level halves the resolution along every dimension (rounding down, and
+ * down to a minimum of one texel) and is computed by averaging blocks of
+ * <tt>2^Dimension</tt> texels of the previous one. The pyramid is built with
+ * regular array operations, i.e. on the device when using CUDA arrays.
+ *
+ * All levels are stored in a single flat array, which means that a lookup
+ * only needs to fetch from the two levels that are closest to the requested
+ * level of detail (LOD). The level is either specified explicitly (\ref
+ * eval_lod()) or derived from the screen-space derivatives of the lookup
+ * position (\ref eval()). The filter and wrap modes have the same meaning as
+ * for \ref Texture, except that FilterMode::Nearest also selects the nearest
+ * level.
+ *
+ * The lookups are performed via explicit arithmetic on all backends. CUDA
+ * texture objects created via \c jit_cuda_tex_create() only provide a single
+ * resolution level and are therefore not used.
+ */
+NAMESPACE_BEGIN(detail)
+
+/// Apply a wrap mode to integer texel positions given a (per-lane) resolution
+template <typename PosI>
+PosI texture_wrap(const PosI &pos, const PosI &res, WrapMode wrap_mode) {
+    if (wrap_mode == WrapMode::Clamp)
+        return clamp(pos, 0, res - 1);
+
+    PosI period = wrap_mode == WrapMode::Mirror ? res + res : res;
+    PosI mod = pos % period;
+    mod = select(mod < 0, mod + period, mod);
+
+    if (wrap_mode == WrapMode::Mirror)
+        mod = select(mod >= res, period - 1 - mod, mod);
+
+    return mod;
+}
+
+/// Texel index (without channels) of an integer position
+template <typename UInt32, typename PosI>
+UInt32 texture_index(const PosI &pos, const PosI &res) {
+    constexpr size_t Dimension = array_size_v<PosI>;
+    UInt32 idx = UInt32(pos[Dimension - 1]);
+    for (size_t i = Dimension - 1; i > 0; --i)
+        idx = fmadd(idx, UInt32(res[i - 1]), UInt32(pos[i - 1]));
+    return idx;
+}
+
+NAMESPACE_END(detail)
+
+template <typename Value, size_t Dimension> class MipmapTexture {
+public:
+    using Base = Texture<Value, Dimension>;
+    using Int32 = typename Base::Int32;
+    using UInt32 = typename Base::UInt32;
+    using Mask = typename Base::Mask;
+    using PosF = typename Base::PosF;
+    using PosI = typename Base::PosI;
+    using ArrayX = typename Base::ArrayX;
+    using Storage = typename Base::Storage;
+    using TensorXf = typename Base::TensorXf;
+    using StorageU = uint32_array_t<Storage>;
+
+    /// Default constructor: create an invalid texture object
+    MipmapTexture() = default;
+
+    /**
+     * \brief Construct a mipmapped texture from a given tensor
+     *
+     * The number of levels is limited to \c max_levels (all levels down to a
+     * resolution of one texel are created by default).
+     */
+    MipmapTexture(const TensorXf &tensor,
+                  FilterMode filter_mode = FilterMode::Linear,
+                  WrapMode wrap_mode = WrapMode::Clamp,
+                  size_t max_levels = (size_t) -1)
+        : m_filter_mode(filter_mode), m_wrap_mode(wrap_mode),
+          m_max_levels(max_levels) {
+        set_tensor(tensor);
+    }
+
+    /// Return the texture dimension plus one (for the "channel dimension")
+    size_t ndim() const { return Dimension + 1; }
+
+    /// Return the shape of the finest level
+    const size_t *shape() const { return m_value.shape().data(); }
+
+    /// Return the number of levels of the pyramid
+    size_t levels() const { return m_levels; }
+
+    FilterMode filter_mode() const { return m_filter_mode; }
+    WrapMode wrap_mode() const { return m_wrap_mode; }
+
+    /// Return the finest level as a tensor object
+    const TensorXf &tensor() const { return m_value; }
+
+    /// Return all levels as a flat array (finest level first)
+    const Storage &pyramid() const { return m_pyramid; }
+
+    /**
+     * \brief Return the resolution of a level along dimension \c dim, in the
+     * order used for positions (width, height, depth)
+     */
+    size_t level_resolution(size_t level, size_t dim) const {
+        size_t res = m_resolution[dim] >> level;
+        return res > 0 ? res : 1;
+    }
+
+    /// Override the texel values of the finest level and rebuild the pyramid
+    void set_value(const Storage &value) {
+        if (value.size() != m_value.array().size())
+            drjit_raise("MipmapTexture::set_value(): unexpected array size!");
+        m_value.array() = value;
+        build();
+    }
+
+    /// Override the texture contents (resolution changes are permitted)
+    void set_tensor(const TensorXf &tensor) {
+        if (tensor.ndim() != Dimension + 1)
+            drjit_raise("MipmapTexture::set_tensor(): tensor dimension must "
+                        "equal texture dimension plus one (channels).");
+        if (tensor.shape(Dimension) == 0)
+            drjit_raise("MipmapTexture::set_tensor(): must have at least 1 "
+                        "channel!");
+
+        size_t max_res = 0;
+        for (size_t i = 0; i < Dimension; ++i) {
+            m_resolution[i] = tensor.shape(Dimension - 1 - i);
+            if (m_resolution[i] == 0)
+                drjit_raise("MipmapTexture::set_tensor(): texture resolution "
+                            "must be nonzero!");
+            max_res = m_resolution[i] > max_res ? m_resolution[i] : max_res;
+        }
+
+        m_levels = 1;
+        while ((max_res >> m_levels) > 0 && m_levels < m_max_levels)
+            m_levels++;
+
+        m_value = tensor;
+        build();
+    }
+
+    /**
+     * \brief Compute the level of detail of a lookup from the derivatives of
+     * its position with respect to the screen-space coordinates
+     */
+    Value lod(const PosF &dp_dx, const PosF &dp_dy) const {
+        PosF res = resolution_f();
+        Value len2 = maximum(squared_norm(dp_dx * res), squared_norm(dp_dy * res));
+        return .5f * log2(len2);
+    }
+
+    /// Evaluate the texture at an explicitly specified level of detail
+    void eval_lod(const PosF &pos, const Value &lod, Value *out,
+                  Mask active = true) const {
+        if constexpr (!is_array_v<Mask>)
+            active = true;
+
+        Value lod_c = clamp(lod, 0.f, (float) (m_levels - 1));
+
+        if (m_filter_mode == FilterMode::Nearest) {
+            eval_level(pos, Int32(round(lod_c)), out, active);
+            return;
+        }
+
+        const size_t channels = m_value.shape(Dimension);
+        ArrayX out_1 = empty<ArrayX>(channels);
+
+        Value lod_f = floor(lod_c), t = lod_c - lod_f;
+        Int32 level = Int32(lod_f);
+
+        eval_level(pos, level, out, active);
+        eval_level(pos, minimum(level + 1, (int32_t) m_levels - 1),
+                   out_1.data(), active);
+
+        for (size_t ch = 0; ch < channels; ++ch)
+            out[ch] = lerp(out[ch], out_1[ch], t);
+    }
+
+    /**
+     * \brief Evaluate the texture, choosing the level of detail based on the
+     * derivatives of the position with respect to the screen-space coordinates
+     *
+     * With <tt>max_anisotropy == 1</tt>, the level is determined by the longer
+     * derivative (trilinear filtering). Otherwise, \c max_anisotropy trilinear
+     * lookups are distributed along the longer derivative, and the level is
+     * reduced accordingly (by up to a factor of \c max_anisotropy, depending
+     * on the ratio of the lengths of the two derivatives).
+     */
+    void eval(const PosF &pos, const PosF &dp_dx, const PosF &dp_dy,
+              Value *out, Mask active = true,
+              uint32_t max_anisotropy = 1) const {
+        if (max_anisotropy <= 1) {
+            eval_lod(pos, lod(dp_dx, dp_dy), out, active);
+            return;
+        }
+
+        PosF res = resolution_f();
+        Value len2_x = squared_norm(dp_dx * res),
+              len2_y = squared_norm(dp_dy * res);
+
+        Mask x_major = len2_x >= len2_y;
+        PosF axis = select(x_major, dp_dx, dp_dy);
+        Value major = sqrt(maximum(len2_x, len2_y)),
+              minor = sqrt(minimum(len2_x, len2_y));
+
+        Value n = clamp(major / maximum(minor, 1e-8f), 1.f,
+                        (float) max_anisotropy);
+        Value lod_ = log2(major / n);
+
+        const size_t channels = m_value.shape(Dimension);
+        ArrayX out_k = empty<ArrayX>(channels);
+        for (size_t ch = 0; ch < channels; ++ch)
+            out[ch] = zeros<Value>();
+
+        float scale = 1.f / (float) max_anisotropy;
+        for (uint32_t k = 0; k < max_anisotropy; ++k) {
+            PosF pos_k = fmadd(axis, ((float) k + .5f) * scale - .5f, pos);
+            eval_lod(pos_k, lod_, out_k.data(), active);
+            for (size_t ch = 0; ch < channels; ++ch)
+                out[ch] = fmadd(out_k[ch], scale, out[ch]);
+        }
+    }
+
+protected:
+    PosF resolution_f() const {
+        PosF res;
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = (float) m_resolution[i];
+        return res;
+    }
+
+    /// Interpolate within the given (per-lane) level of the pyramid
+    void eval_level(const PosF &pos, const Int32 &level, Value *out,
+                    const Mask &active) const {
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension);
+
+        PosI res;
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = maximum(Int32((int32_t) m_resolution[i]) >> level, 1);
+
+        UInt32 offset = gather<UInt32>(m_offsets, UInt32(level), active);
+
+        if (m_filter_mode == FilterMode::Nearest) {
+            PosI pos_i = wrap(floor2int<PosI>(pos * PosF(res)), res);
+            UInt32 idx = fmadd(index(pos_i, res), channels, offset);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = gather<Value>(m_pyramid, idx + ch, active);
+            return;
+        }
+
+        const PosF pos_f = fmadd(pos, PosF(res), -.5f);
+        const PosI pos_i = floor2int<PosI>(pos_f);
+        const PosF w1 = pos_f - PosF(pos_i),
+                   w0 = 1.f - w1;
+
+        for (uint32_t ch = 0; ch < channels; ++ch)
+            out[ch] = zeros<Value>();
+
+        for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+            PosI pos_c;
+            Value weight = 1.f;
+            for (size_t i = 0; i < Dimension; ++i) {
+                bool upper = (corner >> i) & 1;
+                pos_c[i] = upper ? pos_i[i] + 1 : pos_i[i];
+                weight *= upper ? w1[i] : w0[i];
+            }
+
+            UInt32 idx = fmadd(index(wrap(pos_c, res), res), channels, offset);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = fmadd(gather<Value>(m_pyramid, idx + ch, active),
+                                weight, out[ch]);
+        }
+    }
+
+    PosI wrap(const PosI &pos, const PosI &res) const {
+        return detail::texture_wrap(pos, res, m_wrap_mode);
+    }
+
+    static UInt32 index(const PosI &pos, const PosI &res) {
+        return detail::texture_index<UInt32>(pos, res);
+    }
+
+    /// Compute the coarser levels and concatenate them
+    void build() {
+        const size_t channels = m_value.shape(Dimension);
+
+        std::vector<uint32_t> offsets(m_levels);
+        size_t total = 0;
+        for (size_t l = 0; l < m_levels; ++l) {
+            offsets[l] = (uint32_t) total;
+            size_t size = channels;
+            for (size_t i = 0; i < Dimension; ++i)
+                size *= level_resolution(l, i);
+            total += size;
+        }
+        if (total > 0xFFFFFFFFull)
+            drjit_raise("MipmapTexture::set_tensor(): the texture is too large!");
+
+        m_offsets = load<StorageU>(offsets.data(), m_levels);
+        m_pyramid = zeros<Storage>(total);
+
+        Storage level = m_value.array();
+        scatter(m_pyramid, level, arange<StorageU>(level.size()));
+
+        for (size_t l = 1; l < m_levels; ++l) {
+            level = downsample(level, l, channels);
+            scatter(m_pyramid, level,
+                    arange<StorageU>(level.size()) + offsets[l]);
+        }
+
+        drjit::eval(m_pyramid);
+    }
+
+    /// Box-filter level <tt>l - 1</tt> (\c src) to produce level \c l
+    Storage downsample(const Storage &src, size_t l, size_t channels) const {
+        size_t size = channels;
+        for (size_t i = 0; i < Dimension; ++i)
+            size *= level_resolution(l, i);
+
+        StorageU texel = arange<StorageU>(size),
+                 ch = texel % (uint32_t) channels,
+                 coord[Dimension];
+        texel /= (uint32_t) channels;
+        for (size_t i = 0; i < Dimension; ++i) {
+            uint32_t res = (uint32_t) level_resolution(l, i);
+            coord[i] = texel % res;
+            texel /= res;
+        }
+
+        Storage result = zeros<Storage>(size);
+        for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+            StorageU idx = zeros<StorageU>(size);
+            for (size_t i = Dimension; i > 0; --i) {
+                uint32_t res = (uint32_t) level_resolution(l - 1, i - 1);
+                StorageU c = minimum(coord[i - 1] * 2 + ((corner >> (i - 1)) & 1),
+                                     res - 1);
+                idx = fmadd(idx, res, c);
+            }
+            result += gather<Storage>(src, fmadd(idx, (uint32_t) channels, ch));
+        }
+
+        return result * (1.f / (float) (1u << Dimension));
+    }
+
+private:
+    /// Finest level
+    TensorXf m_value;
+
+    /// Concatenation of all levels and the offset of each one of them
+    Storage m_pyramid;
+    StorageU m_offsets;
+
+    /// Resolution of the finest level (width, height, depth)
+    size_t m_resolution[Dimension] { };
+    size_t m_levels = 0;
+
+    FilterMode m_filter_mode = FilterMode::Linear;
+    WrapMode m_wrap_mode = WrapMode::Clamp;
+    size_t m_max_levels = (size_t) -1;
+};
+
+/**
+ * \brief Array of textures with the same resolution and channel count
+ *
+ * The layers are stored in a single allocation, and each lane of a lookup
+ * selects its layer via an index. This replaces a loop or a virtual function
+ * call over separate \ref Texture instances by a single gathered fetch. The
+ * lookups use the software implementation of \ref Texture::eval_nonaccel().
+ */
+template <typename Value, size_t Dimension> class TextureArray {
+public:
+    using Base = Texture<Value, Dimension>;
+    using Int32 = typename Base::Int32;
+    using UInt32 = typename Base::UInt32;
+    using Mask = typename Base::Mask;
+    using PosF = typename Base::PosF;
+    using PosI = typename Base::PosI;
+    using Storage = typename Base::Storage;
+    using TensorXf = typename Base::TensorXf;
+
+    /// Default constructor: create an invalid texture array
+    TextureArray() = default;
+
+    /**
+     * \brief Construct a texture array from a tensor whose first dimension
+     * indexes the layers (followed by the texture dimensions and channels)
+     */
+    TextureArray(const TensorXf &tensor,
+                 FilterMode filter_mode = FilterMode::Linear,
+                 WrapMode wrap_mode = WrapMode::Clamp)
+        : m_filter_mode(filter_mode), m_wrap_mode(wrap_mode) {
+        set_tensor(tensor);
+    }
+
+    /// Return the texture dimension plus two (for the layers and channels)
+    size_t ndim() const { return Dimension + 2; }
+
+    /// Return the shape of the underlying tensor
+    const size_t *shape() const { return m_value.shape().data(); }
+
+    /// Return the number of layers
+    size_t layers() const { return m_value.shape(0); }
+
+    FilterMode filter_mode() const { return m_filter_mode; }
+    WrapMode wrap_mode() const { return m_wrap_mode; }
+
+    const Storage &value() const { return m_value.array(); }
+    const TensorXf &tensor() const { return m_value; }
+
+    /// Override the texel values of all layers
+    void set_value(const Storage &value) {
+        if (value.size() != m_value.array().size())
+            drjit_raise("TextureArray::set_value(): unexpected array size!");
+        m_value.array() = value;
+    }
+
+    /// Override the texture contents (shape changes are permitted)
+    void set_tensor(const TensorXf &tensor) {
+        if (tensor.ndim() != Dimension + 2)
+            drjit_raise("TextureArray::set_tensor(): tensor dimension must "
+                        "equal texture dimension plus two (layers and "
+                        "channels).");
+        if (tensor.shape(Dimension + 1) == 0 || tensor.shape(0) == 0)
+            drjit_raise("TextureArray::set_tensor(): must have at least 1 "
+                        "layer and channel!");
+        if (tensor.array().size() > 0xFFFFFFFFull)
+            drjit_raise("TextureArray::set_tensor(): the texture array is "
+                        "too large!");
+
+        for (size_t i = 0; i < Dimension; ++i)
+            m_resolution[i] = (int32_t) tensor.shape(Dimension - i);
+
+        m_value = tensor;
+    }
+
+    /**
+     * \brief Evaluate the texture of the given layer at the given position
+     *
+     * Lanes whose \c layer index is out of bounds evaluate to zero.
+     */
+    void eval(const PosF &pos, const UInt32 &layer, Value *out,
+              Mask active = true) const {
+        const uint32_t channels = (uint32_t) m_value.shape(Dimension + 1),
+                       layer_size = (uint32_t) (m_value.array().size() /
+                                                m_value.shape(0));
+
+        if constexpr (!is_array_v<Mask>)
+            active = true;
+        active &= layer < (uint32_t) m_value.shape(0);
+
+        PosI res;
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = m_resolution[i];
+
+        UInt32 offset = layer * layer_size;
+
+        if (m_filter_mode == FilterMode::Nearest) {
+            PosI pos_i = detail::texture_wrap(
+                floor2int<PosI>(pos * PosF(res)), res, m_wrap_mode);
+            UInt32 idx = fmadd(detail::texture_index<UInt32>(pos_i, res),
+                               channels, offset);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = gather<Value>(m_value.array(), idx + ch, active);
+            return;
+        }
+
+        const PosF pos_f = fmadd(pos, PosF(res), -.5f);
+        const PosI pos_i = floor2int<PosI>(pos_f);
+        const PosF w1 = pos_f - PosF(pos_i),
+                   w0 = 1.f - w1;
+
+        for (uint32_t ch = 0; ch < channels; ++ch)
+            out[ch] = zeros<Value>();
+
+        for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+            PosI pos_c;
+            Value weight = 1.f;
+            for (size_t i = 0; i < Dimension; ++i) {
+                bool upper = (corner >> i) & 1;
+                pos_c[i] = upper ? pos_i[i] + 1 : pos_i[i];
+                weight *= upper ? w1[i] : w0[i];
+            }
+
+            pos_c = detail::texture_wrap(pos_c, res, m_wrap_mode);
+            UInt32 idx = fmadd(detail::texture_index<UInt32>(pos_c, res),
+                               channels, offset);
+            for (uint32_t ch = 0; ch < channels; ++ch)
+                out[ch] = fmadd(gather<Value>(m_value.array(), idx + ch, active),
+                                weight, out[ch]);
+        }
+    }
+
+private:
+    /// Texels of all layers (layer, [depth, ] [height, ] width, channel)
+    TensorXf m_value;
+
+    /// Resolution of each layer (width, height, depth)
+    int32_t m_resolution[Dimension] { };
+
+    FilterMode m_filter_mode = FilterMode::Linear;
+    WrapMode m_wrap_mode = WrapMode::Clamp;
+};
+
+/**
+ * \brief Texture whose texels are paged in and out in tiles
+ *
+ * Only a bounded number of tiles (the \c capacity) of the virtual texture
+ * are resident at any time. They are stored in a shared pool of tile slots,
+ * and a page table maps each tile to its slot. Lookups of texels of missing
+ * tiles evaluate to zero and increment a per-tile counter of the feedback
+ * buffer. Between frames, the application queries \ref requested_tiles()
+ * and streams the corresponding data in via \ref load_tile(), possibly after
+ * making space with \ref evict_tile(). Memory usage thus scales with the
+ * working set of the lookups rather than with the resolution.
+ */
+template <typename Value, size_t Dimension> class VirtualTexture {
+public:
+    using Base = Texture<Value, Dimension>;
+    using Int32 = typename Base::Int32;
+    using UInt32 = typename Base::UInt32;
+    using Mask = typename Base::Mask;
+    using PosF = typename Base::PosF;
+    using PosI = typename Base::PosI;
+    using Storage = typename Base::Storage;
+    using StorageU = uint32_array_t<Storage>;
+
+    /// Default constructor: create an invalid texture object
+    VirtualTexture() = default;
+
+    /**
+     * \brief Create a virtual texture with the specified size and channel
+     * count
+     *
+     * The tiles consist of \c tile_size texels (a power of two) along each
+     * dimension, and at most \c capacity of them are resident. All tiles
+     * are initially missing.
+     */
+    VirtualTexture(const size_t shape[Dimension], size_t channels,
+                   uint32_t tile_size, uint32_t capacity,
+                   FilterMode filter_mode = FilterMode::Linear,
+                   WrapMode wrap_mode = WrapMode::Clamp)
+        : m_channels((uint32_t) channels), m_tile_size(tile_size),
+          m_capacity(capacity), m_filter_mode(filter_mode),
+          m_wrap_mode(wrap_mode) {
+        if (channels == 0)
+            drjit_raise("VirtualTexture(): must have at least 1 channel!");
+        if (tile_size == 0 || (tile_size & (tile_size - 1)) != 0)
+            drjit_raise("VirtualTexture(): the tile size must be a power of "
+                        "two!");
+
+        m_tile_texels = 1;
+        m_tile_count = 1;
+        for (size_t i = 0; i < Dimension; ++i) {
+            m_shape[i] = shape[i];
+            m_resolution[i] = (int32_t) shape[Dimension - 1 - i];
+            m_tiles[i] = (int32_t) ((shape[Dimension - 1 - i] + tile_size - 1) /
+                                    tile_size);
+            m_tile_texels *= tile_size;
+            m_tile_count *= (uint32_t) m_tiles[i];
+        }
+
+        m_page_table = zeros<StorageU>(m_tile_count);
+        m_feedback = zeros<StorageU>(m_tile_count);
+        m_pool = zeros<Storage>((size_t) capacity * m_tile_texels * channels);
+
+        m_slot.resize(m_tile_count, 0);
+        m_free.resize(capacity);
+        for (uint32_t i = 0; i < capacity; ++i)
+            m_free[i] = capacity - 1 - i;
+    }
+
+    /// Return the texture dimension plus one (for the "channel dimension")
+    size_t ndim() const { return Dimension + 1; }
+
+    /// Return the number of channels
+    size_t channels() const { return m_channels; }
+
+    /// Return the virtual resolution (without channels)
+    const size_t *shape() const { return m_shape; }
+
+    FilterMode filter_mode() const { return m_filter_mode; }
+    WrapMode wrap_mode() const { return m_wrap_mode; }
+
+    uint32_t tile_size() const { return m_tile_size; }
+    uint32_t tile_count() const { return m_tile_count; }
+    uint32_t capacity() const { return m_capacity; }
+
+    /// Return the number of resident tiles
+    uint32_t resident_count() const {
+        return m_capacity - (uint32_t) m_free.size();
+    }
+
+    /**
+     * \brief Return the linear index of the tile containing a given texel
+     * (both specified in the order used for positions: x, y, z)
+     */
+    uint32_t tile_index(const size_t texel[Dimension]) const {
+        uint32_t tile = 0;
+        for (size_t i = Dimension; i > 0; --i)
+            tile = tile * (uint32_t) m_tiles[i - 1] +
+                   (uint32_t) (texel[i - 1] / m_tile_size);
+        return tile;
+    }
+
+    bool is_resident(uint32_t tile) const {
+        check_tile(tile, "is_resident");
+        return m_slot[tile] != 0;
+    }
+
+    /**
+     * \brief Make a tile resident and set its texels
+     *
+     * The array \c data contains <tt>tile_size^Dimension * channels</tt>
+     * values in C-style order (like the tensor of a \ref Texture). Texels of
+     * tiles at the boundary that lie outside of the texture are ignored. A
+     * resident tile is overwritten in place.
+     */
+    void load_tile(uint32_t tile, const Storage &data) {
+        check_tile(tile, "load_tile");
+        if (data.size() != (size_t) m_tile_texels * m_channels)
+            drjit_raise("VirtualTexture::load_tile(): unexpected array size!");
+
+        uint32_t slot = m_slot[tile];
+        if (slot == 0) {
+            if (m_free.empty())
+                drjit_raise("VirtualTexture::load_tile(): all %u tile slots "
+                            "are in use, evict tiles first!", m_capacity);
+            slot = m_free.back() + 1;
+            m_free.pop_back();
+            m_slot[tile] = slot;
+            scatter(m_page_table, StorageU(slot), StorageU(tile));
+        }
+
+        scatter(m_pool, data,
+                arange<StorageU>(data.size()) +
+                    (slot - 1) * m_tile_texels * m_channels);
+    }
+
+    /// Release the slot of a resident tile, subsequent lookups miss again
+    void evict_tile(uint32_t tile) {
+        check_tile(tile, "evict_tile");
+        uint32_t slot = m_slot[tile];
+        if (slot == 0)
+            return;
+
+        m_slot[tile] = 0;
+        m_free.push_back(slot - 1);
+        scatter(m_page_table, StorageU(0u), StorageU(tile));
+    }
+
+    /// Return the number of missed lookups per tile since the last reset
+    const StorageU &feedback() const { return m_feedback; }
+
+    /**
+     * \brief Return the indices of the tiles whose texels were missing in
+     * lookups since the last reset, in increasing order
+     *
+     * The feedback buffer is reset when \c reset is \c true.
+     */
+    StorageU requested_tiles(bool reset = true) {
+        drjit::eval(m_feedback);
+        StorageU result = compress(m_feedback > 0u);
+        if (reset)
+            m_feedback = zeros<StorageU>(m_tile_count);
+        return result;
+    }
+
+    /// Evaluate the texture at the given position
+    void eval(const PosF &pos, Value *out, Mask active = true) const {
+        if constexpr (!is_array_v<Mask>)
+            active = true;
+
+        PosI res;
+        for (size_t i = 0; i < Dimension; ++i)
+            res[i] = m_resolution[i];
+
+        if (m_filter_mode == FilterMode::Nearest) {
+            PosI pos_i = detail::texture_wrap(
+                floor2int<PosI>(pos * PosF(res)), res, m_wrap_mode);
+            fetch(pos_i, out, Value(1.f), true, active);
+            return;
+        }
+
+        const PosF pos_f = fmadd(pos, PosF(res), -.5f);
+        const PosI pos_i = floor2int<PosI>(pos_f);
+        const PosF w1 = pos_f - PosF(pos_i),
+                   w0 = 1.f - w1;
+
+        for (uint32_t corner = 0; corner < (1u << Dimension); ++corner) {
+            PosI pos_c;
+            Value weight = 1.f;
+            for (size_t i = 0; i < Dimension; ++i) {
+                bool upper = (corner >> i) & 1;
+                pos_c[i] = upper ? pos_i[i] + 1 : pos_i[i];
+                weight *= upper ? w1[i] : w0[i];
+            }
+
+            fetch(detail::texture_wrap(pos_c, res, m_wrap_mode), out, weight,
+                  corner == 0, active);
+        }
+    }
+
+protected:
+    void check_tile(uint32_t tile, const char *name) const {
+        if (tile >= m_tile_count)
+            drjit_raise("VirtualTexture::%s(): tile index %u is out of "
+                        "bounds!", name, tile);
+    }
+
+    /// Accumulate the weighted texel at a wrapped position into \c out
+    void fetch(const PosI &pos, Value *out, const Value &weight, bool init,
+               const Mask &active) const {
+        PosI tiles, tile_pos, local_pos, tile_res;
+        int32_t shift = (int32_t) log2i(m_tile_size);
+        for (size_t i = 0; i < Dimension; ++i) {
+            tiles[i] = m_tiles[i];
+            tile_pos[i] = pos[i] >> shift;
+            local_pos[i] = pos[i] & ((int32_t) m_tile_size - 1);
+            tile_res[i] = (int32_t) m_tile_size;
+        }
+
+        UInt32 tile = detail::texture_index<UInt32>(tile_pos, tiles),
+               slot = gather<UInt32>(m_page_table, tile, active);
+
+        // Record the misses in the feedback buffer
+        Mask resident = neq(slot, 0u);
+        scatter_reduce(ReduceOp::Add, m_feedback, UInt32(1u), tile,
+                       active && !resident);
+
+        UInt32 idx = fmadd(slot - 1, m_tile_texels,
+                           detail::texture_index<UInt32>(local_pos, tile_res)) *
+                     m_channels;
+
+        for (uint32_t ch = 0; ch < m_channels; ++ch) {
+            Value value =
+                gather<Value>(m_pool, idx + ch, active && resident) * weight;
+            out[ch] = init ? value : out[ch] + value;
+        }
+    }
+
+private:
+    size_t m_shape[Dimension] { };
+    uint32_t m_channels = 0;
+    uint32_t m_tile_size = 0;
+    uint32_t m_tile_texels = 0;
+    uint32_t m_tile_count = 0;
+    uint32_t m_capacity = 0;
+
+    /// Resolution and number of tiles (width, height, depth)
+    int32_t m_resolution[Dimension] { };
+    int32_t m_tiles[Dimension] { };
+
+    /// Device-side page table (tile -> slot + 1, or 0) and tile pool
+    StorageU m_page_table;
+    Storage m_pool;
+    mutable StorageU m_feedback;
+
+    /// Host-side copy of the page table and unused slots
+    std::vector<uint32_t> m_slot;
+    std::vector<uint32_t> m_free;
+
+    FilterMode m_filter_mode = FilterMode::Linear;
+    WrapMode m_wrap_mode = WrapMode::Clamp;
 };
 
 NAMESPACE_END(drjit)
@@ -262,6 +262,465 @@ IndexN binary_search(typename std::enable_if_t<is_jit_v<Index1>, Index1> start_,
     return start;
 }
 
+/**
+ * \brief Sorted table in Eytzinger (breadth-first) order for repeated
+ * vectorized searches
+ *
+ * The constructor permutes a sorted flat array so that the implicit binary
+ * search tree is stored level by level, with the children of slot \c k at
+ * slots <tt>2k</tt> and <tt>2k+1</tt> (slot 0 is unused). The nodes visited
+ * by all lanes during the first steps of a search thus share a few cache
+ * lines, while a search in the sorted array fetches a new line at every
+ * step ("Array Layouts for Comparison-Based Searching", Khuong and Morin,
+ * 2017). The in-order rank of every slot is computed in closed form from the
+ * subtree sizes of a complete binary tree, so construction needs just one
+ * kernel.
+ *
+ * \ref search() runs a fixed number of <tt>log2(n) + 1</tt> steps, and these
+ * are unrolled within the calling kernel. Every step is a masked gather
+ * followed by a select, hence lanes never diverge.
+ */
+template <typename Value_> struct EytzingerTable {
+    using Value  = detached_t<Value_>;
+    using UInt32 = uint32_array_t<Value>;
+    using Mask   = mask_t<UInt32>;
+
+    static_assert(is_dynamic_array_v<Value> && array_depth_v<Value> == 1,
+                  "EytzingerTable: requires a flat dynamic array type!");
+
+    /// Number of entries
+    uint32_t size = 0;
+
+    /// Entries in Eytzinger order, starting at slot 1
+    Value values;
+
+    /// Position in the sorted array referenced by each slot (\c size for slot 0)
+    UInt32 index;
+
+    EytzingerTable() = default;
+
+    /// Build the table from an array that is sorted in ascending order
+    EytzingerTable(const Value_ &sorted) {
+        size_t n_ = sorted.size();
+        if (n_ == 0)
+            drjit_raise("drjit::EytzingerTable(): the array must be nonempty!");
+        if (n_ >= (1ull << 31))
+            drjit_raise("drjit::EytzingerTable(): too many entries (%zu)!", n_);
+
+        uint32_t n = (uint32_t) n_, depth = log2i(n);
+        size = n;
+
+        // Number of nodes within the subtree rooted at the given slot
+        auto subtree_size = [&](const UInt32 &slot) {
+            Mask valid = slot <= n;
+            UInt32 levels = (depth + lzcnt(slot)) - 31u,
+                   first  = slot << levels,
+                   full   = UInt32(1u) << levels,
+                   last   = minimum(select(first <= n, n + 1u - first, 0u), full);
+            return select(valid, full - 1u + last, 0u);
+        };
+
+        // In-order rank: left subtree plus the ancestors reached from the left
+        UInt32 slot = arange<UInt32>(1, n + 1),
+               slot_depth = 31u - lzcnt(slot),
+               rank = subtree_size(slot << 1);
+
+        for (uint32_t k = 1; k <= depth; ++k) {
+            Mask active = k <= slot_depth;
+            UInt32 shift = slot_depth - k;
+            Mask right = active && neq((slot >> shift) & 1u, 0u);
+            masked(rank, right) += subtree_size((slot >> (shift + 1u)) << 1) + 1u;
+        }
+
+        index = empty<UInt32>(n + 1);
+        scatter(index, rank, slot);
+        scatter(index, UInt32(n), UInt32(0));
+
+        values = gather<Value>(detach(sorted), minimum(index, n - 1));
+        eval(index, values);
+    }
+
+    /**
+     * \brief Return the smallest sorted index whose value does not satisfy
+     * \c pred, or \ref size when all values do
+     *
+     * Like \ref binary_search(), this requires \c pred to hold for a
+     * (possibly empty) prefix of the sorted array. As opposed to \ref
+     * binary_search(), the predicate receives values instead of indices.
+     */
+    template <typename Predicate>
+    UInt32 search(const Predicate &pred, const Mask &active = true) const {
+        UInt32 slot = 1u;
+
+        for (uint32_t i = 0, steps = log2i(size) + 1; i < steps; ++i) {
+            Mask valid = active && slot <= size;
+            Value value = gather<Value>(values, slot, valid);
+            Mask right = valid && Mask(pred(value));
+            slot = select(valid, sl<1>(slot) + select(right, 1u, 0u), slot);
+        }
+
+        // Undo the steps to the right that followed the last step to the left
+        slot = slot >> (tzcnt(~slot) + 1u);
+
+        return gather<UInt32>(index, slot, active);
+    }
+
+    /// Return the index of the first entry that is >= \c x
+    UInt32 lower_bound(const Value_ &x, const Mask &active = true) const {
+        return search([&](const Value &value) { return value < detach(x); },
+                      active);
+    }
+
+    /// Return the index of the first entry that is > \c x
+    UInt32 upper_bound(const Value_ &x, const Mask &active = true) const {
+        return search([&](const Value &value) { return value <= detach(x); },
+                      active);
+    }
+};
+
+NAMESPACE_BEGIN(detail)
+
+/// Map keys to unsigned integers whose ordering matches that of the keys
+template <typename Key> uint_array_t<Key> radix_key(const Key &key) {
+    using UInt = uint_array_t<Key>;
+    using UIntScalar = scalar_t<UInt>;
+    constexpr UIntScalar SignBit = UIntScalar(1) << (sizeof(UIntScalar) * 8 - 1);
+
+    if constexpr (std::is_floating_point_v<scalar_t<Key>>) {
+        // Flip all bits of negative values, and only the sign of positive ones
+        UInt u = reinterpret_array<UInt>(key);
+        return u ^ (-sr<sizeof(UIntScalar) * 8 - 1>(u) | SignBit);
+    } else if constexpr (std::is_signed_v<scalar_t<Key>>) {
+        return reinterpret_array<UInt>(key) ^ SignBit;
+    } else {
+        return key;
+    }
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Compute the stable sorting permutation of a flat JIT array
+ *
+ * This is a least significant digit radix sort over 2-bit digits, which
+ * works for 32/64-bit integer and floating point keys. Each pass writes a
+ * (digit, element) flag matrix in bucket-major order, whose exclusive
+ * prefix sum directly yields the stable destination of every element, and
+ * then scatters the keys and permutation to their new positions. Passes
+ * over leading digits that are zero in all keys are skipped.
+ *
+ * The function evaluates its input and launches several kernels, hence it
+ * cannot be used within recorded loops or virtual function calls.
+ */
+template <typename Key> uint32_array_t<detached_t<Key>> argsort(const Key &keys) {
+    static_assert(is_jit_v<Key> && array_depth_v<Key> == 1,
+                  "argsort(): requires a flat JIT array!");
+
+    using UKey = uint_array_t<detached_t<Key>>;
+    using UKeyScalar = scalar_t<UKey>;
+    using UInt32 = uint32_array_t<detached_t<Key>>;
+    constexpr uint32_t RadixBits = 2, Radix = 1u << RadixBits,
+                       KeyBits = sizeof(UKeyScalar) * 8;
+
+    size_t size = keys.size();
+    if (size * Radix > 0xffffffffull)
+        drjit_raise("drjit::argsort(): the array is too large (%zu entries)!",
+                    size);
+
+    uint32_t n = (uint32_t) size;
+    UInt32 index = arange<UInt32>(n), perm = index;
+    if (n < 2)
+        return perm;
+
+    UKey ukeys = detail::radix_key(detach(keys));
+
+    UKeyScalar key_max = max(ukeys).entry(0);
+    uint32_t bits = 0;
+    while (bits < KeyBits && (key_max >> bits) != 0)
+        bits += RadixBits;
+
+    // Digit and element associated with every entry of the flag matrix
+    divisor<uint32_t> div(n);
+    auto [slot_digit, slot_elem] = idivmod(arange<UInt32>(n * Radix), div);
+
+    for (uint32_t shift = 0; shift < bits; shift += RadixBits) {
+        UInt32 digit = UInt32((ukeys >> shift) & UKeyScalar(Radix - 1));
+        eval(digit);
+
+        UInt32 flags = select(eq(gather<UInt32>(digit, slot_elem), slot_digit),
+                              UInt32(1), UInt32(0));
+        UInt32 offset = prefix_sum(flags, true);
+        UInt32 target = gather<UInt32>(offset, digit * n + index);
+
+        UKey ukeys_new = empty<UKey>(n);
+        UInt32 perm_new = empty<UInt32>(n);
+        scatter(ukeys_new, ukeys, target);
+        scatter(perm_new, perm, target);
+        ukeys = ukeys_new;
+        perm = perm_new;
+        eval(ukeys, perm);
+    }
+
+    return perm;
+}
+
+/// Sort a flat JIT array in ascending order (see \ref argsort())
+template <typename Key> Key sort(const Key &keys) {
+    return gather<Key>(keys, argsort(keys));
+}
+
+/**
+ * \brief Sort \c keys in ascending order, and reorder \c values (which can
+ * be any array or structure supporting gathers) with the same permutation
+ *
+ * The sort is stable, and gradients propagate through the reordered values.
+ */
+template <typename Key, typename Value>
+std::pair<Key, Value> sort_by_key(const Key &keys, const Value &values) {
+    uint32_array_t<detached_t<Key>> perm = argsort(keys);
+    return { gather<Key>(keys, perm), gather<Value>(values, perm) };
+}
+
+NAMESPACE_BEGIN(detail)
+
+/**
+ * \brief Positions where the runs of equal consecutive keys begin, along
+ * with a mask of these positions
+ */
+template <typename Key>
+std::pair<uint32_array_t<detached_t<Key>>, mask_t<detached_t<Key>>>
+segment_starts(const Key &keys_) {
+    using KeyD = detached_t<Key>;
+    using UInt32 = uint32_array_t<KeyD>;
+    using Mask = mask_t<KeyD>;
+
+    static_assert(is_jit_v<Key> && array_depth_v<Key> == 1,
+                  "segment_starts(): requires a flat JIT array!");
+
+    KeyD keys = detach(keys_);
+    UInt32 index = arange<UInt32>((uint32_t) keys.size());
+    Mask valid = index > 0u,
+         head = !valid ||
+                neq(keys, gather<KeyD>(keys, index - 1u, valid));
+    eval(head);
+
+    return { compress(head), head };
+}
+
+/// Index of the segment containing every entry, given the mask of segment starts
+template <typename Mask> uint32_array_t<Mask> segment_index(const Mask &head) {
+    using UInt32 = uint32_array_t<Mask>;
+    return prefix_sum(select(head, UInt32(1), UInt32(0)), false) - 1u;
+}
+
+/// Identity element of a reduction with respect to the given operator
+template <typename Value> scalar_t<Value> reduce_identity(ReduceOp op) {
+    using Scalar = scalar_t<Value>;
+    switch (op) {
+        case ReduceOp::Add: return Scalar(0);
+        case ReduceOp::Mul: return Scalar(1);
+        case ReduceOp::Min:
+            if constexpr (std::is_floating_point_v<Scalar>)
+                return Infinity<Scalar>;
+            else
+                return std::numeric_limits<Scalar>::max();
+        case ReduceOp::Max:
+            if constexpr (std::is_floating_point_v<Scalar>)
+                return -Infinity<Scalar>;
+            else
+                return std::numeric_limits<Scalar>::min();
+        case ReduceOp::And:
+            if constexpr (std::is_integral_v<Scalar>)
+                return Scalar(~Scalar(0));
+            else
+                break;
+        case ReduceOp::Or:
+            if constexpr (std::is_integral_v<Scalar>)
+                return Scalar(0);
+            else
+                break;
+        default: break;
+    }
+    drjit_raise("drjit::segmented_reduce(): unsupported reduction operator!");
+}
+
+NAMESPACE_END(detail)
+
+/**
+ * \brief Run-length encode a flat JIT array
+ *
+ * Returns the first key of every run of equal consecutive entries together
+ * with the length of the run. This evaluates the input and launches a
+ * compaction kernel, hence it cannot be used within recorded loops or
+ * virtual function calls.
+ */
+template <typename Key>
+std::pair<Key, uint32_array_t<detached_t<Key>>>
+run_length_encode(const Key &keys) {
+    using UInt32 = uint32_array_t<detached_t<Key>>;
+
+    uint32_t n = (uint32_t) keys.size();
+    if (n == 0)
+        return { Key(), UInt32() };
+
+    UInt32 start = detail::segment_starts(keys).first;
+    uint32_t count = (uint32_t) start.size();
+
+    UInt32 run = arange<UInt32>(count);
+    auto not_last = run + 1u < count;
+    UInt32 end = select(not_last, gather<UInt32>(start, run + 1u, not_last),
+                        UInt32(n));
+
+    return { gather<Key>(keys, start), end - start };
+}
+
+/**
+ * \brief Prefix sum within the segments of \c values that share the same
+ * key (runs of equal consecutive entries of \c keys)
+ *
+ * Integer values are scanned globally, and each entry then subtracts the
+ * scan result at the start of its segment. This is exact in modular
+ * arithmetic and requires only a single scan of the values. Floating point
+ * values would lose precision in this subtraction, hence they are instead
+ * scanned using <tt>ceil(log2(longest segment))</tt> passes of the
+ * Hillis-Steele algorithm, which only ever adds values of the same segment
+ * and propagates gradients.
+ *
+ * This evaluates the inputs and launches several kernels, hence it cannot be
+ * used within recorded loops or virtual function calls.
+ */
+template <typename Value, typename Key>
+Value segmented_prefix_sum(const Value &values, const Key &keys,
+                           bool exclusive = true) {
+    using UInt32 = uint32_array_t<detached_t<Key>>;
+
+    static_assert(is_jit_v<Value> && array_depth_v<Value> == 1,
+                  "segmented_prefix_sum(): requires a flat JIT array!");
+
+    size_t n = values.size();
+    if (keys.size() != n)
+        drjit_raise("drjit::segmented_prefix_sum(): the values and keys have "
+                    "mismatched sizes (%zu and %zu)!", n, keys.size());
+    if (n == 0)
+        return values;
+
+    auto [start, head] = detail::segment_starts(keys);
+    UInt32 index = arange<UInt32>((uint32_t) n),
+           first = gather<UInt32>(start, detail::segment_index(head));
+
+    if constexpr (std::is_integral_v<scalar_t<Value>>) {
+        Value scan = prefix_sum(values, true),
+              base = gather<Value>(scan, first);
+        return (exclusive ? scan : scan + values) - base;
+    } else {
+        eval(first);
+        uint32_t length = max(index - first).entry(0) + 1;
+
+        Value scan = values;
+        for (uint32_t offset = 1; offset < length; offset <<= 1) {
+            auto active = index >= first + offset;
+            scan += gather<Value>(scan, index - offset, active);
+            eval(scan);
+        }
+
+        if (exclusive) {
+            auto active = index > first;
+            scan = gather<Value>(scan, index - 1u, active);
+        }
+
+        return scan;
+    }
+}
+
+/**
+ * \brief Reduce the segments of \c values that share the same key (runs of
+ * equal consecutive entries of \c keys) using the operator \c op
+ *
+ * Returns one entry per segment in the order of \ref run_length_encode().
+ * The reduction is a single \ref scatter_reduce() into the output. Since
+ * the entries of a segment are contiguous, backends that reduce atomics
+ * within a warp or vector before issuing them (see
+ * <tt>JitFlag::AtomicReduceLocal</tt>) only perform one atomic operation
+ * per segment and packet in most cases.
+ */
+template <typename Value, typename Key>
+Value segmented_reduce(ReduceOp op, const Value &values, const Key &keys) {
+    static_assert(is_jit_v<Value> && array_depth_v<Value> == 1,
+                  "segmented_reduce(): requires a flat JIT array!");
+
+    size_t n = values.size();
+    if (keys.size() != n)
+        drjit_raise("drjit::segmented_reduce(): the values and keys have "
+                    "mismatched sizes (%zu and %zu)!", n, keys.size());
+    if (n == 0)
+        return values;
+
+    auto [start, head] = detail::segment_starts(keys);
+    Value result = full<Value>(detail::reduce_identity<Value>(op), start.size());
+    scatter_reduce(op, result, values, detail::segment_index(head));
+    return result;
+}
+
+/**
+ * \brief Stream compaction with payload: return the entries of every
+ * argument (arrays or structures supporting gathers) where \c mask is set
+ *
+ * The mask is compacted just once, and the payload arrays then gather from
+ * the resulting index list.
+ */
+template <typename Mask, typename T, typename... Ts>
+std::tuple<T, Ts...> compress(const Mask &mask, const T &value,
+                              const Ts &... values) {
+    uint32_array_t<array_t<Mask>> index = compress(mask);
+    return { gather<T>(value, index), gather<Ts>(values, index)... };
+}
+
+/**
+ * \brief Accumulate \c value into the bins \c index of a histogram with
+ * \c bin_count entries. Entries with an out-of-range index or a disabled
+ * \c active flag are skipped.
+ *
+ * Atomic additions serialize when many threads target the same bin, which is
+ * common in histograms with a few dominant bins. The histogram is therefore
+ * privatized: consecutive groups of 32 entries (one warp or a few packets)
+ * accumulate into one of \c copies replicas in round-robin order, and the
+ * replicas are merged by a \ref block_sum() at the end. The atomics are
+ * furthermore issued with <tt>JitFlag::AtomicReduceLocal</tt> enabled, so
+ * that the lanes of a group which target the same bin are combined before
+ * a single atomic operation reaches memory (the scatter is evaluated
+ * within this function so that the flag applies to the generated kernel).
+ *
+ * For <tt>copies == 1</tt>, this reduces to a plain \ref scatter_reduce().
+ */
+template <typename Value, typename Index>
+Value histogram(const Index &index, uint32_t bin_count, const Value &value,
+                const mask_t<Value> &active = true, uint32_t copies = 16) {
+    using UInt32 = uint32_array_t<detached_t<Index>>;
+
+    static_assert(is_jit_v<Value> && array_depth_v<Value> == 1,
+                  "histogram(): requires a flat JIT array!");
+
+    if (copies == 0)
+        drjit_raise("drjit::histogram(): at least one copy is required!");
+
+    auto valid = active && index < bin_count;
+    scoped_set_flag local_reduce(JitFlag::AtomicReduceLocal, true);
+
+    if (copies == 1) {
+        Value result = zeros<Value>(bin_count);
+        scatter_reduce(ReduceOp::Add, result, value, index, valid);
+        eval(result);
+        return result;
+    }
+
+    UInt32 replica = sr<5>(arange<UInt32>((uint32_t) width(index, value, active))) % copies;
+
+    Value result = zeros<Value>((size_t) bin_count * copies);
+    scatter_reduce(ReduceOp::Add, result, value, index * copies + replica, valid);
+    eval(result);
+    return block_sum(result, copies);
+}
+
 /// Vectorized N-dimensional 'range' iterable with automatic mask computation
 template <typename Value> struct range {
     static constexpr bool Recurse =
@@ -16,7 +16,13 @@
 
 #include <drjit/array.h>
 #include <drjit/vcall_packet.h>
+#include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 extern DRJIT_IMPORT uint32_t jit_registry_put(JitBackend backend,
@@ -31,11 +37,136 @@ extern DRJIT_IMPORT uint32_t jit_var_registry_attr(JitBackend backend,
                                                    VarType type,
                                                    const char *domain,
                                                    const char *name);
+extern DRJIT_IMPORT uint32_t jit_registry_get_max(JitBackend backend,
+                                                  const char *domain);
+extern DRJIT_IMPORT void *jit_registry_get_ptr(JitBackend backend,
+                                               const char *domain, uint32_t id);
 extern DRJIT_IMPORT uint32_t jit_flags();
+extern DRJIT_IMPORT void jit_eval();
+extern DRJIT_IMPORT void jit_sync_thread();
 enum class JitFlags : uint32_t;
 };
 
 NAMESPACE_BEGIN(drjit)
+
+/// Dispatch strategy of a vectorized method call site (see \ref VCallSite)
+enum class VCallMode : uint32_t {
+    /// Follow \ref JitFlag::VCallRecord (the default)
+    Global,
+
+    /// Always record the call into a single kernel
+    Record,
+
+    /// Always dispatch the call via horizontal reduction
+    Reduce,
+
+    /// Time both strategies on the first calls, then use the faster one
+    Adaptive
+};
+
+/**
+ * \brief Runtime statistics and dispatch strategy of a vectorized method call
+ * site, i.e. of a method name within a domain (see \ref vcall_site())
+ *
+ * The counters are gathered for every JIT method call and indexed by the
+ * strategy that was used (0: horizontal reduction, 1: recording). Kernel times
+ * are only measured while a site in \ref VCallMode::Adaptive mode is being
+ * profiled: the method call is then preceded and followed by \ref jit_eval()
+ * and \ref jit_sync_thread(), and its host wall-clock time is accumulated.
+ */
+struct VCallSite {
+    /// Calls per strategy profiled by VCallMode::Adaptive (incl. one warm-up)
+    static constexpr uint32_t ProfileCalls = 4;
+
+    /// Number of buckets of the instance count histogram
+    static constexpr uint32_t HistogramSize = 16;
+
+    VCallSite(const char *domain, const char *name)
+        : domain(domain), name(name) { }
+
+    std::string domain, name;
+
+    /// Dispatch strategy, can be changed at any time
+    std::atomic<VCallMode> mode { VCallMode::Global };
+
+    /// Number of calls and total number of lanes (wavefront size)
+    std::atomic<uint64_t> calls[2] { }, lanes[2] { };
+
+    /// Calls, lanes, and time in nanoseconds profiled by VCallMode::Adaptive
+    std::atomic<uint64_t> profiled_calls[2] { }, profiled_lanes[2] { },
+                          profiled_time_ns[2] { };
+
+    /**
+     * Histogram of the number of instances per call. Bucket \c i counts the
+     * calls with <tt>[2^i, 2^(i+1))</tt> instances, bucket 0 also counts
+     * calls without instances, and the last bucket is open-ended.
+     */
+    std::atomic<uint64_t> instances[HistogramSize] { };
+
+    /// Average profiled time per lane in nanoseconds (excluding warm-up calls)
+    double time_per_lane(bool record) const {
+        uint64_t lanes_ = profiled_lanes[record].load();
+        return lanes_ ? (double) profiled_time_ns[record].load() / lanes_ : 0.0;
+    }
+
+    /// Clear all statistics, which also restarts the profiling of VCallMode::Adaptive
+    void reset() {
+        for (uint32_t i = 0; i < 2; ++i) {
+            calls[i] = 0; lanes[i] = 0;
+            profiled_calls[i] = 0; profiled_lanes[i] = 0;
+            profiled_time_ns[i] = 0;
+        }
+        for (uint32_t i = 0; i < HistogramSize; ++i)
+            instances[i] = 0;
+    }
+
+    VCallSite(const VCallSite &) = delete;
+    VCallSite &operator=(const VCallSite &) = delete;
+};
+
+NAMESPACE_BEGIN(detail)
+
+struct VCallSiteTable {
+    std::mutex mutex;
+    std::unordered_map<std::string, std::unique_ptr<VCallSite>> sites;
+};
+
+inline VCallSiteTable &vcall_site_table() {
+    static VCallSiteTable table;
+    return table;
+}
+
+NAMESPACE_END(detail)
+
+/// Return the statistics of the call site \c domain::name, creating it if needed
+inline VCallSite *vcall_site(const char *domain, const char *name) {
+    detail::VCallSiteTable &table = detail::vcall_site_table();
+    std::string key = std::string(domain) + "::" + name;
+
+    std::lock_guard<std::mutex> guard(table.mutex);
+    std::unique_ptr<VCallSite> &site = table.sites[key];
+    if (!site)
+        site.reset(new VCallSite(domain, name));
+    return site.get();
+}
+
+/// Return all call sites that were created so far
+inline std::vector<VCallSite *> vcall_sites() {
+    detail::VCallSiteTable &table = detail::vcall_site_table();
+    std::lock_guard<std::mutex> guard(table.mutex);
+
+    std::vector<VCallSite *> result;
+    result.reserve(table.sites.size());
+    for (auto &kv : table.sites)
+        result.push_back(kv.second.get());
+    return result;
+}
+
+/// Set the dispatch strategy of the call site \c domain::name
+inline void vcall_set_mode(const char *domain, const char *name, VCallMode mode) {
+    vcall_site(domain, name)->mode = mode;
+}
+
 NAMESPACE_BEGIN(detail)
 
 template <typename T>
@@ -94,7 +225,8 @@ struct MaskScope {
         jit_var_mask_push(Backend, mask.index());
     }
     ~MaskScope() {
-        jit_var_mask_pop(Backend);
+        // Dependent argument, the JIT API isn't declared in packet-only builds
+        jit_var_mask_pop(detached_t<Mask>::Backend);
     }
 };
 
@@ -119,6 +251,108 @@ template <typename T, typename... Ts> void ad_copy(T &value, Ts&...values) {
         ad_copy(values...);
 }
 
+/// Registered instances of a domain as (pointer, ID) pairs ordered by ID
+using VCallRegistryTable = std::vector<std::pair<void *, uint32_t>>;
+
+/**
+ * Return a snapshot of the registered instances of a domain. A recorded method
+ * call queries it once and passes it on, so that it doesn't query the registry
+ * per ID several times. The snapshot isn't cached across calls, since
+ * instances may be registered and IDs reused without Dr.Jit's involvement.
+ */
+inline VCallRegistryTable vcall_registry(JitBackend backend,
+                                         const char *domain) {
+    uint32_t n_max = jit_registry_get_max(backend, domain);
+
+    VCallRegistryTable table;
+    for (uint32_t i = 1; i <= n_max; ++i) {
+        void *ptr = jit_registry_get_ptr(backend, domain, i);
+        if (ptr)
+            table.emplace_back(ptr, i);
+    }
+
+    return table;
+}
+
+/// Sort key installed by \ref VCallCoherenceScope (see below)
+struct VCallCoherence {
+    JitBackend backend;
+    uint32_t key_index;
+    uint32_t key_range;
+};
+
+inline thread_local const VCallCoherence *vcall_coherence = nullptr;
+
+/// Thread count installed by \ref VCallConcurrencyScope (see below)
+inline thread_local uint32_t vcall_concurrency = 0;
+
+/// Instance count limit installed by \ref VCallInlineScope (see below)
+inline thread_local uint32_t vcall_inline_max = 1;
+
+/// Installed by \ref VCallFuseBackwardScope (see below)
+inline thread_local bool vcall_fuse_backward = false;
+
+/// Call site of the method call that is currently being dispatched
+inline thread_local VCallSite *vcall_site_active = nullptr;
+
+/// Add the instance count of the current method call to its site's histogram
+inline void vcall_site_instances(uint32_t n_inst) {
+    VCallSite *site = vcall_site_active;
+    if (!site)
+        return;
+
+    uint32_t bucket = 0;
+    while (n_inst > 1 && bucket + 1 < VCallSite::HistogramSize) {
+        n_inst >>= 1;
+        bucket++;
+    }
+    site->instances[bucket]++;
+
+    // Only the outermost dispatch routine reports (vcall_autodiff records, too)
+    vcall_site_active = nullptr;
+}
+
+struct VCallSiteScope {
+    VCallSiteScope(VCallSite *site) : m_prev(vcall_site_active) {
+        vcall_site_active = site;
+    }
+    ~VCallSiteScope() { vcall_site_active = m_prev; }
+    VCallSite *m_prev;
+};
+
+/**
+ * Decide whether a method call at \c site should be recorded, and whether
+ * it should be profiled for \ref VCallMode::Adaptive
+ */
+inline bool vcall_site_record(VCallSite *site, bool &profile) {
+    uint32_t flags = jit_flags();
+    profile = false;
+
+    VCallMode mode = site->mode.load(std::memory_order_relaxed);
+    if (mode == VCallMode::Global)
+        return (flags & (uint32_t) JitFlag::VCallRecord) != 0;
+    else if (mode == VCallMode::Record)
+        return true;
+
+    // Horizontal reduction evaluates, which isn't possible while recording
+    if (flags & (uint32_t) JitFlag::Recording)
+        return true;
+    else if (mode == VCallMode::Reduce)
+        return false;
+
+    uint64_t n_reduce = site->profiled_calls[0].load(),
+             n_record = site->profiled_calls[1].load();
+
+    // Alternate between the strategies while profiling, starting with reduce
+    if (n_reduce < VCallSite::ProfileCalls ||
+        n_record < VCallSite::ProfileCalls) {
+        profile = true;
+        return n_record < n_reduce;
+    }
+
+    return site->time_per_lane(true) < site->time_per_lane(false);
+}
+
 template <typename Guide, typename Type, typename = int> struct vectorize_type {
     using type = Type;
 };
@@ -128,6 +362,27 @@ struct vectorize_type<Guide, Type, enable_if_t<std::is_scalar_v<Type> && !std::i
     using type = replace_scalar_t<Guide, Type>;
 };
 
+/**
+ * Evaluate an instance-uniform method once per registered instance, place the
+ * results in a table indexed by instance ID, and gather from it by \c self
+ */
+template <typename Class, typename Result, typename Func, typename Self>
+Result vcall_uniform(const Func &func, const Self &self,
+                     const mask_t<Self> &mask) {
+    using UInt32 = uint32_array_t<Self>;
+    static constexpr JitBackend Backend = detached_t<Self>::Backend;
+
+    VCallRegistryTable registry = vcall_registry(Backend, Class::Domain);
+    Result table = zeros<Result>(
+        (registry.empty() ? 0 : registry.back().second) + 1);
+
+    for (auto [ptr, id] : registry)
+        scatter(table, Result(func((Class *) ptr)), UInt32(id));
+
+    return gather<Result>(table, UInt32::borrow(self.index()),
+                          mask && neq(self, nullptr));
+}
+
 template <typename Result, typename Func, typename Self, typename... Args>
 Result vcall_jit_reduce(const Func &func, const Self &self,
                         const Args &... args);
@@ -148,14 +403,53 @@ auto vcall(const char *name, const Func &func, const Self &self,
 
     DRJIT_MARK_USED(name);
     if constexpr (is_jit_v<Self>) {
-        if ((jit_flags() & (uint32_t) JitFlag::VCallRecord) == 0) {
-            return detail::vcall_jit_reduce<Result>(func, self, copy_diff(args)...);
-        } else {
-            if constexpr (is_diff_v<Self>)
-                return detail::vcall_autodiff<Result>(name, func, self, args...);
-            else
-                return detail::vcall_jit_record<Result>(name, func, self, args...);
+        // DRJIT_VCALL_METHOD() instantiates this function per method
+        static VCallSite *site = vcall_site(Class::Domain, name);
+
+        bool profile;
+        bool record = vcall_site_record(site, profile);
+        uint64_t lanes = (uint64_t) width(self, args...);
+
+        std::chrono::steady_clock::time_point start;
+        if (profile) {
+            // Flush pending work so that only the method call is timed
+            jit_eval();
+            jit_sync_thread();
+            start = std::chrono::steady_clock::now();
+        }
+
+        Result result;
+        {
+            VCallSiteScope scope(site);
+            if (!record) {
+                result = detail::vcall_jit_reduce<Result>(func, self, copy_diff(args)...);
+            } else {
+                if constexpr (is_diff_v<Self>)
+                    result = detail::vcall_autodiff<Result>(name, func, self, args...);
+                else
+                    result = detail::vcall_jit_record<Result>(name, func, self, args...);
+            }
+        }
+
+        if (profile) {
+            schedule(result);
+            jit_eval();
+            jit_sync_thread();
+            uint64_t time_ns = (uint64_t)
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+
+            // The first call usually includes kernel compilation, skip it
+            if (site->profiled_calls[record]++ > 0) {
+                site->profiled_lanes[record] += lanes;
+                site->profiled_time_ns[record] += time_ns;
+            }
         }
+
+        site->calls[record]++;
+        site->lanes[record] += lanes;
+
+        return result;
     } else {
         return detail::vcall_packet<Result>(func, self, args...);
     }
@@ -163,6 +457,139 @@ auto vcall(const char *name, const Func &func, const Self &self,
 
 NAMESPACE_END(detail)
 
+/**
+ * \brief Reorder the lanes of vectorized method calls by a user-provided key
+ *
+ * While this scope is active, vectorized method calls that are dispatched via
+ * horizontal reduction (i.e. with \ref JitFlag::VCallRecord disabled) sort the
+ * lanes targeting each instance by the value of \c key before invoking it.
+ * Choosing, e.g., a texture ID or a quantized Morton code (\ref morton.h) as
+ * the key improves the memory locality of the callee. The per-instance
+ * permutations are computed upfront, in a single evaluation for all
+ * instances.
+ *
+ * The key must have the same size as the instance array of the method call,
+ * and its entries should lie in the range <tt>[0, key_range)</tt> (larger
+ * values are clamped to <tt>key_range - 1</tt>). The scope does not affect
+ * method calls that are nested within the callees.
+ */
+template <typename UInt32> struct VCallCoherenceScope {
+    static_assert(is_jit_v<UInt32> && std::is_same_v<scalar_t<UInt32>, uint32_t>,
+                  "VCallCoherenceScope(): requires a 32 bit unsigned JIT array!");
+
+    VCallCoherenceScope(const UInt32 &key, uint32_t key_range)
+        : m_key(key), m_prev(detail::vcall_coherence) {
+        if (key_range == 0)
+            drjit_raise("VCallCoherenceScope(): key_range must be nonzero!");
+        m_state = { detached_t<UInt32>::Backend, m_key.index(), key_range };
+        detail::vcall_coherence = &m_state;
+    }
+
+    ~VCallCoherenceScope() { detail::vcall_coherence = m_prev; }
+
+    VCallCoherenceScope(const VCallCoherenceScope &) = delete;
+    VCallCoherenceScope &operator=(const VCallCoherenceScope &) = delete;
+
+private:
+    UInt32 m_key;
+    detail::VCallCoherence m_state;
+    const detail::VCallCoherence *m_prev;
+};
+
+/**
+ * \brief Launch the instances of vectorized method calls concurrently
+ *
+ * By default, method calls that are dispatched via horizontal reduction
+ * (i.e. with \ref JitFlag::VCallRecord disabled) trace and launch one kernel
+ * per instance after the other. When there are many instances with few lanes
+ * each, the launch latency of these kernels dominates. While this scope is
+ * active, the instances are instead split into up to \c thread_count groups
+ * that are processed by the worker threads of the Dr.Jit thread pool. Each
+ * worker traces its share of the instances and evaluates their outputs on its
+ * own CUDA stream or chain of LLVM tasks. Once all of them have finished, the
+ * outputs are scattered into the result on the calling thread.
+ *
+ * The callees must therefore be safe to trace from several threads at once.
+ * Method calls returning differentiable types, and method calls that are
+ * nested within the callees, are not affected by this scope.
+ */
+struct VCallConcurrencyScope {
+    VCallConcurrencyScope(uint32_t thread_count)
+        : m_prev(detail::vcall_concurrency) {
+        detail::vcall_concurrency = thread_count;
+    }
+
+    ~VCallConcurrencyScope() { detail::vcall_concurrency = m_prev; }
+
+    VCallConcurrencyScope(const VCallConcurrencyScope &) = delete;
+    VCallConcurrencyScope &operator=(const VCallConcurrencyScope &) = delete;
+
+private:
+    uint32_t m_prev;
+};
+
+/**
+ * \brief Inline recorded method calls with few instances into a select chain
+ *
+ * When \ref JitFlag::VCallInline is set, recorded method calls (i.e. with
+ * \ref JitFlag::VCallRecord enabled) targeting a single instance are inlined
+ * into the caller. While this scope is active, the same applies to method
+ * calls with up to \c max_instances instances: each callee is traced on all
+ * lanes and its output is blended into the result with a chain of \ref
+ * select() operations, while side effects are masked.
+ *
+ * This avoids the indirect call and lets the compiler optimize across the
+ * callees, but evaluates every callee on all lanes. It is therefore only
+ * worthwhile for tiny callees, which should be characterized by benchmarking.
+ */
+struct VCallInlineScope {
+    VCallInlineScope(uint32_t max_instances)
+        : m_prev(detail::vcall_inline_max) {
+        detail::vcall_inline_max = max_instances;
+    }
+
+    ~VCallInlineScope() { detail::vcall_inline_max = m_prev; }
+
+    VCallInlineScope(const VCallInlineScope &) = delete;
+    VCallInlineScope &operator=(const VCallInlineScope &) = delete;
+
+private:
+    uint32_t m_prev;
+};
+
+/**
+ * \brief Record the reverse-mode derivative of differentiable method calls
+ * along with their primal evaluation
+ *
+ * By default, the backward pass of a recorded method call with gradient
+ * tracking re-traces every callee, builds its AD graph for the captured
+ * inputs and differentiates it. While this scope is active, calls made from
+ * this thread instead trace each callee once, recording the primal result
+ * and the derivative with respect to the arguments in the same call. The
+ * derivative reads the output gradient from a buffer that the backward pass
+ * fills in, hence no callee is traced again at that point.
+ *
+ * This does not apply to callees that depend on instance fields with
+ * gradient tracking, whose gradients must be scattered at the time of the
+ * backward pass; these fall back to the default strategy. Forward-mode
+ * derivatives also use the default strategy, and so do graphs that are
+ * traversed more than once.
+ */
+struct VCallFuseBackwardScope {
+    VCallFuseBackwardScope(bool enable = true)
+        : m_prev(detail::vcall_fuse_backward) {
+        detail::vcall_fuse_backward = enable;
+    }
+
+    ~VCallFuseBackwardScope() { detail::vcall_fuse_backward = m_prev; }
+
+    VCallFuseBackwardScope(const VCallFuseBackwardScope &) = delete;
+    VCallFuseBackwardScope &operator=(const VCallFuseBackwardScope &) = delete;
+
+private:
+    bool m_prev;
+};
+
 template <typename Class, typename Value>
 void set_attr(Class *self, const char *name, const Value &value) {
     DRJIT_MARK_USED(self);
@@ -248,6 +675,25 @@ NAMESPACE_END(drjit)
         }                                                                      \
     }
 
+/**
+ * Like DRJIT_VCALL_METHOD, but for methods without arguments whose result only
+ * depends on the instance (e.g. flags). Each instance is called only once.
+ */
+#define DRJIT_VCALL_UNIFORM_METHOD(name)                                       \
+    auto name(const mask_t<Array> &mask = true) const {                        \
+        if constexpr (is_jit_v<Array>) {                                       \
+            using Result = typename detail::vectorize_type<                    \
+                Array, decltype(std::declval<Class *>()->name())>::type;       \
+            return detail::vcall_uniform<Class, Result>(                       \
+                [](Class *self) { return self->name(); }, array, mask);        \
+        } else {                                                               \
+            return detail::vcall<Class>(                                       \
+                #name, [](auto self)                                           \
+                    DRJIT_INLINE_LAMBDA { return self->name(); },              \
+                array & mask);                                                 \
+        }                                                                      \
+    }
+
 #define DRJIT_VCALL_BEGIN(Name)                                                \
     namespace drjit {                                                          \
         template <typename Array>                                              \
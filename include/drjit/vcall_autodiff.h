@@ -16,12 +16,40 @@
 
 #include <drjit/custom.h>
 #include <drjit/struct.h>
+#include <atomic>
 
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
 
 using ConstStr = const char *;
 
+/// Copy the output gradient 'value' into the buffer read by a fused vcall
+template <typename T>
+void vcall_write_grad(const T &target, const T &value) {
+    if constexpr (array_depth_v<T> > 1) {
+        for (size_t i = 0; i < target.derived().size(); ++i)
+            vcall_write_grad(target.derived().entry(i),
+                             value.derived().entry(i));
+    } else if constexpr (is_diff_v<T>) {
+        vcall_write_grad(target.detach_(), value.detach_());
+    } else if constexpr (is_jit_v<T>) {
+        size_t size = target.size();
+        T source = value;
+        if (!source.index())
+            source = zeros<T>(size);
+        else if (source.size() != size)
+            source = source + zeros<T>(size);
+        source.eval_();
+        jit_memcpy_async(T::Backend, (void *) target.data(), source.data(),
+                         size * sizeof(scalar_t<T>));
+    } else if constexpr (is_drjit_struct_v<T>) {
+        struct_support_t<T>::apply_2(
+            target, value, [](auto const &x1, auto const &x2) {
+                vcall_write_grad(x1, x2);
+            });
+    }
+}
+
 template <typename DiffType, typename Self, typename Result, typename Func,
           typename... Args>
 struct DiffVCall : CustomOp<DiffType, Result, ConstStr, Self, Func, Args...> {
@@ -40,17 +68,74 @@ struct DiffVCall : CustomOp<DiffType, Result, ConstStr, Self, Func, Args...> {
 
         // Perform the function call
         size_t implicit_snapshot = ad_implicit<Type>();
-        Result result = vcall_jit_record<Result>(name, func, self, args...);
+        Result result;
+        if constexpr (!std::is_same_v<Result, std::nullptr_t>) {
+            if (vcall_fuse_backward)
+                result = eval_fused(name, self, func, args...);
+            else
+                result = vcall_jit_record<Result>(name, func, self, args...);
+        } else {
+            result = vcall_jit_record<Result>(name, func, self, args...);
+        }
 
         // Capture implicit dependencies of the operation
-        m_implicit_in = dr_vector<uint32_t>(ad_implicit<Type>() - implicit_snapshot, 0);
-        ad_extract_implicit<Type>(implicit_snapshot, m_implicit_in.data());
-        for (size_t i = 0; i < m_implicit_in.size(); ++i)
-            detail::ad_inc_ref<Type>(m_implicit_in[i]);
+        dr_vector<uint32_t> implicit(ad_implicit<Type>() - implicit_snapshot, 0);
+        size_t implicit_count =
+            ad_extract_implicit<Type>(implicit_snapshot, implicit.data());
+        for (size_t i = 0; i < implicit_count; ++i)
+            m_implicit_in.push_back(implicit[i]);
+        detail::ad_inc_ref_n_impl<Type>(m_implicit_in.size(),
+                                        m_implicit_in.data());
 
         return result;
     }
 
+    /**
+     * Record the primal call together with its reverse-mode derivative. The
+     * latter reads the output gradient from 'm_fused_grad_out', a buffer that
+     * \ref backward() fills in later. Each instance is thus traced only once.
+     */
+    Result eval_fused(const ConstStr &name, const Self &self, const Func &func,
+                      const Args &... args) {
+        using Input = dr_tuple<Args...>;
+        using Fused = dr_tuple<Result, Input>;
+
+        m_fused_grad_out = zeros<Result>(width(self, args...));
+        make_opaque(m_fused_grad_out);
+        m_fused_valid = true;
+
+        std::atomic<bool> *valid = &m_fused_valid;
+        auto func_fused = [func, valid](auto *self2, auto &grad_out,
+                                        auto... args2) -> Fused {
+            ad_copy(args2...);
+            enable_grad(args2...);
+            size_t implicit_snapshot = ad_implicit<Type>();
+            Result result = func(self2, args2...);
+
+            /* Gradients of implicit dependencies (e.g. instance fields) would
+               be scattered by a side effect of the primal call, before the
+               output gradient is known. Leave these calls to backward_impl() */
+            if (ad_implicit<Type>() != implicit_snapshot) {
+                valid->store(false, std::memory_order_relaxed);
+                return Fused(result, zeros<Input>());
+            }
+
+            set_grad(result, grad_out);
+            enqueue(ADMode::Backward, result);
+            traverse<DiffType>(ADMode::Backward);
+            return Fused(result, Input(grad<false>(args2)...));
+        };
+
+        Fused fused = vcall_jit_record<Fused>(name, func_fused, self,
+                                              m_fused_grad_out, args...);
+        if (m_fused_valid)
+            m_fused_grad_in = fused.template get<1>();
+        else
+            m_fused_grad_out = Result();
+
+        return fused.template get<0>();
+    }
+
     void forward() override {
         forward_impl(std::make_index_sequence<sizeof...(Args)>());
     }
@@ -131,7 +216,24 @@ struct DiffVCall : CustomOp<DiffType, Result, ConstStr, Self, Func, Args...> {
         (Base::template set_grad_in<3 + Is>(grad_in.template get<Is>()), ...);
     }
 
+    template <size_t... Is>
+    void backward_fused(std::index_sequence<Is...>) {
+        vcall_write_grad(m_fused_grad_out, Base::grad_out());
+        (Base::template set_grad_in<3 + Is>(m_fused_grad_in.template get<Is>()), ...);
+
+        /* The recorded derivative reads 'm_fused_grad_out' lazily, hence it
+           cannot be reused by later traversals of a retained graph */
+        m_fused_valid = false;
+        m_fused_grad_in = dr_tuple<Args...>();
+    }
+
     void backward() override {
+        if constexpr (!std::is_same_v<Result, std::nullptr_t>) {
+            if (m_fused_valid) {
+                backward_fused(std::make_index_sequence<sizeof...(Args)>());
+                return;
+            }
+        }
         backward_impl(std::make_index_sequence<sizeof...(Args)>());
     }
 
@@ -140,8 +242,14 @@ struct DiffVCall : CustomOp<DiffType, Result, ConstStr, Self, Func, Args...> {
 private:
     const char *m_name_static = nullptr;
     char m_name_long[128];
+
+    // State of the fused mode (see \ref VCallFuseBackwardScope)
+    Result m_fused_grad_out;
+    dr_tuple<Args...> m_fused_grad_in;
+    std::atomic<bool> m_fused_valid { false };
 };
 
+
 inline std::pair<void *, uint32_t> vcall_registry_get(JitBackend Backend,
                                                       const char *domain);
 
@@ -78,7 +78,8 @@ template <typename T> DRJIT_INLINE auto wrap_vcall(const T &value) {
 
 template <typename Result, typename Base, typename Func, typename Self,
           typename Mask, size_t... Is, typename... Args>
-Result vcall_jit_record_impl(const char *name, uint32_t n_inst,
+Result vcall_jit_record_impl(const char *name,
+                             const VCallRegistryTable &registry,
                              const Func &func, const Self &self,
                              const Mask &mask, std::index_sequence<Is...>,
                              const Args &... args) {
@@ -86,7 +87,8 @@ Result vcall_jit_record_impl(const char *name, uint32_t n_inst,
     constexpr size_t N = sizeof...(Args);
     DRJIT_MARK_USED(N);
 
-    uint32_t scope = jit_scope(Backend);
+    uint32_t scope = jit_scope(Backend),
+             n_inst = (uint32_t) registry.size();
 
     char label[128];
 
@@ -104,15 +106,12 @@ Result vcall_jit_record_impl(const char *name, uint32_t n_inst,
 
     state[0] = jit_record_checkpoint(Backend);
 
-    uint32_t n_inst_max = jit_registry_get_max(Backend, Base::Domain);
-    for (uint32_t i = 1, j = 1; i <= n_inst_max; ++i) {
+    uint32_t j = 1;
+    for (auto [ptr, i] : registry) {
         snprintf(label, sizeof(label), "VCall: %s::%s() [instance %u]",
                  Base::Domain, name, j);
 
-        Base *base = (Base *) jit_registry_get_ptr(Backend, Base::Domain, i);
-        if (!base)
-            continue;
-
+        Base *base = (Base *) ptr;
         jit_set_scope(Backend, scope);
 
 #if defined(DRJIT_VCALL_DEBUG)
@@ -190,20 +189,44 @@ vcall_jit_record_impl_scalar(Base *inst, const Func &func, const Mask &mask,
     }
 }
 
-inline std::pair<void *, uint32_t> vcall_registry_get(JitBackend Backend,
-                                                      const char *domain) {
-    uint32_t n = jit_registry_get_max(Backend, domain), n_inst = 0;
-    void *inst = nullptr;
-
-    for (uint32_t i = 1; i <= n; ++i) {
-        void *ptr = jit_registry_get_ptr(Backend, domain, i);
-        if (ptr) {
-            inst = ptr;
-            n_inst++;
-        }
+template <typename Result, typename Base, typename Func, typename Self,
+          typename Mask, size_t... Is, typename... Args>
+Result vcall_jit_record_impl_inline(const VCallRegistryTable &registry,
+                                    const Func &func, const Self &self,
+                                    const Mask &mask, std::index_sequence<Is...>,
+                                    const Args &... args) {
+    static constexpr JitBackend Backend = backend_v<Mask>;
+    constexpr size_t N = sizeof...(Args);
+    DRJIT_MARK_USED(N);
+
+    // Evaluate every instance on all lanes, then select per lane
+    detail::JitState<Backend> jit_state;
+    Result result = zeros<Result>(width(self, args...));
+
+    for (const auto &entry : registry) {
+        Base *base = (Base *) entry.first;
+        Mask inst_mask = mask && eq(self, base);
+        jit_state.set_mask(inst_mask.index());
+
+        if constexpr (is_drjit_struct_v<Result> || is_array_v<Result>)
+            result = select(inst_mask, func(base, set_mask_true<Is, N>(args)...),
+                            result);
+        else
+            func(base, set_mask_true<Is, N>(args)...);
+
+        jit_state.clear_mask();
     }
 
-    return { inst, n_inst };
+    return result;
+}
+
+inline std::pair<void *, uint32_t> vcall_registry_get(JitBackend Backend,
+                                                      const char *domain) {
+    VCallRegistryTable registry = vcall_registry(Backend, domain);
+    if (registry.empty())
+        return { nullptr, 0 };
+    else
+        return { registry.back().first, (uint32_t) registry.size() };
 }
 
 template <typename Result, typename Func, typename Self, typename... Args>
@@ -214,7 +237,10 @@ Result vcall_jit_record(const char *name, const Func &func, Self &self,
     static constexpr JitBackend Backend = detached_t<Self>::Backend;
     using Mask = mask_t<Self>;
 
-    auto [inst, n_inst] = vcall_registry_get(Backend, Base::Domain);
+    VCallRegistryTable registry = vcall_registry(Backend, Base::Domain);
+    uint32_t n_inst = (uint32_t) registry.size();
+    void *inst = n_inst > 0 ? registry.back().first : nullptr;
+    vcall_site_instances(n_inst);
 
     size_t self_size = width(self, args...);
     Mask mask = extract_mask<Mask>(args...);
@@ -235,12 +261,20 @@ Result vcall_jit_record(const char *name, const Func &func, Self &self,
         return vcall_jit_record_impl_scalar<Result, Base>(
             (Base *) inst, func, mask && neq(self, nullptr),
             std::make_index_sequence<sizeof...(Args)>(), args...);
+    } else if (n_inst <= vcall_inline_max && vcall_inline) {
+        jit_log(::LogLevel::InfoSym,
+                "jit_var_vcall(self=r%u): call (\"%s::%s()\") inlined as a "
+                "select chain (%u instances)", self.index(), Base::Domain, name,
+                n_inst);
+        return vcall_jit_record_impl_inline<Result, Base>(
+            registry, func, self, mask,
+            std::make_index_sequence<sizeof...(Args)>(), args...);
     } else {
         isolate_grad<DiffType> guard;
         jit_new_scope(Backend);
 
         return vcall_jit_record_impl<Result, Base>(
-            name, n_inst, func, self, mask,
+            name, registry, func, self, mask,
             std::make_index_sequence<sizeof...(Args)>(),
             wrap_vcall(args)...);
     }
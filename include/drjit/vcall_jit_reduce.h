@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <nanothread/nanothread.h>
+#include <exception>
+#include <mutex>
+
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
 
@@ -33,6 +37,27 @@ DRJIT_INLINE decltype(auto) gather_helper(const T& value, const UInt32 &perm) {
     }
 }
 
+/// Reorder the entries of the permutation \c perm by the (evaluated) key \c key
+template <typename UInt32>
+UInt32 vcall_coherent_perm(const UInt32 &perm, const UInt32 &key,
+                           uint32_t key_range) {
+    static constexpr JitBackend Backend = detached_t<UInt32>::Backend;
+    uint32_t size = (uint32_t) perm.size();
+
+    uint32_t *order = (uint32_t *) jit_malloc(
+        Backend == JitBackend::CUDA ? AllocType::Device : AllocType::HostAsync,
+        size * sizeof(uint32_t));
+    uint32_t *offsets = (uint32_t *) jit_malloc(
+        Backend == JitBackend::CUDA ? AllocType::HostPinned : AllocType::Host,
+        (size_t(key_range) * 4 + 1) * sizeof(uint32_t));
+
+    jit_mkperm(Backend, key.data(), size, key_range, order, offsets);
+    jit_free(offsets);
+
+    return gather<UInt32>(
+        perm, UInt32::steal(jit_var_mem_map(Backend, VarType::UInt32, order, size, 1)));
+}
+
 template <typename Result, typename Func, typename Self, size_t... Is,
           typename... Args>
 Result vcall_jit_reduce_impl(Func func, const Self &self_,
@@ -73,8 +98,30 @@ Result vcall_jit_reduce_impl(Func func, const Self &self_,
         }
     };
 
+    struct CoherenceHelper {
+        CoherenceHelper() : value(vcall_coherence) { vcall_coherence = nullptr; }
+        ~CoherenceHelper() { vcall_coherence = value; }
+        const VCallCoherence *value;
+    };
+
+    struct ConcurrencyHelper {
+        ConcurrencyHelper() : value(vcall_concurrency) { vcall_concurrency = 0; }
+        ~ConcurrencyHelper() { vcall_concurrency = value; }
+        uint32_t value;
+    };
+
     Self self = self_ & mask;
-    auto [buckets, n_inst] = self.vcall_();
+    // Not a structured binding, since these are captured by lambdas below
+    std::pair<VCallBucket *, uint32_t> vcall_info = self.vcall_();
+    VCallBucket *buckets = vcall_info.first;
+    uint32_t n_inst = vcall_info.second;
+    vcall_site_instances(n_inst);
+
+    // Don't propagate these settings to method calls nested in the callees
+    CoherenceHelper coherence;
+    ConcurrencyHelper concurrency;
+    if (coherence.value && coherence.value->backend != Backend)
+        coherence.value = nullptr;
 
     Result result;
     SetSelfHelper self_helper;
@@ -82,38 +129,152 @@ Result vcall_jit_reduce_impl(Func func, const Self &self_,
         result = empty<Result>(self_size);
         size_t last_size = 0;
 
-        for (size_t i = 0; i < n_inst ; ++i) {
-            UInt32 perm = UInt32::borrow(buckets[i].index);
-            size_t wavefront_size = perm.size();
+        std::unique_ptr<UInt32[]> perms;
+        if (coherence.value) {
+            if (jit_var_size(coherence.value->key_index) != self_size)
+                drjit_raise("VCallCoherenceScope(): the size of the key (%u) "
+                            "does not match the size of the method call (%zu)!",
+                            jit_var_size(coherence.value->key_index), self_size);
+
+            /* Fetch the keys of all instances in one go, then sort each
+               bucket. Out-of-range keys would overflow the histogram of
+               jit_mkperm(), hence they are clamped. */
+            uint32_t key_max = coherence.value->key_range - 1;
+            UInt32 key = UInt32::borrow(coherence.value->key_index);
+            std::unique_ptr<UInt32[]> keys(new UInt32[n_inst]);
+            perms.reset(new UInt32[n_inst]);
+
+            for (size_t i = 0; i < n_inst; ++i) {
+                perms[i] = UInt32::borrow(buckets[i].index);
+                if (buckets[i].ptr && perms[i].size() > 1) {
+                    keys[i] = minimum(gather<UInt32>(key, perms[i]), key_max);
+                    keys[i].schedule_();
+                }
+            }
+            eval();
+
+            for (size_t i = 0; i < n_inst; ++i) {
+                if (keys[i].index() != 0) {
+                    perms[i] = vcall_coherent_perm(perms[i], keys[i],
+                                                   coherence.value->key_range);
+                    perms[i].schedule_();
+                }
+            }
+            keys.reset();
+            eval();
+        }
+
+        /* Invoke instance 'i' and pass its outputs along with the lane
+           permutation to 'store(perm, value)' */
+        auto trace = [&](size_t i, auto &&store, SetSelfHelper &helper) {
+            UInt32 perm = perms ? perms[i] : UInt32::borrow(buckets[i].index);
+
+#if defined(DRJIT_AUTODIFF_H)
+            // Timeline event per instance bucket, see drjit::trace_enable()
+            TraceScope trace_scope(std::remove_pointer_t<Class>::Domain,
+                                   "vcall", perm.size());
+#endif
 
             MaskScope<Mask> scope(Mask::steal(
-                jit_var_mask_default(Backend, (uint32_t) wavefront_size)));
+                jit_var_mask_default(Backend, (uint32_t) perm.size())));
 
             UInt32 instance_id = gather<UInt32>(self, perm);
 
-            // Avoid merging multiple vcall launches if size repeats..
-            if (wavefront_size != last_size)
-                last_size = wavefront_size;
-            else
-                eval(result);
-
             if (buckets[i].ptr) {
-                self_helper.set(buckets[i].id, instance_id.index());
+                helper.set(buckets[i].id, instance_id.index());
 
                 if constexpr (!std::is_same_v<Result, std::nullptr_t>) {
                     using OrigResult = decltype(func((Class) nullptr, args...));
-                    scatter<true>(
-                        result,
-                        ref_cast_t<OrigResult, Result>(func(
-                            (Class) buckets[i].ptr,
-                            gather_helper<Is, N>(args, perm)...)),
-                        perm);
+                    store(perm, ref_cast_t<OrigResult, Result>(func(
+                                    (Class) buckets[i].ptr,
+                                    gather_helper<Is, N>(args, perm)...)));
                 } else {
+                    DRJIT_MARK_USED(store);
                     func((Class) buckets[i].ptr, gather_helper<Is, N>(args, perm)...);
                 }
             } else {
                 if constexpr (!std::is_same_v<Result, std::nullptr_t>)
-                    scatter<true>(result, zeros<Result>(), perm);
+                    store(perm, zeros<Result>());
+            }
+        };
+
+        auto store_result = [&](const UInt32 &perm, const Result &value) {
+            scatter<true>(result, value, perm);
+        };
+
+        uint32_t thread_count =
+            concurrency.value < n_inst ? concurrency.value : n_inst;
+        if (is_diff_v<leaf_array_t<Result>> || thread_count < 2) {
+            for (size_t i = 0; i < n_inst ; ++i) {
+                size_t wavefront_size = perms ? perms[i].size()
+                                              : jit_var_size(buckets[i].index);
+
+                // Avoid merging multiple vcall launches if size repeats
+                if (wavefront_size != last_size)
+                    last_size = wavefront_size;
+                else
+                    eval(result);
+
+                trace(i, store_result, self_helper);
+            }
+        } else if constexpr (!is_diff_v<leaf_array_t<Result>>) {
+            /* Trace and launch the instances on the thread pool. Each worker
+               has its own CUDA stream / chain of LLVM tasks and evaluates the
+               outputs of its instances, which are subsequently scattered into
+               'result' on the calling thread. */
+            jit_sync_thread();
+
+            int32_t device = Backend == JitBackend::CUDA ? jit_cuda_device() : 0;
+            uint32_t flags = jit_flags();
+            std::unique_ptr<std::pair<UInt32, Result>[]> outputs(
+                new std::pair<UInt32, Result>[n_inst]);
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            drjit::parallel_for(
+                drjit::blocked_range<uint32_t>(
+                    0, n_inst, (n_inst + thread_count - 1) / thread_count),
+                [&](drjit::blocked_range<uint32_t> range) {
+                    try {
+                        if (Backend == JitBackend::CUDA)
+                            jit_cuda_set_device(device);
+                        if (jit_flags() != flags)
+                            jit_set_flags(flags);
+
+                        SetSelfHelper helper;
+                        for (uint32_t i : range) {
+                            trace(i, [&](const UInt32 &perm, const Result &value) {
+                                outputs[i] = { perm, value };
+                                schedule(outputs[i].second);
+                            }, helper);
+                        }
+
+                        jit_eval();
+                        jit_sync_thread();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> guard(error_mutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                }
+            );
+
+            if (error)
+                std::rethrow_exception(error);
+
+            for (size_t i = 0; i < n_inst ; ++i) {
+                const UInt32 &perm = outputs[i].first;
+                if (perm.size() == 0)
+                    continue;
+
+                if (perm.size() != last_size)
+                    last_size = perm.size();
+                else
+                    eval(result);
+
+                MaskScope<Mask> scope(Mask::steal(
+                    jit_var_mask_default(Backend, (uint32_t) perm.size())));
+                store_result(perm, outputs[i].second);
             }
         }
         schedule(result);
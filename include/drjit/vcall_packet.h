@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <vector>
+
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
 
@@ -49,7 +51,7 @@ DRJIT_INLINE Result vcall_packet(Func func, const Self &self, const Args&... arg
             Class instance         = extract(self, mask);
             Mask active            = mask & eq(self, instance);
             mask                   = andnot(mask, active);
-            masked(result, active) = func(instance, replace_mask(args, active)...);
+            drjit::masked(result, active) = func(instance, replace_mask(args, active)...);
         }
         return result;
     } else {
@@ -63,4 +65,130 @@ DRJIT_INLINE Result vcall_packet(Func func, const Self &self, const Args&... arg
 }
 
 NAMESPACE_END(detail)
+
+/**
+ * \brief Batched method call over many packets' worth of instance pointers
+ *
+ * \ref vcall_packet() invokes the callee once per unique instance within each
+ * packet, which means that a divergent packet of size N triggers up to N
+ * calls. This function instead takes a large array of \c size instance
+ * pointers (e.g. the contents of many packets), groups its entries by
+ * instance like the bucketing step of the JIT backends, and then invokes
+ *
+ *     func(instance, index, active)
+ *
+ * on dense packets of lane indices (of type \c UInt32P) that all refer to
+ * the same instance. The callee is responsible for gathering its inputs and
+ * scattering its outputs via \c index. Inactive entries of \c index (only
+ * found in the last packet of each instance) hold valid but unrelated lane
+ * indices. Entries equal to \c nullptr are skipped.
+ *
+ * Grouping and the indirect loads/stores add a fixed cost per entry, hence
+ * this only pays off when the packets are divergent and the callee isn't
+ * trivial.
+ */
+template <typename UInt32P, typename Ptr, typename Func>
+void vcall_batched(const Ptr *self, size_t size, Func &&func) {
+    static_assert(std::is_pointer_v<Ptr> && is_static_array_v<UInt32P> &&
+                      std::is_same_v<scalar_t<UInt32P>, uint32_t>,
+                  "vcall_batched(): expected an array of pointers and a "
+                  "32 bit unsigned index packet type!");
+    using Mask = mask_t<UInt32P>;
+    constexpr size_t Size = UInt32P::Size;
+    constexpr uint32_t Invalid = (uint32_t) -1;
+
+    if (size >= (size_t) Invalid)
+        drjit_raise("vcall_batched(): too many entries!");
+
+    /* 1. Assign a bucket to each entry using an open addressing hash table
+          (consecutive entries often refer to the same instance) */
+    std::vector<Ptr> instances, table(64, nullptr);
+    std::vector<uint32_t> offsets, table_id(64);
+    uint32_t shift = 64 - 6;
+
+    /* Per-entry bucket IDs, followed by the permutation. Reused across calls,
+       since the page faults of a fresh allocation dominate otherwise */
+    static thread_local std::vector<uint32_t> scratch;
+    if (scratch.size() < 2 * size + Size)
+        scratch.resize(2 * size + Size);
+    uint32_t *bucket = scratch.data();
+
+    auto slot = [&](Ptr ptr) {
+        size_t mask = table.size() - 1,
+               i = (size_t) (((uint64_t) (uintptr_t) ptr *
+                              0x9E3779B97F4A7C15ull) >> shift);
+        while (table[i] && table[i] != ptr)
+            i = (i + 1) & mask;
+        return i;
+    };
+
+    Ptr prev_ptr = nullptr;
+    uint32_t prev_id = Invalid;
+    for (size_t i = 0; i < size; ++i) {
+        Ptr ptr = self[i];
+        if (ptr != prev_ptr) {
+            prev_ptr = ptr;
+            prev_id = Invalid;
+
+            if (ptr) {
+                size_t j = slot(ptr);
+                if (!table[j]) {
+                    table[j] = ptr;
+                    table_id[j] = (uint32_t) instances.size();
+                    instances.push_back(ptr);
+                    offsets.push_back(0);
+
+                    // Keep the load factor below 1/2
+                    if (instances.size() * 2 > table.size()) {
+                        table.assign(table.size() * 2, nullptr);
+                        table_id.resize(table.size());
+                        shift--;
+                        for (uint32_t k = 0; k < (uint32_t) instances.size(); ++k) {
+                            size_t l = slot(instances[k]);
+                            table[l] = instances[k];
+                            table_id[l] = k;
+                        }
+                        j = slot(ptr);
+                    }
+                }
+                prev_id = table_id[j];
+            }
+        }
+
+        bucket[i] = prev_id;
+        if (prev_id != Invalid)
+            offsets[prev_id]++;
+    }
+
+    // 2. Counting sort of the entries by bucket
+    uint32_t sum = 0;
+    for (uint32_t &o : offsets) {
+        uint32_t count = o;
+        o = sum;
+        sum += count;
+    }
+    offsets.push_back(sum);
+
+    // Padding, so that the last packet of each bucket can use a full load
+    uint32_t *perm = bucket + size;
+    for (size_t i = 0; i < Size; ++i)
+        perm[sum + i] = 0;
+    {
+        std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+        for (size_t i = 0; i < size; ++i) {
+            if (bucket[i] != Invalid)
+                perm[cursor[bucket[i]]++] = (uint32_t) i;
+        }
+    }
+
+    // 3. Invoke the callee on dense packets of each instance
+    for (size_t j = 0; j < instances.size(); ++j) {
+        for (uint32_t o = offsets[j]; o < offsets[j + 1]; o += (uint32_t) Size) {
+            UInt32P index = load<UInt32P>(perm + o);
+            Mask active = arange<UInt32P>() < (offsets[j + 1] - o);
+            func(instances[j], index, active);
+        }
+    }
+}
+
 NAMESPACE_END(drjit)
@@ -10,12 +10,13 @@
  *
  * Forward and reverse-mode traversal build on three main data structures:
  *
- * - 'state.variable': A hash table mapping from variable IDs (uint32_t) to
- *   'Variable' instances, which mainly stores the gradient associated with
- *   each variable, as well as links into the 'state.edges' list for
- *   connectivity.
+ * - 'state().shards': A set of hash tables mapping from variable IDs (uint32_t)
+ *   to 'Variable' instances, which mainly stores the gradient associated with
+ *   each variable, as well as links into the 'state().edges' list for
+ *   connectivity. Each shard has its own lock so that reference counting
+ *   does not need to acquire the global lock protecting the graph.
  *
- * - 'state.edges': An interlinked array storing edges that provide
+ * - 'state().edges': An interlinked array storing edges that provide
  *   connectivity between the variables. Each edge can be simple or special---a
  *   simple edge records an edge weight that is used to scale gradients passing
  *   along it. A special edge implements some more complex gradient
@@ -24,7 +25,8 @@
  *
  * - 'local_state.todo': List of edges that should be traversed by the next
  *   call to 'ad_traverse()'. This list is thread-local in contrast to the
- *   previous two data structures that are shared by all threads.
+ *   previous two data structures that are shared by all threads (unless a
+ *   thread switched to a private graph via 'ad_isolated_graph_enter()').
  *
  * To understand how everything fits together, start by looking at 'ad_new()'
  * and 'ad_traverse()': Arithmetic involving differentiable Dr.Jit arrays
@@ -61,8 +63,13 @@
 #include <tsl/robin_set.h>
 #include <assert.h>
 #include <mutex>
+#include <atomic>
 #include <xxh3.h>
 
+#if defined(DRJIT_ENABLE_JIT)
+#  include <nanothread/nanothread.h>
+#endif
+
 NAMESPACE_BEGIN(drjit)
 NAMESPACE_BEGIN(detail)
 
@@ -83,6 +90,15 @@ NAMESPACE_BEGIN(detail)
 #define Edge                 RENAME(Edge)
 #define Variable             RENAME(Variable)
 #define State                RENAME(State)
+#define VariableShard        RENAME(VariableShard)
+#define StateMutex           RENAME(StateMutex)
+#define GraphSwitch          RENAME(GraphSwitch)
+#define LocalState           RENAME(LocalState)
+#define VariableSlab         RENAME(VariableSlab)
+#define SpecialPool          RENAME(SpecialPool)
+#define SpecialPoolRelease   RENAME(SpecialPoolRelease)
+#define SparseGrad           RENAME(SparseGrad)
+#define HessianTerms         RENAME(HessianTerms)
 #define ReleaseQueueHelper   RENAME(ReleaseQueueHelper)
 #define ReleaseOperandHelper RENAME(ReleaseOperandHelper)
 
@@ -107,10 +123,20 @@ template <typename T> bool is_valid(const T &value) {
         return true;
 }
 
+/// Add an event to the timeline when tracing is enabled, see trace_enable()
+static void ad_trace_event(const char *name, uint64_t start, uint64_t end,
+                           uint64_t arg = (uint64_t) -1) {
+    if (unlikely(trace_active.load(std::memory_order_relaxed)))
+        trace_record(name, "ad", start, end, arg);
+}
+
 // ==========================================================================
 // Central data structures: edges, variables, global state
 // ==========================================================================
 
+/// Compact encoding of literal edge weights (see \ref Edge::unit)
+enum EdgeUnit : uint32_t { UnitNone = 0, UnitPlus = 1, UnitMinus = 2 };
+
 /**
  * Represents an edge in the AD graph that futhermore stores either
  *
@@ -120,6 +146,11 @@ template <typename T> bool is_valid(const T &value) {
  *    some more advanced way of transforming gradients between source/target
  *    variable. Masking and scatter/gather operations, e.g., require this.
  *
+ * 3. Neither: edges with a literal weight of +1 or -1 (very common, e.g. due
+ *    to additions and subtractions) only record this fact in 'unit'. This
+ *    avoids holding a reference to a JIT literal for every such edge and
+ *    replaces the multiplication by a plain accumulation during traversal.
+ *
  * Instead of storing an explicit adjacency list of the AD graph structure, the
  * adjacency information is directly encoded in the edges. In particular, the
  * 'next_fwd' and 'next_bwd' indices each implement a singly linked list that
@@ -137,15 +168,18 @@ struct Edge {
     uint32_t next_fwd;
 
     /// Links to the next backward edge
-    uint32_t next_bwd : 31;
+    uint32_t next_bwd : 29;
 
     /// Visited bit
     uint32_t visited : 1;
 
+    /// Literal weight that is not stored in 'weight' (an \ref EdgeUnit value)
+    uint32_t unit : 2;
+
     /// Pointer to a handler for "special" edges
     Special *special;
 
-    /// Weight value (zero/empty for "special" edges)
+    /// Weight value (zero/empty for "special" and "unit" edges)
     Value weight{};
 
     DRJIT_ARRAY_DEFAULTS(Edge);
@@ -191,8 +225,28 @@ struct Variable {
     /// Descriptive label or nullptr
     char *label;
 
-    /// High bits of variable index (unused atm.)
-    uint32_t index_hi : 16;
+    /**
+     * Number of references held by outgoing edges and by the traversal queue.
+     * Saturates at 'RefCountIntMax', after which the variable is always
+     * considered observable by ad_prune_bwd().
+     */
+    uint32_t ref_count_int : 10;
+
+    /// Is this a select() node at the iteration boundary of a wavefront loop?
+    uint32_t loop_boundary : 1;
+
+    /// Are second-order terms recorded in 'State::hessians'?
+    uint32_t hessian : 1;
+
+    /// Temporary flags used by ad_prune_bwd()
+    uint32_t prune_done : 1;
+    uint32_t prune_keep : 1;
+
+    /// Are there deferred gradient contributions in 'State::pending'?
+    uint32_t pending_grad : 1;
+
+    /// Are gather() gradients recorded sparsely? (see \ref SparseGrad)
+    uint32_t sparse_grad : 1;
 
     /// Gradient reference count for custom operations
     uint32_t ref_count_grad : 13;
@@ -291,25 +345,7 @@ struct Variable {
            v1 == 0 implies v1 * v2 == 0, even if multiplication by
            v2 would produce a NaN (e.g. if v2 is infinite or NaN). */
 
-        T z = 0.f, v2;
-
-        if constexpr (is_jit_v<T>) {
-            if (v2_.is_literal() && std::isnormal(v2_[0]) &&
-                jit_flag(JitFlag::ADOptimize)) {
-                /* The check can be elided if the edge weight is a normal
-                   literal constant. This can save significant amounts of
-                   unnecessary eq() and select() operations in generated IR */
-                v2 = v2_;
-            } else {
-                /* Only use this if absolutely necessary (also because it
-                   triggers a forced evaluation in case any of the input
-                   variables have pending scatter operations) */
-                v2 = select(eq(v1, z), z, v2_);
-            }
-        } else {
-            // Scalar case
-            v2 = select(eq(v1, z), z, v2_);
-        }
+        T v2 = guard_weight(v1, v2_);
 
         if constexpr (is_array_v<T>) {
             bool grad_valid = is_valid(grad);
@@ -344,22 +380,379 @@ struct Variable {
         }
     }
 
+    /// Mask the weight 'v2_' so that v1 == 0 implies v1 * v2 == 0
+    template <typename T = Value>
+    static T guard_weight(const T &v1, const T &v2_) {
+        T z = 0.f;
+
+        if constexpr (is_jit_v<T>) {
+            if (v2_.is_literal() && std::isnormal(v2_[0]) &&
+                jit_flag(JitFlag::ADOptimize)) {
+                /* The check can be elided if the edge weight is a normal
+                   literal constant. This can save significant amounts of
+                   unnecessary eq() and select() operations in generated IR */
+                return v2_;
+            } else {
+                /* Only use this if absolutely necessary (also because it
+                   triggers a forced evaluation in case any of the input
+                   variables have pending scatter operations) */
+                return select(eq(v1, z), z, v2_);
+            }
+        } else {
+            // Scalar case
+            return select(eq(v1, z), z, v2_);
+        }
+    }
+
+    /**
+     * \brief Return the term that \ref edge_accum() would add to the gradient
+     * of this variable, already reduced to a single value if necessary
+     */
+    Value edge_term(const Value &v1, const Edge &edge, uint32_t src_size) const {
+        Value t;
+        if (edge.unit == UnitPlus)
+            t = v1;
+        else if (edge.unit == UnitMinus)
+            t = -v1;
+        else
+            t = v1 * guard_weight(v1, edge.weight);
+
+        if constexpr (is_array_v<Value>) {
+            if (size == 1 && src_size != 1) {
+                if (width(t) == 1)
+                    t *= scalar_t<Value>(src_size);
+                else
+                    t = sum(t);
+            }
+        }
+
+        return t;
+    }
+
+    /// Accumulate a gradient 'v1' scaled by the weight of a non-special edge
+    void edge_accum(const Value &v1, const Edge &edge, uint32_t src_size) {
+        if (edge.unit == UnitPlus)
+            accum(v1, src_size);
+        else if (edge.unit == UnitMinus)
+            accum(-v1, src_size);
+        else
+            mul_accum(v1, edge.weight, src_size);
+    }
+
     bool is_scalar() const { return size == 1; }
 
     DRJIT_ARRAY_DEFAULTS(Variable);
 };
 
-/// Records the (global) state of the AD graph
-struct State {
-    using VariableMap = tsl::robin_map<uint32_t, Variable, UInt32Hasher,
-                                       std::equal_to<uint32_t>>;
-    using EdgeVector  = std::vector<Edge>;
+#if defined(DRJIT_AD_DENSE_STORAGE)
+/**
+ * \brief Dense, index-addressed storage for AD variables
+ *
+ * Variable IDs are produced by a monotonically increasing counter, hence the
+ * set of live variables usually occupies a contiguous range of IDs. This data
+ * structure stores them in fixed-size pages that are addressed via a
+ * two-level directory (similar to a page table), so that a lookup costs a few
+ * pointer chases instead of a hash table probe. IDs are not reused (the
+ * traversal relies on them being topologically ordered).
+ *
+ * A page only holds the occupancy masks of its 4096 slots and the pointers to
+ * their storage, which is allocated in chunks of 64 variables (one word of
+ * the occupancy mask). Chunks are released once all of their variables have
+ * been removed, and pages once all of their chunks are gone. A long-lived
+ * variable therefore only keeps its own chunk alive instead of the storage of
+ * the whole page. Variables never move, so that pointers to them remain valid
+ * until they are removed.
+ *
+ * Insertion and removal must happen while holding 'State::mutex'. Lookups of
+ * variables that are known to exist may proceed concurrently.
+ */
+struct VariableSlab {
+    static constexpr uint32_t PageBits  = 12, PageSize  = 1u << PageBits,
+                              ChunkBits = 6,  ChunkSize = 1u << ChunkBits,
+                              DirBits   = 10, DirSize   = 1u << DirBits,
+                              RootSize  = 1u << (32 - PageBits - DirBits),
+                              ChunkCount = PageSize / ChunkSize;
+
+    /// Maximum number of unused chunks that are kept around for reuse
+    static constexpr size_t MaxUnusedChunks = 256;
+
+    struct Chunk {
+        /// Storage for the variables
+        alignas(Variable) char storage[ChunkSize * sizeof(Variable)];
+
+        Variable *get(uint32_t slot) { return (Variable *) storage + slot; }
+    };
+
+    static_assert(ChunkSize == 64, "The occupancy mask of a chunk must be a word");
+
+    struct Page {
+        /// Occupancy bit mask (one word per chunk)
+        std::atomic<uint64_t> used[ChunkCount];
+
+        /// Storage of the chunks that contain live variables
+        Chunk *chunks[ChunkCount];
+
+        /// Number of allocated chunks in this page
+        uint32_t live;
+
+        Variable *get(uint32_t slot) {
+            return chunks[slot >> ChunkBits]->get(slot & (ChunkSize - 1));
+        }
+    };
+
+    struct Directory {
+        Page *pages[DirSize];
+    };
+
+    VariableSlab() : root() { }
+
+    ~VariableSlab() {
+        for (Directory *dir : root) {
+            if (!dir)
+                continue;
+            for (Page *page : dir->pages) {
+                if (!page)
+                    continue;
+                for (uint32_t i = 0; i < ChunkCount; ++i) {
+                    uint64_t used = page->used[i].load(std::memory_order_relaxed);
+                    while (used) {
+                        page->chunks[i]->get((uint32_t) tzcnt_(used))->~Variable();
+                        used &= used - 1;
+                    }
+                    delete page->chunks[i];
+                }
+                delete page;
+            }
+            delete dir;
+        }
+        for (Chunk *chunk : unused_chunks)
+            delete chunk;
+    }
+
+    /// Look up a variable, returns \c nullptr if it does not exist
+    Variable *find(uint32_t index) const {
+        const Directory *dir = root[index >> (PageBits + DirBits)];
+        if (!dir)
+            return nullptr;
+        Page *page = dir->pages[(index >> PageBits) & (DirSize - 1)];
+        if (!page)
+            return nullptr;
+        uint32_t slot = index & (PageSize - 1);
+        if (!(page->used[slot >> ChunkBits].load(std::memory_order_relaxed) &
+              (1ull << (slot & (ChunkSize - 1)))))
+            return nullptr;
+        return page->get(slot);
+    }
+
+    /// Create a variable, returns \c nullptr if the ID is already in use
+    template <typename... Args>
+    Variable *insert(uint32_t index, Args&&... args) {
+        Directory *&dir = root[index >> (PageBits + DirBits)];
+        if (!dir)
+            dir = new Directory();
+
+        Page *&page = dir->pages[(index >> PageBits) & (DirSize - 1)];
+        if (!page) {
+            page = new Page();
+            page_count++;
+        }
+
+        uint32_t slot = index & (PageSize - 1);
+        uint64_t bit = 1ull << (slot & (ChunkSize - 1));
+        std::atomic<uint64_t> &used = page->used[slot >> ChunkBits];
+        if (used.load(std::memory_order_relaxed) & bit)
+            return nullptr;
+
+        Chunk *&chunk = page->chunks[slot >> ChunkBits];
+        if (!chunk) {
+            if (!unused_chunks.empty()) {
+                chunk = unused_chunks.back();
+                unused_chunks.pop_back();
+            } else {
+                chunk = new Chunk();
+            }
+            page->live++;
+            chunk_count++;
+        }
+
+        Variable *v = new (page->get(slot)) Variable(std::forward<Args>(args)...);
+        used.fetch_or(bit, std::memory_order_relaxed);
+        return v;
+    }
+
+    /// Remove a variable
+    void erase(uint32_t index) {
+        Directory *dir = root[index >> (PageBits + DirBits)];
+        Page *&page = dir->pages[(index >> PageBits) & (DirSize - 1)];
+        uint32_t slot = index & (PageSize - 1);
+
+        uint64_t used = page->used[slot >> ChunkBits].fetch_and(
+            ~(1ull << (slot & (ChunkSize - 1))), std::memory_order_relaxed);
+        page->get(slot)->~Variable();
+
+        if (used != (1ull << (slot & (ChunkSize - 1))))
+            return;
+
+        // This was the last variable of its chunk
+        Chunk *&chunk = page->chunks[slot >> ChunkBits];
+        if (unused_chunks.size() < MaxUnusedChunks)
+            unused_chunks.push_back(chunk);
+        else
+            delete chunk;
+        chunk = nullptr;
+        chunk_count--;
+
+        if (--page->live == 0) {
+            delete page;
+            page = nullptr;
+            page_count--;
+        }
+    }
+
+    /// Invoke 'func(index, variable)' for each variable in increasing order
+    template <typename Func> void for_each(Func &&func) {
+        for (uint32_t i = 0; i < RootSize; ++i) {
+            Directory *dir = root[i];
+            if (!dir)
+                continue;
+            for (uint32_t j = 0; j < DirSize; ++j) {
+                Page *page = dir->pages[j];
+                if (!page)
+                    continue;
+                uint32_t base = (i << (PageBits + DirBits)) | (j << PageBits);
+                for (uint32_t k = 0; k < ChunkCount; ++k) {
+                    uint64_t used = page->used[k].load(std::memory_order_relaxed);
+                    while (used) {
+                        uint32_t slot = (uint32_t) tzcnt_(used);
+                        func(base + (k << ChunkBits) + slot,
+                             *page->chunks[k]->get(slot));
+                        used &= used - 1;
+                    }
+                }
+            }
+        }
+    }
+
+    /// Approximate memory usage in bytes
+    size_t memory_usage() const {
+        size_t result = sizeof(VariableSlab) + page_count * sizeof(Page) +
+                        (chunk_count + unused_chunks.size()) * sizeof(Chunk);
+        for (const Directory *dir : root)
+            result += dir ? sizeof(Directory) : 0;
+        return result;
+    }
+
+    Directory *root[RootSize];
+    std::vector<Chunk *> unused_chunks;
+    size_t page_count = 0, chunk_count = 0;
+};
+#endif
 
-    /// std::mutex protecting the state data structure
+/**
+ * Mutex guarding the AD data structures. Private graphs created via
+ * 'ad_isolated_graph_enter()' are only accessed by a single thread and
+ * disable it, which turns locking into a no-op.
+ */
+struct StateMutex {
     std::mutex mutex;
+    bool enabled = true;
+
+    bool try_lock() { return !enabled || mutex.try_lock(); }
+    void lock() { if (enabled) mutex.lock(); }
+    void unlock() { if (enabled) mutex.unlock(); }
+};
+
+/**
+ * Subset of the AD variables that is protected by its own mutex. Reference
+ * count updates only need to acquire the lock of the shard containing the
+ * variable, which allows multiple threads to create and release variables
+ * without serializing on the global 'State::mutex'. With the dense storage
+ * mode, the shard only serves as a lock stripe.
+ */
+struct VariableShard {
+    /// Mutex protecting the variable map *and* reference counts
+    StateMutex mutex;
+
+#if !defined(DRJIT_AD_DENSE_STORAGE)
+    using VariableMap = tsl::robin_map<uint32_t, Variable, UInt32Hasher,
+                                       std::equal_to<uint32_t>>;
 
     /// Hash table mapping variable IDs to variable instances
     VariableMap variables;
+#endif
+};
+
+/**
+ * Sparse gradient of a variable with the 'sparse_grad' bit set
+ *
+ * The reverse-mode derivative of a gather() normally scatters into a dense
+ * zero-initialized gradient having the size of the source array, which is
+ * wasteful when a large buffer (e.g. an embedding table) is only accessed at
+ * a few locations. Variables marked via 'ad_set_grad_sparse()' instead
+ * record pairs of (row indices, gradient values) here. The list is converted
+ * into a dense gradient on demand and can also be queried directly via
+ * 'ad_grad_sparse()', e.g., to only update the affected rows of a parameter.
+ */
+struct SparseGrad {
+    std::vector<std::pair<Index, Value>> chunks;
+};
+
+/**
+ * Second-order terms of an operation, recorded for Hessian-vector products
+ *
+ * While \ref ad_set_record_hessian() is active, differentiable operations
+ * store the upper triangle of their local Hessian (i.e. the second
+ * derivatives with respect to the operands, row by row) in addition to the
+ * edge weights. 'ad_hvp()' combines these terms with the tangents of the
+ * operands to obtain the directional derivative of each edge weight
+ * ('dweight'), which is all that is needed to differentiate the reverse-mode
+ * traversal in forward mode.
+ */
+struct HessianTerms {
+    /// Operands of the operation (zero if not attached to the AD graph)
+    uint32_t sources[3];
+
+    /// Number of operands
+    uint32_t size;
+
+    /// Upper triangle of the local Hessian
+    Value terms[6];
+
+    /// Directional derivative of the edge weights (computed by ad_hvp())
+    Value dweight[3];
+};
+
+/// 'HessianTerms::size' of operations lacking second-order terms (e.g. prod())
+static constexpr uint32_t HessianUnavailable = 0;
+
+/**
+ * \brief Records the (global) state of the AD graph
+ *
+ * Locking works as follows: modifications of the graph connectivity (edges,
+ * gradients, creation and removal of variables) require 'State::mutex'.
+ * Reference count changes and lookups additionally or exclusively acquire
+ * the lock of the shard storing the variable. When both are needed, the
+ * global lock must be acquired first.
+ */
+struct State {
+    using EdgeVector  = std::vector<Edge>;
+
+    /// Number of variable shards (must be a power of two)
+    static constexpr uint32_t ShardCount = 64;
+
+    /// Mutex protecting the graph connectivity
+    StateMutex mutex;
+
+    /// Reference count locks, and variable storage (in hash table mode)
+    VariableShard shards[ShardCount];
+
+#if defined(DRJIT_AD_DENSE_STORAGE)
+    /// Variable storage (dense mode)
+    VariableSlab variables;
+#endif
+
+    /// Total number of variables (across shards)
+    std::atomic<size_t> variable_count{0};
 
     /// List of all edges (used and unused ones)
     EdgeVector edges;
@@ -367,25 +760,60 @@ struct State {
     /// List of currently unused edges
     std::vector<uint32_t> unused_edges;
 
-    /// Counter for variable indices
-    uint32_t variable_index = 1;
+    /**
+     * Counter for variable indices, which wraps around within the range
+     * [index_begin, index_end). The global graph uses the lower half of the
+     * index space, and private graphs (see 'ad_isolated_graph_enter()') own
+     * disjoint slices of the upper half, which identifies the graph that a
+     * variable belongs to.
+     */
+    uint32_t variable_index = 1, index_begin = 1, index_end = 0x80000000u;
+
+    /**
+     * Thread owning this private graph. This is \c nullptr for the global
+     * graph, and for private graphs whose thread exited while some of their
+     * variables were still alive (see 'ad_isolated_graph_orphan()').
+     */
+    std::atomic<const void *> owner { nullptr };
+
+    /// Generation of the private graph, encoded in bits 20..23 of its indices
+    uint32_t generation = 0;
+
+    /**
+     * Reference count changes that other threads requested for variables of
+     * this private graph. Its locks are disabled, hence the owner applies
+     * them later (see 'ad_apply_foreign_refs()').
+     */
+    std::mutex foreign_mutex;
+    std::vector<uint32_t> foreign_inc, foreign_dec;
+    std::atomic<bool> foreign_pending { false };
+
+    /// Sparse gradients of variables with the 'sparse_grad' bit set
+    tsl::robin_map<uint32_t, SparseGrad, UInt32Hasher> sparse_grads;
+
+    /// Deferred gradient contributions of variables with the 'pending_grad' bit
+    tsl::robin_map<uint32_t, std::vector<Value>, UInt32Hasher> pending;
+
+    /// Second-order terms of variables with the 'hessian' bit
+    tsl::robin_map<uint32_t, HessianTerms, UInt32Hasher> hessians;
 
     State() : edges(1) { }
 
     ~State() {
-        if (!variables.empty()) {
+        size_t count = variable_count.load();
+        if (count != 0) {
             ad_log(Warn,
                    "drjit-autodiff: variable leak detected (%zu variables "
-                   "remain in use)!", variables.size());
+                   "remain in use)!", count);
             uint32_t counter = 0;
-            for (auto kv : variables) {
-                ad_log(Warn, " - variable a%u (%u references)", kv.first,
-                       kv.second.ref_count);
-                if (++counter == 10) {
+            for_each([&](uint32_t index, const Variable &v) {
+                if (counter < 10)
+                    ad_log(Warn, " - variable a%u (%u references)", index,
+                           v.ref_count);
+                else if (counter == 10)
                     ad_log(Warn, " - (skipping the rest)");
-                    break;
-                }
-            }
+                counter++;
+            });
         }
 
         size_t edges_used = edges.size() - unused_edges.size() - 1;
@@ -395,11 +823,82 @@ struct State {
                    "remain in use)!", edges_used);
     }
 
-    Variable *operator[](uint32_t index) {
+    /// Return the shard responsible for the given variable index
+    VariableShard &shard(uint32_t index) {
+        return shards[index & (ShardCount - 1)];
+    }
+
+    /// Look up a variable, returns \c nullptr if it does not exist
+    Variable *find(uint32_t index) {
+#if defined(DRJIT_AD_DENSE_STORAGE)
+        return variables.find(index);
+#else
+        VariableShard::VariableMap &variables = shard(index).variables;
         auto it = variables.find(index);
-        if (unlikely(index == 0 || it == variables.end()))
-            ad_fail("referenced an unknown variable a%u!", index);
+        if (it == variables.end())
+            return nullptr;
         return &it.value();
+#endif
+    }
+
+    /**
+     * \brief Create a new variable, returns \c nullptr if the ID is taken
+     *
+     * The caller must hold 'State::mutex'.
+     */
+    template <typename... Args>
+    Variable *insert(uint32_t index, Args&&... args) {
+        lock_guard<StateMutex> guard(shard(index).mutex);
+#if defined(DRJIT_AD_DENSE_STORAGE)
+        Variable *v = variables.insert(index, std::forward<Args>(args)...);
+#else
+        auto result = shard(index).variables.try_emplace(
+            index, std::forward<Args>(args)...);
+        Variable *v = result.second ? &result.first.value() : nullptr;
+#endif
+        if (likely(v))
+            variable_count++;
+        return v;
+    }
+
+    /// Remove a variable (the caller must hold 'State::mutex')
+    void erase(uint32_t index) {
+        lock_guard<StateMutex> guard(shard(index).mutex);
+#if defined(DRJIT_AD_DENSE_STORAGE)
+        variables.erase(index);
+#else
+        shard(index).variables.erase(index);
+#endif
+        variable_count--;
+    }
+
+    /// Invoke 'func(index, variable)' for each variable in unspecified order
+    template <typename Func> void for_each(Func &&func) {
+#if defined(DRJIT_AD_DENSE_STORAGE)
+        variables.for_each(func);
+#else
+        for (VariableShard &shard : shards)
+            for (auto &kv : shard.variables)
+                func(kv.first, kv.second);
+#endif
+    }
+
+    /// Return a sorted list of all variable indices
+    std::vector<uint32_t> indices() {
+        std::vector<uint32_t> result;
+        result.reserve(variable_count.load());
+        for_each([&](uint32_t index, const Variable &) {
+            result.push_back(index);
+        });
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    Variable *operator[](uint32_t index) {
+        Variable *v = index ? find(index) : nullptr;
+        if (unlikely(!v))
+            ad_fail("referenced an unknown variable a%u!", index);
+        return v;
     }
 };
 
@@ -491,7 +990,101 @@ struct Scope {
 };
 
 // Special edge (scatter, gather, scatter_reduce, block_sum, etc.)
+/**
+ * \brief Thread-local free lists for the storage of 'Special' edge handlers
+ *
+ * Gathers, scatters, masked operations and custom operations allocate a
+ * 'Special' instance per edge, which is released again when the edge is
+ * traversed or garbage collected. To avoid the associated malloc()/free()
+ * traffic, released blocks are cached in per-size-class free lists and reused
+ * by later allocations on the same thread.
+ *
+ * The data structure is trivially destructible so that it remains usable
+ * while other thread-local objects are destroyed. A separate helper
+ * ('SpecialPoolRelease') returns the cached blocks to the system at thread
+ * exit, after which the pool forwards to malloc()/free().
+ */
+struct SpecialPool {
+    static constexpr size_t Granularity = 16, ClassCount = 16,
+                            MaxCached = 4096;
+
+    /// Singly linked list of cached blocks per size class
+    void *head[ClassCount];
+
+    /// Number of cached blocks per size class
+    uint32_t count[ClassCount];
+
+    /// Set once the cached blocks were released at thread exit
+    bool released;
+
+    static void *alloc(size_t size);
+    static void release(void *ptr, size_t size);
+};
+
+struct SpecialPoolRelease {
+    ~SpecialPoolRelease();
+};
+
+static thread_local SpecialPool special_pool;
+static thread_local SpecialPoolRelease special_pool_release;
+
+void *SpecialPool::alloc(size_t size) {
+    size_t cls = (size + Granularity - 1) / Granularity;
+    SpecialPool &pool = special_pool;
+
+    if (likely(cls < ClassCount && !pool.released)) {
+        // Ensure that the cached blocks are released at thread exit
+        (void) &special_pool_release;
+
+        void *ptr = pool.head[cls];
+        if (likely(ptr)) {
+            pool.head[cls] = *(void **) ptr;
+            pool.count[cls]--;
+            return ptr;
+        }
+
+        size = cls * Granularity;
+    }
+
+    return malloc_check(size);
+}
+
+void SpecialPool::release(void *ptr, size_t size) {
+    size_t cls = (size + Granularity - 1) / Granularity;
+    SpecialPool &pool = special_pool;
+
+    if (likely(cls < ClassCount && !pool.released &&
+               pool.count[cls] < MaxCached)) {
+        *(void **) ptr = pool.head[cls];
+        pool.head[cls] = ptr;
+        pool.count[cls]++;
+    } else {
+        free(ptr);
+    }
+}
+
+SpecialPoolRelease::~SpecialPoolRelease() {
+    SpecialPool &pool = special_pool;
+    for (size_t i = 0; i < SpecialPool::ClassCount; ++i) {
+        void *ptr = pool.head[i];
+        while (ptr) {
+            void *next = *(void **) ptr;
+            free(ptr);
+            ptr = next;
+        }
+        pool.head[i] = nullptr;
+        pool.count[i] = 0;
+    }
+    pool.released = true;
+}
+
 struct Special {
+    static void *operator new(size_t size) { return SpecialPool::alloc(size); }
+
+    static void operator delete(void *ptr, size_t size) {
+        SpecialPool::release(ptr, size);
+    }
+
     virtual void backward(Variable * /* source */,
                           const Variable * /* target */,
                           uint32_t /* flags */) const {
@@ -503,6 +1096,12 @@ struct Special {
         ad_fail("Special::forward(): not implemented!");
     }
 
+    /// Does the edge only access the gradients of its source and target?
+    virtual bool local() const { return true; }
+
+    /// Is the edge linear in its primal inputs? (required by ad_hvp())
+    virtual bool linear() const { return true; }
+
     virtual ~Special() = default;
 };
 
@@ -514,21 +1113,42 @@ struct LocalState {
     /// Keeps track of implicit input dependencies of recorded computation
     std::vector<EdgeRef> implicit;
 
+    /**
+     * Sources pinned by ad_enqueue_implicit(), each group followed by its
+     * size. Popped by the matching call to ad_dequeue_implicit().
+     */
+    std::vector<uint32_t> implicit_pinned;
+
+    /// Temporary storage used to deduplicate implicit dependencies
+    IndexSet implicit_seen;
+
     /// Nested scopes that restrict AD to specific variables
     std::vector<Scope> scopes;
 
     /// List of special edges that should be cleaned up
     std::vector<Special *> cleanup;
 
-    ~LocalState() {
-        for (Special *s : cleanup)
-            delete s;
+    /**
+     * Edge list of the last traversal that retained the graph, before
+     * ('schedule_in') and after sorting ('schedule'). Repeated traversals of
+     * the same graph (e.g. with different gradient seeds) reuse the latter.
+     */
+    std::vector<EdgeRef> schedule_in, schedule;
+    ADMode schedule_mode = ADMode::Primal;
 
-        if (!scopes.empty())
-            ad_log(Warn,
-                   "drjit-autodiff: scope leak detected (%zu scopes "
-                   "remain in use)!", scopes.size());
-    }
+    /// Temporary storage used by ad_inc_ref_n_impl() and ad_dec_ref_n_impl()
+    std::vector<uint32_t> refcount_scratch;
+
+    /// Time spent in ad_enqueue() since the last traversal (see 'Statistics::last')
+    uint64_t time_dfs_pending = 0;
+
+    /// Record second-order terms for ad_hvp()? (see \ref ad_set_record_hessian())
+    bool record_hessian = false;
+
+    /// Private graph of this thread (see \ref ad_isolated_graph_enter())
+    State *isolated = nullptr;
+
+    ~LocalState();
 };
 
 constexpr bool IsDouble = std::is_same_v<Value, double>;
@@ -543,47 +1163,272 @@ static_assert(sizeof(Variable) == ((IsDouble ? 2 : 0) + 8) * sizeof(uint32_t),
 // ==========================================================================
 
 /// Global state, protected by a mutex
-static State state;
+static State state_global;
 
-/// Thread-local state
-static thread_local LocalState local_state;
+/// Maximum number of private graphs (see 'ad_isolated_graph_enter()')
+static constexpr uint32_t IsolatedGraphCount = 128;
 
-void Edge::reset() {
-    memset(this, 0, sizeof(uint32_t) * 4 + sizeof(Special *));
-    weight = Value();
-}
+/// Number of generations that a slot of 'isolated_graphs' cycles through
+static constexpr uint32_t IsolatedGenerationCount = 16;
 
-// ==========================================================================
-// Reference counting and variable cleanup
-// ==========================================================================
+/**
+ * Private graphs, indexed by bits 24..30 of their variable indices. Bits
+ * 20..23 store the generation of the slot, which is advanced whenever it is
+ * reused so that stale indices of a released graph are detected.
+ */
+static std::atomic<State *> isolated_graphs[IsolatedGraphCount];
+static uint32_t isolated_generations[IsolatedGraphCount];
 
+/**
+ * Released private graphs, which are recycled by 'ad_isolated_graph_enter()'
+ * instead of being deleted. Threads racing with the release may therefore
+ * still safely inspect them.
+ */
+static std::vector<State *> isolated_graphs_unused;
+static std::mutex isolated_graphs_mutex;
+
+/// Graph receiving the variables created by the current thread
+static thread_local State *state_ptr = &state_global;
+
+/// Return the graph of the current thread (see 'GraphSwitch')
+static inline State &state() { return *state_ptr; }
+
+/// Thread-local state
+static thread_local LocalState local_state;
+
+static void ad_isolated_graph_orphan(State *graph);
+
+LocalState::~LocalState() {
+    if (isolated) {
+        if (state_ptr == isolated)
+            state_ptr = &state_global;
+        ad_isolated_graph_orphan(isolated);
+        isolated = nullptr;
+    }
+
+    for (Special *s : cleanup)
+        delete s;
+    cleanup.clear();
+
+    if (!scopes.empty())
+        ad_log(Warn,
+               "drjit-autodiff: scope leak detected (%zu scopes "
+               "remain in use)!", scopes.size());
+}
+
+/// Return the graph that owns variable 'index' (nullptr if it was released)
+static State *ad_graph(uint32_t index) {
+    if (likely(!(index & 0x80000000u)))
+        return &state_global;
+    State *graph = isolated_graphs[(index >> 24) & (IsolatedGraphCount - 1)]
+                       .load(std::memory_order_acquire);
+    if (unlikely(!graph ||
+                 graph->generation != ((index >> 20) &
+                                       (IsolatedGenerationCount - 1))))
+        return nullptr;
+    return graph;
+}
+
+/// Return the graph of 'index', fail if it was already released
+static State *ad_graph_live(uint32_t index) noexcept(true) {
+    State *graph = ad_graph(index);
+    if (unlikely(!graph))
+        ad_fail("drjit-autodiff: variable a%u belongs to a private AD graph "
+                "that no longer exists!", index);
+    return graph;
+}
+
+/**
+ * Reference counting of a variable owned by the private graph of another
+ * thread: queue the change for the owner, who applies it in
+ * 'ad_apply_foreign_refs()'. Returns 'false' if the variable is accessible
+ * from the current thread.
+ */
+static bool ad_defer_foreign_ref(State *graph, uint32_t index, bool inc) {
+    const void *owner = graph->owner.load(std::memory_order_acquire);
+    if (likely(!owner || owner == &local_state))
+        return false;
+
+    std::lock_guard<std::mutex> guard(graph->foreign_mutex);
+
+    // The owner may have exited in the meantime, which enables the locks
+    if (!graph->owner.load(std::memory_order_relaxed))
+        return false;
+
+    (inc ? graph->foreign_inc : graph->foreign_dec).push_back(index);
+    graph->foreign_pending.store(true, std::memory_order_release);
+    return true;
+}
+
+template <typename T> void ad_inc_ref_impl(uint32_t index) noexcept(true);
+template <typename T> void ad_dec_ref_impl(uint32_t index) noexcept(true);
+
+/**
+ * Apply the reference count changes that other threads queued for the
+ * private graph of the current thread. Increments are applied first, which
+ * never releases a variable that is still referenced.
+ */
+static void ad_apply_foreign_refs(State *graph = local_state.isolated) {
+    if (likely(!graph ||
+               !graph->foreign_pending.load(std::memory_order_acquire)))
+        return;
+
+    std::vector<uint32_t> inc, dec;
+    /* Acquire the queued changes */ {
+        std::lock_guard<std::mutex> guard(graph->foreign_mutex);
+        inc.swap(graph->foreign_inc);
+        dec.swap(graph->foreign_dec);
+        graph->foreign_pending.store(false, std::memory_order_relaxed);
+    }
+
+    for (uint32_t index : inc)
+        ad_inc_ref_impl<Value>(index);
+    for (uint32_t index : dec)
+        ad_dec_ref_impl<Value>(index);
+}
+
+/**
+ * Unpublish the orphaned private graph of 'index' once its last variable is
+ * gone. The slot and generation are checked again while holding the lock,
+ * since another thread may have released the graph already.
+ */
+static void ad_isolated_graph_release(uint32_t index) {
+    uint32_t id = (index >> 24) & (IsolatedGraphCount - 1);
+    std::lock_guard<std::mutex> guard(isolated_graphs_mutex);
+    State *graph = ad_graph(index);
+    if (!graph || graph->owner.load(std::memory_order_relaxed) ||
+        graph->variable_count.load() != 0)
+        return;
+    isolated_graphs[id].store(nullptr, std::memory_order_release);
+    isolated_graphs_unused.push_back(graph);
+}
+
+/**
+ * Called when the thread owning a private graph exits. Variables that are
+ * still alive (e.g. arrays that were handed to other threads) keep the graph
+ * around: it switches to regular locking and is released along with its
+ * last variable.
+ */
+static void ad_isolated_graph_orphan(State *graph) {
+    State *prev = state_ptr;
+    state_ptr = graph;
+    ad_apply_foreign_refs(graph);
+
+    std::vector<uint32_t> inc, dec;
+    /* Enable the locks before other threads may access the graph directly */ {
+        std::lock_guard<std::mutex> guard(graph->foreign_mutex);
+        graph->mutex.enabled = true;
+        for (VariableShard &shard : graph->shards)
+            shard.mutex.enabled = true;
+        inc.swap(graph->foreign_inc);
+        dec.swap(graph->foreign_dec);
+        graph->foreign_pending.store(false, std::memory_order_relaxed);
+        graph->owner.store(nullptr, std::memory_order_release);
+    }
+
+    for (uint32_t index : inc)
+        ad_inc_ref_impl<Value>(index);
+    for (uint32_t index : dec)
+        ad_dec_ref_impl<Value>(index);
+    state_ptr = prev;
+
+    ad_isolated_graph_release(graph->index_begin);
+}
+
+/// Raise an exception if 'index' is not part of the graph of the current thread
+static void ad_check_graph(const char *func, uint32_t index) {
+    if (unlikely(index && ad_graph(index) != state_ptr))
+        ad_raise("%s(): variable a%u belongs to a different AD graph than the "
+                 "one of the current thread! Variables of the global graph and "
+                 "private graphs (see ad_isolated_graph_enter()) cannot be "
+                 "combined.", func, index);
+}
+
+/// RAII helper to temporarily operate on the graph owning a variable
+struct GraphSwitch {
+    GraphSwitch(State *graph) : prev(state_ptr) { state_ptr = graph; }
+    ~GraphSwitch() { state_ptr = prev; }
+    GraphSwitch(const GraphSwitch &) = delete;
+    GraphSwitch &operator=(const GraphSwitch &) = delete;
+    State *prev;
+};
+
+void Edge::reset() {
+    memset(this, 0, sizeof(uint32_t) * 4 + sizeof(Special *));
+    weight = Value();
+}
+
+// ==========================================================================
+// Reference counting and variable cleanup
+// ==========================================================================
+
+/// Increase the reference count of a variable (caller must hold 'state.mutex')
 static void ad_inc_ref(uint32_t index, Variable *v) noexcept (true) {
     DRJIT_MARK_USED(index);
+    lock_guard<StateMutex> guard(state().shard(index).mutex);
     ad_trace("ad_inc_ref(a%u): %u", index, v->ref_count + 1);
     v->ref_count++;
 }
 
+/// Decrease the reference count of a variable (caller must hold 'state.mutex')
 static bool ad_dec_ref(uint32_t index, Variable *v) noexcept (true) {
     DRJIT_MARK_USED(index);
-    ad_trace("ad_dec_ref(a%u): %u", index, v->ref_count - 1);
 
-    if (unlikely(v->ref_count == 0))
-        ad_fail("drjit-autodiff: fatal error: external reference count of "
-                "variable a%u became negative!", index);
+    /* lock the variable's shard */ {
+        lock_guard<StateMutex> guard(state().shard(index).mutex);
+        ad_trace("ad_dec_ref(a%u): %u", index, v->ref_count - 1);
 
-    if (--v->ref_count > 0) {
-        return false;
-    } else {
-        ad_free(index, v);
-        return true;
+        if (unlikely(v->ref_count == 0))
+            ad_fail("drjit-autodiff: fatal error: external reference count of "
+                    "variable a%u became negative!", index);
+
+        if (--v->ref_count > 0)
+            return false;
     }
+
+    ad_free(index, v);
+    return true;
+}
+
+/// Saturation value of Variable::ref_count_int
+static constexpr uint32_t RefCountIntMax = (1u << 10) - 1;
+
+/// Reference held by an edge or by the traversal queue (see ad_observable())
+static void ad_inc_ref_int(uint32_t index, Variable *v) noexcept (true) {
+    ad_inc_ref(index, v);
+    if (v->ref_count_int != RefCountIntMax)
+        v->ref_count_int++;
+}
+
+/// Release a reference acquired by ad_inc_ref_int()
+static bool ad_dec_ref_int(uint32_t index, Variable *v) noexcept (true) {
+    if (unlikely(v->ref_count_int == 0))
+        ad_fail("drjit-autodiff: fatal error: internal reference count of "
+                "variable a%u became negative!", index);
+    if (v->ref_count_int != RefCountIntMax)
+        v->ref_count_int--;
+    return ad_dec_ref(index, v);
 }
 
 template <typename T> void ad_inc_ref_impl(uint32_t index) noexcept(true) {
     if (likely(index == 0))
         return;
-    std::lock_guard<std::mutex> guard(state.mutex);
-    ad_inc_ref(index, state[index]);
+
+    State *graph = ad_graph_live(index);
+    if (unlikely(graph != state_ptr)) {
+        if (ad_defer_foreign_ref(graph, index, true))
+            return;
+        GraphSwitch graph_switch(graph);
+        ad_inc_ref_impl<T>(index);
+        return;
+    }
+
+    // Only the shard lock is needed, since the variable is already referenced
+    VariableShard &shard = state().shard(index);
+    lock_guard<StateMutex> guard(shard.mutex);
+    Variable *v = state()[index];
+    ad_trace("ad_inc_ref(a%u): %u", index, v->ref_count + 1);
+    v->ref_count++;
 }
 
 template <typename T> uint32_t ad_inc_ref_cond_impl(uint32_t index) noexcept(true) {
@@ -597,17 +1442,50 @@ template <typename T> uint32_t ad_inc_ref_cond_impl(uint32_t index) noexcept(tru
             return 0;
     }
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    ad_inc_ref(index, state[index]);
+    ad_inc_ref_impl<T>(index);
     return index;
 }
 
 template <typename T> void ad_dec_ref_impl(uint32_t index) noexcept(true) {
     if (index == 0)
         return;
-    std::lock_guard<std::mutex> guard(state.mutex);
 
-    if (unlikely(ad_dec_ref(index, state[index]))) {
+    State *graph = ad_graph_live(index);
+    if (unlikely(graph != state_ptr)) {
+        if (ad_defer_foreign_ref(graph, index, false))
+            return;
+        /* Scope */ {
+            GraphSwitch graph_switch(graph);
+            ad_dec_ref_impl<T>(index);
+        }
+        // Release orphaned private graphs along with their last variable
+        if (unlikely(graph != &state_global &&
+                     !graph->owner.load(std::memory_order_relaxed) &&
+                     graph->variable_count.load() == 0))
+            ad_isolated_graph_release(index);
+        return;
+    }
+
+    if (unlikely(graph->owner.load(std::memory_order_relaxed)))
+        ad_apply_foreign_refs();
+
+    /* Fast path: the reference count does not reach zero, which only
+       requires the shard lock. Otherwise, retry while holding the global
+       lock, since the variable and its edges must be removed from the graph
+       (other threads may have acquired a reference in the meantime). */ {
+        VariableShard &shard = state().shard(index);
+        lock_guard<StateMutex> guard(shard.mutex);
+        Variable *v = state()[index];
+        if (likely(v->ref_count > 1)) {
+            ad_trace("ad_dec_ref(a%u): %u", index, v->ref_count - 1);
+            v->ref_count--;
+            return;
+        }
+    }
+
+    lock_guard<StateMutex> guard(state().mutex);
+
+    if (unlikely(ad_dec_ref(index, state()[index]))) {
         /* Extra-careful here: deallocate cleanup queue of
            custom AD edge callbacks (reentrant!) */
 
@@ -623,6 +1501,108 @@ template <typename T> void ad_dec_ref_impl(uint32_t index) noexcept(true) {
     }
 }
 
+/**
+ * Reorder the nonzero entries of 'indices' by shard (counting sort), which
+ * allows bulk reference count updates to acquire each shard lock only once.
+ * 'offsets[s]' .. 'offsets[s + 1]' specifies the range of shard 's'.
+ */
+static uint32_t *ad_sort_by_shard(size_t n, const uint32_t *indices,
+                                  uint32_t *offsets) {
+    constexpr uint32_t ShardMask = State::ShardCount - 1;
+    std::vector<uint32_t> &out = local_state.refcount_scratch;
+
+    memset(offsets, 0, sizeof(uint32_t) * (State::ShardCount + 1));
+    for (size_t i = 0; i < n; ++i) {
+        if (indices[i])
+            offsets[(indices[i] & ShardMask) + 1]++;
+    }
+
+    for (uint32_t s = 0; s < State::ShardCount; ++s)
+        offsets[s + 1] += offsets[s];
+
+    out.resize(offsets[State::ShardCount]);
+
+    uint32_t pos[State::ShardCount];
+    memcpy(pos, offsets, sizeof(pos));
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t index = indices[i];
+        if (index)
+            out[pos[index & ShardMask]++] = index;
+    }
+
+    return out.data();
+}
+
+/// Check if all entries of 'indices' belong to the graph of the current thread
+static bool ad_graph_local(size_t n, const uint32_t *indices) {
+    for (size_t i = 0; i < n; ++i) {
+        if (indices[i] && unlikely(ad_graph(indices[i]) != state_ptr))
+            return false;
+    }
+    return true;
+}
+
+template <typename T>
+void ad_inc_ref_n_impl(size_t n, const uint32_t *indices) noexcept(true) {
+    if (unlikely(!ad_graph_local(n, indices))) {
+        for (size_t i = 0; i < n; ++i)
+            ad_inc_ref_impl<T>(indices[i]);
+        return;
+    }
+
+    uint32_t offsets[State::ShardCount + 1];
+    const uint32_t *sorted = ad_sort_by_shard(n, indices, offsets);
+
+    for (uint32_t s = 0; s < State::ShardCount; ++s) {
+        uint32_t start = offsets[s], end = offsets[s + 1];
+        if (start == end)
+            continue;
+
+        lock_guard<StateMutex> guard(state().shards[s].mutex);
+        for (uint32_t i = start; i < end; ++i) {
+            Variable *v = state()[sorted[i]];
+            ad_trace("ad_inc_ref(a%u): %u", sorted[i], v->ref_count + 1);
+            v->ref_count++;
+        }
+    }
+}
+
+template <typename T>
+void ad_dec_ref_n_impl(size_t n, const uint32_t *indices) noexcept(true) {
+    if (unlikely(!ad_graph_local(n, indices))) {
+        for (size_t i = 0; i < n; ++i)
+            ad_dec_ref_impl<T>(indices[i]);
+        return;
+    }
+
+    uint32_t offsets[State::ShardCount + 1];
+    const uint32_t *sorted = ad_sort_by_shard(n, indices, offsets);
+
+    // Variables whose reference count reaches zero take the slow path below
+    std::vector<uint32_t> release;
+
+    for (uint32_t s = 0; s < State::ShardCount; ++s) {
+        uint32_t start = offsets[s], end = offsets[s + 1];
+        if (start == end)
+            continue;
+
+        lock_guard<StateMutex> guard(state().shards[s].mutex);
+        for (uint32_t i = start; i < end; ++i) {
+            uint32_t index = sorted[i];
+            Variable *v = state()[index];
+            if (likely(v->ref_count > 1)) {
+                ad_trace("ad_dec_ref(a%u): %u", index, v->ref_count - 1);
+                v->ref_count--;
+            } else {
+                release.push_back(index);
+            }
+        }
+    }
+
+    for (uint32_t index : release)
+        ad_dec_ref_impl<T>(index);
+}
+
 static void ad_free(uint32_t index, Variable *v) {
     ad_trace("ad_free(a%u)", index);
 
@@ -631,11 +1611,20 @@ static void ad_free(uint32_t index, Variable *v) {
         v->label = nullptr;
     }
 
+    if (unlikely(v->sparse_grad))
+        state().sparse_grads.erase(index);
+
+    if (unlikely(v->pending_grad))
+        state().pending.erase(index);
+
+    if (unlikely(v->hessian))
+        state().hessians.erase(index);
+
     uint32_t edge_id = v->next_bwd;
     v->next_bwd = 0;
 
     while (edge_id) {
-        Edge &edge = state.edges[edge_id];
+        Edge &edge = state().edges[edge_id];
 
         ad_trace("ad_free(): freeing edge a%u -> a%u", edge.source,
                  edge.target);
@@ -654,19 +1643,19 @@ static void ad_free(uint32_t index, Variable *v) {
             local_state.cleanup.push_back(edge.special);
         edge.reset();
 
-        Variable *v2 = state[source];
+        Variable *v2 = state()[source];
 
         if (unlikely(v2->ref_count == 0))
             ad_fail("drjit-autodiff: fatal error: reference count of variable "
                     "a%u became negative!", source);
 
-        if (!ad_dec_ref(source, v2)) {
+        if (!ad_dec_ref_int(source, v2)) {
             uint32_t fwd = v2->next_fwd;
             if (fwd == edge_id) {
                 v2->next_fwd = next_fwd;
             } else {
                 while (true) {
-                    Edge &edge2 = state.edges[fwd];
+                    Edge &edge2 = state().edges[fwd];
                     assert(edge2.source == source);
                     if (edge2.next_fwd != edge_id) {
                         fwd = edge2.next_fwd;
@@ -678,12 +1667,12 @@ static void ad_free(uint32_t index, Variable *v) {
             }
         }
 
-        state.unused_edges.push_back(edge_id);
+        state().unused_edges.push_back(edge_id);
 
         edge_id = next_bwd;
     }
 
-    state.variables.erase(index);
+    state().erase(index);
 }
 
 // ==========================================================================
@@ -694,33 +1683,40 @@ static void ad_free(uint32_t index, Variable *v) {
 static std::pair<uint32_t, Variable *> ad_var_new(const char *label,
                                                   size_t size) {
     while (true) {
-        uint32_t index = state.variable_index++;
+        uint32_t index = state().variable_index++;
 
-        if (unlikely(index == 0)) { // overflow
-            state.variable_index = 1;
-            index = state.variable_index++;
+        if (unlikely(index == state().index_end)) { // overflow
+            state().variable_index = state().index_begin;
+            index = state().variable_index++;
         }
 
         bool rec = false;
         if (is_jit_v<Value>)
             rec = jit_flag(JitFlag::Recording);
 
-        auto result = state.variables.try_emplace(index, label, size, rec);
-        if (likely(result.second))
-            return { index, &result.first.value() };
+        Variable *v = state().insert(index, label, size, rec);
+        if (likely(v))
+            return { index, v };
     }
 }
 
 /// Allocate a new edge from the pool
 static uint32_t ad_edge_new() {
     uint32_t index;
-    if (likely(!state.unused_edges.empty())) {
-        index = state.unused_edges.back();
-        state.unused_edges.pop_back();
+    if (likely(!state().unused_edges.empty())) {
+        index = state().unused_edges.back();
+        state().unused_edges.pop_back();
     } else {
-        index = (uint32_t) state.edges.size();
-        state.edges.emplace_back();
+        index = (uint32_t) state().edges.size();
+        if (unlikely(index >= (1u << 29)))
+            ad_raise("ad_edge_new(): the AD graph exceeds the maximum number "
+                     "of edges (2^29)!");
+        state().edges.emplace_back();
     }
+
+    size_t edges_used = state().edges.size() - state().unused_edges.size() - 1;
+    if (edges_used > stats.edges_peak.load(std::memory_order_relaxed))
+        stats.edges_peak.store(edges_used, std::memory_order_relaxed);
     return index;
 }
 
@@ -729,8 +1725,8 @@ static uint32_t ad_edge_new() {
 static void ad_propagate_placeholder_size(Variable *v) {
     uint32_t edge = v->next_bwd;
     while (edge) {
-        Edge &e = state.edges[edge];
-        Variable *v2 = state[e.source];
+        Edge &e = state().edges[edge];
+        Variable *v2 = state()[e.source];
         if (v2->placeholder && v2->size != v->size && v2->size == 1) {
             v2->size = v->size;
             ad_propagate_placeholder_size(v2);
@@ -753,7 +1749,7 @@ struct ReleaseOperandHelper {
     ~ReleaseOperandHelper() {
         for (uint32_t i = 0; i < pos; ++i) {
             uint32_t index = values[i];
-            ad_dec_ref(index, state[index]);
+            ad_dec_ref(index, state()[index]);
         }
     }
 };
@@ -803,8 +1799,8 @@ void ad_scope_enter(ADScope type, size_t size, const uint32_t *indices) {
 
             scope.isolate = true;
             /* access state data structure */ {
-                std::lock_guard<std::mutex> guard(state.mutex);
-                scope.variable_index = state.variable_index;
+                lock_guard<StateMutex> guard(state().mutex);
+                scope.variable_index = state().variable_index;
             }
             ad_log(Debug, "ad_scope_enter(isolate, a%u...)", scope.variable_index);
             break;
@@ -860,9 +1856,6 @@ template <typename T> void ad_scope_leave(bool process_postponed) {
     } else {
         scopes.pop_back();
     }
-
-    // Use this opportunity to also clear the implicit dependency tracker
-    // ls.implicit.clear();
 }
 
 template <typename T> bool ad_grad_enabled(uint32_t index) {
@@ -883,14 +1876,16 @@ template <typename T> bool ad_enabled() noexcept(true) {
             return false;
     }
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    return !state.variables.empty();
+    return state().variable_count.load(std::memory_order_relaxed) != 0;
 }
 
 template <typename T>
 uint32_t ad_new(const char *label, size_t size, uint32_t op_count,
                 uint32_t *op, T *weights) {
-    std::lock_guard<std::mutex> guard(state.mutex);
+    for (uint32_t i = 0; i < op_count; ++i)
+        ad_check_graph("ad_new", op[i]);
+
+    lock_guard<StateMutex> guard(state().mutex);
 
     /* Potentially turn off derivative tracking for some of the operands if
        we're within a scope that enables/disables gradient propagation
@@ -924,7 +1919,7 @@ uint32_t ad_new(const char *label, size_t size, uint32_t op_count,
                 continue;
 
             uint32_t index = op[i];
-            const Variable *var = state[index];
+            const Variable *var = state()[index];
 
             /* When recording AD code (e.g. in a virtual function call),
                convert reads from external/private variables into gathers */
@@ -987,19 +1982,32 @@ uint32_t ad_new(const char *label, size_t size, uint32_t op_count,
             continue;
         }
 
+        scalar_t<T> unit_value = 0;
+        if constexpr (is_jit_v<T>) {
+            if (jit_flag(JitFlag::ADOptimize) && weights[i].is_literal())
+                unit_value = weights[i][0];
+        } else {
+            unit_value = weights[i];
+        }
+
         uint32_t index2 = op[i];
-        Variable *var2 = state[index2];
+        Variable *var2 = state()[index2];
 
         uint32_t edge_index_new = ad_edge_new();
-        Edge &edge = state.edges[edge_index_new];
+        Edge &edge = state().edges[edge_index_new];
         edge.source = index2;
         edge.target = index;
-        edge.weight = std::move(weights[i]);
+        if (unit_value == 1)
+            edge.unit = UnitPlus;
+        else if (unit_value == -1)
+            edge.unit = UnitMinus;
+        else
+            edge.weight = std::move(weights[i]);
         edge.next_fwd = var2->next_fwd;
         edge.next_bwd = edge_index;
         edge_index = edge_index_new;
 
-        ad_inc_ref(index2, var2);
+        ad_inc_ref_int(index2, var2);
         var2->next_fwd = edge_index_new;
     }
 
@@ -1025,6 +2033,79 @@ uint32_t ad_new(const char *label, size_t size, uint32_t op_count,
     return index;
 }
 
+// ==========================================================================
+// Deferred gradient accumulation at variables with a high fan-in
+// ==========================================================================
+
+/* When many edges propagate gradients into the same variable, accumulating
+   them one at a time (via Variable::accum() and mul_accum()) produces a
+   serial chain of JIT operations whose length matches the fan-in. With JIT
+   backends, ad_traverse() therefore only stores the first contribution
+   directly and collects the remaining ones in 'state().pending'. They are
+   summed using a balanced reduction tree once the gradient is needed. All
+   functions in this section require that the caller holds 'state.mutex'. */
+
+/// Sum a list of gradient contributions using a balanced reduction tree
+static Value ad_sum_tree(std::vector<Value> &terms) {
+    size_t n = terms.size();
+    while (n > 1) {
+        size_t half = n / 2;
+        for (size_t i = 0; i < half; ++i)
+            terms[i] = terms[2 * i] + terms[2 * i + 1];
+        if (n & 1)
+            terms[half] = std::move(terms[n - 1]);
+        n = half + (n & 1);
+    }
+    Value result = std::move(terms[0]);
+    terms.clear();
+    return result;
+}
+
+/// Record a gradient contribution 't' to variable 'v' for later accumulation
+static void ad_defer_accum(uint32_t index, Variable *v, Value &&t) {
+    std::vector<Value> &terms = state().pending[index];
+    if (!v->pending_grad) {
+        terms.clear();
+        if (is_valid(v->grad))
+            terms.push_back(std::move(v->grad));
+        v->grad = Value();
+        v->pending_grad = 1;
+    }
+    terms.push_back(std::move(t));
+}
+
+/// Merge the deferred contributions into the gradient of 'v'
+static void ad_flush_pending(uint32_t index, Variable *v) {
+    auto it = state().pending.find(index);
+    if (it != state().pending.end()) {
+        std::vector<Value> &terms = it.value();
+        if (is_valid(v->grad))
+            terms.push_back(std::move(v->grad));
+        if (!terms.empty())
+            v->grad = ad_sum_tree(terms);
+        state().pending.erase(it);
+    }
+    v->pending_grad = 0;
+}
+
+/// Merge all deferred contributions (e.g., before invoking a user callback)
+static void ad_flush_pending_all() {
+    if (state().pending.empty())
+        return;
+
+    for (auto &kv : state().pending) {
+        Variable *v = state()[kv.first];
+        std::vector<Value> &terms = kv.second;
+        if (is_valid(v->grad))
+            terms.push_back(std::move(v->grad));
+        if (!terms.empty())
+            v->grad = ad_sum_tree(terms);
+        v->pending_grad = 0;
+    }
+
+    state().pending.clear();
+}
+
 // ==========================================================================
 // Implementation of AD for special operations: masks, gathers, scatters
 // ==========================================================================
@@ -1058,6 +2139,8 @@ template <typename Value> struct SpecialConnection : Special {
         if (source->size)
             const_cast<Variable *>(source)->ref_count_grad++;
     }
+
+    bool local() const override { return false; }
 };
 
 template <typename Value> struct SpecialCallback : Special {
@@ -1104,7 +2187,7 @@ template <typename Value> struct SpecialCallback : Special {
 
     virtual ~SpecialCallback() {
         /* outside of critical section */ {
-            unlock_guard<std::mutex> guard(state.mutex);
+            unlock_guard<StateMutex> guard(state().mutex);
             callback.reset();
         }
     }
@@ -1112,19 +2195,24 @@ template <typename Value> struct SpecialCallback : Special {
     SpecialCallback(DiffCallback *callback, Scope &&scope)
         : callback(callback), scope(std::move(scope)) { }
 
+    bool linear() const override { return false; }
+
+    bool local() const override { return false; }
+
     void backward(Variable *, const Variable *target, uint32_t flags) const override {
         ad_trace("ad_traverse(): invoking user callback ..");
         uint32_t edge = target->next_fwd;
+        ad_flush_pending_all();
 
         /* leave critical section */ {
-            unlock_guard<std::mutex> guard(state.mutex);
+            unlock_guard<StateMutex> guard(state().mutex);
             PushScope push(scope);
             callback->backward();
         }
-        if (edge && state.edges[edge].next_fwd) { // fan-in > 1, update ref counts
+        if (edge && state().edges[edge].next_fwd) { // fan-in > 1, update ref counts
             do {
-                const Edge &e = state.edges[edge];
-                Variable *v = state[e.target];
+                const Edge &e = state().edges[edge];
+                Variable *v = state()[e.target];
 
                 if (v->ref_count_grad > 0 && --v->ref_count_grad == 0) {
                     if (((flags & (uint32_t) ADFlag::ClearInterior) && v->next_fwd != 0) ||
@@ -1139,15 +2227,16 @@ template <typename Value> struct SpecialCallback : Special {
     void forward(const Variable *source, Variable *, uint32_t flags) const override {
         ad_trace("ad_traverse(): invoking user callback ..");
         uint32_t edge = source->next_bwd;
+        ad_flush_pending_all();
         /* leave critical section */ {
-            unlock_guard<std::mutex> guard(state.mutex);
+            unlock_guard<StateMutex> guard(state().mutex);
             PushScope push(scope);
             callback->forward();
         }
-        if (edge && state.edges[edge].next_bwd) { // fan-in > 1, update ref counts
+        if (edge && state().edges[edge].next_bwd) { // fan-in > 1, update ref counts
             do {
-                const Edge &e = state.edges[edge];
-                Variable *v = state[e.source];
+                const Edge &e = state().edges[edge];
+                Variable *v = state()[e.source];
 
 
                 if (v->ref_count_grad > 0 && --v->ref_count_grad == 0) {
@@ -1168,19 +2257,22 @@ template <typename Value> struct SpecialCallback : Special {
 template <typename Value, typename Mask>
 uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
                        uint32_t t_index, uint32_t f_index) {
-    std::lock_guard<std::mutex> guard(state.mutex);
+    ad_check_graph("ad_new_select", t_index);
+    ad_check_graph("ad_new_select", f_index);
+
+    lock_guard<StateMutex> guard(state().mutex);
     if constexpr (is_jit_v<Mask>) {
         if (jit_flag(JitFlag::ADOptimize) && mask.is_literal()) {
             uint32_t result = mask[0] ? t_index : f_index;
             if (result)
-                ad_inc_ref(result, state[result]);
+                ad_inc_ref(result, state()[result]);
             ad_log(Debug, "ad_new_select(a%u <- a%u, a%u): simplified", result, t_index, f_index);
             return result;
         }
 
         if (jit_flag(JitFlag::ADOptimize) && f_index == t_index) {
             if (t_index)
-                ad_inc_ref(t_index, state[t_index]);
+                ad_inc_ref(t_index, state()[t_index]);
             ad_log(Debug, "ad_new_select(a%u <- a%u, a%u): simplified", t_index, t_index, f_index);
             return t_index;
         }
@@ -1213,7 +2305,7 @@ uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
                 continue;
 
             uint32_t index = op[i];
-            Variable *var = state[index];
+            Variable *var = state()[index];
 
             /* When recording AD code (e.g. in a virtual function call),
                convert reads from external/private variables into gathers */
@@ -1233,7 +2325,7 @@ uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
                 index = ad_new_gather_impl<Value>("gather", size, op[i], Index(0),
                                                   Mask(true), false);
 
-                var = state[index];
+                var = state()[index];
                 op[i] = index;
                 helper.put(index);
             }
@@ -1241,6 +2333,7 @@ uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
     }
 
     auto [index, var] = ad_var_new(label, size);
+    var->loop_boundary = label && strcmp(label, "dr_loop") == 0;
 
     ad_log(Debug, "ad_new_select(a%u <- a%u, a%u)", index, t_index, f_index);
     uint32_t edge_index = 0;
@@ -1249,10 +2342,10 @@ uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
             continue;
 
         uint32_t index2 = op[i];
-        Variable *var2 = state[index2];
+        Variable *var2 = state()[index2];
 
         uint32_t edge_index_new = ad_edge_new();
-        Edge &edge = state.edges[edge_index_new];
+        Edge &edge = state().edges[edge_index_new];
         edge.source = index2;
         edge.target = index;
         edge.special = new MaskEdge<Value>(mask, i != 0);
@@ -1260,7 +2353,7 @@ uint32_t ad_new_select(const char *label, size_t size, const Mask &mask,
         edge.next_bwd = edge_index;
         edge_index = edge_index_new;
 
-        ad_inc_ref(index2, var2);
+        ad_inc_ref_int(index2, var2);
 
         var2->next_fwd = edge_index_new;
     }
@@ -1295,9 +2388,24 @@ template <typename Mask> struct MaskGuard {
 };
 
 
+/// Kahan-compensated version of scatter_reduce(ReduceOp::Add, ..)
+template <typename Value>
+void scatter_add_compensated(Value &target, const Value &value,
+                             const Index &offset, const Mask &mask) {
+    if constexpr (is_jit_v<Value>) {
+        Value error = zeros<Value>(target.size());
+        scatter_reduce_kahan(target, error, value, offset, mask);
+        target += error;
+    } else {
+        scatter_reduce(ReduceOp::Add, target, value, offset, mask);
+    }
+}
+
 template <typename Value> struct GatherEdge : Special {
-    GatherEdge(const Index &offset, const Mask &mask, bool permute)
-        : offset(offset), mask(mask), permute(permute) {
+    GatherEdge(uint32_t source_index, const Index &offset, const Mask &mask,
+               bool permute)
+        : offset(offset), mask(mask), source_index(source_index),
+          permute(permute) {
         if constexpr (is_jit_v<Value>) {
             uint32_t mask_idx = jit_var_mask_peek(Value::Backend);
             if (!mask_idx)
@@ -1306,7 +2414,7 @@ template <typename Value> struct GatherEdge : Special {
         }
     }
 
-    void backward(Variable *source, const Variable *target, uint32_t) const override {
+    void backward(Variable *source, const Variable *target, uint32_t flags) const override {
         Value &source_grad = (Value &) source->grad;
         uint32_t size = source->size;
 
@@ -1316,6 +2424,26 @@ template <typename Value> struct GatherEdge : Special {
             return;
         }
 
+        if constexpr (is_jit_v<Value>) {
+            if (source->sparse_grad) {
+                // Record (row, value) pairs instead of scattering
+                auto it = state().sparse_grads.find(source_index);
+                if (it != state().sparse_grads.end()) {
+                    mask_t<Value> active = mask & mask_stack;
+                    uint32_t n = (uint32_t) width(offset, active);
+                    uint32_array_t<Value> rows = select(active, offset, 0u);
+                    Value values = select(active, target->grad, 0.f);
+                    if ((uint32_t) rows.size() != n)
+                        rows.resize(n);
+                    if ((uint32_t) values.size() != n)
+                        values.resize(n);
+                    it.value().chunks.emplace_back(std::move(rows),
+                                                   std::move(values));
+                    return;
+                }
+            }
+        }
+
         if (!source_grad.valid())
             source_grad = zeros<Value>(size);
         else if ((uint32_t) source_grad.size() != size)
@@ -1324,6 +2452,8 @@ template <typename Value> struct GatherEdge : Special {
         MaskGuard guard(mask_stack);
         if (permute)
             scatter(source_grad, target->grad, offset, mask);
+        else if (flags & (uint32_t) ADFlag::Compensated)
+            scatter_add_compensated(source_grad, target->grad, offset, mask);
         else
             scatter_reduce(ReduceOp::Add, source_grad, target->grad, offset, mask);
     }
@@ -1337,6 +2467,7 @@ template <typename Value> struct GatherEdge : Special {
     Index offset;
     Mask mask;
     Mask mask_stack;
+    uint32_t source_index;
     bool permute;
 };
 
@@ -1368,16 +2499,16 @@ uint32_t ad_new_gather_impl(const char *label, size_t size, uint32_t src_index,
         ad_log(Debug, "ad_new_gather(a%u <- a%u, size=%zu, permute=%i)", index,
                src_index, size, (int) permute);
 
-        Variable *var2 = state[src_index];
+        Variable *var2 = state()[src_index];
 
         uint32_t edge_index_new = ad_edge_new();
-        Edge &edge = state.edges[edge_index_new];
+        Edge &edge = state().edges[edge_index_new];
         edge.source = src_index;
         edge.target = index;
-        edge.special = new GatherEdge<Value>(offset, mask, permute);
+        edge.special = new GatherEdge<Value>(src_index, offset, mask, permute);
         edge.next_fwd = var2->next_fwd;
         edge.next_bwd = 0;
-        ad_inc_ref(src_index, var2);
+        ad_inc_ref_int(src_index, var2);
         var2->next_fwd = edge_index_new;
         var->next_bwd = edge_index_new;
         var->ref_count = 1;
@@ -1407,7 +2538,9 @@ uint32_t ad_new_gather_impl(const char *label, size_t size, uint32_t src_index,
 template <typename Value, typename Mask, typename Index>
 uint32_t ad_new_gather(const char *label, size_t size, uint32_t src_index,
                       const Index &offset, const Mask &mask, bool permute) {
-    std::lock_guard<std::mutex> guard(state.mutex);
+    ad_check_graph("ad_new_gather", src_index);
+
+    lock_guard<StateMutex> guard(state().mutex);
     return ad_new_gather_impl<Value>(label, size, src_index, offset, mask, permute);
 }
 
@@ -1430,7 +2563,7 @@ template <typename Value> struct ScatterEdge : Special {
                       (uint32_t) width(offset));
     }
 
-    void forward(const Variable *source, Variable *target, uint32_t) const override {
+    void forward(const Variable *source, Variable *target, uint32_t flags) const override {
         Value &target_grad = (Value &) target->grad;
         uint32_t size = target->size;
 
@@ -1440,7 +2573,9 @@ template <typename Value> struct ScatterEdge : Special {
             target_grad.resize(size);
 
         MaskGuard guard(mask_stack);
-        if (op != ReduceOp::None)
+        if (op == ReduceOp::Add && (flags & (uint32_t) ADFlag::Compensated))
+            scatter_add_compensated(target_grad, source->grad, offset, mask);
+        else if (op != ReduceOp::None)
             scatter_reduce(op, target_grad, source->grad, offset, mask);
         else
             scatter(target_grad, source->grad, offset, mask);
@@ -1456,18 +2591,20 @@ template <typename Value, typename Mask, typename Index>
 uint32_t ad_new_scatter(const char *label, size_t size, ReduceOp op,
                         uint32_t src_index, uint32_t dst_index, const Index &offset,
                         const Mask &mask_, bool permute) {
+    ad_check_graph("ad_new_scatter", src_index);
+    ad_check_graph("ad_new_scatter", dst_index);
 
     Mask mask(mask_);
     DRJIT_MARK_USED(mask);
 
     if constexpr (is_array_v<Value>) {
-        std::lock_guard<std::mutex> guard(state.mutex);
+        lock_guard<StateMutex> guard(state().mutex);
 
         if (is_jit_v<Value>) {
             // Apply the mask stack (needed for wavefront-mode dr::Loop)
             Mask top = Mask::steal(jit_var_mask_peek(Mask::Backend));
             size_t tsize = top.size(),
-                   ssize = (size_t)(src_index ? state[src_index]->size : 0);
+                   ssize = (size_t)(src_index ? state()[src_index]->size : 0);
             ssize = std::max(std::max(ssize, offset.size()), mask_.size());
             if (tsize != 1 && tsize == ssize)
                 mask &= top;
@@ -1494,36 +2631,36 @@ uint32_t ad_new_scatter(const char *label, size_t size, ReduceOp op,
         uint32_t edge_index = 0;
 
         if (src_index != 0) {
-            Variable *var2 = state[src_index];
+            Variable *var2 = state()[src_index];
             uint32_t edge_index_new = ad_edge_new();
-            Edge &edge = state.edges[edge_index_new];
+            Edge &edge = state().edges[edge_index_new];
             edge.source = src_index;
             edge.target = index;
             edge.special = new ScatterEdge<Value>(offset, mask, op);
             edge.next_fwd = var2->next_fwd;
             edge.next_bwd = var->next_bwd;
-            ad_inc_ref(src_index, var2);
+            ad_inc_ref_int(src_index, var2);
             var2->next_fwd = edge_index_new;
             edge_index = edge_index_new;
         }
 
         if (dst_index != 0) {
-            Variable *var2 = state[dst_index];
+            Variable *var2 = state()[dst_index];
 
             uint32_t edge_index_new = ad_edge_new();
-            Edge &edge2 = state.edges[edge_index_new];
+            Edge &edge2 = state().edges[edge_index_new];
             edge2.source = dst_index;
             edge2.target = index;
             edge2.next_fwd = var2->next_fwd;
             edge2.next_bwd = edge_index;
             if (op != ReduceOp::None || permute) {
-                edge2.weight = 1;
+                edge2.unit = UnitPlus;
             } else {
                 Mask edge_mask = full<Mask>(false, size);
                 scatter(edge_mask, Mask(true), offset, mask);
                 edge2.special = new MaskEdge<Value>(edge_mask, true);
             }
-            ad_inc_ref(dst_index, var2);
+            ad_inc_ref_int(dst_index, var2);
             var2->next_fwd = edge_index_new;
             edge_index = edge_index_new;
         }
@@ -1552,6 +2689,26 @@ uint32_t ad_new_scatter(const char *label, size_t size, ReduceOp op,
 // Interface for querying and modifying variables
 // ==========================================================================
 
+/// Merge the sparse gradient of 'v' into its dense gradient (needs the lock)
+template <typename T = Value> void ad_densify(uint32_t index, Variable &v) {
+    auto it = state().sparse_grads.find(index);
+    if (it == state().sparse_grads.end() || it.value().chunks.empty())
+        return;
+
+    if constexpr (is_jit_v<T>) {
+        T &grad = v.grad;
+        if (!grad.valid())
+            grad = zeros<T>(v.size);
+        else if ((uint32_t) grad.size() != v.size)
+            grad.resize(v.size);
+
+        for (auto &[rows, values] : it.value().chunks)
+            scatter_reduce(ReduceOp::Add, grad, values, rows);
+    }
+
+    it.value().chunks.clear();
+}
+
 template <typename T> T ad_grad(uint32_t index, bool fail_if_missing) {
     auto const &scopes = local_state.scopes;
     if (unlikely(!scopes.empty()))
@@ -1559,15 +2716,22 @@ template <typename T> T ad_grad(uint32_t index, bool fail_if_missing) {
     if (unlikely(index == 0))
         return T(0);
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    auto it = state.variables.find(index);
-    if (it == state.variables.end()) {
+    ad_check_graph("ad_grad", index);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *vp = state().find(index);
+    if (!vp) {
         if (fail_if_missing)
             ad_raise("ad_grad(): referenced an unknown variable a%u!", index);
         return T(0);
     }
 
-    const Variable &v = it->second;
+    Variable &v = *vp;
+    if (unlikely(v.pending_grad))
+        ad_flush_pending(index, &v);
+    if (unlikely(v.sparse_grad))
+        ad_densify(index, v);
+
     T result = v.grad;
 
     if constexpr (is_jit_v<T>) {
@@ -1588,16 +2752,18 @@ void ad_set_grad(uint32_t index, const T &value, bool fail_if_missing) {
     if (unlikely(index == 0))
         return;
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    auto it = state.variables.find(index);
-    if (it == state.variables.end()) {
+    ad_check_graph("ad_set_grad", index);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *vp = state().find(index);
+    if (!vp) {
         if (fail_if_missing)
             ad_raise("ad_set_grad(): referenced an unknown variable a%u!", index);
         return;
     }
 
     size_t size_in = width(value);
-    Variable &v = it.value();
+    Variable &v = *vp;
 
     if (v.size != size_in && size_in != 1 && v.size != 1)
         ad_raise("ad_set_grad(): attempted to assign a gradient of size "
@@ -1605,6 +2771,13 @@ void ad_set_grad(uint32_t index, const T &value, bool fail_if_missing) {
                  size_in, index, v.size);
 
     ad_trace("ad_set_grad(a%u)", index);
+    if (unlikely(v.sparse_grad))
+        state().sparse_grads[index].chunks.clear();
+    if (unlikely(v.pending_grad)) {
+        state().pending.erase(index);
+        v.pending_grad = 0;
+    }
+
     if (v.size != 1 || size_in == 1)
         v.grad = value;
     else
@@ -1619,16 +2792,18 @@ void ad_accum_grad(uint32_t index, const T &value, bool fail_if_missing) {
     if (unlikely(index == 0))
         return;
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    auto it = state.variables.find(index);
-    if (it == state.variables.end()) {
+    ad_check_graph("ad_accum_grad", index);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *vp = state().find(index);
+    if (!vp) {
         if (fail_if_missing)
             ad_raise("ad_accum_grad(): referenced an unknown variable a%u!", index);
         return;
     }
 
     size_t size_in = width(value);
-    Variable &v = it.value();
+    Variable &v = *vp;
 
     if (v.size != size_in && size_in != 1 && v.size != 1)
         ad_raise("ad_accum_grad(): attempted to accumulate a gradient of size "
@@ -1639,12 +2814,95 @@ void ad_accum_grad(uint32_t index, const T &value, bool fail_if_missing) {
     v.accum(value, (uint32_t) size_in);
 }
 
+template <typename T>
+void ad_set_grad_sparse(uint32_t index, bool value) {
+    if (index == 0)
+        return;
+
+    ad_check_graph("ad_set_grad_sparse", index);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *v = state().find(index);
+    if (!v)
+        ad_raise("ad_set_grad_sparse(): referenced an unknown variable a%u!", index);
+
+    if (!is_jit_v<T> || (bool) v->sparse_grad == value)
+        return;
+
+    ad_log(Debug, "ad_set_grad_sparse(a%u, %i)", index, (int) value);
+
+    if (value) {
+        if (v->next_bwd)
+            ad_raise("ad_set_grad_sparse(): variable a%u is not a leaf of the "
+                     "AD graph!", index);
+        state().sparse_grads.try_emplace(index);
+    } else {
+        ad_densify(index, *v);
+        state().sparse_grads.erase(index);
+    }
+
+    v->sparse_grad = value;
+}
+
+template <typename T, typename I>
+bool ad_grad_sparse(uint32_t index, I &rows, T &values) {
+    if (index == 0)
+        return false;
+
+    ad_check_graph("ad_grad_sparse", index);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *v = state().find(index);
+    if (!v)
+        ad_raise("ad_grad_sparse(): referenced an unknown variable a%u!", index);
+
+    if (!v->sparse_grad)
+        return false;
+
+    if constexpr (is_jit_v<T>) {
+        std::vector<std::pair<Index, Value>> &chunks =
+            state().sparse_grads[index].chunks;
+
+        if (chunks.size() == 1) {
+            rows = chunks[0].first;
+            values = chunks[0].second;
+        } else {
+            uint32_t size = 0;
+            for (auto &c : chunks)
+                size += (uint32_t) width(c.first);
+
+            rows = zeros<I>(size);
+            values = zeros<T>(size);
+
+            uint32_t offset = 0;
+            for (auto &[r, val] : chunks) {
+                uint32_t n = (uint32_t) width(r);
+                I target = arange<I>(n) + offset;
+                scatter(rows, r, target);
+                scatter(values, val, target);
+                offset += n;
+            }
+
+            /* Replace the chunk list by the concatenated version so that
+               repeated queries don't redo this work */
+            chunks.clear();
+            if (size)
+                chunks.emplace_back(rows, values);
+        }
+    } else {
+        (void) rows; (void) values;
+    }
+
+    return true;
+}
+
 template <typename T> void ad_set_label(uint32_t index, const char *label) {
     if (index == 0)
         return;
-    std::lock_guard<std::mutex> guard(state.mutex);
+    ad_check_graph("ad_set_label", index);
+    lock_guard<StateMutex> guard(state().mutex);
     ad_log(Debug, "ad_set_label(a%u, \"%s\")", index, label ? label : "(null)");
-    Variable *v = state[index];
+    Variable *v = state()[index];
     if (v->free_label)
         free(v->label);
     v->label = strdup(label);
@@ -1655,13 +2913,16 @@ template <typename T> void ad_set_label(uint32_t index, const char *label) {
 template <typename T> const char *ad_label(uint32_t index) {
     if (index == 0)
         return nullptr;
-    std::lock_guard<std::mutex> guard(state.mutex);
-    return state[index]->label;
+    ad_check_graph("ad_label", index);
+    lock_guard<StateMutex> guard(state().mutex);
+    return state()[index]->label;
 }
 
 template <typename T>
 void ad_add_edge(uint32_t source_idx, uint32_t target_idx,
                  DiffCallback *callback) {
+    ad_check_graph("ad_add_edge", source_idx);
+    ad_check_graph("ad_add_edge", target_idx);
 
     /* Potentially turn off derivative tracking for some of the operands if
        we're within a scope that enables/disables gradient propagation
@@ -1678,15 +2939,15 @@ void ad_add_edge(uint32_t source_idx, uint32_t target_idx,
     if (source_idx == 0 || target_idx == 0)
         return;
 
-    std::lock_guard<std::mutex> guard(state.mutex);
+    lock_guard<StateMutex> guard(state().mutex);
     ad_log(Debug, "ad_add_edge(a%u -> a%u)", source_idx, target_idx);
     assert(source_idx < target_idx);
 
-    Variable *source = state[source_idx],
-             *target = state[target_idx];
+    Variable *source = state()[source_idx],
+             *target = state()[target_idx];
 
     uint32_t edge_index_new = ad_edge_new();
-    Edge &edge = state.edges[edge_index_new];
+    Edge &edge = state().edges[edge_index_new];
     edge.source = source_idx;
     edge.target = target_idx;
 
@@ -1700,7 +2961,7 @@ void ad_add_edge(uint32_t source_idx, uint32_t target_idx,
 
     source->next_fwd = edge_index_new;
     target->next_bwd = edge_index_new;
-    ad_inc_ref(source_idx, source);
+    ad_inc_ref_int(source_idx, source);
 }
 
 
@@ -1714,7 +2975,7 @@ static void ad_dfs_fwd(std::vector<EdgeRef> &todo, uint32_t index, Variable *v)
 
     uint32_t edge_id = v->next_fwd;
     while (edge_id) {
-        Edge &edge = state.edges[edge_id];
+        Edge &edge = state().edges[edge_id];
 
         if (!edge.visited) {
             edge.visited = 1;
@@ -1722,8 +2983,8 @@ static void ad_dfs_fwd(std::vector<EdgeRef> &todo, uint32_t index, Variable *v)
             ad_trace("ad_dfs_fwd(): enqueuing edge a%u -> a%u", index,
                      edge.target);
 
-            Variable *v2 = state[edge.target];
-            ad_inc_ref(edge.target, v2);
+            Variable *v2 = state()[edge.target];
+            ad_inc_ref_int(edge.target, v2);
             todo.emplace_back(edge_id, edge.source, edge.target);
             ad_dfs_fwd(todo, edge.target, v2);
         }
@@ -1736,7 +2997,7 @@ static void ad_dfs_fwd(std::vector<EdgeRef> &todo, uint32_t index, Variable *v)
 static void ad_dfs_bwd(std::vector<EdgeRef> &todo, uint32_t index, Variable *v) {
     uint32_t edge_id = v->next_bwd;
     while (edge_id) {
-        Edge &edge = state.edges[edge_id];
+        Edge &edge = state().edges[edge_id];
 
         if (!edge.visited) {
             edge.visited = 1;
@@ -1744,8 +3005,8 @@ static void ad_dfs_bwd(std::vector<EdgeRef> &todo, uint32_t index, Variable *v)
             ad_trace("ad_dfs_bwd(): enqueuing edge a%u -> a%u", index,
                      edge.source);
 
-            Variable *v2 = state[edge.source];
-            ad_inc_ref(index, v);
+            Variable *v2 = state()[edge.source];
+            ad_inc_ref_int(index, v);
             todo.emplace_back(edge_id, edge.source, edge.target);
             ad_dfs_bwd(todo, edge.source, v2);
         }
@@ -1761,83 +3022,438 @@ template <typename T> void ad_enqueue(ADMode mode, uint32_t index) {
     ad_trace("ad_enqueue_node(a%u, mode=%s)", index,
              mode == ADMode::Forward ? "forward" : "backward");
 
+    ad_check_graph("ad_enqueue", index);
+
     LocalState &ls = local_state;
 
-    std::lock_guard<std::mutex> guard(state.mutex);
+    lock_guard<StateMutex> guard(state().mutex);
+    uint64_t t0 = ad_time();
     switch (mode) {
         case ADMode::Forward:
-            ad_dfs_fwd(ls.todo, index, state[index]);
+            ad_dfs_fwd(ls.todo, index, state()[index]);
             break;
 
         case ADMode::Backward:
-            ad_dfs_bwd(ls.todo, index, state[index]);
+            ad_dfs_bwd(ls.todo, index, state()[index]);
             break;
 
         default:
             ad_raise("ad_enqueue(): invalid mode specified!");
     }
+    uint64_t t1 = ad_time();
+    stats.time_dfs.fetch_add(t1 - t0, std::memory_order_relaxed);
+    ls.time_dfs_pending += t1 - t0;
+    ad_trace_event("ad_enqueue", t0, t1);
 }
 
 // ==========================================================================
 // AD graph traversal
 // ==========================================================================
 
-template <typename Value>
-void ad_traverse(ADMode mode, uint32_t flags) {
-    LocalState &ls = local_state;
-
-    std::vector<EdgeRef> &todo_tls = ls.todo, todo;
-    if (todo_tls.empty())
-        return;
-
-    // Are we currently recording a megakernel?
-    bool rec = false;
-    if (is_jit_v<Value>)
-        rec = jit_flag(JitFlag::Recording);
-    DRJIT_MARK_USED(rec);
-
-    std::lock_guard<std::mutex> guard(state.mutex);
-    todo_tls.swap(todo);
-
-    if (mode != ADMode::Forward && mode != ADMode::Backward)
-        ad_raise("ad_traverse(): invalid mode specified!");
+/**
+ * \brief Bring enqueued edges into traversal order
+ *
+ * Backward traversal processes edges by decreasing (target, source, id), and
+ * forward traversal by increasing (source, target, id). Variable indices are
+ * allocated consecutively, hence the primary key of a large edge list usually
+ * covers a dense range. In this case, the edges are distributed into one
+ * bucket per primary key (a counting sort), and each bucket (containing the
+ * few edges that share a target/source variable) is then ordered by the
+ * remaining keys. This produces the same order as a comparison sort of the
+ * full tuple in linear time. Sparse key ranges use a comparison sort.
+ */
+static void ad_sort_edges(std::vector<EdgeRef> &todo, ADMode mode) {
+    bool backward = mode == ADMode::Backward;
+    size_t size = todo.size();
 
-    // Bring the edges into the appropriate order
-    std::sort(todo.begin(), todo.end(), [mode](EdgeRef e1, EdgeRef e2) {
-        if (mode == ADMode::Backward)
+    auto compare = [backward](EdgeRef e1, EdgeRef e2) {
+        if (backward)
             return std::tie(e1.target, e1.source, e1.id) >
                    std::tie(e2.target, e2.source, e2.id);
         else
             return std::tie(e1.source, e1.target, e1.id) <
                    std::tie(e2.source, e2.target, e2.id);
-    });
+    };
 
-    ad_log(Debug, "ad_traverse(): processing %zu edges in %s mode ..", todo.size(),
-           mode == ADMode::Forward ? "forward" : "backward");
+    uint32_t EdgeRef::*key = backward ? &EdgeRef::target : &EdgeRef::source;
+    uint32_t lo = 0xFFFFFFFFu, hi = 0;
+    if (size >= 1024) {
+        for (const EdgeRef &e : todo) {
+            lo = std::min(lo, e.*key);
+            hi = std::max(hi, e.*key);
+        }
+    }
 
-    /// Any edges with an ID less than this value will be postponed
-    uint32_t postpone_before = 0;
+    size_t range = (size_t) hi - (size_t) lo + 1;
+    if (size < 1024 || range > 4 * size) {
+        std::sort(todo.begin(), todo.end(), compare);
+        return;
+    }
+
+    // Bucket index, buckets are visited in increasing order
+    auto bucket = [backward, key, lo, hi](const EdgeRef &e) -> size_t {
+        return backward ? hi - e.*key : e.*key - lo;
+    };
+
+    std::unique_ptr<uint32_t[]> offset(new uint32_t[range + 1]());
+    for (const EdgeRef &e : todo)
+        offset[bucket(e) + 1]++;
+    for (size_t i = 0; i < range; ++i)
+        offset[i + 1] += offset[i];
+
+    std::vector<EdgeRef> tmp(size);
+    for (const EdgeRef &e : todo)
+        tmp[offset[bucket(e)]++] = e;
+
+    // Order the edges within each bucket by the remaining keys
+    for (size_t i = 0; i < size; ) {
+        size_t j = i + 1;
+        while (j < size && tmp[j].*key == tmp[i].*key)
+            ++j;
+        if (j - i > 1)
+            std::sort(tmp.begin() + i, tmp.begin() + j, compare);
+        i = j;
+    }
+
+    todo.swap(tmp);
+}
+
+/// Can the gradient of 'v' be observed once ad_traverse() finishes?
+static bool ad_observable(Variable *v, uint32_t flags) {
+    if (v->ref_count_grad > 0)
+        return true;
+
+    if (v->next_bwd) {
+        // Gradients of processed vertices may be cleared by postprocess()
+        bool clear = v->next_fwd ? (flags & (uint32_t) ADFlag::ClearInterior)
+                                 : (flags & (uint32_t) ADFlag::ClearInput);
+        if (clear)
+            return false;
+    }
+
+    // Are there references other than the ones held by edges and ad_traverse()?
+    return v->ref_count_int == RefCountIntMax || v->ref_count > v->ref_count_int;
+}
+
+/// Is it worthwhile to propagate gradients into the source 'v'?
+static bool ad_prune_keep(Variable *v, uint32_t flags) {
+    if (!v->prune_done) {
+        /* Interior vertices are handled in ad_prune_bwd() before their
+           outgoing edges, except when not all of their incoming edges were
+           enqueued. Conservatively keep the latter. */
+        v->prune_done = 1;
+        v->prune_keep = v->next_bwd ? 1 : (uint32_t) ad_observable(v, flags);
+    }
+    return v->prune_keep;
+}
+
+/**
+ * \brief Remove edges that cannot contribute to an observable gradient from
+ * a reverse-mode schedule
+ *
+ * Reverse-mode traversal visits every edge reachable from the enqueued
+ * variables, even when the gradient flowing along it ends up in variables
+ * that are no longer referenced (e.g. the parameters of a partially frozen
+ * model, whose gradient was disabled) or that are cleared right away. This
+ * function determines which vertices can lead to an observable gradient by
+ * visiting the (sorted) schedule in reverse, i.e., in topological order. Edges
+ * with user callbacks are always kept. Returns \c false if nothing could be
+ * pruned, and otherwise writes the remaining edges to 'out'.
+ */
+static bool ad_prune_bwd(const std::vector<EdgeRef> &todo,
+                         std::vector<EdgeRef> &out, uint32_t flags) {
+    size_t n = todo.size(), pruned = 0;
+
+    for (size_t j = n; j > 0; ) {
+        uint32_t target = todo[j - 1].target;
+        bool keep = false;
+
+        size_t i = j;
+        for (; i > 0 && todo[i - 1].target == target; --i) {
+            const EdgeRef &er = todo[i - 1];
+            const Special *special = state().edges[er.id].special;
+            bool keep_edge = (special && !special->local()) ||
+                             ad_prune_keep(state()[er.source], flags);
+            keep |= keep_edge;
+            pruned += !keep_edge;
+        }
+
+        Variable *v = state()[target];
+        v->prune_done = 1;
+        v->prune_keep = keep || ad_observable(v, flags);
+        j = i;
+    }
+
+    if (!pruned)
+        return false;
+
+    out.clear();
+    out.reserve(n - pruned);
+    for (const EdgeRef &er : todo) {
+        const Special *special = state().edges[er.id].special;
+        if ((special && !special->local()) || state()[er.source]->prune_keep)
+            out.push_back(er);
+    }
+
+    ad_log(Debug, "ad_traverse(): pruned %zu/%zu edges that cannot contribute "
+           "to an observable gradient.", pruned, n);
+
+    return true;
+}
+
+#if defined(DRJIT_ENABLE_JIT)
+/**
+ * \brief Level-scheduled parallel version of the reverse-mode traversal loop
+ *
+ * Every enqueued edge is assigned to the level of its source variable, which
+ * is one plus the largest level of any variable that consumes it. The
+ * gradients of all targets are final once the preceding levels have been
+ * processed, hence the source variables of a level can accumulate their
+ * gradients independently on the thread pool. Edges leading to the same
+ * source are accumulated in the same order as in the sequential traversal,
+ * which produces identical results.
+ *
+ * Special edges and reductions into scalar variables (which may launch
+ * kernels) are processed on the calling thread. The function returns \c
+ * false without modifying anything when the graph contains features that
+ * require the sequential traversal (custom operations, wavefront loops).
+ */
+static bool ad_traverse_parallel(const std::vector<EdgeRef> &todo,
+                                 uint32_t flags) {
+    struct Item {
+        uint32_t level, pos;
+        Variable *v0, *v1;
+    };
+
+    // Dependency levels, computed in a single pass (edges are sorted by target)
+    tsl::robin_map<uint32_t, uint32_t, UInt32Hasher> levels;
+    for (const EdgeRef &er : todo) {
+        const Edge &edge = state().edges[er.id];
+        if (edge.special && !edge.special->local())
+            return false;
+
+        if (state()[er.target]->loop_boundary)
+            return false;
+
+        auto it = levels.find(er.target);
+        uint32_t level = it != levels.end() ? it->second + 1 : 1;
+        uint32_t &level_source = levels[er.source];
+        level_source = std::max(level_source, level);
+    }
+
+    std::vector<Item> items(todo.size());
+    for (uint32_t i = 0; i < (uint32_t) todo.size(); ++i) {
+        const EdgeRef &er = todo[i];
+        items[i] = Item{ levels[er.source], i, state()[er.target],
+                         state()[er.source] };
+    }
+
+    std::sort(items.begin(), items.end(), [&todo](const Item &a, const Item &b) {
+        return std::tie(a.level, todo[a.pos].source, a.pos) <
+               std::tie(b.level, todo[b.pos].source, b.pos);
+    });
+
+    ad_log(Debug, "ad_traverse(): processing %zu edges on %u levels in parallel ..",
+           todo.size(), items.empty() ? 0u : items.back().level);
+
+    std::atomic<uint32_t> invalid_edge { 0 };
+
+    // Propagate gradients along the edges [start, end) into a single source
+    auto process = [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            const Item &item = items[i];
+            const EdgeRef &er = todo[item.pos];
+            Edge &edge = state().edges[er.id];
+            Variable *v0 = item.v0, *v1 = item.v1;
+
+            uint32_t grad_size = (uint32_t) width(v0->grad);
+            if (unlikely(grad_size != 1 && v0->size != grad_size)) {
+                if (grad_size != 0)
+                    invalid_edge.store(er.id);
+                continue;
+            }
+
+            if (unlikely(edge.special)) {
+                edge.special->backward(v1, v0, flags);
+
+                if (flags & (uint32_t) ADFlag::ClearEdges) {
+                    Special *special2 = edge.special;
+                    edge.special = nullptr;
+                    delete special2;
+                }
+            } else {
+                v1->edge_accum(v0->grad, edge, v0->size);
+
+                if (flags & (uint32_t) ADFlag::ClearEdges)
+                    edge.weight = Value();
+            }
+        }
+    };
+
+    std::vector<std::pair<size_t, size_t>> parallel, serial;
+    IndexSet labeled;
+    uint32_t jit_flags_ = jit_flags();
+
+    for (size_t i = 0; i < items.size(); ) {
+        uint32_t level = items[i].level;
+        parallel.clear();
+        serial.clear();
+
+        // Group the edges of this level by source variable
+        size_t j = i;
+        while (j < items.size() && items[j].level == level) {
+            uint32_t source = todo[items[j].pos].source;
+            bool safe = true;
+            size_t k = j;
+
+            for (; k < items.size() && items[k].level == level &&
+                   todo[items[k].pos].source == source; ++k) {
+                const Item &item = items[k];
+                safe &= !state().edges[todo[item.pos].id].special &&
+                        !(item.v1->size == 1 && item.v0->size != 1);
+
+                if (unlikely(item.v0->custom_label) &&
+                    labeled.insert(todo[item.pos].target).second &&
+                    width(item.v0->grad) != 0) {
+                    char tmp[256];
+                    snprintf(tmp, 256, "%s_grad", item.v0->label);
+                    set_label(item.v0->grad, tmp);
+                }
+            }
+
+            (safe ? parallel : serial).emplace_back(j, k);
+            j = k;
+        }
+
+        if (parallel.size() > 1) {
+            drjit::parallel_for(
+                drjit::blocked_range<uint32_t>(0, (uint32_t) parallel.size(), 16),
+                [&](drjit::blocked_range<uint32_t> range) {
+                    if (jit_flags() != jit_flags_)
+                        jit_set_flags(jit_flags_);
+                    for (uint32_t l : range)
+                        process(parallel[l].first, parallel[l].second);
+                }
+            );
+        } else if (parallel.size() == 1) {
+            process(parallel[0].first, parallel[0].second);
+        }
+
+        for (auto [start, end] : serial)
+            process(start, end);
+
+        uint32_t invalid = invalid_edge.load();
+        if (unlikely(invalid)) {
+            const Edge &edge = state().edges[invalid];
+            const Variable *v0 = state()[edge.target];
+            ad_raise("ad_traverse(): gradient propagation encountered "
+                     "variable a%u (\"%s\") with an invalid gradient size "
+                     "(expected size %u, actual size %u)!",
+                     edge.target, v0->label ? v0->label : "", v0->size,
+                     (uint32_t) width(v0->grad));
+        }
+
+        i = j;
+    }
+
+    return true;
+}
+#endif
+
+/// Number of edges between evaluations in asynchronous mode (ADFlag::Async)
+static constexpr size_t AsyncInterval = 1024;
+
+template <typename Value>
+void ad_traverse(ADMode mode, uint32_t flags) {
+    LocalState &ls = local_state;
+
+    std::vector<EdgeRef> &todo_tls = ls.todo, todo;
+    if (todo_tls.empty())
+        return;
+
+    // Are we currently recording a megakernel?
+    bool rec = false;
+    if (is_jit_v<Value>)
+        rec = jit_flag(JitFlag::Recording);
+    DRJIT_MARK_USED(rec);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    todo_tls.swap(todo);
+
+    if (mode != ADMode::Forward && mode != ADMode::Backward)
+        ad_raise("ad_traverse(): invalid mode specified!");
+
+    uint64_t t0 = ad_time();
+    stats.traversals.fetch_add(1, std::memory_order_relaxed);
+
+    bool retain = !(flags & (uint32_t) ADFlag::ClearEdges);
+
+    /* Bring the edges into the appropriate order. The result only depends on
+       the enqueued edge list, hence the sorted list of a previous traversal
+       can be reused when the same graph is traversed once more. */
+    if (ls.schedule_mode == mode && ls.schedule_in.size() == todo.size() &&
+        memcmp(ls.schedule_in.data(), todo.data(),
+               todo.size() * sizeof(EdgeRef)) == 0) {
+        ad_log(Debug, "ad_traverse(): reusing schedule of previous traversal.");
+        todo = ls.schedule;
+    } else {
+        if (retain)
+            ls.schedule_in = todo;
+
+        ad_sort_edges(todo, mode);
+
+        if (retain) {
+            ls.schedule = todo;
+            ls.schedule_mode = mode;
+        }
+    }
+
+    if (!retain) {
+        // The traversed edges will be removed, release the cached schedule
+        ls.schedule_in = std::vector<EdgeRef>();
+        ls.schedule = std::vector<EdgeRef>();
+        ls.schedule_mode = ADMode::Primal;
+    }
+
+    /// Any edges with an ID less than this value will be postponed
+    uint32_t postpone_before = 0;
     if (!ls.scopes.empty() && ls.scopes.back().isolate)
         postpone_before = ls.scopes.back().variable_index;
 
+    /* Skip edges that cannot contribute to an observable gradient. This
+       is disabled within AD scopes and while recording, where gradients may
+       be observed in ways that cannot be detected here. */
+    std::vector<EdgeRef> todo_pruned;
+    bool prune_pass = mode == ADMode::Backward && ls.scopes.empty() && !rec,
+         prune = prune_pass && ad_prune_bwd(todo, todo_pruned, flags);
+    std::vector<EdgeRef> &todo_run = prune ? todo_pruned : todo;
+
+    uint64_t t1 = ad_time(), time_special = 0;
+    size_t edge_count = todo_run.size();
+    stats.time_sort.fetch_add(t1 - t0, std::memory_order_relaxed);
+    ad_trace_event("ad_traverse: sort", t0, t1, todo_run.size());
+
+    ad_log(Debug, "ad_traverse(): processing %zu edges in %s mode ..",
+           todo_run.size(), mode == ADMode::Forward ? "forward" : "backward");
+
     std::vector<Value> dr_loop_todo;
     auto postprocess = [&](uint32_t prev_i, uint32_t cur_i) {
         if (!prev_i || prev_i == cur_i)
             return;
 
-        Variable *cur  = cur_i ? state[cur_i] : nullptr,
-                 *prev = state[prev_i];
+        Variable *cur  = cur_i ? state()[cur_i] : nullptr,
+                 *prev = state()[prev_i];
 
         /* Wave-front style evaluation of dr.Loop with differentiable
-           variables produces nodes with label 'dr_loop' at the boundary of
+           variables produces nodes marked 'loop_boundary' at the boundary of
            each iteration. It's good if we dr::schedule() and then finally
            evaluate the gradient of all such variables at once so that AD
            tarversal produces reasonably sized kernels (i.e. with an evaluation
            granularity matching the loop iterations of the original/primal
            evaluation). The code below does just that. */
 
-        bool dr_loop_prev = prev->label && strstr(prev->label, "dr_loop"),
-             dr_loop_cur  = cur && cur->label && strstr(cur->label, "dr_loop");
+        bool dr_loop_prev = prev->loop_boundary,
+             dr_loop_cur  = cur && cur->loop_boundary;
 
         if (dr_loop_prev) {
             dr_loop_todo.push_back(prev->grad);
@@ -1876,9 +3492,54 @@ void ad_traverse(ADMode mode, uint32_t flags) {
     uint32_t v0i_prev = 0;
     uint32_t last_edge_id = 0;
 
+    bool parallel = false;
+#if defined(DRJIT_ENABLE_JIT)
+    if ((flags & (uint32_t) ADFlag::Parallel) && mode == ADMode::Backward &&
+        !rec && postpone_before == 0 && !is_cuda_v<Value>)
+        parallel = ad_traverse_parallel(todo_run, flags);
+#endif
+
+    /* Asynchronous mode: evaluate the gradients accumulated so far every
+       'AsyncInterval' edges. This splits the derivative computation into a
+       sequence of kernels that run while the remainder of the graph is
+       traversed (the evaluation does not wait for their completion). */
+    bool async = false;
+    if constexpr (is_jit_v<Value>)
+        async = (flags & (uint32_t) ADFlag::Async) && !rec && !parallel;
+    IndexSet async_todo;
+    size_t async_edges = 0;
+
+    auto async_eval = [&]() {
+        if constexpr (is_jit_v<Value>) {
+            for (uint32_t index : async_todo) {
+                Variable *v = state()[index];
+                if (unlikely(v->pending_grad))
+                    ad_flush_pending(index, v);
+                if (is_valid(v->grad))
+                    schedule(v->grad);
+            }
+            ad_trace("ad_traverse(): evaluating %zu partial gradients",
+                     async_todo.size());
+            async_todo.clear();
+            async_edges = 0;
+            stats.async_evals.fetch_add(1, std::memory_order_relaxed);
+
+            // Don't block other threads while the kernels are compiled
+            unlock_guard<StateMutex> guard(state().mutex);
+            eval();
+        }
+    };
+
     // This is the main AD traversal loop
-    for (EdgeRef &er : todo) {
-        Edge &edge = state.edges[er.id];
+    for (EdgeRef &er : todo_run) {
+        if (parallel) {
+            // Gradients were already propagated, only clear them below
+            postprocess(v0i_prev, er.target);
+            v0i_prev = er.target;
+            continue;
+        }
+
+        Edge &edge = state().edges[er.id];
 
         uint32_t v0i, v1i;
         if (mode == ADMode::Forward) {
@@ -1903,8 +3564,13 @@ void ad_traverse(ADMode mode, uint32_t flags) {
                     "garbage collected between enqueuing and traversal steps!",
                     v0i, v1i);
 
-        Variable *v0 = state[v0i],
-                 *v1 = state[v1i];
+        Variable *v0 = state()[v0i],
+                 *v1 = state()[v1i];
+
+        if constexpr (is_jit_v<Value>) {
+            if (unlikely(v0->pending_grad))
+                ad_flush_pending(v0i, v0);
+        }
 
         uint32_t grad_size = (uint32_t) width(v0->grad);
 
@@ -1923,7 +3589,7 @@ void ad_traverse(ADMode mode, uint32_t flags) {
                     "the variables being differentiated and call "
                     "dr.traverse(dr.ADFlag.ClearEdges) *before* entering this "
                     "scope.",
-                    v0i, v1i, postpone_before, state.variable_index);
+                    v0i, v1i, postpone_before, state().variable_index);
             }
         }
 
@@ -1943,6 +3609,17 @@ void ad_traverse(ADMode mode, uint32_t flags) {
         postprocess(v0i_prev, v0i);
         v0i_prev = v0i;
 
+        if constexpr (is_jit_v<Value>) {
+            // Nothing to do if the gradient is a literal zero (except for callbacks)
+            const Value &g = v0->grad;
+            if (g.is_literal() && g[0] == 0 &&
+                (!edge.special || edge.special->local())) {
+                ad_trace("ad_traverse(): skipping edge a%u -> a%u (zero "
+                         "gradient).", v0i, v1i);
+                continue;
+            }
+        }
+
         ad_trace("ad_traverse(): processing edge a%u -> a%u ..", v0i, v1i);
 
         if (unlikely(v0->custom_label)) {
@@ -1953,14 +3630,18 @@ void ad_traverse(ADMode mode, uint32_t flags) {
         }
 
         if (unlikely(edge.special)) {
+            uint64_t t2 = ad_time();
             if (mode == ADMode::Forward)
                 edge.special->forward(v0, v1, flags);
             else
                 edge.special->backward(v1, v0, flags);
+            uint64_t t2_end = ad_time();
+            time_special += t2_end - t2;
+            ad_trace_event("ad_traverse: special", t2, t2_end);
 
             if (flags & (uint32_t) ADFlag::ClearEdges) {
                 // Edge may have been invalidated by callback, look up once more
-                Edge &edge2 = state.edges[er.id];
+                Edge &edge2 = state().edges[er.id];
                 if (edge2.source == er.source && edge2.target == er.target) {
                     Special *special2 = edge2.special;
                     edge2.special = nullptr;
@@ -1968,15 +3649,38 @@ void ad_traverse(ADMode mode, uint32_t flags) {
                 }
             }
         } else {
-            v1->mul_accum(v0->grad, edge.weight, v0->size);
+            if constexpr (is_jit_v<Value>) {
+                if (v1->pending_grad || is_valid(v1->grad))
+                    ad_defer_accum(v1i, v1,
+                                   v1->edge_term(v0->grad, edge, v0->size));
+                else
+                    v1->edge_accum(v0->grad, edge, v0->size);
+            } else {
+                v1->edge_accum(v0->grad, edge, v0->size);
+            }
 
             if (flags & (uint32_t) ADFlag::ClearEdges)
                 edge.weight = Value();
         }
+
+        if (async) {
+            async_todo.insert(v1i);
+            if (++async_edges == AsyncInterval)
+                async_eval();
+        }
     }
 
+    ad_flush_pending_all();
     postprocess(v0i_prev, 0);
 
+    if (async)
+        async_eval();
+
+    uint64_t t3 = ad_time();
+    stats.time_traverse.fetch_add(t3 - t1, std::memory_order_relaxed);
+    stats.time_special.fetch_add(time_special, std::memory_order_relaxed);
+    ad_trace_event("ad_traverse: propagate", t1, t3, todo_run.size());
+
     ad_log(Debug, (flags & (uint32_t) ADFlag::ClearEdges)
                       ? "ad_traverse(): decreasing reference counts .."
                       : "ad_traverse(): decreasing reference counts "
@@ -1987,7 +3691,12 @@ void ad_traverse(ADMode mode, uint32_t flags) {
         if (!er.target)
             continue;
 
-        Edge &edge = state.edges[er.id];
+        if (prune_pass) {
+            state()[er.source]->prune_done = state()[er.target]->prune_done = 0;
+            state()[er.source]->prune_keep = state()[er.target]->prune_keep = 0;
+        }
+
+        Edge &edge = state().edges[er.id];
         if (unlikely(edge.source != er.source || edge.target != er.target))
             ad_fail(
                 "ad_traverse(): internal error: edge a%u -> a%u was garbage "
@@ -1998,8 +3707,8 @@ void ad_traverse(ADMode mode, uint32_t flags) {
 
         edge.visited = 0;
 
-        Variable *source = state[er.source],
-                 *target = state[er.target];
+        Variable *source = state()[er.source],
+                 *target = state()[er.target];
 
         if (flags & (uint32_t) ADFlag::ClearEdges) {
             ad_trace("ad_traverse(): removing edge a%u -> a%u", er.source, er.target);
@@ -2008,12 +3717,12 @@ void ad_traverse(ADMode mode, uint32_t flags) {
             uint32_t edge_id_prev = 0,
                      edge_id_cur = source->next_fwd;
             while (edge_id_cur) {
-                Edge &e2 = state.edges[edge_id_cur];
+                Edge &e2 = state().edges[edge_id_cur];
                 ad_trace("ad_traverse(): visiting forward edge a%u -> a%u", e2.source, e2.target);
 
                 if (edge_id_cur == er.id) {
                     if (edge_id_prev)
-                        state.edges[edge_id_prev].next_fwd = e2.next_fwd;
+                        state().edges[edge_id_prev].next_fwd = e2.next_fwd;
                     else
                         source->next_fwd = e2.next_fwd;
                     break;
@@ -2033,11 +3742,11 @@ void ad_traverse(ADMode mode, uint32_t flags) {
             edge_id_prev = 0;
             edge_id_cur = target->next_bwd;
             while (edge_id_cur) {
-                Edge &e2 = state.edges[edge_id_cur];
+                Edge &e2 = state().edges[edge_id_cur];
 
                 if (edge_id_cur == er.id) {
                     if (edge_id_prev)
-                        state.edges[edge_id_prev].next_bwd = e2.next_bwd;
+                        state().edges[edge_id_prev].next_bwd = e2.next_bwd;
                     else
                         target->next_bwd = e2.next_bwd;
                     break;
@@ -2057,15 +3766,29 @@ void ad_traverse(ADMode mode, uint32_t flags) {
             if (unlikely(edge.special))
                 ls.cleanup.push_back(edge.special);
             edge.reset();
-            state.unused_edges.push_back(er.id);
+            state().unused_edges.push_back(er.id);
 
-            ad_dec_ref(er.source, source);
-            target = state[er.target]; // pointer might have changed
+            ad_dec_ref_int(er.source, source);
+            target = state()[er.target]; // pointer might have changed
+
+            if (unlikely(target->hessian)) {
+                state().hessians.erase(er.target);
+                target->hessian = 0;
+            }
         }
 
-        ad_dec_ref(er.target, target);
+        ad_dec_ref_int(er.target, target);
     }
 
+    uint64_t t4 = ad_time();
+    stats.time_cleanup.fetch_add(t4 - t3, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> guard_last(stats.last_mutex);
+        stats.last = TraversalRecord{ ls.time_dfs_pending, t1 - t0, t3 - t1,
+                                      time_special, t4 - t3, edge_count };
+    }
+    ls.time_dfs_pending = 0;
+    ad_trace_event("ad_traverse: cleanup", t3, t4);
     ad_log(Debug, "ad_traverse(): done.");
 
     std::vector<Special *> temp, &cleanup = ls.cleanup;
@@ -2084,6 +3807,382 @@ void ad_traverse(ADMode mode, uint32_t flags) {
     todo_tls.swap(todo);
 }
 
+// ==========================================================================
+// Hessian-vector products
+// ==========================================================================
+
+/* A Hessian-vector product H v is the forward-mode derivative of the
+   reverse-mode gradient along the direction v. Reverse-mode traversal
+   accumulates 'grad[source] += weight * grad[target]' for every edge, and
+   differentiating this step along v yields
+
+       dgrad[source] += weight * dgrad[target] + dweight * grad[target].
+
+   The first term is the same linear propagation performed by a regular
+   backward traversal, and 'dweight' only depends on the tangents of the
+   operands and on the second-order terms recorded by ad_set_hessian().
+   Instead of building a second AD graph for the gradient computation,
+   ad_hvp() therefore traverses the existing graph three times:
+
+   1. A forward traversal computes the tangents along v, from which the
+      'dweight' values of all recorded operations are obtained.
+
+   2. A backward traversal computes the gradient at every vertex.
+
+   3. The contributions 'dweight * grad[target]' are accumulated into the
+      operands, and a final backward traversal propagates them (along with
+      everything else) to the inputs.
+
+   The cost is thus comparable to that of a few gradient evaluations. */
+
+template <typename T> void ad_set_record_hessian(bool value) {
+    local_state.record_hessian = value;
+}
+
+template <typename T> bool ad_record_hessian() noexcept(true) {
+    return local_state.record_hessian;
+}
+
+template <typename T>
+void ad_set_hessian(uint32_t index, uint32_t op_count, const uint32_t *op,
+                    const T *terms) {
+    if (index == 0 || !local_state.record_hessian)
+        return;
+
+    if (op_count > 3)
+        ad_raise("ad_set_hessian(): at most 3 operands are supported!");
+
+    // Recorded computation (e.g. in a virtual function call) is not supported
+    if constexpr (is_jit_v<T>) {
+        if (jit_flag(JitFlag::Recording))
+            return;
+    }
+
+    // Mark nonlinear operations whose second-order terms are unavailable
+    if (op_count == 0) {
+        lock_guard<StateMutex> guard(state().mutex);
+        state().hessians[index].size = HessianUnavailable;
+        state()[index]->hessian = 1;
+        return;
+    }
+
+    uint32_t term_count = op_count * (op_count + 1) / 2;
+    bool nonzero = false;
+    for (uint32_t i = 0; i < term_count; ++i) {
+        if constexpr (is_jit_v<T>)
+            nonzero |= !terms[i].is_literal() || terms[i][0] != 0;
+        else
+            nonzero |= terms[i] != 0;
+    }
+
+    // Nothing to do for operations with a vanishing Hessian (e.g. add())
+    if (!nonzero)
+        return;
+
+    lock_guard<StateMutex> guard(state().mutex);
+    Variable *v = state()[index];
+    HessianTerms &h = state().hessians[index];
+    h.size = op_count;
+    for (uint32_t i = 0; i < op_count; ++i)
+        h.sources[i] = op[i];
+    for (uint32_t i = 0; i < term_count; ++i)
+        h.terms[i] = terms[i];
+    v->hessian = 1;
+
+    ad_trace("ad_set_hessian(a%u): recorded %u terms", index, term_count);
+}
+
+/// Reset the gradients of the given variables (the caller must hold the lock)
+static void ad_clear_grads(const std::vector<uint32_t> &indices) {
+    for (uint32_t index : indices) {
+        Variable *v = state().find(index);
+        if (!v)
+            continue;
+
+        if (unlikely(v->pending_grad)) {
+            state().pending.erase(index);
+            v->pending_grad = 0;
+        }
+
+        if (unlikely(v->sparse_grad))
+            state().sparse_grads[index].chunks.clear();
+
+        v->grad = Value();
+    }
+}
+
+/// Return the sorted set of variables referenced by an edge list
+static std::vector<uint32_t> ad_edge_vertices(const std::vector<EdgeRef> &todo) {
+    std::vector<uint32_t> result;
+    result.reserve(todo.size() * 2);
+    for (const EdgeRef &er : todo) {
+        result.push_back(er.source);
+        result.push_back(er.target);
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+/// Does 'value' hold a gradient that may be nonzero?
+template <typename T = Value> bool ad_grad_nonzero(const T &value) {
+    if constexpr (is_jit_v<T>)
+        return value.valid() && !(value.is_literal() && value[0] == 0);
+    else
+        return value != 0;
+}
+
+template <typename T> void ad_hvp(uint32_t index, uint32_t flags) {
+    LocalState &ls = local_state;
+
+    if (index == 0 || ls.todo.empty())
+        return;
+
+    if (!ls.scopes.empty() && ls.scopes.back().isolate)
+        ad_raise("ad_hvp(): Hessian-vector products cannot be computed within "
+                 "a dr.isolate_grad() scope!");
+
+    if constexpr (is_jit_v<T>) {
+        if (jit_flag(JitFlag::Recording))
+            ad_raise("ad_hvp(): Hessian-vector products cannot be computed "
+                     "while recording computation!");
+    }
+
+    ad_log(Debug, "ad_hvp(a%u): computing Hessian-vector product ..", index);
+
+    // 1. Propagate the tangents of the forward-enqueued inputs
+    std::vector<uint32_t> vert_fwd = ad_edge_vertices(ls.todo), targets;
+    Value seed;
+
+    /* Second-order terms are only needed for operations that depend on the
+       inputs, i.e. those reached by the forward traversal. Unsupported ones
+       are reported once it has consumed the queue. */
+    uint32_t callback = 0;
+    {
+        lock_guard<StateMutex> guard(state().mutex);
+
+        for (const EdgeRef &er : ls.todo) {
+            const Special *special = state().edges[er.id].special;
+            if (special && !special->linear())
+                callback = er.target;
+        }
+        Variable *v = state()[index];
+        if (unlikely(v->pending_grad))
+            ad_flush_pending(index, v);
+        seed = v->grad;
+
+        for (const EdgeRef &er : ls.todo)
+            targets.push_back(er.target);
+        ad_clear_grads(targets);
+    }
+
+    ad_traverse<Value>(ADMode::Forward, (uint32_t) ADFlag::ClearNone);
+
+    std::vector<uint32_t> active;
+    {
+        lock_guard<StateMutex> guard(state().mutex);
+
+        uint32_t unsupported = 0;
+        for (uint32_t i : vert_fwd) {
+            Variable *v = state().find(i);
+            if (v && v->hessian &&
+                state().hessians[i].size == HessianUnavailable)
+                unsupported = i;
+        }
+
+        if (callback || unsupported) {
+            ad_clear_grads(vert_fwd);
+            if (callback)
+                ad_raise("ad_hvp(): the computation involves custom derivative "
+                         "callbacks (e.g. a CustomOp or a differentiable "
+                         "virtual function call, see a%u), whose second-order "
+                         "terms are unknown!", callback);
+            else
+                ad_raise("ad_hvp(): the second-order terms of operation a%u "
+                         "(\"%s\") are not supported!", unsupported,
+                         state()[unsupported]->label);
+        }
+
+        for (uint32_t i : vert_fwd) {
+            Variable *v = state().find(i);
+            if (!v || !v->hessian)
+                continue;
+
+            HessianTerms &h = state().hessians[i];
+            const Value *tangent[3] { };
+            for (uint32_t k = 0; k < h.size; ++k) {
+                Variable *vk = h.sources[k] ? state().find(h.sources[k]) : nullptr;
+                if (vk && ad_grad_nonzero(vk->grad))
+                    tangent[k] = &vk->grad;
+            }
+
+            bool found = false;
+            for (uint32_t j = 0; j < h.size; ++j) {
+                Value dw{};
+                for (uint32_t k = 0; k < h.size; ++k) {
+                    uint32_t r = std::min(j, k), c = std::max(j, k),
+                             t = r * h.size - r * (r + 1) / 2 + c;
+                    if (!tangent[k] || !ad_grad_nonzero(h.terms[t]))
+                        continue;
+                    Value term = h.terms[t] * *tangent[k];
+                    dw = is_valid(dw) ? dw + term : term;
+                }
+                found |= is_valid(dw);
+                h.dweight[j] = std::move(dw);
+            }
+
+            if (found)
+                active.push_back(i);
+        }
+
+        ad_clear_grads(vert_fwd);
+    }
+
+    // 2. Compute the gradient at every vertex
+    ad_enqueue<Value>(ADMode::Backward, index);
+    std::vector<uint32_t> vert_bwd = ad_edge_vertices(ls.todo);
+    {
+        lock_guard<StateMutex> guard(state().mutex);
+        ad_clear_grads(vert_bwd);
+        state()[index]->grad = seed;
+    }
+
+    ad_traverse<Value>(ADMode::Backward, (uint32_t) ADFlag::ClearNone);
+
+    // 3. Differentiate the gradient propagation along the tangents
+    {
+        lock_guard<StateMutex> guard(state().mutex);
+
+        struct Term {
+            uint32_t index;
+            uint32_t size;
+            Value value;
+        };
+
+        std::vector<Term> terms;
+        for (uint32_t i : active) {
+            Variable *v = state().find(i);
+            if (!v)
+                continue;
+
+            HessianTerms &h = state().hessians[i];
+            bool nonzero = ad_grad_nonzero(v->grad);
+            for (uint32_t j = 0; j < h.size; ++j) {
+                if (nonzero && h.sources[j] && is_valid(h.dweight[j]))
+                    terms.push_back({ h.sources[j], v->size,
+                                      v->grad * Variable::guard_weight(
+                                                    v->grad, h.dweight[j]) });
+                h.dweight[j] = Value();
+            }
+        }
+
+        ad_clear_grads(vert_bwd);
+
+        for (Term &t : terms) {
+            Variable *v = state().find(t.index);
+            if (v)
+                v->accum(t.value, t.size);
+        }
+    }
+
+    ad_enqueue<Value>(ADMode::Backward, index);
+    ad_traverse<Value>(ADMode::Backward, flags);
+
+    ad_log(Debug, "ad_hvp(): done.");
+}
+
+// ==========================================================================
+// Private per-thread AD graphs
+// ==========================================================================
+
+/* Threads that each differentiate their own independent computation (e.g.
+   per-request gradients in a server) otherwise contend on the locks of the
+   shared graph. 'ad_isolated_graph_enter()' instead redirects the variables
+   created by the current thread into a private 'State' instance with locking
+   disabled. Its variable indices are taken from a dedicated slice of the
+   upper half of the index space (bits 24..30 identify the graph, and bits
+   20..23 the generation of its slot), which limits each private graph to
+   2^20 simultaneously allocated indices and the process to
+   'IsolatedGraphCount' private graphs at once.
+   Other threads may still release arrays that reference such variables. The
+   resulting reference count changes are queued and applied by the owner
+   (see 'ad_defer_foreign_ref()'). When the owner exits, the remaining
+   variables keep the graph alive until they are released as well (see
+   'ad_isolated_graph_orphan()'). */
+
+/// Reset the thread-local traversal state when switching between graphs
+static void ad_isolated_graph_check(const char *func) {
+    LocalState &ls = local_state;
+    if (!ls.todo.empty() || !ls.implicit.empty() || !ls.scopes.empty())
+        ad_raise("%s(): cannot switch AD graphs while there are enqueued "
+                 "variables or active AD scopes!", func);
+    ls.schedule_in = std::vector<EdgeRef>();
+    ls.schedule = std::vector<EdgeRef>();
+    ls.schedule_mode = ADMode::Primal;
+}
+
+template <typename T> void ad_isolated_graph_enter() {
+    LocalState &ls = local_state;
+    if (state_ptr != &state_global)
+        ad_raise("ad_isolated_graph_enter(): the current thread already uses "
+                 "a private AD graph!");
+    ad_isolated_graph_check("ad_isolated_graph_enter");
+
+    if (!ls.isolated) {
+        std::lock_guard<std::mutex> guard(isolated_graphs_mutex);
+        uint32_t id = 0;
+        while (id < IsolatedGraphCount &&
+               isolated_graphs[id].load(std::memory_order_relaxed))
+            ++id;
+        if (id == IsolatedGraphCount)
+            ad_raise("ad_isolated_graph_enter(): too many private AD graphs "
+                     "(at most %u) are in use!", IsolatedGraphCount);
+
+        State *graph;
+        if (!isolated_graphs_unused.empty()) {
+            graph = isolated_graphs_unused.back();
+            isolated_graphs_unused.pop_back();
+        } else {
+            graph = new State();
+        }
+
+        graph->owner.store(&ls, std::memory_order_relaxed);
+        graph->mutex.enabled = false;
+        for (VariableShard &shard : graph->shards)
+            shard.mutex.enabled = false;
+
+        uint32_t generation = isolated_generations[id];
+        isolated_generations[id] = (generation + 1) & (IsolatedGenerationCount - 1);
+
+        // The last range ends at 2^32, where 'ad_var_new()' wraps around as well
+        graph->generation = generation;
+        graph->index_begin = graph->variable_index =
+            0x80000000u | (id << 24) | (generation << 20);
+        graph->index_end = graph->index_begin + (1u << 20);
+        isolated_graphs[id].store(graph, std::memory_order_release);
+        ls.isolated = graph;
+    }
+
+    state_ptr = ls.isolated;
+    ad_apply_foreign_refs();
+    ad_log(Debug, "ad_isolated_graph_enter(): using private graph a%u..",
+           state().index_begin);
+}
+
+template <typename T> void ad_isolated_graph_leave() {
+    if (state_ptr == &state_global)
+        ad_raise("ad_isolated_graph_leave(): the current thread does not use a "
+                 "private AD graph!");
+    ad_isolated_graph_check("ad_isolated_graph_leave");
+    ad_apply_foreign_refs();
+    state_ptr = &state_global;
+    ad_log(Debug, "ad_isolated_graph_leave()");
+}
+
+template <typename T> bool ad_isolated_graph() noexcept(true) {
+    return state_ptr != &state_global;
+}
+
 // ==========================================================================
 // Tracking of implicit dependencies. The following functions are used by
 // the implementations of differentiable virtual function calls, to
@@ -2101,75 +4200,101 @@ template <typename Value> size_t ad_implicit() {
     return local_state.implicit.size();
 }
 
-template <typename Value> void ad_extract_implicit(size_t snapshot, uint32_t *out) {
-    std::vector<EdgeRef> &implicit = local_state.implicit;
+template <typename Value> size_t ad_extract_implicit(size_t snapshot, uint32_t *out) {
+    LocalState &ls = local_state;
+    std::vector<EdgeRef> &implicit = ls.implicit;
     size_t size = implicit.size();
 
     if (snapshot == size)
-        return;
+        return 0;
     else if (unlikely(snapshot > size))
         ad_raise("ad_extract_implicit(): invalid input arguments!");
 
-    size_t count = size - snapshot;
-    ad_trace("ad_extract_implicit(): extracting %zu implicit dependencies.",
-             count);
+    // Many edges (e.g. gathers by different instances) often share a source
+    IndexSet &seen = ls.implicit_seen;
+    seen.clear();
 
-    for (size_t i = 0; i < count; ++i) {
-        uint32_t index = implicit[snapshot + i].source;
-        if (state.variables.find(index) != state.variables.end())
-            out[i] = index;
+    size_t count = 0;
+    for (size_t i = snapshot; i < size; ++i) {
+        uint32_t index = implicit[i].source;
+        if (state().find(index) && seen.insert(index).second)
+            out[count++] = index;
     }
 
+    ad_trace("ad_extract_implicit(): extracted %zu distinct implicit "
+             "dependencies from %zu edges.", count, size - snapshot);
+
     std::sort(out, out + count);
-    uint32_t *ptr = std::unique(out, out + count);
-    while (ptr != out + count)
-        *ptr++ = 0;
+
+    /* Outside of AD scopes, no recording is in progress that could still
+       consume these entries (they are now captured by the caller). Drop them
+       so that the tracker doesn't grow for the lifetime of the thread */
+    if (ls.scopes.empty())
+        implicit.resize(snapshot);
+
+    return count;
 }
 
 template <typename Value> void ad_enqueue_implicit(size_t snapshot) {
     LocalState &ls = local_state;
-    std::vector<EdgeRef> &implicit = local_state.implicit;
+    std::vector<EdgeRef> &implicit = ls.implicit;
+    std::vector<uint32_t> &pinned = ls.implicit_pinned;
     size_t size = implicit.size();
 
-    if (snapshot == size)
-        return;
-    else if (unlikely(snapshot > size))
+    if (unlikely(snapshot > size))
         ad_raise("ad_enqueue_implicit(): invalid input arguments!");
 
     ad_trace("ad_enqueue_implicit(): enqueuing %zu implicit dependencies.",
              size - snapshot);
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    for (size_t i = snapshot; i < implicit.size(); ++i) {
+    IndexSet &seen = ls.implicit_seen;
+    seen.clear();
+    size_t pinned_start = pinned.size();
+
+    lock_guard<StateMutex> guard(state().mutex);
+    for (size_t i = snapshot; i < size; ++i) {
         const EdgeRef &er = implicit[i];
-        Edge &e = state.edges[er.id];
+        Edge &e = state().edges[er.id];
 
         if (e.source != er.source || e.target != er.target || e.visited)
             continue;
 
         e.visited = 1;
-        ad_inc_ref(er.target, state[er.target]);
+        ad_inc_ref_int(er.target, state()[er.target]);
         ls.todo.push_back(er);
-        ad_dfs_fwd(ls.todo, er.target, state[er.target]);
-        state[er.source]->ref_count_grad++;
+        ad_dfs_fwd(ls.todo, er.target, state()[er.target]);
+
+        // Keep the gradient of every source alive (once) until dequeued
+        if (seen.insert(er.source).second) {
+            state()[er.source]->ref_count_grad++;
+            pinned.push_back(er.source);
+        }
     }
+
+    pinned.push_back((uint32_t) (pinned.size() - pinned_start));
 }
 
-template <typename Value> void ad_dequeue_implicit(size_t snapshot) {
-    std::vector<EdgeRef> &implicit = local_state.implicit;
-    size_t size = implicit.size();
+template <typename Value> void ad_dequeue_implicit(size_t /* snapshot */) {
+    std::vector<uint32_t> &pinned = local_state.implicit_pinned;
 
-    if (snapshot == size)
-        return;
-    else if (unlikely(snapshot > size))
-        ad_raise("ad_dequeue_implicit(): invalid input arguments!");
+    if (unlikely(pinned.empty()))
+        ad_raise("ad_dequeue_implicit(): no matching call to "
+                 "ad_enqueue_implicit()!");
 
-    ad_trace("ad_dequeue_implicit(): dequeuing %zu implicit dependencies.",
-             size - snapshot);
+    uint32_t count = pinned.back();
+    pinned.pop_back();
 
-    std::lock_guard<std::mutex> guard(state.mutex);
-    for (size_t i = snapshot; i < implicit.size(); ++i)
-        state[implicit[i].source]->ref_count_grad--;
+    ad_trace("ad_dequeue_implicit(): dequeuing %u implicit dependencies.",
+             count);
+
+    lock_guard<StateMutex> guard(state().mutex);
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t index = pinned.back();
+        pinned.pop_back();
+        Variable *v = state().find(index);
+        if (v && v->ref_count_grad > 0)
+            v->ref_count_grad--;
+    }
 }
 
 // ==========================================================================
@@ -2177,16 +4302,12 @@ template <typename Value> void ad_dequeue_implicit(size_t snapshot) {
 // ==========================================================================
 
 extern void RENAME(ad_whos)() {
-    std::lock_guard<std::mutex> guard(state.mutex);
+    lock_guard<StateMutex> guard(state().mutex);
 
-    std::vector<uint32_t> indices;
-    indices.reserve(state.variables.size());
-    for (auto &kv: state.variables)
-        indices.push_back(kv.first);
-    std::sort(indices.begin(), indices.end());
+    std::vector<uint32_t> indices = state().indices();
 
     for (uint32_t id : indices) {
-        const Variable *v = state[id];
+        const Variable *v = state()[id];
         buffer.fmt("  %-7i ", id);
         size_t sz = buffer.fmt("%u", v->ref_count);
         buffer.fmt("%*s%-12u%-8s\n", 11 - (int) sz, "", v->size,
@@ -2194,15 +4315,44 @@ extern void RENAME(ad_whos)() {
     }
 }
 
-template <typename Value> const char *ad_graphviz() {
-    std::lock_guard<std::mutex> guard(state.mutex);
+extern void RENAME(ad_stats)(LabelMap *labels, GraphStats &out) {
+    lock_guard<StateMutex> guard(state().mutex);
+
+    if (labels) {
+        state().for_each([&](uint32_t, const Variable &v) {
+            const char *label = v.label ? v.label : "unnamed",
+                       *sep   = strrchr(label, '/');
 
-    std::vector<uint32_t> indices;
-    indices.reserve(state.variables.size());
-    for (const auto& it : state.variables)
-        indices.push_back(it.first);
+            LabelStats &entry = (*labels)[sep ? std::string(label, sep)
+                                              : std::string(label)];
+            entry.variables++;
+
+            uint32_t edge = v.next_bwd;
+            while (edge) {
+                entry.edges++;
+                edge = state().edges[edge].next_bwd;
+            }
+
+            entry.grad_bytes += width(v.grad) * sizeof(scalar_t<Value>);
+        });
+    }
+
+    size_t variables = state().variable_count.load(std::memory_order_relaxed);
+    out.variables += variables;
+    out.edges += state().edges.size() - state().unused_edges.size() - 1;
+#if defined(DRJIT_AD_DENSE_STORAGE)
+    out.variable_bytes += state().variables.memory_usage();
+#else
+    out.variable_bytes += variables * sizeof(Variable);
+#endif
+    out.edge_bytes += state().edges.capacity() * sizeof(Edge) +
+                      state().unused_edges.capacity() * sizeof(uint32_t);
+}
+
+template <typename Value> const char *ad_graphviz() {
+    lock_guard<StateMutex> guard(state().mutex);
 
-    std::sort(indices.begin(), indices.end());
+    std::vector<uint32_t> indices = state().indices();
     buffer.clear();
     buffer.put("digraph {\n"
                    "    rankdir=BT;\n"
@@ -2213,7 +4363,7 @@ template <typename Value> const char *ad_graphviz() {
     size_t current_hash = 0, current_depth = 1;
 
     for (uint32_t index : indices) {
-        const Variable *v = state[index];
+        const Variable *v = state()[index];
         const char *label = v->label;
         const char *label_without_prefix = label;
 
@@ -2333,17 +4483,17 @@ template <typename Value> const char *ad_graphviz() {
     }
 
     for (uint32_t index : indices) {
-        const Variable *v = state[index];
+        const Variable *v = state()[index];
 
         uint32_t edge = v->next_bwd, edge_count = 0;
         while (edge) {
-            edge = state.edges[edge].next_bwd;
+            edge = state().edges[edge].next_bwd;
             edge_count++;
         }
         edge = v->next_bwd;
         uint32_t edge_ctr = edge_count;
         while (edge) {
-            const Edge &e = state.edges[edge];
+            const Edge &e = state().edges[edge];
             if (edge_count == 1)
                 buffer.fmt("    %i -> %i%s;\n", e.target, e.source,
                            e.special ? " [color=red]" : "");
@@ -2374,17 +4524,21 @@ template <typename Value> const char *ad_graphviz() {
 template DRJIT_EXPORT void ad_inc_ref_impl<Value>(uint32_t) noexcept;
 template DRJIT_EXPORT uint32_t ad_inc_ref_cond_impl<Value>(uint32_t) noexcept;
 template DRJIT_EXPORT void ad_dec_ref_impl<Value>(uint32_t) noexcept;
+template DRJIT_EXPORT void ad_inc_ref_n_impl<Value>(size_t, const uint32_t *) noexcept;
+template DRJIT_EXPORT void ad_dec_ref_n_impl<Value>(size_t, const uint32_t *) noexcept;
 template DRJIT_EXPORT uint32_t ad_new<Value>(const char *, size_t, uint32_t,
                                             uint32_t *, Value *);
 template DRJIT_EXPORT Value ad_grad<Value>(uint32_t, bool);
 template DRJIT_EXPORT void ad_set_grad<Value>(uint32_t, const Value &, bool);
 template DRJIT_EXPORT void ad_accum_grad<Value>(uint32_t, const Value &, bool);
+template DRJIT_EXPORT void ad_set_grad_sparse<Value>(uint32_t, bool);
+template DRJIT_EXPORT bool ad_grad_sparse<Value, Index>(uint32_t, Index &, Value &);
 template DRJIT_EXPORT void ad_set_label<Value>(uint32_t, const char *);
 template DRJIT_EXPORT const char *ad_label<Value>(uint32_t);
 template DRJIT_EXPORT void ad_enqueue<Value>(ADMode, uint32_t);
 template DRJIT_EXPORT void ad_traverse<Value>(ADMode, uint32_t);
 template DRJIT_EXPORT size_t ad_implicit<Value>();
-template DRJIT_EXPORT void ad_extract_implicit<Value>(size_t, uint32_t*);
+template DRJIT_EXPORT size_t ad_extract_implicit<Value>(size_t, uint32_t*);
 template DRJIT_EXPORT void ad_enqueue_implicit<Value>(size_t);
 template DRJIT_EXPORT void ad_dequeue_implicit<Value>(size_t);
 template DRJIT_EXPORT const char *ad_graphviz<Value>();
@@ -2401,6 +4555,14 @@ template DRJIT_EXPORT void ad_scope_enter<Value>(ADScope, size_t, const uint32_t
 template DRJIT_EXPORT void ad_scope_leave<Value>(bool);
 template DRJIT_EXPORT bool ad_grad_enabled<Value>(uint32_t);
 template DRJIT_EXPORT bool ad_enabled<Value>() noexcept;
+template DRJIT_EXPORT void ad_set_record_hessian<Value>(bool);
+template DRJIT_EXPORT bool ad_record_hessian<Value>() noexcept;
+template DRJIT_EXPORT void ad_set_hessian<Value>(uint32_t, uint32_t,
+                                                 const uint32_t *, const Value *);
+template DRJIT_EXPORT void ad_hvp<Value>(uint32_t, uint32_t);
+template DRJIT_EXPORT void ad_isolated_graph_enter<Value>();
+template DRJIT_EXPORT void ad_isolated_graph_leave<Value>();
+template DRJIT_EXPORT bool ad_isolated_graph<Value>() noexcept;
 NAMESPACE_END(detail)
 
 template struct DRJIT_EXPORT DiffArray<detail::Value>;
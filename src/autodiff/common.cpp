@@ -1,11 +1,16 @@
 #include "common.h"
 #include <tsl/robin_set.h>
 #include <algorithm>
+#include <tuple>
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdexcept>
+#include <memory>
+#include <mutex>
 
-Buffer buffer{0};
+thread_local Buffer buffer{0};
+std::atomic<size_t> lock_contention{0};
+Statistics stats;
 
 void ad_fail(const char *fmt, ...) {
     fprintf(stderr, "\n\nCritical failure in Dr.Jit AD backend: ");
@@ -115,11 +120,17 @@ namespace drjit {
     namespace detail {
         extern void ad_whos_scalar_f32();
         extern void ad_whos_scalar_f64();
+        extern void ad_stats_scalar_f32(LabelMap *, GraphStats &);
+        extern void ad_stats_scalar_f64(LabelMap *, GraphStats &);
 #if defined(DRJIT_ENABLE_JIT)
         extern void ad_whos_cuda_f32();
         extern void ad_whos_cuda_f64();
         extern void ad_whos_llvm_f32();
         extern void ad_whos_llvm_f64();
+        extern void ad_stats_cuda_f32(LabelMap *, GraphStats &);
+        extern void ad_stats_cuda_f64(LabelMap *, GraphStats &);
+        extern void ad_stats_llvm_f32(LabelMap *, GraphStats &);
+        extern void ad_stats_llvm_f64(LabelMap *, GraphStats &);
 #endif
     }
 
@@ -178,6 +189,199 @@ namespace drjit {
         return buffer.get();
     }
 
+    DRJIT_EXPORT size_t ad_lock_contention() {
+        return lock_contention.load(std::memory_order_relaxed);
+    }
+
+    DRJIT_EXPORT void ad_lock_contention_clear() {
+        lock_contention.store(0, std::memory_order_relaxed);
+    }
+
+    /// Query the graph size (and optionally label statistics) of all variants
+    static GraphStats ad_stats_collect(LabelMap *labels) {
+        GraphStats result;
+        detail::ad_stats_scalar_f32(labels, result);
+        detail::ad_stats_scalar_f64(labels, result);
+        #if defined(DRJIT_ENABLE_JIT)
+            #if defined(DRJIT_ENABLE_CUDA)
+                detail::ad_stats_cuda_f32(labels, result);
+                detail::ad_stats_cuda_f64(labels, result);
+            #endif
+            detail::ad_stats_llvm_f32(labels, result);
+            detail::ad_stats_llvm_f64(labels, result);
+        #endif
+        return result;
+    }
+
+    DRJIT_EXPORT ADStats ad_stats() {
+        auto ms = [](const std::atomic<uint64_t> &value) {
+            return (double) value.load(std::memory_order_relaxed) * 1e-6;
+        };
+
+        GraphStats graph = ad_stats_collect(nullptr);
+
+        ADStats result;
+        result.traversals     = (size_t) stats.traversals.load(std::memory_order_relaxed);
+        result.async_evals    = (size_t) stats.async_evals.load(std::memory_order_relaxed);
+        result.time_dfs       = ms(stats.time_dfs);
+        result.time_sort      = ms(stats.time_sort);
+        result.time_traverse  = ms(stats.time_traverse);
+        result.time_special   = ms(stats.time_special);
+        result.time_cleanup   = ms(stats.time_cleanup);
+        {
+            std::lock_guard<std::mutex> guard(stats.last_mutex);
+            result.last_time_dfs      = (double) stats.last.time_dfs * 1e-6;
+            result.last_time_sort     = (double) stats.last.time_sort * 1e-6;
+            result.last_time_traverse = (double) stats.last.time_traverse * 1e-6;
+            result.last_time_special  = (double) stats.last.time_special * 1e-6;
+            result.last_time_cleanup  = (double) stats.last.time_cleanup * 1e-6;
+            result.last_edges         = stats.last.edges;
+        }
+        result.variables      = graph.variables;
+        result.edges          = graph.edges;
+        result.edges_peak     = std::max(stats.edges_peak.load(std::memory_order_relaxed),
+                                         result.edges);
+        result.variable_bytes = graph.variable_bytes;
+        result.edge_bytes     = graph.edge_bytes;
+        return result;
+    }
+
+    DRJIT_EXPORT void ad_stats_clear() {
+        stats.traversals.store(0, std::memory_order_relaxed);
+        stats.async_evals.store(0, std::memory_order_relaxed);
+        stats.time_dfs.store(0, std::memory_order_relaxed);
+        stats.time_sort.store(0, std::memory_order_relaxed);
+        stats.time_traverse.store(0, std::memory_order_relaxed);
+        stats.time_special.store(0, std::memory_order_relaxed);
+        stats.time_cleanup.store(0, std::memory_order_relaxed);
+        stats.edges_peak.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> guard(stats.last_mutex);
+        stats.last = TraversalRecord();
+    }
+
+    DRJIT_EXPORT void ad_stats_labels(void (*callback)(void *, const char *,
+                                                       size_t, size_t, size_t),
+                                      void *payload) {
+        LabelMap labels;
+        ad_stats_collect(&labels);
+
+        // Report the labels holding the most gradient storage first
+        std::vector<std::pair<std::string, LabelStats>> sorted;
+        sorted.reserve(labels.size());
+        for (const auto &kv : labels)
+            sorted.emplace_back(kv.first, kv.second);
+        std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b) {
+            return std::tie(a.second.grad_bytes, a.second.edges, b.first) >
+                   std::tie(b.second.grad_bytes, b.second.edges, a.first);
+        });
+
+        for (const auto &kv : sorted)
+            callback(payload, kv.first.c_str(), kv.second.variables,
+                     kv.second.edges, kv.second.grad_bytes);
+    }
+
+    struct TraceEvent {
+        const char *name, *category;
+        uint64_t start, end, arg;
+        uint32_t thread;
+    };
+
+    DRJIT_EXPORT std::atomic<bool> trace_active{false};
+
+    /// Ring buffer of events, only reallocated while tracing is disabled
+    static std::unique_ptr<TraceEvent[]> trace_events;
+    static size_t trace_capacity = 0;
+    static std::atomic<uint64_t> trace_count{0};
+    static std::atomic<uint32_t> trace_threads{0};
+    static uint64_t trace_origin = 0;
+    static std::mutex trace_mutex;
+    static thread_local uint32_t trace_thread = 0;
+
+    DRJIT_EXPORT void trace_enable(size_t capacity) {
+        std::lock_guard<std::mutex> guard(trace_mutex);
+        if (trace_active.load(std::memory_order_relaxed))
+            return;
+        if (capacity == 0)
+            throw std::runtime_error(
+                "trace_enable(): the capacity must be positive!");
+        if (capacity != trace_capacity) {
+            trace_events.reset(new TraceEvent[capacity]);
+            trace_capacity = capacity;
+            trace_count.store(0, std::memory_order_relaxed);
+        }
+        if (trace_count.load(std::memory_order_relaxed) == 0)
+            trace_origin = ad_time();
+        trace_active.store(true, std::memory_order_release);
+    }
+
+    DRJIT_EXPORT void trace_disable() {
+        trace_active.store(false, std::memory_order_release);
+    }
+
+    DRJIT_EXPORT void trace_clear() {
+        std::lock_guard<std::mutex> guard(trace_mutex);
+        trace_count.store(0, std::memory_order_relaxed);
+        trace_origin = ad_time();
+    }
+
+    DRJIT_EXPORT void trace_record(const char *name, const char *category,
+                                   uint64_t start, uint64_t end, uint64_t arg) {
+        if (!trace_active.load(std::memory_order_acquire))
+            return;
+        if (unlikely(!trace_thread))
+            trace_thread = ++trace_threads;
+        uint64_t i = trace_count.fetch_add(1, std::memory_order_relaxed);
+        trace_events[i % trace_capacity] =
+            TraceEvent{ name, category, start, end, arg, trace_thread };
+    }
+
+    DRJIT_EXPORT const char *trace_intern(const char *str) {
+        static tsl::robin_set<std::string> strings;
+        std::lock_guard<std::mutex> guard(trace_mutex);
+        return strings.emplace(str).first->c_str();
+    }
+
+    /// Append a JSON string literal
+    static void trace_put_string(const char *str) {
+        buffer.putc('"');
+        for (; *str; ++str) {
+            char c = *str;
+            if (c == '"' || c == '\\')
+                buffer.putc('\\');
+            if ((unsigned char) c >= 0x20)
+                buffer.putc(c);
+        }
+        buffer.putc('"');
+    }
+
+    DRJIT_EXPORT const char *trace_export() {
+        std::lock_guard<std::mutex> guard(trace_mutex);
+        uint64_t count = trace_count.load(std::memory_order_acquire),
+                 first = count > trace_capacity ? count - trace_capacity : 0;
+
+        buffer.clear();
+        buffer.put("{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+        for (uint64_t i = first; i < count; ++i) {
+            const TraceEvent &e = trace_events[i % trace_capacity];
+            uint64_t start = e.start > trace_origin ? e.start - trace_origin : 0,
+                     end   = e.end > e.start ? e.end - e.start : 0;
+            if (i != first)
+                buffer.putc(',');
+            buffer.put("\n  {\"name\": ");
+            trace_put_string(e.name);
+            buffer.put(", \"cat\": ");
+            trace_put_string(e.category);
+            buffer.fmt(", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, "
+                       "\"pid\": 1, \"tid\": %u",
+                       start * 1e-3, end * 1e-3, e.thread);
+            if (e.arg != (uint64_t) -1)
+                buffer.fmt(", \"args\": {\"size\": %llu}", (unsigned long long) e.arg);
+            buffer.putc('}');
+        }
+        buffer.put("\n]}\n");
+        return buffer.get();
+    }
+
     namespace detail {
         /// Custom graph edge for implementing custom differentiable operations
         struct DRJIT_EXPORT DiffCallback {
@@ -4,8 +4,13 @@
 #include <cstdlib>
 #include <cstdarg>
 #include <vector>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
 #include <drjit/fwd.h>
 #include <drjit-core/jit.h>
+#include <tsl/robin_map.h>
 
 #if !defined(likely)
 #  if !defined(_MSC_VER)
@@ -25,6 +30,71 @@ constexpr LogLevel log_level = LogLevel::Trace;
 constexpr LogLevel log_level = LogLevel::Info;
 #endif
 
+/// Number of times that a thread had to wait to acquire one of the AD locks
+extern std::atomic<size_t> lock_contention;
+
+/// Timings (in nanoseconds) and number of processed edges of one traversal
+struct TraversalRecord {
+    uint64_t time_dfs = 0, time_sort = 0, time_traverse = 0, time_special = 0,
+             time_cleanup = 0;
+    size_t edges = 0;
+};
+
+/// Cumulative statistics of all AD variants (times in nanoseconds), see ad_stats()
+struct Statistics {
+    std::atomic<uint64_t> traversals{0}, async_evals{0}, time_dfs{0},
+                          time_sort{0}, time_traverse{0}, time_special{0},
+                          time_cleanup{0};
+
+    /// Largest number of edges that were simultaneously in use
+    std::atomic<size_t> edges_peak{0};
+
+    /// Most recently completed traversal (of any thread), protected by 'last_mutex'
+    TraversalRecord last;
+    std::mutex last_mutex;
+};
+
+extern Statistics stats;
+
+/// Size of the AD graph of one variant, accumulated by ad_stats()
+struct GraphStats {
+    size_t variables = 0, edges = 0, variable_bytes = 0, edge_bytes = 0;
+};
+
+/// Per-label information collected by the AD variants, see ad_stats_labels()
+struct LabelStats {
+    size_t variables = 0, edges = 0, grad_bytes = 0;
+};
+
+using LabelMap = tsl::robin_map<std::string, LabelStats>;
+
+/// Monotonic time stamp (in nanoseconds) used for the AD statistics
+inline uint64_t ad_time() {
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * \brief Replacement for std::lock_guard that keeps track of lock contention
+ *
+ * The lock is first acquired using a non-blocking 'try_lock()' call. When this
+ * fails, the global 'lock_contention' counter is incremented before blocking.
+ */
+template <typename T> class lock_guard {
+public:
+    lock_guard(T &mutex) : m_mutex(mutex) {
+        if (unlikely(!m_mutex.try_lock())) {
+            lock_contention.fetch_add(1, std::memory_order_relaxed);
+            m_mutex.lock();
+        }
+    }
+    ~lock_guard() { m_mutex.unlock(); }
+    lock_guard(const lock_guard &) = delete;
+    lock_guard &operator=(const lock_guard &) = delete;
+private:
+    T &m_mutex;
+};
+
 /// RAII helper for *unlocking* a mutex
 template <typename T> class unlock_guard {
 public:
@@ -132,7 +202,7 @@ struct UInt32Hasher {
     }
 };
 
-extern Buffer buffer;
+extern thread_local Buffer buffer;
 static constexpr LogLevel Disable = LogLevel::Disable;
 static constexpr LogLevel Error   = LogLevel::Error;
 static constexpr LogLevel Warn    = LogLevel::Warn;
@@ -155,6 +225,9 @@ extern void ad_raise(const char *fmt, ...);
 #endif
 extern void ad_log(LogLevel level, const char *fmt, ...);
 
+/// Like malloc(), but terminates the application when the allocation fails
+extern void *malloc_check(size_t size);
+
 namespace drjit {
     extern const char *ad_prefix();
     DRJIT_EXPORT bool ad_enabled() noexcept;
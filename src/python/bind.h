@@ -7,10 +7,44 @@
 #include <drjit/quaternion.h>
 #include <drjit/autodiff.h>
 #include <drjit/sh.h>
+#include <drjit/util.h>
 #include <pybind11/functional.h>
 
 extern py::handle array_base, array_name, array_init, tensor_init, array_configure;
 
+/// Callbacks that install the arithmetic fast paths, see \ref FastPath
+extern std::vector<void (*)()> fast_path_init;
+
+/// Array types whose entries are stored contiguously in host memory
+template <typename Array>
+constexpr bool has_buffer_v =
+    !dr::is_jit_v<Array> && (dr::is_tensor_v<Array> || Array::Depth == 1) &&
+    (!Array::IsMask || dr::is_dynamic_v<Array>);
+
+/// Describe the memory of an array for the Python buffer protocol
+template <typename Array> py::buffer_info array_buffer(Array &a) {
+    using Scalar = std::conditional_t<Array::IsMask, bool, dr::scalar_t<Array>>;
+    std::vector<py::ssize_t> shape, strides;
+
+    if constexpr (dr::is_tensor_v<Array>) {
+        py::ssize_t stride = sizeof(Scalar);
+        shape.resize(a.ndim());
+        strides.resize(a.ndim());
+        for (size_t i = a.ndim(); i > 0; --i) {
+            shape[i - 1] = (py::ssize_t) a.shape(i - 1);
+            strides[i - 1] = stride;
+            stride *= shape[i - 1];
+        }
+    } else {
+        shape.push_back((py::ssize_t) a.size());
+        strides.push_back((py::ssize_t) sizeof(Scalar));
+    }
+
+    return py::buffer_info(a.data(), sizeof(Scalar),
+                           py::format_descriptor<Scalar>::format(),
+                           (py::ssize_t) shape.size(), shape, strides);
+}
+
 template <typename Array>
 auto bind_type(py::module_ &m, bool scalar_mode = false) {
     using Scalar = std::conditional_t<Array::IsMask, bool, dr::scalar_t<Array>>;
@@ -58,8 +92,16 @@ auto bind_type(py::module_ &m, bool scalar_mode = false) {
     py::object type = py::cast(Type),
                name = array_name(prefix, type, shape, scalar_mode);
 
-    auto cls = py::class_<Array>(
-        m, PyUnicode_AsUTF8AndSize(name.ptr(), nullptr), array_base);
+    const char *name_s = PyUnicode_AsUTF8AndSize(name.ptr(), nullptr);
+    auto cls = [&]() {
+        if constexpr (has_buffer_v<Array>)
+            return py::class_<Array>(m, name_s, array_base, py::buffer_protocol());
+        else
+            return py::class_<Array>(m, name_s, array_base);
+    }();
+
+    if constexpr (has_buffer_v<Array>)
+        cls.def_buffer([](Array &a) { return array_buffer(a); });
 
     array_configure(cls, shape, type, py::handle((PyObject *) value_obj));
     register_implicit_conversions(typeid(Array));
@@ -71,7 +113,8 @@ template <typename Array>
 void bind_basic_methods(py::class_<Array> &cls) {
     using Value = std::conditional_t<Array::IsMask, dr::mask_t<dr::value_t<Array>>,
                                      dr::value_t<Array>>;
-    cls.def("entry_", [](const Array &a, size_t i) -> Value { return a.entry(i); })
+    cls.def("entry_", [](const Array &a, size_t i) -> Value { return a.entry(i); },
+            jit_release_gil<Array>())
        .def("set_entry_", [](Array &a, size_t i, const Value &value) {
            a.set_entry(i, value);
        });
@@ -88,7 +131,7 @@ void bind_basic_methods(py::class_<Array> &cls) {
                   (!dr::is_jit_v<Array> && !dr::is_mask_v<Array>))
         cls.def("data_", [](const Array &a) {
             return (uintptr_t) a.data();
-        });
+        }, jit_release_gil<Array>());
 
     if constexpr (dr::is_dynamic_array_v<Array>) {
         cls.def("__len__", &Array::size);
@@ -131,6 +174,102 @@ void bind_generic_constructor(py::class_<Array> &cls) {
         }, py::detail::is_new_style_constructor());
 }
 
+/**
+ * \brief Arithmetic fast path in the number slots of a bound array type
+ *
+ * Operators on Python arrays are normally routed through ``router.py``,
+ * which promotes the operands to a common type before calling the C++
+ * implementation. When both operands already have the exact same type, the
+ * functions below call the C++ implementation directly. Everything else
+ * (mixed types, scalars, errors) is forwarded to the original slot, so the
+ * behavior is unchanged.
+ *
+ * The slots are patched by \c drjit.detail.install_fast_paths() once the
+ * Python operators have been installed in \c ArrayBase.
+ */
+template <typename Array> struct FastPath {
+    static inline PyTypeObject *type = nullptr;
+    static inline binaryfunc add, sub, mul, div, iadd, isub, imul;
+
+    template <typename Func>
+    static PyObject *binary(PyObject *a, PyObject *b, binaryfunc fallback,
+                            Func func) {
+        if (Py_TYPE(a) == type && Py_TYPE(b) == type) {
+            try {
+                return py::cast(func(py::cast<const Array &>(a),
+                                     py::cast<const Array &>(b)))
+                    .release()
+                    .ptr();
+            } catch (...) {
+                // Let the regular code path raise a properly translated error
+            }
+        }
+        return fallback(a, b);
+    }
+
+    template <typename Func>
+    static PyObject *inplace(PyObject *a, PyObject *b, binaryfunc fallback,
+                             Func func) {
+        if (Py_TYPE(a) == type && Py_TYPE(b) == type) {
+            try {
+                Array &a_ = py::cast<Array &>(a);
+                a_ = func(a_, py::cast<const Array &>(b));
+                Py_INCREF(a);
+                return a;
+            } catch (...) { }
+        }
+        return fallback(a, b);
+    }
+
+    static PyObject *add_(PyObject *a, PyObject *b) {
+        return binary(a, b, add, [](const Array &x, const Array &y) { return x.add_(y); });
+    }
+
+    static PyObject *sub_(PyObject *a, PyObject *b) {
+        return binary(a, b, sub, [](const Array &x, const Array &y) { return x.sub_(y); });
+    }
+
+    static PyObject *mul_(PyObject *a, PyObject *b) {
+        return binary(a, b, mul, [](const Array &x, const Array &y) { return x.mul_(y); });
+    }
+
+    static PyObject *div_(PyObject *a, PyObject *b) {
+        return binary(a, b, div, [](const Array &x, const Array &y) { return x.div_(y); });
+    }
+
+    static PyObject *iadd_(PyObject *a, PyObject *b) {
+        return inplace(a, b, iadd, [](const Array &x, const Array &y) { return x.add_(y); });
+    }
+
+    static PyObject *isub_(PyObject *a, PyObject *b) {
+        return inplace(a, b, isub, [](const Array &x, const Array &y) { return x.sub_(y); });
+    }
+
+    static PyObject *imul_(PyObject *a, PyObject *b) {
+        return inplace(a, b, imul, [](const Array &x, const Array &y) { return x.mul_(y); });
+    }
+
+    static void patch(binaryfunc &slot, binaryfunc &fallback, binaryfunc func) {
+        if (slot && slot != func) {
+            fallback = slot;
+            slot = func;
+        }
+    }
+
+    static void install() {
+        PyNumberMethods *nb = type->tp_as_number;
+        patch(nb->nb_add, add, add_);
+        patch(nb->nb_subtract, sub, sub_);
+        patch(nb->nb_multiply, mul, mul_);
+        patch(nb->nb_inplace_add, iadd, iadd_);
+        patch(nb->nb_inplace_subtract, isub, isub_);
+        patch(nb->nb_inplace_multiply, imul, imul_);
+        // Only the division operator that router.py accepts for this type
+        patch(Array::IsFloat ? nb->nb_true_divide : nb->nb_floor_divide, div,
+              div_);
+    }
+};
+
 template <typename Array> auto bind(py::module_ &m, bool scalar_mode = false) {
     auto cls = bind_type<Array>(m, scalar_mode);
     bind_generic_constructor(cls);
@@ -215,9 +354,9 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
     });
 
     if constexpr (Array::IsMask) {
-        cls.def("all_", &Array::all_);
-        cls.def("any_", &Array::any_);
-        cls.def("count_", &Array::count_);
+        cls.def("all_", &Array::all_, jit_release_gil<Array>());
+        cls.def("any_", &Array::any_, jit_release_gil<Array>());
+        cls.def("count_", &Array::count_, jit_release_gil<Array>());
     } else {
         if constexpr (sizeof(Scalar) == 4) {
             cls.def_static("reinterpret_array_",
@@ -261,11 +400,11 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         cls.def(Array::IsFloat ? "itruediv_" : "ifloordiv_",
                 [](Array *a, const Array &b) { *a = a->div_(b); return a; });
 
-        cls.def("dot_",  &Array::dot_);
-        cls.def("min_",  &Array::min_);
-        cls.def("max_",  &Array::max_);
-        cls.def("sum_",  &Array::sum_);
-        cls.def("prod_", &Array::prod_);
+        cls.def("dot_",  &Array::dot_,  jit_release_gil<Array>());
+        cls.def("min_",  &Array::min_,  jit_release_gil<Array>());
+        cls.def("max_",  &Array::max_,  jit_release_gil<Array>());
+        cls.def("sum_",  &Array::sum_,  jit_release_gil<Array>());
+        cls.def("prod_", &Array::prod_, jit_release_gil<Array>());
 
         cls.def("and_", [](const Array &a, const Mask &b) {
             return a.and_(static_cast<const dr::mask_t<Array> &>(b));
@@ -339,7 +478,7 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         if constexpr (Array::IsMask) {
             cls.def("compress_", [](const Array &source) {
                 return dr::compress(source);
-            });
+            }, jit_release_gil<Array>());
         } else {
             cls.def("scatter_reduce_",
                     [](const Array& value, ReduceOp op, Array& target, const UInt32& index, const Mask& mask) {
@@ -360,8 +499,14 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         cls.def("is_evaluated_", [](Array &value) { return value.is_evaluated(); });
 
         if constexpr (!Array::IsMask) {
-            cls.def("prefix_sum_", &Array::prefix_sum_);
-            cls.def("block_sum_", &Array::block_sum_);
+            cls.def("prefix_sum_", &Array::prefix_sum_,
+                    py::call_guard<py::gil_scoped_release>());
+            cls.def("block_sum_", &Array::block_sum_,
+                    py::call_guard<py::gil_scoped_release>());
+            if constexpr (sizeof(Scalar) >= 4)
+                cls.def("argsort_", [](const Array &value) {
+                    return dr::uint32_array_t<Array>(dr::argsort(value));
+                }, py::call_guard<py::gil_scoped_release>());
         }
     }
 
@@ -430,6 +575,40 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         });
     }
 
+    if constexpr (dr::is_dynamic_array_v<Array>) {
+        /* Bulk copy from a 1D buffer with the same element type (or None).
+           Single precision arrays also accept half precision buffers, which
+           are converted in bulk on the host (or within a kernel on JIT
+           backends, after uploading the half precision data). */
+        cls.def_static("load_buffer_", [](py::handle o) -> py::object {
+            if (!PyObject_CheckBuffer(o.ptr()))
+                return py::none();
+            py::buffer_info info = py::reinterpret_borrow<py::buffer>(o).request();
+            if (info.ndim != 1 || info.strides[0] != info.itemsize)
+                return py::none();
+            size_t size = (size_t) info.shape[0];
+
+            if constexpr (std::is_same_v<Scalar, float>) {
+                if (info.itemsize == 2 && info.format == "e") {
+                    if constexpr (Array::IsJIT) {
+                        using Detached = dr::detached_t<Array>;
+                        using Half = dr::float16_array_t<Detached>;
+                        return py::cast(Array(Detached(dr::load<Half>(info.ptr, size))));
+                    } else {
+                        Array result = dr::empty<Array>(size);
+                        dr::half_to_float32((const dr::half *) info.ptr,
+                                            result.data(), size);
+                        return py::cast(result);
+                    }
+                }
+            }
+
+            if (!py::detail::compare_buffer_info<Scalar>::compare(info))
+                return py::none();
+            return py::cast(drjit::load<Array>(info.ptr, size));
+        });
+    }
+
     if constexpr (dr::is_jit_v<Array>) {
         cls.def_static("map_", [](uintptr_t ptr, size_t size, std::function<void (void)> callback) {
             Array result = Array::map_((void *) ptr, size, false);
@@ -447,8 +626,12 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         }, "ptr"_a, "size"_a, "callback"_a = py::none());
     }
 
-    if constexpr (Array::IsJIT)
-        cls.def("migrate_", &Array::migrate_);
+    if constexpr (Array::IsJIT) {
+        cls.def("migrate_", &Array::migrate_,
+                py::call_guard<py::gil_scoped_release>());
+        cls.def("migrate_device_", &Array::migrate_device_,
+                py::call_guard<py::gil_scoped_release>());
+    }
 
     if constexpr (Array::IsJIT) {
         cls.def_property_readonly("index", &Array::index);
@@ -472,12 +655,20 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
             cls.def("grad_", [](const Array &a) { return a.grad_(); });
             cls.def("set_grad_", [](Array &a, dr::detached_t<Array> &value) { a.set_grad_(value); });
             cls.def("accum_grad_", [](Array &a, dr::detached_t<Array> &value) { a.accum_grad_(value); });
+            cls.def("set_grad_sparse_", &Array::set_grad_sparse_);
+            cls.def("grad_sparse_", &Array::grad_sparse_);
             cls.def("set_grad_enabled_", &Array::set_grad_enabled_);
             cls.def("grad_enabled_", &Array::grad_enabled_);
             cls.def("enqueue_", &Array::enqueue_);
 
             cls.def_static("traverse_", &Array::traverse_,
                            py::call_guard<py::gil_scoped_release>());
+            cls.def("hvp_", &Array::hvp_,
+                    py::call_guard<py::gil_scoped_release>());
+            cls.def_static("set_record_hessian_", &Array::set_record_hessian_);
+            cls.def_static("record_hessian_", &Array::record_hessian_);
+            cls.def_static("set_isolated_graph_", &Array::set_isolated_graph_);
+            cls.def_static("isolated_graph_", &Array::isolated_graph_);
 
             cls.def_static("create_", [](uint32_t index,
                                          const dr::detached_t<Array> &value) {
@@ -498,6 +689,11 @@ auto bind_full(py::class_<Array> &cls, bool /* scalar_mode */ = false) {
         }
     }
 
+    if constexpr (!Array::IsMask) {
+        FastPath<Array>::type = (PyTypeObject *) cls.ptr();
+        fast_path_init.push_back(&FastPath<Array>::install);
+    }
+
     bind_generic_constructor(cls);
 
     return cls;
@@ -549,7 +745,7 @@ void bind_ad_details(py::class_<dr::DiffArray<T>> &cls) {
     });
     cls.def("ad_extract_implicit_", [](size_t snapshot) {
         std::vector<uint32_t> implicit_in(dr::detail::ad_implicit<T>() - snapshot, 0);
-        dr::detail::ad_extract_implicit<T>(snapshot, implicit_in.data());
+        implicit_in.resize(dr::detail::ad_extract_implicit<T>(snapshot, implicit_in.data()));
         return implicit_in;
     });
     cls.def("ad_enqueue_implicit_", [](size_t snapshot) {
@@ -1,6 +1,7 @@
 #if defined(DRJIT_ENABLE_JIT) && defined(DRJIT_ENABLE_CUDA)
 #include "bind.h"
 #include "random.h"
+#include "bvh.h"
 #include "loop.h"
 #include "switch.h"
 #include "tensor.h"
@@ -18,6 +19,9 @@ void export_cuda(py::module_ &m) {
     DRJIT_BIND_ARRAY_TYPES(cuda, Guide, false);
 
     bind_pcg32<Guide>(cuda);
+    bind_philox4x32<Guide>(cuda);
+    bind_qmc<Guide>(cuda);
+    bind_lbvh<Guide>(cuda);
 
     using Mask = dr::mask_t<Guide>;
 
@@ -30,6 +34,9 @@ void export_cuda(py::module_ &m) {
         .def("init", &Loop<Mask>::init)
         .def("set_max_iterations", &Loop<Mask>::set_max_iterations)
         .def("set_eval_stride", &Loop<Mask>::set_eval_stride)
+        .def("set_unroll", &Loop<Mask>::set_unroll)
+        .def("set_optimize", &Loop<Mask>::set_optimize)
+        .def("set_compaction", &Loop<Mask>::set_compaction, "threshold"_a, "stride"_a = 1)
         .def("__call__", &Loop<Mask>::operator());
 
     bind_texture_all<Guide>(cuda);
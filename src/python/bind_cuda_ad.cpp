@@ -17,6 +17,8 @@ void export_cuda_ad(py::module_ &m) {
     DRJIT_BIND_ARRAY_TYPES(cuda_ad, Guide, false);
 
     bind_pcg32<Guide>(cuda_ad);
+    bind_philox4x32<Guide>(cuda_ad);
+    bind_qmc<Guide>(cuda_ad);
 
     using Mask = dr::mask_t<Guide>;
 
@@ -29,6 +31,9 @@ void export_cuda_ad(py::module_ &m) {
         .def("init", &Loop<Mask>::init)
         .def("set_max_iterations", &Loop<Mask>::set_max_iterations)
         .def("set_eval_stride", &Loop<Mask>::set_eval_stride)
+        .def("set_unroll", &Loop<Mask>::set_unroll)
+        .def("set_optimize", &Loop<Mask>::set_optimize)
+        .def("set_compaction", &Loop<Mask>::set_compaction, "threshold"_a, "stride"_a = 1)
         .def("__call__", &Loop<Mask>::operator());
 
     DRJIT_BIND_TENSOR_TYPES(cuda_ad);
@@ -16,6 +16,8 @@ void export_llvm_ad(py::module_ &m) {
     DRJIT_BIND_ARRAY_TYPES(llvm_ad, Guide, false);
 
     bind_pcg32<Guide>(llvm_ad);
+    bind_philox4x32<Guide>(llvm_ad);
+    bind_qmc<Guide>(llvm_ad);
 
     py::module_ detail = llvm_ad.def_submodule("detail");
     detail.def("ad_add_edge", [](int32_t src_index, int32_t dst_index,
@@ -35,6 +37,9 @@ void export_llvm_ad(py::module_ &m) {
         .def("init", &Loop<Mask>::init)
         .def("set_max_iterations", &Loop<Mask>::set_max_iterations)
         .def("set_eval_stride", &Loop<Mask>::set_eval_stride)
+        .def("set_unroll", &Loop<Mask>::set_unroll)
+        .def("set_optimize", &Loop<Mask>::set_optimize)
+        .def("set_compaction", &Loop<Mask>::set_compaction, "threshold"_a, "stride"_a = 1)
         .def("__call__", &Loop<Mask>::operator());
 
     DRJIT_BIND_TENSOR_TYPES(llvm_ad);
@@ -10,5 +10,7 @@ void export_packet(py::module_ &m) {
     DRJIT_BIND_ARRAY_TYPES(packet, Guide, false);
 
     bind_pcg32<Guide>(packet);
+    bind_philox4x32<Guide>(packet);
+    bind_qmc<Guide>(packet);
 }
 #endif
@@ -25,6 +25,8 @@ void export_scalar(py::module_ &m) {
     bind_full(d_b, true);
 
     bind_pcg32<uint64_t>(scalar);
+    bind_philox4x32<uint64_t>(scalar);
+    bind_qmc<uint64_t>(scalar);
 
     struct LoopDummy { LoopDummy(const char*, py::args) { }};
     py::class_<LoopDummy>(scalar, "Loop")
@@ -33,6 +35,10 @@ void export_scalar(py::module_ &m) {
         .def("init", [](LoopDummy&) {})
         .def("set_uniform", [](LoopDummy&, bool) { })
         .def("set_max_iterations", [](LoopDummy&, bool) { })
+        .def("set_unroll", [](LoopDummy&, uint32_t) { })
+        .def("set_optimize", [](LoopDummy&, bool) { })
+        .def("set_compaction", [](LoopDummy&, float, uint32_t) { },
+             "threshold"_a, "stride"_a = 1)
         .def("__call__", [](LoopDummy&, bool value) { return value; });
 
     bind_texture_all<float>(scalar);
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <drjit/bvh.h>
+#include "common.h"
+
+template <typename Guide>
+void bind_lbvh(py::module_ &m) {
+    using BVH = dr::LBVH<Guide>;
+    using Traversal = dr::LBVHTraversal<Guide>;
+    using Array3f = typename BVH::Array3f;
+    using Mask = typename BVH::Mask;
+
+    py::class_<BVH>(m, "LBVH")
+        .def(py::init<const Array3f &, const Array3f &>(), "bbox_min"_a,
+             "bbox_max"_a)
+        .def_readonly("size", &BVH::size)
+        .def_readonly("bbox_min", &BVH::bbox_min)
+        .def_readonly("bbox_max", &BVH::bbox_max)
+        .def_readonly("child", &BVH::child)
+        .def_readonly("skip", &BVH::skip)
+        .def_readonly("prim_index", &BVH::prim_index);
+
+    auto traversal = py::class_<Traversal>(m, "LBVHTraversal")
+        .def(py::init<const BVH &, const Mask &>(), "bvh"_a, "active"_a,
+             py::keep_alive<1, 2>())
+        .def("active", &Traversal::active)
+        .def("next",
+             [](Traversal &t, const py::function &pred, const Mask &mask) {
+                 return t.next(
+                     [&](const Array3f &lo, const Array3f &hi) {
+                         return py::cast<Mask>(pred(lo, hi));
+                     }, mask);
+             }, "pred"_a, "mask"_a = true)
+        .def_readwrite("node", &Traversal::node);
+
+    py::dict fields;
+    fields["node"] = py::type::of<typename BVH::UInt32>();
+    traversal.attr("DRJIT_STRUCT") = fields;
+}
@@ -14,6 +14,17 @@ namespace dr = drjit;
 
 using namespace py::literals;
 
+/**
+ * Releases the GIL in bindings of JIT arrays that may compile or run kernels.
+ * Only use it for methods that don't modify their arguments: another Python
+ * thread could otherwise access the array while it is being modified.
+ */
+template <typename Array>
+using jit_release_gil =
+    std::conditional_t<dr::is_jit_v<Array>,
+                       py::call_guard<py::gil_scoped_release>,
+                       py::call_guard<>>;
+
 /// Register an implicit conversion handler for a particular type
 extern void register_implicit_conversions(const std::type_info &type);
 
@@ -29,3 +40,7 @@ extern py::capsule to_dlpack(const py::object &owner, uint64_t data,
                              const py::tuple &strides);
 
 extern py::dict from_dlpack(const py::capsule &o);
+
+#if defined(DRJIT_ENABLE_CUDA)
+extern void cuda_stream_wait(uintptr_t consumer);
+#endif
@@ -1,6 +1,10 @@
 #include "common.h"
 #include <pybind11/functional.h>
 
+#if defined(DRJIT_ENABLE_CUDA)
+#  include <drjit-core/jit.h>
+#endif
+
 struct DLManagedTensor {
     void *data;
     int device_type;
@@ -122,3 +126,80 @@ py::dict from_dlpack(const py::capsule &o) {
 
     return d;
 }
+
+#if defined(DRJIT_ENABLE_CUDA)
+using CUresult = int;
+using CUcontext = void *;
+using CUstream = void *;
+using CUevent = void *;
+
+#define CU_EVENT_DISABLE_TIMING 2
+#define CU_STREAM_LEGACY ((CUstream) 0x1)
+#define CU_STREAM_PER_THREAD ((CUstream) 0x2)
+
+struct CUDAEventAPI {
+    CUresult (*cuCtxPushCurrent)(CUcontext);
+    CUresult (*cuCtxPopCurrent)(CUcontext *);
+    CUresult (*cuEventCreate)(CUevent *, unsigned int);
+    CUresult (*cuEventRecord)(CUevent, CUstream);
+    CUresult (*cuEventDestroy)(CUevent);
+    CUresult (*cuStreamWaitEvent)(CUstream, CUevent, unsigned int);
+
+    CUDAEventAPI() {
+        lookup(cuCtxPushCurrent, "cuCtxPushCurrent_v2");
+        lookup(cuCtxPopCurrent, "cuCtxPopCurrent_v2");
+        lookup(cuEventCreate, "cuEventCreate");
+        lookup(cuEventRecord, "cuEventRecord");
+        lookup(cuEventDestroy, "cuEventDestroy_v2");
+        lookup(cuStreamWaitEvent, "cuStreamWaitEvent");
+    }
+
+    template <typename Func> static void lookup(Func &func, const char *name) {
+        func = (Func) jit_cuda_lookup(name);
+        if (!func)
+            throw std::runtime_error(
+                std::string("DLPack: could not find CUDA driver function ") + name);
+    }
+};
+
+static void cuda_check(CUresult rv, const char *name) {
+    if (rv != 0)
+        throw std::runtime_error(std::string("DLPack: ") + name +
+                                 "() failed with error code " +
+                                 std::to_string(rv));
+}
+
+/**
+ * Order the work on \c consumer after all work submitted to Dr.Jit's CUDA
+ * stream so far. This records an event instead of synchronizing with the
+ * host, so both streams keep running asynchronously. The \c consumer value
+ * follows the DLPack convention: 1 and 2 denote the legacy and per-thread
+ * default stream, and other values are raw stream handles.
+ */
+void cuda_stream_wait(uintptr_t consumer) {
+    static CUDAEventAPI api;
+
+    CUstream producer = (CUstream) jit_cuda_stream(),
+             target = (CUstream) consumer;
+    if (consumer == 1)
+        target = CU_STREAM_LEGACY;
+    else if (consumer == 2)
+        target = CU_STREAM_PER_THREAD;
+    if (target == producer)
+        return;
+
+    cuda_check(api.cuCtxPushCurrent((CUcontext) jit_cuda_context()),
+               "cuCtxPushCurrent");
+    CUevent event = nullptr;
+    CUresult rv = api.cuEventCreate(&event, CU_EVENT_DISABLE_TIMING);
+    if (rv == 0)
+        rv = api.cuEventRecord(event, producer);
+    if (rv == 0)
+        rv = api.cuStreamWaitEvent(target, event, 0);
+    if (event)
+        api.cuEventDestroy(event); // deferred by CUDA until the wait completes
+    CUcontext ctx;
+    api.cuCtxPopCurrent(&ctx);
+    cuda_check(rv, "cuStreamWaitEvent");
+}
+#endif
@@ -12,8 +12,11 @@ template <typename Value> struct Loop : dr::Loop<Value> {
     using Base::m_state;
 
     Loop(const char *name, py::handle func) : Base(name) {
-        py::object detail = py::module_::import("drjit").attr("detail");
-        m_process_state = detail.attr("loop_process_state");
+        py::object drjit = py::module_::import("drjit");
+        m_init_state = drjit.attr("detail").attr("loop_init_state");
+        m_is_tensor = drjit.attr("is_tensor_v");
+        m_is_jit = drjit.attr("is_jit_v");
+        m_is_struct = drjit.attr("is_struct_v");
         if (!func.is_none()) {
             if (!py::isinstance<py::function>(func)) {
                 jit_raise("Loop(\"%s\"): expected a lambda function as second "
@@ -33,26 +36,8 @@ template <typename Value> struct Loop : dr::Loop<Value> {
             jit_raise("Loop(\"%s\"): was already initialized!",
                       m_name.get());
 
-        process_state(false);
-
-        py::int_ i0(0), i1(1), i2(2);
-        for (size_t i = 0, size = m_state_py.size(); i < size; ++i) {
-            py::object o = m_state_py[i];
-            if (!py::isinstance<py::tuple>(o))
-                continue;
-            m_indices_py.push_back(py::cast<uint32_t>(o[i0]));
-            m_indices_py_ad.push_back(py::cast<int32_t>(o[i1]));
-            int ad_float_precision = py::cast<uint32_t>(o[i2]);
-            if (ad_float_precision) {
-                if (m_ad_float_precision == 0)
-                    m_ad_float_precision = ad_float_precision;
-                if (m_ad_float_precision != ad_float_precision)
-                    jit_raise(
-                        "Loop::init(): differentiable loop variables must "
-                        "use the same floating point precision! (either "
-                        "all single or all double precision)");
-            }
-        }
+        m_init_state(this, m_funcs);
+        process_state(Mode::Init);
 
         for (size_t i = 0; i < m_indices_py.size(); ++i) {
             m_indices.push_back(&m_indices_py[i]);
@@ -60,56 +45,197 @@ template <typename Value> struct Loop : dr::Loop<Value> {
         }
 
         Base::init();
-        write_state();
+        process_state(Mode::Write);
     }
 
     bool operator()(const dr::mask_t<Value> &mask) {
-        read_state();
+        if (m_layout.empty() && !m_funcs.empty())
+            jit_raise("Loop(\"%s\"): must be initialized before "
+                      "first loop iteration!", m_name.get());
+
+        process_state(Mode::Read);
         bool result = Base::operator()(mask);
-        write_state();
+        process_state(Mode::Write);
         return result;
     }
 
 private:
-    void read_state() {
-        process_state(false);
-
-        py::int_ i0(0), i1(1);
-        for (size_t i = 0, j = 0, size = m_state_py.size(); i < size; ++i) {
-            py::object o = m_state_py[i];
-            if (!py::isinstance<py::tuple>(o))
-                continue;
-            if (j >= m_indices_py.size()) {
-                jit_raise("Loop(\"%s\"): must be initialized before "
-                          "first loop iteration!", m_name.get());
-            } else {
-                m_indices_py[j] = py::cast<uint32_t>(o[i0]);
-                m_indices_py_ad[j] = py::cast<int32_t>(o[i1]);
+    enum class Mode { Init, Read, Write };
+
+    enum class Kind : uint8_t { Sequence, Tensor, Nested, Leaf, Struct, Skip };
+
+    /**
+     * Node of the loop state, in the depth-first order of the traversal. The
+     * layout is determined once by \ref init(), later traversals only verify
+     * the type of every node and reuse the remaining information.
+     */
+    struct Node {
+        py::object type;
+        Kind kind;
+        bool diff;
+        py::object fields;
+    };
+
+    /**
+     * Collect the indices of the loop state variables into 'm_indices_py'
+     * and 'm_indices_py_ad' (Mode::Init, Mode::Read), or update the
+     * variables with their values (Mode::Write)
+     */
+    void process_state(Mode mode) {
+        size_t node = 0, leaf = 0;
+        for (py::handle func : m_funcs) {
+            py::object value = func();
+            process(value, mode, node, leaf, false);
+        }
+
+        if (mode != Mode::Init && node != m_layout.size())
+            dr::drjit_raise(
+                "Loop(\"%s\"): the number of loop state variables must "
+                "remain the same throughout the loop!", m_name.get());
+    }
+
+    void process(py::handle value, Mode mode, size_t &node, size_t &leaf,
+                 bool in_struct) {
+        py::handle type = (PyObject *) Py_TYPE(value.ptr());
+
+        if (mode == Mode::Init) {
+            m_layout.push_back(classify(type));
+        } else if (node >= m_layout.size() || !m_layout[node].type.is(type)) {
+            dr::drjit_raise(
+                "Loop(\"%s\"): the type of loop state variables must remain the "
+                "same throughout the loop. However, one of the supplied "
+                "variables changed from type %s to %s!", m_name.get(),
+                node < m_layout.size() ? type_name(m_layout[node].type).c_str()
+                                       : "(none)",
+                type_name(type).c_str());
+        }
+
+        // Note: the layout may grow (and reallocate) while recursing
+        size_t self = node++;
+        Kind kind = m_layout[self].kind;
+
+        switch (kind) {
+            case Kind::Sequence:
+                for (py::handle entry : value)
+                    process(entry, mode, node, leaf, in_struct);
+                break;
+
+            case Kind::Tensor:
+                process(value.attr("array"), mode, node, leaf, in_struct);
+                break;
+
+            case Kind::Nested: {
+                    py::object entry_ref = value.attr("entry_ref_");
+                    size_t size = py::len(value);
+                    for (size_t i = 0; i < size; ++i)
+                        process(entry_ref(i), mode, node, leaf, in_struct);
+                }
+                break;
+
+            case Kind::Leaf:
+                process_leaf(value, m_layout[self], mode, leaf);
+                break;
+
+            case Kind::Struct: {
+                    py::object fields = m_layout[self].fields;
+                    for (py::handle key : fields)
+                        process(value.attr(key), mode, node, leaf, true);
+                }
+                break;
+
+            case Kind::Skip:
+                if (!in_struct && !value.is_none() &&
+                    !py::hasattr(value, "loop_put"))
+                    dr::drjit_raise(
+                        "Loop(\"%s\"): one of the provided loop state variables "
+                        "was of type '%s', which is not allowed (you must use "
+                        "Dr.Jit arrays/structs that are managed by the JIT "
+                        "compiler)", m_name.get(), type_name(type).c_str());
+                break;
+        }
+    }
+
+    void process_leaf(py::handle value, const Node &n, Mode mode, size_t &leaf) {
+        if (mode == Mode::Write) {
+            value.attr("set_index_")(m_indices_py[leaf]);
+            if (n.diff)
+                value.attr("set_index_ad_")(m_indices_py_ad[leaf]);
+            leaf++;
+            return;
+        }
+
+        uint32_t index = py::cast<uint32_t>(value.attr("index")),
+                 index_ad = n.diff ? py::cast<uint32_t>(value.attr("index_ad")) : 0;
+
+        if (index_ad != 0 && jit_flag(JitFlag::LoopRecord))
+            dr::drjit_raise(
+                "Loop(\"%s\"): one of the supplied loop state variables of type "
+                "%s is attached to the AD graph (i.e., grad_enabled(..) is "
+                "true). However, propagating derivatives through multiple "
+                "iterations of a recorded loop is not supported (and never "
+                "will be). Please see the documentation on differentiating "
+                "loops for details and suggested alternatives.",
+                m_name.get(), type_name(n.type).c_str());
+
+        if (index == 0)
+            dr::drjit_raise("Loop(\"%s\"): one of the supplied loop state "
+                            "variables of type %s is uninitialized!",
+                            m_name.get(), type_name(n.type).c_str());
+
+        if (mode == Mode::Init) {
+            m_indices_py.push_back(index);
+            m_indices_py_ad.push_back(index_ad);
+
+            uint32_t precision = 0;
+            if (n.diff && py::cast<bool>(n.type.attr("IsFloat")))
+                precision = py::cast<uint32_t>(
+                    n.type.attr("Type").attr("Size")) * 8;
+            if (precision) {
+                if (m_ad_float_precision == 0)
+                    m_ad_float_precision = precision;
+                if (m_ad_float_precision != (int) precision)
+                    jit_raise(
+                        "Loop::init(): differentiable loop variables must "
+                        "use the same floating point precision! (either "
+                        "all single or all double precision)");
             }
-            j++;
+        } else {
+            m_indices_py[leaf] = index;
+            m_indices_py_ad[leaf] = index_ad;
         }
+        leaf++;
     }
 
-    void write_state() {
-        py::int_ i0(0), i1(1);
-        for (size_t i = 0, j = 0, size = m_state_py.size(); i < size; ++i) {
-            py::object o = m_state_py[i];
-            if (!py::isinstance<py::tuple>(o))
-                continue;
-            m_state_py[i] = py::make_tuple(m_indices_py[j], m_indices_py_ad[j], 0);
-            j++;
+    Node classify(py::handle type) const {
+        Node n { py::reinterpret_borrow<py::object>(type), Kind::Skip, false,
+                 py::object() };
+
+        PyTypeObject *tp = (PyTypeObject *) type.ptr();
+        if (PyType_IsSubtype(tp, &PyTuple_Type) ||
+            PyType_IsSubtype(tp, &PyList_Type)) {
+            n.kind = Kind::Sequence;
+        } else if (py::cast<bool>(m_is_tensor(type))) {
+            n.kind = Kind::Tensor;
+        } else if (py::cast<bool>(m_is_jit(type))) {
+            n.diff = py::cast<bool>(type.attr("IsDiff"));
+            n.kind = py::cast<size_t>(type.attr("Depth")) > 1 ? Kind::Nested
+                                                              : Kind::Leaf;
+        } else if (py::cast<bool>(m_is_struct(type))) {
+            n.kind = Kind::Struct;
+            n.fields = py::list(type.attr("DRJIT_STRUCT"));
         }
 
-        process_state(true);
+        return n;
     }
 
-    void process_state(bool write) {
-        m_process_state(this, m_funcs, m_state_py, write);
+    static std::string type_name(py::handle type) {
+        return py::cast<std::string>(type.attr("__name__"));
     }
 
 private:
-    py::list m_funcs, m_state_py;
-    py::object m_process_state;
+    py::list m_funcs;
+    py::object m_init_state, m_is_tensor, m_is_jit, m_is_struct;
+    std::vector<Node> m_layout;
     dr::dr_vector<uint32_t> m_indices_py;
     dr::dr_vector<uint32_t> m_indices_py_ad;
 };
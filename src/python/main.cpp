@@ -1,7 +1,9 @@
 #include "bind.h"
 #include <drjit/autodiff.h>
 #include <drjit/idiv.h>
+#include <drjit/jit.h>
 #include <drjit/loop.h>
+#include <drjit/resample.h>
 #include <drjit/texture.h>
 #include <pybind11/stl.h>
 #include <pybind11/operators.h>
@@ -46,6 +48,7 @@ const char* var_type_numpy[(int) VarType::Count] {
 };
 
 py::handle array_base, array_name, array_init, tensor_init, array_configure;
+std::vector<void (*)()> fast_path_init;
 
 /// Placeholder base of all DrJit arrays in the Python domain
 struct ArrayBase { };
@@ -60,6 +63,52 @@ static void log_callback(LogLevel /* level */, const char *msg) {
     else
         fprintf(stderr, "%s\n", msg);
 }
+
+/// Kernel history entry along with the \ref Scope that was active at launch
+struct KernelRecord {
+    KernelHistoryEntry entry;
+    std::string scope;
+};
+
+/// Entries taken from the kernel history as scopes are entered and exited
+static std::vector<KernelRecord> kernel_records;
+
+/// Names of the active scopes, outermost first
+static std::vector<std::string> kernel_scopes;
+
+/// Move new history entries into 'kernel_records' and attribute them to the current scope
+static void kernel_history_drain() {
+    KernelHistoryEntry *data  = jit_kernel_history(),
+                       *entry = data;
+
+    std::string scope;
+    for (const std::string &name : kernel_scopes)
+        scope += scope.empty() ? name : "/" + name;
+
+    while (entry && (uint32_t) entry->backend)
+        kernel_records.push_back({ *entry++, scope });
+
+    free(data);
+}
+
+static void kernel_history_clear() {
+    jit_kernel_history_clear();
+    for (KernelRecord &record : kernel_records) {
+        if (record.entry.type == KernelType::JIT)
+            free(record.entry.ir);
+    }
+    kernel_records.clear();
+}
+
+/* jit_malloc_stats() is only exported by recent drjit-core revisions. The
+   overload below is selected when it is missing, in which case the binding
+   is skipped and drjit.malloc_stats() parses the jit_var_whos() report. */
+struct MallocStatsMissing { };
+namespace malloc_stats_fallback {
+    template <typename... Ts> MallocStatsMissing jit_malloc_stats(Ts...) {
+        return { };
+    }
+}
 #endif
 
 PYBIND11_MODULE(drjit_ext, m_) {
@@ -108,6 +157,9 @@ PYBIND11_MODULE(drjit_ext, m_) {
         .value("ClearInterior", dr::ADFlag::ClearInterior)
         .value("ClearVertices", dr::ADFlag::ClearVertices)
         .value("Default", dr::ADFlag::Default)
+        .value("Parallel", dr::ADFlag::Parallel)
+        .value("Compensated", dr::ADFlag::Compensated)
+        .value("Async", dr::ADFlag::Async)
         .def(py::self == py::self)
         .def(py::self | py::self)
         .def(int() | py::self)
@@ -125,12 +177,35 @@ PYBIND11_MODULE(drjit_ext, m_) {
         .value("Clamp", dr::WrapMode::Clamp)
         .value("Mirror", dr::WrapMode::Mirror);
 
+    py::enum_<dr::TextureCompression>(m, "TextureCompression")
+        .value("Uncompressed", dr::TextureCompression::Uncompressed)
+        .value("BC4", dr::TextureCompression::BC4);
+
+    py::enum_<dr::TextureFormat>(m, "TextureFormat")
+        .value("Float32", dr::TextureFormat::Float32)
+        .value("Float16", dr::TextureFormat::Float16)
+        .value("UNorm8", dr::TextureFormat::UNorm8)
+        .value("SNorm16", dr::TextureFormat::SNorm16);
+
+    py::enum_<dr::TextureLayout>(m, "TextureLayout")
+        .value("RowMajor", dr::TextureLayout::RowMajor)
+        .value("Tiled", dr::TextureLayout::Tiled);
+
+    py::enum_<dr::ResampleFilter>(m, "ResampleFilter")
+        .value("Box", dr::ResampleFilter::Box)
+        .value("Tent", dr::ResampleFilter::Tent)
+        .value("Lanczos", dr::ResampleFilter::Lanczos);
+
     py::class_<dr::detail::reinterpret_flag>(array_detail, "reinterpret_flag")
         .def(py::init<>());
 
     array_base = py::class_<ArrayBase>(m, "ArrayBase");
 
     py::register_exception<drjit::Exception>(m, "Exception");
+    array_detail.def("install_fast_paths", []() {
+        for (auto install : fast_path_init)
+            install();
+    });
     array_detail.def("reinterpret_scalar", &reinterpret_scalar);
     array_detail.def("fmadd_scalar", [](double a, double b, double c) {
         return std::fma(a, b, c);
@@ -140,6 +215,7 @@ PYBIND11_MODULE(drjit_ext, m_) {
     array_detail.def("cuda_context", []() { return reinterpret_cast<std::uintptr_t>(jit_cuda_context()); });
     array_detail.def("cuda_device", &jit_cuda_device_raw);
     array_detail.def("cuda_stream", []() { return reinterpret_cast<std::uintptr_t>(jit_cuda_stream()); });
+    array_detail.def("cuda_stream_wait", &cuda_stream_wait, "consumer"_a);
 #endif
 
     export_scalar(m);
@@ -170,28 +246,67 @@ PYBIND11_MODULE(drjit_ext, m_) {
     export_llvm_ad(m);
     m.def("ad_whos_str", &dr::ad_whos);
     m.def("ad_whos", []() { py::print(dr::ad_whos()); });
+    m.def("ad_lock_contention", &dr::ad_lock_contention);
+    m.def("ad_lock_contention_clear", &dr::ad_lock_contention_clear);
+    m.def("ad_stats", []() {
+        dr::ADStats s = dr::ad_stats();
+        py::dict result, labels;
+        result["traversals"] = s.traversals;
+        result["async_evals"] = s.async_evals;
+        result["time_dfs"] = s.time_dfs;
+        result["time_sort"] = s.time_sort;
+        result["time_traverse"] = s.time_traverse;
+        result["time_special"] = s.time_special;
+        result["time_cleanup"] = s.time_cleanup;
+        py::dict last;
+        last["time_dfs"] = s.last_time_dfs;
+        last["time_sort"] = s.last_time_sort;
+        last["time_traverse"] = s.last_time_traverse;
+        last["time_special"] = s.last_time_special;
+        last["time_cleanup"] = s.last_time_cleanup;
+        last["edges"] = s.last_edges;
+        result["last"] = last;
+        result["variables"] = s.variables;
+        result["edges"] = s.edges;
+        result["edges_peak"] = s.edges_peak;
+        result["variable_bytes"] = s.variable_bytes;
+        result["edge_bytes"] = s.edge_bytes;
+
+        dr::ad_stats_labels([](void *payload, const char *label, size_t variables,
+                               size_t edges, size_t grad_bytes) {
+            py::dict entry;
+            entry["variables"] = variables;
+            entry["edges"] = edges;
+            entry["grad_bytes"] = grad_bytes;
+            (*(py::dict *) payload)[label] = entry;
+        }, &labels);
+
+        result["labels"] = labels;
+        return result;
+    });
+    m.def("ad_stats_clear", &dr::ad_stats_clear);
+    m.def("trace_enable", &dr::trace_enable, "capacity"_a = 1 << 20);
+    m.def("trace_disable", &dr::trace_disable);
+    m.def("trace_clear", &dr::trace_clear);
+    m.def("trace_export", []() { return py::str(dr::trace_export()); });
     array_detail.def("graphviz_ad", [](){
-        py::str string = py::str("");
-
-        const char *s = drjit::detail::ad_graphviz<drjit::LLVMArray<float>>();
-        if (strlen(s) > 453)
-            string = py::str(string + py::str(s));
-
-        s = drjit::detail::ad_graphviz<drjit::LLVMArray<double>>();
-        if (strlen(s) > 453)
-            string = py::str(string + py::str(s));
-
-    #if defined(DRJIT_ENABLE_CUDA)
-        s = drjit::detail::ad_graphviz<drjit::CUDAArray<float>>();
-        if (strlen(s) > 453)
-            string = py::str(string + py::str(s));
-
-        s = drjit::detail::ad_graphviz<drjit::CUDAArray<double>>();
-        if (strlen(s) > 453)
-            string = py::str(string + py::str(s));
-    #endif
-
-        return string;
+        std::string string;
+        {
+            // Traversing large graphs can take a while
+            py::gil_scoped_release gsr;
+            auto append = [&](const char *s) {
+                if (strlen(s) > 453)
+                    string += s;
+            };
+
+            append(drjit::detail::ad_graphviz<drjit::LLVMArray<float>>());
+            append(drjit::detail::ad_graphviz<drjit::LLVMArray<double>>());
+        #if defined(DRJIT_ENABLE_CUDA)
+            append(drjit::detail::ad_graphviz<drjit::CUDAArray<float>>());
+            append(drjit::detail::ad_graphviz<drjit::CUDAArray<double>>());
+        #endif
+        }
+        return py::str(string);
     });
 #endif
 
@@ -199,7 +314,16 @@ PYBIND11_MODULE(drjit_ext, m_) {
         Scope(const std::string &name) : name(name) { }
 
         void enter() {
+            #if defined(DRJIT_ENABLE_AUTODIFF)
+                if (dr::trace_active.load(std::memory_order_relaxed)) {
+                    trace_name = dr::trace_intern(name.c_str());
+                    trace_start = dr::trace_time();
+                }
+            #endif
             #if defined(DRJIT_ENABLE_JIT)
+                if (jit_flag(JitFlag::KernelHistory))
+                    kernel_history_drain();
+                kernel_scopes.push_back(name);
                 #if defined(DRJIT_ENABLE_CUDA)
                     if (jit_has_backend(JitBackend::CUDA)) {
                         jit_prefix_push(JitBackend::CUDA, name.c_str());
@@ -218,6 +342,9 @@ PYBIND11_MODULE(drjit_ext, m_) {
 
         void exit(py::handle, py::handle, py::handle) {
             #if defined(DRJIT_ENABLE_JIT)
+                if (jit_flag(JitFlag::KernelHistory))
+                    kernel_history_drain();
+                kernel_scopes.pop_back();
                 #if defined(DRJIT_ENABLE_CUDA)
                     if (pushed_cuda)
                         jit_prefix_pop(JitBackend::CUDA);
@@ -227,10 +354,18 @@ PYBIND11_MODULE(drjit_ext, m_) {
             #endif
             #if defined(DRJIT_ENABLE_AUTODIFF)
                 dr::ad_prefix_pop();
+                if (trace_start)
+                    dr::trace_record(trace_name, "python", trace_start,
+                                     dr::trace_time());
+                trace_start = 0;
             #endif
         }
 
         std::string name;
+        #if defined(DRJIT_ENABLE_AUTODIFF)
+            const char *trace_name = nullptr;
+            uint64_t trace_start = 0;
+        #endif
         #if defined(DRJIT_ENABLE_JIT)
         #if defined(DRJIT_ENABLE_CUDA)
             bool pushed_cuda = false;
@@ -304,14 +439,30 @@ PYBIND11_MODULE(drjit_ext, m_) {
 #endif
 
     m.def("has_backend", &jit_has_backend);
-    m.def("sync_thread", &jit_sync_thread);
-    m.def("sync_device", &jit_sync_device);
-    m.def("sync_all_devices", &jit_sync_all_devices);
+    m.def("sync_thread", &jit_sync_thread,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("sync_device", &jit_sync_device,
+          py::call_guard<py::gil_scoped_release>());
+    m.def("sync_all_devices", &jit_sync_all_devices,
+          py::call_guard<py::gil_scoped_release>());
     m.def("whos_str", &jit_var_whos);
     m.def("whos", []() { py::print(jit_var_whos()); });
     m.def("flush_kernel_cache", &jit_flush_kernel_cache);
     m.def("flush_malloc_cache", &jit_flush_malloc_cache);
     m.def("malloc_clear_statistics", &jit_malloc_clear_statistics);
+    {
+        using namespace malloc_stats_fallback;
+        size_t *none = nullptr;
+        if constexpr (!std::is_same_v<decltype(jit_malloc_stats(
+                          AllocType::Host, none, none, none)),
+                                      MallocStatsMissing>) {
+            array_detail.def("malloc_stats", [](AllocType type) {
+                size_t used = 0, allocated = 0, peak = 0;
+                jit_malloc_stats(type, &used, &allocated, &peak);
+                return py::make_tuple(used, allocated, peak);
+            });
+        }
+    }
     m.def("set_log_level", [](LogLevel level) { jit_set_log_level_callback(level, log_callback); });
     m.def("log_level", &jit_log_level_stderr);
     m.def("registry_trim", &jit_registry_trim);
@@ -329,13 +480,15 @@ PYBIND11_MODULE(drjit_ext, m_) {
     m.def(
         "kernel_history",
         [io](py::list types) {
-            KernelHistoryEntry *data  = jit_kernel_history();
-            KernelHistoryEntry *entry = data;
+            kernel_history_drain();
+
             py::list history;
-            while (entry && (uint32_t) entry->backend) {
+            for (KernelRecord &record : kernel_records) {
+                KernelHistoryEntry *entry = &record.entry;
                 py::dict dict;
                 dict["backend"] = entry->backend;
                 dict["type"]    = entry->type;
+                dict["scope"]   = record.scope;
                 if (entry->type == KernelType::JIT) {
                     char kernel_hash[33];
                     snprintf(kernel_hash, sizeof(kernel_hash), "%016llx%016llx",
@@ -351,8 +504,19 @@ PYBIND11_MODULE(drjit_ext, m_) {
                 dict["size"]         = entry->size;
                 dict["input_count"]  = entry->input_count;
                 dict["output_count"] = entry->output_count;
-                if (entry->type == KernelType::JIT)
+                if (entry->type == KernelType::JIT) {
                     dict["operation_count"] = entry->operation_count;
+
+                    /* Fraction of the SIMD lanes that process an element:
+                       LLVM kernels run over whole packets of the vector width */
+                    if (entry->backend == JitBackend::LLVM) {
+                        uint32_t width = (uint32_t) jit_llvm_vector_width(),
+                                 packets = (entry->size + width - 1) / width;
+                        dict["vector_width"] = width;
+                        dict["vector_utilization"] =
+                            packets ? entry->size / double(packets * width) : 0.0;
+                    }
+                }
                 dict["codegen_time"]   = entry->codegen_time;
                 dict["backend_time"]   = entry->backend_time;
                 dict["execution_time"] = entry->execution_time;
@@ -365,19 +529,29 @@ PYBIND11_MODULE(drjit_ext, m_) {
 
                 if (queried_type)
                     history.append(dict);
-
-                entry++;
             }
-            free(data);
+            kernel_records.clear();
             return history;
         },
         "types"_a = py::list());
-    m.def("kernel_history_clear", &jit_kernel_history_clear);
+    m.def("kernel_history_clear", &kernel_history_clear);
 
     array_detail.def("graphviz", &jit_var_graphviz);
     array_detail.def("schedule", &jit_var_schedule);
+#if defined(DRJIT_ENABLE_AUTODIFF)
+    // Evaluations include the code generation, compilation and kernel launches
+    array_detail.def("eval", [](uint32_t index) {
+        dr::TraceScope trace("eval", "jit");
+        return jit_var_eval(index);
+    }, py::call_guard<py::gil_scoped_release>());
+    array_detail.def("eval", []() {
+        dr::TraceScope trace("eval", "jit");
+        jit_eval();
+    }, py::call_guard<py::gil_scoped_release>());
+#else
     array_detail.def("eval", &jit_var_eval, py::call_guard<py::gil_scoped_release>());
     array_detail.def("eval", &jit_eval, py::call_guard<py::gil_scoped_release>());
+#endif
     array_detail.def("to_dlpack", &to_dlpack, "owner"_a, "data"_a,
                      "type"_a, "device"_a, "shape"_a, "strides"_a);
     array_detail.def("from_dlpack", &from_dlpack);
@@ -398,6 +572,10 @@ PYBIND11_MODULE(drjit_ext, m_) {
     m.def("set_flag", [](JitFlag f, bool v) { jit_set_flag(f, v); });
     m.def("flags", &jit_flags);
     m.def("flag", [](JitFlag f) { return jit_flag(f); });
+    m.def("set_deterministic_reductions",
+          [](bool v) { dr::detail::deterministic_reductions = v; });
+    m.def("deterministic_reductions",
+          []() { return dr::detail::deterministic_reductions; });
 
     /* Register a cleanup callback function that is invoked when
        the 'drjit::ArrayBase' Python type is garbage collected */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <drjit/random.h>
+#include <drjit/qmc.h>
 #include "common.h"
 
 template <typename Guide>
@@ -18,6 +19,10 @@ void bind_pcg32(py::module_ &m) {
         .def("seed", &PCG32::seed, "size"_a = 1,
              "initstate"_a = PCG32_DEFAULT_STATE,
              "initseq"_a = PCG32_DEFAULT_STREAM)
+        .def("seed_sequence", &PCG32::seed_sequence, "size"_a = 1,
+             "initstate"_a = PCG32_DEFAULT_STATE,
+             "initseq"_a = PCG32_DEFAULT_STREAM,
+             "stride"_a = (uint64_t) 1 << 32)
         .def("next_uint32", py::overload_cast<>(&PCG32::next_uint32))
         .def("next_uint32",
              py::overload_cast<const dr::mask_t<UInt64> &>(&PCG32::next_uint32))
@@ -28,6 +33,10 @@ void bind_pcg32(py::module_ &m) {
              py::overload_cast<const dr::mask_t<UInt64> &>(&PCG32::next_uint64))
         .def("next_uint64_bounded", &PCG32::next_uint64_bounded, "bound"_a,
              "mask"_a = true)
+        .def("next_uint32_bounded_fixed", &PCG32::next_uint32_bounded_fixed,
+             "bound"_a, "mask"_a = true, "retries"_a = 1)
+        .def("next_uint64_bounded_fixed", &PCG32::next_uint64_bounded_fixed,
+             "bound"_a, "mask"_a = true, "retries"_a = 1)
         .def("next_float32", py::overload_cast<>(&PCG32::next_float32))
         .def("next_float32", py::overload_cast<const dr::mask_t<UInt64> &>(
                                  &PCG32::next_float32))
@@ -52,3 +61,71 @@ void bind_pcg32(py::module_ &m) {
     fields["inc"] = u64;
     pcg32.attr("DRJIT_STRUCT") = fields;
 }
+
+template <typename Guide>
+void bind_philox4x32(py::module_ &m) {
+    using UInt32 = dr::uint32_array_t<Guide>;
+    using UInt64 = dr::uint64_array_t<Guide>;
+    using Philox = dr::Philox4x32<UInt32>;
+    using Mask = dr::mask_t<UInt32>;
+
+    auto philox = py::class_<Philox>(m, "Philox4x32")
+        .def(py::init<const UInt32 &, const UInt32 &, const UInt64 &,
+                      const UInt32 &>(),
+             "index"_a = 0, "sample"_a = 0, "seed"_a = 0, "dimension"_a = 0)
+        .def(py::init<const Philox &>())
+        .def_static("block", &Philox::block, "counter"_a, "key0"_a, "key1"_a)
+        .def("peek_uint32x4", &Philox::peek_uint32x4)
+        .def("next_uint32x4", py::overload_cast<>(&Philox::next_uint32x4))
+        .def("next_uint32x4",
+             py::overload_cast<const Mask &>(&Philox::next_uint32x4))
+        .def("next_float32x4", py::overload_cast<>(&Philox::next_float32x4))
+        .def("next_float32x4",
+             py::overload_cast<const Mask &>(&Philox::next_float32x4))
+        .def("next_uint32", py::overload_cast<>(&Philox::next_uint32))
+        .def("next_uint32",
+             py::overload_cast<const Mask &>(&Philox::next_uint32))
+        .def("next_uint32_bounded", &Philox::next_uint32_bounded, "bound"_a,
+             "mask"_a = true)
+        .def("next_uint64", py::overload_cast<>(&Philox::next_uint64))
+        .def("next_uint64",
+             py::overload_cast<const Mask &>(&Philox::next_uint64))
+        .def("next_uint64_bounded", &Philox::next_uint64_bounded, "bound"_a,
+             "mask"_a = true)
+        .def("next_float32", py::overload_cast<>(&Philox::next_float32))
+        .def("next_float32",
+             py::overload_cast<const Mask &>(&Philox::next_float32))
+        .def("next_float64", py::overload_cast<>(&Philox::next_float64))
+        .def("next_float64",
+             py::overload_cast<const Mask &>(&Philox::next_float64))
+        .def_readwrite("index", &Philox::index)
+        .def_readwrite("sample", &Philox::sample)
+        .def_readwrite("dimension", &Philox::dimension)
+        .def_readwrite("seed", &Philox::seed);
+
+    py::handle u32, u64;
+    if constexpr (dr::is_array_v<UInt32>) {
+        u32 = py::type::of<UInt32>();
+        u64 = py::type::of<UInt64>();
+    } else {
+        u32 = u64 = py::handle((PyObject *) &PyLong_Type);
+    }
+    py::dict fields;
+    fields["index"] = u32;
+    fields["sample"] = u32;
+    fields["dimension"] = u32;
+    fields["seed"] = u64;
+    philox.attr("DRJIT_STRUCT") = fields;
+}
+
+template <typename Guide>
+void bind_qmc(py::module_ &m) {
+    using UInt32 = dr::uint32_array_t<Guide>;
+
+    m.def("reverse_bits", &dr::reverse_bits<UInt32>, "value"_a);
+    m.def("sobol_uint32", &dr::sobol_uint32<UInt32>, "index"_a, "dim"_a);
+    m.def("sobol", &dr::sobol<UInt32>, "index"_a, "dim"_a, "seed"_a);
+    m.def("owen_scramble", &dr::owen_scramble<UInt32>, "value"_a, "seed"_a);
+    m.def("radical_inverse", &dr::radical_inverse<UInt32>, "index"_a, "base"_a);
+    m.def("halton", &dr::halton<UInt32>, "index"_a, "dim"_a);
+}
@@ -52,12 +52,36 @@ py::object switch_record_impl(UInt32 indices, py::list funcs, py::args args) {
 
     state[0] = jit_record_checkpoint(Backend);
 
+    /* Callables that occur several times in 'funcs' are traced once (when
+       free of side effects), later occurrences reuse the recorded outputs */
+    struct Traced { py::handle func; size_t offset, count; };
+    std::vector<Traced> traced;
+
     // Trace all Python functions
     py::object result;
     for (uint32_t i = 1, j = 1; i <= funcs.size(); ++i) {
         if (funcs[i-1].is_none())
             continue;
 
+        const Traced *prev = nullptr;
+        for (const Traced &t : traced) {
+            if (t.func.is(funcs[i-1])) {
+                prev = &t;
+                break;
+            }
+        }
+
+        if (prev) {
+            for (size_t k = 0; k < prev->count; ++k) {
+                uint32_t index = indices_out_all[prev->offset + k];
+                indices_out_all.push_back(index);
+            }
+            state[j] = jit_record_checkpoint(Backend);
+            inst_id[j - 1] = i;
+            j++;
+            continue;
+        }
+
         jit_set_scope(Backend, scope);
 
         Mask vcall_mask = true;
@@ -84,6 +108,7 @@ py::object switch_record_impl(UInt32 indices, py::list funcs, py::args args) {
         result = result2;
 
         // Collect output indices
+        size_t offset = indices_out_all.size();
         apply_cpp(result, py::cpp_function([&](uint32_t index){
             indices_out_all.push_back(index);
         }));
@@ -91,6 +116,9 @@ py::object switch_record_impl(UInt32 indices, py::list funcs, py::args args) {
         jit_state.clear_mask();
 
         state[j] = jit_record_checkpoint(Backend);
+        if (state[j] == state[j - 1])
+            traced.push_back({ funcs[i-1], offset,
+                               indices_out_all.size() - offset });
         inst_id[j - 1] = i;
         j++;
     }
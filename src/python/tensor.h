@@ -1,4 +1,8 @@
 #include <drjit/tensor.h>
+#include <drjit/convolution.h>
+#include <drjit/fft.h>
+#include <drjit/resample.h>
+#include <drjit/npy.h>
 #include <pybind11/stl.h>
 
 template <typename T> auto bind_tensor(py::module m) {
@@ -49,7 +53,13 @@ template <typename T> auto bind_tensor(py::module m) {
         })
        .def("data_", [](const Tensor &a) {
             return (uintptr_t) a.data();
-        });
+        }, jit_release_gil<T>())
+       .def_static("load_npy_", [](const std::string &filename) {
+            return dr::load_npy<Tensor>(filename.c_str());
+        }, py::call_guard<py::gil_scoped_release>())
+       .def("save_npy_", [](const Tensor &a, const std::string &filename) {
+            dr::save_npy(filename.c_str(), a);
+        }, py::call_guard<py::gil_scoped_release>());
 
     cls.def("or_",     [](const Tensor &a, const Tensor &b) { return a.or_(b); });
     cls.def("and_",    [](const Tensor &a, const Tensor &b) { return a.and_(b); });
@@ -84,12 +94,49 @@ template <typename T> auto bind_tensor(py::module m) {
         cls.def(Tensor::IsFloat ? "itruediv_" : "ifloordiv_",
                 [](Tensor *a, const Tensor &b) { *a = a->div_(b); return a; });
 
+        cls.def("reduce_", &Tensor::reduce_);
         cls.def("abs_", &Tensor::abs_);
         cls.def("minimum_", &Tensor::minimum_);
         cls.def("maximum_", &Tensor::maximum_);
     }
 
     if constexpr (Tensor::IsFloat) {
+        cls.def("matmul_", &Tensor::matmul_);
+        cls.def("conv2d_", [](const Tensor &x, const Tensor &w, size_t stride,
+                              size_t padding) {
+            return dr::conv2d(x, w, stride, padding);
+        });
+        cls.def("conv3d_", [](const Tensor &x, const Tensor &w, size_t stride,
+                              size_t padding) {
+            return dr::conv3d(x, w, stride, padding);
+        });
+        cls.def("fft_", [](const Tensor &t, size_t ndim, bool inverse) {
+            switch (ndim) {
+                case 1: return inverse ? dr::ifft(t) : dr::fft(t);
+                case 2: return inverse ? dr::ifft2(t) : dr::fft2(t);
+                case 3: return inverse ? dr::ifft3(t) : dr::fft3(t);
+                default:
+                    throw py::value_error("fft(): the number of transformed "
+                                          "dimensions must be 1, 2 or 3!");
+            }
+        });
+        cls.def("resample_", [](const Tensor &t, const std::vector<size_t> &shape,
+                                dr::ResampleFilter filter) {
+            if (shape.size() != t.ndim())
+                throw py::type_error("resample(): the target shape must have "
+                                     "one entry per tensor dimension!");
+            return dr::resample(t, shape.data(), filter);
+        });
+        cls.def("pool2d_", [](const Tensor &x, ReduceOp op, size_t kernel_size,
+                              size_t stride) {
+            return op == ReduceOp::Max ? dr::max_pool2d(x, kernel_size, stride)
+                                       : dr::avg_pool2d(x, kernel_size, stride);
+        });
+        cls.def("pool3d_", [](const Tensor &x, ReduceOp op, size_t kernel_size,
+                              size_t stride) {
+            return op == ReduceOp::Max ? dr::max_pool3d(x, kernel_size, stride)
+                                       : dr::avg_pool3d(x, kernel_size, stride);
+        });
         cls.def("rcp_",   &Tensor::rcp_);
         cls.def("sqrt_",  &Tensor::sqrt_);
         cls.def("rsqrt_", &Tensor::rsqrt_);
@@ -10,19 +10,30 @@ void bind_texture(py::module &m, const char *name) {
     auto tex = py::class_<Tex>(m, name)
         .def(py::init([](const std::array<size_t, Dimension> &shape,
                          size_t channels, bool use_accel,
-                         dr::FilterMode filter_mode, dr::WrapMode wrap_mode) {
-                 return new Tex(shape.data(), channels, use_accel, filter_mode, wrap_mode);
+                         dr::FilterMode filter_mode, dr::WrapMode wrap_mode,
+                         dr::TextureFormat format) {
+                 return new Tex(shape.data(), channels, use_accel, filter_mode,
+                                wrap_mode, format);
              }),
              "shape"_a, "channels"_a, "use_accel"_a = true,
              "filter_mode"_a = dr::FilterMode::Linear,
-             "wrap_mode"_a = dr::WrapMode::Clamp)
+             "wrap_mode"_a = dr::WrapMode::Clamp,
+             "format"_a = dr::TextureFormat::Float32)
         .def(py::init<const typename Tex::TensorXf &, bool, bool, dr::FilterMode,
-                      dr::WrapMode>(),
+                      dr::WrapMode, dr::TextureFormat>(),
              "tensor"_a, "use_accel"_a = true, "migrate"_a = true,
              "filter_mode"_a = dr::FilterMode::Linear,
-             "wrap_mode"_a = dr::WrapMode::Clamp)
+             "wrap_mode"_a = dr::WrapMode::Clamp,
+             "format"_a = dr::TextureFormat::Float32)
         .def("set_value",  &Tex::set_value,  "value"_a,  "migrate"_a = false)
         .def("set_tensor", &Tex::set_tensor, "tensor"_a, "migrate"_a = false)
+        .def("update_region",
+             [](Tex &texture, const std::array<size_t, Dimension> &offset,
+                const std::array<size_t, Dimension> &extent,
+                const typename Tex::Storage &data) {
+                 texture.update_region(offset.data(), extent.data(), data);
+             }, "offset"_a, "extent"_a, "data"_a)
+        .def("update_texels", &Tex::update_texels, "texel"_a, "data"_a)
         .def("value", &Tex::value, py::return_value_policy::reference_internal)
         .def("tensor",
              py::overload_cast<>(&Tex::tensor, py::const_),
@@ -31,6 +42,13 @@ void bind_texture(py::module &m, const char *name) {
         .def("wrap_mode", &Tex::wrap_mode)
         .def("use_accel", &Tex::use_accel)
         .def("migrated", &Tex::migrated)
+        .def("set_compression", &Tex::set_compression, "compression"_a)
+        .def("compression", &Tex::compression)
+        .def("format", &Tex::format)
+        .def("set_layout", &Tex::set_layout, "layout"_a)
+        .def("layout", &Tex::layout)
+        .def("set_grad_replicas", &Tex::set_grad_replicas, "replicas"_a)
+        .def("grad_replicas", &Tex::grad_replicas)
         .def_property_readonly("shape", [](const Tex &t) {
             PyObject *shape = PyTuple_New(t.ndim());
             for (size_t i = 0; i < t.ndim(); ++i)
@@ -310,6 +310,46 @@ DRJIT_TEST(test06_vcall_symbolic_nested_ad_loop_opt) {
     delete b;
 }
 
+DRJIT_TEST(test06b_vcall_fuse_backward) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    jit_set_flag(JitFlag::VCallRecord, true);
+
+    A *a = new A();
+    B *b = new B();
+    int n = 10;
+    FMask m = dr::neq(dr::arange<UInt32>(n) & 1, 0);
+    BasePtr arr = dr::select(m, (Base *) a, (Base *) b);
+
+    for (int fuse = 0; fuse < 2; ++fuse) {
+        dr::VCallFuseBackwardScope scope(fuse != 0);
+
+        // Explicit arguments only: derivative recorded with the primal call
+        Float v = dr::arange<Float>(n);
+        dr::enable_grad(v);
+        Float y = arr->g(v), loss = y * y;
+        dr::backward(loss);
+        assert(dr::all(dr::eq(dr::grad(v),
+                              dr::select(m, 8.f, 2.f) * dr::arange<Float>(n))));
+
+        // Depends on the instance fields: falls back to the default strategy
+        dr::set_grad(a->x, 0.f);
+        dr::set_grad(b->x, 0.f);
+        Float w = dr::arange<Float>(n);
+        dr::enable_grad(w);
+        size_t implicit = dr::detail::ad_implicit<dr::LLVMArray<float>>();
+        Float z = arr->f(w);
+        // The implicit dependencies were captured and released by the call
+        assert(dr::detail::ad_implicit<dr::LLVMArray<float>>() == implicit);
+        dr::backward(z);
+        assert(dr::all(dr::eq(dr::grad(w), dr::select(m, 10.f, 20.f))));
+        assert(dr::all_nested(dr::eq(dr::grad(a->x), 25.f) &&
+                              dr::eq(dr::grad(b->x), 40.f)));
+    }
+
+    delete a;
+    delete b;
+}
+
 DRJIT_TEST(test07_vcall_within_loop_postpone_bwd) {
     /// postponing of AD edges across vcalls/loops, faux dependencies
 
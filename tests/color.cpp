@@ -29,3 +29,61 @@ DRJIT_TEST_FLOAT(test02_srgb_to_linear) {
     );
 }
 
+
+using FloatP = Packet<float>;
+using UInt32P = uint32_array_t<FloatP>;
+
+static double srgb_ref(double x) {
+    return 255.0 * (x <= 0.0031308 ? 12.92 * x : 1.055 * std::pow(x, 1.0 / 2.4) - 0.055);
+}
+
+DRJIT_TEST(test03_linear_to_srgb8) {
+    // Every 64th float in [0, 1]; ties may round either way
+    for (uint32_t u = 0; u <= 0x3f800000u; u += 64 * FloatP::Size) {
+        UInt32P bits = u + arange<UInt32P>() * 64u;
+        FloatP x = reinterpret_array<FloatP>(bits);
+        UInt32P code = linear_to_srgb8(x);
+
+        for (size_t i = 0; i < FloatP::Size; ++i)
+            assert(std::abs(srgb_ref(x[i]) - code[i]) <= (x[i] > 0.f ? .55 : .5));
+    }
+
+    using Float4 = Array<float, 4>;
+    Float4 special(-1.f, 2.f, NaN<float>, 1.f);
+    assert(linear_to_srgb8(special) == uint32_array_t<Float4>(0, 255, 0, 255));
+}
+
+DRJIT_TEST(test04_srgb8_roundtrip) {
+    for (uint32_t i = 0; i < 256; i += UInt32P::Size) {
+        UInt32P code = i + arange<UInt32P>();
+        FloatP x = srgb8_to_linear(code);
+        for (size_t j = 0; j < FloatP::Size; ++j)
+            assert(std::abs(srgb_ref(x[j]) - code[j]) < 1e-3);
+        assert(linear_to_srgb8(x) == code);
+    }
+
+    using Float4 = Array<float, 4>;
+    using UInt4 = uint32_array_t<Float4>;
+    using Color4f4 = Array<Float4, 4>;
+    Color4f4 color(srgb8_to_linear(UInt4(0, 12, 128, 255)), Float4(1.f),
+                   Float4(0.f), Float4(0.f, .5f, 1.f, .25f));
+    UInt4 packed = pack_srgb8(color);
+    assert(packed[1] == ((128u << 24) | (255u << 8) | 12u));
+    assert(all_nested(abs(unpack_srgb8<Color4f4>(packed) - color) < 3e-3f));
+}
+
+DRJIT_TEST(test05_color_matrices) {
+    using Color3f = Array<float, 3>;
+    Color3f white(1.f), c(.2f, .5f, .9f);
+
+    assert(std::abs(linear_srgb_to_xyz(white).y() - 1.f) < 1e-6f);
+    assert(all(abs(xyz_to_linear_srgb(linear_srgb_to_xyz(c)) - c) < 1e-5f));
+
+    Color3f ycc = srgb_to_ycbcr(white);
+    assert(all(abs(ycc - Color3f(1.f, .5f, .5f)) < 1e-6f));
+    assert(all(abs(ycbcr_to_srgb(srgb_to_ycbcr(c)) - c) < 1e-5f));
+
+    Color3f lab = linear_srgb_to_oklab(white);
+    assert(all(abs(lab - Color3f(1.f, 0.f, 0.f)) < 1e-4f));
+    assert(all(abs(oklab_to_linear_srgb(linear_srgb_to_oklab(c)) - c) < 1e-4f));
+}
@@ -162,3 +162,59 @@ DRJIT_TEST(test20_sincos_arg) {
     assert(abs(result.first + 0.75831358f) < 1e-6f);
     assert(abs(result.second - 0.65188996f) < 1e-6f);
 }
+
+DRJIT_TEST(test21_fast_slerp) {
+    using FloatP = Packet<float>;
+    using QuaternionP = Quaternion<FloatP>;
+
+    Quaternion4f a = normalize(Quaternion4f(1, 2, 3, 4));
+    for (int k = 0; k < 8; ++k) {
+        // Angles between the two rotations of up to 180 degrees
+        Vector3f axis = normalize(Vector3f(3.f, -1.f, 2.f + k));
+        Quaternion4f b = rotate<Quaternion4f>(axis, k * .45f) * a;
+        if (k & 1)
+            b = -b;
+
+        FloatP t = arange<FloatP>() / float(std::max(FloatP::Size - 1, (size_t) 1));
+        QuaternionP qa(a), qb(b);
+        QuaternionP r0 = slerp(qa, qb, t), r1 = fast_slerp(qa, qb, t),
+                    r2 = nlerp(qa, qb, t);
+
+        assert(all(abs(r0.x() - r1.x()) < 5e-5f && abs(r0.y() - r1.y()) < 5e-5f &&
+                   abs(r0.z() - r1.z()) < 5e-5f && abs(r0.w() - r1.w()) < 5e-5f));
+        assert(all(abs(squared_norm(r2) - 1.f) < 1e-5f));
+        assert(abs(fast_slerp(a, b, 0.f) - a) < 1e-6f);
+    }
+}
+
+DRJIT_TEST(test22_dual_quat) {
+    using DualQuaternion4f = DualQuaternion<float>;
+    using Matrix3f = Matrix<float, 3>;
+
+    Quaternion4f r0 = rotate<Quaternion4f>(normalize(Vector3f(1.f, 2.f, 3.f)), .5f),
+                 r1 = rotate<Quaternion4f>(normalize(Vector3f(-1.f, 0.f, 1.f)), 1.2f);
+    Vector3f t0(1.f, -2.f, .5f), t1(-3.f, 1.f, 2.f), p(.3f, .7f, -1.1f);
+
+    DualQuaternion4f dq0 = dual_quat(r0, t0), dq1 = dual_quat(r1, t1);
+    assert(norm(dual_quat_translation(dq0) - t0) < 1e-6f);
+
+    Vector3f ref = quat_to_matrix<Matrix3f>(r0) * p + t0;
+    assert(norm(dual_quat_transform_point(dq0, p) - ref) < 1e-5f);
+    assert(norm(dual_quat_transform_vector(dq0, p) - quat_to_matrix<Matrix3f>(r0) * p) < 1e-5f);
+
+    Matrix4f m = dual_quat_to_matrix<Matrix4f>(dq0);
+    assert(norm(head<3>(m * concat(p, 1.f)) - ref) < 1e-5f);
+
+    // Blending with unit weight reproduces the input, also for r -> -r
+    DualQuaternion4f blend = dual_quat_blend(DualQuaternion4f(zeros<Quaternion4f>(), zeros<Quaternion4f>()),
+                                             dq0, 1.f);
+    blend = normalize(dual_quat_blend(blend, DualQuaternion4f(-dq0.real, -dq0.dual), 1.f));
+    assert(norm(dual_quat_transform_point(blend, p) - ref) < 1e-5f);
+
+    // Blending two transformations preserves rigidity
+    DualQuaternion4f mix = dual_quat_blend(dual_quat_blend(
+        DualQuaternion4f(zeros<Quaternion4f>(), zeros<Quaternion4f>()), dq0, .3f), dq1, .7f);
+    mix = normalize(mix);
+    assert(std::abs(squared_norm(mix.real) - 1.f) < 1e-6f);
+    assert(std::abs(dot(mix.real, mix.dual)) < 1e-6f);
+}
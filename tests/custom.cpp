@@ -152,5 +152,151 @@ DRJIT_TEST(test02_corner_case) {
     }
 
 
+    jit_shutdown(1);
+}
+
+DRJIT_TEST(test03_checkpoint) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    auto func = [](const Vector3f &v, const Float &s) {
+        return dr::sin(v * s) * dr::norm(v);
+    };
+
+    {
+        Vector3f d1(1, 2, 3), d2 = d1;
+        dr::enable_grad(d1, d2);
+        Vector3f r1 = dr::checkpoint<Float>(func, d1, Float(2)),
+                 r2 = func(d2, Float(2));
+        assert(dr::allclose(r1, r2));
+        dr::set_grad(r1, Vector3f(5, 6, 7));
+        dr::set_grad(r2, Vector3f(5, 6, 7));
+        dr::enqueue(ADMode::Backward, r1, r2);
+        dr::traverse<Float>(ADMode::Backward);
+        assert(dr::allclose(dr::grad(d1), dr::grad(d2)));
+    }
+
+    {
+        Vector3f d1(1, 2, 3), d2 = d1;
+        dr::enable_grad(d1, d2);
+        Vector3f r1 = dr::checkpoint<Float>(func, d1, Float(2)),
+                 r2 = func(d2, Float(2));
+        dr::set_grad(d1, Vector3f(5, 6, 7));
+        dr::set_grad(d2, Vector3f(5, 6, 7));
+        dr::enqueue(ADMode::Forward, d1, d2);
+        dr::traverse<Float>(ADMode::Forward);
+        assert(dr::allclose(dr::grad(r1), dr::grad(r2)));
+    }
+
+    jit_shutdown(1);
+}
+
+DRJIT_TEST(test04_no_grad) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    auto func = [](const auto &v, const auto &s) {
+        return dr::sin(v * s) * dr::norm(v);
+    };
+
+    Vector3f d(1, 2, 3);
+    dr::enable_grad(d);
+    auto r1 = dr::no_grad(func, d, Float(2));
+    static_assert(std::is_same_v<decltype(r1), dr::detached_t<Vector3f>>);
+    Vector3f r2 = func(d, Float(2));
+    assert(dr::allclose(r1, dr::detach(r2)));
+
+    jit_shutdown(1);
+}
+
+struct StaticNormalize : dr::StaticCustomOp<Float, Vector3f, Vector3f> {
+    Vector3f eval(const Vector3f &input) {
+        m_input = input;
+        m_inv_norm = dr::rcp(dr::norm(input));
+        return input * m_inv_norm;
+    }
+
+    // Jacobian of the normalization, which is symmetric
+    Vector3f apply(const Vector3f &grad) const {
+        Vector3f result = grad * m_inv_norm;
+        return result - m_input * (dr::dot(m_input, result) * dr::sqr(m_inv_norm));
+    }
+
+    Vector3f forward(const Vector3f &grad_in) { return apply(grad_in); }
+    Inputs backward(const Vector3f &grad_out) { return { apply(grad_out) }; }
+
+    const char *name() const { return "static_normalize"; }
+
+    Float m_inv_norm;
+    Vector3f m_input;
+};
+
+struct StaticScaleAdd : dr::StaticCustomOp<Float, Float, Float, Float, int> {
+    Float eval(const Float &in1, const Float &in2, const int &scale) {
+        m_scale = scale;
+        return (in1 + in2) * scale;
+    }
+
+    Float forward(const Float &grad_in_1, const Float &grad_in_2, const int &) {
+        return (grad_in_1 + grad_in_2) * m_scale;
+    }
+
+    Inputs backward(const Float &grad_out) {
+        return { grad_out * m_scale, grad_out * m_scale, 0 };
+    }
+
+    int m_scale = 0;
+};
+
+DRJIT_TEST(test05_static_custom) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    {
+        Vector3f d(1, 2, 3);
+        dr::enable_grad(d);
+        Vector3f d2 = dr::custom_static<StaticNormalize>(d);
+        assert(dr::allclose(d2, dr::normalize(dr::detach(d))));
+        dr::set_grad(d2, Vector3f(5, 6, 7));
+        dr::enqueue(ADMode::Backward, d2);
+        dr::traverse<Float>(ADMode::Backward);
+        assert(dr::allclose(dr::grad(d), Vector3f(0.610883, 0.152721, -0.305441)));
+    }
+
+    {
+        Vector3f d(1, 2, 3);
+        dr::enable_grad(d);
+        Vector3f d2 = dr::custom_static<StaticNormalize>(d);
+        dr::set_grad(d, Vector3f(5, 6, 7));
+        dr::enqueue(ADMode::Forward, d);
+        dr::traverse<Float>(ADMode::Forward);
+        assert(dr::allclose(dr::grad(d2), Vector3f(0.610883, 0.152721, -0.305441)));
+    }
+
+    {
+        // Single differentiable input and output: no interface nodes
+        Float a(1, 2), b(3, 4);
+        dr::enable_grad(a);
+        Float c = dr::custom_static<StaticScaleAdd>(a, b, 5);
+        assert(dr::allclose(c, Float(20, 30)));
+        dr::backward(c);
+        assert(dr::allclose(dr::grad(a), Float(5, 5)));
+        assert(dr::allclose(dr::grad(b), Float(0, 0)));
+    }
+
+    {
+        Float a(1, 2), b(3, 4);
+        dr::enable_grad(a, b);
+        Float c = dr::custom_static<StaticScaleAdd>(a, b, 2);
+        dr::set_grad(a, Float(1, 2));
+        dr::set_grad(b, Float(3, 5));
+        dr::enqueue(ADMode::Forward, a, b);
+        dr::traverse<Float>(ADMode::Forward);
+        assert(dr::allclose(dr::grad(c), Float(8, 14)));
+    }
+
+    {
+        // No differentiable inputs: the output remains detached
+        Float c = dr::custom_static<StaticScaleAdd>(Float(1), Float(2), 3);
+        assert(!dr::grad_enabled(c));
+    }
+
     jit_shutdown(1);
 }
@@ -0,0 +1,63 @@
+/*
+    tests/dispatch.cpp -- tests for runtime instruction set dispatch
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/dispatch.h>
+
+DRJIT_ISA_DECLARE(PacketISA, dispatch_kernel, (float *, size_t, float))
+
+DRJIT_TEST(test01_host_isa) {
+    assert(isa_supported(CompiledISA));
+    assert(isa_supported(PacketISA::None));
+    assert(isa_supported(host_isa()));
+    assert(host_packet_size() == packet_size(host_isa()));
+    assert(packet_size(PacketISA::AVX512) == 16);
+    assert(packet_size(PacketISA::None) == 1);
+
+    if (isa_supported(PacketISA::AVX512))
+        assert(isa_supported(PacketISA::AVX2));
+    if (isa_supported(PacketISA::AVX2))
+        assert(isa_supported(PacketISA::AVX));
+    if (isa_supported(PacketISA::AVX))
+        assert(isa_supported(PacketISA::SSE42));
+}
+
+DRJIT_TEST(test02_dispatch) {
+    ISADispatch<PacketISA(float *, size_t, float)> kernel {
+        DRJIT_ISA_VARIANTS(dispatch_kernel)
+    };
+
+    float data[37];
+    for (size_t i = 0; i < 37; ++i)
+        data[i] = (float) i;
+
+    // The best variant supported by the host is chosen
+    PacketISA isa = kernel(data, 37, 2.f);
+    assert(isa == kernel.isa());
+    assert(isa == host_isa());
+
+    for (size_t i = 0; i < 37; ++i)
+        assert(data[i] == (float) i * 2.f + 1.f);
+}
+
+DRJIT_TEST(test03_dispatch_fallback) {
+    // Variants without an implementation are skipped
+    ISADispatch<PacketISA(float *, size_t, float)> kernel {
+        { PacketISA::AVX512, nullptr },
+        { PacketISA::None, &dispatch_kernel_none }
+    };
+
+    float value = 3.f;
+    assert(kernel(&value, 1, 2.f) == PacketISA::None);
+    assert(value == 7.f);
+}
@@ -0,0 +1,35 @@
+/*
+    tests/dispatch_kernel.cpp -- kernel compiled once per instruction set,
+    used by tests/dispatch.cpp
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include <drjit/packet.h>
+#include <drjit/dispatch.h>
+
+namespace dr = drjit;
+
+/// Computes data[i] = data[i] * scale + 1, returns the instruction set used
+dr::PacketISA DRJIT_ISA_NAME(dispatch_kernel)(float *data, size_t size,
+                                              float scale) {
+    using FloatP = dr::Packet<float>;
+
+    size_t i = 0;
+    for (; i + FloatP::Size <= size; i += FloatP::Size) {
+        FloatP value = dr::load<FloatP>(data + i);
+        dr::store(data + i, dr::fmadd(value, scale, 1.f));
+    }
+
+    for (; i < size; ++i)
+        data[i] = data[i] * scale + 1.f;
+
+    return dr::CompiledISA;
+}
@@ -0,0 +1,96 @@
+/*
+    tests/distribution.cpp -- tests discrete distributions based on alias tables
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/jit.h>
+#include <drjit/autodiff.h>
+#include <drjit/distribution.h>
+
+namespace dr = drjit;
+
+using Float   = dr::DiffArray<dr::LLVMArray<float>>;
+using FloatD  = dr::LLVMArray<float>;
+using UInt32  = dr::LLVMArray<uint32_t>;
+using Array2f = dr::Array<FloatD, 2>;
+
+/// Stratified samples on [0, 1)
+FloatD stratified(uint32_t count) {
+    return (dr::arange<FloatD>(count) + .5f) * (1.f / (float) count);
+}
+
+/// Relative frequency with which each of 'n' entries was sampled
+FloatD histogram(const UInt32 &index, uint32_t n) {
+    FloatD hist = dr::zeros<FloatD>(n);
+    dr::scatter_reduce(ReduceOp::Add, hist, dr::full<FloatD>(1.f, dr::width(index)), index);
+    return hist * (1.f / (float) dr::width(index));
+}
+
+DRJIT_TEST(test01_discrete_1d) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    FloatD raw = dr::arange<FloatD>(97);
+    Float weights = Float(dr::select(dr::eq(raw % 7.f, 0.f), 0.f, raw * raw + 1.f - raw % 13.f));
+    dr::DiscreteDistribution<Float> distr(weights);
+
+    uint32_t n = distr.size();
+    assert(n == 97);
+    FloatD pmf = dr::detach(distr.pdf(dr::arange<UInt32>(n)));
+    assert(dr::abs(dr::sum(pmf)[0] - 1.f) < 1e-5f);
+
+    UInt32 index = distr.sample(stratified(n * 1024));
+    assert(dr::all(dr::abs(histogram(index, n) - pmf) < 1e-4f));
+
+    // Zero-weight entries are never sampled
+    assert(dr::none(dr::eq(dr::gather<FloatD>(pmf, index), 0.f)));
+
+    // Reused samples remain uniformly distributed
+    auto [index2, u2] = distr.sample_reuse(stratified(n * 1024));
+    assert(dr::all(dr::eq(index2, index)));
+    assert(dr::all(u2 >= 0.f && u2 < 1.f));
+    assert(dr::abs(dr::mean(u2)[0] - .5f) < 1e-3f);
+
+    // Rebuild after changing the weights
+    distr.weights = Float(dr::full<FloatD>(1.f, 16));
+    distr.update();
+    assert(distr.size() == 16);
+    index = distr.sample(stratified(16 * 64));
+    assert(dr::all(dr::abs(histogram(index, 16) - 1.f / 16.f) < 1e-6f));
+}
+
+DRJIT_TEST(test02_discrete_2d) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    uint32_t width = 13, height = 7, n = width * height;
+    UInt32 i = dr::arange<UInt32>(n);
+    FloatD x = FloatD(i % width), y = FloatD(i / width),
+           w = dr::select(dr::eq(y, 3.f), 0.f, x * x + y + 1.f);
+    dr::DiscreteDistribution2D<Float> distr(Float(w), width, height);
+
+    // Stratified 2D samples with 64 x 64 samples per pixel
+    uint32_t res_x = width * 64, res_y = height * 64;
+    UInt32 j = dr::arange<UInt32>(res_x * res_y);
+    Array2f u((FloatD(j % res_x) + .5f) / (float) res_x,
+              (FloatD(j / res_x) + .5f) / (float) res_y);
+
+    auto pos = distr.sample(u);
+    FloatD pmf = dr::detach(distr.pdf(dr::Array<UInt32, 2>(i % width, i / width)));
+    assert(dr::abs(dr::sum(pmf)[0] - 1.f) < 1e-5f);
+    assert(dr::all(dr::abs(histogram(pos.y() * width + pos.x(), n) - pmf) < 1e-3f));
+
+    auto [p, density] = distr.sample_continuous(u);
+    assert(dr::all(p.x() >= 0.f && p.x() <= 1.f && p.y() >= 0.f && p.y() <= 1.f));
+    UInt32 pixel = dr::minimum(UInt32(p.y() * (float) height), height - 1) * width +
+                   dr::minimum(UInt32(p.x() * (float) width), width - 1);
+    assert(dr::all(dr::eq(pixel, pos.y() * width + pos.x())));
+    assert(dr::all(dr::abs(dr::detach(density) -
+                           dr::gather<FloatD>(pmf, pixel) * (float) n) < 1e-4f));
+}
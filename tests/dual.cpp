@@ -0,0 +1,65 @@
+/*
+    tests/dual.cpp -- tests dual numbers for forward-mode differentiation
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/dual.h>
+#include <drjit/math.h>
+
+using Df = Dual<double>;
+using P = Packet<float, 8>;
+using DP = Dual<P>;
+
+DRJIT_TEST(test00_dual_arith) {
+    Df x(3.0, 1.0), y(2.0, 0.0);
+    assert(primal(x * y + x) == 9.0 && tangent(x * y + x) == 3.0);
+    assert(primal(x / y) == 1.5 && tangent(x / y) == 0.5);
+    assert(tangent(y / x) == -2.0 / 9.0);
+    assert(tangent(rcp(x)) == -1.0 / 9.0);
+    assert(tangent(x * 2.0) == 2.0 && tangent(2.0 * x) == 2.0);
+    assert(tangent(Df(4.0)) == 0.0);
+    assert(tangent(fmadd(x, x, y)) == 6.0);
+}
+
+DRJIT_TEST(test01_dual_math) {
+    double v = 0.3;
+    Df x(v, 1.0);
+    auto check = [](const Df &d, double ref) {
+        assert(std::abs(tangent(d) - ref) < 1e-6 * std::abs(ref));
+    };
+    check(sqrt(x), .5 / std::sqrt(v));
+    check(rsqrt(x), -.5 * std::pow(v, -1.5));
+    check(cbrt(x), std::pow(v, -2.0 / 3.0) / 3.0);
+    check(exp(x), std::exp(v));
+    check(log(x), 1.0 / v);
+    check(sin(x), std::cos(v));
+    check(cos(x), -std::sin(v));
+    check(tan(x), 1.0 / (std::cos(v) * std::cos(v)));
+    check(asin(x), 1.0 / std::sqrt(1.0 - v * v));
+    check(acos(x), -1.0 / std::sqrt(1.0 - v * v));
+    check(atan(x), 1.0 / (1.0 + v * v));
+    check(tanh(x), 1.0 - std::tanh(v) * std::tanh(v));
+    check(pow(x, 3.0), 3.0 * v * v);
+    check(abs(-x), 1.0);
+    check(atan2(x, Df(2.0)), 2.0 / (4.0 + v * v));
+}
+
+DRJIT_TEST(test02_dual_packet) {
+    P v = linspace<P>(.1f, .8f);
+    DP x(v, P(1.f));
+    DP y = sin(x) * exp(x) + x * x;
+    P ref = exp(v) * (sin(v) + cos(v)) + 2.f * v;
+    assert(all(abs(tangent(y) - ref) < 1e-5f));
+    assert(all(abs(primal(y) - (sin(v) * exp(v) + v * v)) < 1e-5f));
+    DP m = maximum(x, DP(P(.5f)));
+    assert(all(eq(tangent(m), select(v >= .5f, 1.f, 0.f))));
+}
@@ -0,0 +1,78 @@
+#include "test.h"
+
+using fast::Accuracy;
+
+/// Check the maximum absolute or relative error of 'func' on [min, max]
+template <typename T, typename Func, typename Ref>
+void check_error(Func func, Ref ref, double min, double max, double max_err,
+                 bool relative = true) {
+    using Value = value_t<T>;
+    const size_t n = 10000;
+    double err = 0;
+
+    for (size_t i = 0; i < n; i += T::Size) {
+        T x;
+        for (size_t k = 0; k < T::Size; ++k)
+            x[k] = Value(min + (max - min) * double(std::min(i + k, n - 1)) / double(n - 1));
+
+        T result = func(x);
+        for (size_t k = 0; k < T::Size; ++k) {
+            double r = ref(double(x[k])),
+                   e = std::abs(double(result[k]) - r);
+            if (relative && r != 0)
+                e /= std::abs(r);
+            err = std::max(err, e);
+        }
+    }
+
+    assert(err < max_err);
+}
+
+DRJIT_TEST_FLOAT(test01_sin) {
+    auto ref = [](double a) { return std::sin(a); };
+    check_error<T>([](const T &a) { return fast::sin<Accuracy::Medium>(a); }, ref, -8192, 8192, 2e-7, false);
+    check_error<T>([](const T &a) { return fast::sin<Accuracy::Low>(a); }, ref, -8192, 8192, 5e-6, false);
+    check_error<T>([](const T &a) { return fast::sincos<Accuracy::Low>(a).first; }, ref, -8192, 8192, 5e-6, false);
+}
+
+DRJIT_TEST_FLOAT(test02_cos) {
+    auto ref = [](double a) { return std::cos(a); };
+    check_error<T>([](const T &a) { return fast::cos<Accuracy::Medium>(a); }, ref, -8192, 8192, 2e-7, false);
+    check_error<T>([](const T &a) { return fast::cos<Accuracy::Low>(a); }, ref, -8192, 8192, 5e-6, false);
+    check_error<T>([](const T &a) { return fast::sincos<Accuracy::Low>(a).second; }, ref, -8192, 8192, 5e-6, false);
+}
+
+DRJIT_TEST_FLOAT(test03_exp) {
+    auto ref = [](double a) { return std::exp(a); };
+    check_error<T>([](const T &a) { return fast::exp<Accuracy::Medium>(a); }, ref, -20, 30, 1e-6);
+    check_error<T>([](const T &a) { return fast::exp<Accuracy::Low>(a); }, ref, -20, 30, 1e-4);
+}
+
+DRJIT_TEST_FLOAT(test04_exp2) {
+    auto ref = [](double a) { return std::exp2(a); };
+    check_error<T>([](const T &a) { return fast::exp2<Accuracy::Medium>(a); }, ref, -20, 30, 1e-6);
+    check_error<T>([](const T &a) { return fast::exp2<Accuracy::Low>(a); }, ref, -20, 30, 1e-4);
+}
+
+DRJIT_TEST_FLOAT(test05_log) {
+    auto ref = [](double a) { return std::log(a); };
+    check_error<T>([](const T &a) { return fast::log<Accuracy::Medium>(a); }, ref, 1e-20, 1000, 1e-6);
+    check_error<T>([](const T &a) { return fast::log<Accuracy::Low>(a); }, ref, 1e-20, 1000, 1e-4);
+
+    auto ref2 = [](double a) { return std::log2(a); };
+    check_error<T>([](const T &a) { return fast::log2<Accuracy::Medium>(a); }, ref2, 1e-20, 1000, 1e-6);
+    check_error<T>([](const T &a) { return fast::log2<Accuracy::Low>(a); }, ref2, 1e-20, 1000, 1e-4);
+}
+
+DRJIT_TEST_FLOAT(test06_erf) {
+    auto ref = [](double a) { return std::erf(a); };
+    check_error<T>([](const T &a) { return fast::erf<Accuracy::Medium>(a); }, ref, -6, 6, 1e-6);
+    check_error<T>([](const T &a) { return fast::erf<Accuracy::Low>(a); }, ref, -6, 6, 1e-4);
+}
+
+DRJIT_TEST_FLOAT(test07_erfinv) {
+    // Use the round trip through std::erf() as a reference
+    auto ref = [](double a) { return a; };
+    check_error<T>([](const T &a) { return T(erf(fast::erfinv<Accuracy::Medium>(a))); }, ref, -0.999, 0.999, 1e-6);
+    check_error<T>([](const T &a) { return T(erf(fast::erfinv<Accuracy::Low>(a))); }, ref, -0.999, 0.999, 1e-4);
+}
@@ -241,3 +241,32 @@ DRJIT_TEST_FLOAT(test20_cbrt) {
     assert(drjit::cbrt(T(0)) == T(0));
     assert(drjit::cbrt(0.f) == 0.f);
 }
+
+DRJIT_TEST_FLOAT(test21_half_exhaustive) {
+    /* Every half precision value is exactly representable in single and
+       double precision, hence all of them must survive a round trip */
+    using Half = replace_scalar_t<T, half>;
+
+    for (uint32_t base = 0; base < 0x10000; base += (uint32_t) Size) {
+        Half h(T(0));
+        for (size_t i = 0; i < Size; ++i)
+            h.entry(i) = half::from_binary(uint16_t(base + i));
+
+        T value(h);
+        Half h2(value);
+
+        for (size_t i = 0; i < Size; ++i) {
+            uint16_t bits = h.entry(i).value, bits2 = h2.entry(i).value;
+            float ref = half::float16_to_float32(bits);
+
+            if (std::isnan(ref)) {
+                assert(std::isnan(value.entry(i)));
+                assert((bits2 & 0x7C00) == 0x7C00 && (bits2 & 0x3FF) != 0);
+            } else {
+                assert(value.entry(i) == Value(ref));
+                assert(std::signbit(value.entry(i)) == std::signbit(ref));
+                assert(bits2 == bits);
+            }
+        }
+    }
+}
@@ -243,3 +243,49 @@ DRJIT_TEST_ALL(test13_max_inner_nested) {
     assert(max_inner(x) == y);
     assert(max_nested(x) == max(y));
 }
+
+DRJIT_TEST_ALL(test14_segmented_reduce) {
+    T a;
+    for (size_t i = 0; i < Size; ++i)
+        a.entry(i) = Value((i * 7) % 11);
+
+    auto check = [&](auto group) {
+        constexpr size_t Group = decltype(group)::value;
+        if constexpr (Size % Group == 0) {
+            T s = segmented_sum<Group>(a), mn = segmented_min<Group>(a),
+              mx = segmented_max<Group>(a);
+            for (size_t i = 0; i < Size; ++i) {
+                size_t start = i - i % Group;
+                Value ref_s = 0, ref_mn = a.entry(start), ref_mx = a.entry(start);
+                for (size_t j = start; j < start + Group; ++j) {
+                    ref_s += a.entry(j);
+                    ref_mn = std::min(ref_mn, a.entry(j));
+                    ref_mx = std::max(ref_mx, a.entry(j));
+                }
+                assert(s.entry(i) == ref_s);
+                assert(mn.entry(i) == ref_mn);
+                assert(mx.entry(i) == ref_mx);
+            }
+        }
+    };
+
+    check(std::integral_constant<size_t, 1>());
+    check(std::integral_constant<size_t, 2>());
+    check(std::integral_constant<size_t, 4>());
+    check(std::integral_constant<size_t, 8>());
+    check(std::integral_constant<size_t, 16>());
+}
+
+DRJIT_TEST_ALL(test15_prefix_sum) {
+    T a;
+    for (size_t i = 0; i < Size; ++i)
+        a.entry(i) = Value((i * 7) % 11);
+
+    T incl = prefix_sum(a, false), excl = prefix_sum(a);
+    Value accum = 0;
+    for (size_t i = 0; i < Size; ++i) {
+        assert(excl.entry(i) == accum);
+        accum += a.entry(i);
+        assert(incl.entry(i) == accum);
+    }
+}
@@ -14,6 +14,7 @@
 #include "test.h"
 #include <random>
 #include <drjit/idiv.h>
+#include <drjit/dynamic.h>
 
 #define ITERATIONS 1000000
 
@@ -135,3 +136,77 @@ DRJIT_TEST_INT(test04_idiv_vector) {
         assert((T(y) % i)[0] == y % i);
     }
 }
+
+DRJIT_TEST_INT(test05_idiv_per_lane) {
+    using Dynamic = DynamicArray<Value>;
+    using Index = uint32_array_t<T>;
+    std::mt19937_64 mt;
+
+    // Table of divisors mixing random values, small values and powers of two
+    Value table[64];
+    for (size_t i = 0; i < 64; ++i) {
+        Value d = i < 16 ? Value(i + 1) : i < 32 ? Value(Value(1) << (i % 31)) : Value(mt() >> (i % 48));
+        if (d == 0)
+            d = 3;
+        if (std::is_signed_v<Value> && (i & 1))
+            d = Value(0) - d;
+        table[i] = d;
+    }
+
+    divisor<Dynamic> precomp(load<Dynamic>(table, 64));
+
+    for (size_t it = 0; it < 10000; ++it) {
+        T x, d;
+        Index index;
+        for (size_t k = 0; k < Size; ++k) {
+            x.entry(k) = (Value) mt();
+            index.entry(k) = (uint32_t) (mt() % 64);
+            d.entry(k) = table[index.entry(k)];
+        }
+        if (it & 1)
+            x = sr<7>(x);
+
+        divisor<T> div = gather<divisor<T>>(precomp, index);
+        divisor<T> div2(d);
+
+        auto [q, r] = idivmod(x, div);
+        T q2 = idiv(x, div2), r2 = imod(x, div2);
+        for (size_t k = 0; k < Size; ++k) {
+            Value ref_q = x.entry(k) / d.entry(k), ref_r = x.entry(k) % d.entry(k);
+            assert(q.entry(k) == ref_q && r.entry(k) == ref_r);
+            assert(q2.entry(k) == ref_q && r2.entry(k) == ref_r);
+        }
+    }
+}
+
+DRJIT_TEST_INT(test06_idiv24) {
+    std::mt19937 mt;
+
+    for (size_t it = 0; it < 100000; ++it) {
+        T x, d;
+        for (size_t k = 0; k < Size; ++k) {
+            x.entry(k) = (Value) (mt() >> 8);
+            d.entry(k) = (Value) ((mt() >> (8 + (it % 24))) | 1);
+        }
+        // Exact multiples and remainders of d - 1 stress the correction step
+        for (size_t k = 0; k < Size; ++k) {
+            Value xk = x.entry(k), dk = d.entry(k);
+            if (it % 3 == 0)
+                x.entry(k) = xk - xk % dk;
+            else if (it % 3 == 1 && xk >= dk)
+                x.entry(k) = xk - xk % dk - 1;
+        }
+
+        auto [q, r] = idivmod24(x, d);
+        for (size_t k = 0; k < Size; ++k)
+            assert(q.entry(k) == x.entry(k) / d.entry(k) &&
+                   r.entry(k) == x.entry(k) % d.entry(k));
+    }
+
+    // Largest operands and exact multiples
+    for (Value d : { Value(1), Value(3), Value(4093), Value(0xffffff) }) {
+        Value x = Value(0xffffff) - Value(0xffffff) % d;
+        assert(all(eq(idiv24(T(x), T(d)), T(x / d))));
+        assert(all(eq(imod24(T(x), T(d)), T(0))));
+    }
+}
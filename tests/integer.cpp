@@ -12,6 +12,7 @@
 */
 
 #include "test.h"
+#include <random>
 
 DRJIT_TEST_INT(test01_or) {
     auto sample = test::sample_values<Value>();
@@ -141,3 +142,19 @@ DRJIT_TEST_INT(test07_bmi) {
     assert(popcnt(T(v))[0] == (sizeof(Value) == 8 ? 64 : 32));
     assert(popcnt(v) == (sizeof(Value) == 8 ? 64 : 32));
 }
+
+DRJIT_TEST_INT(test08_mulhi) {
+    std::mt19937_64 mt;
+    for (int i = 0; i < 1000; ++i) {
+        T a, b;
+        for (size_t j = 0; j < Size; ++j) {
+            /* Include small and negative values */
+            a.entry(j) = (Value) (i % 4 == 0 ? mt() % 16 : mt());
+            b.entry(j) = (Value) (i % 4 == 1 ? (Value) -(Value) (mt() % 16) : (Value) mt());
+        }
+
+        T r = mulhi(a, b);
+        for (size_t j = 0; j < Size; ++j)
+            assert(r.entry(j) == mulhi(a.entry(j), b.entry(j)));
+    }
+}
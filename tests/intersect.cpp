@@ -0,0 +1,210 @@
+/*
+    tests/intersect.cpp -- tests ray-box, ray-triangle and ray-sphere
+    intersection routines
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/intersect.h>
+#include <random>
+
+using FloatP   = Array<float>;
+using MaskP    = mask_t<FloatP>;
+using Vector3f = Array<float, 3>;
+using Vector3d = Array<double, 3>;
+using Vector3P = Array<FloatP, 3>;
+
+/// Random rays starting within [-3, 3]^3, with about a third of the direction components exactly zero
+struct Rays {
+    std::vector<Vector3f> o, d;
+
+    Rays(size_t count) {
+        std::mt19937 gen(0);
+        std::uniform_real_distribution<float> pos(-3.f, 3.f);
+        std::uniform_int_distribution<int> coin(0, 2);
+        for (size_t i = 0; i < count; ++i) {
+            Vector3f oi, di;
+            for (size_t k = 0; k < 3; ++k) {
+                oi[k] = pos(gen);
+                di[k] = coin(gen) == 0 ? 0.f : pos(gen);
+            }
+            if (all(eq(di, 0.f)))
+                di.x() = 1.f;
+            o.push_back(oi);
+            d.push_back(di);
+        }
+    }
+
+    /// Load rays [i, i + Size) into packets
+    std::pair<Vector3P, Vector3P> packet(size_t i) const {
+        Vector3P op, dp;
+        for (size_t j = 0; j < FloatP::Size; ++j) {
+            for (size_t k = 0; k < 3; ++k) {
+                op.entry(k).entry(j) = o[i + j][k];
+                dp.entry(k).entry(j) = d[i + j][k];
+            }
+        }
+        return { op, dp };
+    }
+};
+
+/// First lane of a packet of vectors
+Vector3d first(const Vector3P &v) {
+    return Vector3d(v.x().entry(0), v.y().entry(0), v.z().entry(0));
+}
+
+DRJIT_TEST(test01_ray_box) {
+    Rays rays(4096);
+    Vector3P lo(-1.f, -1.5f, -.5f), hi(1.f, .5f, 2.f);
+
+    for (size_t i = 0; i < rays.o.size(); i += FloatP::Size) {
+        auto [o, d] = rays.packet(i);
+        auto [hit, t_near, t_far] =
+            ray_box(o, ray_rcp_dir(d), lo, hi, FloatP(0.f), FloatP(10.f));
+
+        for (size_t j = 0; j < FloatP::Size; ++j) {
+            // Reference slab test in double precision
+            Vector3d oj(rays.o[i + j]), dj(rays.d[i + j]);
+            double t0 = 0, t1 = 10;
+            for (size_t k = 0; k < 3; ++k) {
+                double l = lo.entry(k).entry(0), h = hi.entry(k).entry(0);
+                if (dj[k] == 0) {
+                    if (oj[k] < l || oj[k] > h)
+                        t1 = -1;
+                    continue;
+                }
+                double ta = (l - oj[k]) / dj[k], tb = (h - oj[k]) / dj[k];
+                t0 = std::max(t0, std::min(ta, tb));
+                t1 = std::min(t1, std::max(ta, tb));
+            }
+
+            assert(!std::isnan(t_near.entry(j)) && !std::isnan(t_far.entry(j)));
+            if (std::abs(t1 - t0) < 1e-4)
+                continue; // grazing ray
+            assert(hit.entry(j) == (t0 <= t1));
+            if (t0 <= t1) {
+                assert(std::abs(t_near.entry(j) - t0) < 1e-4 * std::max(1.0, t0));
+                assert(std::abs(t_far.entry(j) - t1) < 1e-4 * std::max(1.0, t1));
+            }
+        }
+    }
+
+    // Ray running within a face of the box
+    auto [hit, t_near, t_far] =
+        ray_box(Vector3P(-2.f, .5f, 0.f), ray_rcp_dir(Vector3P(1.f, 0.f, 0.f)),
+                lo, hi, FloatP(0.f), FloatP(10.f));
+    assert(all(hit) && all(abs(t_near - 1.f) < 1e-5f) && all(abs(t_far - 3.f) < 1e-5f));
+}
+
+DRJIT_TEST(test02_ray_triangle) {
+    Rays rays(4096);
+    Vector3P p0(-1.f, -1.f, .5f), p1(1.5f, -1.f, -.5f), p2(0.f, 1.f, .25f);
+
+    for (size_t i = 0; i < rays.o.size(); i += FloatP::Size) {
+        auto [o, d] = rays.packet(i);
+        auto [hit, t, u, v] = ray_triangle(TriangleRay<Vector3P>(o, d), p0,
+                                           p1, p2, FloatP(0.f), FloatP(100.f));
+        Vector3P p = (1.f - u - v) * p0 + u * p1 + v * p2;
+
+        for (size_t j = 0; j < FloatP::Size; ++j) {
+            // Reference: plane intersection and inside-outside test in double precision
+            Vector3d oj(rays.o[i + j]), dj(rays.d[i + j]),
+                     a = first(p0), b = first(p1), c = first(p2),
+                     nj = cross(b - a, c - a);
+            double denom = dot(nj, dj);
+            if (std::abs(denom) < 1e-3)
+                continue;
+            double tj = dot(nj, a - oj) / denom;
+            Vector3d q = oj + tj * dj;
+            double e0 = dot(cross(b - a, q - a), nj),
+                   e1 = dot(cross(c - b, q - b), nj),
+                   e2 = dot(cross(a - c, q - c), nj),
+                   margin = 1e-4 * squared_norm(nj);
+            bool inside = e0 > 0 && e1 > 0 && e2 > 0,
+                 outside = e0 < 0 || e1 < 0 || e2 < 0;
+            if (tj > 0 && tj < 100 &&
+                std::min({ std::abs(e0), std::abs(e1), std::abs(e2) }) < margin)
+                continue; // close to an edge
+            if (std::abs(tj) < 1e-4)
+                continue;
+
+            bool ref = tj > 0 && tj < 100 && inside && !outside;
+            assert(hit.entry(j) == ref);
+            if (ref) {
+                assert(std::abs(t.entry(j) - tj) < 1e-3 * std::max(1.0, tj));
+                for (size_t k = 0; k < 3; ++k)
+                    assert(std::abs(p.entry(k).entry(j) - q[k]) < 1e-3);
+            }
+        }
+    }
+}
+
+DRJIT_TEST(test03_ray_triangle_watertight) {
+    // Two triangles sharing the diagonal of a quad in the z=1 plane
+    Vector3P a(-1.f, -1.f, 1.f), b(1.f, -1.f, 1.f), c(1.f, 1.f, 1.f),
+             d(-1.f, 1.f, 1.f);
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<float> s(-1.f, 1.f);
+    for (size_t i = 0; i < 10000; ++i) {
+        // Rays through points on the shared edge, from random origins
+        FloatP x, ox, oy;
+        for (size_t j = 0; j < FloatP::Size; ++j) {
+            x.entry(j) = s(gen);
+            ox.entry(j) = s(gen) * 3.f;
+            oy.entry(j) = s(gen) * 3.f;
+        }
+        Vector3P o(ox, oy, -2.f), dir = Vector3P(x, x, 1.f) - o;
+        TriangleRay<Vector3P> ray(o, dir);
+
+        auto [hit_0, t_0, u_0, v_0] = ray_triangle(ray, a, b, c, FloatP(0.f), FloatP(10.f));
+        auto [hit_1, t_1, u_1, v_1] = ray_triangle(ray, a, c, d, FloatP(0.f), FloatP(10.f));
+        assert(all(hit_0 || hit_1));
+    }
+}
+
+DRJIT_TEST(test04_ray_sphere) {
+    Rays rays(4096);
+    Vector3P center(.5f, -.25f, 0.f);
+    FloatP radius(1.25f);
+
+    for (size_t i = 0; i < rays.o.size(); i += FloatP::Size) {
+        auto [o, d] = rays.packet(i);
+        auto [hit, t] = ray_sphere(o, d, center, radius, FloatP(0.f), FloatP(100.f));
+
+        for (size_t j = 0; j < FloatP::Size; ++j) {
+            Vector3d oj(rays.o[i + j]), dj(rays.d[i + j]), cj = first(center),
+                     f = oj - cj;
+            double qa = dot(dj, dj), qb = dot(f, dj),
+                   qc = dot(f, f) - 1.25 * 1.25,
+                   disc = qb * qb - qa * qc;
+            if (std::abs(disc) < 1e-3 * qa || std::abs(qc) < 1e-4)
+                continue; // tangent ray or origin on the surface
+
+            double ref = -1;
+            if (disc > 0) {
+                double t0 = (-qb - std::sqrt(disc)) / qa,
+                       t1 = (-qb + std::sqrt(disc)) / qa;
+                ref = t0 > 0 ? t0 : t1;
+            }
+            bool ref_hit = ref > 0 && ref < 100;
+            assert(hit.entry(j) == ref_hit);
+            if (ref_hit)
+                assert(std::abs(t.entry(j) - ref) < 1e-4 * std::max(1.0, ref));
+        }
+    }
+
+    // Distant sphere: the naive discriminant b^2 - a c cancels catastrophically
+    auto [hit, t] = ray_sphere(Vector3P(0.f, 0.f, -1e4f), Vector3P(0.f, 1e-7f, 1.f),
+                               Vector3P(0.f), FloatP(1e-2f), FloatP(0.f),
+                               FloatP(2e4f));
+    assert(all(hit) && all(abs(t - (1e4f - 1e-2f)) < 1.f));
+}
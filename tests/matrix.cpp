@@ -64,3 +64,193 @@ DRJIT_TEST(test02_gather) {
     test_gather<Matrix22f>();
     test_gather<Quaternion4f>();
 }
+
+template <size_t Size, typename Value = Float>
+dr::Matrix<Value, Size> test_matrix(size_t n) {
+    dr::Matrix<Value, Size> m;
+    Value lane = dr::arange<Value>(n);
+    for (size_t i = 0; i < Size; ++i)
+        for (size_t j = 0; j < Size; ++j)
+            m(i, j) = dr::sin(lane * .37f + float(i * i * 13 + j * 7 + i * j * 3)) +
+                      (i == j ? 1.5f : 0.f);
+    return m;
+}
+
+template <size_t Size> dr::Array<Float, Size> test_vector(size_t n) {
+    dr::Array<Float, Size> v;
+    Float lane = dr::arange<Float>(n);
+    for (size_t i = 0; i < Size; ++i)
+        v.entry(i) = dr::cos(lane * .21f + float(i * 5));
+    return v;
+}
+
+template <typename T> float max_error(const T &a, const T &b) {
+    return dr::max_nested(dr::abs(a - b));
+}
+
+template <size_t Size> void test_solvers() {
+    using Matrix = dr::Matrix<Float, Size>;
+    using Vector = dr::Array<Float, Size>;
+    size_t n = 64;
+
+    Matrix A = test_matrix<Size>(n);
+    Vector b = test_vector<Size>(n);
+
+    // A x = b via LU with partial pivoting
+    Vector x = dr::solve(A, b);
+    assert(max_error(A * x, b) < 1e-3f);
+
+    // Cholesky decomposition of a symmetric positive definite matrix
+    Matrix S = A * dr::transpose(A) + dr::identity<Matrix>();
+    Matrix L = dr::cholesky(S);
+    for (size_t i = 0; i < Size; ++i)
+        for (size_t j = i + 1; j < Size; ++j)
+            assert(dr::all(dr::eq(L(i, j), 0.f)));
+    assert(max_error(L * dr::transpose(L), S) < 1e-4f);
+    assert(max_error(S * dr::cholesky_solve(L, b), b) < 1e-3f);
+
+    // Householder QR decomposition
+    auto [Q, R] = dr::qr_decomp(A);
+    for (size_t i = 0; i < Size; ++i)
+        for (size_t j = 0; j < i; ++j)
+            assert(dr::all(dr::eq(R(i, j), 0.f)));
+    assert(max_error(Q * dr::transpose(Q), dr::identity<Matrix>()) < 1e-5f);
+    assert(max_error(Q * R, A) < 1e-5f);
+    assert(max_error(A * dr::qr_solve(Q, R, b), b) < 1e-3f);
+}
+
+DRJIT_TEST(test03_solvers) {
+    test_solvers<3>();
+    test_solvers<6>();
+    test_solvers<8>();
+}
+
+DRJIT_TEST(test04_lu_pivoting) {
+    // A permutation matrix cannot be factored without row exchanges
+    using Matrix4f = dr::Matrix<Float, 4>;
+    using Vector4f = dr::Array<Float, 4>;
+
+    Matrix4f P(0.f, 1.f, 0.f, 0.f,
+               0.f, 0.f, 0.f, 1.f,
+               1.f, 0.f, 0.f, 0.f,
+               0.f, 0.f, 1.f, 0.f);
+    Vector4f b(1.f, 2.f, 3.f, 4.f);
+
+    auto [LU, perm] = dr::lu_decomp(P);
+    assert(dr::all_nested(dr::eq(perm, dr::Array<UInt32, 4>(2u, 0u, 3u, 1u))));
+    assert(dr::all_nested(dr::eq(dr::lu_solve(LU, perm, b),
+                                 Vector4f(3.f, 1.f, 4.f, 2.f))));
+}
+
+using Double = dr::DynamicArray<double>;
+
+template <typename Float, size_t Size>
+dr::Matrix<Float, Size> test_symmetric(size_t n) {
+    dr::Matrix<Float, Size> m;
+    Float lane = dr::arange<Float>(n);
+    for (size_t i = 0; i < Size; ++i)
+        for (size_t j = 0; j <= i; ++j)
+            m(i, j) = m(j, i) = dr::sin(lane * 1.37f + float(i * i * 13 + j * 7));
+    return m;
+}
+
+template <size_t Size> void test_eig_sym() {
+    using Matrix = dr::Matrix<Float, Size>;
+    size_t n = 64;
+
+    Matrix A = test_symmetric<Float, Size>(n);
+    auto [lambda, V] = dr::eig_sym(A);
+    assert(max_error(A * V, V * dr::diag(lambda)) < 1e-5f);
+    assert(max_error(V * dr::transpose(V), dr::identity<Matrix>()) < 1e-5f);
+    for (size_t i = 0; i + 1 < Size; ++i)
+        assert(dr::all(lambda.entry(i) <= lambda.entry(i + 1)));
+
+    // Repeated eigenvalues
+    Matrix D = dr::diag(dr::Array<Float, Size>(2.f));
+    D(0, 0) = 1.f;
+    auto [lambda2, V2] = dr::eig_sym(D);
+    assert(max_error(V2 * dr::diag(lambda2) * dr::transpose(V2), D) < 1e-6f);
+}
+
+DRJIT_TEST(test05_eig_sym) {
+    test_eig_sym<2>();
+    test_eig_sym<3>();
+}
+
+template <size_t Size> void test_svd() {
+    using Matrix = dr::Matrix<Float, Size>;
+    size_t n = 64;
+
+    Matrix A = test_matrix<Size>(n);
+    auto [U, S, V] = dr::svd(A);
+    assert(max_error(U * dr::diag(S) * dr::transpose(V), A) < 1e-5f);
+    assert(max_error(U * dr::transpose(U), dr::identity<Matrix>()) < 1e-5f);
+    assert(max_error(V * dr::transpose(V), dr::identity<Matrix>()) < 1e-5f);
+    for (size_t i = 0; i < Size; ++i)
+        assert(dr::all(S.entry(i) >= 0.f));
+    for (size_t i = 0; i + 1 < Size; ++i)
+        assert(dr::all(S.entry(i) >= S.entry(i + 1)));
+
+    // Rank deficient matrix: U must remain orthogonal
+    Matrix B = A;
+    B.entry(Size - 1) = B.entry(0) * 2.f;
+    std::tie(U, S, V) = dr::svd(B);
+    assert(max_error(U * dr::diag(S) * dr::transpose(V), B) < 1e-5f);
+    assert(max_error(U * dr::transpose(U), dr::identity<Matrix>()) < 1e-5f);
+
+    auto [Q, P] = dr::polar_decomp(A);
+    assert(max_error(Q * P, A) < 1e-5f);
+    assert(max_error(Q * dr::transpose(Q), dr::identity<Matrix>()) < 1e-5f);
+    assert(max_error(P, dr::transpose(P)) < 1e-5f);
+}
+
+DRJIT_TEST(test06_svd) {
+    test_svd<2>();
+    test_svd<3>();
+}
+
+template <typename T> double inner(const T &a, const T &b) {
+    return dr::sum_nested(a * b);
+}
+
+DRJIT_TEST(test07_decomp_derivatives) {
+    using Matrix3d = dr::Matrix<Double, 3>;
+    using Vector3d = dr::Array<Double, 3>;
+    using PlainMatrix = dr::plain_t<Matrix3d>;
+    size_t n = 16;
+    double h = 1e-6;
+
+    Matrix3d A = test_symmetric<Double, 3>(n),
+             dA = test_symmetric<Double, 3>(n) * 2.0 + dr::identity<Matrix3d>();
+
+    // Forward-mode derivatives match central differences
+    auto [lambda, V] = dr::eig_sym(A);
+    auto [d_lambda, dV] = dr::detail::eig_sym_fwd(lambda, V, dA);
+    auto [lambda_p, V_p] = dr::eig_sym(Matrix3d(A + dA * h));
+    auto [lambda_m, V_m] = dr::eig_sym(Matrix3d(A - dA * h));
+    assert(dr::max_nested(dr::abs((lambda_p - lambda_m) / (2 * h) - d_lambda)) < 1e-5);
+    assert(max_error(PlainMatrix(V_p - V_m) / (2 * h), PlainMatrix(dV)) < 1e-5);
+
+    Matrix3d B = test_matrix<3, Double>(n), dB = test_symmetric<Double, 3>(n);
+    auto [U, S, W] = dr::svd(B);
+    auto [dU, dS, dW] = dr::detail::svd_fwd(U, S, W, dB);
+    auto [U_p, S_p, W_p] = dr::svd(Matrix3d(B + dB * h));
+    auto [U_m, S_m, W_m] = dr::svd(Matrix3d(B - dB * h));
+    assert(dr::max_nested(dr::abs((S_p - S_m) / (2 * h) - dS)) < 1e-5);
+    assert(max_error(PlainMatrix(U_p - U_m) / (2 * h), PlainMatrix(dU)) < 1e-5);
+    assert(max_error(PlainMatrix(W_p - W_m) / (2 * h), PlainMatrix(dW)) < 1e-5);
+
+    // Backward-mode derivatives are the adjoints of the forward derivatives
+    Matrix3d gV = test_matrix<3, Double>(n), gU = Matrix3d(dr::transpose(gV));
+    Vector3d g_lambda(1.0, -2.0, .5);
+
+    Matrix3d gA = dr::detail::eig_sym_bwd(lambda, V, g_lambda, gV);
+    assert(dr::abs(inner(PlainMatrix(gA), PlainMatrix(dA)) -
+                   inner(g_lambda, d_lambda) -
+                   inner(PlainMatrix(gV), PlainMatrix(dV))) < 1e-8);
+
+    Matrix3d gB = dr::detail::svd_bwd(U, S, W, gU, g_lambda, gV);
+    assert(dr::abs(inner(PlainMatrix(gB), PlainMatrix(dB)) -
+                   inner(g_lambda, dS) - inner(PlainMatrix(gU), PlainMatrix(dU)) -
+                   inner(PlainMatrix(gV), PlainMatrix(dW))) < 1e-8);
+}
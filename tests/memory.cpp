@@ -12,6 +12,8 @@
 */
 
 #include "test.h"
+#include <drjit/dynamic.h>
+#include <vector>
 #if defined(_MSC_VER)
 #  include <windows.h>
 #endif
@@ -198,3 +200,218 @@ DRJIT_TEST_ALL(test09_scatter_mask) {
     for (size_t i = 0; i < Size; ++i)
         assert(dst[i] == (((Size-1-i) % 2 == 0) ? Value(Size - 1 - i) : 0));
 }
+
+DRJIT_TEST_ALL(test10_scatter_reduce_conflict) {
+    using UInt = uint_array_t<Value>;
+    Array<uint32_t, Size> id32;
+    Array<uint64_t, Size> id64;
+    Value ref_add[3] = { 0, 0, 0 }, ref_min[3] = { 100, 100, 100 },
+          ref_max[3] = { 0, 0, 0 }, ref_mul[3] = { 1, 1, 1 };
+    UInt ref_and[3] = { UInt(-1), UInt(-1), UInt(-1) }, ref_or[3] = { 0, 0, 0 };
+
+    /* Several lanes update the same address, lane 1 is masked. Products
+       only involve 1 and 2 so that they remain exact for all types */
+    for (size_t i = 0; i < Size; ++i) {
+        id32.entry(i) = uint32_t(i % 3);
+        id64.entry(i) = uint64_t(i % 3);
+        if (i == 1)
+            continue;
+        Value v = Value(i + 1);
+        ref_add[i % 3] += v;
+        ref_min[i % 3] = std::min(ref_min[i % 3], v);
+        ref_max[i % 3] = std::max(ref_max[i % 3], v);
+        ref_mul[i % 3] *= Value(1 + i % 2);
+        ref_and[i % 3] &= UInt(i + 1);
+        ref_or[i % 3] |= UInt(i + 1);
+    }
+
+    auto mask = mask_t<T>(neq(arange<uint_array_t<T>>(), 1u));
+    T value = arange<T>() + Value(1),
+      value_mul = T(1) + T(arange<uint_array_t<T>>() % 2u);
+
+    for (int k = 0; k < 2; ++k) {
+        Value dst_add[3] = { 0, 0, 0 }, dst_min[3] = { 100, 100, 100 },
+              dst_max[3] = { 0, 0, 0 }, dst_mul[3] = { 1, 1, 1 };
+        UInt dst_and[3] = { UInt(-1), UInt(-1), UInt(-1) }, dst_or[3] = { 0, 0, 0 };
+
+        auto run = [&](const auto &id) {
+            scatter_reduce(ReduceOp::Add, dst_add, value, id, mask);
+            scatter_reduce(ReduceOp::Min, dst_min, value, id, mask);
+            scatter_reduce(ReduceOp::Max, dst_max, value, id, mask);
+            scatter_reduce(ReduceOp::Mul, dst_mul, value_mul, id, mask);
+            if constexpr (std::is_integral_v<Value>) {
+                scatter_reduce(ReduceOp::And, dst_and, value, id, mask);
+                scatter_reduce(ReduceOp::Or, dst_or, value, id, mask);
+            }
+        };
+
+        if (k == 0)
+            run(id32);
+        else
+            run(id64);
+
+        for (size_t i = 0; i < 3; ++i) {
+            assert(dst_add[i] == ref_add[i]);
+            assert(dst_min[i] == ref_min[i]);
+            assert(dst_max[i] == ref_max[i]);
+            assert(dst_mul[i] == ref_mul[i]);
+            if constexpr (std::is_integral_v<Value>) {
+                assert(dst_and[i] == ref_and[i]);
+                assert(dst_or[i] == ref_or[i]);
+            }
+        }
+    }
+}
+
+DRJIT_TEST_ALL(test11_load_store_aos) {
+    auto run = [](auto n) {
+        constexpr size_t N = decltype(n)::value;
+        using Nested = Array<T, N>;
+        Value buf[Size * N], out[Size * N];
+        for (size_t i = 0; i < Size * N; ++i)
+            buf[i] = Value(i);
+
+        Nested v = load_aos<Nested>(buf);
+        for (size_t i = 0; i < Size; ++i)
+            for (size_t j = 0; j < N; ++j)
+                assert(v.entry(j).entry(i) == buf[i * N + j]);
+
+        store_aos(out, v);
+        for (size_t i = 0; i < Size * N; ++i)
+            assert(out[i] == buf[i]);
+    };
+
+    run(std::integral_constant<size_t, 2>());
+    run(std::integral_constant<size_t, 3>());
+    run(std::integral_constant<size_t, 4>());
+}
+
+DRJIT_TEST_ALL(test12_compress_expand) {
+    for (uint32_t bits = 0; bits < (1u << std::min(Size, (size_t) 10)); bits += 3) {
+        using UInt = uint_array_t<Value>;
+        Value mem[Size + 1], ref[Size + 1];
+        uint_array_t<T> mask_int;
+        size_t ref_count = 0;
+
+        for (size_t i = 0; i < Size; ++i) {
+            mask_int.entry(i) = (bits >> (i % 10)) & 1;
+            if (mask_int.entry(i))
+                ref[ref_count++] = Value(i + 1);
+        }
+
+        auto mask = mask_t<T>(neq(mask_int, UInt(0)));
+
+        /* Compress: only the selected entries are written */
+        for (size_t i = 0; i <= Size; ++i)
+            mem[i] = Value(100);
+        T value = arange<T>() + Value(1);
+        size_t count = compress_store(mem, value, mask);
+        assert(count == ref_count);
+        for (size_t i = 0; i < count; ++i)
+            assert(mem[i] == ref[i]);
+        for (size_t i = count; i <= Size; ++i)
+            assert(mem[i] == Value(100));
+
+        /* Expand: the inverse operation, remaining lanes are zero */
+        T result = expand_load<T>(mem, mask);
+        assert(all(eq(result, select(mask, value, T(0)))));
+    }
+}
+
+DRJIT_TEST(test13_compress_dynamic) {
+    using Mask = DynamicArray<bool>;
+    for (size_t size : { 0, 1, 7, 16, 33, 100 }) {
+        Mask mask = empty<Mask>(size);
+        std::vector<uint32_t> ref;
+        for (size_t i = 0; i < size; ++i) {
+            mask.entry(i) = (i * 7) % 3 != 1;
+            if (mask.entry(i))
+                ref.push_back((uint32_t) i);
+        }
+
+        DynamicArray<uint32_t> result = compress(mask);
+        assert(result.size() == ref.size());
+        for (size_t i = 0; i < ref.size(); ++i)
+            assert(result.entry(i) == ref[i]);
+    }
+}
+
+DRJIT_TEST(test14_dynamic_small_buffer) {
+    using FloatX = DynamicArray<float>;
+    static_assert(FloatX::InlineSize == 16);
+
+    FloatX small = arange<FloatX>(5), large = arange<FloatX>(100);
+    assert(small.data() != nullptr && ((uintptr_t) large.data() % 64) == 0);
+
+    // Copies and moves of inline arrays
+    FloatX a(small), b(large), c;
+    assert(a.data() != small.data() && a == small && b == large);
+    c = std::move(a);
+    assert(a.size() == 0 && c == small);
+    c = large;
+    assert(c == large && c.data() != large.data());
+    c = small;
+    assert(c == small);
+    b = std::move(c);
+    assert(b == small && c.size() == 0);
+    b = std::move(large);
+    assert(b.size() == 100 && b[99] == 99.f);
+    b = b;
+    assert(b.size() == 100);
+
+    // Arithmetic on inline temporaries
+    FloatX d = small * 2.f + small;
+    assert(d == FloatX(0.f, 3.f, 6.f, 9.f, 12.f));
+}
+
+DRJIT_TEST(test15_dynamic_parallel) {
+    using FloatP = Packet<float>;
+    using FloatX = DynamicArray<FloatP>;
+    size_t n = (FloatX::ParallelThreshold / sizeof(FloatP)) * 4 + 3;
+    static_assert(FloatX::IsParallel && DynamicArray<uint32_t>::IsParallel &&
+                  !DynamicArray<DynamicArray<float>>::IsParallel);
+
+    FloatX x = empty<FloatX>(n);
+    for (size_t i = 0; i < n; ++i)
+        x.entry(i) = arange<FloatP>() + float(i * FloatP::Size);
+
+    uint32_t thread_count = dynamic_thread_count();
+    set_dynamic_thread_count(1);
+    FloatX ref = fmadd(x, x, sqrt(x)) - x * .5f;
+
+    set_dynamic_thread_count(4);
+    assert(dynamic_thread_count() == 4);
+    for (int k = 0; k < 3; ++k) {
+        FloatX y = fmadd(x, x, sqrt(x)) - x * .5f;
+        for (size_t i = 0; i < n; ++i)
+            assert(all(eq(y.entry(i), ref.entry(i))));
+    }
+
+    set_dynamic_thread_count(thread_count);
+}
+
+DRJIT_TEST(test16_dynamic_half) {
+    using FloatX = DynamicArray<float>;
+    using HalfX = DynamicArray<half>;
+
+    // Normal, subnormal, infinite and out-of-range values
+    std::vector<float> in;
+    for (int i = 0; i < 43; ++i)
+        in.push_back(std::ldexp(float(i) - 20.5f, i - 30));
+    in.push_back(std::numeric_limits<float>::infinity());
+    in.push_back(-1e6f);
+
+    // Every size exercises a different split between vector and scalar loop
+    for (size_t size = 0; size <= in.size(); ++size) {
+        HalfX h(load<FloatX>(in.data(), size));
+        FloatX f(h);
+        assert(h.size() == size && f.size() == size);
+
+        for (size_t i = 0; i < size; ++i) {
+            half ref = half(in[i]);
+            assert(h.entry(i).value == ref.value);
+            assert(memcpy_cast<uint32_t>(f.entry(i)) ==
+                   memcpy_cast<uint32_t>(float(ref)));
+        }
+    }
+}
@@ -101,3 +101,52 @@ DRJIT_TEST(test08_morton_u64_3d_array) {
 
     assert(value == value3);
 }
+
+DRJIT_TEST(test09_morton_u32_4d_array) {
+    using T = drjit::Array<uint32_t>;
+    using T2 = drjit::Array<T, 4>;
+
+    T2 value = T2(123u, 45u, 67u, 89u);
+    T value2 = morton_encode(value);
+    T2 value3 = morton_decode<T2>(value2);
+
+    assert(value == value3);
+}
+
+DRJIT_TEST(test10_morton_u64_4d_array) {
+    using T = drjit::Array<uint64_t>;
+    using T2 = drjit::Array<T, 4>;
+
+    T2 value = T2(12345u, 6789u, 1011u, 1213u);
+    T value2 = morton_encode(value);
+    T2 value3 = morton_decode<T2>(value2);
+
+    assert(value == value3);
+}
+
+template <size_t Dimension, typename T> void test_morton_vs_scalar() {
+    using Scalar = drjit::scalar_t<T>;
+    Scalar seed = (Scalar) 0x9e3779b97f4a7c15ull;
+
+    for (size_t i = 0; i < 1000; ++i) {
+        T value = drjit::arange<T>() * seed + (Scalar) i * (Scalar) 0x2545f4914f6cdd1dull;
+        T spread = drjit::detail::scatter_bits<Dimension>(value),
+          packed = drjit::detail::gather_bits<Dimension>(value);
+
+        for (size_t j = 0; j < T::Size; ++j) {
+            assert(spread.entry(j) ==
+                   drjit::detail::scatter_bits<Dimension>(value.entry(j)));
+            assert(packed.entry(j) ==
+                   drjit::detail::gather_bits<Dimension>(value.entry(j)));
+        }
+    }
+}
+
+DRJIT_TEST(test11_morton_packet_vs_scalar) {
+    test_morton_vs_scalar<2, drjit::Array<uint32_t>>();
+    test_morton_vs_scalar<3, drjit::Array<uint32_t>>();
+    test_morton_vs_scalar<4, drjit::Array<uint32_t>>();
+    test_morton_vs_scalar<2, drjit::Array<uint64_t>>();
+    test_morton_vs_scalar<3, drjit::Array<uint64_t>>();
+    test_morton_vs_scalar<4, drjit::Array<uint64_t>>();
+}
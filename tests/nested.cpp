@@ -99,3 +99,28 @@ DRJIT_TEST(test06_nested_reductions) {
     assert(my_any_nested(data));
     assert(my_count_nested(data) == 36);
 }
+
+DRJIT_TEST(test07_split_apply) {
+    using FloatP = Packet<float, 32>;
+    using Vector3fP = Array<FloatP, 3>;
+
+    auto kernel = [](const auto &v, float s) {
+        return v * s + v.x();
+    };
+
+    Vector3fP v(arange<FloatP>(), arange<FloatP>() * 2.f, arange<FloatP>() + 1.f);
+    Vector3fP ref = kernel(v, 2.f);
+
+    Vector3fP r1 = split_apply<8>(kernel, v, 2.f),
+              r2 = split_apply<16>(kernel, v, 2.f),
+              r3 = split_apply<32>(kernel, v, 2.f);
+
+    assert(all_nested(eq(r1, ref)));
+    assert(all_nested(eq(r2, ref)));
+    assert(all_nested(eq(r3, ref)));
+
+    /* Kernels without a return value, and flat arguments */
+    float sum = 0.f;
+    split_apply<4>([&](const auto &x) { sum += drjit::sum(x); }, v.y());
+    assert(sum == drjit::sum(v.y()));
+}
@@ -1942,3 +1942,276 @@ def test80_backward_from_complex(m):
     b = 2 * a
     dr.backward_from(b)
     assert dr.allclose(dr.grad(a), m.Complex2f(0, 2))
+
+
+def test81_backward_parallel(m):
+    # Parallel traversal must reproduce the sequential gradients exactly
+    def compute(flags):
+        x = [m.Float(0.1 * (i + 1), 0.2 * (i + 1)) for i in range(32)]
+        dr.enable_grad(x)
+        y = m.Float(0)
+        for k in range(4):
+            for i in range(32):
+                a = dr.sin(x[i] * (k + 1)) * x[(i * 7) % 32]
+                y += a * a + dr.exp(a)
+        dr.backward(y, flags)
+        return [dr.grad(v) for v in x]
+
+    g1 = compute(dr.ADFlag.Default)
+    g2 = compute(dr.ADFlag.Default | dr.ADFlag.Parallel)
+    for a, b in zip(g1, g2):
+        assert dr.all(a == b)
+
+
+def test82_checkpoint(m):
+    # Recomputing the checkpointed subgraph must reproduce the gradients
+    def func(x, y):
+        return dr.sin(x * y) * dr.exp(x)
+
+    for mode in [dr.ADMode.Forward, dr.ADMode.Backward]:
+        x1, y1 = m.Float(1, 2, 3), m.Float(4, 3, 2)
+        x2, y2 = m.Float(1, 2, 3), m.Float(4, 3, 2)
+        dr.enable_grad(x1, y1, x2, y2)
+        z1 = dr.checkpoint(func, x1, y1) * 2
+        z2 = func(x2, y2) * 2
+        assert dr.allclose(z1, z2)
+
+        if mode == dr.ADMode.Backward:
+            dr.backward(z1)
+            dr.backward(z2)
+            assert dr.allclose(dr.grad(x1), dr.grad(x2))
+            assert dr.allclose(dr.grad(y1), dr.grad(y2))
+        else:
+            dr.set_grad(x1, 1)
+            dr.set_grad(x2, 1)
+            dr.forward_to(z1)
+            dr.forward_to(z2)
+            assert dr.allclose(dr.grad(z1), dr.grad(z2))
+
+
+def test83_backward_batch(m):
+    # One VJP per cotangent, computed without re-recording the graph
+    x = m.Array3f(1, 2, 3)
+    dr.enable_grad(x)
+    y = m.Array3f(x.x * x.y, dr.sin(x.z), x.x + x.z)
+    grads = [m.Array3f(1, 0, 0), m.Array3f(0, 1, 0), m.Array3f(0, 0, 1)]
+    rows = dr.backward_batch(y, grads, x)
+
+    assert dr.allclose(rows[0], m.Array3f(2, 1, 0))
+    assert dr.allclose(rows[1], m.Array3f(0, 0, dr.cos(3)))
+    assert dr.allclose(rows[2], m.Array3f(1, 0, 1))
+    assert dr.all(dr.grad(x) == 0)
+
+
+def test84_backward_replay(m):
+    # Repeated traversals of a retained graph reuse the edge schedule
+    x = m.Float(1, 2, 3)
+    dr.enable_grad(x)
+    y = dr.sum(dr.sin(x) * x + dr.exp(-x))
+    ref = dr.sin(x) + x * dr.cos(x) - dr.exp(-x)
+
+    for i in range(4):
+        last = i == 3
+        dr.set_grad(y, i + 1)
+        dr.enqueue(dr.ADMode.Backward, y)
+        dr.traverse(m.Float, dr.ADMode.Backward,
+                    dr.ADFlag.Default if last else dr.ADFlag.ClearVertices)
+        assert dr.allclose(dr.grad(x), ref * (i + 1))
+        dr.set_grad(x, 0)
+
+
+def test85_ad_stats(m):
+    dr.ad_stats_clear()
+    x = m.Float(1, 2, 3)
+    dr.enable_grad(x)
+    with dr.Scope("stats_test"):
+        y = dr.sin(x) * x
+    z = y + 1
+
+    s = dr.ad_stats()
+    assert s['labels']['stats_test']['variables'] >= 1
+    assert s['labels']['stats_test']['edges'] >= 2
+    assert s['edges'] >= 3 and s['edges_peak'] >= s['edges']
+
+    dr.backward(z)
+    s = dr.ad_stats()
+    assert s['traversals'] >= 1
+    for k in ['time_dfs', 'time_sort', 'time_traverse',
+              'time_special', 'time_cleanup']:
+        assert s[k] >= 0 and 0 <= s['last'][k] <= s[k]
+    assert s['last']['edges'] >= 2
+
+
+def test86_grad_sparse(m):
+    x = dr.arange(m.Float, 1000)
+    dr.enable_grad(x)
+    dr.set_grad_sparse(x)
+
+    idx = m.UInt32(3, 7, 3, 900)
+    y = dr.gather(m.Float, x, idx, m.Bool(True, True, True, False))
+    dr.backward(y * m.Float(1, 2, 3, 4))
+
+    rows, values = dr.grad_sparse(x)
+    dense = dr.zeros(m.Float, 1000)
+    dr.scatter_reduce(dr.ReduceOp.Add, dense, values, rows)
+    assert dense[3] == 4 and dense[7] == 2 and dense[900] == 0
+    assert dr.allclose(dr.grad(x), dense)
+    assert dr.count(dr.neq(dr.grad(x), 0)) == 2
+
+
+def test87_compensated_gather_grad(m):
+    # Many small contributions to the same entry of a large gradient
+    x = m.Float(0, 0)
+    dr.enable_grad(x)
+    n = 1000000
+    y = dr.gather(m.Float, x, dr.zeros(m.UInt32, n))
+    dr.set_grad(y, dr.full(m.Float, 1e-4, n))
+    dr.enqueue(dr.ADMode.Backward, y)
+    dr.traverse(m.Float, dr.ADMode.Backward,
+                dr.ADFlag.Default | dr.ADFlag.Compensated)
+    assert dr.allclose(dr.grad(x), [100, 0], rtol=1e-6)
+
+
+def test88_high_fan_in(m):
+    # Gradients from many edges into one variable are summed as a tree
+    x = m.Float(1, 2, 3)
+    dr.enable_grad(x)
+    y = 0
+    for i in range(200):
+        y = y + x * (i + 1) if i % 2 == 0 else y - dr.sqr(x)
+    dr.backward(y)
+    assert dr.allclose(dr.grad(x), 100 * 100 - 200 * x)
+
+
+def test89_prune_frozen(m):
+    # Edges leading only to frozen parameters are skipped during traversal
+    a, b = m.Float(1, 2), m.Float(3, 4)
+    dr.enable_grad(a, b)
+    c = dr.sqr(a) * dr.exp(b)
+    d = dr.sin(b) + c
+    dr.disable_grad(b)
+    dr.backward(d)
+    assert dr.allclose(dr.grad(a), 2 * a * dr.exp(b))
+    assert dr.grad(b) == 0
+
+
+def test90_hvp(m):
+    # Hessian-vector products via forward-over-reverse traversal
+    x, y = m.Float(0.5, 1.0), m.Float(1.5, 2.0)
+    dr.enable_grad(x, y)
+    dr.set_record_hessian(m.Float, True)
+    f = dr.sin(x * y) + dr.sqr(x) / y
+    dr.set_record_hessian(m.Float, False)
+
+    vx, vy = m.Float(1, 2), m.Float(-1, 3)
+    hx, hy = dr.hvp(f, [x, y], [vx, vy], dr.ADFlag.ClearVertices)
+
+    s, c = dr.sincos(x * y)
+    fxx = -dr.sqr(y) * s + 2 / y
+    fxy = c - x * y * s - 2 * x / dr.sqr(y)
+    fyy = -dr.sqr(x) * s + 2 * dr.sqr(x) / (y * dr.sqr(y))
+    assert dr.allclose(hx, fxx * vx + fxy * vy)
+    assert dr.allclose(hy, fxy * vx + fyy * vy)
+
+    # The graph was retained, hence the product can be computed once more
+    hx2, hy2 = dr.hvp(f, [x, y], [vx, vy])
+    assert dr.allclose(hx, hx2) and dr.allclose(hy, hy2)
+
+    # Operations without second-order terms are rejected
+    dr.set_record_hessian(m.Float, True)
+    g = dr.prod(x * y)
+    d = dr.custom(Normalize, m.Array3f(x, y, 1))
+    dr.set_record_hessian(m.Float, False)
+
+    with pytest.raises(Exception, match='second-order terms'):
+        dr.hvp(g, [x, y], [vx, vy])
+    with pytest.raises(Exception, match='custom derivative callbacks'):
+        dr.hvp(d.x, [x, y], [vx, vy])
+    assert dr.all(dr.eq(dr.grad(x), 0)) and dr.all(dr.eq(dr.grad(y), 0))
+
+
+def test91_isolated_graph(m):
+    # Threads that differentiate independent computations in private graphs
+    import threading
+    y = m.Float(2)
+    dr.enable_grad(y)
+    results, errors = [None] * 4, []
+
+    def worker(i):
+        try:
+            with dr.isolated_graph(m.Float):
+                x = m.Float(i, i + 1)
+                dr.enable_grad(x)
+                dr.backward(dr.sqr(x) * 3)
+                results[i] = dr.grad(x)
+
+                # Variables of the global graph cannot be used here
+                with pytest.raises(Exception, match='different AD graph'):
+                    x * y
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=worker, args=(i,)) for i in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    assert not errors
+    for i in range(4):
+        assert dr.allclose(results[i], [6 * i, 6 * (i + 1)])
+
+
+def test91b_isolated_graph_lifetime(m):
+    # Variables may outlive the thread that owns their private graph
+    import threading
+    kept = []
+
+    def worker():
+        with dr.isolated_graph(m.Float):
+            x = m.Float(1, 2)
+            dr.enable_grad(x)
+            kept.append((x, x * 2))
+
+    for i in range(3):
+        t = threading.Thread(target=worker)
+        t.start()
+        t.join()
+
+        x, y = kept[-1]
+        assert dr.grad_enabled(y)
+        dr.backward(y)
+        assert dr.allclose(dr.grad(x), [2, 2])
+
+    # Releasing the last variables also releases the orphaned graphs
+    kept.clear()
+    t = threading.Thread(target=worker)
+    t.start()
+    t.join()
+    x, y = kept.pop()
+    assert dr.grad_enabled(y)
+
+
+def test92_backward_async(m):
+    # Asynchronous traversal of a graph spanning several evaluation intervals
+    def f(x):
+        y = x
+        for i in range(1500):
+            y = dr.fmadd(y, 0.999, dr.sin(y) * 1e-3)
+        return y
+
+    x = dr.linspace(m.Float, 0, 1, 16)
+    dr.enable_grad(x)
+    dr.backward(f(x))
+    ref = dr.grad(x)
+
+    x2 = dr.linspace(m.Float, 0, 1, 16)
+    dr.enable_grad(x2)
+    y2 = f(x2)
+    evals = dr.ad_stats()['async_evals']
+    future = dr.backward_async(y2)
+    future.wait()
+    assert dr.allclose(dr.grad(x2), ref)
+
+    # The traversal spans two intervals of 1024 edges plus the final evaluation
+    assert dr.ad_stats()['async_evals'] - evals >= 2
@@ -735,4 +735,23 @@ def test25_select_with_only_mask(pkg):
 
     res = dr.select(a, b, c)
 
-    assert dr.all(dr.eq(res, pkg.Bool([0, 1, 1, 0])))
\ No newline at end of file
+    assert dr.all(dr.eq(res, pkg.Bool([0, 1, 1, 0])))
+
+@pytest.mark.parametrize("pkg", ['drjit.cuda', 'drjit.llvm'])
+def test26_philox4x32(pkg):
+    pkg = get_class(pkg)
+    UInt32 = pkg.UInt32
+
+    # Known-answer vector of the Random123 reference implementation
+    r = pkg.Philox4x32.block(pkg.Array4u(0), UInt32(0), UInt32(0))
+    assert r == pkg.Array4u(0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8)
+
+    rng = pkg.Philox4x32(dr.arange(UInt32, 100), UInt32(3), 1234)
+    v0 = rng.next_float32()
+    v1 = rng.next_uint32_bounded(10)
+    assert dr.width(v0) == 100 and dr.all(v1 < 10)
+    assert rng.dimension == dr.full(UInt32, 2, 100)
+
+    # Random access: regenerate dimension 0 of lane 42 directly
+    rng2 = pkg.Philox4x32(UInt32(42), UInt32(3), 1234)
+    assert rng2.next_float32()[0] == v0[42]
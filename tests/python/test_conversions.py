@@ -67,6 +67,29 @@ def test_roundtrip_pytorch_cuda():
     assert a1.x == Float(a1.x.torch())
 
 
+def test_dlpack_stream_pytorch_cuda():
+    torch = pytest.importorskip("torch")
+    prepare("drjit.cuda")
+    from drjit.cuda import Float
+
+    assert Float().__dlpack_device__()[0] == 2
+
+    # Consumer on a side stream: must observe the result without a host sync
+    with torch.cuda.stream(torch.cuda.Stream()):
+        a = dr.arange(Float, 1000000) * 2
+        b = torch.from_dlpack(a)
+        assert b[-1].item() == 1999998
+
+    # Import: Dr.Jit's stream waits for pending PyTorch work
+    c = torch.arange(1000000, device='cuda', dtype=torch.float32) + 1
+    d = Float(c)
+    assert d[-1] == 1000000
+
+    a.__dlpack__(stream=-1)
+    with pytest.raises(Exception):
+        a.__dlpack__(stream=0)
+
+
 def test_roundtrip_pytorch_llvm():
     pytest.importorskip("torch")
     prepare("drjit.llvm.ad")
@@ -82,6 +105,21 @@ def test_roundtrip_pytorch_llvm():
     assert a1.x == Float(a1.x.torch())
 
 
+@pytest.mark.parametrize("package", ["drjit.cuda", "drjit.llvm"])
+def test_strided_pytorch_tensor(package):
+    torch = pytest.importorskip("torch")
+    package = prepare(package)
+    TensorXf = package.TensorXf
+    device = 'cuda' if TensorXf.IsCUDA else 'cpu'
+
+    a = torch.arange(24, dtype=torch.float32, device=device).reshape(2, 3, 4)
+    for b in (a.transpose(0, 2), a[:, 1:, ::2], a[1], a[:, :, 3:]):
+        c = TensorXf(b)
+        assert c.shape == tuple(b.shape)
+        assert dr.all(c.array ==
+                      package.Float(b.contiguous().flatten().tolist()))
+
+
 def test_roundtrip_jax():
     pytest.importorskip("jax")
 
@@ -159,3 +197,52 @@ def test_torch_matrix_unit_dimension():
     b = dr.cuda.ad.Matrix4f(a)
 
     assert dr.allclose(b, expected)
+
+
+@pytest.mark.parametrize("package", ["drjit.scalar", "drjit.llvm"])
+def test_buffer_protocol(package):
+    import array
+    package = prepare(package)
+    if package is dr.scalar:
+        Float, UInt = package.ArrayXf, package.ArrayXu
+    else:
+        Float, UInt = package.Float, package.UInt
+
+    a = Float(array.array('f', [1, 2, 3, 4]))
+    assert len(a) == 4 and a[3] == 4
+    b = UInt(memoryview(array.array('I', [5, 6])))
+    assert len(b) == 2 and b[1] == 6
+
+    # Mismatched element types use the element-wise conversion
+    c = Float(array.array('d', [1.5, 2.5]))
+    assert len(c) == 2 and c[1] == 2.5
+
+
+    if not a.IsJIT:
+        # Zero-copy view of the array memory
+        m = memoryview(a)
+        assert m.format == 'f' and m.shape == (4,) and m.tolist() == [1, 2, 3, 4]
+        m[0] = 10
+        assert a[0] == 10
+
+        t = dr.scalar.TensorXf(dr.arange(Float, 6), shape=(2, 3))
+        m = memoryview(t)
+        assert m.shape == (2, 3) and m.tolist() == [[0, 1, 2], [3, 4, 5]]
+
+
+@pytest.mark.parametrize("package", ["drjit.scalar", "drjit.llvm"])
+def test_buffer_protocol_half(package):
+    np = pytest.importorskip("numpy")
+    package = prepare(package)
+    Float = package.ArrayXf if package is dr.scalar else package.Float
+
+    # Half precision arrays are converted in bulk (with a scalar remainder)
+    values = np.concatenate([np.linspace(-3, 3, 37), [65504, 2**-24, np.inf]])
+    h = values.astype(np.float16)
+    a = Float(h)
+    assert len(a) == len(values)
+    assert dr.all(dr.eq(a, Float(h.astype(np.float32))))
+
+    # Non-contiguous input takes the regular NumPy path
+    b = Float(h[::2])
+    assert dr.all(dr.eq(b, Float(h[::2].astype(np.float32))))
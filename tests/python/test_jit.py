@@ -39,8 +39,193 @@ def test01_kernel_history(m):
     assert len(dr.kernel_history()) == 0
 
 
+def test01b_kernel_history_scope(m):
+    with dr.scoped_set_flag(dr.JitFlag.KernelHistory, True):
+        dr.eval(dr.arange(m.Float, 5))
+        with dr.Scope("outer"):
+            dr.eval(dr.arange(m.Float, 6))
+            with dr.Scope("inner"):
+                dr.eval(dr.arange(m.Float, 7))
+        history = dr.kernel_history()
+
+    assert [h['scope'] for h in history] == ['', 'outer', 'outer/inner']
+    assert [h['size'] for h in history] == [5, 6, 7]
+
+    for h in history:
+        if h['backend'] == dr.JitBackend.LLVM:
+            w = h['vector_width']
+            assert h['vector_utilization'] == h['size'] / (w * ((h['size'] + w - 1) // w))
+
+    assert len(dr.kernel_history()) == 0
+
+
+
+def test01c_trace(m, tmp_path):
+    import json
+    if not hasattr(dr, 'trace_enable'):
+        pytest.skip('Tracing requires the AD backend')
+
+    dr.trace_clear()
+    dr.trace_enable()
+    with dr.Scope("traced"):
+        x = m.Float(1, 2, 3)
+        dr.enable_grad(x)
+        y = dr.sum(x * x)
+        dr.eval(y)
+        dr.backward(y)
+    dr.trace_disable()
+    count = len(json.loads(dr.trace_export())['traceEvents'])
+
+    # Events are no longer recorded
+    dr.eval(dr.arange(m.Float, 10))
+
+    dr.trace_save(tmp_path / 'trace.json')
+    events = json.loads((tmp_path / 'trace.json').read_text())['traceEvents']
+    names = [e['name'] for e in events]
+    assert len(events) == count
+    assert 'traced' in names and 'eval' in names
+    assert any(n.startswith('ad_traverse') for n in names)
+    assert all(e['ph'] == 'X' and e['dur'] >= 0 for e in events)
+    dr.trace_clear()
+
+
+def test01d_malloc_stats(m):
+    x = dr.arange(m.Float, 1024 * 1024)
+    dr.eval(x)
+    stats = dr.malloc_stats()
+    for name, entry in stats.items():
+        assert set(entry.keys()) == {'used', 'allocated', 'cached', 'peak'}
+        assert entry['used'] <= entry['allocated']
+        assert entry['cached'] == entry['allocated'] - entry['used']
+
+    # The exact byte counts are reported when drjit-core exports them
+    if not hasattr(dr.detail, 'malloc_stats'):
+        return
+    assert set(stats.keys()) == {'host', 'host-async', 'host-pinned', 'device'}
+    entry = stats['device' if dr.is_cuda_v(m.Float) else 'host-async']
+    assert entry['used'] >= 4 * 1024 * 1024 and entry['peak'] >= entry['used']
+
+
+def test01e_malloc_flush_threshold(m):
+    assert dr.malloc_flush_threshold() is None
+    with pytest.raises(Exception):
+        dr.set_malloc_flush_threshold(-1)
+
+    try:
+        dr.set_malloc_flush_threshold(0, interval=0)
+        assert dr.malloc_flush_threshold() == 0
+        x = dr.arange(m.Float, 1024 * 1024)
+        dr.eval(x)
+        del x
+        dr.eval(dr.arange(m.Float, 10))
+    finally:
+        dr.set_malloc_flush_threshold(None)
+    assert dr.malloc_flush_threshold() is None
+
+
+def test01f_migrate_device():
+    if not dr.has_backend(dr.JitBackend.CUDA):
+        pytest.skip('CUDA mode is unsupported')
+    import drjit.cuda as c
+    count = dr.device_count()
+    if count < 2:
+        pytest.skip('Requires at least two CUDA devices')
+
+    prev = dr.device()
+    dr.set_device(0)
+    x = c.Array3f(1, 2, 3)
+    y = dr.migrate_device(x, 1)
+    assert dr.device() == 0
+    assert dr.all(y.numpy() == x.numpy(), axis=None)
+
+    dr.set_device(1)
+    b = c.Float(10, 20)
+    dr.eval(b)
+    dr.set_device(0)
+    a = c.Float(1, 2)
+    dr.eval(a)
+    result = dr.all_reduce([a, b], [0, 1])
+    for r in result:
+        assert r.numpy().tolist() == [11, 22]
+    dr.set_device(prev)
+
 
 # TODO:
 # - Check number of kernel launched when scheduling variables to make sure it create a single kernel
 # - Check that number of output only contains the ones required (optimization)
 # - ...
+
+
+def test02_arithmetic_fast_path(m):
+    a, b = m.Float(1, 2, 3), m.Float(4, 5, 6)
+    assert dr.all((a + b) == m.Float(5, 7, 9))
+    assert dr.all((b - a) == 3)
+    assert dr.all((a * b) == m.Float(4, 10, 18))
+    assert dr.all((b / a) == m.Float(4, 2.5, 2))
+    assert dr.all((m.UInt(7, 8) // m.UInt(2, 3)) == m.UInt(3, 2))
+
+    # In-place operators must update the same object
+    c = a
+    c += b
+    assert c is a and dr.all(a == m.Float(5, 7, 9))
+    c *= b
+    assert c is a and dr.all(a == m.Float(20, 35, 54))
+
+    # Mixed types and errors still go through the regular code path
+    assert type(m.Float(1) + m.Int(2)) is m.Float
+    assert dr.all((m.Float(1, 2) + 1) == m.Float(2, 3))
+    with pytest.raises(TypeError):
+        m.Int(1) / m.Int(2)
+    with pytest.raises(RuntimeError):
+        dr.eval(m.Float(1, 2) + m.Float(1, 2, 3))
+
+    # Derivatives propagate through the fast path
+    x = m.Float(2, 3)
+    dr.enable_grad(x)
+    y = x * x + x
+    dr.backward(y)
+    assert dr.all(dr.grad(x) == m.Float(5, 7))
+
+
+def test03_kernel_cache(m, tmp_path):
+    def workload(x):
+        return dr.sin(x) * 4.25 + dr.cos(x * 0.125)
+
+    result, kernels = dr.warm_up(workload, dr.arange(m.Float, 16))
+    assert len(result) == 16
+    assert len(kernels) > 0 and all('hash' in k for k in kernels)
+
+    # Kernels are persisted and can be shared through another directory
+    hashes = [k['hash'] for k in kernels]
+    cached = {k['hash'] for k in dr.kernel_cache()}
+    assert all(h in cached for h in hashes)
+
+    assert dr.kernel_cache_export(tmp_path, hashes) == len(set(hashes))
+    assert {k['hash'] for k in dr.kernel_cache(tmp_path)} == set(hashes)
+    assert dr.kernel_cache_export(tmp_path, hashes) == 0
+    assert dr.kernel_cache_import(tmp_path) == 0
+
+
+def test03b_kernel_cache_dir(monkeypatch, tmp_path):
+    # The directory follows the environment variables used by drjit-core
+    import sys
+    var = 'LOCALAPPDATA' if sys.platform == 'win32' else 'HOME'
+    monkeypatch.setenv(var, str(tmp_path))
+    assert dr.kernel_cache_dir().startswith(str(tmp_path))
+
+
+def test04_reinterpret_alias(m):
+    x = dr.arange(m.Float, 10) + 1
+    dr.eval(x)
+
+    # Evaluated arrays are reinterpreted without a copy
+    y = dr.reinterpret_array_v(m.UInt, x)
+    assert y.data_() == x.data_()
+    assert dr.all(dr.reinterpret_array_v(m.Float, y + 0) == x)
+
+    # Writes never leak into the array sharing the storage
+    dr.scatter(y, m.UInt(0), m.UInt(0))
+    assert x[0] == 1 and y[0] == 0 and y[1] == 0x40000000
+    z = dr.reinterpret_array_v(m.UInt, x)
+    x[1] = 0
+    assert z[1] == 0x40000000
@@ -334,3 +334,122 @@ def test15_scalar_side_effect(pkg):
             active &= False
 
         assert target[0] == 123
+
+
+@pytest.mark.parametrize("unroll", [1, 2, 3, 4])
+@pytest.mark.parametrize("pkg", pkgs)
+def test16_unroll(pkg, unroll):
+    p = get_class(pkg)
+
+    for i in range(2):
+        dr.set_flag(dr.JitFlag.LoopOptimize, i == 1)
+
+        x = dr.arange(p.Int, 0, 10)
+        y = dr.zeros(p.Float, 1)
+        z = p.Float(1)
+        count = dr.zeros(p.UInt32, 10)
+
+        loop = p.Loop("MyLoop", lambda: (x, y, z))
+        loop.set_unroll(unroll)
+        while loop(x < 5):
+            # Lanes that terminated in an earlier copy of the body must be masked
+            dr.scatter_reduce(dr.ReduceOp.Add, count, 1, dr.arange(p.UInt32, 10))
+            y += p.Float(x)
+            x += 1
+            z = z + 1
+
+        assert z == p.Int(6, 5, 4, 3, 2, 1, 1, 1, 1, 1)
+        assert y == p.Int(10, 10, 9, 7, 4, 0, 0, 0, 0, 0)
+        assert x == p.Int(5, 5, 5, 5, 5, 5, 6, 7, 8, 9)
+        assert count == p.UInt32(5, 4, 3, 2, 1, 0, 0, 0, 0, 0)
+
+    dr.set_flag(dr.JitFlag.LoopOptimize, False)
+
+
+@pytest.mark.parametrize("stride", [1, 2])
+@pytest.mark.parametrize("pkg", pkgs)
+def test17_compaction(pkg, stride):
+    p = get_class(pkg)
+    dr.set_flag(dr.JitFlag.LoopRecord, False)
+
+    x = dr.arange(p.Int, 0, 10)
+    y = dr.zeros(p.Float, 1)
+    z = p.Float(1)
+    idx = dr.arange(p.UInt32, 10)
+    count = dr.zeros(p.UInt32, 10)
+
+    loop = p.Loop("MyLoop", lambda: (x, y, z, idx))
+    loop.set_compaction(1.0, stride)
+    while loop(x < 5):
+        dr.scatter_reduce(dr.ReduceOp.Add, count, 1, idx)
+        y += p.Float(x)
+        x += 1
+        z = z + 1
+
+    assert z == p.Int(6, 5, 4, 3, 2, 1, 1, 1, 1, 1)
+    assert y == p.Int(10, 10, 9, 7, 4, 0, 0, 0, 0, 0)
+    assert x == p.Int(5, 5, 5, 5, 5, 5, 6, 7, 8, 9)
+    assert idx == dr.arange(p.UInt32, 10)
+    assert count == p.UInt32(5, 4, 3, 2, 1, 0, 0, 0, 0, 0)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test18_invariant(pkg):
+    # Loops can opt into eliminating invariant variables without
+    # JitFlag.LoopOptimize, which records their body twice
+    p = get_class(pkg)
+    dr.set_flag(dr.JitFlag.LoopOptimize, False)
+
+    for optimize in [False, True]:
+        x = dr.arange(p.Int, 0, 10)
+        c = dr.full(p.Float, 3, 10)
+        y = dr.zeros(p.Float, 10)
+        traced = 0
+
+        loop = p.Loop("MyLoop", lambda: (x, c, y))
+        loop.set_optimize(optimize)
+        while loop(x < 5):
+            traced += 1
+            y += c
+            x += 1
+
+        assert traced == (2 if optimize else 1)
+
+    assert x == p.Int(5, 5, 5, 5, 5, 5, 6, 7, 8, 9)
+    assert y == p.Float(15, 12, 9, 6, 3, 0, 0, 0, 0, 0)
+    assert c == dr.full(p.Float, 3, 10)
+    assert not dr.flag(dr.JitFlag.LoopOptimize)
+
+
+@pytest.mark.parametrize("pkg", ["drjit.cuda", "drjit.llvm"])
+def test19_lbvh_traversal(pkg):
+    p = get_class(pkg)
+
+    # Random boxes, including duplicated centroids
+    n = 1000
+    rng = p.PCG32(n)
+    lo = p.Array3f(rng.next_float32(), rng.next_float32(), rng.next_float32())
+    lo = dr.select(dr.arange(p.UInt32, n) % 7 == 0, 0.5, lo)
+    hi = lo + 0.05 * p.Array3f(rng.next_float32(), rng.next_float32(),
+                               rng.next_float32())
+    bvh = p.LBVH(lo, hi)
+    assert bvh.size == n
+    assert dr.allclose(bvh.bbox_min[0], dr.min(lo.x)) and \
+           dr.allclose(bvh.bbox_max[0], dr.max(hi.x))
+
+    # Count the boxes overlapping each query box
+    m = 64
+    q = p.Array3f(dr.linspace(p.Float, 0, 1, m), 0.4, 0.5)
+    count = dr.zeros(p.UInt32, m)
+    it = p.LBVHTraversal(bvh, dr.full(p.Bool, True, m))
+
+    loop = p.Loop("LBVH", lambda: (it, count))
+    while loop(it.active()):
+        prim, hit = it.next(lambda a, b: dr.all((a <= q + 0.1) & (b >= q)))
+        count[hit] += 1
+
+    ref = []
+    for i in range(m):
+        qi = p.Array3f(q.x[i], q.y[i], q.z[i])
+        ref.append(dr.count(dr.all((lo <= qi + 0.1) & (hi >= qi))))
+    assert count == p.UInt32(ref)
@@ -248,3 +248,19 @@ def test09_scatter_inc(m):
     out_np = np.array(out)
     out_np.sort()
     assert np.all(out_np == np.arange(n))
+
+def test10_sort(m):
+    for t in [m.Float, m.Int32, m.UInt32, m.Float64, m.Int64, m.UInt64]:
+        assert dr.sort(t(3, 1, 2, 1)) == t(1, 1, 2, 3)
+        # Stable: equal keys keep their order
+        assert dr.argsort(t(3, 1, 2, 1)) == m.UInt32(1, 3, 2, 0)
+
+    a = m.Float(-1.5, 2, -0.25, 0, 1e30, -1e30)
+    assert dr.sort(a) == m.Float(-1e30, -1.5, -0.25, 0, 2, 1e30)
+
+    n = 10000
+    keys = dr.arange(m.UInt32, n) * 0x9e3779b9
+    k, v = dr.sort_by_key(keys, m.Array2f(dr.arange(m.Float, n), 1))
+    i = dr.arange(m.UInt32, n - 1)
+    assert dr.all(dr.gather(m.UInt32, k, i + 1) >= dr.gather(m.UInt32, k, i))
+    assert dr.gather(m.UInt32, keys, m.UInt32(v.x)) == k
@@ -235,3 +235,33 @@ def test06_switch_failure(modname, recorded):
     with pytest.raises(RuntimeError) as ei:
         dr.forward(a)
     assert "bar" in str(ei.value)
+
+
+@pytest.mark.parametrize("modname", ["drjit.cuda.ad", "drjit.llvm.ad"])
+def test07_switch_repeated_callables(modname):
+    m = get_module(modname)
+
+    dr.set_flag(dr.JitFlag.VCallRecord, True)
+
+    calls = []
+
+    def f(a):
+        calls.append('f')
+        return a * 4.0
+
+    def g(a):
+        calls.append('g')
+        return -a
+
+    idx = m.UInt([0, 1, 2, 3, 2])
+    a = m.Float([1.0, 2.0, 3.0, 4.0, 5.0])
+    dr.enable_grad(a)
+
+    result = dr.switch(idx, [f, g, f, g], a)
+    assert dr.allclose(result, [4, -2, 12, -4, 20])
+
+    # Each distinct callable is traced once
+    assert sorted(calls) == ['f', 'g']
+
+    dr.backward(result)
+    assert dr.allclose(dr.grad(a), [4, -1, 4, -1, 4])
@@ -413,3 +413,358 @@ def test14_upsampling_texture(pkg):
     assert dr.allclose(b.tensor().array, [1.0, 1.0, 5.0, 1.5, 1.5, 5.5, 2.0, 2.0, 6.0,
                                           2.0, 2.0, 6.0, 2.5, 2.5, 6.5, 3.0, 3.0, 7.0,
                                           3.0, 3.0, 7.0, 3.5, 3.5, 7.5, 4.0, 4.0, 8.0])
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test15_matmul(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    for shape_a, shape_b in [((1, 1), (1, 1)), ((3, 7), (7, 5)),
+                             ((4, 40), (40, 9)), ((2, 3, 4), (2, 4, 5)),
+                             ((2, 3, 4), (4, 6)), ((5, 3), (2, 3, 2))]:
+        a_n = np.random.uniform(size=shape_a).astype(np.float32)
+        b_n = np.random.uniform(size=shape_b).astype(np.float32)
+        c = t(a_n) @ t(b_n)
+        assert c.shape == np.matmul(a_n, b_n).shape
+        assert np.allclose(c.numpy(), np.matmul(a_n, b_n), atol=1e-5)
+
+    with pytest.raises(RuntimeError) as ei:
+        t([1, 2, 3], shape=(3,)) @ t([1, 2, 3], shape=(3, 1))
+    assert "at least two dimensions" in str(ei.value)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.zeros(t, (2, 3)) @ dr.zeros(t, (2, 3))
+    assert "incompatible inner dimensions" in str(ei.value)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.zeros(t, (2, 2, 3)) @ dr.zeros(t, (3, 3, 1))
+    assert "incompatible batch dimensions" in str(ei.value)
+
+
+@pytest.mark.parametrize("pkg", pkgs_ad)
+def test16_matmul_ad(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    a_n = np.random.uniform(size=(2, 3, 20)).astype(np.float32)
+    b_n = np.random.uniform(size=(20, 4)).astype(np.float32)
+    g_n = np.random.uniform(size=(2, 3, 4)).astype(np.float32)
+
+    a, b = t(a_n), t(b_n)
+    dr.enable_grad(a, b)
+    dr.backward((a @ b) * t(g_n))
+
+    assert np.allclose(dr.grad(a).numpy(), np.matmul(g_n, b_n.T), atol=1e-5)
+    assert np.allclose(dr.grad(b).numpy(),
+                       np.einsum('bik,bij->kj', a_n, g_n), atol=1e-5)
+
+    a, b = t(a_n), t(b_n)
+    dr.enable_grad(a)
+    c = a @ b
+    dr.forward(a)
+    assert np.allclose(dr.grad(c).numpy(),
+                       np.matmul(np.ones_like(a_n), b_n), atol=1e-5)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test17_identity_slice(pkg):
+    t = get_class(pkg + ".TensorXf")
+    c = Checker((2, 1, 3), get_class(pkg + ".TensorXu"))
+    c[:]
+    c[...]
+    c[:, 0]
+    c[None, :, :, None]
+
+    # Slices that keep the element order reuse the flat array
+    a = t(dr.arange(t.Array, 6), shape=(2, 1, 3))
+    dr.eval(a)
+    b = a[:, 0, :]
+    assert b.shape == (2, 3)
+    assert b.array.index == a.array.index
+
+    # .. but assignments don't leak into the original tensor
+    b[:] = 5
+    assert b.array == dr.full(t.Array, 5, 6)
+    assert a.array == dr.arange(t.Array, 6)
+
+    # Broadcasting a single element doesn't gather
+    s = t([2], shape=(1, 1))
+    assert (s * a[:, 0, :]).array == dr.arange(t.Array, 6) * 2
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test18_reduce_axis(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    for shape in [(2, 3, 4), (1, 40, 3), (5, 1, 2)]:
+        v_n = np.random.uniform(-1, 1, size=shape).astype(np.float32)
+        v = t(v_n)
+        for axis in [0, 1, 2, -1]:
+            assert np.allclose(dr.sum(v, axis=axis).numpy(), v_n.sum(axis=axis), atol=1e-5)
+            assert np.allclose(dr.mean(v, axis=axis).numpy(), v_n.mean(axis=axis), atol=1e-5)
+            assert np.all(dr.max(v, axis=axis).numpy() == v_n.max(axis=axis))
+            assert np.all(dr.min(v, axis=axis).numpy() == v_n.min(axis=axis))
+
+    u = get_class(pkg + ".TensorXi")([-3, 1, 2, 5, -1, 0], shape=(2, 3))
+    assert dr.min(u, axis=1).array == [-3, -1]
+    assert dr.sum(u, axis=0).array == [2, 0, 2]
+
+    with pytest.raises(IndexError) as ei:
+        dr.sum(v, axis=3)
+    assert "out of bounds" in str(ei.value)
+
+    with pytest.raises(TypeError) as ei:
+        dr.sum(v.array, axis=0)
+    assert "requires a tensor input" in str(ei.value)
+
+
+@pytest.mark.parametrize("pkg", pkgs_ad)
+def test19_reduce_axis_ad(pkg):
+    t = get_class(pkg + ".TensorXf")
+
+    a = t([1, 5, 3, 2, 4, 6], shape=(2, 3))
+    dr.enable_grad(a)
+    dr.backward(dr.sum(a, axis=1) * t([1, 2], shape=(2,)))
+    assert dr.grad(a).array == [1, 1, 1, 2, 2, 2]
+
+    a = t([1, 5, 3, 2, 4, 6], shape=(2, 3))
+    dr.enable_grad(a)
+    dr.backward(dr.max(a, axis=0))
+    assert dr.grad(a).array == [0, 1, 0, 1, 0, 1]
+
+    a = t([1, 5, 3, 2, 4, 6], shape=(2, 3))
+    dr.enable_grad(a)
+    b = dr.mean(a, axis=0)
+    dr.forward(a)
+    assert dr.allclose(dr.grad(b).array, [1, 1, 1])
+
+
+def conv2d_ref(np, x, w, stride, padding):
+    x = np.pad(x, ((0, 0), (padding, padding), (padding, padding), (0, 0)))
+    kh, kw = w.shape[:2]
+    h = (x.shape[1] - kh) // stride + 1
+    v = (x.shape[2] - kw) // stride + 1
+    out = np.zeros((x.shape[0], h, v, w.shape[3]), dtype=np.float32)
+    for i in range(kh):
+        for j in range(kw):
+            patch = x[:, i:i + stride * h:stride, j:j + stride * v:stride, :]
+            out += np.einsum('bhwc,co->bhwo', patch, w[i, j])
+    return out
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test20_conv2d(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    for x_shape, w_shape, stride, padding in [
+            ((1, 5, 6, 1), (3, 3, 1, 1), 1, 0),
+            ((2, 7, 5, 3), (3, 3, 3, 6), 1, 1),
+            ((1, 8, 8, 4), (3, 3, 4, 9), 2, 1),
+            ((2, 9, 9, 12), (3, 3, 12, 5), 1, 1)]:
+        x_n = np.random.uniform(-1, 1, size=x_shape).astype(np.float32)
+        w_n = np.random.uniform(-1, 1, size=w_shape).astype(np.float32)
+        y = dr.conv2d(t(x_n), t(w_n), stride=stride, padding=padding)
+        assert np.allclose(y.numpy(), conv2d_ref(np, x_n, w_n, stride, padding), atol=1e-4)
+
+    y = dr.conv2d(t(x_n[0]), t(w_n), padding=1)
+    assert y.shape == (9, 9, 5)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.conv2d(dr.zeros(t, (4, 4, 2)), dr.zeros(t, (3, 3, 3, 1)))
+    assert "channel count mismatch" in str(ei.value)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test21_pool2d(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    x_n = np.random.uniform(-1, 1, size=(2, 6, 4, 3)).astype(np.float32)
+    windows = x_n.reshape(2, 3, 2, 2, 2, 3)
+    assert np.allclose(dr.avg_pool2d(t(x_n), 2).numpy(), windows.mean(axis=(2, 4)), atol=1e-6)
+    assert np.all(dr.max_pool2d(t(x_n), 2).numpy() == windows.max(axis=(2, 4)))
+    assert dr.max_pool2d(t(x_n), 3, stride=1).shape == (2, 4, 2, 3)
+
+
+@pytest.mark.parametrize("pkg", pkgs_ad)
+def test22_conv_pool_ad(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    x_n = np.random.uniform(-1, 1, size=(1, 6, 5, 2)).astype(np.float32)
+    w_n = np.random.uniform(-1, 1, size=(3, 3, 2, 3)).astype(np.float32)
+    g_n = np.random.uniform(-1, 1, size=(1, 3, 3, 3)).astype(np.float32)
+
+    # Adjoint identities: <conv(dx, w) + conv(x, dw), g> = <dx, gx> + <dw, gw>
+    x, w = t(x_n), t(w_n)
+    dr.enable_grad(x, w)
+    dr.backward(dr.conv2d(x, w, stride=2, padding=1) * t(g_n))
+    gx, gw = dr.grad(x).numpy(), dr.grad(w).numpy()
+
+    dx_n = np.random.uniform(-1, 1, size=x_n.shape).astype(np.float32)
+    dw_n = np.random.uniform(-1, 1, size=w_n.shape).astype(np.float32)
+    dy = conv2d_ref(np, dx_n, w_n, 2, 1) + conv2d_ref(np, x_n, dw_n, 2, 1)
+    assert np.allclose((dy * g_n).sum(), (dx_n * gx).sum() + (dw_n * gw).sum(), atol=1e-4)
+
+    a = t([1, 5, 3, 2, 4, 6, 0, 1], shape=(2, 4, 1))
+    dr.enable_grad(a)
+    dr.backward(dr.max_pool2d(a, 2))
+    assert dr.grad(a).array == [0, 0, 1, 0, 0, 1, 0, 0]
+
+    a = t([1, 5, 3, 2, 4, 6, 0, 1], shape=(2, 4, 1))
+    dr.enable_grad(a)
+    dr.backward(dr.avg_pool2d(a, 2))
+    assert dr.allclose(dr.grad(a).array, 0.25)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test23_resample_tensor(pkg):
+    t = get_class(pkg + ".TensorXf")
+    a = t(dr.arange(t.Array, 16), shape=(4, 4))
+
+    b = dr.downsample(a, scale_factor=[2, 2])
+    assert b.shape == (2, 2)
+    assert dr.allclose(b.array, [2.5, 4.5, 10.5, 12.5])
+
+    b = dr.resample(a, [4, 8], filter=dr.ResampleFilter.Box)
+    assert dr.allclose(b[0].array, [0, 0, 1, 1, 2, 2, 3, 3])
+
+    b = dr.resample(a, [4, 8])
+    assert dr.allclose(b[0].array, [0, 0.25, 0.75, 1.25, 1.75, 2.25, 2.75, 3])
+
+    # The box filter includes the tap at the lower end of its support
+    b = dr.resample(t([1, 2], shape=(2,)), [3], filter=dr.ResampleFilter.Box)
+    assert dr.allclose(b.array, [1, 1, 2])
+
+    # Constant signals are preserved by all filters
+    c = dr.full(t, 1, (6, 5, 3))
+    for f in [dr.ResampleFilter.Box, dr.ResampleFilter.Tent,
+              dr.ResampleFilter.Lanczos]:
+        for shape in [[3, 2], [13, 9], [2, 11]]:
+            r = dr.resample(c, shape, filter=f)
+            assert r.shape == (shape[0], shape[1], 3)
+            assert dr.allclose(r.array, 1)
+
+    with pytest.raises(TypeError) as ei:
+        dr.downsample(a, shape=[8, 4])
+    assert "smaller or equal" in str(ei.value)
+
+    with pytest.raises(TypeError) as ei:
+        dr.resample(a, [0, 4])
+    assert "positive integer" in str(ei.value)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test24_resample_texture(pkg):
+    t = get_class(pkg + ".TensorXf")
+    tex_t = get_class(pkg + ".Texture2f")
+
+    a = tex_t(t(dr.arange(t.Array, 16), shape=(4, 4, 1)))
+    b = dr.downsample(a, shape=[2, 2])
+    assert type(b) is tex_t
+    assert b.shape == (2, 2, 1)
+    assert dr.allclose(b.tensor().array, [2.5, 4.5, 10.5, 12.5])
+
+
+@pytest.mark.parametrize("pkg", pkgs_ad)
+def test25_resample_ad(pkg):
+    t = get_class(pkg + ".TensorXf")
+
+    a = t(dr.arange(t.Array, 16), shape=(4, 4))
+    dr.enable_grad(a)
+    dr.backward(dr.downsample(a, scale_factor=[2, 2]))
+    assert dr.allclose(dr.grad(a).array, 0.25)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test26_npy_roundtrip(pkg, tmp_path):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+    ti = get_class(pkg + ".TensorXi")
+
+    ref = np.arange(24, dtype=np.float32).reshape(2, 3, 4)
+    np.save(tmp_path / "a.npy", ref)
+    a = dr.load_npy(t, tmp_path / "a.npy")
+    assert a.shape == (2, 3, 4)
+    assert np.all(a.numpy() == ref)
+
+    # Writes to the loaded tensor must not reach the file
+    dr.scatter(a.array, 100, 0)
+    assert np.all(np.load(tmp_path / "a.npy") == ref)
+    assert a.array[0] == 100
+
+    dr.save_npy(tmp_path / "b.npy", a * 2)
+    b = np.load(tmp_path / "b.npy")
+    assert b.dtype == np.float32 and b.shape == (2, 3, 4)
+    assert b[0, 0, 0] == 200 and np.all(b.ravel()[1:] == ref.ravel()[1:] * 2)
+
+    c = dr.load_npy(t, tmp_path / "b.npy")
+    assert c.shape == (2, 3, 4) and dr.all(c.array == (a * 2).array)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.load_npy(ti, tmp_path / "a.npy")
+    assert "expected \"<i4\"" in str(ei.value)
+
+
+def fft_ref(np, x_n, ndim, inverse=False):
+    z = x_n[..., 0] + 1j * x_n[..., 1]
+    axes = tuple(range(-ndim, 0))
+    z = np.fft.ifftn(z, axes=axes) if inverse else np.fft.fftn(z, axes=axes)
+    return np.stack((z.real, z.imag), axis=-1)
+
+
+@pytest.mark.parametrize("pkg", pkgs)
+def test27_fft(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    for shape, ndim in [((1, 2), 1), ((3, 8, 2), 1), ((2, 512, 2), 1),
+                        ((4, 16, 2), 2), ((2, 8, 32, 2), 2),
+                        ((4, 2, 8, 2), 3), ((3, 4, 8, 16, 2), 3)]:
+        x_n = np.random.uniform(-1, 1, size=shape).astype(np.float32)
+        y = dr.fft(t(x_n), ndim)
+        assert y.shape == shape
+        assert np.allclose(y.numpy(), fft_ref(np, x_n, ndim), atol=1e-4)
+        z = dr.ifft(t(x_n), ndim)
+        assert np.allclose(z.numpy(), fft_ref(np, x_n, ndim, True), atol=1e-5)
+        assert np.allclose(dr.ifft(y, ndim).numpy(), x_n, atol=1e-5)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.fft(dr.zeros(t, (6, 2)))
+    assert "must be a power of two" in str(ei.value)
+
+    with pytest.raises(RuntimeError) as ei:
+        dr.fft(dr.zeros(t, (8, 3)))
+    assert "real and imaginary parts" in str(ei.value)
+
+
+@pytest.mark.parametrize("pkg", pkgs_ad)
+def test28_fft_ad(pkg):
+    np = pytest.importorskip("numpy")
+    t = get_class(pkg + ".TensorXf")
+
+    # Adjoint identity: <fft(dx), g> = <dx, grad>
+    for ndim, inverse in [(1, False), (2, False), (2, True), (3, True)]:
+        shape = (2, 4, 8, 2, 2)
+        x_n = np.random.uniform(-1, 1, size=shape).astype(np.float32)
+        g_n = np.random.uniform(-1, 1, size=shape).astype(np.float32)
+        dx_n = np.random.uniform(-1, 1, size=shape).astype(np.float32)
+
+        x = t(x_n)
+        dr.enable_grad(x)
+        y = dr.ifft(x, ndim) if inverse else dr.fft(x, ndim)
+        dr.backward(y * t(g_n))
+        gx = dr.grad(x).numpy()
+
+        dy = fft_ref(np, dx_n, ndim, inverse)
+        assert np.allclose((dy * g_n).sum(), (dx_n * gx).sum(), atol=1e-3)
+
+        x = t(x_n)
+        dr.enable_grad(x)
+        y = dr.ifft(x, ndim) if inverse else dr.fft(x, ndim)
+        dr.set_grad(x, t(dx_n))
+        dr.forward_to(y)
+        assert np.allclose(dr.grad(y).numpy(), dy, atol=1e-4)
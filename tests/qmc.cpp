@@ -0,0 +1,79 @@
+/*
+    tests/qmc.cpp -- tests low-discrepancy sequences
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/qmc.h>
+
+using UInt32P = Packet<uint32_t>;
+
+DRJIT_TEST(test01_sobol_reference) {
+    // First points of the Joe-Kuo Sobol sequence (without Gray code ordering)
+    float ref[8][4] = {
+        { 0.f, 0.f, 0.f, 0.f },
+        { .5f, .5f, .5f, .5f },
+        { .25f, .75f, .75f, .75f },
+        { .75f, .25f, .25f, .25f },
+        { .125f, .625f, .375f, .125f },
+        { .625f, .125f, .875f, .625f },
+        { .375f, .375f, .625f, .875f },
+        { .875f, .875f, .125f, .375f }
+    };
+
+    for (uint32_t i = 0; i < 8; ++i)
+        for (uint32_t d = 0; d < 4; ++d)
+            assert(sobol_uint32(i, d) * 0x1p-32f == ref[i][d]);
+
+    assert(sobol_uint32(12345u, 15) == 0xcb140000u);
+    assert(sobol_uint32(0xffffffffu, 9) == 0x812ad7a7u);
+    assert(reverse_bits(0x12345678u) == 0x1e6a2c48u);
+}
+
+DRJIT_TEST(test02_sobol_stratification) {
+    // Every dimension is stratified before and after scrambling
+    const uint32_t log_n = 10, n = 1u << log_n;
+
+    for (uint32_t d = 0; d < 40; ++d) {
+        bool hit_raw[n] { }, hit_scrambled[n] { };
+        for (uint32_t i = 0; i < n; ++i) {
+            if (d < 16)
+                hit_raw[sobol_uint32(i, d) >> (32 - log_n)] = true;
+            hit_scrambled[(uint32_t) (sobol(i, d, 1234u) * n)] = true;
+        }
+
+        for (uint32_t i = 0; i < n; ++i)
+            assert((d >= 16 || hit_raw[i]) && hit_scrambled[i]);
+    }
+}
+
+DRJIT_TEST(test03_halton) {
+    assert(halton(1u, 0) == .5f && halton(2u, 0) == .25f && halton(3u, 0) == .75f);
+    assert(std::abs(halton(1u, 1) - 1.f / 3.f) < 1e-7f);
+    assert(std::abs(halton(5u, 1) - 7.f / 9.f) < 1e-7f);
+    assert(std::abs(halton(7u, 2) - 11.f / 25.f) < 1e-7f);
+    assert(radical_inverse(0xffffffffu, 3) < 1.f);
+}
+
+DRJIT_TEST(test04_qmc_packet) {
+    UInt32P index = arange<UInt32P>() * 77u + 5u,
+            seed = arange<UInt32P>() ^ 0x5555u;
+
+    UInt32P s = sobol_uint32(index, 7);
+    auto f = sobol(index, 21, seed);
+    auto h = halton(index, 5);
+
+    for (size_t i = 0; i < UInt32P::Size; ++i) {
+        assert(s[i] == sobol_uint32(index[i], 7));
+        assert(f[i] == sobol(index[i], 21, seed[i]));
+        assert(h[i] == halton(index[i], 5));
+    }
+}
@@ -0,0 +1,130 @@
+/*
+    tests/random.cpp -- tests the counter-based pseudorandom number generator
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/random.h>
+
+using UInt32P = Packet<uint32_t>;
+
+DRJIT_TEST(test01_philox_known_answer) {
+    // Known-answer vectors of the Random123 reference implementation
+    using Philox = Philox4x32<uint32_t>;
+    using UInt32x4 = Philox::UInt32x4;
+
+    assert(Philox::block(UInt32x4(0u), 0u, 0u) ==
+           UInt32x4(0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u));
+    assert(Philox::block(UInt32x4(0xffffffffu), 0xffffffffu, 0xffffffffu) ==
+           UInt32x4(0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu));
+    assert(Philox::block(UInt32x4(0x243f6a88u, 0x85a308d3u, 0x13198a2eu,
+                                  0x03707344u), 0xa4093822u, 0x299f31d0u) ==
+           UInt32x4(0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u));
+}
+
+DRJIT_TEST(test02_philox_random_access) {
+    // Packets and scalars produce the same values for the same counter
+    Philox4x32<UInt32P> rng_p(arange<UInt32P>() + 100u, 7u, 1234u);
+    Philox4x32<uint32_t> rng_s[UInt32P::Size];
+    for (size_t i = 0; i < UInt32P::Size; ++i)
+        rng_s[i] = Philox4x32<uint32_t>(100u + (uint32_t) i, 7u, 1234u);
+
+    for (int j = 0; j < 10; ++j) {
+        UInt32P a = rng_p.next_uint32();
+        UInt32P b = rng_p.next_uint32_bounded(13, arange<UInt32P>() < 2u);
+        for (size_t i = 0; i < UInt32P::Size; ++i) {
+            assert(a[i] == rng_s[i].next_uint32());
+            if (i < 2)
+                assert(b[i] == rng_s[i].next_uint32_bounded(13));
+        }
+    }
+
+    // Any dimension can be evaluated without generating the previous ones
+    for (size_t i = 0; i < UInt32P::Size; ++i)
+        assert(rng_s[i].dimension == rng_p.dimension[i]);
+    size_t k = UInt32P::Size - 1;
+    Philox4x32<uint32_t> rng(100u + (uint32_t) k, 7u, 1234u, rng_p.dimension[k]);
+    assert(rng.next_float32() == rng_p.next_float32()[k]);
+}
+
+DRJIT_TEST(test03_philox_bounded) {
+    Philox4x32<UInt32P> rng(arange<UInt32P>());
+    uint32_t hist[10] { };
+
+    // 160K samples regardless of the packet size
+    const int iterations = 160000 / (int) UInt32P::Size;
+    for (int i = 0; i < iterations; ++i) {
+        UInt32P value = rng.next_uint32_bounded(10);
+        assert(all(value < 10u));
+        for (size_t j = 0; j < UInt32P::Size; ++j)
+            hist[value[j]]++;
+
+        auto value64 = rng.next_uint64_bounded(1000000000000ull);
+        assert(all(value64 < 1000000000000ull));
+    }
+
+    uint32_t expected = 16000;
+    for (int i = 0; i < 10; ++i)
+        assert(hist[i] > expected * 95 / 100 && hist[i] < expected * 105 / 100);
+
+    for (int i = 0; i < 1000; ++i) {
+        Array<Packet<float>, 4> v = rng.next_float32x4();
+        assert(all_nested(v >= 0.f && v < 1.f));
+    }
+}
+
+DRJIT_TEST(test04_pcg32_bounded_fixed) {
+    PCG32<Packet<uint64_t, UInt32P::Size>> rng;
+    uint32_t hist[10] { };
+
+    // 160K samples regardless of the packet size
+    const int iterations = 160000 / (int) UInt32P::Size;
+    for (int i = 0; i < iterations; ++i) {
+        auto value = rng.next_uint32_bounded_fixed(10);
+        assert(all(value < 10u));
+        for (size_t j = 0; j < UInt32P::Size; ++j)
+            hist[value[j]]++;
+
+        auto value64 = rng.next_uint64_bounded_fixed(1000000000000ull);
+        assert(all(value64 < 1000000000000ull));
+    }
+
+    uint32_t expected = 16000;
+    for (int i = 0; i < 10; ++i)
+        assert(hist[i] > expected * 95 / 100 && hist[i] < expected * 105 / 100);
+
+    // Disabled lanes don't advance
+    using Mask = mask_t<Packet<uint64_t, UInt32P::Size>>;
+    auto state = rng.state;
+    rng.next_uint32_bounded_fixed(0x80000001u, Mask(false), 4);
+    assert(all(eq(state, rng.state)));
+}
+
+DRJIT_TEST(test05_pcg32_seed_sequence) {
+    using UInt64P = Packet<uint64_t, UInt32P::Size>;
+    const uint64_t stride = 5;
+
+    // Lane i continues where lane i - 1 leaves off after 'stride' samples
+    PCG32<UInt64P> rng_p;
+    rng_p.seed_sequence(UInt64P::Size, 42, 54, stride);
+    PCG32<uint64_t> rng_s;
+    rng_s.seed_sequence(1, 42, 54, stride);
+
+    uint32_t ref[UInt64P::Size * stride];
+    for (size_t i = 0; i < UInt64P::Size * stride; ++i)
+        ref[i] = rng_s.next_uint32();
+
+    for (size_t k = 0; k < stride; ++k) {
+        auto value = rng_p.next_uint32();
+        for (size_t j = 0; j < UInt64P::Size; ++j)
+            assert(value[j] == ref[j * stride + k]);
+    }
+}
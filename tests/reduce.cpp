@@ -0,0 +1,136 @@
+/*
+    tests/reduce.cpp -- tests deterministic floating point reductions
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/jit.h>
+#include <drjit/autodiff.h>
+#include <cstring>
+#include <vector>
+
+namespace dr = drjit;
+
+using Float   = dr::LLVMArray<float>;
+using Float64 = dr::LLVMArray<double>;
+using UInt32  = dr::LLVMArray<uint32_t>;
+using FloatAD = dr::DiffArray<Float>;
+
+/// Values spanning many orders of magnitude, which makes rounding visible
+template <typename T> std::vector<T> values(size_t n, uint32_t seed) {
+    std::mt19937 mt(seed);
+    std::vector<T> result(n);
+    for (size_t i = 0; i < n; ++i)
+        result[i] = (T) std::ldexp((double) mt() / 4294967296.0 - .5,
+                                   (int) (mt() % 24) - 12);
+    return result;
+}
+
+template <typename T> bool bitwise_equal(const T &a, const T &b) {
+    using Scalar = dr::scalar_t<T>;
+    std::vector<Scalar> va(a.size()), vb(b.size());
+    dr::store(va.data(), a);
+    dr::store(vb.data(), b);
+    return va.size() == vb.size() &&
+           memcmp(va.data(), vb.data(), va.size() * sizeof(Scalar)) == 0;
+}
+
+DRJIT_TEST(test01_horizontal) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    dr::DeterministicReductionScope scope;
+
+    // Sizes that are not multiples of the fan-in of the reduction tree
+    for (size_t n : { 1u, 15u, 17u, 1000u, 123457u }) {
+        std::vector<float> v = values<float>(n, (uint32_t) n);
+        Float x = dr::load<Float>(v.data(), n);
+
+        double ref = 0.0, ref_abs = 0.0;
+        for (float f : v) {
+            ref += f;
+            ref_abs += std::abs(f);
+        }
+
+        Float s = dr::sum(x), d = dr::dot(x, x);
+        assert(std::abs(s[0] - ref) <= 1e-5 * ref_abs);
+        for (int i = 0; i < 3; ++i) {
+            assert(bitwise_equal(s, dr::sum(x)));
+            assert(bitwise_equal(d, dr::dot(x, x)));
+        }
+    }
+
+    Float x = dr::arange<Float>(1, 11);
+    assert(dr::prod(x)[0] == 3628800.f);
+    assert(dr::sum(dr::arange<Float64>(100))[0] == 4950.0);
+}
+
+template <typename T> void scatter_add_test() {
+    using Scalar = dr::scalar_t<T>;
+    dr::DeterministicReductionScope scope;
+
+    size_t n = 100000, m = 37;
+    std::vector<Scalar> v = values<Scalar>(n, 1);
+    std::vector<uint32_t> index(n), perm(n);
+    for (size_t i = 0; i < n; ++i) {
+        index[i] = (uint32_t) (i * 7919 % m);
+        perm[i] = (uint32_t) (i * 48271 % n);
+    }
+
+    // Non-finite contributions and an entry without any contribution
+    v[3] = std::numeric_limits<Scalar>::infinity();
+    index[5] = index[7] = (uint32_t) m;
+
+    std::vector<double> ref(m + 1, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        ref[index[i]] += (double) v[i];
+
+    T value = dr::load<T>(v.data(), n);
+    UInt32 idx = dr::load<UInt32>(index.data(), n),
+           p = dr::load<UInt32>(perm.data(), n);
+
+    T a = dr::full<T>(Scalar(.5), m + 2), b = a;
+    dr::scatter_reduce(ReduceOp::Add, a, value, idx);
+
+    // The result does not depend on the order of the inputs
+    dr::scatter_reduce(ReduceOp::Add, b, dr::gather<T>(value, p),
+                       dr::gather<UInt32>(idx, p));
+    assert(bitwise_equal(a, b));
+
+    for (size_t i = 0; i <= m + 1; ++i) {
+        double expected = (i <= m ? ref[i] : 0.0) + .5;
+        if (std::isinf(expected))
+            assert(std::isinf(a[i]));
+        else
+            assert(std::abs(a[i] - expected) <=
+                   (std::is_same_v<Scalar, float> ? 1e-6 : 1e-10) *
+                       std::max(1.0, std::abs(expected)));
+    }
+}
+
+DRJIT_TEST(test02_scatter_add) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    scatter_add_test<Float>();
+    scatter_add_test<Float64>();
+}
+
+DRJIT_TEST(test03_ad) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    dr::DeterministicReductionScope scope;
+
+    FloatAD x = dr::arange<FloatAD>(10);
+    dr::enable_grad(x);
+
+    FloatAD y = dr::zeros<FloatAD>(3);
+    dr::scatter_reduce(ReduceOp::Add, y, x * x, dr::arange<UInt32>(10) % 3);
+    FloatAD loss = dr::sum(y);
+    dr::backward(loss);
+
+    assert(dr::detach(loss)[0] == 285.f);
+    assert(dr::all(dr::eq(dr::detach(dr::grad(x)), 2.f * dr::arange<Float>(10))));
+}
@@ -13,6 +13,8 @@
 
 #include "test.h"
 #include <drjit/sh.h>
+#include <drjit/matrix.h>
+#include <drjit/dynamic.h>
 
 DRJIT_TEST(test00_sh) {
     using T = Array<float>;
@@ -59,3 +61,118 @@ DRJIT_TEST(test00_sh) {
         }
     }
 }
+
+DRJIT_TEST(test01_sh_recurrence) {
+    using T = Array<float>;
+    using Vector3f = Array<T, 3>;
+
+    Vector3f d = normalize(Vector3f(arange<T>() - 3.f, 2.f, T(1.f) - arange<T>() * .5f));
+
+    T ref[100], out[441];
+    for (size_t i = 0; i < 10; ++i) {
+        sh_eval(d, i, ref);
+        sh_eval_recurrence(d, i, out);
+        for (size_t j = 0; j < (i + 1) * (i + 1); ++j)
+            assert(all(abs(out[j] - ref[j]) < 1e-5f));
+    }
+
+    // Addition theorem: sum_m Y_lm(d)^2 = (2l + 1) / (4 pi)
+    sh_eval(d, 20, out);
+    for (size_t l = 0; l <= 20; ++l) {
+        T sum = 0.f;
+        for (size_t i = l * l; i < (l + 1) * (l + 1); ++i)
+            sum += sqr(out[i]);
+        assert(all(abs(sum - (2.f * l + 1.f) / (4.f * Pi<float>)) < 1e-4f));
+    }
+}
+
+DRJIT_TEST(test02_sh_rotate) {
+    using T = Array<float>;
+    using Vector3f = Array<T, 3>;
+    using Matrix3f = Matrix<float, 3>;
+
+    const size_t order = 7, n = (order + 1) * (order + 1);
+    float angle = 1.1f, c = std::cos(angle), s = std::sin(angle);
+    float a[3] = { 0.48f, -0.6f, 0.64f };
+
+    // Rodrigues' formula for a rotation about the unit axis 'a'
+    Matrix3f rot;
+    for (size_t i = 0; i < 3; ++i)
+        for (size_t j = 0; j < 3; ++j)
+            rot(i, j) = (i == j ? c : 0.f) + (1.f - c) * a[i] * a[j];
+    rot(0, 1) -= s * a[2]; rot(1, 0) += s * a[2];
+    rot(0, 2) += s * a[1]; rot(2, 0) -= s * a[1];
+    rot(1, 2) -= s * a[0]; rot(2, 1) += s * a[0];
+
+    T coeffs[n], rotated[n], basis[n];
+    for (size_t i = 0; i < n; ++i)
+        coeffs[i] = std::sin(1.f + i * 0.7f);
+    sh_rotate(rot, order, coeffs, rotated);
+
+    Vector3f d = normalize(Vector3f(arange<T>() - 3.f, 2.f, T(1.f) - arange<T>() * .5f)),
+             d_rot;
+    for (size_t i = 0; i < 3; ++i)
+        d_rot.entry(i) = rot(i, 0) * d.x() + rot(i, 1) * d.y() + rot(i, 2) * d.z();
+
+    T f = 0.f, g = 0.f;
+    sh_eval(d, order, basis);
+    for (size_t i = 0; i < n; ++i)
+        f = fmadd(coeffs[i], basis[i], f);
+    sh_eval(d_rot, order, basis);
+    for (size_t i = 0; i < n; ++i)
+        g = fmadd(rotated[i], basis[i], g);
+
+    assert(all(abs(f - g) < 1e-4f));
+
+    // In-place rotation by the inverse recovers the input
+    sh_rotate(transpose(rot), order, rotated, rotated);
+    for (size_t i = 0; i < n; ++i)
+        assert(all(abs(rotated[i] - coeffs[i]) < 1e-5f));
+}
+
+DRJIT_TEST(test03_sh_zonal_convolve) {
+    using T = Array<float>;
+    using Vector3f = Array<T, 3>;
+
+    const size_t order = 12, n = (order + 1) * (order + 1);
+    float zonal[order + 1];
+    for (size_t l = 0; l <= order; ++l)
+        zonal[l] = 1.f / (1.f + l);
+
+    // Aligned with +Z: only the m = 0 coefficients remain
+    T out[n];
+    sh_zonal_rotate(Vector3f(0.f, 0.f, 1.f), order, zonal, out);
+    for (size_t l = 0; l <= order; ++l)
+        for (size_t i = l * l; i < (l + 1) * (l + 1); ++i)
+            assert(all(abs(out[i] - (i == l * (l + 1) ? zonal[l] : 0.f)) < 1e-5f));
+
+    // Convolving the basis functions of 'd' with a zonal kernel is the same
+    Vector3f d = normalize(Vector3f(arange<T>() - 3.f, 2.f, T(1.f)));
+    T basis[n];
+    sh_eval(d, order, basis);
+    sh_convolve(basis, order, zonal, basis);
+    sh_zonal_rotate(d, order, zonal, out);
+    for (size_t i = 0; i < n; ++i)
+        assert(all(abs(out[i] - basis[i]) < 1e-5f));
+}
+
+DRJIT_TEST(test04_sh_project) {
+    using T = DynamicArray<float>;
+    using Vector3f = Array<T, 3>;
+
+    // Spherical Fibonacci points
+    const size_t count = 20000, order = 4, n = (order + 1) * (order + 1);
+    T i = arange<T>(count) + .5f,
+      z = 1.f - 2.f * i / float(count),
+      phi = i * 2.39996322972865332f,
+      r = safe_sqrt(1.f - sqr(z));
+    Vector3f d(r * cos(phi), r * sin(phi), z);
+
+    T basis[n], out[n], weight = full<T>(4.f * Pi<float> / count, count);
+    sh_eval(d, order, basis);
+    for (size_t j = 0; j < n; ++j) {
+        sh_project(d, basis[j] * weight, order, out);
+        for (size_t k = 0; k < n; ++k)
+            assert(std::abs(out[k].entry(0) - (j == k ? 1.f : 0.f)) < 1e-3f);
+    }
+}
@@ -0,0 +1,205 @@
+/*
+    tests/sparse.cpp -- tests sparse matrices and their products
+
+    Dr.Jit is a C++ template library for efficient vectorization and
+    differentiation of numerical kernels on modern processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/jit.h>
+#include <drjit/autodiff.h>
+#include <drjit/sparse.h>
+#include <vector>
+
+namespace dr = drjit;
+
+using Float  = dr::DiffArray<dr::LLVMArray<float>>;
+using FloatD = dr::LLVMArray<float>;
+using UInt32 = dr::LLVMArray<uint32_t>;
+
+/// Dense row-major copy of a matrix given as (row, column, value) triplets
+std::vector<float> dense(uint32_t rows, uint32_t cols,
+                         const std::vector<uint32_t> &row,
+                         const std::vector<uint32_t> &col,
+                         const std::vector<float> &value) {
+    std::vector<float> result(rows * cols, 0.f);
+    for (size_t i = 0; i < row.size(); ++i)
+        result[row[i] * cols + col[i]] += value[i];
+    return result;
+}
+
+/// Product of a dense row-major matrix (or its transpose) with 'b' (k columns)
+std::vector<float> dense_matmul(const std::vector<float> &a, uint32_t rows,
+                                uint32_t cols, const std::vector<float> &b,
+                                uint32_t k, bool transpose) {
+    uint32_t n = transpose ? cols : rows, m = transpose ? rows : cols;
+    std::vector<float> result(n * k, 0.f);
+    for (uint32_t i = 0; i < n; ++i)
+        for (uint32_t l = 0; l < m; ++l)
+            for (uint32_t j = 0; j < k; ++j)
+                result[i * k + j] +=
+                    (transpose ? a[l * cols + i] : a[i * cols + l]) * b[l * k + j];
+    return result;
+}
+
+template <typename T> bool close(const T &a, const std::vector<float> &b) {
+    return dr::width(a) == b.size() &&
+           dr::all(dr::abs(dr::detach(a) - dr::load<FloatD>(b.data(), b.size())) < 1e-4f);
+}
+
+/// Random 7x5 matrix with an empty row and a duplicate entry
+struct Example {
+    uint32_t rows = 7, cols = 5;
+    std::vector<uint32_t> row, col;
+    std::vector<float> value;
+
+    Example() {
+        for (uint32_t i = 0; i < 20; ++i) {
+            uint32_t r = (i * 7 + 3) % rows;
+            if (r == 4)
+                continue;
+            row.push_back(r);
+            col.push_back((i * 3 + 1) % cols);
+            value.push_back(float(i % 5) - 1.5f);
+        }
+        row.push_back(row[0]);
+        col.push_back(col[0]);
+        value.push_back(.25f);
+    }
+
+    template <typename T> dr::SparseMatrix<T> matrix() const {
+        size_t n = row.size();
+        return dr::SparseMatrix<T>::from_coo(
+            rows, cols, dr::load<UInt32>(row.data(), n),
+            dr::load<UInt32>(col.data(), n), dr::load<T>(value.data(), n));
+    }
+};
+
+DRJIT_TEST(test01_sparse_products) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    Example e;
+    std::vector<float> a = dense(e.rows, e.cols, e.row, e.col, e.value);
+    dr::SparseMatrix<FloatD> m = e.matrix<FloatD>();
+    assert(m.nnz() == e.row.size());
+
+    for (uint32_t k : { 1u, 3u, 12u }) {
+        for (bool transpose : { false, true }) {
+            std::vector<float> b((transpose ? e.rows : e.cols) * k);
+            for (size_t i = 0; i < b.size(); ++i)
+                b[i] = float(i % 7) * .5f - 1.f;
+
+            FloatD bv = dr::load<FloatD>(b.data(), b.size());
+            std::vector<float> ref =
+                dense_matmul(a, e.rows, e.cols, b, k, transpose);
+            assert(close(m.matmul(bv, k, transpose), ref));
+            assert(close(m.transpose().matmul(bv, k, !transpose), ref));
+            if (k == 1)
+                assert(close(m.matvec(bv, transpose), ref));
+        }
+    }
+
+    // CSR constructor with the arrays of an existing matrix
+    dr::SparseMatrix<FloatD> m2(e.rows, e.cols, m.offset, m.col, m.values);
+    FloatD x = dr::arange<FloatD>(e.cols);
+    assert(dr::all(dr::eq(m2.matvec(x), m.matvec(x))));
+
+    bool raised = false;
+    try {
+        m.matvec(dr::zeros<FloatD>(e.rows));
+    } catch (const std::exception &) {
+        raised = true;
+    }
+    assert(raised);
+}
+
+DRJIT_TEST(test02_sparse_ad) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    Example e;
+    dr::SparseMatrix<Float> m = e.matrix<Float>();
+    dr::enable_grad(m.values);
+
+    for (bool transpose : { false, true }) {
+        uint32_t k = 2, n_in = transpose ? e.rows : e.cols,
+                 n_out = transpose ? e.cols : e.rows;
+        Float b = dr::arange<Float>(n_in * k) * .25f - 1.f,
+              g = dr::arange<Float>(n_out * k) * .5f + .5f;
+        dr::enable_grad(b);
+
+        // Reverse mode: compare against the adjoint identity for 'b'
+        Float y = m.matmul(b, k, transpose), loss = dr::dot(y, g);
+        dr::backward(loss);
+        Float grad_b = dr::grad(b), grad_v = dr::grad(m.values);
+        assert(dr::allclose(dr::detach(grad_b),
+                            dr::detach(m.matmul(g, k, !transpose)), 1e-4f, 1e-4f));
+
+        // Finite differences in the direction of the values
+        FloatD dv = dr::arange<FloatD>(m.nnz()) * .1f - .3f;
+        dr::SparseMatrix<FloatD> md(e.rows, e.cols, m.offset, m.col,
+                                    dr::detach(m.values) + dv * 1e-2f);
+        FloatD yd = md.matmul(dr::detach(b), k, transpose);
+        float fd = (dr::dot(yd, dr::detach(g)) - dr::detach(loss))[0] * 100.f,
+              ad = dr::dot(dr::detach(grad_v), dv)[0];
+        assert(std::abs(fd - ad) < 1e-2f * std::max(1.f, std::abs(ad)));
+
+        // Forward mode
+        dr::set_grad(m.values, 0.f);
+        dr::set_grad(b, 0.f);
+        Float y2 = m.matmul(b, k, transpose);
+        dr::set_grad(m.values, Float(dv));
+        dr::forward_to(y2);
+        FloatD dy = dr::detach(dr::grad(y2));
+        dr::SparseMatrix<FloatD> mv(e.rows, e.cols, m.offset, m.col, dv);
+        assert(dr::allclose(dy, mv.matmul(dr::detach(b), k, transpose), 1e-4f, 1e-4f));
+
+        dr::set_grad(m.values, 0.f);
+        dr::disable_grad(b);
+    }
+}
+
+DRJIT_TEST(test03_sparse_cg) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    // 1D Laplacian with Dirichlet boundary conditions
+    uint32_t n = 64;
+    std::vector<uint32_t> row, col;
+    std::vector<float> value;
+    for (uint32_t i = 0; i < n; ++i) {
+        for (int d = -1; d <= 1; ++d) {
+            int j = (int) i + d;
+            if (j < 0 || j >= (int) n)
+                continue;
+            row.push_back(i);
+            col.push_back((uint32_t) j);
+            value.push_back(d == 0 ? 2.f : -1.f);
+        }
+    }
+
+    size_t nnz = row.size();
+    auto m = dr::SparseMatrix<FloatD>::from_coo(
+        n, n, dr::load<UInt32>(row.data(), nnz),
+        dr::load<UInt32>(col.data(), nnz), dr::load<FloatD>(value.data(), nnz));
+
+    // Conjugate gradients converge after n iterations in exact arithmetic
+    FloatD rhs = dr::full<FloatD>(1.f, n), x = dr::zeros<FloatD>(n),
+           r = rhs, p = r;
+    float rr = dr::dot(r, r)[0];
+    for (uint32_t it = 0; it < n && rr > 1e-10f; ++it) {
+        FloatD ap = m.matvec(p);
+        float alpha = rr / dr::dot(p, ap)[0];
+        x = dr::fmadd(p, alpha, x);
+        r = dr::fmadd(ap, -alpha, r);
+        float rr_new = dr::dot(r, r)[0];
+        p = dr::fmadd(p, rr_new / rr, r);
+        rr = rr_new;
+        dr::eval(x, r, p);
+    }
+
+    assert(dr::all(dr::abs(m.matvec(x) - rhs) < 1e-2f));
+}
@@ -90,3 +90,45 @@ DRJIT_TEST(test04_slice) {
     assert(c3.o.x() == 0.75f);
     assert(c3.i == 3);
 }
+
+template <typename Value_> struct Particle {
+    using Value = Value_;
+    using Vector = Array<Value, 3>;
+    using UInt = uint32_array_t<Value>;
+    using Mask = mask_t<Value>;
+
+    Vector p;
+    Value w;
+    UInt id;
+    Mask alive;
+
+    DRJIT_STRUCT(Particle, p, w, id, alive)
+};
+
+DRJIT_TEST(test05_aos_gather_scatter) {
+    using ParticleX = Particle<FloatX>;
+    using UInt32X = DynamicArray<uint32_t>;
+
+    ParticleX c = zeros<ParticleX>(4);
+    c.p.x() = FloatX(0, 1, 2, 3);
+    c.p.z() = FloatX(4, 5, 6, 7);
+    c.w = FloatX(.5f, .25f, .125f, 1.f);
+    c.id = UInt32X(10, 11, 12, 13);
+    c.alive = c.id > 11u;
+
+    // Interleaved buffer with 6 slots per particle
+    FloatX buffer = zeros<FloatX>(24);
+    scatter(buffer, c, arange<UInt32X>(4));
+    assert(buffer[6 * 2 + 0] == 2.f);
+    assert(buffer[6 * 2 + 2] == 6.f);
+    assert(buffer[6 * 2 + 3] == .125f);
+    assert(reinterpret_array<uint32_t>(buffer[6 * 1 + 4]) == 11u);
+    assert(buffer[6 * 3 + 5] == 1.f && buffer[6 * 1 + 5] == 0.f);
+
+    ParticleX g = gather<ParticleX>(buffer, UInt32X(3, 1, 2));
+    assert(g.p.x() == FloatX(3, 1, 2));
+    assert(g.p.z() == FloatX(7, 5, 6));
+    assert(g.w == FloatX(1.f, .25f, .125f));
+    assert(g.id == UInt32X(13, 11, 12));
+    assert(g.alive == mask_t<FloatX>(true, false, true));
+}
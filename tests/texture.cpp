@@ -938,3 +938,272 @@ DRJIT_TEST(test24_set_tensor_inplace) {
     assert(dr::allclose(result_drjit, result_cuda, 5e-3f, 5e-3f));
     assert(dr::allclose(result_drjit, Array2f(4.5, 4.f)));
 }
+
+DRJIT_TEST(test25_mipmap) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::MipmapTexture<Float, 2>::TensorXf;
+
+    size_t shape[3] = { 4, 4, 1 };
+    TensorXf tensor(dr::arange<Float>(16), 3, shape);
+    dr::MipmapTexture<Float, 2> tex(tensor);
+
+    assert(tex.levels() == 3);
+    assert(dr::allclose(
+        tex.pyramid(),
+        Float(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+              2.5f, 4.5f, 10.5f, 12.5f, 7.5f)));
+
+    Array2f pos(0.375f, 0.125f);
+    Array1f out;
+    tex.eval_lod(pos, Float(0.f, 0.5f, 1.f, 2.f, 5.f), out.data());
+    assert(dr::allclose(out.x(), Float(1.f, 2.f, 3.f, 7.5f, 7.5f)));
+
+    // Derivatives spanning two texels of the finest level select level 1
+    Array2f dp_dx(.5f, 0.f), dp_dy(0.f, .25f);
+    assert(dr::allclose(tex.lod(dp_dx, dp_dy), 1.f));
+    tex.eval(pos, dp_dx, dp_dy, out.data());
+    assert(dr::allclose(out.x(), 3.f));
+
+    // Anisotropic lookups average along the longer derivative
+    tex.eval(Array2f(.5f, .5f), dp_dx, Array2f(0.f, .125f), out.data(), true, 4);
+    assert(dr::allclose(out.x(), 7.5f));
+}
+
+DRJIT_TEST(test26_compression) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::Texture<Float, 2>::TensorXf;
+
+    size_t shape[3] = { 4, 4, 1 };
+    TensorXf tensor(dr::arange<Float>(16) / 15.f, 3, shape);
+    dr::Texture<Float, 2> tex(tensor, false, false, dr::FilterMode::Nearest);
+    tex.set_compression(dr::TextureCompression::BC4);
+    assert(tex.compression() == dr::TextureCompression::BC4);
+
+    // The block palette interpolates the endpoints 0 and 1 in steps of 1/7
+    Float ref = dr::floor(dr::arange<Float>(16) * .5f) / 7.f;
+    assert(dr::allclose(tex.value(), ref));
+
+    Array2f pos(.125f, .375f);
+    Array1f out;
+    tex.eval(pos, out.data());
+    assert(dr::allclose(out.x(), 2.f / 7.f));
+
+    // Partial blocks and multiple channels
+    size_t shape2[3] = { 3, 5, 2 };
+    Float value = .5f + .45f * dr::sin(dr::arange<Float>(30) * .37f);
+    dr::Texture<Float, 2> tex2(TensorXf(value, 3, shape2), false, false);
+    tex2.set_compression(dr::TextureCompression::BC4);
+    assert(dr::all(dr::abs(tex2.value() - value) < .065f));
+
+    tex2.set_compression(dr::TextureCompression::Uncompressed);
+    tex2.set_value(value);
+    assert(dr::allclose(tex2.value(), value));
+}
+
+DRJIT_TEST(test27_format) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::Texture<Float, 2>::TensorXf;
+    using UInt32 = dr::uint32_array_t<Float>;
+
+    size_t shape[3] = { 3, 5, 2 };
+    Float value = .9f * dr::sin(dr::arange<Float>(30) * .37f);
+
+    dr::TextureFormat formats[3] = { dr::TextureFormat::Float16,
+                                     dr::TextureFormat::UNorm8,
+                                     dr::TextureFormat::SNorm16 };
+    float tolerance[3] = { 5e-4f, 2e-3f, 2e-5f };
+
+    for (int i = 0; i < 3; ++i) {
+        dr::Texture<Float, 2> tex(TensorXf(value, 3, shape), false, false,
+                                  dr::FilterMode::Nearest,
+                                  dr::WrapMode::Clamp, formats[i]);
+        assert(tex.format() == formats[i]);
+
+        // Normalized formats clamp to their range
+        Float ref = formats[i] == dr::TextureFormat::UNorm8
+                        ? dr::maximum(value, 0.f) : value;
+        assert(dr::all(dr::abs(tex.value() - ref) < tolerance[i]));
+
+        Array2f pos(.3f, .5f);
+        Array2f out;
+        tex.eval(pos, out.data());
+        Array2f expected(dr::gather<Float>(ref, UInt32(12)),
+                         dr::gather<Float>(ref, UInt32(13)));
+        assert(dr::all_nested(dr::abs(out - expected) < tolerance[i]));
+    }
+}
+
+DRJIT_TEST(test28_texture_array) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::TextureArray<Float, 2>::TensorXf;
+    using UInt32 = dr::uint32_array_t<Float>;
+
+    size_t shape[4] = { 3, 2, 2, 1 };
+    dr::TextureArray<Float, 2> tex(TensorXf(dr::arange<Float>(12), 4, shape));
+    assert(tex.layers() == 3);
+
+    // Each lane selects its layer, out-of-bounds layers evaluate to zero
+    Array1f out;
+    tex.eval(Array2f(.5f, .5f), UInt32(0, 1, 2, 3), out.data());
+    assert(dr::allclose(out.x(), Float(1.5f, 5.5f, 9.5f, 0.f)));
+
+    dr::TextureArray<Float, 2> tex2(TensorXf(dr::arange<Float>(12), 4, shape),
+                                    dr::FilterMode::Nearest,
+                                    dr::WrapMode::Repeat);
+    tex2.eval(Array2f(1.75f, .25f), UInt32(2), out.data());
+    assert(dr::allclose(out.x(), 9.f));
+}
+
+DRJIT_TEST(test29_tiled_layout) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::Texture<Float, 2>::TensorXf;
+
+    size_t shape[3] = { 5, 7, 2 };
+    Float value = dr::sin(dr::arange<Float>(70) * .37f);
+
+    for (int k = 0; k < 2; ++k) {
+        dr::FilterMode filter_mode =
+            k == 0 ? dr::FilterMode::Nearest : dr::FilterMode::Linear;
+        dr::Texture<Float, 2> ref(TensorXf(value, 3, shape), false, false,
+                                  filter_mode, dr::WrapMode::Mirror),
+                              tex(TensorXf(value, 3, shape), false, false,
+                                  filter_mode, dr::WrapMode::Mirror);
+        tex.set_layout(dr::TextureLayout::Tiled);
+        assert(tex.layout() == dr::TextureLayout::Tiled);
+        assert(dr::allclose(tex.value(), value));
+
+        Array2f pos(dr::linspace<Float>(-.3f, 1.3f, 37),
+                    dr::linspace<Float>(1.2f, -.2f, 37));
+        Array2f out, out_ref;
+        tex.eval(pos, out.data());
+        ref.eval(pos, out_ref.data());
+        assert(dr::allclose(out, out_ref));
+
+        tex.eval_cubic(pos, out.data());
+        ref.eval_cubic(pos, out_ref.data());
+        assert(dr::allclose(out, out_ref));
+    }
+}
+
+DRJIT_TEST(test30_cubic_nonaccel_grad) {
+    CHECK_CUDA_AVAILABLE()
+
+    size_t shape[3] = { 4, 5, 3 };
+    dr::Texture<DFloat, 3> tex(shape, 1, false, FilterMode::Linear,
+                               WrapMode::Mirror);
+    tex.set_value(dr::sin(dr::arange<DFloat>(60) * .37f));
+
+    // The separable evaluation matches the basis functions and their gradient
+    ArrayD3f pos(dr::linspace<DFloat>(-.2f, 1.2f, 17),
+                 dr::linspace<DFloat>(.9f, .1f, 17),
+                 dr::linspace<DFloat>(.3f, .7f, 17));
+    ArrayD3f pos2 = dr::detach(pos);
+    dr::enable_grad(pos, pos2);
+
+    ArrayD1f res, res2;
+    tex.eval_cubic(pos, res.data());
+    tex.eval_cubic_helper(pos2, res2.data());
+    assert(dr::allclose(res, res2));
+
+    DFloat sum = res.x() + res2.x();
+    dr::backward(sum);
+    assert(dr::allclose(dr::grad(pos), dr::grad(pos2)));
+}
+
+DRJIT_TEST(test31_partial_update) {
+    CHECK_CUDA_AVAILABLE()
+
+    using TensorXf = dr::Texture<Float, 2>::TensorXf;
+    using UInt32 = dr::uint32_array_t<Float>;
+
+    for (int i = 0; i < 2; ++i) {
+        bool use_accel = i == 1;
+        size_t shape[3] = { 4, 5, 1 };
+        dr::Texture<Float, 2> tex(TensorXf(dr::zeros<Float>(20), 3, shape),
+                                  use_accel, use_accel, FilterMode::Nearest);
+
+        size_t offset[2] = { 1, 2 }, extent[2] = { 2, 3 };
+        tex.update_region(offset, extent, dr::arange<Float>(6) + 1.f);
+        tex.update_texels(UInt32(0, 19), Float(7.f, 8.f));
+
+        assert(dr::allclose(tex.value(),
+                            Float(7, 0, 0, 0, 0, 0, 0, 1, 2, 3, 0, 0, 4, 5, 6,
+                                  0, 0, 0, 0, 8)));
+
+        Array1f out;
+        tex.eval(Array2f(.5f, .3f), out.data());
+        assert(dr::allclose(out.x(), 1.f));
+    }
+}
+
+DRJIT_TEST(test32_virtual_texture) {
+    CHECK_CUDA_AVAILABLE()
+
+    using UInt32 = dr::uint32_array_t<Float>;
+
+    // 10x6 texels, 3x2 tiles of 4x4 texels, 2 of which can be resident
+    size_t shape[2] = { 6, 10 };
+    dr::VirtualTexture<Float, 2> tex(shape, 1, 4, 2, FilterMode::Nearest);
+    assert(tex.tile_count() == 6);
+
+    Array2f pos(Float(.05f, .95f, .95f), Float(.1f, .9f, .9f));
+    Array1f out;
+    tex.eval(pos, out.data());
+    assert(dr::allclose(out.x(), 0.f));
+    assert(dr::all(dr::eq(tex.requested_tiles(false), UInt32(0, 5))));
+    assert(dr::all(dr::eq(dr::gather<UInt32>(tex.feedback(), UInt32(0, 5)),
+                          UInt32(1, 2))));
+
+    tex.requested_tiles();
+    tex.load_tile(0, dr::arange<Float>(16));
+    tex.load_tile(5, dr::arange<Float>(16) + 100.f);
+    assert(tex.resident_count() == 2);
+
+    tex.eval(Array2f(Float(.05f, .15f, .95f, .5f), Float(.1f, .2f, .9f, .1f)),
+             out.data());
+    assert(dr::allclose(out.x(), Float(0.f, 5.f, 105.f, 0.f)));
+    assert(dr::all(dr::eq(tex.requested_tiles(), UInt32(1))));
+
+    // Replace tile 0 by tile 1
+    tex.evict_tile(0);
+    tex.load_tile(1, dr::arange<Float>(16) + 50.f);
+    tex.eval(Array2f(Float(.05f, .45f), Float(.1f)), out.data());
+    assert(dr::allclose(out.x(), Float(0.f, 50.f)));
+}
+
+DRJIT_TEST(test33_grad_replicas) {
+    CHECK_CUDA_AVAILABLE()
+
+    size_t shape[2] = { 5, 4 };
+    ArrayD2f pos(dr::linspace<DFloat>(.1f, .9f, 1000) * .3f,
+                 dr::linspace<DFloat>(.8f, .2f, 1000));
+    DFloat weight = dr::linspace<DFloat>(-1.f, 1.f, 1000);
+
+    for (TextureLayout layout : { TextureLayout::RowMajor, TextureLayout::Tiled }) {
+        DFloat grad[2];
+        for (uint32_t replicas : { 1u, 8u }) {
+            dr::Texture<DFloat, 2> tex(shape, 2, false);
+            tex.set_layout(layout);
+            tex.set_grad_replicas(replicas);
+            assert(tex.grad_replicas() == replicas);
+
+            DFloat value = dr::arange<DFloat>(40) * .1f;
+            dr::enable_grad(value);
+            tex.set_value(value);
+
+            ArrayD2f out, out_cubic;
+            tex.eval_nonaccel(pos, out.data());
+            tex.eval_cubic(pos, out_cubic.data());
+            DFloat loss = dr::sum(weight * (out.x() + out.y() + out_cubic.x()));
+            dr::backward(loss);
+            grad[replicas > 1] = dr::grad(value);
+        }
+
+        assert(dr::allclose(grad[0], grad[1], 1e-4f, 1e-4f));
+    }
+}
@@ -2,6 +2,7 @@
 #include <drjit/custom.h>
 #include <drjit/dynamic.h>
 #include <drjit/jit.h>
+#include <drjit/staging.h>
 #include <drjit/util.h>
 
 
@@ -137,3 +138,144 @@ DRJIT_TEST(test03_binary_search) {
 
     assert(dr::all(dr::eq(indices, 5)));
 }
+
+DRJIT_TEST(test04_eytzinger_search) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    for (uint32_t n : { 1, 2, 7, 8, 9, 1000 }) {
+        // Sorted values with duplicates
+        Float sorted = dr::floor(dr::arange<Float>(n) * .5f);
+        dr::EytzingerTable<Float> table(sorted);
+
+        Float x = dr::arange<Float>(n + 4) * .5f - 1.f;
+        UInt32 expected = dr::binary_search<UInt32>(0, n, [&](UInt32 index) {
+            return dr::gather<Float>(sorted, index) < x;
+        });
+        assert(dr::all(dr::eq(table.lower_bound(x), expected)));
+
+        UInt32 upper = table.upper_bound(x);
+        assert(dr::all(dr::eq(upper, dr::minimum(UInt32(dr::floor(dr::maximum(x, 0.f)) * 2.f + 2.f), n)) ||
+                       x < 0.f));
+        assert(dr::all(dr::eq(upper, 0u) || x >= 0.f));
+    }
+}
+
+DRJIT_TEST(test05_segmented_scan) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    UInt32 keys(3, 3, 3, 1, 7, 7, 3, 3, 3, 3),
+           values(1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+
+    auto [unique, count] = dr::run_length_encode(keys);
+    assert(dr::all(dr::eq(unique, UInt32(3, 1, 7, 3))));
+    assert(dr::all(dr::eq(count, UInt32(3, 1, 2, 4))));
+
+    assert(dr::all(dr::eq(dr::segmented_prefix_sum(values, keys),
+                          UInt32(0, 1, 3, 0, 0, 5, 0, 7, 15, 24))));
+    assert(dr::all(dr::eq(dr::segmented_prefix_sum(values, keys, false),
+                          UInt32(1, 3, 6, 4, 5, 11, 7, 15, 24, 34))));
+
+    Float values_f(values);
+    assert(dr::all(dr::eq(dr::segmented_prefix_sum(values_f, keys),
+                          Float(0, 1, 3, 0, 0, 5, 0, 7, 15, 24))));
+    assert(dr::all(dr::eq(dr::segmented_prefix_sum(values_f, keys, false),
+                          Float(1, 3, 6, 4, 5, 11, 7, 15, 24, 34))));
+
+    assert(dr::all(dr::eq(dr::segmented_reduce(ReduceOp::Add, values, keys),
+                          UInt32(6, 4, 11, 34))));
+    assert(dr::all(dr::eq(dr::segmented_reduce(ReduceOp::Max, values_f, keys),
+                          Float(3, 4, 6, 10))));
+
+    auto [key_c, value_c] = dr::compress(values > 4u && values < 9u, keys, values_f);
+    assert(dr::all(dr::eq(key_c, UInt32(7, 7, 3, 3))));
+    assert(dr::all(dr::eq(value_c, Float(5, 6, 7, 8))));
+}
+
+DRJIT_TEST(test06_histogram) {
+    jit_init((uint32_t) JitBackend::LLVM);
+
+    // Heavily skewed bins: most entries land in bin 0
+    UInt32 index = dr::arange<UInt32>(1000);
+    index = dr::select(dr::eq(index, 5u), 100u, // out of range
+                       dr::select(dr::eq(index % 10u, 0u), index % 7u, 0u));
+
+    for (uint32_t copies : { 1, 3, 16 }) {
+        UInt32 hist = dr::histogram(index, 7, UInt32(1), true, copies);
+        assert(hist.size() == 7);
+        assert(dr::all(dr::eq(hist, UInt32(914, 14, 14, 15, 14, 14, 14))));
+
+        Float weight = dr::histogram(index, 7, Float(.5f), index > 0u, copies);
+        assert(dr::all(dr::eq(weight, Float(0.f, 7.f, 7.f, 7.5f, 7.f, 7.f, 7.f))));
+    }
+}
+
+DRJIT_TEST(test07_staging_ring) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    using FloatJ = dr::LLVMArray<float>;
+
+    dr::StagingRing<FloatJ> ring(16, 2);
+    std::vector<FloatJ> uploaded;
+
+    // Cycle through the ring several times to exercise slot reuse
+    for (int i = 0; i < 5; ++i) {
+        float *buf = ring.acquire();
+        for (int j = 0; j < 10; ++j)
+            buf[j] = float(i * 10 + j);
+        auto [value, transfer] = ring.upload(10);
+        uploaded.push_back(value + 1.f);
+        transfer.wait();
+        assert(transfer.done());
+    }
+
+    for (int i = 0; i < 5; ++i)
+        assert(dr::all(dr::eq(uploaded[i], dr::arange<FloatJ>(10) + float(i * 10 + 1))));
+
+    auto [ptr, transfer] = ring.download(uploaded[4] * 2.f);
+    transfer.wait();
+    for (int j = 0; j < 10; ++j)
+        assert(ptr[j] == float(2 * (41 + j)));
+
+    bool raised = false;
+    try {
+        ring.acquire();
+        ring.upload(17);
+    } catch (const std::exception &) {
+        raised = true;
+    }
+    assert(raised);
+}
+
+DRJIT_TEST(test08_reinterpret_alias) {
+    jit_init((uint32_t) JitBackend::LLVM);
+    using FloatJ = dr::LLVMArray<float>;
+    using UInt32J = dr::LLVMArray<uint32_t>;
+
+    FloatJ x = dr::arange<FloatJ>(10) + 1.f;
+    dr::eval(x);
+
+    // Evaluated arrays share their storage with the reinterpreted array
+    UInt32J y = dr::reinterpret_array<UInt32J>(x);
+    assert(y.data() == (const uint32_t *) x.data());
+    assert(dr::all(dr::eq(dr::reinterpret_array<FloatJ>(y + 0u), x)));
+
+    // Writes to either array must not be visible through the other one
+    dr::scatter(y, UInt32J(0u), UInt32J(0u));
+    assert(y.data() != (const uint32_t *) x.data());
+    assert(x[0] == 1.f && y[0] == 0u && y[1] == dr::memcpy_cast<uint32_t>(2.f));
+
+    UInt32J z = dr::reinterpret_array<UInt32J>(x);
+    dr::scatter(x, FloatJ(0.f), UInt32J(1u));
+    assert(x[1] == 0.f && z[1] == dr::memcpy_cast<uint32_t>(2.f));
+
+    // Relabeling an alias first replaces it by a copy
+    UInt32J l = dr::reinterpret_array<UInt32J>(x);
+    dr::set_label(l, "l");
+    assert(l.data() != (const uint32_t *) x.data());
+
+    // The alias keeps its source alive
+    FloatJ v = dr::arange<FloatJ>(4) * 2.f;
+    dr::eval(v);
+    UInt32J w = dr::reinterpret_array<UInt32J>(v);
+    v = FloatJ();
+    assert(dr::all(dr::eq(dr::reinterpret_array<FloatJ>(w), dr::arange<FloatJ>(4) * 2.f)));
+}
@@ -42,6 +42,7 @@ struct Base {
     }
 
     float field() const { return 1.2f; };
+    virtual uint32_t flags() const { return 0; }
     DRJIT_VCALL_REGISTER(Float, Base)
 
 protected:
@@ -62,6 +63,7 @@ struct A : Base {
 
 struct B : Base {
     B(bool scalar) : Base(scalar) { dr::set_attr(this, "field", 4.8f); }
+    uint32_t flags() const override { return 7; }
     StructF f(const StructF &m, ::Mask /* active */ = true) override {
         if (x.size() == 1)
             return Struct(m.b * 20, m.a * x);
@@ -75,6 +77,7 @@ DRJIT_VCALL_METHOD(f)
 DRJIT_VCALL_METHOD(side_effect)
 DRJIT_VCALL_METHOD(strlen)
 DRJIT_VCALL_GETTER(field, float)
+DRJIT_VCALL_UNIFORM_METHOD(flags)
 DRJIT_VCALL_END(Base)
 
 DRJIT_TEST(test01_vcall_reduce_and_record) {
@@ -124,6 +127,7 @@ DRJIT_TEST(test01_vcall_reduce_and_record) {
                                                 Array3f(60.f, 75.f, 90.f)))));
 
             assert(dr::all(dr::eq(arr->field(), dr::select(m, 4.8f, 2.4f))));
+            assert(dr::all(dr::eq(arr->flags(), dr::select(m, 7u, 0u))));
 
             delete a;
             delete b;
@@ -468,3 +472,171 @@ DRJIT_TEST(test06_vcall_ad_bwd_inputs) {
         delete b;
     }
 }
+
+DRJIT_TEST(test07_vcall_reduce_coherent) {
+    int n = 9999;
+
+    if constexpr (dr::is_cuda_v<Float>)
+        jit_init((uint32_t) JitBackend::CUDA);
+    else
+        jit_init((uint32_t) JitBackend::LLVM);
+
+    jit_set_flag(JitFlag::VCallRecord, false);
+
+    A *a = new A(true);
+    B *b = new B(true);
+
+    UInt32 index = dr::arange<UInt32>(n);
+    ::Mask m = dr::neq(index & 1, 0);
+    BasePtr arr = dr::select(m, (Base *) b, (Base *) a);
+
+    // Per-lane arguments that reveal any mix-up of the lane order
+    Float value = Float(n - index);
+    StructF arg{ Array3f(1, 2, 3) * value, Array3f(4, 5, 6) * value };
+
+    StructF ref = arr->f(arg), result;
+    {
+        dr::VCallCoherenceScope<UInt32> scope((n - 1 - index) % 37, 37);
+        result = arr->f(arg, index > 100);
+    }
+
+    assert(dr::all_nested(
+        dr::eq(result.a, dr::select(index > 100, ref.a, 0.f)) &&
+        dr::eq(result.b, dr::select(index > 100, ref.b, 0.f))));
+
+    // Buckets of the same size, and keys exceeding the specified range
+    n = 10000;
+    index = dr::arange<UInt32>(n);
+    arr = dr::select(dr::neq(index & 1, 0), (Base *) b, (Base *) a);
+    value = Float(n - index);
+    arg = StructF{ Array3f(1, 2, 3) * value, Array3f(4, 5, 6) * value };
+
+    ref = arr->f(arg);
+    {
+        dr::VCallCoherenceScope<UInt32> scope(n - 1 - index, 37);
+        result = arr->f(arg);
+    }
+
+    assert(dr::all_nested(dr::eq(result.a, ref.a) && dr::eq(result.b, ref.b)));
+
+    delete a;
+    delete b;
+}
+
+DRJIT_TEST(test08_vcall_reduce_concurrent) {
+    int n = 9999;
+
+    if constexpr (dr::is_cuda_v<Float>)
+        jit_init((uint32_t) JitBackend::CUDA);
+    else
+        jit_init((uint32_t) JitBackend::LLVM);
+
+    jit_set_flag(JitFlag::VCallRecord, false);
+
+    A *a = new A(true);
+    B *b = new B(true);
+
+    UInt32 index = dr::arange<UInt32>(n);
+    ::Mask m = dr::neq(index & 1, 0);
+    BasePtr arr = dr::select(m, (Base *) b, (Base *) a);
+
+    Float value = Float(n - index);
+    StructF arg{ Array3f(1, 2, 3) * value, Array3f(4, 5, 6) * value };
+
+    StructF ref = arr->f(arg), result;
+    {
+        dr::VCallConcurrencyScope scope(4);
+        result = arr->f(arg);
+    }
+
+    assert(dr::all_nested(dr::eq(result.a, ref.a) && dr::eq(result.b, ref.b)));
+
+    delete a;
+    delete b;
+}
+
+DRJIT_TEST(test09_vcall_record_inline_select) {
+    int n = 9999;
+
+    if constexpr (dr::is_cuda_v<Float>)
+        jit_init((uint32_t) JitBackend::CUDA);
+    else
+        jit_init((uint32_t) JitBackend::LLVM);
+
+    jit_set_flag(JitFlag::VCallRecord, true);
+    jit_set_flag(JitFlag::VCallInline, true);
+
+    A *a = new A(true);
+    B *b = new B(true);
+
+    ::Mask m = dr::neq(dr::arange<UInt32>(n) & 1, 0);
+    BasePtr arr = dr::select(m, (Base *) b, (Base *) a);
+
+    dr::VCallInlineScope scope(2);
+    StructF result = arr->f(Struct{ Array3f(1, 2, 3) * dr::full<Float>(1, n),
+                                    Array3f(4, 5, 6) * dr::full<Float>(1, n)});
+
+    assert(dr::all_nested(
+        dr::eq(result.a, dr::select(m, Array3f(80.f, 100.f, 120.f),
+                                       Array3f(10.f, 20.f, 30.f))) &&
+        dr::eq(result.b, dr::select(m, Array3f(10.f, 20.f, 30.f),
+                                       Array3f(60.f, 75.f, 90.f)))));
+
+    assert(dr::all(dr::eq(arr->field(), dr::select(m, 4.8f, 2.4f))));
+
+    delete a;
+    delete b;
+}
+
+DRJIT_TEST(test10_vcall_site_adaptive) {
+    int n = 9999;
+
+    if constexpr (dr::is_cuda_v<Float>)
+        jit_init((uint32_t) JitBackend::CUDA);
+    else
+        jit_init((uint32_t) JitBackend::LLVM);
+
+    A *a = new A(true);
+    B *b = new B(true);
+
+    ::Mask m = dr::neq(dr::arange<UInt32>(n) & 1, 0);
+    BasePtr arr = dr::select(m, (Base *) b, (Base *) a);
+
+    dr::VCallSite *site = dr::vcall_site("Base", "f");
+    site->reset();
+    site->mode = dr::VCallMode::Adaptive;
+
+    uint32_t n_calls = 2 * dr::VCallSite::ProfileCalls + 2;
+    for (uint32_t i = 0; i < n_calls; ++i) {
+        StructF result = arr->f(Struct{ Array3f(1, 2, 3) * dr::full<Float>(1, n),
+                                        Array3f(4, 5, 6) * dr::full<Float>(1, n)});
+
+        assert(dr::all_nested(
+            dr::eq(result.a, dr::select(m, Array3f(80.f, 100.f, 120.f),
+                                           Array3f(10.f, 20.f, 30.f))) &&
+            dr::eq(result.b, dr::select(m, Array3f(10.f, 20.f, 30.f),
+                                           Array3f(60.f, 75.f, 90.f)))));
+    }
+
+    // Both strategies were profiled, the remaining calls used the faster one
+    assert(site->profiled_calls[0] == dr::VCallSite::ProfileCalls);
+    assert(site->profiled_calls[1] == dr::VCallSite::ProfileCalls);
+    assert(site->calls[0] + site->calls[1] == n_calls);
+    assert(site->lanes[0] + site->lanes[1] == (uint64_t) n * n_calls);
+    assert(site->calls[site->time_per_lane(true) < site->time_per_lane(false)] ==
+           dr::VCallSite::ProfileCalls + 2);
+
+    // All calls targeted two instances
+    assert(site->instances[1] == n_calls);
+
+    // Manual override
+    site->reset();
+    dr::vcall_set_mode("Base", "f", dr::VCallMode::Reduce);
+    arr->f(Struct{ Array3f(1, 2, 3), Array3f(4, 5, 6) });
+    assert(site->calls[0] == 1 && site->calls[1] == 0);
+
+    site->mode = dr::VCallMode::Global;
+
+    delete a;
+    delete b;
+}
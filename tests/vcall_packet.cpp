@@ -0,0 +1,96 @@
+/*
+    tests/vcall_packet.cpp -- tests vectorized method calls on packet types
+
+    Dr.Jit is a C++ template library that enables transparent vectorization
+    of numerical kernels using SIMD instruction sets available on current
+    processor architectures.
+
+    Copyright (c) 2021 Wenzel Jakob <wenzel.jakob@epfl.ch>
+
+    All rights reserved. Use of this source code is governed by a BSD-style
+    license that can be found in the LICENSE file.
+*/
+
+#include "test.h"
+#include <drjit/vcall.h>
+
+using FloatP  = Packet<float>;
+using UInt32P = Packet<uint32_t>;
+using MaskP   = mask_t<FloatP>;
+
+struct Base {
+    Base(float scale) : scale(scale) { }
+    virtual ~Base() { }
+    virtual FloatP f(const FloatP &x, MaskP /* active */) const = 0;
+    DRJIT_VCALL_REGISTER(FloatP, Base)
+    float scale;
+};
+
+using BasePtrP = replace_scalar_t<FloatP, const Base *>;
+
+struct A : Base {
+    A() : Base(2.f) { }
+    FloatP f(const FloatP &x, MaskP) const override { return x * scale; }
+};
+
+struct B : Base {
+    B() : Base(3.f) { }
+    FloatP f(const FloatP &x, MaskP) const override { return x + scale; }
+};
+
+DRJIT_VCALL_BEGIN(Base)
+DRJIT_VCALL_METHOD(f)
+DRJIT_VCALL_END(Base)
+
+DRJIT_TEST(test01_vcall_packet) {
+    A a; B b;
+    MaskP m = neq(arange<UInt32P>() & 1, 0u);
+    BasePtrP ptr = select(m, BasePtrP(&b), BasePtrP(&a));
+    ptr[arange<UInt32P>() == 0] = nullptr;
+
+    FloatP x = arange<FloatP>();
+    FloatP result = ptr->f(x, MaskP(true));
+    FloatP ref = select(m, x + 3.f, x * 2.f);
+    ref[arange<UInt32P>() == 0] = 0.f;
+
+    assert(all(eq(result, ref)));
+}
+
+DRJIT_TEST(test02_vcall_batched) {
+    A a; B b;
+    const size_t size = 1000;
+
+    std::vector<const Base *> self(size);
+    std::vector<float> x(size), y(size, -1.f);
+    for (size_t i = 0; i < size; ++i) {
+        uint32_t h = (uint32_t) (i * 2654435761u) >> 28;
+        self[i] = h < 6 ? (const Base *) &a : (h < 14 ? (const Base *) &b : nullptr);
+        x[i] = (float) i;
+    }
+
+    size_t calls = 0;
+    vcall_batched<UInt32P>(
+        self.data(), size,
+        [&](const Base *inst, const UInt32P &index, const MaskP &active) {
+            FloatP value = gather<FloatP>(x.data(), index, active);
+            scatter(y.data(), inst->f(value, active), index, active);
+            calls++;
+        });
+
+    size_t count[2] = { 0, 0 };
+    for (size_t i = 0; i < size; ++i) {
+        if (self[i] == &a) {
+            assert(y[i] == x[i] * 2.f);
+            count[0]++;
+        } else if (self[i] == &b) {
+            assert(y[i] == x[i] + 3.f);
+            count[1]++;
+        } else {
+            assert(y[i] == -1.f);
+        }
+    }
+
+    // Each instance is called on densely packed lanes
+    size_t n = UInt32P::Size;
+    assert(calls == (count[0] + n - 1) / n + (count[1] + n - 1) / n);
+}